@@ -46,6 +46,7 @@
 #include <protocols/ipv4.h>
 #include <protocols/udp.h>
 #include <protocols/rtp.h>
+#include <protocols/tcp.h>
 
 /* include for the PCAP library */
 #if HAVE_PCAP_PCAP_H == 1
@@ -71,6 +72,7 @@ for ./configure ? If yes, check configure output and config.log"
 static void usage(void);
 static bool build_stream(const char *const filename,
                          const char *const stream_type,
+                         const bool use_tcp,
                          const unsigned long max_packets,
                          const unsigned long streams_nr,
                          const int use_large_cid,
@@ -118,6 +120,8 @@ int main(int argc, char *argv[])
 	unsigned long max_packets = 0;
 	char *filename = NULL;
 	char *cid_type = NULL;
+	char *protocol = NULL;
+	bool use_tcp;
 	int max_contexts = ROHC_SMALL_CID_MAX + 1;
 	int wlsb_width = 4;
 	int streams_nr = 1;
@@ -198,6 +202,18 @@ int main(int argc, char *argv[])
 			streams_nr = atoi(argv[1]);
 			args_used++;
 		}
+		else if(!strcmp(*argv, "--protocol"))
+		{
+			/* get the protocol of the streams to generate */
+			if(argc <= 1)
+			{
+				fprintf(stderr, "missing mandatory --protocol parameter\n");
+				usage();
+				goto error;
+			}
+			protocol = argv[1];
+			args_used++;
+		}
 		else if(stream_type == NULL)
 		{
 			/* get the type of the stream to perform */
@@ -266,6 +282,22 @@ int main(int argc, char *argv[])
 		goto error;
 	}
 
+	/* check protocol */
+	if(protocol == NULL || !strcmp(protocol, "rtp"))
+	{
+		use_tcp = false;
+	}
+	else if(!strcmp(protocol, "tcp"))
+	{
+		use_tcp = true;
+	}
+	else
+	{
+		fprintf(stderr, "invalid protocol '%s', only 'rtp' and 'tcp' "
+		        "expected\n", protocol);
+		goto error;
+	}
+
 	/* check WLSB width */
 	if(wlsb_width <= 0 || (wlsb_width & (wlsb_width - 1)) != 0)
 	{
@@ -298,7 +330,7 @@ int main(int argc, char *argv[])
 	}
 
 	/* test ROHC compression/decompression with the packets from the file */
-	if(!build_stream(filename, stream_type, max_packets, streams_nr,
+	if(!build_stream(filename, stream_type, use_tcp, max_packets, streams_nr,
 	                 use_large_cid, wlsb_width, max_contexts))
 	{
 		fprintf(stderr, "failed to build stream\n");
@@ -328,6 +360,8 @@ static void usage(void)
 	       "  -h, --help              Print this usage and exit\n"
 	       "  -v, --version           Print the application version and exit\n"
 	       "      --streams-nr        The number of streams to generate\n"
+	       "      --protocol PROTO    The protocol of the streams among 'rtp'\n"
+	       "                          (default) and 'tcp'\n"
 	       "Compression options:\n"
 	       "      --cid-type TYPE     The type of CID to use among 'smallcid'\n"
 	       "                          and 'largecid'\n"
@@ -345,6 +379,10 @@ static void usage(void)
 	       "  rohc_gen_stream comp 500 rohc.pcap    Generate 500 RTP packets,\n"
 	       "                                        compress them, then store\n"
 	       "                                        them in file rohc.pcap\n"
+	       "  rohc_gen_stream --protocol tcp uncomp 1000 tcp.pcap\n"
+	       "                                        Generate 1000 packets of\n"
+	       "                                        a TCP bulk flow in file\n"
+	       "                                        tcp.pcap\n"
 	       "\n"
 	       "Report bugs to <" PACKAGE_BUGREPORT ">.\n");
 }
@@ -355,6 +393,8 @@ static void usage(void)
  *
  * @param filename       The name of the PCAP file to output the stream
  * @param stream_type    The type of stream to generate: uncomp or comp
+ * @param use_tcp        Whether to generate TCP bulk flows instead of
+ *                       IP/UDP/RTP streams
  * @param max_packets    The number of packets to generate
  * @param streams_nr     The number of streams to generate
  * @param use_large_cid  Whether the compressor shall use large CIDs
@@ -365,6 +405,7 @@ static void usage(void)
  */
 static bool build_stream(const char *const filename,
                          const char *const stream_type,
+                         const bool use_tcp,
                          const unsigned long max_packets,
                          const unsigned long streams_nr,
                          const int use_large_cid,
@@ -448,10 +489,13 @@ static bool build_stream(const char *const filename,
 	/* build the stream, and save it in the PCAP dump */
 	for(counter = 1; counter <= max_packets; counter++)
 	{
-		const size_t payload_len = 20;
+		const size_t tcp_opts_len = 2 + TCP_OLEN_TS;
+		const size_t payload_len = (use_tcp ? 1000 : 20);
 		const size_t packet_len = sizeof(struct ipv4_hdr) +
-		                          sizeof(struct udphdr) +
-		                          sizeof(struct rtphdr) +
+		                          (use_tcp ?
+		                           sizeof(struct tcphdr) + tcp_opts_len :
+		                           sizeof(struct udphdr) +
+		                           sizeof(struct rtphdr)) +
 		                          payload_len;
 		uint8_t buffer[ETHER_HDR_LEN + packet_len];
 		struct rohc_buf packet =
@@ -466,6 +510,8 @@ static bool build_stream(const char *const filename,
 		struct ipv4_hdr *ipv4;
 		struct udphdr *udp;
 		struct rtphdr *rtp;
+		struct tcphdr *tcp;
+		uint32_t ts;
 		size_t i;
 
 		/* skip the Ethernet header, it will be written later */
@@ -484,37 +530,76 @@ static bool build_stream(const char *const filename,
 		ipv4->id = htons(42 + counter / streams_nr);
 		ipv4->frag_off = 0;
 		ipv4->ttl = 64;
-		ipv4->protocol = IPPROTO_UDP;
+		ipv4->protocol = (use_tcp ? IPPROTO_TCP : IPPROTO_UDP);
 		ipv4->check = 0;
 		ipv4->saddr = htonl(0xc0a80001);
 		ipv4->daddr = htonl(0xc0a80002);
 		ipv4->check = ip_fast_csum((uint8_t *) ipv4, ipv4->ihl);
 		rohc_buf_pull(&packet, sizeof(struct ipv4_hdr));
 
-		/* build UDP header */
-		packet.len += sizeof(struct udphdr);
-		udp = (struct udphdr *) rohc_buf_data(packet);
-		udp->source = htons(1234 + (counter % streams_nr));
-		udp->dest = htons(1234);
-		udp->len = htons(packet_len - sizeof(struct ipv4_hdr));
-		udp->check = 0; /* UDP checksum disabled */
-		rohc_buf_pull(&packet, sizeof(struct udphdr));
-
-		/* build RTP header */
-		packet.len += sizeof(struct rtphdr);
-		rtp = (struct rtphdr *) rohc_buf_data(packet);
-		rtp->version = 2;
-		rtp->padding = 0;
-		rtp->extension = 0;
-		rtp->cc = 0;
-		rtp->m = 0;
-		rtp->pt = 0x72; /* speex */
-		rtp->sn = htons(counter / streams_nr);
-		rtp->timestamp = htonl(500000 + (counter / streams_nr) * 160);
-		rtp->ssrc = htonl(0x42424242 + (counter % streams_nr));
-		rohc_buf_pull(&packet, sizeof(struct rtphdr));
-
-		/* build RTP payload */
+		if(use_tcp)
+		{
+			/* build the TCP header of one bulk data segment: the sequence
+			 * number increases by the payload length, the ACK number and the
+			 * window do not change */
+			packet.len += sizeof(struct tcphdr);
+			tcp = (struct tcphdr *) rohc_buf_data(packet);
+			tcp->src_port = htons(1234 + (counter % streams_nr));
+			tcp->dst_port = htons(80);
+			tcp->seq_num = htonl(0x10000000 + (counter / streams_nr) * payload_len);
+			tcp->ack_num = htonl(0x20000000);
+			tcp->res_flags = 0;
+			tcp->data_offset = (sizeof(struct tcphdr) + tcp_opts_len) / 4;
+			tcp->ecn_flags = 0;
+			tcp->urg_flag = 0;
+			tcp->ack_flag = 1;
+			tcp->psh_flag = 0;
+			tcp->rsf_flags = RSF_NONE;
+			tcp->window = htons(0xffff);
+			tcp->checksum = 0;
+			tcp->urg_ptr = 0;
+			rohc_buf_pull(&packet, sizeof(struct tcphdr));
+
+			/* build the NOP, NOP and TS options: the timestamp increases with
+			 * every segment, the echo reply does not change */
+			packet.len += tcp_opts_len;
+			rohc_buf_byte_at(packet, 0) = TCP_OPT_NOP;
+			rohc_buf_byte_at(packet, 1) = TCP_OPT_NOP;
+			rohc_buf_byte_at(packet, 2) = TCP_OPT_TS;
+			rohc_buf_byte_at(packet, 3) = TCP_OLEN_TS;
+			ts = htonl(1000000 + counter / streams_nr);
+			memcpy(rohc_buf_data_at(packet, 4), &ts, sizeof(uint32_t));
+			ts = htonl(2000000);
+			memcpy(rohc_buf_data_at(packet, 8), &ts, sizeof(uint32_t));
+			rohc_buf_pull(&packet, tcp_opts_len);
+		}
+		else
+		{
+			/* build UDP header */
+			packet.len += sizeof(struct udphdr);
+			udp = (struct udphdr *) rohc_buf_data(packet);
+			udp->source = htons(1234 + (counter % streams_nr));
+			udp->dest = htons(1234);
+			udp->len = htons(packet_len - sizeof(struct ipv4_hdr));
+			udp->check = 0; /* UDP checksum disabled */
+			rohc_buf_pull(&packet, sizeof(struct udphdr));
+
+			/* build RTP header */
+			packet.len += sizeof(struct rtphdr);
+			rtp = (struct rtphdr *) rohc_buf_data(packet);
+			rtp->version = 2;
+			rtp->padding = 0;
+			rtp->extension = 0;
+			rtp->cc = 0;
+			rtp->m = 0;
+			rtp->pt = 0x72; /* speex */
+			rtp->sn = htons(counter / streams_nr);
+			rtp->timestamp = htonl(500000 + (counter / streams_nr) * 160);
+			rtp->ssrc = htonl(0x42424242 + (counter % streams_nr));
+			rohc_buf_pull(&packet, sizeof(struct rtphdr));
+		}
+
+		/* build RTP or TCP payload */
 		for(i = 0; i < payload_len; i++)
 		{
 			rohc_buf_byte_at(packet, i) = i % 0xff;
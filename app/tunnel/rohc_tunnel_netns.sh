@@ -0,0 +1,64 @@
+#!/bin/sh
+#
+# Run two ROHC tunnels between two network namespaces linked by a veth pair,
+# ping through the tunnels, then print the per-stage statistics of both
+# tunnels.
+#
+# Usage: rohc_tunnel_netns.sh [ROHC_TUNNEL_OPTIONS]
+#
+# The ROHC_TUNNEL environment variable may give the path to the rohc_tunnel
+# binary, and the PING_COUNT environment variable the number of pings.
+#
+# You need to be root (or to have POSIX capability CAP_NET_ADMIN and
+# CAP_SYS_ADMIN) to run the script.
+#
+
+ROHC_TUNNEL=${ROHC_TUNNEL:-rohc_tunnel}
+PING_COUNT=${PING_COUNT:-100}
+NS_A="rohc_tunnel_a"
+NS_B="rohc_tunnel_b"
+LOG_A=$( mktemp )
+LOG_B=$( mktemp )
+
+cleanup()
+{
+	ip netns del ${NS_A} 2>/dev/null
+	ip netns del ${NS_B} 2>/dev/null
+	rm -f ${LOG_A} ${LOG_B}
+}
+trap cleanup EXIT
+
+# two namespaces linked by a veth pair
+ip netns add ${NS_A} || exit 1
+ip netns add ${NS_B} || exit 1
+ip link add veth_a netns ${NS_A} type veth peer name veth_b netns ${NS_B} || exit 1
+ip -n ${NS_A} addr add 192.168.100.1/24 dev veth_a || exit 1
+ip -n ${NS_B} addr add 192.168.100.2/24 dev veth_b || exit 1
+ip -n ${NS_A} link set veth_a up || exit 1
+ip -n ${NS_B} link set veth_b up || exit 1
+
+# one ROHC tunnel in each namespace
+ip netns exec ${NS_A} ${ROHC_TUNNEL} "$@" rohc0 \
+	192.168.100.1 5000 192.168.100.2 5000 >${LOG_A} 2>&1 &
+PID_A=$!
+ip netns exec ${NS_B} ${ROHC_TUNNEL} "$@" rohc0 \
+	192.168.100.2 5000 192.168.100.1 5000 >${LOG_B} 2>&1 &
+PID_B=$!
+sleep 1
+ip -n ${NS_A} addr add 10.100.0.1/24 dev rohc0 || exit 1
+ip -n ${NS_B} addr add 10.100.0.2/24 dev rohc0 || exit 1
+ip -n ${NS_A} link set rohc0 up || exit 1
+ip -n ${NS_B} link set rohc0 up || exit 1
+
+# ping through the tunnels
+ip netns exec ${NS_A} ping -q -i 0.01 -c ${PING_COUNT} 10.100.0.2
+ret=$?
+
+kill ${PID_A} ${PID_B}
+wait ${PID_A} ${PID_B}
+echo "=== ROHC tunnel in ${NS_A} ==="
+cat ${LOG_A}
+echo "=== ROHC tunnel in ${NS_B} ==="
+cat ${LOG_B}
+
+exit ${ret}
@@ -0,0 +1,1294 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   tunnel.c
+ * @brief  ROHC tunnel program
+ * @author agent <agent@local>
+ *
+ * Objectives:
+ *   Provide a reference data path that runs the library at line rate.
+ *   Measure the time spent in every stage of the data path.
+ *
+ * How it works:
+ *   The program reads IP packets from a TUN device, compresses them, and
+ *   sends the ROHC packets to the remote tunnel endpoint over UDP. In the
+ *   reverse direction, it receives ROHC packets over UDP, decompresses them,
+ *   and writes the IP packets to the TUN device.
+ *
+ *   Packets are handled in batches: the UDP socket is read and written with
+ *   recvmmsg() and sendmmsg(), the TUN device is read until it is empty or
+ *   until the batch is full. TUN devices do not support recvmmsg() and
+ *   sendmmsg(), so they are read and written one packet at a time.
+ *
+ *   The feedback of the local decompressor is piggybacked on the ROHC
+ *   packets of the local compressor. It is flushed in feedback-only packets
+ *   if no packet was compressed for a while.
+ *
+ * Thread models:
+ *   - single: one thread handles both directions,
+ *   - split: one thread compresses, another thread decompresses. The
+ *     compressor is shared by both threads because of feedback, so it is
+ *     protected by a mutex.
+ *
+ * Statistics:
+ *   The time spent in every stage of the data path is printed when the
+ *   program stops: TUN read, compression, UDP send, UDP receive,
+ *   decompression, and TUN write.
+ */
+
+#define _GNU_SOURCE /* for recvmmsg() and sendmmsg() */
+
+#include "config.h" /* for PACKAGE_BUGREPORT */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <poll.h>
+#include <pthread.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <linux/if.h>
+#include <linux/if_tun.h>
+
+/* ROHC includes */
+#include <rohc/rohc.h>
+#include <rohc/rohc_comp.h>
+#include <rohc/rohc_decomp.h>
+
+
+/** The maximal length of the IP and ROHC packets */
+#define TUNNEL_PKT_MAX_LEN  4096U
+
+/** The maximal number of packets in one batch */
+#define TUNNEL_BATCH_MAX  64U
+
+/** The default number of packets in one batch */
+#define TUNNEL_BATCH_DEFAULT  32U
+
+/** The maximal delay (in ms) before the feedback of the local decompressor
+ *  is flushed in feedback-only packets */
+#define TUNNEL_FEEDBACK_DELAY  10U
+
+/** Print a trace on stderr */
+#define TUNNEL_LOG(format, ...) \
+	do \
+	{ \
+		fprintf(stderr, format "\n", ##__VA_ARGS__); \
+		fflush(stderr); \
+	} while(0)
+
+
+/** The stages of the data path */
+typedef enum
+{
+	TUNNEL_STAGE_TUN_READ  = 0, /**< Read IP packets from the TUN device */
+	TUNNEL_STAGE_COMP      = 1, /**< Compress the IP packets */
+	TUNNEL_STAGE_UDP_SEND  = 2, /**< Send the ROHC packets over UDP */
+	TUNNEL_STAGE_UDP_RECV  = 3, /**< Receive the ROHC packets over UDP */
+	TUNNEL_STAGE_DECOMP    = 4, /**< Decompress the ROHC packets */
+	TUNNEL_STAGE_TUN_WRITE = 5, /**< Write the IP packets to the TUN device */
+	TUNNEL_STAGE_MAX       = 6,
+} tunnel_stage_t;
+
+/** The names of the stages of the data path */
+static const char *const tunnel_stage_names[TUNNEL_STAGE_MAX] =
+{
+	[TUNNEL_STAGE_TUN_READ]  = "TUN read",
+	[TUNNEL_STAGE_COMP]      = "compression",
+	[TUNNEL_STAGE_UDP_SEND]  = "UDP send",
+	[TUNNEL_STAGE_UDP_RECV]  = "UDP receive",
+	[TUNNEL_STAGE_DECOMP]    = "decompression",
+	[TUNNEL_STAGE_TUN_WRITE] = "TUN write",
+};
+
+/** The statistics of one stage of the data path */
+struct tunnel_stage_stats
+{
+	unsigned long calls_nr;  /**< The number of batches handled */
+	unsigned long pkts_nr;   /**< The number of packets handled */
+	uint64_t total_ns;       /**< The total time spent (in ns) */
+	uint64_t max_ns;         /**< The longest time spent on one batch (in ns) */
+};
+
+/** The thread models */
+typedef enum
+{
+	TUNNEL_THREADS_SINGLE = 0, /**< One thread for both directions */
+	TUNNEL_THREADS_SPLIT  = 1, /**< One thread per direction */
+} tunnel_threads_t;
+
+/** The ROHC tunnel */
+struct tunnel
+{
+	int tun_fd;     /**< The TUN device */
+	int udp_fd;     /**< The UDP socket connected to the remote endpoint */
+	size_t batch_len; /**< The maximal number of packets in one batch */
+
+	struct rohc_comp *comp;      /**< The ROHC compressor */
+	struct rohc_decomp *decomp;  /**< The ROHC decompressor */
+	/** The lock of the compressor, shared by the compression path and by the
+	 *  feedback of the decompression path */
+	pthread_mutex_t comp_lock;
+
+	/** The statistics of the stages of the data path */
+	struct tunnel_stage_stats stages[TUNNEL_STAGE_MAX];
+	unsigned long comp_failures_nr;    /**< The number of compression failures */
+	unsigned long decomp_failures_nr;  /**< The number of decompression failures */
+	unsigned long drops_nr;            /**< The number of packets not sent */
+	unsigned long feedbacks_nr;        /**< The number of feedback-only packets */
+
+	/* compression path */
+	uint8_t tun_pkts[TUNNEL_BATCH_MAX][TUNNEL_PKT_MAX_LEN];
+	size_t tun_pkts_len[TUNNEL_BATCH_MAX];
+	uint8_t rohc_pkts[TUNNEL_BATCH_MAX][TUNNEL_PKT_MAX_LEN];
+	struct iovec send_iovs[TUNNEL_BATCH_MAX];
+	struct mmsghdr send_msgs[TUNNEL_BATCH_MAX];
+
+	/* decompression path */
+	uint8_t udp_pkts[TUNNEL_BATCH_MAX][TUNNEL_PKT_MAX_LEN];
+	struct iovec recv_iovs[TUNNEL_BATCH_MAX];
+	struct mmsghdr recv_msgs[TUNNEL_BATCH_MAX];
+	uint8_t ip_pkts[TUNNEL_BATCH_MAX][TUNNEL_PKT_MAX_LEN];
+	size_t ip_pkts_len[TUNNEL_BATCH_MAX];
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static void tunnel_interrupt(int signum);
+
+static int tun_create(const char *const name);
+static int udp_create(const char *const local_addr,
+                      const char *const local_port,
+                      const char *const remote_addr,
+                      const char *const remote_port);
+static bool tunnel_create_rohc(struct tunnel *const tunnel,
+                               const rohc_cid_type_t cid_type,
+                               const rohc_cid_t max_cid,
+                               const int proto_version,
+                               const rohc_mode_t mode);
+
+static bool tunnel_run_single(struct tunnel *const tunnel);
+static bool tunnel_run_split(struct tunnel *const tunnel);
+static void * tunnel_comp_thread(void *const arg);
+static void * tunnel_decomp_thread(void *const arg);
+
+static bool tunnel_comp_batch(struct tunnel *const tunnel);
+static bool tunnel_decomp_batch(struct tunnel *const tunnel);
+static bool tunnel_flush_feedbacks(struct tunnel *const tunnel);
+static bool tunnel_udp_send(struct tunnel *const tunnel, const size_t msgs_nr);
+
+static uint64_t tunnel_now_ns(void);
+static struct rohc_ts tunnel_now_ts(void);
+static void tunnel_stage_add(struct tunnel_stage_stats *const stage,
+                             const uint64_t start_ns,
+                             const size_t pkts_nr);
+static void tunnel_print_stats(const struct tunnel *const tunnel);
+
+static int gen_random_num(const struct rohc_comp *const comp,
+                          void *const user_context);
+
+
+/** Whether the program shall stop or not */
+static volatile sig_atomic_t stop_program;
+
+
+/**
+ * @brief Main function for the ROHC tunnel application
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	struct tunnel *tunnel;
+	char *tun_name = NULL;
+	char *local_addr = NULL;
+	char *local_port = NULL;
+	char *remote_addr = NULL;
+	char *remote_port = NULL;
+	int batch_len = TUNNEL_BATCH_DEFAULT;
+	int max_contexts = ROHC_SMALL_CID_MAX + 1;
+	int proto_version = 1; /* ROHC protocol version, v1 by default */
+	rohc_mode_t mode = ROHC_O_MODE;
+	tunnel_threads_t threads = TUNNEL_THREADS_SINGLE;
+	rohc_cid_type_t cid_type;
+	bool is_ok;
+	int args_used;
+	size_t i;
+
+	/* by default, we don't stop */
+	stop_program = 0;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc <= 1)
+	{
+		usage();
+		goto error;
+	}
+
+	for(argc--, argv++; argc > 0; argc -= args_used, argv += args_used)
+	{
+		args_used = 1;
+
+		if(!strcmp(*argv, "-v") || !strcmp(*argv, "--version"))
+		{
+			/* print version */
+			printf("rohc_tunnel version %s\n", rohc_version());
+			goto error;
+		}
+		else if(!strcmp(*argv, "-h") || !strcmp(*argv, "--help"))
+		{
+			/* print help */
+			usage();
+			goto error;
+		}
+		else if(!strcmp(*argv, "-b") || !strcmp(*argv, "--batch"))
+		{
+			/* get the maximal number of packets in one batch */
+			if(argc <= 1)
+			{
+				TUNNEL_LOG("missing mandatory -b/--batch parameter");
+				usage();
+				goto error;
+			}
+			batch_len = atoi(argv[1]);
+			args_used++;
+		}
+		else if(!strcmp(*argv, "-t") || !strcmp(*argv, "--threads"))
+		{
+			/* get the thread model */
+			if(argc <= 1)
+			{
+				TUNNEL_LOG("missing mandatory -t/--threads parameter");
+				usage();
+				goto error;
+			}
+			if(!strcmp(argv[1], "single"))
+			{
+				threads = TUNNEL_THREADS_SINGLE;
+			}
+			else if(!strcmp(argv[1], "split"))
+			{
+				threads = TUNNEL_THREADS_SPLIT;
+			}
+			else
+			{
+				TUNNEL_LOG("unknown thread model '%s'", argv[1]);
+				usage();
+				goto error;
+			}
+			args_used++;
+		}
+		else if(!strcmp(*argv, "-m") || !strcmp(*argv, "--max-contexts"))
+		{
+			/* get the maximum number of contexts the tunnel should use */
+			if(argc <= 1)
+			{
+				TUNNEL_LOG("missing mandatory -m/--max-contexts parameter");
+				usage();
+				goto error;
+			}
+			max_contexts = atoi(argv[1]);
+			args_used++;
+		}
+		else if(!strcmp(*argv, "--rohc-version"))
+		{
+			/* get the ROHC version to use */
+			if(argc <= 1)
+			{
+				TUNNEL_LOG("option --rohc-version takes one argument");
+				usage();
+				goto error;
+			}
+			proto_version = atoi(argv[1]);
+			args_used++;
+		}
+		else if(!strcmp(*argv, "--mode"))
+		{
+			/* get the target mode of the decompressor */
+			if(argc <= 1)
+			{
+				TUNNEL_LOG("option --mode takes one argument");
+				usage();
+				goto error;
+			}
+			if(!strcmp(argv[1], "U"))
+			{
+				mode = ROHC_U_MODE;
+			}
+			else if(!strcmp(argv[1], "O"))
+			{
+				mode = ROHC_O_MODE;
+			}
+			else
+			{
+				TUNNEL_LOG("unknown mode '%s'", argv[1]);
+				usage();
+				goto error;
+			}
+			args_used++;
+		}
+		else if(tun_name == NULL)
+		{
+			tun_name = argv[0];
+		}
+		else if(local_addr == NULL)
+		{
+			local_addr = argv[0];
+		}
+		else if(local_port == NULL)
+		{
+			local_port = argv[0];
+		}
+		else if(remote_addr == NULL)
+		{
+			remote_addr = argv[0];
+		}
+		else if(remote_port == NULL)
+		{
+			remote_port = argv[0];
+		}
+		else
+		{
+			/* do not accept more parameters without option name */
+			usage();
+			goto error;
+		}
+	}
+
+	/* check mandatory parameters */
+	if(remote_port == NULL)
+	{
+		TUNNEL_LOG("missing mandatory parameters");
+		usage();
+		goto error;
+	}
+	if(batch_len < 1 || (size_t) batch_len > TUNNEL_BATCH_MAX)
+	{
+		TUNNEL_LOG("the number of packets in one batch should be between 1 "
+		           "and %u", TUNNEL_BATCH_MAX);
+		usage();
+		goto error;
+	}
+	if(max_contexts < 1 || (size_t) max_contexts > (ROHC_LARGE_CID_MAX + 1))
+	{
+		TUNNEL_LOG("the maximum number of ROHC contexts should be between 1 "
+		           "and %u", ROHC_LARGE_CID_MAX + 1);
+		usage();
+		goto error;
+	}
+	if(proto_version != 1 && proto_version != 2)
+	{
+		TUNNEL_LOG("unknown ROHC version %d", proto_version);
+		usage();
+		goto error;
+	}
+	cid_type = ((size_t) max_contexts > (ROHC_SMALL_CID_MAX + 1) ?
+	            ROHC_LARGE_CID : ROHC_SMALL_CID);
+
+	/* the tunnel is too large for the stack */
+	tunnel = calloc(1, sizeof(struct tunnel));
+	if(tunnel == NULL)
+	{
+		TUNNEL_LOG("failed to allocate memory for the tunnel");
+		goto error;
+	}
+	tunnel->batch_len = batch_len;
+	for(i = 0; i < TUNNEL_BATCH_MAX; i++)
+	{
+		tunnel->send_iovs[i].iov_base = tunnel->rohc_pkts[i];
+		tunnel->send_msgs[i].msg_hdr.msg_iov = &tunnel->send_iovs[i];
+		tunnel->send_msgs[i].msg_hdr.msg_iovlen = 1;
+		tunnel->recv_iovs[i].iov_base = tunnel->udp_pkts[i];
+		tunnel->recv_iovs[i].iov_len = TUNNEL_PKT_MAX_LEN;
+		tunnel->recv_msgs[i].msg_hdr.msg_iov = &tunnel->recv_iovs[i];
+		tunnel->recv_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+	if(pthread_mutex_init(&tunnel->comp_lock, NULL) != 0)
+	{
+		TUNNEL_LOG("failed to create the lock of the compressor");
+		goto free_tunnel;
+	}
+
+	/* create the TUN device and the UDP socket */
+	tunnel->tun_fd = tun_create(tun_name);
+	if(tunnel->tun_fd < 0)
+	{
+		goto destroy_lock;
+	}
+	tunnel->udp_fd = udp_create(local_addr, local_port, remote_addr, remote_port);
+	if(tunnel->udp_fd < 0)
+	{
+		goto close_tun;
+	}
+
+	/* create the ROHC compressor and decompressor */
+	if(!tunnel_create_rohc(tunnel, cid_type, max_contexts - 1, proto_version,
+	                       mode))
+	{
+		goto close_udp;
+	}
+
+	/* stop the tunnel on SIGINT and SIGTERM */
+	signal(SIGINT, tunnel_interrupt);
+	signal(SIGTERM, tunnel_interrupt);
+
+	TUNNEL_LOG("tunnel %s: %s:%s <-> %s:%s, batches of %d packets, %s "
+	           "thread model", tun_name, local_addr, local_port, remote_addr,
+	           remote_port, batch_len,
+	           threads == TUNNEL_THREADS_SINGLE ? "single" : "split");
+
+	/* run the tunnel until it is stopped */
+	if(threads == TUNNEL_THREADS_SINGLE)
+	{
+		is_ok = tunnel_run_single(tunnel);
+	}
+	else
+	{
+		is_ok = tunnel_run_split(tunnel);
+	}
+
+	tunnel_print_stats(tunnel);
+
+	rohc_decomp_free(tunnel->decomp);
+	rohc_comp_free(tunnel->comp);
+	close(tunnel->udp_fd);
+	close(tunnel->tun_fd);
+	pthread_mutex_destroy(&tunnel->comp_lock);
+	free(tunnel);
+
+	return (is_ok ? 0 : 1);
+
+close_udp:
+	close(tunnel->udp_fd);
+close_tun:
+	close(tunnel->tun_fd);
+destroy_lock:
+	pthread_mutex_destroy(&tunnel->comp_lock);
+free_tunnel:
+	free(tunnel);
+error:
+	return 1;
+}
+
+
+/**
+ * @brief Print usage of the tunnel application
+ */
+static void usage(void)
+{
+	printf("The ROHC tunnel compresses the IP packets of a TUN device and\n"
+	       "sends them to a remote ROHC tunnel over UDP\n"
+	       "\n"
+	       "You need to be root (or to have POSIX capability CAP_NET_ADMIN)\n"
+	       "to run the ROHC tunnel.\n"
+	       "\n"
+	       "Usage: rohc_tunnel [OPTIONS] TUN LADDR LPORT RADDR RPORT\n"
+	       "\n"
+	       "Options:\n"
+	       "  TUN                     The name of the TUN device to create\n"
+	       "  LADDR LPORT             The local address and UDP port\n"
+	       "  RADDR RPORT             The address and UDP port of the remote\n"
+	       "                          ROHC tunnel\n"
+	       "  -v, --version           Print version information and exit\n"
+	       "  -h, --help              Print this usage and exit\n"
+	       "  -b, --batch NUM         The maximal number of packets handled\n"
+	       "                          in one batch (default: %u, max: %u)\n"
+	       "  -t, --threads MODEL     The thread model among 'single' (one\n"
+	       "                          thread for both directions, default)\n"
+	       "                          and 'split' (one thread per direction)\n"
+	       "  -m, --max-contexts NUM  The maximum number of ROHC contexts to\n"
+	       "                          simultaneously use\n"
+	       "      --rohc-version NUM  The ROHC version to use: 1 for ROHCv1\n"
+	       "                          and 2 for ROHCv2\n"
+	       "      --mode MODE         The mode of the decompressor among 'U'\n"
+	       "                          and 'O' (default)\n"
+	       "\n"
+	       "Examples:\n"
+	       "  rohc_tunnel rohc0 10.0.0.1 5000 10.0.0.2 5000\n"
+	       "                          tunnel the packets of rohc0 to 10.0.0.2\n"
+	       "  rohc_tunnel -t split -b 64 rohc0 10.0.0.1 5000 10.0.0.2 5000\n"
+	       "                          same with one thread per direction and\n"
+	       "                          batches of 64 packets\n"
+	       "\n"
+	       "Report bugs to <" PACKAGE_BUGREPORT ">.\n",
+	       TUNNEL_BATCH_DEFAULT, TUNNEL_BATCH_MAX);
+}
+
+
+/**
+ * @brief Handle UNIX signals that interrupt the program
+ *
+ * @param signum  The received signal
+ */
+static void tunnel_interrupt(int signum __attribute__((unused)))
+{
+	/* end the program with next poll timeout */
+	stop_program = 1;
+}
+
+
+/**
+ * @brief Create the TUN device
+ *
+ * @param name  The name of the TUN device
+ * @return      The file descriptor of the TUN device, -1 in case of error
+ */
+static int tun_create(const char *const name)
+{
+	struct ifreq ifr;
+	int fd;
+
+	fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+	if(fd < 0)
+	{
+		TUNNEL_LOG("failed to open /dev/net/tun: %s (%d)", strerror(errno), errno);
+		goto error;
+	}
+
+	/* IP packets without packet information */
+	memset(&ifr, 0, sizeof(struct ifreq));
+	ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+	strncpy(ifr.ifr_name, name, IFNAMSIZ - 1);
+	if(ioctl(fd, TUNSETIFF, &ifr) < 0)
+	{
+		TUNNEL_LOG("failed to create TUN device '%s': %s (%d)", name,
+		           strerror(errno), errno);
+		goto close_fd;
+	}
+
+	return fd;
+
+close_fd:
+	close(fd);
+error:
+	return -1;
+}
+
+
+/**
+ * @brief Create the UDP socket connected to the remote tunnel endpoint
+ *
+ * @param local_addr   The local IPv4 or IPv6 address
+ * @param local_port   The local UDP port
+ * @param remote_addr  The IPv4 or IPv6 address of the remote endpoint
+ * @param remote_port  The UDP port of the remote endpoint
+ * @return             The UDP socket, -1 in case of error
+ */
+static int udp_create(const char *const local_addr,
+                      const char *const local_port,
+                      const char *const remote_addr,
+                      const char *const remote_port)
+{
+	struct addrinfo hints;
+	struct addrinfo *local;
+	struct addrinfo *remote;
+	int fd;
+	int ret;
+
+	memset(&hints, 0, sizeof(struct addrinfo));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_DGRAM;
+	hints.ai_flags = AI_NUMERICHOST | AI_NUMERICSERV;
+
+	ret = getaddrinfo(local_addr, local_port, &hints, &local);
+	if(ret != 0)
+	{
+		TUNNEL_LOG("invalid local address %s:%s: %s", local_addr, local_port,
+		           gai_strerror(ret));
+		goto error;
+	}
+	ret = getaddrinfo(remote_addr, remote_port, &hints, &remote);
+	if(ret != 0)
+	{
+		TUNNEL_LOG("invalid remote address %s:%s: %s", remote_addr, remote_port,
+		           gai_strerror(ret));
+		goto free_local;
+	}
+
+	fd = socket(local->ai_family, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+	if(fd < 0)
+	{
+		TUNNEL_LOG("failed to create UDP socket: %s (%d)", strerror(errno), errno);
+		goto free_remote;
+	}
+	if(bind(fd, local->ai_addr, local->ai_addrlen) != 0)
+	{
+		TUNNEL_LOG("failed to bind UDP socket on %s:%s: %s (%d)", local_addr,
+		           local_port, strerror(errno), errno);
+		goto close_fd;
+	}
+
+	/* a connected socket only receives the packets of the remote endpoint
+	 * and sends packets without destination address */
+	if(connect(fd, remote->ai_addr, remote->ai_addrlen) != 0)
+	{
+		TUNNEL_LOG("failed to connect UDP socket to %s:%s: %s (%d)", remote_addr,
+		           remote_port, strerror(errno), errno);
+		goto close_fd;
+	}
+
+	freeaddrinfo(remote);
+	freeaddrinfo(local);
+
+	return fd;
+
+close_fd:
+	close(fd);
+free_remote:
+	freeaddrinfo(remote);
+free_local:
+	freeaddrinfo(local);
+error:
+	return -1;
+}
+
+
+/**
+ * @brief Create the ROHC compressor and decompressor of the tunnel
+ *
+ * @param tunnel         The ROHC tunnel
+ * @param cid_type       The type of CIDs
+ * @param max_cid        The largest CID
+ * @param proto_version  The ROHC version: 1 for ROHCv1 and 2 for ROHCv2
+ * @param mode           The target mode of the decompressor
+ * @return               true if the compressor and decompressor were created,
+ *                       false otherwise
+ */
+static bool tunnel_create_rohc(struct tunnel *const tunnel,
+                               const rohc_cid_type_t cid_type,
+                               const rohc_cid_t max_cid,
+                               const int proto_version,
+                               const rohc_mode_t mode)
+{
+	bool is_ok;
+
+	tunnel->comp = rohc_comp_new2(cid_type, max_cid, gen_random_num, NULL);
+	if(tunnel->comp == NULL)
+	{
+		TUNNEL_LOG("failed to create the ROHC compressor");
+		goto error;
+	}
+	tunnel->decomp = rohc_decomp_new2(cid_type, max_cid, mode);
+	if(tunnel->decomp == NULL)
+	{
+		TUNNEL_LOG("failed to create the ROHC decompressor");
+		goto free_comp;
+	}
+
+	if(proto_version == 1)
+	{
+		is_ok = rohc_comp_enable_profiles(tunnel->comp, ROHC_PROFILE_UNCOMPRESSED,
+		                                  ROHC_PROFILE_RTP, ROHC_PROFILE_UDP,
+		                                  ROHC_PROFILE_ESP, ROHC_PROFILE_IP,
+		                                  ROHC_PROFILE_TCP, ROHC_PROFILE_UDPLITE,
+		                                  -1);
+		is_ok = is_ok &&
+		        rohc_decomp_enable_profiles(tunnel->decomp,
+		                                    ROHC_PROFILE_UNCOMPRESSED,
+		                                    ROHC_PROFILE_RTP, ROHC_PROFILE_UDP,
+		                                    ROHC_PROFILE_ESP, ROHC_PROFILE_IP,
+		                                    ROHC_PROFILE_TCP, ROHC_PROFILE_UDPLITE,
+		                                    -1);
+	}
+	else
+	{
+		is_ok = rohc_comp_enable_profiles(tunnel->comp, ROHC_PROFILE_UNCOMPRESSED,
+		                                  ROHCv2_PROFILE_IP_UDP_RTP,
+		                                  ROHCv2_PROFILE_IP_UDP,
+		                                  ROHCv2_PROFILE_IP_ESP,
+		                                  ROHCv2_PROFILE_IP, ROHC_PROFILE_TCP,
+		                                  ROHCv2_PROFILE_IP_UDPLITE, -1);
+		is_ok = is_ok &&
+		        rohc_decomp_enable_profiles(tunnel->decomp,
+		                                    ROHC_PROFILE_UNCOMPRESSED,
+		                                    ROHCv2_PROFILE_IP_UDP_RTP,
+		                                    ROHCv2_PROFILE_IP_UDP,
+		                                    ROHCv2_PROFILE_IP_ESP,
+		                                    ROHCv2_PROFILE_IP, ROHC_PROFILE_TCP,
+		                                    ROHCv2_PROFILE_IP_UDPLITE, -1);
+	}
+	if(!is_ok)
+	{
+		TUNNEL_LOG("failed to enable the ROHC profiles");
+		goto free_decomp;
+	}
+
+	/* piggyback the feedback of the local decompressor on the ROHC packets of
+	 * the local compressor, send it alone if it waits too long */
+	if(!rohc_comp_set_piggybacking(tunnel->comp, TUNNEL_PKT_MAX_LEN,
+	                               TUNNEL_FEEDBACK_DELAY))
+	{
+		TUNNEL_LOG("failed to configure feedback piggybacking");
+		goto free_decomp;
+	}
+
+	return true;
+
+free_decomp:
+	rohc_decomp_free(tunnel->decomp);
+free_comp:
+	rohc_comp_free(tunnel->comp);
+error:
+	return false;
+}
+
+
+/**
+ * @brief Run the tunnel with one thread for both directions
+ *
+ * @param tunnel  The ROHC tunnel
+ * @return        true if the tunnel was stopped, false in case of error
+ */
+static bool tunnel_run_single(struct tunnel *const tunnel)
+{
+	struct pollfd fds[2];
+
+	fds[0].fd = tunnel->tun_fd;
+	fds[0].events = POLLIN;
+	fds[1].fd = tunnel->udp_fd;
+	fds[1].events = POLLIN;
+
+	while(!stop_program)
+	{
+		const int ret = poll(fds, 2, TUNNEL_FEEDBACK_DELAY);
+		if(ret < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+			TUNNEL_LOG("failed to poll: %s (%d)", strerror(errno), errno);
+			goto error;
+		}
+
+		if((fds[0].revents & POLLIN) != 0 && !tunnel_comp_batch(tunnel))
+		{
+			goto error;
+		}
+		if((fds[1].revents & POLLIN) != 0 && !tunnel_decomp_batch(tunnel))
+		{
+			goto error;
+		}
+		if(!tunnel_flush_feedbacks(tunnel))
+		{
+			goto error;
+		}
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Run the tunnel with one thread per direction
+ *
+ * @param tunnel  The ROHC tunnel
+ * @return        true if the tunnel was stopped, false in case of error
+ */
+static bool tunnel_run_split(struct tunnel *const tunnel)
+{
+	pthread_t comp_thread;
+	pthread_t decomp_thread;
+	void *comp_ret;
+	void *decomp_ret;
+
+	if(pthread_create(&comp_thread, NULL, tunnel_comp_thread, tunnel) != 0)
+	{
+		TUNNEL_LOG("failed to create the compression thread");
+		goto error;
+	}
+	if(pthread_create(&decomp_thread, NULL, tunnel_decomp_thread, tunnel) != 0)
+	{
+		TUNNEL_LOG("failed to create the decompression thread");
+		stop_program = 1;
+		pthread_join(comp_thread, NULL);
+		goto error;
+	}
+
+	pthread_join(decomp_thread, &decomp_ret);
+	pthread_join(comp_thread, &comp_ret);
+
+	return (comp_ret == NULL && decomp_ret == NULL);
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief The thread that compresses the packets of the TUN device
+ *
+ * @param arg  The ROHC tunnel
+ * @return     NULL if the thread was stopped, the tunnel in case of error
+ */
+static void * tunnel_comp_thread(void *const arg)
+{
+	struct tunnel *const tunnel = arg;
+	struct pollfd fd;
+
+	fd.fd = tunnel->tun_fd;
+	fd.events = POLLIN;
+
+	while(!stop_program)
+	{
+		const int ret = poll(&fd, 1, TUNNEL_FEEDBACK_DELAY);
+		if(ret < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+			TUNNEL_LOG("failed to poll: %s (%d)", strerror(errno), errno);
+			goto error;
+		}
+
+		if((fd.revents & POLLIN) != 0 && !tunnel_comp_batch(tunnel))
+		{
+			goto error;
+		}
+		if(!tunnel_flush_feedbacks(tunnel))
+		{
+			goto error;
+		}
+	}
+
+	return NULL;
+
+error:
+	stop_program = 1;
+	return tunnel;
+}
+
+
+/**
+ * @brief The thread that decompresses the packets of the UDP socket
+ *
+ * @param arg  The ROHC tunnel
+ * @return     NULL if the thread was stopped, the tunnel in case of error
+ */
+static void * tunnel_decomp_thread(void *const arg)
+{
+	struct tunnel *const tunnel = arg;
+	struct pollfd fd;
+
+	fd.fd = tunnel->udp_fd;
+	fd.events = POLLIN;
+
+	while(!stop_program)
+	{
+		const int ret = poll(&fd, 1, TUNNEL_FEEDBACK_DELAY);
+		if(ret < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+			TUNNEL_LOG("failed to poll: %s (%d)", strerror(errno), errno);
+			goto error;
+		}
+
+		if((fd.revents & POLLIN) != 0 && !tunnel_decomp_batch(tunnel))
+		{
+			goto error;
+		}
+	}
+
+	return NULL;
+
+error:
+	stop_program = 1;
+	return tunnel;
+}
+
+
+/**
+ * @brief Compress one batch of packets from the TUN device
+ *
+ * @param tunnel  The ROHC tunnel
+ * @return        true if the batch was handled, false in case of error
+ */
+static bool tunnel_comp_batch(struct tunnel *const tunnel)
+{
+	const struct rohc_ts now = tunnel_now_ts();
+	size_t pkts_nr = 0;
+	size_t msgs_nr = 0;
+	uint64_t start_ns;
+	size_t i;
+
+	/* read one batch of IP packets from the TUN device: TUN devices do not
+	 * support recvmmsg(), so read them one by one until none is left */
+	start_ns = tunnel_now_ns();
+	while(pkts_nr < tunnel->batch_len)
+	{
+		const ssize_t len = read(tunnel->tun_fd, tunnel->tun_pkts[pkts_nr],
+		                         TUNNEL_PKT_MAX_LEN);
+		if(len < 0)
+		{
+			if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+			{
+				break;
+			}
+			TUNNEL_LOG("failed to read from TUN device: %s (%d)",
+			           strerror(errno), errno);
+			goto error;
+		}
+		tunnel->tun_pkts_len[pkts_nr] = len;
+		pkts_nr++;
+	}
+	tunnel_stage_add(&tunnel->stages[TUNNEL_STAGE_TUN_READ], start_ns, pkts_nr);
+	if(pkts_nr == 0)
+	{
+		goto skip;
+	}
+
+	/* compress the batch of IP packets */
+	start_ns = tunnel_now_ns();
+	pthread_mutex_lock(&tunnel->comp_lock);
+	for(i = 0; i < pkts_nr; i++)
+	{
+		const struct rohc_buf ip_pkt =
+			rohc_buf_init_full(tunnel->tun_pkts[i], tunnel->tun_pkts_len[i], now);
+		struct rohc_buf rohc_pkt =
+			rohc_buf_init_empty(tunnel->rohc_pkts[msgs_nr], TUNNEL_PKT_MAX_LEN);
+
+		if(rohc_compress4(tunnel->comp, ip_pkt, &rohc_pkt) != ROHC_STATUS_OK)
+		{
+			tunnel->comp_failures_nr++;
+			continue;
+		}
+		tunnel->send_iovs[msgs_nr].iov_len = rohc_pkt.len;
+		msgs_nr++;
+	}
+	pthread_mutex_unlock(&tunnel->comp_lock);
+	tunnel_stage_add(&tunnel->stages[TUNNEL_STAGE_COMP], start_ns, pkts_nr);
+
+	/* send the batch of ROHC packets */
+	start_ns = tunnel_now_ns();
+	if(!tunnel_udp_send(tunnel, msgs_nr))
+	{
+		goto error;
+	}
+	tunnel_stage_add(&tunnel->stages[TUNNEL_STAGE_UDP_SEND], start_ns, msgs_nr);
+
+skip:
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Decompress one batch of packets from the UDP socket
+ *
+ * @param tunnel  The ROHC tunnel
+ * @return        true if the batch was handled, false in case of error
+ */
+static bool tunnel_decomp_batch(struct tunnel *const tunnel)
+{
+	const struct rohc_ts now = tunnel_now_ts();
+	uint8_t rcvd_feedback_buf[TUNNEL_PKT_MAX_LEN];
+	uint8_t feedback_send_buf[TUNNEL_PKT_MAX_LEN];
+	size_t written_nr = 0;
+	uint64_t start_ns;
+	int msgs_nr;
+	int i;
+
+	/* receive one batch of ROHC packets */
+	start_ns = tunnel_now_ns();
+	msgs_nr = recvmmsg(tunnel->udp_fd, tunnel->recv_msgs, tunnel->batch_len,
+	                   MSG_DONTWAIT, NULL);
+	if(msgs_nr < 0)
+	{
+		if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+		{
+			goto skip;
+		}
+		TUNNEL_LOG("failed to receive from UDP socket: %s (%d)",
+		           strerror(errno), errno);
+		goto error;
+	}
+	tunnel_stage_add(&tunnel->stages[TUNNEL_STAGE_UDP_RECV], start_ns, msgs_nr);
+
+	/* decompress the batch of ROHC packets */
+	start_ns = tunnel_now_ns();
+	for(i = 0; i < msgs_nr; i++)
+	{
+		const struct rohc_buf rohc_pkt =
+			rohc_buf_init_full(tunnel->udp_pkts[i], tunnel->recv_msgs[i].msg_len,
+			                   now);
+		struct rohc_buf ip_pkt =
+			rohc_buf_init_empty(tunnel->ip_pkts[i], TUNNEL_PKT_MAX_LEN);
+		struct rohc_buf rcvd_feedback =
+			rohc_buf_init_empty(rcvd_feedback_buf, TUNNEL_PKT_MAX_LEN);
+		struct rohc_buf feedback_send =
+			rohc_buf_init_empty(feedback_send_buf, TUNNEL_PKT_MAX_LEN);
+
+		if(rohc_decompress3(tunnel->decomp, rohc_pkt, &ip_pkt, &rcvd_feedback,
+		                    &feedback_send) != ROHC_STATUS_OK)
+		{
+			tunnel->decomp_failures_nr++;
+			ip_pkt.len = 0;
+		}
+		tunnel->ip_pkts_len[i] = ip_pkt.len;
+
+		/* the received feedback is for the local compressor, the feedback to
+		 * send is piggybacked by the local compressor */
+		if(rcvd_feedback.len > 0 || feedback_send.len > 0)
+		{
+			feedback_send.time = now;
+			pthread_mutex_lock(&tunnel->comp_lock);
+			if(!rohc_comp_deliver_feedback2(tunnel->comp, rcvd_feedback))
+			{
+				TUNNEL_LOG("failed to deliver received feedback to compressor");
+			}
+			if(!rohc_comp_piggyback_feedback(tunnel->comp, feedback_send))
+			{
+				TUNNEL_LOG("failed to queue feedback for piggybacking");
+			}
+			pthread_mutex_unlock(&tunnel->comp_lock);
+		}
+	}
+	tunnel_stage_add(&tunnel->stages[TUNNEL_STAGE_DECOMP], start_ns, msgs_nr);
+
+	/* write the IP packets to the TUN device, one by one */
+	start_ns = tunnel_now_ns();
+	for(i = 0; i < msgs_nr; i++)
+	{
+		if(tunnel->ip_pkts_len[i] == 0)
+		{
+			continue; /* decompression failed or feedback-only packet */
+		}
+		if(write(tunnel->tun_fd, tunnel->ip_pkts[i], tunnel->ip_pkts_len[i]) < 0)
+		{
+			tunnel->drops_nr++;
+			continue;
+		}
+		written_nr++;
+	}
+	tunnel_stage_add(&tunnel->stages[TUNNEL_STAGE_TUN_WRITE], start_ns,
+	                 written_nr);
+
+skip:
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Send the feedback that waited too long for piggybacking
+ *
+ * @param tunnel  The ROHC tunnel
+ * @return        true if the feedback was sent (if any), false in case of error
+ */
+static bool tunnel_flush_feedbacks(struct tunnel *const tunnel)
+{
+	struct rohc_buf feedback_pkt =
+		rohc_buf_init_empty(tunnel->rohc_pkts[0], TUNNEL_PKT_MAX_LEN);
+	bool is_ok;
+
+	pthread_mutex_lock(&tunnel->comp_lock);
+	is_ok = rohc_comp_flush_feedbacks(tunnel->comp, tunnel_now_ts(),
+	                                  &feedback_pkt);
+	pthread_mutex_unlock(&tunnel->comp_lock);
+	if(!is_ok)
+	{
+		TUNNEL_LOG("failed to flush feedback");
+		goto error;
+	}
+
+	if(feedback_pkt.len > 0)
+	{
+		tunnel->send_iovs[0].iov_len = feedback_pkt.len;
+		if(!tunnel_udp_send(tunnel, 1))
+		{
+			goto error;
+		}
+		tunnel->feedbacks_nr++;
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Send the given number of ROHC packets with as few syscalls as possible
+ *
+ * @param tunnel   The ROHC tunnel
+ * @param msgs_nr  The number of ROHC packets to send
+ * @return         true if the packets were sent or dropped,
+ *                 false in case of error
+ */
+static bool tunnel_udp_send(struct tunnel *const tunnel, const size_t msgs_nr)
+{
+	size_t sent_nr = 0;
+
+	while(sent_nr < msgs_nr)
+	{
+		const int ret = sendmmsg(tunnel->udp_fd, tunnel->send_msgs + sent_nr,
+		                         msgs_nr - sent_nr, 0);
+		if(ret < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+			if(errno == EAGAIN || errno == EWOULDBLOCK ||
+			   errno == ECONNREFUSED || errno == ENOBUFS)
+			{
+				/* drop the first packet, retry with the next ones */
+				tunnel->drops_nr++;
+				sent_nr++;
+				continue;
+			}
+			TUNNEL_LOG("failed to send to UDP socket: %s (%d)",
+			           strerror(errno), errno);
+			goto error;
+		}
+		sent_nr += ret;
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Get the current time in nanoseconds
+ *
+ * @return  The current time of the monotonic clock (in nanoseconds)
+ */
+static uint64_t tunnel_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t) ts.tv_sec) * 1000000000U + ts.tv_nsec;
+}
+
+
+/**
+ * @brief Get the current time for the ROHC library
+ *
+ * @return  The current time of the monotonic clock
+ */
+static struct rohc_ts tunnel_now_ts(void)
+{
+	struct rohc_ts now;
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now.sec = ts.tv_sec;
+	now.nsec = ts.tv_nsec;
+
+	return now;
+}
+
+
+/**
+ * @brief Account one batch handled by one stage of the data path
+ *
+ * @param stage     The statistics of the stage
+ * @param start_ns  The time the stage began to handle the batch
+ * @param pkts_nr   The number of packets in the batch
+ */
+static void tunnel_stage_add(struct tunnel_stage_stats *const stage,
+                             const uint64_t start_ns,
+                             const size_t pkts_nr)
+{
+	const uint64_t duration_ns = tunnel_now_ns() - start_ns;
+
+	stage->calls_nr++;
+	stage->pkts_nr += pkts_nr;
+	stage->total_ns += duration_ns;
+	if(duration_ns > stage->max_ns)
+	{
+		stage->max_ns = duration_ns;
+	}
+}
+
+
+/**
+ * @brief Print the statistics of the stages of the data path
+ *
+ * @param tunnel  The ROHC tunnel
+ */
+static void tunnel_print_stats(const struct tunnel *const tunnel)
+{
+	size_t i;
+
+	printf("%-14s %10s %10s %13s %13s %13s\n", "stage", "batches", "packets",
+	       "avg/batch(us)", "avg/pkt(us)", "max/batch(us)");
+	for(i = 0; i < TUNNEL_STAGE_MAX; i++)
+	{
+		const struct tunnel_stage_stats *const stage = &tunnel->stages[i];
+
+		printf("%-14s %10lu %10lu %13.3f %13.3f %13.3f\n",
+		       tunnel_stage_names[i], stage->calls_nr, stage->pkts_nr,
+		       stage->calls_nr == 0 ? 0.0 :
+		       (double) stage->total_ns / stage->calls_nr / 1000.0,
+		       stage->pkts_nr == 0 ? 0.0 :
+		       (double) stage->total_ns / stage->pkts_nr / 1000.0,
+		       (double) stage->max_ns / 1000.0);
+	}
+	printf("compression failures: %lu, decompression failures: %lu, "
+	       "dropped packets: %lu, feedback-only packets: %lu\n",
+	       tunnel->comp_failures_nr, tunnel->decomp_failures_nr,
+	       tunnel->drops_nr, tunnel->feedbacks_nr);
+}
+
+
+/**
+ * @brief Generate a random number
+ *
+ * @param comp          The ROHC compressor
+ * @param user_context  Should always be NULL
+ * @return              A random number
+ */
+static int gen_random_num(const struct rohc_comp *const comp __attribute__((unused)),
+                          void *const user_context __attribute__((unused)))
+{
+	return rand();
+}
@@ -88,6 +88,9 @@ EXPORT_SYMBOL_GPL(rohc_comp_get_segment2);
 
 /* feedback */
 EXPORT_SYMBOL_GPL(rohc_comp_deliver_feedback2);
+EXPORT_SYMBOL_GPL(rohc_comp_set_piggybacking);
+EXPORT_SYMBOL_GPL(rohc_comp_piggyback_feedback);
+EXPORT_SYMBOL_GPL(rohc_comp_flush_feedbacks);
 
 /* statistics */
 EXPORT_SYMBOL_GPL(rohc_comp_get_state_descr);
@@ -108,8 +111,13 @@ EXPORT_SYMBOL_GPL(rohc_comp_set_wlsb_window_width);
 EXPORT_SYMBOL_GPL(rohc_comp_set_reorder_ratio);
 EXPORT_SYMBOL_GPL(rohc_comp_set_periodic_refreshes);
 EXPORT_SYMBOL_GPL(rohc_comp_set_periodic_refreshes_time);
+EXPORT_SYMBOL_GPL(rohc_comp_set_periodic_refreshes_jitter);
+EXPORT_SYMBOL_GPL(rohc_comp_set_refreshes_rate);
 EXPORT_SYMBOL_GPL(rohc_comp_set_traces_cb2);
 EXPORT_SYMBOL_GPL(rohc_comp_set_features);
+EXPORT_SYMBOL_GPL(rohc_comp_set_ctxt_eviction);
+EXPORT_SYMBOL_GPL(rohc_comp_set_ctxt_prio);
+EXPORT_SYMBOL_GPL(rohc_comp_set_ctxt_admission);
 
 /* RTP-specific configuration */
 EXPORT_SYMBOL_GPL(rohc_comp_set_rtp_detection_cb);
@@ -123,6 +131,7 @@ EXPORT_SYMBOL_GPL(rohc_comp_set_rtp_detection_cb);
 EXPORT_SYMBOL_GPL(rohc_decomp_new2);
 EXPORT_SYMBOL_GPL(rohc_decomp_free);
 EXPORT_SYMBOL_GPL(rohc_decompress3);
+EXPORT_SYMBOL_GPL(rohc_decomp_get_cid);
 
 /* statistics */
 EXPORT_SYMBOL_GPL(rohc_decomp_get_state_descr);
@@ -50,6 +50,7 @@ typedef enum
 #define ROHC_LSB_SHIFT_TCP_TS_1B  ROHC_LSB_SHIFT_SN /**< real value for TCP TS */
 #define ROHC_LSB_SHIFT_TCP_TS_2B  ROHC_LSB_SHIFT_SN /**< real value for TCP TS */
 	ROHC_LSB_SHIFT_IP_ID      =  0,      /**< real value for IP-ID */
+#define ROHC_LSB_SHIFT_TCP_TS_UNCHANGED  ROHC_LSB_SHIFT_IP_ID /**< real value for TCP TS that may be unchanged */
 	ROHC_LSB_SHIFT_TCP_TTL    =  3,      /**< real value for TCP TTL/HL */
 #define ROHC_LSB_SHIFT_TCP_ACK_SCALED  ROHC_LSB_SHIFT_TCP_TTL
 	ROHC_LSB_SHIFT_TCP_SN     =  4,      /**< real value for TCP MSN */
@@ -29,6 +29,28 @@
 #include "rohc_traces_internal.h"
 
 
+/** The initial value of the FNV-1a hash used to compute the flow key */
+#define NET_PKT_KEY_INIT   2166136261U
+/** The prime of the FNV-1a hash used to compute the flow key */
+#define NET_PKT_KEY_PRIME  16777619U
+
+
+static rohc_ctxt_key_t net_pkt_key_add(rohc_ctxt_key_t key,
+                                       const uint8_t *const data,
+                                       const size_t len)
+	__attribute__((warn_unused_result, nonnull(2)));
+
+static rohc_ctxt_key_t net_pkt_key_add_ip(rohc_ctxt_key_t key,
+                                          const struct ip_packet *const ip)
+	__attribute__((warn_unused_result, nonnull(2)));
+
+static bool net_pkt_ip_is_fragment(const struct ip_packet *const ip)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+static void net_pkt_compute_keys(struct net_pkt *const packet)
+	__attribute__((nonnull(1)));
+
+
 /**
  * @brief Parse a network packet
  *
@@ -102,6 +124,12 @@ void net_pkt_parse(struct net_pkt *const packet,
 		/* get the transport protocol */
 		packet->transport = &packet->inner_ip.nl;
 	}
+
+	/* compute the keys of the flow */
+	net_pkt_compute_keys(packet);
+	rohc_debug(packet, trace_entity, ROHC_PROFILE_GENERAL,
+	           "flow key: 0x%08x, IP addresses key: 0x%08x", packet->key,
+	           packet->addrs_key);
 }
 
 
@@ -133,3 +161,136 @@ size_t net_pkt_get_payload_offset(const struct net_pkt *const packet)
 	return payload_offset;
 }
 
+
+/**
+ * @brief Compute the keys of the flow the given packet belongs to
+ *
+ * The IP addresses key is a hash of the IP versions, the IP addresses and
+ * the transport protocol. The flow key also hashes the UDP, UDP-Lite or TCP
+ * ports, or the ESP SPI. Two packets of the same flow always get the same
+ * keys, but two flows may share the same keys.
+ *
+ * The first bytes after the IP header of a non-first IP fragment are payload,
+ * not ports: the transport header is thus left out of the flow key of all the
+ * IP fragments, so that all the fragments of one flow share one key.
+ *
+ * @param packet  The packet to compute the flow keys for
+ */
+static void net_pkt_compute_keys(struct net_pkt *const packet)
+{
+	const uint8_t proto = packet->transport->proto;
+	rohc_ctxt_key_t key = NET_PKT_KEY_INIT;
+	bool is_fragment;
+
+	key = net_pkt_key_add_ip(key, &packet->outer_ip);
+	is_fragment = net_pkt_ip_is_fragment(&packet->outer_ip);
+	if(packet->ip_hdr_nr > 1)
+	{
+		key = net_pkt_key_add_ip(key, &packet->inner_ip);
+		is_fragment =
+			(is_fragment || net_pkt_ip_is_fragment(&packet->inner_ip));
+	}
+	key = net_pkt_key_add(key, &proto, 1);
+	packet->addrs_key = key;
+
+	/* the ports or the SPI are the first 4 bytes of the transport header */
+	if(!is_fragment &&
+	   (proto == ROHC_IPPROTO_UDP || proto == ROHC_IPPROTO_UDPLITE ||
+	    proto == ROHC_IPPROTO_TCP || proto == ROHC_IPPROTO_ESP) &&
+	   packet->transport->data != NULL && packet->transport->len >= 4)
+	{
+		key = net_pkt_key_add(key, packet->transport->data, 4);
+	}
+	packet->key = key;
+}
+
+
+/**
+ * @brief Whether the given IP header is the one of an IP fragment
+ *
+ * IPv4 fragments are detected thanks to the flags and fragment offset of the
+ * IPv4 header, IPv6 fragments thanks to a Fragment extension header. The
+ * chain of IPv6 extension headers is walked only once the parsing of the
+ * packet found the next layer behind it.
+ *
+ * @param ip  The IP header to check
+ * @return    true if the IP header is the one of an IP fragment,
+ *            false otherwise
+ */
+static bool net_pkt_ip_is_fragment(const struct ip_packet *const ip)
+{
+	bool is_fragment = false;
+
+	if(ip->version == IPV4)
+	{
+		is_fragment = ipv4_is_fragment(&ip->header.v4);
+	}
+	else if(ip->version == IPV6 && ip->nl.data != NULL)
+	{
+		const uint8_t *ext;
+		uint8_t ext_type;
+
+		ext = ip_get_next_ext_from_ip(ip, &ext_type);
+		while(!is_fragment && ext != NULL && ext < ip->nl.data)
+		{
+			is_fragment = (ext_type == ROHC_IPPROTO_FRAGMENT);
+			ext = ip_get_next_ext_from_ext(ext, &ext_type);
+		}
+	}
+
+	return is_fragment;
+}
+
+
+/**
+ * @brief Add the IP version and addresses of the given IP header to a flow key
+ *
+ * @param key  The flow key computed so far
+ * @param ip   The IP header to add to the flow key
+ * @return     The updated flow key
+ */
+static rohc_ctxt_key_t net_pkt_key_add_ip(rohc_ctxt_key_t key,
+                                          const struct ip_packet *const ip)
+{
+	const uint8_t version = ip->version;
+
+	key = net_pkt_key_add(key, &version, 1);
+	if(ip->version == IPV4)
+	{
+		key = net_pkt_key_add(key, (const uint8_t *) &ip->header.v4.saddr, 4);
+		key = net_pkt_key_add(key, (const uint8_t *) &ip->header.v4.daddr, 4);
+	}
+	else if(ip->version == IPV6)
+	{
+		key = net_pkt_key_add(key, (const uint8_t *) &ip->header.v6.saddr,
+		                      sizeof(struct ipv6_addr));
+		key = net_pkt_key_add(key, (const uint8_t *) &ip->header.v6.daddr,
+		                      sizeof(struct ipv6_addr));
+	}
+
+	return key;
+}
+
+
+/**
+ * @brief Add the given bytes to a flow key (FNV-1a hash)
+ *
+ * @param key   The flow key computed so far
+ * @param data  The bytes to add to the flow key
+ * @param len   The number of bytes to add to the flow key
+ * @return      The updated flow key
+ */
+static rohc_ctxt_key_t net_pkt_key_add(rohc_ctxt_key_t key,
+                                       const uint8_t *const data,
+                                       const size_t len)
+{
+	size_t i;
+
+	for(i = 0; i < len; i++)
+	{
+		key ^= data[i];
+		key *= NET_PKT_KEY_PRIME;
+	}
+
+	return key;
+}
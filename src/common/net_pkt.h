@@ -49,6 +49,9 @@ struct net_pkt
 
 	struct net_hdr *transport;   /**< The transport layer of the packet if any */
 
+	rohc_ctxt_key_t key;         /**< The key of the flow the packet belongs to */
+	rohc_ctxt_key_t addrs_key;   /**< The key of the IP addresses of the flow */
+
 	/** The callback function used to manage traces */
 	rohc_trace_callback2_t trace_callback;
 	/** The private context of the callback function used to manage traces */
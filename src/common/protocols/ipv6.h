@@ -172,6 +172,35 @@ _Static_assert(sizeof(struct ipv6_opt) == 3,
 #endif
 
 
+/** The Routing Type of the IPv6 Segment Routing Header (SRH) */
+#define IPV6_ROUTING_TYPE_SRH  4U
+
+/**
+ * @brief The fixed part of the IPv6 Segment Routing Header (SRH)
+ *
+ * The fixed part is followed by the segment list and by optional TLVs.
+ * See section 2 of RFC 8754 for details.
+ */
+struct ipv6_srh
+{
+	uint8_t next_header;    /**< The protocol of the next header */
+	uint8_t length;         /**< The length of the header in 8-byte units minus 1 */
+	uint8_t routing_type;   /**< The Routing Type, \ref IPV6_ROUTING_TYPE_SRH */
+	uint8_t segments_left;  /**< The index of the active segment */
+	uint8_t last_entry;     /**< The index of the last segment */
+	uint8_t flags;          /**< The SRH flags */
+	uint16_t tag;           /**< The tag of the packet */
+} __attribute__((packed));
+
+/* compiler sanity check for C11-compliant compilers and GCC >= 4.6 */
+#if ((defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L) || \
+     (defined(__GNUC__) && defined(__GNUC_MINOR__) && \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))))
+_Static_assert(sizeof(struct ipv6_srh) == 8,
+               "IPv6 SRH fixed part should exactly 8-byte long");
+#endif
+
+
 static inline uint8_t ipv6_get_tc(const struct ipv6_hdr *const ipv6)
 	__attribute__((warn_unused_result, nonnull(1), pure));
 static inline void ipv6_set_tc(struct ipv6_hdr *const ipv6, const uint8_t tc)
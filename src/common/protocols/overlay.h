@@ -0,0 +1,82 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   overlay.h
+ * @brief  The headers of the VXLAN and Geneve overlays carried over UDP
+ * @author agent <agent@local>
+ *
+ * See RFC 7348 for VXLAN and RFC 8926 for Geneve.
+ */
+
+#ifndef ROHC_PROTOCOLS_OVERLAY_H
+#define ROHC_PROTOCOLS_OVERLAY_H
+
+#include <stdint.h>
+
+
+/** The UDP destination port assigned to VXLAN */
+#define VXLAN_PORT  4789U
+
+/** The UDP destination port assigned to Geneve */
+#define GENEVE_PORT  6081U
+
+/** The VXLAN flags with the I flag set to indicate a valid VNI */
+#define VXLAN_FLAGS_VNI  0x08U
+
+/** The Geneve protocol type for inner Ethernet frames */
+#define GENEVE_PROTO_ETH  0x6558U
+
+/** The length of the inner Ethernet header (without any VLAN tag) */
+#define OVERLAY_ETH_HDR_LEN  14U
+
+
+/**
+ * @brief The VXLAN header
+ *
+ * See section 5 of RFC 7348 for details.
+ */
+struct vxlanhdr
+{
+	uint8_t flags;         /**< The VXLAN flags */
+	uint8_t reserved1[3];  /**< Reserved bits */
+	uint8_t vni[3];        /**< The VXLAN Network Identifier (VNI) */
+	uint8_t reserved2;     /**< Reserved bits */
+} __attribute__((packed));
+
+
+/**
+ * @brief The Geneve header without options
+ *
+ * See section 3.4 of RFC 8926 for details.
+ */
+struct genevehdr
+{
+	uint8_t ver_opt_len;   /**< The version and the length of the options */
+	uint8_t flags;         /**< The O and C flags */
+	uint16_t proto;        /**< The protocol type of the inner frame */
+	uint8_t vni[3];        /**< The Virtual Network Identifier (VNI) */
+	uint8_t reserved;      /**< Reserved bits */
+} __attribute__((packed));
+
+
+/** The length of the overlay headers: VXLAN or Geneve + inner Ethernet */
+#define OVERLAY_HDRS_LEN  (sizeof(struct vxlanhdr) + OVERLAY_ETH_HDR_LEN)
+
+#endif
+
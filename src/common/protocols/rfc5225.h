@@ -289,6 +289,32 @@ typedef struct
 } __attribute__((packed)) udp_static_t;
 
 
+/************************************************************************
+ * Compressed overlay headers (non-standard)                            *
+ ************************************************************************/
+
+/** The types of the overlay headers that may follow the UDP header */
+typedef enum
+{
+	ROHC_OVERLAY_NONE   = 0,  /**< No overlay header */
+	ROHC_OVERLAY_VXLAN  = 1,  /**< VXLAN and inner Ethernet headers */
+	ROHC_OVERLAY_GENEVE = 2,  /**< Geneve without option and inner Ethernet headers */
+} rohc_overlay_t;
+
+
+/**
+ * @brief The overlay static part
+ *
+ * Not defined by RFC5225: appended to the UDP static part when the UDP
+ * overlays feature is enabled. The overlay headers are transmitted as is
+ * after the type if the type is not \ref ROHC_OVERLAY_NONE.
+ */
+typedef struct
+{
+	uint8_t type;  /**< The type of the overlay headers, see \ref rohc_overlay_t */
+} __attribute__((packed)) overlay_static_t;
+
+
 /**
  * @brief The UDP endpoint dynamic part
  *
@@ -122,6 +122,7 @@ void rohc_list_item_reset(struct rohc_list_item *const list_item)
 	/* item is not transmitted nor known yet */
 	list_item->known = false;
 	list_item->counter = 0;
+	list_item->fixed_part_only = false;
 
 	/* no data yet */
 	list_item->length = 0;
@@ -86,6 +86,9 @@ struct rohc_list_item
 	bool known;
 	/** How many times the item was transmitted? */
 	size_t counter;
+	/** Is only the fixed part of the item transmitted? (non-standard, for
+	 *  IPv6 Segment Routing Headers with an unchanged segment list) */
+	bool fixed_part_only;
 
 /**
  * @brief The maximum length (in bytes) of item data
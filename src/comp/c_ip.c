@@ -41,6 +41,9 @@ static bool rohc_ip_ctxt_create(struct rohc_comp_ctxt *const context,
                                 const struct net_pkt *const packet)
 	__attribute__((warn_unused_result, nonnull(1, 2)));
 
+static bool c_ip_is_uo1_ip_id_possible(const struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt)
+	__attribute__((warn_unused_result, nonnull(1), pure));
+
 
 /*
  * Definitions of public functions
@@ -394,10 +397,9 @@ rohc_packet_t c_ip_decide_SO_packet(const struct rohc_comp_ctxt *context)
 			rohc_comp_debug(context, "choose packet UO-0");
 		}
 		else if(rohc_comp_rfc3095_is_sn_possible(rfc3095_ctxt, 5, 0) &&
-		        is_outer_ip_id_bits_possible(rfc3095_ctxt, 6) &&
-		        no_inner_ip_id_bits_required(rfc3095_ctxt))
+		        c_ip_is_uo1_ip_id_possible(rfc3095_ctxt))
 		{
-			packet = ROHC_PACKET_UO_1; /* IPv4 only for outer header */
+			packet = ROHC_PACKET_UO_1; /* IPv4 only */
 			rohc_comp_debug(context, "choose packet UO-1");
 		}
 		else if(rohc_comp_rfc3095_is_sn_possible(rfc3095_ctxt, 5, 8))
@@ -421,6 +423,40 @@ rohc_packet_t c_ip_decide_SO_packet(const struct rohc_comp_ctxt *context)
 }
 
 
+/**
+ * @brief May the UO-1 packet transmit the IP-ID bits of both IP headers?
+ *
+ * The UO-1 packet transmits up to 6 IP-ID bits of one IP header only: the
+ * innermost IPv4 header with a non-random IP-ID, or the outer IP header if
+ * the inner one is not such an IPv4 header. The other IP header shall not
+ * require any IP-ID bit, otherwise its IP-ID would be lost.
+ *
+ * @param rfc3095_ctxt  The compression context with two IP headers
+ * @return              true if the UO-1 packet may transmit the IP-ID bits,
+ *                      false otherwise
+ */
+static bool c_ip_is_uo1_ip_id_possible(const struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt)
+{
+	bool is_uo1_ip_id_possible;
+
+	assert(rfc3095_ctxt->ip_hdr_nr == 2);
+
+	if(rfc3095_ctxt->inner_ip_flags.version == IPV4 &&
+	   rfc3095_ctxt->inner_ip_flags.info.v4.rnd != 1)
+	{
+		is_uo1_ip_id_possible =
+			(is_inner_ip_id_bits_possible(rfc3095_ctxt, 6) &&
+			 no_outer_ip_id_bits_required(rfc3095_ctxt));
+	}
+	else
+	{
+		is_uo1_ip_id_possible = is_outer_ip_id_bits_possible(rfc3095_ctxt, 6);
+	}
+
+	return is_uo1_ip_id_possible;
+}
+
+
 /**
  * @brief Determine the SN value for the next packet
  *
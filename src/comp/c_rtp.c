@@ -554,7 +554,6 @@ static rohc_packet_t c_rtp_decide_SO_packet(const struct rohc_comp_ctxt *context
 	unsigned int nr_ipv4_non_rnd;
 	unsigned int nr_ipv4_non_rnd_with_bits;
 	size_t nr_innermost_ip_id_bits;
-	size_t nr_outermost_ip_id_bits;
 	bool is_outer_ipv4_non_rnd;
 	int is_rnd;
 	int is_ip_v4;
@@ -570,7 +569,7 @@ static rohc_packet_t c_rtp_decide_SO_packet(const struct rohc_comp_ctxt *context
 	is_ip_v4 = (rfc3095_ctxt->outer_ip_flags.version == IPV4);
 	is_outer_ipv4_non_rnd = (is_ip_v4 && !is_rnd);
 
-	is_ts_deducible = rohc_ts_sc_is_deducible(&rtp_context->ts_sc);
+	is_ts_deducible = rfc3095_ctxt->tmp.bits.ts_deducible;
 	is_ts_scaled = (rtp_context->ts_sc.state == SEND_SCALED);
 
 	rohc_comp_debug(context, "nr_ip_bits = %zd, is_ts_deducible = %d, "
@@ -629,10 +628,9 @@ static rohc_packet_t c_rtp_decide_SO_packet(const struct rohc_comp_ctxt *context
 	rohc_comp_debug(context, "nr_ipv4_non_rnd = %u, nr_ipv4_non_rnd_with_bits = %u",
 	                nr_ipv4_non_rnd, nr_ipv4_non_rnd_with_bits);
 
-	/* determine the number of IP-ID bits and the IP-ID offset of the
-	 * innermost IPv4 header with non-random IP-ID */
-	rohc_get_ipid_bits(context, &nr_innermost_ip_id_bits,
-	                   &nr_outermost_ip_id_bits);
+	/* the number of IP-ID bits of the innermost IPv4 header with non-random
+	 * IP-ID was computed along with the other fields */
+	nr_innermost_ip_id_bits = rfc3095_ctxt->tmp.bits.ip_id_innermost;
 
 	/* what packet type do we choose? */
 	if(rtp_context->udp_checksum_change_count < MAX_IR_COUNT)
@@ -969,7 +967,8 @@ static bool rtp_encode_uncomp_fields(struct rohc_comp_ctxt *const context,
 
 	/* add new TS value to context */
 	assert(rfc3095_ctxt->sn <= 0xffff);
-	c_add_ts(&rtp_context->ts_sc, rohc_ntoh32(rtp->timestamp), rfc3095_ctxt->sn);
+	c_add_ts(&rtp_context->ts_sc, rohc_ntoh32(rtp->timestamp), rfc3095_ctxt->sn,
+	         context->oa_repetitions_nr);
 
 	/* determine the number of TS bits to send wrt compression state */
 	if(rtp_context->ts_sc.state == INIT_TS ||
@@ -1016,6 +1015,13 @@ static bool rtp_encode_uncomp_fields(struct rohc_comp_ctxt *const context,
 	                rtp_context->tmp.nr_ts_bits_less_equal_than_2,
 	                rtp_context->tmp.nr_ts_bits_more_than_2);
 
+	/* complete the numbers of bits used to select the packet type and the
+	 * extension with the RTP fields */
+	rfc3095_ctxt->tmp.bits.ts = rtp_context->tmp.nr_ts_bits_more_than_2;
+	rfc3095_ctxt->tmp.bits.ts_deducible =
+		rohc_ts_sc_is_deducible(&rtp_context->ts_sc);
+	rfc3095_ctxt->tmp.bits.marker = rtp_context->tmp.is_marker_bit_set;
+
 	return true;
 }
 
@@ -1238,20 +1244,20 @@ static size_t rtp_code_dynamic_rtp_part(const struct rohc_comp_ctxt *const conte
 
 			/* do we transmit the scaled RTP Timestamp (TS) in the next packet ? */
 			rtp_context->ts_sc.nr_init_stride_packets++;
-			if(rtp_context->ts_sc.nr_init_stride_packets >= ROHC_INIT_TS_STRIDE_MIN)
+			if(rtp_context->ts_sc.nr_init_stride_packets >= context->oa_repetitions_nr)
 			{
-				rohc_comp_debug(context, "TS_STRIDE transmitted at least %u "
+				rohc_comp_debug(context, "TS_STRIDE transmitted at least %zu "
 				                "times, so change from state INIT_STRIDE to "
-				                "SEND_SCALED", ROHC_INIT_TS_STRIDE_MIN);
+				                "SEND_SCALED", context->oa_repetitions_nr);
 				rtp_context->ts_sc.state = SEND_SCALED;
 			}
 			else
 			{
 				rohc_comp_debug(context, "TS_STRIDE transmitted only %zd times, "
-				                "so stay in state INIT_STRIDE (at least %u times "
+				                "so stay in state INIT_STRIDE (at least %zu times "
 				                "are required to change to state SEND_SCALED)",
 				                rtp_context->ts_sc.nr_init_stride_packets,
-				                ROHC_INIT_TS_STRIDE_MIN);
+				                context->oa_repetitions_nr);
 			}
 		}
 
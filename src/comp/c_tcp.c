@@ -106,7 +106,7 @@ static bool tcp_detect_changes(struct rohc_comp_ctxt *const context,
                                const struct tcphdr **const tcp)
 	__attribute__((warn_unused_result, nonnull(1, 2, 3, 4)));
 static bool tcp_detect_changes_ipv6_exts(struct rohc_comp_ctxt *const context,
-                                         ip_context_t *const ip_context,
+                                         const ip_context_t *const ip_context,
                                          uint8_t *const protocol,
                                          const uint8_t *const exts,
                                          const size_t max_exts_len,
@@ -118,6 +118,16 @@ static void tcp_decide_state(struct rohc_comp_ctxt *const context,
                              struct rohc_ts pkt_time)
 	__attribute__((nonnull(1)));
 
+static void tcp_update_context(struct rohc_comp_ctxt *const context,
+                               const struct net_pkt *const uncomp_pkt,
+                               const struct tcphdr *const tcp,
+                               const rohc_packet_t packet_type)
+	__attribute__((nonnull(1, 2, 3)));
+static void tcp_update_hdrs_cache(struct rohc_comp_ctxt *const context,
+                                  const struct net_pkt *const uncomp_pkt,
+                                  const struct tcphdr *const tcp)
+	__attribute__((nonnull(1, 2, 3)));
+
 static bool tcp_encode_uncomp_fields(struct rohc_comp_ctxt *const context,
                                      const struct net_pkt *const uncomp_pkt,
                                      const struct tcphdr *const tcp)
@@ -128,24 +138,25 @@ static bool tcp_encode_uncomp_ip_fields(struct rohc_comp_ctxt *const context,
 static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
                                          const struct tcphdr *const tcp)
 	__attribute__((warn_unused_result, nonnull(1, 2)));
+static size_t tcp_get_ts_lsb_short_bits(const struct rohc_comp_ctxt *const context,
+                                        struct c_wlsb *const wlsb,
+                                        const uint32_t ts,
+                                        const char *const descr)
+	__attribute__((warn_unused_result, nonnull(1, 2, 4)));
 
 static rohc_packet_t tcp_decide_packet(struct rohc_comp_ctxt *const context,
-                                       const ip_context_t *const ip_inner_context,
                                        const struct tcphdr *const tcp)
-	__attribute__((warn_unused_result, nonnull(1, 2, 3)));
+	__attribute__((warn_unused_result, nonnull(1, 2)));
 static rohc_packet_t tcp_decide_FO_packet(const struct rohc_comp_ctxt *const context,
-                                          const ip_context_t *const ip_inner_context,
                                           const struct tcphdr *const tcp)
-	__attribute__((warn_unused_result, nonnull(1, 2, 3)));
+	__attribute__((warn_unused_result, nonnull(1, 2)));
 static rohc_packet_t tcp_decide_SO_packet(const struct rohc_comp_ctxt *const context,
-                                          const ip_context_t *const ip_inner_context,
                                           const struct tcphdr *const tcp)
-	__attribute__((warn_unused_result, nonnull(1, 2, 3)));
+	__attribute__((warn_unused_result, nonnull(1, 2)));
 static rohc_packet_t tcp_decide_FO_SO_packet(const struct rohc_comp_ctxt *const context,
-                                             const ip_context_t *const ip_inner_context,
                                              const struct tcphdr *const tcp,
                                              const bool crc7_at_least)
-	__attribute__((warn_unused_result, nonnull(1, 2, 3)));
+	__attribute__((warn_unused_result, nonnull(1, 2)));
 static rohc_packet_t tcp_decide_FO_SO_packet_seq(const struct rohc_comp_ctxt *const context,
                                                  const struct tcphdr *const tcp,
                                                  const bool crc7_at_least)
@@ -402,6 +413,17 @@ static void c_tcp_feedback_ack(struct rohc_comp_ctxt *const context,
                                const size_t sn_bits_nr,
                                const bool sn_not_valid)
 	__attribute__((nonnull(1)));
+static void c_tcp_feedback_nack(struct rohc_comp_ctxt *const context,
+                                const bool is_static_nack)
+	__attribute__((nonnull(1)));
+static void c_tcp_reset_wlsb(struct sc_tcp_context *const tcp_context)
+	__attribute__((nonnull(1)));
+static void c_tcp_set_wlsb_width(struct sc_tcp_context *const tcp_context,
+                                 const size_t width)
+	__attribute__((nonnull(1)));
+static void c_tcp_set_wlsb_ack_driven(struct sc_tcp_context *const tcp_context,
+                                      const bool is_ack_driven)
+	__attribute__((nonnull(1)));
 
 
 /**
@@ -433,6 +455,9 @@ static bool c_tcp_create_from_ctxt(struct rohc_comp_ctxt *const ctxt,
 	ctxt->specific = tcp_ctxt;
 	memcpy(ctxt->specific, base_ctxt->specific, sizeof(struct sc_tcp_context));
 
+	/* the header chain of the base context is not the one of the new context */
+	c_hdrs_cache_reset(&tcp_ctxt->hdrs_cache);
+
 	/* keep the counter of compressed packets from the base context,
 	 * since it is used to init some compression algorithms and we
 	 * don't want the initialization to restart */
@@ -603,6 +628,7 @@ static bool c_tcp_create_from_pkt(struct rohc_comp_ctxt *const context,
 	assert(remain_len >= sizeof(struct tcphdr));
 	tcp = (struct tcphdr *) remain_data;
 	memcpy(&(tcp_context->old_tcphdr), tcp, sizeof(struct tcphdr));
+	c_hdrs_cache_reset(&tcp_context->hdrs_cache);
 
 	/* MSN */
 	wlsb_init(&tcp_context->msn_wlsb, 16, comp->wlsb_window_width, ROHC_LSB_SHIFT_TCP_SN);
@@ -925,6 +951,16 @@ static bool c_tcp_check_context(const struct rohc_comp_ctxt *const context,
 	 *  - IP addresses */
 	(*cr_score) = 0;
 
+	/* the packet belongs to the context if the static fields did not change
+	 * since the last packet of the context */
+	if(!(c_hdrs_cache_cmp(&tcp_context->hdrs_cache, packet->outer_ip.data,
+	                      packet->outer_ip.size) & ROHC_HDRS_STATIC))
+	{
+		rohc_comp_debug(context, "  same static fields as the last packet");
+		(*cr_score) = 3;
+		return true;
+	}
+
 	/* parse the IP headers (lengths already checked while checking profile) */
 	for(ip_hdr_pos = 0;
 	    ip_hdr_pos < tcp_context->ip_contexts_nr && rohc_is_tunneling(next_proto);
@@ -1115,10 +1151,14 @@ bad_context:
  * 1. Check if we have double IP headers.\n
  * 2. Check if the IP-ID fields are random and if they are in NBO.\n
  * 3. Decide in which state to go (IR, FO or SO).\n
- * 4. Decide how many bits are needed to send the IP-ID and SN fields and more
- *    important update the sliding windows.\n
+ * 4. Decide how many bits are needed to send the IP-ID and SN fields.\n
  * 5. Decide which packet type to send.\n
  * 6. Code the packet.\n
+ * 7. Update the context with the new values, including the sliding windows.\n
+ *
+ * Steps 1 to 6 only record the new values in the temporary variables of the
+ * context, so a packet that cannot be built leaves the W-LSB windows, the
+ * TCP options and the IP headers of the context unchanged.
  *
  * @param context           The compression context
  * @param uncomp_pkt        The uncompressed packet to encode
@@ -1172,13 +1212,7 @@ static int c_tcp_encode(struct rohc_comp_ctxt *const context,
 	}
 
 	/* decide which packet to send */
-	*packet_type = tcp_decide_packet(context, ip_inner_context, tcp);
-
-	/* does the packet update the decompressor context? */
-	if(rohc_packet_carry_crc_7_or_8(*packet_type))
-	{
-		tcp_context->msn_of_last_ctxt_updating_pkt = tcp_context->msn;
-	}
+	*packet_type = tcp_decide_packet(context, tcp);
 
 	/* code the chosen packet */
 	if((*packet_type) == ROHC_PACKET_UNKNOWN)
@@ -1217,52 +1251,238 @@ static int c_tcp_encode(struct rohc_comp_ctxt *const context,
 
 	rohc_comp_debug(context, "payload_offset = %zu", *payload_offset);
 
+	/* the packet was successfully built, update the context with it */
+	tcp_update_context(context, uncomp_pkt, tcp, *packet_type);
+
+	return counter;
+
+error:
+	return -1;
+}
+
+
+/**
+ * @brief Update the compression context with the successfully compressed packet
+ *
+ * All the new values that were computed while the packet was encoded are
+ * recorded in context at once: a packet that failed to be compressed shall
+ * not alter the context.
+ *
+ * @param context      The compression context to update
+ * @param uncomp_pkt   The uncompressed packet that updates the context
+ * @param tcp          The TCP header of the uncompressed packet
+ * @param packet_type  The type of ROHC packet that was built
+ */
+static void tcp_update_context(struct rohc_comp_ctxt *const context,
+                               const struct net_pkt *const uncomp_pkt,
+                               const struct tcphdr *const tcp,
+                               const rohc_packet_t packet_type)
+{
+	struct sc_tcp_context *const tcp_context = context->specific;
+	const uint16_t msn = tcp_context->tmp.msn;
+	const bool is_ir_cr = !!(packet_type == ROHC_PACKET_IR_CR);
+	const bool is_dyn_chain = !!(packet_type == ROHC_PACKET_IR ||
+	                             packet_type == ROHC_PACKET_IR_DYN);
+	const uint8_t *remain_data = uncomp_pkt->outer_ip.data;
+	size_t ip_hdr_pos;
+
 	rohc_comp_debug(context, "update context:");
 
-	/* update the context with the new numbers of IP extension headers */
+	/* one more packet transmitted in the current state */
+	switch(context->state)
+	{
+		case ROHC_COMP_STATE_IR:
+			context->ir_count++;
+			break;
+		case ROHC_COMP_STATE_CR:
+			context->cr_count++;
+			break;
+		case ROHC_COMP_STATE_FO:
+			context->fo_count++;
+			break;
+		case ROHC_COMP_STATE_SO:
+			context->so_count++;
+			break;
+		case ROHC_COMP_STATE_UNKNOWN:
+		default:
+			assert(0); /* should not happen */
+			break;
+	}
+
+	/* does the packet update the decompressor context? */
+	if(rohc_packet_carry_crc_7_or_8(packet_type))
+	{
+		tcp_context->msn_of_last_ctxt_updating_pkt = msn;
+	}
+
+	/* does the packet repair the context that a NACK reported as damaged? */
+	if(packet_type == ROHC_PACKET_IR ||
+	   packet_type == ROHC_PACKET_IR_CR ||
+	   packet_type == ROHC_PACKET_IR_DYN)
+	{
+		tcp_context->nack_refresh_pending = false;
+	}
+
+	/* MSN */
+	tcp_context->msn = msn;
+	c_add_wlsb(&tcp_context->msn_wlsb, msn, msn);
+
+	/* IP headers: the IR, IR-CR and IR-DYN packets transmit the dynamic parts
+	 * of all IP headers, the CO packets transmit the innermost one only */
+	for(ip_hdr_pos = 0; ip_hdr_pos < tcp_context->ip_contexts_nr; ip_hdr_pos++)
 	{
-		size_t ip_hdr_pos;
-		for(ip_hdr_pos = 0; ip_hdr_pos < tcp_context->ip_contexts_nr; ip_hdr_pos++)
+		const struct ip_hdr *const ip_hdr = (struct ip_hdr *) remain_data;
+		ip_context_t *const ip_context = &(tcp_context->ip_contexts[ip_hdr_pos]);
+		const bool is_innermost = !!(ip_hdr_pos + 1 == tcp_context->ip_contexts_nr);
+		const bool is_dyn_part = !!(is_dyn_chain || is_ir_cr || is_innermost);
+
+		rohc_comp_debug(context, "  update context of IP header #%zu:",
+		                ip_hdr_pos + 1);
+
+		if(ip_hdr->version == IPV4)
+		{
+			const struct ipv4_hdr *const ipv4 = (struct ipv4_hdr *) remain_data;
+
+			if(is_dyn_part)
+			{
+				if(!is_innermost)
+				{
+					/* only ROHC_IP_ID_BEHAVIOR_RAND or ROHC_IP_ID_BEHAVIOR_ZERO for
+					 * the outer IP headers */
+					ip_context->ctxt.v4.ip_id_behavior =
+						(ipv4->id == 0 ? ROHC_IP_ID_BEHAVIOR_ZERO : ROHC_IP_ID_BEHAVIOR_RAND);
+				}
+				else
+				{
+					ip_context->ctxt.v4.ip_id_behavior = tcp_context->tmp.ip_id_behavior;
+				}
+				ip_context->ctxt.v4.last_ip_id_behavior =
+					ip_context->ctxt.v4.ip_id_behavior;
+				ip_context->ctxt.v4.last_ip_id = rohc_ntoh16(ipv4->id);
+				ip_context->ctxt.v4.df = ipv4->df;
+				ip_context->ctxt.v4.dscp = ipv4->dscp;
+				ip_context->ctxt.v4.ttl = ipv4->ttl;
+			}
+			if(is_ir_cr)
+			{
+				ip_context->cr_ttl_hopl_present =
+					tcp_context->tmp.cr_ttl_hopl_present[ip_hdr_pos];
+			}
+			if(is_innermost)
+			{
+				c_add_wlsb(&tcp_context->ip_id_wlsb, msn, tcp_context->tmp.ip_id_delta);
+			}
+			remain_data += sizeof(struct ipv4_hdr);
+		}
+		else
 		{
-			rohc_comp_debug(context, "  update context of IP header #%zu:",
-			                ip_hdr_pos + 1);
-			tcp_context->ip_contexts[ip_hdr_pos].opts_nr =
-				tcp_context->tmp.ip_exts_nr[ip_hdr_pos];
-			rohc_comp_debug(context, "    %zu extension headers",
-			                tcp_context->ip_contexts[ip_hdr_pos].opts_nr);
+			const struct ipv6_hdr *const ipv6 = (struct ipv6_hdr *) remain_data;
+			size_t ext_pos;
+
+			assert(ip_hdr->version == IPV6);
+
+			if(is_dyn_part)
+			{
+				ip_context->ctxt.v6.dscp = ipv6_get_dscp(ipv6);
+				ip_context->ctxt.v6.hopl = ipv6->hl;
+			}
+			remain_data += sizeof(struct ipv6_hdr);
+
+			/* record the IPv6 extension headers */
+			for(ext_pos = 0; ext_pos < tcp_context->tmp.ip_exts_nr[ip_hdr_pos]; ext_pos++)
+			{
+				ip_option_context_t *const opt_ctxt = &(ip_context->opts[ext_pos]);
+				const struct ipv6_opt *const ext = (struct ipv6_opt *) remain_data;
+				const size_t ext_len = ipv6_opt_get_length(ext);
+
+				opt_ctxt->generic.option_length = ext_len;
+				memcpy(opt_ctxt->generic.data, ext->value, ext_len - 2);
+				remain_data += ext_len;
+			}
 		}
+		ip_context->opts_nr = tcp_context->tmp.ip_exts_nr[ip_hdr_pos];
+		rohc_comp_debug(context, "    %zu extension headers", ip_context->opts_nr);
+	}
+
+	/* innermost IPv4 TTL or IPv6 Hop Limit */
+	tcp_context->ttl_hopl_change_count = tcp_context->tmp.ttl_hopl_change_count;
+	c_add_wlsb(&tcp_context->ttl_hopl_wlsb, msn, tcp_context->tmp.ttl_hopl);
+
+	/* ECN */
+	tcp_context->ecn_used = tcp_context->tmp.ecn_used;
+	tcp_context->ecn_used_change_count = tcp_context->tmp.ecn_used_change_count;
+	tcp_context->ecn_used_zero_count = tcp_context->tmp.ecn_used_zero_count;
+
+	/* TCP window */
+	tcp_context->tcp_window_change_count = tcp_context->tmp.tcp_window_change_count;
+	c_add_wlsb(&tcp_context->window_wlsb, msn, rohc_ntoh16(tcp->window));
+
+	/* the dynamic chain transmits the TCP sequence number */
+	if(is_dyn_chain)
+	{
+		tcp_context->tcp_seq_num_change_count++;
+	}
+
+	/* Context Replication */
+	if(is_ir_cr)
+	{
+		tcp_context->cr_tcp_window_present = tcp_context->tmp.cr_tcp_window_present;
+		tcp_context->cr_tcp_urg_ptr_present = tcp_context->tmp.cr_tcp_urg_ptr_present;
+		tcp_context->cr_tcp_ack_num_present = tcp_context->tmp.cr_tcp_ack_num_present;
 	}
 
 	/* update the context with the new TCP header */
 	memcpy(&(tcp_context->old_tcphdr), tcp, sizeof(struct tcphdr));
+	tcp_update_hdrs_cache(context, uncomp_pkt, tcp);
 	tcp_context->seq_num = rohc_ntoh32(tcp->seq_num);
 	tcp_context->ack_num = rohc_ntoh32(tcp->ack_num);
 
-	/* sequence number */
-	c_add_wlsb(&tcp_context->seq_wlsb, tcp_context->msn, tcp_context->seq_num);
-	if(tcp_context->seq_num_factor != 0)
+	/* sequence number: the decompressor does not update the scaled sequence
+	 * number nor the residue with segments without payload, so neither does
+	 * the compressor */
+	c_add_wlsb(&tcp_context->seq_wlsb, msn, tcp_context->seq_num);
+	if(tcp_context->tmp.seq_num_factor != 0)
 	{
-		c_add_wlsb(&tcp_context->seq_scaled_wlsb, tcp_context->msn,
-		           tcp_context->seq_num_scaled);
+		tcp_context->seq_num_scaled = tcp_context->tmp.seq_num_scaled;
+		tcp_context->seq_num_residue = tcp_context->tmp.seq_num_residue;
+		tcp_context->seq_num_factor = tcp_context->tmp.seq_num_factor;
+		tcp_context->seq_num_scaling_nr = tcp_context->tmp.seq_num_scaling_nr;
+
+		/* the scaled sequence numbers computed with the previous factor or
+		 * residue are not references for the new scaled sequence numbers */
+		if(tcp_context->seq_num_scaling_nr == 0)
+		{
+			wlsb_reset(&tcp_context->seq_scaled_wlsb);
+		}
+		c_add_wlsb(&tcp_context->seq_scaled_wlsb, msn, tcp_context->seq_num_scaled);
 
 		/* sequence number sent once more, count the number of transmissions to
 		 * know when scaled sequence number is possible */
-		if(tcp_context->seq_num_scaling_nr < ROHC_INIT_TS_STRIDE_MIN)
+		if(tcp_context->seq_num_scaling_nr < context->oa_repetitions_nr)
 		{
 			tcp_context->seq_num_scaling_nr++;
 			rohc_comp_debug(context, "unscaled sequence number was transmitted "
-			                "%zu / %u times since the scaling factor or residue "
+			                "%zu / %zu times since the scaling factor or residue "
 			                "changed", tcp_context->seq_num_scaling_nr,
-			                ROHC_INIT_TS_STRIDE_MIN);
+			                context->oa_repetitions_nr);
 		}
 	}
 
 	/* ACK number */
-	c_add_wlsb(&tcp_context->ack_wlsb, tcp_context->msn, tcp_context->ack_num);
+	if(tcp_context->tmp.ack_delta != 0)
+	{
+		tcp_context->ack_deltas_width[tcp_context->ack_deltas_next] =
+			tcp_context->tmp.ack_delta;
+		tcp_context->ack_deltas_next = (tcp_context->ack_deltas_next + 1) % 20;
+	}
+	tcp_context->ack_stride = tcp_context->tmp.ack_stride;
+	tcp_context->ack_num_scaled = tcp_context->tmp.ack_num_scaled;
+	tcp_context->ack_num_residue = tcp_context->tmp.ack_num_residue;
+	tcp_context->ack_num_scaling_nr = tcp_context->tmp.ack_num_scaling_nr;
+	c_add_wlsb(&tcp_context->ack_wlsb, msn, tcp_context->ack_num);
 	if(tcp_context->ack_stride != 0)
 	{
-		c_add_wlsb(&tcp_context->ack_scaled_wlsb, tcp_context->msn,
-		           tcp_context->ack_num_scaled);
+		c_add_wlsb(&tcp_context->ack_scaled_wlsb, msn, tcp_context->ack_num_scaled);
 
 		/* ACK number sent once more, count the number of transmissions to
 		 * know when scaled ACK number is possible */
@@ -1275,10 +1495,105 @@ static int c_tcp_encode(struct rohc_comp_ctxt *const context,
 		}
 	}
 
-	return counter;
+	/* TCP options: all CO packets contain an irregular chain */
+	c_tcp_update_opts_ctxt(context, tcp, msn, !(is_dyn_chain || is_ir_cr),
+	                       &tcp_context->tcp_opts);
+}
 
-error:
-	return -1;
+
+/**
+ * @brief Record the IP headers and the TCP header of the packet for the
+ *        detection of changes in the next packet
+ *
+ * The bits of the header chain are classified only if the structure of the
+ * header chain changed. The bits that are not classified as static or inferred
+ * fields are dynamic fields. The TCP options are not cached.
+ *
+ * @param context     The compression context to update
+ * @param uncomp_pkt  The uncompressed packet that updates the context
+ * @param tcp         The TCP header of the uncompressed packet
+ */
+static void tcp_update_hdrs_cache(struct rohc_comp_ctxt *const context,
+                                  const struct net_pkt *const uncomp_pkt,
+                                  const struct tcphdr *const tcp)
+{
+	struct sc_tcp_context *const tcp_context = context->specific;
+	struct c_hdrs_cache *const cache = &tcp_context->hdrs_cache;
+	const uint8_t *const hdrs = uncomp_pkt->outer_ip.data;
+	const size_t hdrs_len = ((const uint8_t *) tcp) - hdrs + sizeof(struct tcphdr);
+	size_t offset;
+	size_t ip_hdr_pos;
+
+	/* same structure of headers, only record the new header chain */
+	if(cache->len != 0 && !(tcp_context->tmp.hdrs_changed & ROHC_HDRS_STATIC))
+	{
+		c_hdrs_cache_store(cache, hdrs);
+		return;
+	}
+
+	if(!c_hdrs_cache_set_len(cache, hdrs_len))
+	{
+		rohc_comp_debug(context, "%zu-byte header chain is too long to be cached",
+		                hdrs_len);
+		return;
+	}
+
+	/* classify the fields of the IP headers */
+	offset = 0;
+	for(ip_hdr_pos = 0; ip_hdr_pos < tcp_context->ip_contexts_nr; ip_hdr_pos++)
+	{
+		const struct ip_hdr *const ip_hdr = (struct ip_hdr *) (hdrs + offset);
+
+		if(ip_hdr->version == IPV4)
+		{
+			/* Version and IHL */
+			c_hdrs_cache_classify(cache, offset, 1, 0xff, ROHC_HDRS_STATIC);
+			/* Total Length and Identification */
+			c_hdrs_cache_classify(cache, offset + 2, 4, 0xff, ROHC_HDRS_INFERRED);
+			/* Protocol */
+			c_hdrs_cache_classify(cache, offset + 9, 1, 0xff, ROHC_HDRS_STATIC);
+			/* Header Checksum */
+			c_hdrs_cache_classify(cache, offset + 10, 2, 0xff, ROHC_HDRS_INFERRED);
+			/* Source and Destination Addresses */
+			c_hdrs_cache_classify(cache, offset + 12, 8, 0xff, ROHC_HDRS_STATIC);
+			offset += sizeof(struct ipv4_hdr);
+		}
+		else
+		{
+			size_t ext_pos;
+
+			assert(ip_hdr->version == IPV6);
+
+			/* Version, then Flow Label */
+			c_hdrs_cache_classify(cache, offset, 1, 0xf0, ROHC_HDRS_STATIC);
+			c_hdrs_cache_classify(cache, offset + 1, 1, 0x0f, ROHC_HDRS_STATIC);
+			c_hdrs_cache_classify(cache, offset + 2, 2, 0xff, ROHC_HDRS_STATIC);
+			/* Payload Length */
+			c_hdrs_cache_classify(cache, offset + 4, 2, 0xff, ROHC_HDRS_INFERRED);
+			/* Next Header */
+			c_hdrs_cache_classify(cache, offset + 6, 1, 0xff, ROHC_HDRS_STATIC);
+			/* Source and Destination Addresses */
+			c_hdrs_cache_classify(cache, offset + 8, 32, 0xff, ROHC_HDRS_STATIC);
+			offset += sizeof(struct ipv6_hdr);
+
+			/* Next Header and Length of the extension headers */
+			for(ext_pos = 0; ext_pos < tcp_context->tmp.ip_exts_nr[ip_hdr_pos]; ext_pos++)
+			{
+				const struct ipv6_opt *const ext = (struct ipv6_opt *) (hdrs + offset);
+
+				c_hdrs_cache_classify(cache, offset, 2, 0xff, ROHC_HDRS_STATIC);
+				offset += ipv6_opt_get_length(ext);
+			}
+		}
+	}
+	assert((offset + sizeof(struct tcphdr)) == hdrs_len);
+
+	/* classify the fields of the TCP header */
+	c_hdrs_cache_classify(cache, offset, 4, 0xff, ROHC_HDRS_STATIC); /* ports */
+	c_hdrs_cache_classify(cache, offset + 4, 8, 0xff, ROHC_HDRS_INFERRED); /* seq, ack */
+	c_hdrs_cache_classify(cache, offset + 16, 2, 0xff, ROHC_HDRS_INFERRED); /* checksum */
+
+	c_hdrs_cache_store(cache, hdrs);
 }
 
 
@@ -1372,15 +1687,23 @@ static int code_IR_packet(struct rohc_comp_ctxt *const context,
 
 	if(packet_type == ROHC_PACKET_IR || packet_type == ROHC_PACKET_IR_DYN)
 	{
-		/* add static chain for IR packet only */
+		/* add static chain for IR packet only, the one cached in context if the
+		 * static fields did not change since it was encoded */
 		if(packet_type == ROHC_PACKET_IR)
 		{
-			ret = tcp_code_static_part(context, ip, rohc_remain_data, rohc_remain_len);
-			if(ret < 0)
+			ret = rohc_comp_static_chain_reuse(context, rohc_remain_data,
+			                                   rohc_remain_len);
+			if(ret == 0)
 			{
-				rohc_comp_warn(context, "failed to build the static chain of the "
-				               "IR packet");
-				goto error;
+				ret = tcp_code_static_part(context, ip, rohc_remain_data,
+				                           rohc_remain_len);
+				if(ret < 0)
+				{
+					rohc_comp_warn(context, "failed to build the static chain of the "
+					               "IR packet");
+					goto error;
+				}
+				rohc_comp_static_chain_cache(context, rohc_remain_data, ret);
 			}
 			rohc_remain_data += ret;
 			rohc_remain_len -= ret;
@@ -1900,24 +2223,6 @@ static int co_baseheader(struct rohc_comp_ctxt *const context,
 
 	rohc_comp_dump_buf(context, "co_header", rohc_pkt, rohc_hdr_len);
 
-	/* update context with new values (done at the very end to avoid wrongly
-	 * updating the context in case of compression failure) */
-	assert(inner_ip_hdr_len >= 1);
-	if(inner_ip_hdr->version == IPV4)
-	{
-		const struct ipv4_hdr *const inner_ipv4 = (struct ipv4_hdr *) inner_ip_hdr;
-		inner_ip_ctxt->ctxt.v4.last_ip_id_behavior = inner_ip_ctxt->ctxt.v4.ip_id_behavior;
-		inner_ip_ctxt->ctxt.v4.last_ip_id = rohc_ntoh16(inner_ipv4->id);
-		inner_ip_ctxt->ctxt.v4.df = inner_ipv4->df;
-		inner_ip_ctxt->ctxt.vx.dscp = inner_ipv4->dscp;
-	}
-	else
-	{
-		const struct ipv6_hdr *const inner_ipv6 = (struct ipv6_hdr *) inner_ip_hdr;
-		inner_ip_ctxt->ctxt.vx.dscp = ipv6_get_dscp(inner_ipv6);
-	}
-	inner_ip_ctxt->ctxt.vx.ttl_hopl = tcp_context->tmp.ttl_hopl;
-
 	return rohc_hdr_len;
 
 error:
@@ -1962,7 +2267,7 @@ static int c_tcp_build_rnd_1(const struct rohc_comp_ctxt *const context,
 	seq_num = rohc_ntoh32(tcp->seq_num) & 0x3ffff;
 	rnd1->seq_num1 = (seq_num >> 16) & 0x3;
 	rnd1->seq_num2 = rohc_hton16(seq_num & 0xffff);
-	rnd1->msn = tcp_context->msn & 0xf;
+	rnd1->msn = tcp_context->tmp.msn & 0xf;
 	rnd1->psh_flag = tcp->psh_flag;
 	rnd1->header_crc = crc;
 
@@ -2006,8 +2311,8 @@ static int c_tcp_build_rnd_2(const struct rohc_comp_ctxt *const context,
 	}
 
 	rnd2->discriminator = 0x0c; /* '1100' */
-	rnd2->seq_num_scaled = tcp_context->seq_num_scaled & 0xf;
-	rnd2->msn = tcp_context->msn & 0xf;
+	rnd2->seq_num_scaled = tcp_context->tmp.seq_num_scaled & 0xf;
+	rnd2->msn = tcp_context->tmp.msn & 0xf;
 	rnd2->psh_flag = tcp->psh_flag;
 	rnd2->header_crc = crc;
 
@@ -2057,7 +2362,7 @@ static int c_tcp_build_rnd_3(const struct rohc_comp_ctxt *const context,
 	rnd3->ack_num2 = ack_num & 0xff;
 	rohc_comp_debug(context, "ack_number = 0x%04x (0x%02x 0x%02x)",
 	                ack_num, rnd3->ack_num1, rnd3->ack_num2);
-	rnd3->msn = tcp_context->msn & 0xf;
+	rnd3->msn = tcp_context->tmp.msn & 0xf;
 	rnd3->psh_flag = tcp->psh_flag;
 	rnd3->header_crc = crc;
 
@@ -2092,7 +2397,7 @@ static int c_tcp_build_rnd_4(const struct rohc_comp_ctxt *const context,
 {
 	rnd_4_t *const rnd4 = (rnd_4_t *) rohc_data;
 
-	assert(tcp_context->ack_stride != 0);
+	assert(tcp_context->tmp.ack_stride != 0);
 
 	if(rohc_max_len < sizeof(rnd_4_t))
 	{
@@ -2103,8 +2408,8 @@ static int c_tcp_build_rnd_4(const struct rohc_comp_ctxt *const context,
 	}
 
 	rnd4->discriminator = 0x0d; /* '1101' */
-	rnd4->ack_num_scaled = tcp_context->ack_num_scaled & 0xf;
-	rnd4->msn = tcp_context->msn & 0xf;
+	rnd4->ack_num_scaled = tcp_context->tmp.ack_num_scaled & 0xf;
+	rnd4->msn = tcp_context->tmp.msn & 0xf;
 	rnd4->psh_flag = tcp->psh_flag;
 	rnd4->header_crc = crc;
 
@@ -2151,7 +2456,7 @@ static int c_tcp_build_rnd_5(const struct rohc_comp_ctxt *const context,
 
 	rnd5->discriminator = 0x04; /* '100' */
 	rnd5->psh_flag = tcp->psh_flag;
-	rnd5->msn = tcp_context->msn & 0xf;
+	rnd5->msn = tcp_context->tmp.msn & 0xf;
 	rnd5->header_crc = crc;
 
 	/* sequence number */
@@ -2212,8 +2517,8 @@ static int c_tcp_build_rnd_6(const struct rohc_comp_ctxt *const context,
 	rnd6->header_crc = crc;
 	rnd6->psh_flag = tcp->psh_flag;
 	rnd6->ack_num = rohc_hton16(rohc_ntoh32(tcp->ack_num) & 0xffff);
-	rnd6->msn = tcp_context->msn & 0xf;
-	rnd6->seq_num_scaled = tcp_context->seq_num_scaled & 0xf;
+	rnd6->msn = tcp_context->tmp.msn & 0xf;
+	rnd6->seq_num_scaled = tcp_context->tmp.seq_num_scaled & 0xf;
 
 	return sizeof(rnd_6_t);
 
@@ -2260,7 +2565,7 @@ static int c_tcp_build_rnd_7(const struct rohc_comp_ctxt *const context,
 	rnd7->ack_num1 = (ack_num >> 16) & 0x03;
 	rnd7->ack_num2 = rohc_hton16(ack_num & 0xffff);
 	rnd7->window = tcp->window;
-	rnd7->msn = tcp_context->msn & 0xf;
+	rnd7->msn = tcp_context->tmp.msn & 0xf;
 	rnd7->psh_flag = tcp->psh_flag;
 	rnd7->header_crc = crc;
 
@@ -2321,7 +2626,7 @@ static int c_tcp_build_rnd_8(const struct rohc_comp_ctxt *const context,
 	rohc_comp_debug(context, "CRC 0x%x", rnd8->header_crc);
 
 	/* MSN */
-	msn = tcp_context->msn & 0xf;
+	msn = tcp_context->tmp.msn & 0xf;
 	rnd8->msn1 = (msn >> 3) & 0x01;
 	rnd8->msn2 = msn & 0x07;
 
@@ -2345,7 +2650,7 @@ static int c_tcp_build_rnd_8(const struct rohc_comp_ctxt *const context,
 		ttl_hl = ipv6->hl;
 	}
 	rnd8->ttl_hopl = ttl_hl & 0x7;
-	rnd8->ecn_used = GET_REAL(tcp_context->ecn_used);
+	rnd8->ecn_used = GET_REAL(tcp_context->tmp.ecn_used);
 
 	/* sequence number */
 	seq_num = rohc_ntoh32(tcp->seq_num) & 0xffff;
@@ -2365,8 +2670,8 @@ static int c_tcp_build_rnd_8(const struct rohc_comp_ctxt *const context,
 		 * the static option changed, compress them */
 		bool no_item_needed;
 		rnd8->list_present = 1;
-		ret = c_tcp_code_tcp_opts_list_item(context, tcp, tcp_context->msn,
-		                                    ROHC_CHAIN_CO, &tcp_context->tcp_opts,
+		ret = c_tcp_code_tcp_opts_list_item(context, tcp, ROHC_CHAIN_CO,
+		                                    &tcp_context->tcp_opts,
 		                                    rnd8->options,
 		                                    rohc_max_len - sizeof(rnd_8_t),
 		                                    &no_item_needed);
@@ -2440,7 +2745,7 @@ static int c_tcp_build_seq_1(const struct rohc_comp_ctxt *const context,
 	rohc_comp_debug(context, "4-bit IP-ID offset 0x%x", seq1->ip_id);
 	seq_num = rohc_ntoh32(tcp->seq_num) & 0xffff;
 	seq1->seq_num = rohc_hton16(seq_num);
-	seq1->msn = tcp_context->msn & 0xf;
+	seq1->msn = tcp_context->tmp.msn & 0xf;
 	seq1->psh_flag = tcp->psh_flag;
 	seq1->header_crc = crc;
 
@@ -2497,8 +2802,8 @@ static int c_tcp_build_seq_2(const struct rohc_comp_ctxt *const context,
 	seq2->ip_id1 = (tcp_context->tmp.ip_id_delta >> 4) & 0x7;
 	seq2->ip_id2 = tcp_context->tmp.ip_id_delta & 0xf;
 	rohc_comp_debug(context, "7-bit IP-ID offset 0x%x%x", seq2->ip_id1, seq2->ip_id2);
-	seq2->seq_num_scaled = tcp_context->seq_num_scaled & 0xf;
-	seq2->msn = tcp_context->msn & 0xf;
+	seq2->seq_num_scaled = tcp_context->tmp.seq_num_scaled & 0xf;
+	seq2->msn = tcp_context->tmp.msn & 0xf;
 	seq2->psh_flag = tcp->psh_flag;
 	seq2->header_crc = crc;
 
@@ -2555,7 +2860,7 @@ static int c_tcp_build_seq_3(const struct rohc_comp_ctxt *const context,
 	seq3->ip_id = tcp_context->tmp.ip_id_delta & 0xf;
 	rohc_comp_debug(context, "4-bit IP-ID offset 0x%x", seq3->ip_id);
 	seq3->ack_num = rohc_hton16(rohc_ntoh32(tcp->ack_num) & 0xffff);
-	seq3->msn = tcp_context->msn & 0xf;
+	seq3->msn = tcp_context->tmp.msn & 0xf;
 	seq3->psh_flag = tcp->psh_flag;
 	seq3->header_crc = crc;
 
@@ -2599,7 +2904,7 @@ static int c_tcp_build_seq_4(const struct rohc_comp_ctxt *const context,
 	assert(inner_ip_ctxt->ctxt.vx.version == IPV4);
 	assert(inner_ip_hdr_len >= sizeof(struct ipv4_hdr));
 	assert(inner_ip_hdr->version == IPV4);
-	assert(tcp_context->ack_stride != 0);
+	assert(tcp_context->tmp.ack_stride != 0);
 
 	if(rohc_max_len < sizeof(seq_4_t))
 	{
@@ -2610,10 +2915,10 @@ static int c_tcp_build_seq_4(const struct rohc_comp_ctxt *const context,
 	}
 
 	seq4->discriminator = 0x00; /* '0' */
-	seq4->ack_num_scaled = tcp_context->ack_num_scaled & 0xf;
+	seq4->ack_num_scaled = tcp_context->tmp.ack_num_scaled & 0xf;
 	seq4->ip_id = tcp_context->tmp.ip_id_delta & 0x7;
 	rohc_comp_debug(context, "3-bit IP-ID offset 0x%x", seq4->ip_id);
-	seq4->msn = tcp_context->msn & 0xf;
+	seq4->msn = tcp_context->tmp.msn & 0xf;
 	seq4->psh_flag = tcp->psh_flag;
 	seq4->header_crc = crc;
 
@@ -2673,7 +2978,7 @@ static int c_tcp_build_seq_5(const struct rohc_comp_ctxt *const context,
 	seq5->ack_num = rohc_hton16(rohc_ntoh32(tcp->ack_num) & 0xffff);
 	seq_num = rohc_ntoh32(tcp->seq_num) & 0xffff;
 	seq5->seq_num = rohc_hton16(seq_num);
-	seq5->msn = tcp_context->msn & 0xf;
+	seq5->msn = tcp_context->tmp.msn & 0xf;
 	seq5->psh_flag = tcp->psh_flag;
 	seq5->header_crc = crc;
 
@@ -2729,7 +3034,7 @@ static int c_tcp_build_seq_6(const struct rohc_comp_ctxt *const context,
 	seq6->discriminator = 0x1b; /* '11011' */
 
 	/* scaled sequence number */
-	seq_num_scaled = tcp_context->seq_num_scaled & 0xf;
+	seq_num_scaled = tcp_context->tmp.seq_num_scaled & 0xf;
 	seq6->seq_num_scaled1 = (seq_num_scaled >> 1) & 0x07;
 	seq6->seq_num_scaled2 = seq_num_scaled & 0x01;
 
@@ -2737,7 +3042,7 @@ static int c_tcp_build_seq_6(const struct rohc_comp_ctxt *const context,
 	seq6->ip_id = tcp_context->tmp.ip_id_delta & 0x7f;
 	rohc_comp_debug(context, "7-bit IP-ID offset 0x%x", seq6->ip_id);
 	seq6->ack_num = rohc_hton16(rohc_ntoh32(tcp->ack_num) & 0xffff);
-	seq6->msn = tcp_context->msn & 0xf;
+	seq6->msn = tcp_context->tmp.msn & 0xf;
 	seq6->psh_flag = tcp->psh_flag;
 	seq6->header_crc = crc;
 
@@ -2803,7 +3108,7 @@ static int c_tcp_build_seq_7(const struct rohc_comp_ctxt *const context,
 	seq7->ip_id = tcp_context->tmp.ip_id_delta & 0x1f;
 	rohc_comp_debug(context, "5-bit IP-ID offset 0x%x", seq7->ip_id);
 	seq7->ack_num = rohc_hton16(rohc_ntoh32(tcp->ack_num) & 0xffff);
-	seq7->msn = tcp_context->msn & 0xf;
+	seq7->msn = tcp_context->tmp.msn & 0xf;
 	seq7->psh_flag = tcp->psh_flag;
 	seq7->header_crc = crc;
 
@@ -2870,14 +3175,14 @@ static int c_tcp_build_seq_8(const struct rohc_comp_ctxt *const context,
 	seq8->list_present = 0; /* options are set later */
 	seq8->header_crc = crc;
 	rohc_comp_debug(context, "CRC = 0x%x", seq8->header_crc);
-	seq8->msn = tcp_context->msn & 0xf;
+	seq8->msn = tcp_context->tmp.msn & 0xf;
 	seq8->psh_flag = tcp->psh_flag;
 
 	/* TTL/HL */
 	seq8->ttl_hopl = ipv4->ttl & 0x7;
 
 	/* ecn_used */
-	seq8->ecn_used = GET_REAL(tcp_context->ecn_used);
+	seq8->ecn_used = GET_REAL(tcp_context->tmp.ecn_used);
 
 	/* ACK number */
 	ack_num = rohc_ntoh32(tcp->ack_num) & 0x7fff;
@@ -2905,8 +3210,8 @@ static int c_tcp_build_seq_8(const struct rohc_comp_ctxt *const context,
 		 * the static option changed, compress them */
 		bool no_item_needed;
 		seq8->list_present = 1;
-		ret = c_tcp_code_tcp_opts_list_item(context, tcp, tcp_context->msn,
-		                                    ROHC_CHAIN_CO, &tcp_context->tcp_opts,
+		ret = c_tcp_code_tcp_opts_list_item(context, tcp, ROHC_CHAIN_CO,
+		                                    &tcp_context->tcp_opts,
 		                                    seq8->options,
 		                                    rohc_max_len - sizeof(seq_8_t),
 		                                    &no_item_needed);
@@ -2994,7 +3299,7 @@ static int c_tcp_build_co_common(const struct rohc_comp_ctxt *const context,
 	// =:= rsf_index_enc [ 2 ];
 	co_common->rsf_flags = rsf_index_enc(tcp->rsf_flags);
 	// =:= lsb(4, 4) [ 4 ];
-	co_common->msn = tcp_context->msn & 0xf;
+	co_common->msn = tcp_context->tmp.msn & 0xf;
 
 	/* seq_number */
 	nr_seq_bits_16383 = wlsb_get_kp_32bits(&tcp_context->seq_wlsb, seq_num_hbo, 16383);
@@ -3047,9 +3352,9 @@ static int c_tcp_build_co_common(const struct rohc_comp_ctxt *const context,
 	/* ack_stride */
 	{
 		const bool is_ack_stride_static =
-			tcp_is_ack_stride_static(tcp_context->ack_stride,
-			                         tcp_context->ack_num_scaling_nr);
-		ret = c_static_or_irreg16(rohc_hton16(tcp_context->ack_stride),
+			tcp_is_ack_stride_static(tcp_context->tmp.ack_stride,
+			                         tcp_context->tmp.ack_num_scaling_nr);
+		ret = c_static_or_irreg16(rohc_hton16(tcp_context->tmp.ack_stride),
 		                          is_ack_stride_static,
 		                          co_common_opt, rohc_remain_len, &indicator);
 		if(ret < 0)
@@ -3063,7 +3368,7 @@ static int c_tcp_build_co_common(const struct rohc_comp_ctxt *const context,
 		rohc_remain_len -= ret;
 		rohc_comp_debug(context, "ack_stride_indicator = %d, ack_stride 0x%x on "
 		                "%d bytes", co_common->ack_stride_indicator,
-		                tcp_context->ack_stride, ret);
+		                tcp_context->tmp.ack_stride, ret);
 	}
 
 	/* window */
@@ -3088,10 +3393,10 @@ static int c_tcp_build_co_common(const struct rohc_comp_ctxt *const context,
 		// =:= irregular(1) [ 1 ];
 		rohc_comp_debug(context, "optional_ip_id_lsb(behavior = %d, IP-ID = 0x%04x, "
 		                "IP-ID offset = 0x%04x, nr of bits required for WLSB encoding "
-		                "= %zu)", inner_ip_ctxt->ctxt.v4.ip_id_behavior,
+		                "= %zu)", tcp_context->tmp.ip_id_behavior,
 		                rohc_ntoh16(inner_ipv4->id), tcp_context->tmp.ip_id_delta,
 		                tcp_context->tmp.nr_ip_id_bits_3);
-		ret = c_optional_ip_id_lsb(inner_ip_ctxt->ctxt.v4.ip_id_behavior,
+		ret = c_optional_ip_id_lsb(tcp_context->tmp.ip_id_behavior,
 		                           inner_ipv4->id,
 		                           tcp_context->tmp.ip_id_delta,
 		                           tcp_context->tmp.nr_ip_id_bits_3,
@@ -3106,7 +3411,7 @@ static int c_tcp_build_co_common(const struct rohc_comp_ctxt *const context,
 		co_common_opt_len += ret;
 		rohc_remain_len -= ret;
 		// =:= ip_id_behavior_choice(true) [ 2 ];
-		co_common->ip_id_behavior = inner_ip_ctxt->ctxt.v4.ip_id_behavior;
+		co_common->ip_id_behavior = tcp_context->tmp.ip_id_behavior;
 		rohc_comp_debug(context, "ip_id_indicator = %d, "
 		                "ip_id_behavior = %d (innermost IP-ID encoded on %d bytes)",
 		                co_common->ip_id_indicator, co_common->ip_id_behavior, ret);
@@ -3124,7 +3429,7 @@ static int c_tcp_build_co_common(const struct rohc_comp_ctxt *const context,
 
 	// cf RFC3168 and RFC4996 page 20 :
 	// =:= one_bit_choice [ 1 ];
-	co_common->ecn_used = GET_REAL(tcp_context->ecn_used);
+	co_common->ecn_used = GET_REAL(tcp_context->tmp.ecn_used);
 	rohc_comp_debug(context, "ecn_used = %d", GET_REAL(co_common->ecn_used));
 
 	/* urg_flag */
@@ -3253,8 +3558,8 @@ static int c_tcp_build_co_common(const struct rohc_comp_ctxt *const context,
 		 * the static option changed, compress them */
 		bool no_item_needed;
 		co_common->list_present = 1;
-		ret = c_tcp_code_tcp_opts_list_item(context, tcp, tcp_context->msn,
-		                                    ROHC_CHAIN_CO, &tcp_context->tcp_opts,
+		ret = c_tcp_code_tcp_opts_list_item(context, tcp, ROHC_CHAIN_CO,
+		                                    &tcp_context->tcp_opts,
 		                                    co_common_opt, rohc_remain_len,
 		                                    &no_item_needed);
 		if(ret < 0)
@@ -3318,6 +3623,16 @@ static bool tcp_detect_changes(struct rohc_comp_ctxt *const context,
 	bool last_pkt_outer_dscp_changed;
 	uint8_t pkt_ecn_vals;
 
+	/* which classes of fields changed since the last packet? */
+	tcp_context->tmp.hdrs_changed =
+		c_hdrs_cache_cmp(&tcp_context->hdrs_cache, uncomp_pkt->outer_ip.data,
+		                 uncomp_pkt->outer_ip.size);
+	rohc_comp_debug(context, "header fields changed since last packet: "
+	                "static = %s, inferred = %s, dynamic = %s",
+	                (tcp_context->tmp.hdrs_changed & ROHC_HDRS_STATIC) ? "yes" : "no",
+	                (tcp_context->tmp.hdrs_changed & ROHC_HDRS_INFERRED) ? "yes" : "no",
+	                (tcp_context->tmp.hdrs_changed & ROHC_HDRS_DYNAMIC) ? "yes" : "no");
+
 	/* no IPv6 extension got its static or dynamic parts changed at the beginning */
 	tcp_context->tmp.is_ipv6_exts_list_static_changed = false;
 	tcp_context->tmp.is_ipv6_exts_list_dyn_changed = false;
@@ -3455,15 +3770,20 @@ static bool tcp_detect_changes(struct rohc_comp_ctxt *const context,
 		if(context->num_sent_packets == 0)
 		{
 			/* first packet, be optimistic: choose sequential behavior */
-			(*ip_inner_ctxt)->ctxt.v4.ip_id_behavior = ROHC_IP_ID_BEHAVIOR_SEQ;
+			tcp_context->tmp.ip_id_behavior = ROHC_IP_ID_BEHAVIOR_SEQ;
 		}
 		else
 		{
-			(*ip_inner_ctxt)->ctxt.v4.ip_id_behavior =
+			tcp_context->tmp.ip_id_behavior =
 				rohc_comp_detect_ip_id_behavior((*ip_inner_ctxt)->ctxt.v4.last_ip_id, ip_id, 1, 19);
 		}
 		rohc_comp_debug(context, "IP-ID now behaves as %s",
-		                rohc_ip_id_behavior_get_descr((*ip_inner_ctxt)->ctxt.v4.ip_id_behavior));
+		                rohc_ip_id_behavior_get_descr(tcp_context->tmp.ip_id_behavior));
+	}
+	else
+	{
+		/* no IP-ID for IPv6 */
+		tcp_context->tmp.ip_id_behavior = (*ip_inner_ctxt)->ctxt.v6.ip_id_behavior;
 	}
 
 	/* find the offset of the payload and its size */
@@ -3473,8 +3793,8 @@ static bool tcp_detect_changes(struct rohc_comp_ctxt *const context,
 	                tcp_context->tmp.payload_len);
 
 	/* compute or find the new SN */
-	tcp_context->msn = c_tcp_get_next_msn(context);
-	rohc_comp_debug(context, "MSN = 0x%04x / %u", tcp_context->msn, tcp_context->msn);
+	tcp_context->tmp.msn = c_tcp_get_next_msn(context);
+	rohc_comp_debug(context, "MSN = 0x%04x / %u", tcp_context->tmp.msn, tcp_context->tmp.msn);
 
 	return true;
 
@@ -3498,7 +3818,7 @@ error:
  *                          false if a problem occurred
  */
 static bool tcp_detect_changes_ipv6_exts(struct rohc_comp_ctxt *const context,
-                                         ip_context_t *const ip_context,
+                                         const ip_context_t *const ip_context,
                                          uint8_t *const protocol,
                                          const uint8_t *const exts,
                                          const size_t max_exts_len,
@@ -3517,7 +3837,7 @@ static bool tcp_detect_changes_ipv6_exts(struct rohc_comp_ctxt *const context,
 	    rohc_is_ipv6_opt(*protocol) && ext_pos < ROHC_MAX_IP_EXT_HDRS;
 	    ext_pos++)
 	{
-		ip_option_context_t *const opt_ctxt = &(ip_context->opts[ext_pos]);
+		const ip_option_context_t *const opt_ctxt = &(ip_context->opts[ext_pos]);
 		const struct ipv6_opt *const ext = (struct ipv6_opt *) remain_data;
 		size_t ext_len;
 
@@ -3551,12 +3871,6 @@ static bool tcp_detect_changes_ipv6_exts(struct rohc_comp_ctxt *const context,
 				{
 					rohc_comp_debug(context, "  IPv6 option %u is new", *protocol);
 					tcp_context->tmp.is_ipv6_exts_list_static_changed = true;
-
-					/* record option in context */
-					/* TODO: should not update context there */
-					opt_ctxt->generic.option_length = ext_len;
-					memcpy(opt_ctxt->generic.data, ext->value, ext_len - 2);
-
 				}
 				else if(ext_len != opt_ctxt->generic.option_length)
 				{
@@ -3564,13 +3878,9 @@ static bool tcp_detect_changes_ipv6_exts(struct rohc_comp_ctxt *const context,
 					                "(%zu -> %zu bytes)", *protocol,
 					                opt_ctxt->generic.option_length, ext_len);
 					tcp_context->tmp.is_ipv6_exts_list_static_changed = true;
-
-					/* record option in context */
-					/* TODO: should not update context there */
-					opt_ctxt->generic.option_length = ext_len;
-					memcpy(opt_ctxt->generic.data, ext->value, ext_len - 2);
 				}
-				else if(memcmp(ext->value, opt_ctxt->generic.data, ext_len - 2) != 0)
+				else if((tcp_context->tmp.hdrs_changed & ROHC_HDRS_DYNAMIC) != 0 &&
+				        memcmp(ext->value, opt_ctxt->generic.data, ext_len - 2) != 0)
 				{
 					rohc_comp_debug(context, "  IPv6 option %u changed of content",
 					                *protocol);
@@ -3582,11 +3892,6 @@ static bool tcp_detect_changes_ipv6_exts(struct rohc_comp_ctxt *const context,
 					{
 						tcp_context->tmp.is_ipv6_exts_list_dyn_changed = true;
 					}
-
-					/* record option in context */
-					/* TODO: should not update context there */
-					opt_ctxt->generic.option_length = ext_len;
-					memcpy(opt_ctxt->generic.data, ext->value, ext_len - 2);
 				}
 				else
 				{
@@ -3635,11 +3940,14 @@ static bool tcp_detect_changes_ipv6_exts(struct rohc_comp_ctxt *const context,
 	{
 		rohc_comp_debug(context, "  IPv6 extension headers changed too much, static "
 		                "chain is required");
+		context->static_chain_len = 0;
 	}
 	else if(tcp_context->tmp.is_ipv6_exts_list_dyn_changed)
 	{
 		rohc_comp_debug(context, "  IPv6 extension headers changed too much, dynamic "
 		                "chain is required");
+		/* the Next Header fields of the static chain might have changed too */
+		context->static_chain_len = 0;
 	}
 	else
 	{
@@ -3689,17 +3997,18 @@ static void tcp_decide_state(struct rohc_comp_ctxt *const context,
 
 	if(curr_state == ROHC_COMP_STATE_IR)
 	{
-		if(context->ir_count < MAX_IR_COUNT)
+		if(context->ir_count < context->oa_repetitions_nr)
 		{
 			rohc_comp_debug(context, "no enough packets transmitted in IR state "
-			                "for the moment (%zu/%d), so stay in IR state",
-			                context->ir_count, MAX_IR_COUNT);
+			                "for the moment (%zu/%zu), so stay in IR state",
+			                context->ir_count, context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_IR;
 		}
 		else
 		{
-			rohc_comp_debug(context, "enough packets transmitted in IR state (%zu/%u), "
-			                "go to SO state", context->ir_count, MAX_IR_COUNT);
+			rohc_comp_debug(context, "enough packets transmitted in IR state (%zu/%zu), "
+			                "go to SO state", context->ir_count,
+			                context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_SO;
 		}
 	}
@@ -3721,17 +4030,18 @@ static void tcp_decide_state(struct rohc_comp_ctxt *const context,
 	}
 	else if(curr_state == ROHC_COMP_STATE_FO)
 	{
-		if(context->fo_count < MAX_FO_COUNT)
+		if(context->fo_count < context->oa_repetitions_nr)
 		{
 			rohc_comp_debug(context, "no enough packets transmitted in FO state "
-			                "for the moment (%zu/%u), so stay in FO state",
-			                context->fo_count, MAX_FO_COUNT);
+			                "for the moment (%zu/%zu), so stay in FO state",
+			                context->fo_count, context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_FO;
 		}
 		else
 		{
-			rohc_comp_debug(context, "enough packets transmitted in FO state (%zu/%u), "
-			                "go to SO state", context->fo_count, MAX_FO_COUNT);
+			rohc_comp_debug(context, "enough packets transmitted in FO state (%zu/%zu), "
+			                "go to SO state", context->fo_count,
+			                context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_SO;
 		}
 	}
@@ -3740,7 +4050,8 @@ static void tcp_decide_state(struct rohc_comp_ctxt *const context,
 		/* do not change state */
 		rohc_comp_debug(context, "stay in SO state");
 		next_state = ROHC_COMP_STATE_SO;
-		/* TODO: handle NACK and STATIC-NACK */
+		/* NACK and STATIC-NACK are handled as soon as they are received,
+		 * see c_tcp_feedback_nack() */
 	}
 	else
 	{
@@ -3749,6 +4060,13 @@ static void tcp_decide_state(struct rohc_comp_ctxt *const context,
 		return;
 	}
 
+	/* the dynamic chain refresh requested by a NACK ends with the FO state */
+	if(next_state != ROHC_COMP_STATE_FO)
+	{
+		struct sc_tcp_context *const tcp_context = context->specific;
+		tcp_context->dyn_refresh_required = false;
+	}
+
 	rohc_comp_change_state(context, next_state);
 
 	/* periodic context refreshes (RFC6846, §5.2.1.2) */
@@ -3776,12 +4094,10 @@ static bool tcp_encode_uncomp_fields(struct rohc_comp_ctxt *const context,
 
 	/* how many bits are required to encode the new SN ? */
 	tcp_context->tmp.nr_msn_bits =
-		wlsb_get_k_16bits(&tcp_context->msn_wlsb, tcp_context->msn);
+		wlsb_get_minkp_16bits_memo(&tcp_context->msn_wlsb, tcp_context->tmp.msn,
+		                           0, tcp_context->msn_wlsb.p);
 	rohc_comp_debug(context, "%zu bits are required to encode new MSN 0x%04x",
-	                tcp_context->tmp.nr_msn_bits, tcp_context->msn);
-	/* add the new MSN to the W-LSB encoding object */
-	/* TODO: move this after successful packet compression */
-	c_add_wlsb(&tcp_context->msn_wlsb, tcp_context->msn, tcp_context->msn);
+	                tcp_context->tmp.nr_msn_bits, tcp_context->tmp.msn);
 
 	if(!tcp_encode_uncomp_ip_fields(context, uncomp_pkt))
 	{
@@ -3934,33 +4250,33 @@ static bool tcp_encode_uncomp_ip_fields(struct rohc_comp_ctxt *const context,
 
 		/* does IP-ID behavior changed? */
 		tcp_context->tmp.ip_id_behavior_changed =
-			(inner_ip_ctxt->ctxt.v4.last_ip_id_behavior != inner_ip_ctxt->ctxt.v4.ip_id_behavior);
+			(inner_ip_ctxt->ctxt.v4.last_ip_id_behavior != tcp_context->tmp.ip_id_behavior);
 		tcp_field_descr_change(context, "IP-ID behavior",
 		                       tcp_context->tmp.ip_id_behavior_changed, 0);
 
 		/* compute the new IP-ID / SN delta */
-		if(inner_ip_ctxt->ctxt.v4.ip_id_behavior == ROHC_IP_ID_BEHAVIOR_SEQ_SWAP)
+		if(tcp_context->tmp.ip_id_behavior == ROHC_IP_ID_BEHAVIOR_SEQ_SWAP)
 		{
 			/* specific case of IP-ID delta for sequential swapped behavior */
-			tcp_context->tmp.ip_id_delta = swab16(ip_id) - tcp_context->msn;
+			tcp_context->tmp.ip_id_delta = swab16(ip_id) - tcp_context->tmp.msn;
 			rohc_comp_debug(context, "new outer IP-ID delta = 0x%x / %u (behavior = %d)",
 			                tcp_context->tmp.ip_id_delta, tcp_context->tmp.ip_id_delta,
-			                inner_ip_ctxt->ctxt.v4.ip_id_behavior);
+			                tcp_context->tmp.ip_id_behavior);
 		}
 		else
 		{
 			/* compute delta the same way for sequential, zero or random: it is
 			 * important to always compute the IP-ID delta and record it in W-LSB,
 			 * so that the IP-ID deltas of next packets may be correctly encoded */
-			tcp_context->tmp.ip_id_delta = ip_id - tcp_context->msn;
+			tcp_context->tmp.ip_id_delta = ip_id - tcp_context->tmp.msn;
 			rohc_comp_debug(context, "new outer IP-ID delta = 0x%x / %u (behavior = %d)",
 			                tcp_context->tmp.ip_id_delta, tcp_context->tmp.ip_id_delta,
-			                inner_ip_ctxt->ctxt.v4.ip_id_behavior);
+			                tcp_context->tmp.ip_id_behavior);
 		}
 
 		/* how many bits are required to encode the new IP-ID / SN delta ? */
-		if(inner_ip_ctxt->ctxt.v4.ip_id_behavior != ROHC_IP_ID_BEHAVIOR_SEQ &&
-		   inner_ip_ctxt->ctxt.v4.ip_id_behavior != ROHC_IP_ID_BEHAVIOR_SEQ_SWAP)
+		if(tcp_context->tmp.ip_id_behavior != ROHC_IP_ID_BEHAVIOR_SEQ &&
+		   tcp_context->tmp.ip_id_behavior != ROHC_IP_ID_BEHAVIOR_SEQ_SWAP)
 		{
 			/* send all bits if IP-ID behavior is not sequential */
 			tcp_context->tmp.nr_ip_id_bits_3 = 16;
@@ -3972,24 +4288,20 @@ static bool tcp_encode_uncomp_ip_fields(struct rohc_comp_ctxt *const context,
 		{
 			/* send only required bits in FO or SO states */
 			tcp_context->tmp.nr_ip_id_bits_3 =
-				wlsb_get_kp_16bits(&tcp_context->ip_id_wlsb,
-				                   tcp_context->tmp.ip_id_delta, 3);
+				wlsb_get_minkp_16bits_memo(&tcp_context->ip_id_wlsb,
+				                           tcp_context->tmp.ip_id_delta, 0, 3);
 			rohc_comp_debug(context, "%zu bits are required to encode new innermost "
 			                "IP-ID delta 0x%04x with p = 3",
 			                tcp_context->tmp.nr_ip_id_bits_3,
 			                tcp_context->tmp.ip_id_delta);
 			tcp_context->tmp.nr_ip_id_bits_1 =
-				wlsb_get_kp_16bits(&tcp_context->ip_id_wlsb,
-				                   tcp_context->tmp.ip_id_delta, 1);
+				wlsb_get_minkp_16bits_memo(&tcp_context->ip_id_wlsb,
+				                           tcp_context->tmp.ip_id_delta, 0, 1);
 			rohc_comp_debug(context, "%zu bits are required to encode new innermost "
 			                "IP-ID delta 0x%04x with p = 1",
 			                tcp_context->tmp.nr_ip_id_bits_1,
 			                tcp_context->tmp.ip_id_delta);
 		}
-		/* add the new IP-ID / SN delta to the W-LSB encoding object */
-		/* TODO: move this after successful packet compression */
-		c_add_wlsb(&tcp_context->ip_id_wlsb, tcp_context->msn,
-		           tcp_context->tmp.ip_id_delta);
 
 		tcp_context->tmp.ip_df_changed =
 			!!(inner_ipv4->df != inner_ip_ctxt->ctxt.v4.df);
@@ -4024,16 +4336,18 @@ static bool tcp_encode_uncomp_ip_fields(struct rohc_comp_ctxt *const context,
 	if(tcp_context->tmp.ttl_hopl != inner_ip_ctxt->ctxt.vx.ttl_hopl)
 	{
 		tcp_context->tmp.ttl_hopl_changed = true;
-		tcp_context->ttl_hopl_change_count = 0;
+		tcp_context->tmp.ttl_hopl_change_count = 0;
 	}
 	else if(tcp_context->ttl_hopl_change_count < MAX_FO_COUNT)
 	{
 		tcp_context->tmp.ttl_hopl_changed = true;
-		tcp_context->ttl_hopl_change_count++;
+		tcp_context->tmp.ttl_hopl_change_count =
+			tcp_context->ttl_hopl_change_count + 1;
 	}
 	else
 	{
 		tcp_context->tmp.ttl_hopl_changed = false;
+		tcp_context->tmp.ttl_hopl_change_count = tcp_context->ttl_hopl_change_count;
 	}
 	tcp_context->tmp.nr_ttl_hopl_bits =
 		wlsb_get_k_8bits(&tcp_context->ttl_hopl_wlsb, tcp_context->tmp.ttl_hopl);
@@ -4041,10 +4355,6 @@ static bool tcp_encode_uncomp_ip_fields(struct rohc_comp_ctxt *const context,
 	                "TTL/Hop Limit 0x%02x with p = 3",
 	                tcp_context->tmp.nr_ttl_hopl_bits,
 	                tcp_context->tmp.ttl_hopl);
-	/* add the new TTL/Hop Limit to the W-LSB encoding object */
-	/* TODO: move this after successful packet compression */
-	c_add_wlsb(&tcp_context->ttl_hopl_wlsb, tcp_context->msn,
-	           tcp_context->tmp.ttl_hopl);
 
 	return true;
 
@@ -4097,7 +4407,7 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
 	                       tcp_context->tmp.tcp_urg_flag_changed, 0);
 	tcp_field_descr_change(context, "ECN flag",
 	                       tcp_context->tmp.ecn_used_changed,
-	                       tcp_context->ecn_used_change_count);
+	                       tcp_context->tmp.ecn_used_change_count);
 	if(tcp->rsf_flags != 0)
 	{
 		rohc_comp_debug(context, "RSF flags is set in current packet");
@@ -4107,27 +4417,28 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
 	if(tcp->window != tcp_context->old_tcphdr.window)
 	{
 		tcp_context->tmp.tcp_window_changed = true;
-		tcp_context->tcp_window_change_count = 0;
+		tcp_context->tmp.tcp_window_change_count = 0;
 	}
 	else if(tcp_context->tcp_window_change_count < MAX_FO_COUNT)
 	{
 		tcp_context->tmp.tcp_window_changed = true;
-		tcp_context->tcp_window_change_count++;
+		tcp_context->tmp.tcp_window_change_count =
+			tcp_context->tcp_window_change_count + 1;
 	}
 	else
 	{
 		tcp_context->tmp.tcp_window_changed = false;
+		tcp_context->tmp.tcp_window_change_count = tcp_context->tcp_window_change_count;
 	}
 	tcp_field_descr_change(context, "TCP window", tcp_context->tmp.tcp_window_changed,
-	                       tcp_context->tcp_window_change_count);
+	                       tcp_context->tmp.tcp_window_change_count);
 	tcp_context->tmp.nr_window_bits_16383 =
-		wlsb_get_kp_16bits(&tcp_context->window_wlsb, rohc_ntoh16(tcp->window),
-		                   ROHC_LSB_SHIFT_TCP_WINDOW);
+		wlsb_get_minkp_16bits_memo(&tcp_context->window_wlsb,
+		                           rohc_ntoh16(tcp->window), 0,
+		                           ROHC_LSB_SHIFT_TCP_WINDOW);
 	rohc_comp_debug(context, "%zu bits are required to encode new TCP window "
 	                "0x%04x with p = %d", tcp_context->tmp.nr_window_bits_16383,
 	                rohc_ntoh16(tcp->window), ROHC_LSB_SHIFT_TCP_WINDOW);
-	/* TODO: move this after successful packet compression */
-	c_add_wlsb(&tcp_context->window_wlsb, tcp_context->msn, rohc_ntoh16(tcp->window));
 
 	/* compute new scaled TCP sequence number */
 	{
@@ -4141,23 +4452,32 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
 		                "residue = 0x%x", seq_num_hbo, seq_num_scaled,
 		                seq_num_factor, seq_num_residue);
 
-		if(context->num_sent_packets == 0 ||
-		   seq_num_factor == 0 ||
-		   seq_num_factor != tcp_context->seq_num_factor ||
-		   seq_num_residue != tcp_context->seq_num_residue)
+		if(seq_num_factor == 0)
+		{
+			/* sequence number cannot be scaled without payload, but the segment
+			 * does not interrupt the scaling of the next segments: the context
+			 * keeps the factor of the segments with payload */
+			tcp_context->tmp.seq_num_scaling_nr = 0;
+		}
+		else if(context->num_sent_packets == 0 ||
+		        seq_num_factor != tcp_context->seq_num_factor ||
+		        seq_num_residue != tcp_context->seq_num_residue)
 		{
 			/* sequence number is not scalable with same parameters any more */
-			tcp_context->seq_num_scaling_nr = 0;
+			tcp_context->tmp.seq_num_scaling_nr = 0;
+		}
+		else
+		{
+			tcp_context->tmp.seq_num_scaling_nr = tcp_context->seq_num_scaling_nr;
 		}
 		rohc_comp_debug(context, "unscaled sequence number was transmitted at "
-		                "least %zu / %u times since the scaling factor or "
-		                "residue changed", tcp_context->seq_num_scaling_nr,
-		                ROHC_INIT_TS_STRIDE_MIN);
+		                "least %zu / %zu times since the scaling factor or "
+		                "residue changed", tcp_context->tmp.seq_num_scaling_nr,
+		                context->oa_repetitions_nr);
 
-		/* TODO: should update context at the very end only */
-		tcp_context->seq_num_scaled = seq_num_scaled;
-		tcp_context->seq_num_residue = seq_num_residue;
-		tcp_context->seq_num_factor = seq_num_factor;
+		tcp_context->tmp.seq_num_scaled = seq_num_scaled;
+		tcp_context->tmp.seq_num_residue = seq_num_residue;
+		tcp_context->tmp.seq_num_factor = seq_num_factor;
 	}
 
 	/* compute new scaled TCP acknowledgment number */
@@ -4171,29 +4491,33 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
 		/* change ack_stride only if the ACK delta that was most used over the
 		 * sliding window changed */
 		rohc_comp_debug(context, "ACK delta with previous packet = 0x%04x", ack_delta);
+		tcp_context->tmp.ack_delta = ack_delta;
 		if(ack_delta == 0)
 		{
 			ack_stride = tcp_context->ack_stride;
 		}
 		else
 		{
+			/* the sliding window of ACK deltas with the new ACK delta, the context
+			 * is updated with the new ACK delta once the packet is built */
+			const size_t ack_deltas_next = (tcp_context->ack_deltas_next + 1) % 20;
+			uint16_t ack_deltas_width[20];
 			size_t ack_stride_count = 0;
 			size_t i;
 			size_t j;
 
-			/* TODO: should update context at the very end only */
-			tcp_context->ack_deltas_width[tcp_context->ack_deltas_next] = ack_delta;
-			tcp_context->ack_deltas_next = (tcp_context->ack_deltas_next + 1) % 20;
+			memcpy(ack_deltas_width, tcp_context->ack_deltas_width,
+			       sizeof(ack_deltas_width));
+			ack_deltas_width[tcp_context->ack_deltas_next] = ack_delta;
 
 			for(i = 0; i < 20; i++)
 			{
-				const uint16_t val =
-					tcp_context->ack_deltas_width[(tcp_context->ack_deltas_next + i) % 20];
+				const uint16_t val = ack_deltas_width[(ack_deltas_next + i) % 20];
 				size_t val_count = 1;
 
 				for(j = i + 1; j < 20; j++)
 				{
-					if(val == tcp_context->ack_deltas_width[(tcp_context->ack_deltas_next + j) % 20])
+					if(val == ack_deltas_width[(ack_deltas_next + j) % 20])
 					{
 						val_count++;
 					}
@@ -4222,7 +4546,7 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
 		if(context->num_sent_packets == 0)
 		{
 			/* no need to transmit the ack_stride until it becomes non-zero */
-			tcp_context->ack_num_scaling_nr = ROHC_INIT_TS_STRIDE_MIN;
+			tcp_context->tmp.ack_num_scaling_nr = ROHC_INIT_TS_STRIDE_MIN;
 		}
 		else
 		{
@@ -4230,56 +4554,63 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
 			   ack_num_residue != tcp_context->ack_num_residue)
 			{
 				/* ACK number is not scalable with same parameters any more */
-				tcp_context->ack_num_scaling_nr = 0;
+				tcp_context->tmp.ack_num_scaling_nr = 0;
+			}
+			else
+			{
+				tcp_context->tmp.ack_num_scaling_nr = tcp_context->ack_num_scaling_nr;
 			}
 			rohc_comp_debug(context, "unscaled ACK number was transmitted at least "
 			                "%zu / %u times since the scaling factor or residue changed",
-			                tcp_context->ack_num_scaling_nr, ROHC_INIT_TS_STRIDE_MIN);
+			                tcp_context->tmp.ack_num_scaling_nr, ROHC_INIT_TS_STRIDE_MIN);
 		}
 
-		/* TODO: should update context at the very end only */
-		tcp_context->ack_num_scaled = ack_num_scaled;
-		tcp_context->ack_num_residue = ack_num_residue;
-		tcp_context->ack_stride = ack_stride;
+		tcp_context->tmp.ack_num_scaled = ack_num_scaled;
+		tcp_context->tmp.ack_num_residue = ack_num_residue;
+		tcp_context->tmp.ack_stride = ack_stride;
 	}
 
 	/* how many bits are required to encode the new sequence number? */
 	tcp_context->tmp.tcp_seq_num_changed =
 		(tcp->seq_num != tcp_context->old_tcphdr.seq_num);
-	if(tcp_context->seq_num_factor == 0 ||
-	   tcp_context->seq_num_scaling_nr < ROHC_INIT_TS_STRIDE_MIN)
+	if(tcp_context->tmp.seq_num_factor == 0 ||
+	   tcp_context->tmp.seq_num_scaling_nr < context->oa_repetitions_nr)
 	{
 		tcp_context->tmp.nr_seq_scaled_bits = 32;
 	}
 	else
 	{
 		tcp_context->tmp.nr_seq_scaled_bits =
-			wlsb_get_k_32bits(&tcp_context->seq_scaled_wlsb, tcp_context->seq_num_scaled);
+			wlsb_get_minkp_32bits_memo(&tcp_context->seq_scaled_wlsb,
+			                           tcp_context->tmp.seq_num_scaled, 0,
+			                           tcp_context->seq_scaled_wlsb.p);
 		rohc_comp_debug(context, "%zu bits are required to encode new scaled "
 		                "sequence number 0x%08x", tcp_context->tmp.nr_seq_scaled_bits,
-		                tcp_context->seq_num_scaled);
+		                tcp_context->tmp.seq_num_scaled);
 	}
 
 	/* how many bits are required to encode the new ACK number? */
 	tcp_context->tmp.tcp_ack_num_changed =
 		(tcp->ack_num != tcp_context->old_tcphdr.ack_num);
 	tcp_context->tmp.nr_ack_bits_16383 =
-		wlsb_get_kp_32bits(&tcp_context->ack_wlsb, ack_num_hbo, 16383);
+		wlsb_get_minkp_32bits_memo(&tcp_context->ack_wlsb, ack_num_hbo, 0, 16383);
 	rohc_comp_debug(context, "%zd bits are required to encode new ACK "
 	                "number 0x%08x with p = 16383",
 	                tcp_context->tmp.nr_ack_bits_16383, ack_num_hbo);
-	if(!tcp_is_ack_scaled_possible(tcp_context->ack_stride,
-	                               tcp_context->ack_num_scaling_nr))
+	if(!tcp_is_ack_scaled_possible(tcp_context->tmp.ack_stride,
+	                               tcp_context->tmp.ack_num_scaling_nr))
 	{
 		tcp_context->tmp.nr_ack_scaled_bits = 32;
 	}
 	else
 	{
 		tcp_context->tmp.nr_ack_scaled_bits =
-			wlsb_get_k_32bits(&tcp_context->ack_scaled_wlsb, tcp_context->ack_num_scaled);
+			wlsb_get_minkp_32bits_memo(&tcp_context->ack_scaled_wlsb,
+			                           tcp_context->tmp.ack_num_scaled, 0,
+			                           tcp_context->ack_scaled_wlsb.p);
 		rohc_comp_debug(context, "%zu bits are required to encode new scaled "
 		                "ACK number 0x%08x", tcp_context->tmp.nr_ack_scaled_bits,
-		                tcp_context->ack_num_scaled);
+		                tcp_context->tmp.ack_num_scaled);
 	}
 
 	/* how many bits are required to encode the new timestamp echo request and
@@ -4314,22 +4645,17 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
 		/* send only required bits in FO or SO states */
 
 		/* how many bits are required to encode the timestamp echo request
-		 * with p = -1 ? */
+		 * on 1 or 2 bytes? */
 		tcp_context->tcp_opts.tmp.nr_opt_ts_req_bits_minus_1 =
-			wlsb_get_kp_32bits(&tcp_context->tcp_opts.ts_req_wlsb,
-			                   tcp_context->tcp_opts.tmp.ts_req,
-			                   ROHC_LSB_SHIFT_TCP_TS_1B);
-		rohc_comp_debug(context, "%zu bits are required to encode new "
-		                "timestamp echo request 0x%08x with p = %d",
-		                tcp_context->tcp_opts.tmp.nr_opt_ts_req_bits_minus_1,
-		                tcp_context->tcp_opts.tmp.ts_req, ROHC_LSB_SHIFT_TCP_TS_1B);
+			tcp_get_ts_lsb_short_bits(context, &tcp_context->tcp_opts.ts_req_wlsb,
+			                          tcp_context->tcp_opts.tmp.ts_req, "request");
 
 		/* how many bits are required to encode the timestamp echo request
 		 * with p = 0x40000 ? */
 		tcp_context->tcp_opts.tmp.nr_opt_ts_req_bits_0x40000 =
-			wlsb_get_kp_32bits(&tcp_context->tcp_opts.ts_req_wlsb,
-			                   tcp_context->tcp_opts.tmp.ts_req,
-			                   ROHC_LSB_SHIFT_TCP_TS_3B);
+			wlsb_get_minkp_32bits_memo(&tcp_context->tcp_opts.ts_req_wlsb,
+			                           tcp_context->tcp_opts.tmp.ts_req, 0,
+			                           ROHC_LSB_SHIFT_TCP_TS_3B);
 		rohc_comp_debug(context, "%zu bits are required to encode new "
 		                "timestamp echo request 0x%08x with p = 0x%x",
 		                tcp_context->tcp_opts.tmp.nr_opt_ts_req_bits_0x40000,
@@ -4338,31 +4664,26 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
 		/* how many bits are required to encode the timestamp echo reply
 		 * with p = 0x4000000 ? */
 		tcp_context->tcp_opts.tmp.nr_opt_ts_req_bits_0x4000000 =
-			wlsb_get_kp_32bits(&tcp_context->tcp_opts.ts_req_wlsb,
-			                   tcp_context->tcp_opts.tmp.ts_req,
-			                   ROHC_LSB_SHIFT_TCP_TS_4B);
+			wlsb_get_minkp_32bits_memo(&tcp_context->tcp_opts.ts_req_wlsb,
+			                           tcp_context->tcp_opts.tmp.ts_req, 0,
+			                           ROHC_LSB_SHIFT_TCP_TS_4B);
 		rohc_comp_debug(context, "%zu bits are required to encode new "
 		                "timestamp echo request 0x%08x with p = 0x%x",
 		                tcp_context->tcp_opts.tmp.nr_opt_ts_req_bits_0x4000000,
 		                tcp_context->tcp_opts.tmp.ts_req, ROHC_LSB_SHIFT_TCP_TS_4B);
 
 		/* how many bits are required to encode the timestamp echo reply
-		 * with p = -1 ? */
+		 * on 1 or 2 bytes? */
 		tcp_context->tcp_opts.tmp.nr_opt_ts_reply_bits_minus_1 =
-			wlsb_get_kp_32bits(&tcp_context->tcp_opts.ts_reply_wlsb,
-			                   tcp_context->tcp_opts.tmp.ts_reply,
-			                   ROHC_LSB_SHIFT_TCP_TS_1B);
-		rohc_comp_debug(context, "%zu bits are required to encode new "
-		                "timestamp echo reply 0x%08x with p = %d",
-		                tcp_context->tcp_opts.tmp.nr_opt_ts_reply_bits_minus_1,
-		                tcp_context->tcp_opts.tmp.ts_reply, ROHC_LSB_SHIFT_TCP_TS_1B);
+			tcp_get_ts_lsb_short_bits(context, &tcp_context->tcp_opts.ts_reply_wlsb,
+			                          tcp_context->tcp_opts.tmp.ts_reply, "reply");
 
 		/* how many bits are required to encode the timestamp echo reply
 		 * with p = 0x40000 ? */
 		tcp_context->tcp_opts.tmp.nr_opt_ts_reply_bits_0x40000 =
-			wlsb_get_kp_32bits(&tcp_context->tcp_opts.ts_reply_wlsb,
-			                   tcp_context->tcp_opts.tmp.ts_reply,
-			                   ROHC_LSB_SHIFT_TCP_TS_3B);
+			wlsb_get_minkp_32bits_memo(&tcp_context->tcp_opts.ts_reply_wlsb,
+			                           tcp_context->tcp_opts.tmp.ts_reply, 0,
+			                           ROHC_LSB_SHIFT_TCP_TS_3B);
 		rohc_comp_debug(context, "%zu bits are required to encode new "
 		                "timestamp echo reply 0x%08x with p = 0x%x",
 		                tcp_context->tcp_opts.tmp.nr_opt_ts_reply_bits_0x40000,
@@ -4371,9 +4692,9 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
 		/* how many bits are required to encode the timestamp echo reply
 		 * with p = 0x4000000 ? */
 		tcp_context->tcp_opts.tmp.nr_opt_ts_reply_bits_0x4000000 =
-			wlsb_get_kp_32bits(&tcp_context->tcp_opts.ts_reply_wlsb,
-			                   tcp_context->tcp_opts.tmp.ts_reply,
-			                   ROHC_LSB_SHIFT_TCP_TS_4B);
+			wlsb_get_minkp_32bits_memo(&tcp_context->tcp_opts.ts_reply_wlsb,
+			                           tcp_context->tcp_opts.tmp.ts_reply, 0,
+			                           ROHC_LSB_SHIFT_TCP_TS_4B);
 		rohc_comp_debug(context, "%zu bits are required to encode new "
 		                "timestamp echo reply 0x%08x with p = 0x%x",
 		                tcp_context->tcp_opts.tmp.nr_opt_ts_reply_bits_0x4000000,
@@ -4384,11 +4705,55 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
 }
 
 
+/**
+ * @brief Compute how many bits the 1-byte and 2-byte TS LSB forms require
+ *
+ * The standard 1-byte and 2-byte forms use p = -1: they cannot encode a TS
+ * value that did not change since the reference. Timestamp echo replies are
+ * often unchanged from one segment to the other, and timestamp echo requests
+ * of fast flows too. With the \ref ROHC_COMP_FEATURE_TCP_TS_UNCHANGED
+ * feature, both forms use p = 0: the TS values are monotonic, so the
+ * interpretation interval still starts at the reference and only loses the
+ * largest advance of the standard forms.
+ *
+ * The feature is disabled by default, so the compressor encodes the TS
+ * values as the ts_lsb method of RFC 6846 does and stays interoperable with
+ * any RFC 6846 decompressor. The feature is not negotiated: a decompressor
+ * that does not enable \ref ROHC_DECOMP_FEATURE_TCP_TS_UNCHANGED decodes an
+ * unchanged TS value 128 or 16384 ticks too far, and the CRC of the packet
+ * then fails. Enable it only when both ends are known to support it.
+ *
+ * @param context  The compression context
+ * @param wlsb     The W-LSB encoding context of the TS field
+ * @param ts       The TS value to encode
+ * @param descr    The description of the TS field for traces
+ * @return         The number of bits required with the 1-byte and 2-byte
+ *                 forms: at most 7 for the 1-byte form, at most 14 for the
+ *                 2-byte form
+ */
+static size_t tcp_get_ts_lsb_short_bits(const struct rohc_comp_ctxt *const context,
+                                        struct c_wlsb *const wlsb,
+                                        const uint32_t ts,
+                                        const char *const descr)
+{
+	const rohc_lsb_shift_t p =
+		((context->compressor->features & ROHC_COMP_FEATURE_TCP_TS_UNCHANGED) != 0 ?
+		 ROHC_LSB_SHIFT_TCP_TS_UNCHANGED : ROHC_LSB_SHIFT_TCP_TS_1B);
+	size_t nr_bits;
+
+	nr_bits = wlsb_get_minkp_32bits_memo(wlsb, ts, 0, p);
+	rohc_comp_debug(context, "%zu bits are required to encode new "
+	                "timestamp echo %s 0x%08x with p = %d", nr_bits, descr,
+	                ts, p);
+
+	return nr_bits;
+}
+
+
 /**
  * @brief Decide which packet to send when in the different states.
  *
  * @param context           The compression context
- * @param ip_inner_context  The context of the inner IP header
  * @param tcp               The TCP header to compress
  * @return                  \li The packet type among ROHC_PACKET_IR,
  *                              ROHC_PACKET_IR_DYN, ROHC_PACKET_TCP_RND_[1-8],
@@ -4397,7 +4762,6 @@ static bool tcp_encode_uncomp_tcp_fields(struct rohc_comp_ctxt *const context,
  *                          \li ROHC_PACKET_UNKNOWN in case of failure
  */
 static rohc_packet_t tcp_decide_packet(struct rohc_comp_ctxt *const context,
-                                       const ip_context_t *const ip_inner_context,
                                        const struct tcphdr *const tcp)
 {
 	struct sc_tcp_context *const tcp_context = context->specific;
@@ -4408,7 +4772,6 @@ static rohc_packet_t tcp_decide_packet(struct rohc_comp_ctxt *const context,
 		case ROHC_COMP_STATE_IR: /* The Initialization and Refresh (IR) state */
 			rohc_comp_debug(context, "code IR packet");
 			packet_type = ROHC_PACKET_IR;
-			context->ir_count++;
 			break;
 		case ROHC_COMP_STATE_CR: /* The Context Replication (CR) state */
 			if(tcp_context->tmp.is_ipv6_exts_list_static_changed)
@@ -4421,15 +4784,12 @@ static rohc_packet_t tcp_decide_packet(struct rohc_comp_ctxt *const context,
 				rohc_comp_debug(context, "code IR-CR packet");
 				packet_type = ROHC_PACKET_IR_CR;
 			}
-			context->cr_count++;
 			break;
 		case ROHC_COMP_STATE_FO: /* The First Order (FO) state */
-			context->fo_count++;
-			packet_type = tcp_decide_FO_packet(context, ip_inner_context, tcp);
+			packet_type = tcp_decide_FO_packet(context, tcp);
 			break;
 		case ROHC_COMP_STATE_SO: /* The Second Order (SO) state */
-			context->so_count++;
-			packet_type = tcp_decide_SO_packet(context, ip_inner_context, tcp);
+			packet_type = tcp_decide_SO_packet(context, tcp);
 			break;
 		case ROHC_COMP_STATE_UNKNOWN:
 		default:
@@ -4448,7 +4808,6 @@ static rohc_packet_t tcp_decide_packet(struct rohc_comp_ctxt *const context,
  * @brief Decide which packet to send when in FO state.
  *
  * @param context           The compression context
- * @param ip_inner_context  The context of the inner IP header
  * @param tcp               The TCP header to compress
  * @return                  \li The packet type among ROHC_PACKET_IR,
  *                              ROHC_PACKET_IR_DYN, ROHC_PACKET_TCP_RND_8,
@@ -4457,11 +4816,19 @@ static rohc_packet_t tcp_decide_packet(struct rohc_comp_ctxt *const context,
  *                          \li ROHC_PACKET_UNKNOWN in case of failure
  */
 static rohc_packet_t tcp_decide_FO_packet(const struct rohc_comp_ctxt *const context,
-                                          const ip_context_t *const ip_inner_context,
                                           const struct tcphdr *const tcp)
 {
+	const struct sc_tcp_context *const tcp_context = context->specific;
 	const bool crc7_at_least = true;
-	return tcp_decide_FO_SO_packet(context, ip_inner_context, tcp, crc7_at_least);
+
+	if(tcp_context->dyn_refresh_required)
+	{
+		rohc_comp_debug(context, "force packet IR-DYN because the decompressor "
+		                "reported a damaged context with a NACK");
+		return ROHC_PACKET_IR_DYN;
+	}
+
+	return tcp_decide_FO_SO_packet(context, tcp, crc7_at_least);
 }
 
 
@@ -4469,7 +4836,6 @@ static rohc_packet_t tcp_decide_FO_packet(const struct rohc_comp_ctxt *const con
  * @brief Decide which packet to send when in SO state.
  *
  * @param context           The compression context
- * @param ip_inner_context  The context of the inner IP header
  * @param tcp               The TCP header to compress
  * @return                  \li The packet type among ROHC_PACKET_IR,
  *                              ROHC_PACKET_IR_CR, ROHC_PACKET_IR_DYN,
@@ -4479,11 +4845,10 @@ static rohc_packet_t tcp_decide_FO_packet(const struct rohc_comp_ctxt *const con
  *                          \li ROHC_PACKET_UNKNOWN in case of failure
  */
 static rohc_packet_t tcp_decide_SO_packet(const struct rohc_comp_ctxt *const context,
-                                          const ip_context_t *const ip_inner_context,
                                           const struct tcphdr *const tcp)
 {
 	const bool crc7_at_least = false;
-	return tcp_decide_FO_SO_packet(context, ip_inner_context, tcp, crc7_at_least);
+	return tcp_decide_FO_SO_packet(context, tcp, crc7_at_least);
 }
 
 
@@ -4502,7 +4867,6 @@ static rohc_packet_t tcp_decide_SO_packet(const struct rohc_comp_ctxt *const con
  *                          \li ROHC_PACKET_UNKNOWN in case of failure
  */
 static rohc_packet_t tcp_decide_FO_SO_packet(const struct rohc_comp_ctxt *const context,
-                                             const ip_context_t *const ip_inner_context,
                                              const struct tcphdr *const tcp,
                                              const bool crc7_at_least)
 {
@@ -4552,8 +4916,8 @@ static rohc_packet_t tcp_decide_FO_SO_packet(const struct rohc_comp_ctxt *const
 	        tcp_context->tmp.tcp_urg_flag_present ||
 	        tcp_context->tmp.tcp_urg_flag_changed ||
 	        tcp_context->old_tcphdr.urg_ptr != tcp->urg_ptr ||
-	        !tcp_is_ack_stride_static(tcp_context->ack_stride,
-	                                  tcp_context->ack_num_scaling_nr))
+	        !tcp_is_ack_stride_static(tcp_context->tmp.ack_stride,
+	                                  tcp_context->tmp.ack_num_scaling_nr))
 	{
 		TRACE_GOTO_CHOICE;
 		packet_type = ROHC_PACKET_TCP_CO_COMMON;
@@ -4567,14 +4931,14 @@ static rohc_packet_t tcp_decide_FO_SO_packet(const struct rohc_comp_ctxt *const
 		size_t nr_seq_bits_8191; /* min bits required to encode TCP seqnum with p = 8191 */
 		size_t nr_ack_bits_8191; /* min bits required to encode TCP ACK number with p = 8191 */
 
-		nr_seq_bits_65535 = wlsb_get_kp_32bits(&tcp_context->seq_wlsb, seq_num_hbo, 65535);
+		nr_seq_bits_65535 = wlsb_get_minkp_32bits_memo(&tcp_context->seq_wlsb, seq_num_hbo, 0, 65535);
 		rohc_comp_debug(context, "%zd bits are required to encode new sequence "
 		                "number 0x%08x with p = 65535", nr_seq_bits_65535, seq_num_hbo);
-		nr_seq_bits_8191 = wlsb_get_kp_32bits(&tcp_context->seq_wlsb, seq_num_hbo, 8191);
+		nr_seq_bits_8191 = wlsb_get_minkp_32bits_memo(&tcp_context->seq_wlsb, seq_num_hbo, 0, 8191);
 		rohc_comp_debug(context, "%zd bits are required to encode new sequence "
 		                "number 0x%08x with p = 8191", nr_seq_bits_8191, seq_num_hbo);
 
-		nr_ack_bits_8191 = wlsb_get_kp_32bits(&tcp_context->ack_wlsb, ack_num_hbo, 8191);
+		nr_ack_bits_8191 = wlsb_get_minkp_32bits_memo(&tcp_context->ack_wlsb, ack_num_hbo, 0, 8191);
 		rohc_comp_debug(context, "%zd bits are required to encode new ACK "
 		                "number 0x%08x with p = 8191", nr_ack_bits_8191, ack_num_hbo);
 
@@ -4583,7 +4947,7 @@ static rohc_packet_t tcp_decide_FO_SO_packet(const struct rohc_comp_ctxt *const
 		 *  - use common if too many LSB of sequence number are required
 		 *  - use common if too many LSB of innermost TTL/Hop Limit are required
 		 *  - use common if window changed */
-		if(ip_inner_context->ctxt.vx.ip_id_behavior <= ROHC_IP_ID_BEHAVIOR_SEQ_SWAP &&
+		if(tcp_context->tmp.ip_id_behavior <= ROHC_IP_ID_BEHAVIOR_SEQ_SWAP &&
 		   tcp_context->tmp.nr_ip_id_bits_3 <= 4 &&
 		   nr_seq_bits_8191 <= 14 &&
 		   nr_ack_bits_8191 <= 15 &&
@@ -4594,7 +4958,7 @@ static rohc_packet_t tcp_decide_FO_SO_packet(const struct rohc_comp_ctxt *const
 			TRACE_GOTO_CHOICE;
 			packet_type = ROHC_PACKET_TCP_SEQ_8;
 		}
-		else if(ip_inner_context->ctxt.vx.ip_id_behavior > ROHC_IP_ID_BEHAVIOR_SEQ_SWAP &&
+		else if(tcp_context->tmp.ip_id_behavior > ROHC_IP_ID_BEHAVIOR_SEQ_SWAP &&
 		        nr_seq_bits_65535 <= 16 &&
 		        tcp_context->tmp.nr_ack_bits_16383 <= 16 &&
 		        tcp_context->tmp.nr_ttl_hopl_bits <= 3 &&
@@ -4609,14 +4973,14 @@ static rohc_packet_t tcp_decide_FO_SO_packet(const struct rohc_comp_ctxt *const
 			packet_type = ROHC_PACKET_TCP_CO_COMMON;
 		}
 	}
-	else if(ip_inner_context->ctxt.vx.ip_id_behavior <= ROHC_IP_ID_BEHAVIOR_SEQ_SWAP)
+	else if(tcp_context->tmp.ip_id_behavior <= ROHC_IP_ID_BEHAVIOR_SEQ_SWAP)
 	{
 		/* ROHC_IP_ID_BEHAVIOR_SEQ or ROHC_IP_ID_BEHAVIOR_SEQ_SWAP:
 		 * co_common or seq_X packet types */
 		packet_type = tcp_decide_FO_SO_packet_seq(context, tcp, crc7_at_least);
 	}
-	else if(ip_inner_context->ctxt.vx.ip_id_behavior == ROHC_IP_ID_BEHAVIOR_RAND ||
-	        ip_inner_context->ctxt.vx.ip_id_behavior == ROHC_IP_ID_BEHAVIOR_ZERO)
+	else if(tcp_context->tmp.ip_id_behavior == ROHC_IP_ID_BEHAVIOR_RAND ||
+	        tcp_context->tmp.ip_id_behavior == ROHC_IP_ID_BEHAVIOR_ZERO)
 	{
 		/* ROHC_IP_ID_BEHAVIOR_RAND or ROHC_IP_ID_BEHAVIOR_ZERO:
 		 * co_common or rnd_X packet types */
@@ -4625,7 +4989,7 @@ static rohc_packet_t tcp_decide_FO_SO_packet(const struct rohc_comp_ctxt *const
 	else
 	{
 		rohc_comp_warn(context, "unexpected IP-ID behavior (%d)",
-		               ip_inner_context->ctxt.vx.ip_id_behavior);
+		               tcp_context->tmp.ip_id_behavior);
 		assert(0);
 		goto error;
 	}
@@ -4663,14 +5027,14 @@ static rohc_packet_t tcp_decide_FO_SO_packet_seq(const struct rohc_comp_ctxt *co
 	size_t nr_ack_bits_8191; /* min bits required to encode TCP ACK number with p = 8191 */
 	rohc_packet_t packet_type;
 
-	nr_seq_bits_32767 = wlsb_get_kp_32bits(&tcp_context->seq_wlsb, seq_num_hbo, 32767);
+	nr_seq_bits_32767 = wlsb_get_minkp_32bits_memo(&tcp_context->seq_wlsb, seq_num_hbo, 0, 32767);
 	rohc_comp_debug(context, "%zd bits are required to encode new sequence "
 	                "number 0x%08x with p = 32767", nr_seq_bits_32767, seq_num_hbo);
-	nr_seq_bits_8191 = wlsb_get_kp_32bits(&tcp_context->seq_wlsb, seq_num_hbo, 8191);
+	nr_seq_bits_8191 = wlsb_get_minkp_32bits_memo(&tcp_context->seq_wlsb, seq_num_hbo, 0, 8191);
 	rohc_comp_debug(context, "%zd bits are required to encode new sequence "
 	                "number 0x%08x with p = 8191", nr_seq_bits_8191, seq_num_hbo);
 
-	nr_ack_bits_8191 = wlsb_get_kp_32bits(&tcp_context->ack_wlsb, ack_num_hbo, 8191);
+	nr_ack_bits_8191 = wlsb_get_minkp_32bits_memo(&tcp_context->ack_wlsb, ack_num_hbo, 0, 8191);
 	rohc_comp_debug(context, "%zd bits are required to encode new ACK "
 	                "number 0x%08x with p = 8191", nr_ack_bits_8191, ack_num_hbo);
 
@@ -4706,7 +5070,7 @@ static rohc_packet_t tcp_decide_FO_SO_packet_seq(const struct rohc_comp_ctxt *co
 	{
 		size_t nr_ack_bits_32767; /* min bits required to encode TCP ACK number with p = 32767 */
 
-		nr_ack_bits_32767 = wlsb_get_kp_32bits(&tcp_context->ack_wlsb, ack_num_hbo, 32767);
+		nr_ack_bits_32767 = wlsb_get_minkp_32bits_memo(&tcp_context->ack_wlsb, ack_num_hbo, 0, 32767);
 		rohc_comp_debug(context, "%zd bits are required to encode new ACK "
 		                "number 0x%08x with p = 32767", nr_ack_bits_32767, ack_num_hbo);
 
@@ -4733,7 +5097,7 @@ static rohc_packet_t tcp_decide_FO_SO_packet_seq(const struct rohc_comp_ctxt *co
 		/* seq_2, seq_1 or co_common */
 		if(!crc7_at_least &&
 		   tcp_context->tmp.nr_ip_id_bits_3 <= 7 &&
-		   tcp_context->seq_num_scaling_nr >= ROHC_INIT_TS_STRIDE_MIN &&
+		   tcp_context->tmp.seq_num_scaling_nr >= context->oa_repetitions_nr &&
 		   tcp_context->tmp.nr_seq_scaled_bits <= 4)
 		{
 			/* seq_2 is possible */
@@ -4768,8 +5132,8 @@ static rohc_packet_t tcp_decide_FO_SO_packet_seq(const struct rohc_comp_ctxt *co
 		/* seq_4, seq_3, or co_common */
 		if(!crc7_at_least &&
 		   tcp_context->tmp.nr_ip_id_bits_1 <= 3 &&
-		   tcp_is_ack_scaled_possible(tcp_context->ack_stride,
-		                              tcp_context->ack_num_scaling_nr) &&
+		   tcp_is_ack_scaled_possible(tcp_context->tmp.ack_stride,
+		                              tcp_context->tmp.ack_num_scaling_nr) &&
 		   tcp_context->tmp.nr_ack_scaled_bits <= 4)
 		{
 			TRACE_GOTO_CHOICE;
@@ -4802,7 +5166,7 @@ static rohc_packet_t tcp_decide_FO_SO_packet_seq(const struct rohc_comp_ctxt *co
 		 * seq_6, seq_5, seq_8 or co_common */
 		if(!crc7_at_least &&
 		   tcp_context->tmp.nr_ip_id_bits_3 <= 4 &&
-		   tcp_context->seq_num_scaling_nr >= ROHC_INIT_TS_STRIDE_MIN &&
+		   tcp_context->tmp.seq_num_scaling_nr >= context->oa_repetitions_nr &&
 		   tcp_context->tmp.nr_seq_scaled_bits <= 4 &&
 		   tcp_context->tmp.nr_ack_bits_16383 <= 16)
 		{
@@ -4866,14 +5230,14 @@ static rohc_packet_t tcp_decide_FO_SO_packet_rnd(const struct rohc_comp_ctxt *co
 	size_t nr_ack_bits_8191; /* min bits required to encode TCP ACK number with p = 8191 */
 	rohc_packet_t packet_type;
 
-	nr_seq_bits_65535 = wlsb_get_kp_32bits(&tcp_context->seq_wlsb, seq_num_hbo, 65535);
+	nr_seq_bits_65535 = wlsb_get_minkp_32bits_memo(&tcp_context->seq_wlsb, seq_num_hbo, 0, 65535);
 	rohc_comp_debug(context, "%zd bits are required to encode new sequence "
 	                "number 0x%08x with p = 65535", nr_seq_bits_65535, seq_num_hbo);
-	nr_seq_bits_8191 = wlsb_get_kp_32bits(&tcp_context->seq_wlsb, seq_num_hbo, 8191);
+	nr_seq_bits_8191 = wlsb_get_minkp_32bits_memo(&tcp_context->seq_wlsb, seq_num_hbo, 0, 8191);
 	rohc_comp_debug(context, "%zd bits are required to encode new sequence "
 	                "number 0x%08x with p = 8191", nr_seq_bits_8191, seq_num_hbo);
 
-	nr_ack_bits_8191 = wlsb_get_kp_32bits(&tcp_context->ack_wlsb, ack_num_hbo, 8191);
+	nr_ack_bits_8191 = wlsb_get_minkp_32bits_memo(&tcp_context->ack_wlsb, ack_num_hbo, 0, 8191);
 	rohc_comp_debug(context, "%zd bits are required to encode new ACK "
 	                "number 0x%08x with p = 8191", nr_ack_bits_8191, ack_num_hbo);
 
@@ -4900,7 +5264,7 @@ static rohc_packet_t tcp_decide_FO_SO_packet_rnd(const struct rohc_comp_ctxt *co
 		{
 			size_t nr_ack_bits_65535; /* min bits required to encode ACK number with p = 65535 */
 
-			nr_ack_bits_65535 = wlsb_get_kp_32bits(&tcp_context->ack_wlsb, ack_num_hbo, 65535);
+			nr_ack_bits_65535 = wlsb_get_minkp_32bits_memo(&tcp_context->ack_wlsb, ack_num_hbo, 0, 65535);
 			rohc_comp_debug(context, "%zd bits are required to encode new ACK "
 			                "number 0x%08x with p = 65535", nr_ack_bits_65535, ack_num_hbo);
 
@@ -4922,7 +5286,7 @@ static rohc_packet_t tcp_decide_FO_SO_packet_rnd(const struct rohc_comp_ctxt *co
 		else if(!crc7_at_least &&
 		        !tcp_context->tmp.tcp_ack_num_changed &&
 		        tcp_context->tmp.payload_len > 0 &&
-		        tcp_context->seq_num_scaling_nr >= ROHC_INIT_TS_STRIDE_MIN &&
+		        tcp_context->tmp.seq_num_scaling_nr >= context->oa_repetitions_nr &&
 		        tcp_context->tmp.nr_seq_scaled_bits <= 4)
 		{
 			/* rnd_2 is possible */
@@ -4932,8 +5296,8 @@ static rohc_packet_t tcp_decide_FO_SO_packet_rnd(const struct rohc_comp_ctxt *co
 		}
 		else if(!crc7_at_least &&
 		        tcp->ack_flag != 0 &&
-		        tcp_is_ack_scaled_possible(tcp_context->ack_stride,
-		                                   tcp_context->ack_num_scaling_nr) &&
+		        tcp_is_ack_scaled_possible(tcp_context->tmp.ack_stride,
+		                                   tcp_context->tmp.ack_num_scaling_nr) &&
 		        tcp_context->tmp.nr_ack_scaled_bits <= 4 &&
 		        !tcp_context->tmp.tcp_seq_num_changed)
 		{
@@ -4960,7 +5324,7 @@ static rohc_packet_t tcp_decide_FO_SO_packet_rnd(const struct rohc_comp_ctxt *co
 		}
 		else if(!crc7_at_least &&
 		        tcp->ack_flag != 0 &&
-		        tcp_context->seq_num_scaling_nr >= ROHC_INIT_TS_STRIDE_MIN &&
+		        tcp_context->tmp.seq_num_scaling_nr >= context->oa_repetitions_nr &&
 		        tcp_context->tmp.nr_seq_scaled_bits <= 4 &&
 		        tcp_context->tmp.nr_ack_bits_16383 <= 16)
 		{
@@ -5039,6 +5403,11 @@ static void tcp_detect_ecn_used_behavior(struct rohc_comp_ctxt *const context,
 		 ecn_used_change_needed_by_ecn_flags_unset ||
 		 ecn_used_change_needed_by_ecn_flags_set);
 
+	/* the new values are based on the ones of the context */
+	tcp_context->tmp.ecn_used = tcp_context->ecn_used;
+	tcp_context->tmp.ecn_used_change_count = tcp_context->ecn_used_change_count;
+	tcp_context->tmp.ecn_used_zero_count = tcp_context->ecn_used_zero_count;
+
 	tcp_field_descr_change(context, "RES flags", tcp_res_flag_changed, 0);
 	rohc_comp_debug(context, "ECN: context did%s use ECN",
 	                tcp_context->ecn_used ? "" : "n't");
@@ -5059,16 +5428,16 @@ static void tcp_detect_ecn_used_behavior(struct rohc_comp_ctxt *const context,
 			                "before changing the context ecn_used parameter",
 			                MAX_FO_COUNT - tcp_context->ecn_used_zero_count);
 			tcp_context->tmp.ecn_used_changed = false;
-			tcp_context->ecn_used_zero_count++;
+			tcp_context->tmp.ecn_used_zero_count++;
 		}
 		else
 		{
 			rohc_comp_debug(context, "ECN: behavior changed");
 			tcp_context->tmp.ecn_used_changed = true;
-			tcp_context->ecn_used =
+			tcp_context->tmp.ecn_used =
 				!!(pkt_ecn_vals != 0 || tcp_res_flag_changed || pkt_outer_dscp_changed);
-			tcp_context->ecn_used_change_count = 0;
-			tcp_context->ecn_used_zero_count = 0;
+			tcp_context->tmp.ecn_used_change_count = 0;
+			tcp_context->tmp.ecn_used_zero_count = 0;
 		}
 	}
 	else if(tcp_context->ecn_used_change_count < MAX_FO_COUNT)
@@ -5076,17 +5445,17 @@ static void tcp_detect_ecn_used_behavior(struct rohc_comp_ctxt *const context,
 		rohc_comp_debug(context, "ECN: behavior didn't change but changed a few "
 		                "packet before");
 		tcp_context->tmp.ecn_used_changed = true;
-		tcp_context->ecn_used_change_count++;
-		tcp_context->ecn_used_zero_count = 0;
+		tcp_context->tmp.ecn_used_change_count++;
+		tcp_context->tmp.ecn_used_zero_count = 0;
 	}
 	else
 	{
 		rohc_comp_debug(context, "ECN: behavior didn't change");
 		tcp_context->tmp.ecn_used_changed = false;
-		tcp_context->ecn_used_zero_count = 0;
+		tcp_context->tmp.ecn_used_zero_count = 0;
 	}
 	rohc_comp_debug(context, "ECN: context does%s use ECN",
-	                tcp_context->ecn_used ? "" : "n't");
+	                tcp_context->tmp.ecn_used ? "" : "n't");
 }
 
 
@@ -5278,27 +5647,22 @@ static bool c_tcp_feedback_2(struct rohc_comp_ctxt *const context,
 		}
 		case ROHC_FEEDBACK_NACK:
 		{
-			/* RFC3095 §5.4.1.1.1: NACKs, downward transition */
+			/* RFC6846 §5.2.2: NACKs, downward transition */
 			rohc_info(context->compressor, ROHC_TRACE_COMP, context->profile->id,
-			          "NACK received for CID %zu", context->cid);
+			          "NACK received for CID %zu (%zu-bit SN = 0x%x)",
+			          context->cid, sn_bits_nr, sn_bits);
 			/* the compressor transits back to the FO state */
-			if(context->state == ROHC_COMP_STATE_SO)
-			{
-				rohc_comp_change_state(context, ROHC_COMP_STATE_FO);
-			}
-			/* TODO: use the SN field to determine the latest packet successfully
-			 * decompressed and then determine what fields need to be updated */
+			c_tcp_feedback_nack(context, false);
 			break;
 		}
 		case ROHC_FEEDBACK_STATIC_NACK:
 		{
-			/* RFC3095 §5.4.1.1.1: NACKs, downward transition */
+			/* RFC6846 §5.2.2: STATIC-NACKs, downward transition */
 			rohc_info(context->compressor, ROHC_TRACE_COMP, context->profile->id,
-			          "STATIC-NACK received for CID %zu", context->cid);
+			          "STATIC-NACK received for CID %zu (%zu-bit SN = 0x%x)",
+			          context->cid, sn_bits_nr, sn_bits);
 			/* the compressor transits back to the IR state */
-			rohc_comp_change_state(context, ROHC_COMP_STATE_IR);
-			/* TODO: use the SN field to determine the latest packet successfully
-			 * decompressed and then determine what fields need to be updated */
+			c_tcp_feedback_nack(context, true);
 			break;
 		}
 		case ROHC_FEEDBACK_RESERVED:
@@ -5348,6 +5712,9 @@ static void c_tcp_feedback_ack(struct rohc_comp_ctxt *const context,
 		assert(sn_bits_nr <= 16);
 		assert(sn_bits <= 0xffffU);
 
+		/* let the positive ACKs drive the windows on reliable feedback channels */
+		c_tcp_set_wlsb_ack_driven(tcp_context, rohc_comp_wlsb_is_ack_driven(context));
+
 		/* ack TTL or Hop Limit */
 		acked_nr = wlsb_ack(&tcp_context->ttl_hopl_wlsb, sn_bits, sn_bits_nr);
 		rohc_comp_debug(context, "FEEDBACK-2: positive ACK removed %zu values "
@@ -5385,6 +5752,18 @@ static void c_tcp_feedback_ack(struct rohc_comp_ctxt *const context,
 		acked_nr = wlsb_ack(&tcp_context->msn_wlsb, sn_bits, sn_bits_nr);
 		rohc_comp_debug(context, "FEEDBACK-2: positive ACK removed %zu values "
 		                "from SN W-LSB", acked_nr);
+
+		/* adapt the width of the W-LSB windows to the number of packets that
+		 * were sent after the acknowledged one (the 8-bit MSN of FEEDBACK-1
+		 * may wrap around while packets are not acknowledged yet, do not
+		 * shrink the windows with it) */
+		if(sn_bits_nr >= ROHC_WLSB_WIDTH_ACK_SN_BITS_MIN &&
+		   rohc_comp_wlsb_width_adapt(context, ROHC_FEEDBACK_ACK,
+		                              (tcp_context->msn - sn_bits) &
+		                              ((1U << sn_bits_nr) - 1)))
+		{
+			c_tcp_set_wlsb_width(tcp_context, context->wlsb_window_width);
+		}
 	}
 
 	/* RFC 6846, §5.2.2.1:
@@ -5394,7 +5773,17 @@ static void c_tcp_feedback_ack(struct rohc_comp_ctxt *const context,
 	 *   compressor obtains confidence that the decompressor has received the
 	 *   acknowledged packet and that it has observed changes in the packet
 	 *   flow up to the acknowledged packet. */
-	if(context->state != ROHC_COMP_STATE_SO && !sn_not_valid)
+	if(context->state != ROHC_COMP_STATE_SO && !sn_not_valid &&
+	   tcp_context->nack_refresh_pending)
+	{
+		/* the NACK emptied the W-LSB windows, so the ACK cannot be checked
+		 * against the last context-updating packet: wait for the ACK of the
+		 * refresh packet before any upgrade */
+		rohc_comp_debug(context, "FEEDBACK-2: positive ACK DOES NOT make the "
+		                "compressor transit to the SO state more quickly (context "
+		                "was not refreshed yet since last NACK)");
+	}
+	else if(context->state != ROHC_COMP_STATE_SO && !sn_not_valid)
 	{
 		uint16_t sn_mask;
 		if(sn_bits_nr < 16)
@@ -5435,6 +5824,158 @@ static void c_tcp_feedback_ack(struct rohc_comp_ctxt *const context,
 }
 
 
+/**
+ * @brief Perform the required actions after the reception of a NACK or a
+ *        STATIC-NACK
+ *
+ * RFC 6846 §5.2.2: upon reception of a NACK, the compressor transits back to
+ * the FO state and sends updated information to the decompressor; upon
+ * reception of a STATIC-NACK, the compressor transits back to the IR state.
+ *
+ * The decompressor context is damaged, so the values stored in the W-LSB
+ * windows cannot be used as references anymore: the windows are emptied and
+ * only the values transmitted in the refresh packets will be used as
+ * references for the next packets.
+ *
+ * @param context         The compression context that received a NACK
+ * @param is_static_nack  true if a STATIC-NACK was received,
+ *                        false if a NACK was received
+ */
+static void c_tcp_feedback_nack(struct rohc_comp_ctxt *const context,
+                                const bool is_static_nack)
+{
+	struct sc_tcp_context *const tcp_context = context->specific;
+
+	/* forget about all the references the decompressor might have lost */
+	c_tcp_reset_wlsb(tcp_context);
+	rohc_comp_debug(context, "NACK: all W-LSB windows were reset");
+
+	/* the references were not robust enough against losses */
+	if(rohc_comp_wlsb_width_adapt(context, is_static_nack ?
+	                              ROHC_FEEDBACK_STATIC_NACK : ROHC_FEEDBACK_NACK, 0))
+	{
+		c_tcp_set_wlsb_width(tcp_context, context->wlsb_window_width);
+	}
+
+	/* the unscaled sequence and ACK numbers and the ack_stride shall be
+	 * transmitted again before the scaled fields may be used */
+	tcp_context->seq_num_scaling_nr = 0;
+	tcp_context->ack_num_scaling_nr = 0;
+
+	/* ignore positive ACKs for upgrades until the context is refreshed */
+	tcp_context->nack_refresh_pending = true;
+
+	if(is_static_nack)
+	{
+		/* restart the IR state from the beginning, even if the compressor is
+		 * already in IR state */
+		rohc_comp_change_state(context, ROHC_COMP_STATE_IR);
+		context->ir_count = 0;
+		tcp_context->dyn_refresh_required = false;
+	}
+	else if(context->state == ROHC_COMP_STATE_IR ||
+	        context->state == ROHC_COMP_STATE_CR)
+	{
+		/* IR and IR-CR packets already refresh the dynamic chain */
+		rohc_comp_debug(context, "NACK: stay in state %d that already refreshes "
+		                "the dynamic chain", context->state);
+	}
+	else
+	{
+		/* restart the FO state from the beginning, even if the compressor is
+		 * already in FO state, and send the dynamic chain in every FO packet */
+		rohc_comp_change_state(context, ROHC_COMP_STATE_FO);
+		context->fo_count = 0;
+		tcp_context->dyn_refresh_required = true;
+	}
+}
+
+
+/**
+ * @brief Remove all the references from the W-LSB windows of the TCP context
+ *
+ * @param tcp_context  The TCP compression context
+ */
+static void c_tcp_reset_wlsb(struct sc_tcp_context *const tcp_context)
+{
+	/* MSN */
+	wlsb_reset(&tcp_context->msn_wlsb);
+	/* innermost IP-ID offset */
+	wlsb_reset(&tcp_context->ip_id_wlsb);
+	/* innermost IPv4 TTL or IPv6 Hop Limit */
+	wlsb_reset(&tcp_context->ttl_hopl_wlsb);
+	/* TCP window */
+	wlsb_reset(&tcp_context->window_wlsb);
+	/* TCP (scaled) sequence number */
+	wlsb_reset(&tcp_context->seq_wlsb);
+	wlsb_reset(&tcp_context->seq_scaled_wlsb);
+	/* TCP (scaled) acknowledgment number */
+	wlsb_reset(&tcp_context->ack_wlsb);
+	wlsb_reset(&tcp_context->ack_scaled_wlsb);
+	/* TCP TS option */
+	wlsb_reset(&tcp_context->tcp_opts.ts_req_wlsb);
+	wlsb_reset(&tcp_context->tcp_opts.ts_reply_wlsb);
+}
+
+
+/**
+ * @brief Resize the W-LSB windows of the TCP context
+ *
+ * @param tcp_context  The TCP compression context
+ * @param width        The new width of the W-LSB windows
+ */
+static void c_tcp_set_wlsb_width(struct sc_tcp_context *const tcp_context,
+                                 const size_t width)
+{
+	/* MSN */
+	wlsb_set_window_width(&tcp_context->msn_wlsb, width);
+	/* innermost IP-ID offset */
+	wlsb_set_window_width(&tcp_context->ip_id_wlsb, width);
+	/* innermost IPv4 TTL or IPv6 Hop Limit */
+	wlsb_set_window_width(&tcp_context->ttl_hopl_wlsb, width);
+	/* TCP window */
+	wlsb_set_window_width(&tcp_context->window_wlsb, width);
+	/* TCP (scaled) sequence number */
+	wlsb_set_window_width(&tcp_context->seq_wlsb, width);
+	wlsb_set_window_width(&tcp_context->seq_scaled_wlsb, width);
+	/* TCP (scaled) acknowledgment number */
+	wlsb_set_window_width(&tcp_context->ack_wlsb, width);
+	wlsb_set_window_width(&tcp_context->ack_scaled_wlsb, width);
+	/* TCP TS option */
+	wlsb_set_window_width(&tcp_context->tcp_opts.ts_req_wlsb, width);
+	wlsb_set_window_width(&tcp_context->tcp_opts.ts_reply_wlsb, width);
+}
+
+
+/**
+ * @brief Let the positive ACKs drive the W-LSB windows of the TCP context
+ *
+ * @param tcp_context    The TCP compression context
+ * @param is_ack_driven  Whether the W-LSB windows are driven by positive ACKs
+ */
+static void c_tcp_set_wlsb_ack_driven(struct sc_tcp_context *const tcp_context,
+                                      const bool is_ack_driven)
+{
+	/* MSN */
+	wlsb_set_ack_driven(&tcp_context->msn_wlsb, is_ack_driven);
+	/* innermost IP-ID offset */
+	wlsb_set_ack_driven(&tcp_context->ip_id_wlsb, is_ack_driven);
+	/* innermost IPv4 TTL or IPv6 Hop Limit */
+	wlsb_set_ack_driven(&tcp_context->ttl_hopl_wlsb, is_ack_driven);
+	/* TCP window */
+	wlsb_set_ack_driven(&tcp_context->window_wlsb, is_ack_driven);
+	/* TCP (scaled) sequence number */
+	wlsb_set_ack_driven(&tcp_context->seq_wlsb, is_ack_driven);
+	wlsb_set_ack_driven(&tcp_context->seq_scaled_wlsb, is_ack_driven);
+	/* TCP (scaled) acknowledgment number */
+	wlsb_set_ack_driven(&tcp_context->ack_wlsb, is_ack_driven);
+	wlsb_set_ack_driven(&tcp_context->ack_scaled_wlsb, is_ack_driven);
+	/* TCP TS option */
+	wlsb_set_ack_driven(&tcp_context->tcp_opts.ts_req_wlsb, is_ack_driven);
+	wlsb_set_ack_driven(&tcp_context->tcp_opts.ts_reply_wlsb, is_ack_driven);
+}
+
+
 /**
  * @brief Define the compression part of the TCP profile as described
  *        in the RFC 3095.
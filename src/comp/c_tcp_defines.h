@@ -32,6 +32,7 @@
 #include "protocols/ip.h"
 #include "protocols/tcp.h"
 #include "schemes/ip_ctxt.h"
+#include "schemes/comp_hdrs_cache.h"
 #include "c_tcp_opts_list.h"
 
 
@@ -42,10 +43,18 @@
  * This object must be used by the TCP-specific compression context
  * sc_tcp_context.
  *
+ * The new values of the context fields are computed here while the packet is
+ * being built. They are copied into the context only once the packet was
+ * successfully built.
+ *
  * @see sc_tcp_context
  */
 struct tcp_tmp_variables
 {
+	/** The classes of the header fields that changed since the last packet,
+	 *  see \ref rohc_hdrs_class_t */
+	uint8_t hdrs_changed;
+
 	/** Whether at least one of the static part of the IPv6 extensions changed
 	 * in the current packet */
 	bool is_ipv6_exts_list_static_changed;
@@ -58,11 +67,16 @@ struct tcp_tmp_variables
 	/* the length of the TCP payload (headers and options excluded) */
 	size_t payload_len;
 
+	/** The Master Sequence Number (MSN) of the packet being compressed */
+	uint16_t msn;
 	/** The minimal number of bits required to encode the MSN value */
 	size_t nr_msn_bits;
 
 	/** Whether the TCP window changed or not */
 	size_t tcp_window_changed;
+	/** The new number of times the window field was added to the compressed
+	 *  header */
+	size_t tcp_window_change_count;
 	/** The minimal number of bits required to encode the TCP window */
 	size_t nr_window_bits_16383;
 
@@ -71,6 +85,15 @@ struct tcp_tmp_variables
 	/** The minimal number of bits required to encode the TCP scaled sequence
 	 *  number */
 	size_t nr_seq_scaled_bits;
+	/** The new scaled TCP sequence number */
+	uint32_t seq_num_scaled;
+	/** The new residue of the TCP sequence number */
+	uint32_t seq_num_residue;
+	/** The new scaling factor of the TCP sequence number */
+	size_t seq_num_factor;
+	/** The number of transmissions since the sequence number scaling factor
+	 *  or residue changed (current packet excluded) */
+	size_t seq_num_scaling_nr;
 
 	/** Whether the ACK number changed or not */
 	bool tcp_ack_num_changed;
@@ -80,9 +103,22 @@ struct tcp_tmp_variables
 	/** The minimal number of bits required to encode the TCP scaled ACK
 	 * number */
 	size_t nr_ack_scaled_bits;
+	/** The ACK delta with the previous packet */
+	uint32_t ack_delta;
+	/** The new ACK stride */
+	uint16_t ack_stride;
+	/** The new scaled ACK number */
+	uint32_t ack_num_scaled;
+	/** The new residue of the ACK number */
+	uint16_t ack_num_residue;
+	/** The number of transmissions since the ACK stride or residue changed
+	 *  (current packet excluded) */
+	size_t ack_num_scaling_nr;
 
 	/** The IP-ID / SN delta (with bits swapped if necessary) */
 	uint16_t ip_id_delta;
+	/** The behavior of the innermost IP-ID field detected for current packet */
+	rohc_ip_id_behavior_t ip_id_behavior;
 	/** Whether the behavior of the IP-ID field changed with current packet */
 	bool ip_id_behavior_changed;
 	/** The minimal number of bits required to encode the innermost IP-ID value
@@ -96,6 +132,7 @@ struct tcp_tmp_variables
 	uint8_t ttl_hopl;
 	size_t nr_ttl_hopl_bits;
 	bool ttl_hopl_changed;
+	size_t ttl_hopl_change_count;
 	/* outer IPv4 TTLs or IPv6 Hop Limits */
 	int ttl_irreg_chain_flag;
 	bool outer_ip_ttl_changed;
@@ -107,8 +144,21 @@ struct tcp_tmp_variables
 	bool tcp_urg_flag_present;
 	bool tcp_urg_flag_changed;
 
+	/** The new value of the ecn_used flag */
+	bool ecn_used;
 	/** Whether the ecn_used flag changed or not */
 	bool ecn_used_changed;
+	/** The new number of times the ECN fields were added to the compressed
+	 *  header */
+	size_t ecn_used_change_count;
+	/** The new number of times the ECN fields were not needed */
+	size_t ecn_used_zero_count;
+
+	/* Context Replication: the new presence of the optional fields */
+	bool cr_ttl_hopl_present[ROHC_MAX_IP_HDRS];
+	bool cr_tcp_window_present;
+	bool cr_tcp_urg_ptr_present;
+	bool cr_tcp_ack_num_present;
 };
 
 
@@ -134,6 +184,14 @@ struct sc_tcp_context
 	 * if a positive ACK may cause a transition to a higher compression state) */
 	uint16_t msn_of_last_ctxt_updating_pkt;
 
+	/** Whether the decompressor reported a damaged context with a NACK, so
+	 * the dynamic chain shall be refreshed while the compressor is in FO state */
+	bool dyn_refresh_required;
+	/** Whether a NACK or STATIC-NACK was received but no refresh packet was
+	 * sent since then: positive ACKs received meanwhile acknowledge packets
+	 * sent before the context damage, so they cannot upgrade the state */
+	bool nack_refresh_pending;
+
 	struct c_wlsb ttl_hopl_wlsb;
 	size_t ttl_hopl_change_count;
 
@@ -173,6 +231,9 @@ struct sc_tcp_context
 	/// The previous TCP header
 	struct tcphdr old_tcphdr;
 
+	/** The copy of the IP headers and TCP header of the previous packet */
+	struct c_hdrs_cache hdrs_cache;
+
 	/// @brief TCP-specific temporary variables that are used during one single
 	///        compression of packet
 	struct tcp_tmp_variables tmp;
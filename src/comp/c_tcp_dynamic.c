@@ -36,7 +36,7 @@
 #include <assert.h>
 
 static int tcp_code_dynamic_ipv4_part(const struct rohc_comp_ctxt *const context,
-                                      ip_context_t *const ip_context,
+                                      const ip_context_t *const ip_context,
                                       const struct ipv4_hdr *const ipv4,
                                       const bool is_innermost,
                                       uint8_t *const rohc_data,
@@ -44,7 +44,7 @@ static int tcp_code_dynamic_ipv4_part(const struct rohc_comp_ctxt *const context
 	__attribute__((warn_unused_result, nonnull(1, 2, 3, 5)));
 
 static int tcp_code_dynamic_ipv6_part(const struct rohc_comp_ctxt *const context,
-                                      ip_context_t *const ip_context,
+                                      const ip_context_t *const ip_context,
                                       const struct ipv6_hdr *const ipv6,
                                       uint8_t *const rohc_data,
                                       const size_t rohc_max_len)
@@ -82,7 +82,6 @@ int tcp_code_dyn_part(struct rohc_comp_ctxt *const context,
                       size_t *const parsed_len)
 {
 	struct sc_tcp_context *const tcp_context = context->specific;
-	ip_context_t *inner_ip_context = NULL;
 
 	const uint8_t *remain_data = ip->data;
 	size_t remain_len = ip->size;
@@ -90,7 +89,6 @@ int tcp_code_dyn_part(struct rohc_comp_ctxt *const context,
 	uint8_t *rohc_remain_data = rohc_pkt;
 	size_t rohc_remain_len = rohc_pkt_max_len;
 
-	const struct ip_hdr *inner_ip_hdr = NULL;
 	size_t ip_hdr_pos;
 	int ret;
 
@@ -101,14 +99,10 @@ int tcp_code_dyn_part(struct rohc_comp_ctxt *const context,
 	for(ip_hdr_pos = 0; ip_hdr_pos < tcp_context->ip_contexts_nr; ip_hdr_pos++)
 	{
 		const struct ip_hdr *const ip_hdr = (struct ip_hdr *) remain_data;
-		ip_context_t *const ip_context = &(tcp_context->ip_contexts[ip_hdr_pos]);
+		const ip_context_t *const ip_context = &(tcp_context->ip_contexts[ip_hdr_pos]);
 		const bool is_inner = !!(ip_hdr_pos + 1 == tcp_context->ip_contexts_nr);
 		size_t ip_ext_pos;
 
-		/* the last IP header is the innermost one */
-		inner_ip_context = ip_context;
-		inner_ip_hdr = (struct ip_hdr *) remain_data;
-
 		/* retrieve IP version */
 		assert(remain_len >= sizeof(struct ip_hdr));
 		rohc_comp_debug(context, "found IPv%d", ip_hdr->version);
@@ -214,30 +208,6 @@ int tcp_code_dyn_part(struct rohc_comp_ctxt *const context,
 		*parsed_len = remain_data - ip->data;
 	}
 
-	/* update context with new values (done at the very end to avoid wrongly
-	 * updating the context in case of compression failure) */
-	if(inner_ip_hdr->version == IPV4)
-	{
-		const struct ipv4_hdr *const inner_ipv4 = (struct ipv4_hdr *) inner_ip_hdr;
-		inner_ip_context->ctxt.v4.last_ip_id_behavior =
-			inner_ip_context->ctxt.v4.ip_id_behavior;
-		inner_ip_context->ctxt.v4.last_ip_id = rohc_ntoh16(inner_ipv4->id);
-		inner_ip_context->ctxt.v4.df = inner_ipv4->df;
-		inner_ip_context->ctxt.vx.dscp = inner_ipv4->dscp;
-	}
-	else if(inner_ip_hdr->version == IPV6)
-	{
-		const struct ipv6_hdr *const inner_ipv6 = (struct ipv6_hdr *) inner_ip_hdr;
-		inner_ip_context->ctxt.vx.dscp = ipv6_get_dscp(inner_ipv6);
-	}
-	else
-	{
-		rohc_comp_warn(context, "unexpected IP version %u", inner_ip_hdr->version);
-		assert(0);
-		goto error;
-	}
-	inner_ip_context->ctxt.vx.ttl_hopl = tcp_context->tmp.ttl_hopl;
-
 	return (rohc_pkt_max_len - rohc_remain_len);
 
 error:
@@ -259,12 +229,13 @@ error:
  *                        -1 in case of error
  */
 static int tcp_code_dynamic_ipv4_part(const struct rohc_comp_ctxt *const context,
-                                      ip_context_t *const ip_context,
+                                      const ip_context_t *const ip_context,
                                       const struct ipv4_hdr *const ipv4,
                                       const bool is_innermost,
                                       uint8_t *const rohc_data,
                                       const size_t rohc_max_len)
 {
+	const struct sc_tcp_context *const tcp_context = context->specific;
 	ipv4_dynamic1_t *const ipv4_dynamic1 = (ipv4_dynamic1_t *) rohc_data;
 	size_t ipv4_dynamic_len = sizeof(ipv4_dynamic1_t);
 	uint16_t ip_id;
@@ -281,8 +252,7 @@ static int tcp_code_dynamic_ipv4_part(const struct rohc_comp_ctxt *const context
 
 	/* IP-ID */
 	ip_id = rohc_ntoh16(ipv4->id);
-	rohc_comp_debug(context, "ip_id_behavior = %d, last IP-ID = 0x%04x, "
-	                "IP-ID = 0x%04x", ip_context->ctxt.v4.ip_id_behavior,
+	rohc_comp_debug(context, "last IP-ID = 0x%04x, IP-ID = 0x%04x",
 	                ip_context->ctxt.v4.last_ip_id, ip_id);
 
 	ipv4_dynamic1->reserved = 0;
@@ -293,7 +263,7 @@ static int tcp_code_dynamic_ipv4_part(const struct rohc_comp_ctxt *const context
 	if(is_innermost)
 	{
 		/* all behavior values possible */
-		ipv4_dynamic1->ip_id_behavior = ip_context->ctxt.v4.ip_id_behavior;
+		ipv4_dynamic1->ip_id_behavior = tcp_context->tmp.ip_id_behavior;
 	}
 	else
 	{
@@ -306,11 +276,7 @@ static int tcp_code_dynamic_ipv4_part(const struct rohc_comp_ctxt *const context
 		{
 			ipv4_dynamic1->ip_id_behavior = ROHC_IP_ID_BEHAVIOR_RAND;
 		}
-		/* TODO: should not update context there */
-		ip_context->ctxt.v4.ip_id_behavior = ipv4_dynamic1->ip_id_behavior;
 	}
-	/* TODO: should not update context there */
-	ip_context->ctxt.v4.last_ip_id_behavior = ip_context->ctxt.v4.ip_id_behavior;
 
 	ipv4_dynamic1->dscp = ipv4->dscp;
 	ipv4_dynamic1->ip_ecn_flags = ipv4->ecn;
@@ -340,12 +306,6 @@ static int tcp_code_dynamic_ipv4_part(const struct rohc_comp_ctxt *const context
 		                ipv4_dynamic1->ip_id_behavior, rohc_ntoh16(ipv4->id));
 	}
 
-	/* TODO: should not update context there */
-	ip_context->ctxt.v4.dscp = ipv4->dscp;
-	ip_context->ctxt.v4.ttl = ipv4->ttl;
-	ip_context->ctxt.v4.df = ipv4->df;
-	ip_context->ctxt.v4.last_ip_id = rohc_ntoh16(ipv4->id);
-
 	rohc_comp_dump_buf(context, "IPv4 dynamic part", rohc_data, ipv4_dynamic_len);
 
 	return ipv4_dynamic_len;
@@ -367,7 +327,7 @@ error:
  *                        -1 in case of error
  */
 static int tcp_code_dynamic_ipv6_part(const struct rohc_comp_ctxt *const context,
-                                      ip_context_t *const ip_context,
+                                      const ip_context_t *const ip_context,
                                       const struct ipv6_hdr *const ipv6,
                                       uint8_t *const rohc_data,
                                       const size_t rohc_max_len)
@@ -390,10 +350,6 @@ static int tcp_code_dynamic_ipv6_part(const struct rohc_comp_ctxt *const context
 	ipv6_dynamic->ip_ecn_flags = ipv6->ecn;
 	ipv6_dynamic->ttl_hopl = ipv6->hl;
 
-	/* TODO: should not update context there */
-	ip_context->ctxt.v6.dscp = dscp;
-	ip_context->ctxt.v6.hopl = ipv6->hl;
-
 	rohc_comp_dump_buf(context, "IP dynamic part", rohc_data, ipv6_dynamic_len);
 
 	return ipv6_dynamic_len;
@@ -523,22 +479,19 @@ static int tcp_code_dynamic_tcp_part(const struct rohc_comp_ctxt *const context,
 	                "urg_ptr = %d", rohc_ntoh16(tcp->window),
 	                rohc_ntoh16(tcp->checksum), rohc_ntoh16(tcp->urg_ptr));
 
-	tcp_dynamic->ecn_used = tcp_context->ecn_used;
+	tcp_dynamic->ecn_used = tcp_context->tmp.ecn_used;
 	tcp_dynamic->tcp_res_flags = tcp->res_flags;
 	tcp_dynamic->tcp_ecn_flags = tcp->ecn_flags;
 	tcp_dynamic->urg_flag = tcp->urg_flag;
 	tcp_dynamic->ack_flag = tcp->ack_flag;
 	tcp_dynamic->psh_flag = tcp->psh_flag;
 	tcp_dynamic->rsf_flags = tcp->rsf_flags;
-	tcp_dynamic->msn = rohc_hton16(tcp_context->msn);
+	tcp_dynamic->msn = rohc_hton16(tcp_context->tmp.msn);
 	tcp_dynamic->seq_num = tcp->seq_num;
 
 	rohc_remain_data += sizeof(tcp_dynamic_t);
 	rohc_remain_len -= sizeof(tcp_dynamic_t);
 
-	/* TODO: should not update context here */
-	tcp_context->tcp_seq_num_change_count++;
-
 	/* ack_zero flag and ACK number: always check for the ACK number value even
 	 * if the ACK flag is not set in the uncompressed TCP header, this is
 	 * important to transmit all packets without any change, even if those bits
@@ -596,9 +549,9 @@ static int tcp_code_dynamic_tcp_part(const struct rohc_comp_ctxt *const context,
 	/* ack_stride */
 	{
 		const bool is_ack_stride_static =
-			tcp_is_ack_stride_static(tcp_context->ack_stride,
-			                         tcp_context->ack_num_scaling_nr);
-		ret = c_static_or_irreg16(rohc_hton16(tcp_context->ack_stride),
+			tcp_is_ack_stride_static(tcp_context->tmp.ack_stride,
+			                         tcp_context->tmp.ack_num_scaling_nr);
+		ret = c_static_or_irreg16(rohc_hton16(tcp_context->tmp.ack_stride),
 		                          is_ack_stride_static,
 		                          rohc_remain_data, rohc_remain_len, &indicator);
 		if(ret < 0)
@@ -634,8 +587,7 @@ static int tcp_code_dynamic_tcp_part(const struct rohc_comp_ctxt *const context,
 	{
 		bool no_item_needed;
 
-		ret = c_tcp_code_tcp_opts_list_item(context, tcp, tcp_context->msn,
-		                                    ROHC_CHAIN_DYNAMIC,
+		ret = c_tcp_code_tcp_opts_list_item(context, tcp, ROHC_CHAIN_DYNAMIC,
 		                                    &tcp_context->tcp_opts,
 		                                    rohc_remain_data, rohc_remain_len,
 		                                    &no_item_needed);
@@ -128,7 +128,7 @@ int tcp_code_irreg_chain(struct rohc_comp_ctxt *const context,
 			assert(remain_len >= sizeof(struct ipv4_hdr));
 
 			ret = tcp_code_irregular_ipv4_part(context, ip_context, ipv4, is_innermost,
-			                                   tcp_context->ecn_used, ip_inner_ecn,
+			                                   tcp_context->tmp.ecn_used, ip_inner_ecn,
 			                                   tcp_context->tmp.ttl_irreg_chain_flag,
 			                                   rohc_remain_data, rohc_remain_len);
 			if(ret < 0)
@@ -152,7 +152,7 @@ int tcp_code_irreg_chain(struct rohc_comp_ctxt *const context,
 			assert(remain_len >= sizeof(struct ipv6_hdr));
 
 			ret = tcp_code_irregular_ipv6_part(context, ip_context, ipv6, is_innermost,
-			                                   tcp_context->ecn_used, ip_inner_ecn,
+			                                   tcp_context->tmp.ecn_used, ip_inner_ecn,
 			                                   tcp_context->tmp.ttl_irreg_chain_flag,
 			                                   rohc_remain_data, rohc_remain_len);
 			if(ret < 0)
@@ -248,19 +248,32 @@ static int tcp_code_irregular_ipv4_part(const struct rohc_comp_ctxt *const conte
                                         uint8_t *const rohc_data,
                                         const size_t rohc_max_len)
 {
+	const struct sc_tcp_context *const tcp_context = context->specific;
 	uint8_t *rohc_remain_data = rohc_data;
 	size_t rohc_remain_len = rohc_max_len;
+	uint8_t ip_id_behavior;
 
 	assert(ip_context->ctxt.vx.version == IPV4);
 
+	/* the behavior of the innermost IP-ID is transmitted by the packet itself,
+	 * the ones of the outer IP-IDs are known from the context */
+	if(is_innermost)
+	{
+		ip_id_behavior = tcp_context->tmp.ip_id_behavior;
+	}
+	else
+	{
+		ip_id_behavior = ip_context->ctxt.v4.ip_id_behavior;
+	}
+
 	rohc_comp_debug(context, "ecn_used = %d, is_innermost = %d, "
 	                "ttl_irreg_chain_flag = %d, ip_inner_ecn = %u",
 	                ecn_used, is_innermost, ttl_irreg_chain_flag, ip_inner_ecn);
 	rohc_comp_debug(context, "IP version = 4, ip_id_behavior = %d",
-	                ip_context->ctxt.v4.ip_id_behavior);
+	                ip_id_behavior);
 
 	/* ip_id =:= ip_id_enc_irreg( ip_id_behavior.UVALUE ) */
-	if(ip_context->ctxt.v4.ip_id_behavior == ROHC_IP_ID_BEHAVIOR_RAND)
+	if(ip_id_behavior == ROHC_IP_ID_BEHAVIOR_RAND)
 	{
 		if(rohc_remain_len < sizeof(uint16_t))
 		{
@@ -475,7 +488,7 @@ static int tcp_code_irregular_tcp_part(const struct rohc_comp_ctxt *const contex
 	/* ip_ecn_flags = := tcp_irreg_ip_ecn(ip_inner_ecn)
 	 * tcp_res_flags =:= static_or_irreg(ecn_used.CVALUE,4)
 	 * tcp_ecn_flags =:= static_or_irreg(ecn_used.CVALUE,2) */
-	if(tcp_context->ecn_used)
+	if(tcp_context->tmp.ecn_used)
 	{
 		if(rohc_remain_len < 1)
 		{
@@ -507,9 +520,8 @@ static int tcp_code_irregular_tcp_part(const struct rohc_comp_ctxt *const contex
 	                rohc_ntoh16(tcp->checksum));
 
 	/* irregular part for TCP options */
-	ret = c_tcp_code_tcp_opts_irreg(context, tcp, tcp_context->msn,
-		                             &tcp_context->tcp_opts, rohc_remain_data,
-		                             rohc_remain_len);
+	ret = c_tcp_code_tcp_opts_irreg(context, tcp, &tcp_context->tcp_opts,
+	                                rohc_remain_data, rohc_remain_len);
 	if(ret < 0)
 	{
 		rohc_comp_warn(context, "failed to compress TCP options in irregular chain");
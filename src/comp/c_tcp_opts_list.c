@@ -602,8 +602,6 @@ bool tcp_detect_options_changes(struct rohc_comp_ctxt *const context,
 			                "in previous packet");
 		}
 
-		/* record the structure of the current list TCP options in context */
-		opts_ctxt->structure[opt_pos] = opt_type;
 	}
 	if(opt_pos >= ROHC_TCP_OPTS_MAX && opts_offset != (*opts_len))
 	{
@@ -628,8 +626,7 @@ bool tcp_detect_options_changes(struct rohc_comp_ctxt *const context,
 		rohc_comp_debug(context, "structure of TCP options list changed, "
 		                "compressed list must be transmitted in the compressed "
 		                "base header");
-		opts_ctxt->structure_nr = opts_nr;
-		opts_ctxt->structure_nr_trans = 0;
+		opts_ctxt->tmp.structure_nr_trans = 0;
 	}
 	else if(opts_ctxt->tmp.do_list_static_changed)
 	{
@@ -639,7 +636,7 @@ bool tcp_detect_options_changes(struct rohc_comp_ctxt *const context,
 		                "compressed list must be transmitted in the compressed "
 		                "base header");
 		assert(opts_ctxt->structure_nr == opts_nr);
-		opts_ctxt->structure_nr_trans = 0;
+		opts_ctxt->tmp.structure_nr_trans = 0;
 	}
 	else if(opts_ctxt->structure_nr_trans < context->compressor->list_trans_nr)
 	{
@@ -651,7 +648,7 @@ bool tcp_detect_options_changes(struct rohc_comp_ctxt *const context,
 		                opts_ctxt->structure_nr_trans);
 		opts_ctxt->tmp.do_list_struct_changed = true;
 		assert(opts_ctxt->structure_nr == opts_nr);
-		opts_ctxt->structure_nr_trans++;
+		opts_ctxt->tmp.structure_nr_trans = opts_ctxt->structure_nr_trans + 1;
 	}
 	else
 	{
@@ -661,6 +658,7 @@ bool tcp_detect_options_changes(struct rohc_comp_ctxt *const context,
 		                "base header, any content changes may be transmitted "
 		                "in the irregular chain");
 		assert(opts_ctxt->structure_nr == opts_nr);
+		opts_ctxt->tmp.structure_nr_trans = opts_ctxt->structure_nr_trans;
 	}
 
 	/* use 4-bit XI or 8-bit XI ? */
@@ -694,7 +692,6 @@ error:
  *
  * @param context            The compression context
  * @param tcp                The TCP header
- * @param msn                The Master Sequence Number (MSN) of the packet to compress
  * @param chain_type         The TCP chain for which the list of items is
  * @param[in,out] opts_ctxt  The compression context for TCP options
  * @param[out] comp_opts     The compressed TCP options
@@ -705,7 +702,6 @@ error:
  */
 int c_tcp_code_tcp_opts_list_item(const struct rohc_comp_ctxt *const context,
                                   const struct tcphdr *const tcp,
-                                  const uint16_t msn,
                                   const rohc_chain_t chain_type,
                                   struct c_tcp_opts_ctxt *const opts_ctxt,
                                   uint8_t *const comp_opts,
@@ -795,14 +791,9 @@ int c_tcp_code_tcp_opts_list_item(const struct rohc_comp_ctxt *const context,
 		item_needed = c_tcp_is_list_item_needed(context, chain_type, opt_idx,
 		                                        opt_type, opt_len, options, opts_ctxt);
 
-		/* if item is transmitted, the option is new, changed now or changed a
-		 * few packets back, so save the option in context */
-		/* TODO: move at the very end of compression to avoid altering
-		 *       context in case of compression failure */
 		if(item_needed)
 		{
 			(*no_item_needed) = false;
-			c_tcp_opt_record(opts_ctxt, opt_idx, options, opt_len);
 		}
 
 		/* write the XI field for the TCP option */
@@ -834,23 +825,11 @@ int c_tcp_code_tcp_opts_list_item(const struct rohc_comp_ctxt *const context,
 		comp_opt_len = ret;
 
 		/* TCP option is transmitted towards decompressor once more */
-		opts_ctxt->list[opt_idx].nr_trans++;
 		opts_ctxt->tmp.is_list_item_present[opt_idx] = true;
 		rohc_comp_debug(context, "TCP options list: option '%s' (%u) added "
 			                "%zu bytes of item", tcp_opt_get_descr(opt_type),
 			                opt_type, comp_opt_len);
 		comp_opts_len += comp_opt_len;
-
-		/* TODO: move at the very end of compression to avoid altering
-		 *       context in case of compression failure */
-		if(opt_type == TCP_OPT_TS)
-		{
-			const struct tcp_option_timestamp *const opt_ts =
-				(struct tcp_option_timestamp *) (options + 2);
-			opts_ctxt->is_timestamp_init = true;
-			c_add_wlsb(&opts_ctxt->ts_req_wlsb, msn, rohc_ntoh32(opt_ts->ts));
-			c_add_wlsb(&opts_ctxt->ts_reply_wlsb, msn, rohc_ntoh32(opt_ts->ts_reply));
-		}
 	}
 	if(opt_pos >= ROHC_TCP_OPTS_MAX && i != 0)
 	{
@@ -876,8 +855,7 @@ error:
  *
  * @param context            The compression context
  * @param tcp                The TCP header
- * @param msn                The Master Sequence Number (MSN) of the packet to compress
- * @param[in,out] opts_ctxt  The compression context for TCP options
+ * @param opts_ctxt          The compression context for TCP options
  * @param[out] comp_opts     The compressed TCP options
  * @param comp_opts_max_len  The max remaining length in the ROHC buffer
  * @return                   The length (in bytes) of compressed TCP options
@@ -887,8 +865,7 @@ error:
  */
 int c_tcp_code_tcp_opts_irreg(const struct rohc_comp_ctxt *const context,
                               const struct tcphdr *const tcp,
-                              const uint16_t msn,
-                              struct c_tcp_opts_ctxt *const opts_ctxt,
+                              const struct c_tcp_opts_ctxt *const opts_ctxt,
                               uint8_t *const comp_opts,
                               const size_t comp_opts_max_len)
 {
@@ -982,12 +959,6 @@ int c_tcp_code_tcp_opts_irreg(const struct rohc_comp_ctxt *const context,
 			rohc_remain_data += encoded_ts_lsb_len;
 			rohc_remain_len -= encoded_ts_lsb_len;
 			comp_opt_len += encoded_ts_lsb_len;
-
-			/* TODO: move at the very end of compression to avoid altering
-			 *       context in case of compression failure */
-			opts_ctxt->is_timestamp_init = true;
-			c_add_wlsb(&opts_ctxt->ts_req_wlsb, msn, rohc_ntoh32(opt_ts->ts));
-			c_add_wlsb(&opts_ctxt->ts_reply_wlsb, msn, rohc_ntoh32(opt_ts->ts_reply));
 		}
 		else if(opt_type == TCP_OPT_SACK)
 		{
@@ -1065,11 +1036,6 @@ int c_tcp_code_tcp_opts_irreg(const struct rohc_comp_ctxt *const context,
 		rohc_comp_debug(context, "irregular chain: added %zu bytes of irregular "
 		                "content for TCP option %u", comp_opt_len, opt_type);
 		comp_opts_len += comp_opt_len;
-
-		/* save the option in context */
-		/* TODO: move at the very end of compression to avoid altering
-		 *       context in case of compression failure */
-		c_tcp_opt_record(opts_ctxt, opt_idx, opts + opts_offset, opts_len - opts_offset);
 	}
 
 	return comp_opts_len;
@@ -1079,6 +1045,88 @@ error:
 }
 
 
+/**
+ * @brief Update the compression context of TCP options with the options of
+ *        the packet that was successfully compressed
+ *
+ * The options transmitted in the compressed list of TCP options or in the
+ * irregular chain are recorded in context, and the structure of the list of
+ * TCP options is saved for the next packets.
+ *
+ * @param context            The compression context
+ * @param tcp                The TCP header of the compressed packet
+ * @param msn                The Master Sequence Number (MSN) of the compressed
+ *                           packet
+ * @param is_irreg_chain     Whether the compressed packet contains an
+ *                           irregular chain (CO packets) or not
+ * @param[in,out] opts_ctxt  The compression context for TCP options
+ */
+void c_tcp_update_opts_ctxt(const struct rohc_comp_ctxt *const context,
+                            const struct tcphdr *const tcp,
+                            const uint16_t msn,
+                            const bool is_irreg_chain,
+                            struct c_tcp_opts_ctxt *const opts_ctxt)
+{
+	const uint8_t *const opts = ((uint8_t *) tcp) + sizeof(struct tcphdr);
+	const size_t opts_len = (tcp->data_offset << 2) - sizeof(struct tcphdr);
+	uint8_t opt_len;
+	size_t opts_offset;
+	size_t opt_pos;
+
+	assert(opts_ctxt->tmp.nr <= ROHC_TCP_OPTS_MAX);
+
+	for(opt_pos = 0, opts_offset = 0;
+	    opt_pos < opts_ctxt->tmp.nr;
+	    opt_pos++, opts_offset += opt_len)
+	{
+		const uint8_t opt_idx = opts_ctxt->tmp.position2index[opt_pos];
+		const uint8_t *const opt = opts + opts_offset;
+		uint8_t opt_type;
+
+		/* options were already parsed successfully when changes were detected */
+		if(!c_tcp_opt_get_type_len(opt, opts_len - opts_offset, &opt_type, &opt_len))
+		{
+			assert(0);
+			break;
+		}
+
+		/* record the structure of the list of TCP options */
+		opts_ctxt->structure[opt_pos] = opt_type;
+
+		if(opts_ctxt->tmp.is_list_item_present[opt_idx])
+		{
+			/* the item was transmitted because the option is new, changed now or
+			 * changed a few packets back, so save the option in context */
+			c_tcp_opt_record(opts_ctxt, opt_idx, opt, opt_len);
+			opts_ctxt->list[opt_idx].nr_trans++;
+		}
+		else if(is_irreg_chain)
+		{
+			/* the option was transmitted in the irregular chain */
+			c_tcp_opt_record(opts_ctxt, opt_idx, opt, opts_len - opts_offset);
+		}
+		else
+		{
+			continue;
+		}
+
+		if(opt_type == TCP_OPT_TS)
+		{
+			const struct tcp_option_timestamp *const opt_ts =
+				(struct tcp_option_timestamp *) (opt + 2);
+			opts_ctxt->is_timestamp_init = true;
+			c_add_wlsb(&opts_ctxt->ts_req_wlsb, msn, rohc_ntoh32(opt_ts->ts));
+			c_add_wlsb(&opts_ctxt->ts_reply_wlsb, msn, rohc_ntoh32(opt_ts->ts_reply));
+		}
+	}
+	opts_ctxt->structure_nr = opts_ctxt->tmp.nr;
+	opts_ctxt->structure_nr_trans = opts_ctxt->tmp.structure_nr_trans;
+
+	rohc_comp_debug(context, "TCP options: %zu options recorded in context",
+	                opts_ctxt->structure_nr);
+}
+
+
 /**
  * @brief Get the type and length of the next TCP option
  *
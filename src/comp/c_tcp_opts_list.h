@@ -72,6 +72,9 @@ struct c_tcp_opts_ctxt_tmp
 	/** Whether at least one of the static TCP options changed in the
 	 * current packet */
 	bool do_list_static_changed;
+	/** The new number of times the structure of the list of TCP options was
+	 * transmitted since it last changed */
+	size_t structure_nr_trans;
 	/** Whether the content of every TCP options was transmitted or not */
 	bool is_list_item_present[MAX_TCP_OPTION_INDEX + 1];
 
@@ -141,21 +144,26 @@ bool tcp_detect_options_changes(struct rohc_comp_ctxt *const context,
 
 int c_tcp_code_tcp_opts_list_item(const struct rohc_comp_ctxt *const context,
                                   const struct tcphdr *const tcp,
-                                  const uint16_t msn,
                                   const rohc_chain_t chain_type,
                                   struct c_tcp_opts_ctxt *const opts_ctxt,
                                   uint8_t *const comp_opts,
                                   const size_t comp_opts_max_len,
                                   bool *const no_item_needed)
-	__attribute__((warn_unused_result, nonnull(1, 2, 5, 6, 8)));
+	__attribute__((warn_unused_result, nonnull(1, 2, 4, 5, 7)));
 
 int c_tcp_code_tcp_opts_irreg(const struct rohc_comp_ctxt *const context,
                               const struct tcphdr *const tcp,
-                              const uint16_t msn,
-                              struct c_tcp_opts_ctxt *const opts_ctxt,
+                              const struct c_tcp_opts_ctxt *const opts_ctxt,
                               uint8_t *const comp_opts,
                               const size_t comp_opts_max_len)
-	__attribute__((warn_unused_result, nonnull(1, 2, 4, 5)));
+	__attribute__((warn_unused_result, nonnull(1, 2, 3, 4)));
+
+void c_tcp_update_opts_ctxt(const struct rohc_comp_ctxt *const context,
+                            const struct tcphdr *const tcp,
+                            const uint16_t msn,
+                            const bool is_irreg_chain,
+                            struct c_tcp_opts_ctxt *const opts_ctxt)
+	__attribute__((nonnull(1, 2, 5)));
 
 #endif /* ROHC_COMP_TCP_OPTS_LIST_H */
 
@@ -32,15 +32,16 @@
 #include <assert.h>
 
 static int tcp_code_replicate_ipv4_part(const struct rohc_comp_ctxt *const context,
-                                        ip_context_t *const ip_context,
+                                        const ip_context_t *const ip_context,
+                                        const size_t ip_hdr_pos,
                                         const struct ipv4_hdr *const ipv4,
                                         const bool is_innermost,
                                         uint8_t *const rohc_data,
                                         const size_t rohc_max_len)
-	__attribute__((warn_unused_result, nonnull(1, 2, 3, 5)));
+	__attribute__((warn_unused_result, nonnull(1, 2, 4, 6)));
 
 static int tcp_code_replicate_ipv6_part(const struct rohc_comp_ctxt *const context,
-                                        ip_context_t *const ip_context,
+                                        const ip_context_t *const ip_context,
                                         const struct ipv6_hdr *const ipv6,
                                         uint8_t *const rohc_data,
                                         const size_t rohc_max_len)
@@ -92,7 +93,7 @@ int tcp_code_replicate_chain(struct rohc_comp_ctxt *const context,
 	for(ip_hdr_pos = 0; ip_hdr_pos < tcp_context->ip_contexts_nr; ip_hdr_pos++)
 	{
 		const struct ip_hdr *const ip_hdr = (struct ip_hdr *) remain_data;
-		ip_context_t *const ip_context = &(tcp_context->ip_contexts[ip_hdr_pos]);
+		const ip_context_t *const ip_context = &(tcp_context->ip_contexts[ip_hdr_pos]);
 		const bool is_inner = !!(ip_hdr_pos + 1 == tcp_context->ip_contexts_nr);
 		size_t ip_ext_pos;
 
@@ -106,8 +107,9 @@ int tcp_code_replicate_chain(struct rohc_comp_ctxt *const context,
 
 			assert(remain_len >= sizeof(struct ipv4_hdr));
 
-			ret = tcp_code_replicate_ipv4_part(context, ip_context, ipv4, is_inner,
-			                                   rohc_remain_data, rohc_remain_len);
+			ret = tcp_code_replicate_ipv4_part(context, ip_context, ip_hdr_pos, ipv4,
+			                                   is_inner, rohc_remain_data,
+			                                   rohc_remain_len);
 			if(ret < 0)
 			{
 				rohc_comp_warn(context, "failed to build the IPv4 base header part "
@@ -214,6 +216,7 @@ error:
  *
  * @param context         The compression context
  * @param ip_context      The specific IP compression context
+ * @param ip_hdr_pos      The position of the IPv4 header in the packet
  * @param ipv4            The IPv4 header
  * @param is_innermost    true if the IP header is the innermost of the packet,
  *                        false otherwise
@@ -223,7 +226,8 @@ error:
  *                        -1 in case of error
  */
 static int tcp_code_replicate_ipv4_part(const struct rohc_comp_ctxt *const context,
-                                        ip_context_t *const ip_context,
+                                        const ip_context_t *const ip_context,
+                                        const size_t ip_hdr_pos,
                                         const struct ipv4_hdr *const ipv4,
                                         const bool is_innermost,
                                         uint8_t *const rohc_data,
@@ -251,7 +255,7 @@ static int tcp_code_replicate_ipv4_part(const struct rohc_comp_ctxt *const conte
 	if(is_innermost)
 	{
 		/* all behavior values possible */
-		ipv4_replicate->ip_id_behavior = ip_context->ctxt.v4.ip_id_behavior;
+		ipv4_replicate->ip_id_behavior = tcp_context->tmp.ip_id_behavior;
 	}
 	else
 	{
@@ -264,11 +268,7 @@ static int tcp_code_replicate_ipv4_part(const struct rohc_comp_ctxt *const conte
 		{
 			ipv4_replicate->ip_id_behavior = ROHC_IP_ID_BEHAVIOR_RAND;
 		}
-		/* TODO: should not update context there */
-		ip_context->ctxt.v4.ip_id_behavior = ipv4_replicate->ip_id_behavior;
 	}
-	/* TODO: should not update context there */
-	ip_context->ctxt.v4.last_ip_id_behavior = ip_context->ctxt.v4.ip_id_behavior;
 
 	ipv4_replicate->df = ipv4->df;
 	ipv4_replicate->dscp = ipv4->dscp;
@@ -315,15 +315,9 @@ static int tcp_code_replicate_ipv4_part(const struct rohc_comp_ctxt *const conte
 		rohc_comp_debug(context, "TTL = 0x%02x -> 0x%02x",
 		                ip_context->ctxt.v4.ttl, tcp_context->tmp.ttl_hopl);
 		ipv4_replicate->ttl_flag = ttl_hopl_indicator;
-		ip_context->cr_ttl_hopl_present = !!ttl_hopl_indicator;
+		tcp_context->tmp.cr_ttl_hopl_present[ip_hdr_pos] = !!ttl_hopl_indicator;
 	}
 
-	/* TODO: should not update context there */
-	ip_context->ctxt.v4.dscp = ipv4->dscp;
-	ip_context->ctxt.v4.ttl = ipv4->ttl;
-	ip_context->ctxt.v4.df = ipv4->df;
-	ip_context->ctxt.v4.last_ip_id = rohc_ntoh16(ipv4->id);
-
 	rohc_comp_dump_buf(context, "IPv4 replicate part", rohc_data, ipv4_replicate_len);
 
 	return ipv4_replicate_len;
@@ -345,7 +339,7 @@ error:
  *                        -1 in case of error
  */
 static int tcp_code_replicate_ipv6_part(const struct rohc_comp_ctxt *const context,
-                                        ip_context_t *const ip_context,
+                                        const ip_context_t *const ip_context,
                                         const struct ipv6_hdr *const ipv6,
                                         uint8_t *const rohc_data,
                                         const size_t rohc_max_len)
@@ -395,10 +389,6 @@ static int tcp_code_replicate_ipv6_part(const struct rohc_comp_ctxt *const conte
 		ipv6_replicate2->flow_label2 = ipv6->flow2;
 	}
 
-	/* TODO: should not update context there */
-	ip_context->ctxt.v6.dscp = dscp;
-	ip_context->ctxt.v6.hopl = ipv6->hl;
-
 	rohc_comp_dump_buf(context, "IPv6 replicate part", rohc_data, ipv6_replicate_len);
 
 	return ipv6_replicate_len;
@@ -509,11 +499,11 @@ static int tcp_code_replicate_tcp_part(const struct rohc_comp_ctxt *const contex
 	tcp_replicate->ack_flag = tcp->ack_flag;
 	tcp_replicate->psh_flag = tcp->psh_flag;
 	tcp_replicate->rsf_flags = rsf_index_enc(tcp->rsf_flags);
-	tcp_replicate->ecn_used = tcp_context->ecn_used;
+	tcp_replicate->ecn_used = tcp_context->tmp.ecn_used;
 
 	/* MSN */
-	tcp_replicate->msn = rohc_hton16(tcp_context->msn);
-	rohc_comp_debug(context, "MSN 0x%02x present", tcp_context->msn);
+	tcp_replicate->msn = rohc_hton16(tcp_context->tmp.msn);
+	rohc_comp_debug(context, "MSN 0x%02x present", tcp_context->tmp.msn);
 
 	/* TCP sequence number */
 	tcp_replicate->seq_num = tcp->seq_num;
@@ -567,7 +557,7 @@ static int tcp_code_replicate_tcp_part(const struct rohc_comp_ctxt *const contex
 			goto error;
 		}
 		tcp_replicate->window_presence = indicator;
-		tcp_context->cr_tcp_window_present = !!indicator;
+		tcp_context->tmp.cr_tcp_window_present = !!indicator;
 		rohc_remain_data += ret;
 		rohc_remain_len -= ret;
 		rohc_comp_debug(context, "window_indicator = %d, window = 0x%x on %d bytes",
@@ -590,7 +580,7 @@ static int tcp_code_replicate_tcp_part(const struct rohc_comp_ctxt *const contex
 			goto error;
 		}
 		tcp_replicate->urp_presence = indicator;
-		tcp_context->cr_tcp_urg_ptr_present = indicator;
+		tcp_context->tmp.cr_tcp_urg_ptr_present = indicator;
 		rohc_remain_data += ret;
 		rohc_remain_len -= ret;
 		rohc_comp_debug(context, "urg_ptr_present = %d (URG pointer encoded on %d "
@@ -612,7 +602,7 @@ static int tcp_code_replicate_tcp_part(const struct rohc_comp_ctxt *const contex
 			goto error;
 		}
 		tcp_replicate->ack_presence = indicator;
-		tcp_context->cr_tcp_ack_num_present = !!indicator;
+		tcp_context->tmp.cr_tcp_ack_num_present = !!indicator;
 		rohc_remain_data += ret;
 		rohc_remain_len -= ret;
 		rohc_comp_debug(context, "TCP ack_number %spresent",
@@ -620,7 +610,7 @@ static int tcp_code_replicate_tcp_part(const struct rohc_comp_ctxt *const contex
 	}
 
 	/* ecn_padding + tcp_res_flags + tcp_ecn_flags */
-	if(tcp_context->ecn_used)
+	if(tcp_context->tmp.ecn_used)
 	{
 		if(rohc_remain_len < sizeof(uint16_t))
 		{
@@ -653,9 +643,9 @@ static int tcp_code_replicate_tcp_part(const struct rohc_comp_ctxt *const contex
 	/* ack_stride */
 	{
 		const bool is_ack_stride_static =
-			tcp_is_ack_stride_static(tcp_context->ack_stride,
-			                         tcp_context->ack_num_scaling_nr);
-		ret = c_static_or_irreg16(rohc_hton16(tcp_context->ack_stride),
+			tcp_is_ack_stride_static(tcp_context->tmp.ack_stride,
+			                         tcp_context->tmp.ack_num_scaling_nr);
+		ret = c_static_or_irreg16(rohc_hton16(tcp_context->tmp.ack_stride),
 		                          is_ack_stride_static,
 		                          rohc_remain_data, rohc_remain_len, &indicator);
 		if(ret < 0)
@@ -667,13 +657,12 @@ static int tcp_code_replicate_tcp_part(const struct rohc_comp_ctxt *const contex
 		rohc_remain_data += ret;
 		rohc_remain_len -= ret;
 		rohc_comp_debug(context, "TCP ack_stride %spresent (ack_stride = %u, ack_num_scaling_nr = %zu)",
-		                tcp_replicate->ack_stride_flag ? "" : "not ", tcp_context->ack_stride, tcp_context->ack_num_scaling_nr);
+		                tcp_replicate->ack_stride_flag ? "" : "not ", tcp_context->tmp.ack_stride, tcp_context->tmp.ack_num_scaling_nr);
 	}
 
 	/* the structure of the list of TCP options changed or at least one of
 	 * the option changed, compress them */
-	ret = c_tcp_code_tcp_opts_list_item(context, tcp, tcp_context->msn,
-	                                    ROHC_CHAIN_REPLICATE,
+	ret = c_tcp_code_tcp_opts_list_item(context, tcp, ROHC_CHAIN_REPLICATE,
 	                                    &tcp_context->tcp_opts,
 	                                    rohc_remain_data, rohc_remain_len,
 	                                    &no_item_needed);
@@ -34,6 +34,7 @@
 #include "schemes/ipv6_exts.h"
 #include "schemes/ip_ctxt.h"
 #include "schemes/comp_wlsb.h"
+#include "schemes/comp_reorder_ratio.h"
 #include "schemes/ip_id_offset.h"
 #include "schemes/rfc4996.h" /* for c_optional_ip_id_lsb */
 #include "crc.h"
@@ -70,6 +71,9 @@ struct comp_rfc5225_tmp_variables
 	/** Whether the innermost TOS/TC or TTL/HL changed in the innermost IP header */
 	bool innermost_ip_flag;
 
+	/** Whether the reorder ratio changed */
+	bool reorder_ratio_changed;
+
 	/** The new innermost IP-ID value */
 	uint16_t innermost_ip_id;
 	/** The new innermost IP-ID / SN delta (with bits swapped if necessary) */
@@ -89,6 +93,8 @@ struct rohc_comp_rfc5225_ip_ctxt
 {
 	uint16_t msn;  /**< The Master Sequence Number (MSN) */
 	struct c_wlsb msn_wlsb;    /**< The W-LSB encoding context for MSN */
+	/** The reordering state used to adapt the reorder ratio of the MSN */
+	struct c_reorder_ratio reorder;
 
 	/** The MSN of the last packet that updated the context (used to determine
 	 * if a positive ACK may cause a transition to a higher compression state) */
@@ -125,6 +131,9 @@ struct rohc_comp_rfc5225_ip_ctxt
 	/** The number of innermost TTL/HL transmissions since last change */
 	uint8_t innermost_ttl_hopl_trans_nr;
 
+	/** The number of reorder ratio transmissions since last change */
+	uint8_t reorder_ratio_trans_nr;
+
 	struct comp_rfc5225_tmp_variables tmp;
 };
 
@@ -174,7 +183,7 @@ static int rohc_comp_rfc5225_ip_detect_changes_ipv6(struct rohc_comp_ctxt *const
                                                     const bool is_innermost)
 	__attribute__((warn_unused_result, nonnull(1, 2, 3)));
 
-static int rohc_comp_rfc5225_ip_code_IR_pkt(const struct rohc_comp_ctxt *const ctxt,
+static int rohc_comp_rfc5225_ip_code_IR_pkt(struct rohc_comp_ctxt *const ctxt,
                                             const struct ip_packet *const ip,
                                             uint8_t *const rohc_pkt,
                                             const size_t rohc_pkt_max_len)
@@ -306,6 +315,9 @@ static void rohc_comp_rfc5225_ip_feedback_ack(struct rohc_comp_ctxt *const ctxt,
                                               const bool sn_not_valid)
 	__attribute__((nonnull(1)));
 
+static void rohc_comp_rfc5225_ip_set_wlsb_width(struct rohc_comp_ctxt *const ctxt)
+	__attribute__((nonnull(1)));
+
 /* mode and state transitions */
 static void rohc_comp_rfc5225_ip_decide_state(struct rohc_comp_ctxt *const context,
                                               const struct rohc_ts pkt_time)
@@ -453,6 +465,8 @@ static bool rohc_comp_rfc5225_ip_create(struct rohc_comp_ctxt *const context,
 
 	/* MSN */
 	wlsb_init(&rfc5225_ctxt->msn_wlsb, 16, comp->wlsb_window_width, ROHC_LSB_SHIFT_VAR);
+	/* reorder ratio of the MSN, adapted later to the reordering observed */
+	c_reorder_ratio_init(&rfc5225_ctxt->reorder, comp->reorder_ratio, 16);
 	/* innermost IP-ID offset */
 	wlsb_init(&rfc5225_ctxt->innermost_ip_id_offset_wlsb, 16,
 	          comp->wlsb_window_width, ROHC_LSB_SHIFT_VAR);
@@ -1024,6 +1038,10 @@ static int rohc_comp_rfc5225_ip_encode(struct rohc_comp_ctxt *const context,
 	{
 		rfc5225_ctxt->innermost_ttl_hopl_trans_nr++;
 	}
+	if(rfc5225_ctxt->reorder_ratio_trans_nr < MAX_FO_COUNT)
+	{
+		rfc5225_ctxt->reorder_ratio_trans_nr++;
+	}
 
 	return rohc_len;
 
@@ -1064,6 +1082,7 @@ static bool rohc_comp_rfc5225_ip_detect_changes(struct rohc_comp_ctxt *const con
 	rfc5225_ctxt->tmp.innermost_ip_flag = false;
 	rfc5225_ctxt->tmp.at_least_one_df_changed = false;
 	rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed = false;
+	rfc5225_ctxt->tmp.reorder_ratio_changed = false;
 	for(ip_hdr_pos = 0; ip_hdr_pos < rfc5225_ctxt->ip_contexts_nr; ip_hdr_pos++)
 	{
 		const struct ip_hdr *const ip_hdr = (struct ip_hdr *) remain_data;
@@ -1278,6 +1297,15 @@ static bool rohc_comp_rfc5225_ip_detect_changes(struct rohc_comp_ctxt *const con
 		rfc5225_ctxt->tmp.innermost_ttl_hopl_changed = true;
 	}
 
+	/* reorder ratio that changes shall be transmitted several times */
+	if(rfc5225_ctxt->reorder_ratio_trans_nr < MAX_FO_COUNT)
+	{
+		rohc_comp_debug(context, "reorder ratio changed in last packets, "
+		                "it shall be transmitted %u times more",
+		                MAX_FO_COUNT - rfc5225_ctxt->reorder_ratio_trans_nr);
+		rfc5225_ctxt->tmp.reorder_ratio_changed = true;
+	}
+
 	return true;
 
 error:
@@ -1570,6 +1598,7 @@ static bool rohc_comp_rfc5225_ip_feedback_2(struct rohc_comp_ctxt *const ctxt,
                                             const uint8_t *const feedback_data,
                                             const size_t feedback_data_len)
 {
+	struct rohc_comp_rfc5225_ip_ctxt *const rfc5225_ctxt = ctxt->specific;
 	const uint8_t *remain_data = feedback_data;
 	size_t remain_len = feedback_data_len;
 	const struct rohc_feedback_2_rfc6846 *feedback2;
@@ -1638,6 +1667,12 @@ static bool rohc_comp_rfc5225_ip_feedback_2(struct rohc_comp_ctxt *const ctxt,
 			{
 				rohc_comp_change_state(ctxt, ROHC_COMP_STATE_FO);
 			}
+			/* the current references are not robust enough against losses */
+			if(rohc_comp_wlsb_width_adapt(ctxt, feedback2->ack_type, 0))
+			{
+				rohc_comp_rfc5225_ip_set_wlsb_width(ctxt);
+			}
+			c_reorder_ratio_nack(&rfc5225_ctxt->reorder);
 			/* TODO: use the SN field to determine the latest packet successfully
 			 * decompressed and then determine what fields need to be updated */
 			break;
@@ -1649,6 +1684,12 @@ static bool rohc_comp_rfc5225_ip_feedback_2(struct rohc_comp_ctxt *const ctxt,
 			          "STATIC-NACK received for CID %zu", ctxt->cid);
 			/* the compressor transits back to the IR state */
 			rohc_comp_change_state(ctxt, ROHC_COMP_STATE_IR);
+			/* the current references are not robust enough against losses */
+			if(rohc_comp_wlsb_width_adapt(ctxt, feedback2->ack_type, 0))
+			{
+				rohc_comp_rfc5225_ip_set_wlsb_width(ctxt);
+			}
+			c_reorder_ratio_nack(&rfc5225_ctxt->reorder);
 			/* TODO: use the SN field to determine the latest packet successfully
 			 * decompressed and then determine what fields need to be updated */
 			break;
@@ -1700,6 +1741,12 @@ static void rohc_comp_rfc5225_ip_feedback_ack(struct rohc_comp_ctxt *const ctxt,
 		assert(sn_bits_nr <= 16);
 		assert(sn_bits <= 0xffffU);
 
+		/* let the positive ACKs drive the windows on reliable feedback channels */
+		wlsb_set_ack_driven(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
+		                    rohc_comp_wlsb_is_ack_driven(ctxt));
+		wlsb_set_ack_driven(&rfc5225_ctxt->msn_wlsb,
+		                    rohc_comp_wlsb_is_ack_driven(ctxt));
+
 		/* ack innermost IP-ID */
 		acked_nr = wlsb_ack(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
 		                    sn_bits, sn_bits_nr);
@@ -1709,6 +1756,30 @@ static void rohc_comp_rfc5225_ip_feedback_ack(struct rohc_comp_ctxt *const ctxt,
 		acked_nr = wlsb_ack(&rfc5225_ctxt->msn_wlsb, sn_bits, sn_bits_nr);
 		rohc_comp_debug(ctxt, "FEEDBACK-2: positive ACK removed %zu values "
 		                "from MSN W-LSB", acked_nr);
+
+		/* adapt the width of the W-LSB windows to the number of packets that
+		 * were sent after the acknowledged one */
+		{
+			const uint16_t sn_mask = (1U << sn_bits_nr) - 1;
+			const uint16_t unacked_nr = (rfc5225_ctxt->msn - sn_bits) & sn_mask;
+
+			/* the 8-bit MSN of FEEDBACK-1 may wrap around while packets are not
+			 * acknowledged yet, do not shrink the windows with it */
+			if(sn_bits_nr >= ROHC_WLSB_WIDTH_ACK_SN_BITS_MIN &&
+			   rohc_comp_wlsb_width_adapt(ctxt, ROHC_FEEDBACK_ACK, unacked_nr))
+			{
+				rohc_comp_rfc5225_ip_set_wlsb_width(ctxt);
+			}
+
+			/* adapt the reorder ratio to the order of the acknowledged MSNs */
+			if(c_reorder_ratio_ack(&rfc5225_ctxt->reorder,
+			                       (uint16_t) (rfc5225_ctxt->msn - unacked_nr)))
+			{
+				rohc_comp_debug(ctxt, "reorder ratio changed to %u",
+				                rfc5225_ctxt->reorder.ratio);
+				rfc5225_ctxt->reorder_ratio_trans_nr = 0;
+			}
+		}
 	}
 
 	/* RFC 6846, §5.2.2.1:
@@ -1759,6 +1830,21 @@ static void rohc_comp_rfc5225_ip_feedback_ack(struct rohc_comp_ctxt *const ctxt,
 }
 
 
+/**
+ * @brief Resize the W-LSB windows of the context to the width of the context
+ *
+ * @param ctxt  The compression context
+ */
+static void rohc_comp_rfc5225_ip_set_wlsb_width(struct rohc_comp_ctxt *const ctxt)
+{
+	struct rohc_comp_rfc5225_ip_ctxt *const rfc5225_ctxt = ctxt->specific;
+
+	wlsb_set_window_width(&rfc5225_ctxt->msn_wlsb, ctxt->wlsb_window_width);
+	wlsb_set_window_width(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
+	                      ctxt->wlsb_window_width);
+}
+
+
 /**
  * @brief Decide the state that should be used for the next packet
  *
@@ -1773,33 +1859,35 @@ static void rohc_comp_rfc5225_ip_decide_state(struct rohc_comp_ctxt *const conte
 
 	if(curr_state == ROHC_COMP_STATE_IR)
 	{
-		if(context->ir_count < MAX_IR_COUNT)
+		if(context->ir_count < context->oa_repetitions_nr)
 		{
 			rohc_comp_debug(context, "not enough packets transmitted in IR state "
-			                "for the moment (%zu/%d), so stay in IR state",
-			                context->ir_count, MAX_IR_COUNT);
+			                "for the moment (%zu/%zu), so stay in IR state",
+			                context->ir_count, context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_IR;
 		}
 		else
 		{
-			rohc_comp_debug(context, "enough packets transmitted in IR state (%zu/%u), "
-			                "go to SO state", context->ir_count, MAX_IR_COUNT);
+			rohc_comp_debug(context, "enough packets transmitted in IR state (%zu/%zu), "
+			                "go to SO state", context->ir_count,
+			                context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_SO;
 		}
 	}
 	else if(curr_state == ROHC_COMP_STATE_FO)
 	{
-		if(context->fo_count < MAX_FO_COUNT)
+		if(context->fo_count < context->oa_repetitions_nr)
 		{
 			rohc_comp_debug(context, "not enough packets transmitted in FO state "
-			                "for the moment (%zu/%u), so stay in FO state",
-			                context->fo_count, MAX_FO_COUNT);
+			                "for the moment (%zu/%zu), so stay in FO state",
+			                context->fo_count, context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_FO;
 		}
 		else
 		{
-			rohc_comp_debug(context, "enough packets transmitted in FO state (%zu/%u), "
-			                "go to SO state", context->fo_count, MAX_FO_COUNT);
+			rohc_comp_debug(context, "enough packets transmitted in FO state (%zu/%zu), "
+			                "go to SO state", context->fo_count,
+			                context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_SO;
 		}
 	}
@@ -1932,7 +2020,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_decide_FO_SO_pkt(const struct rohc_com
                                                            const bool crc7_at_least)
 {
 	struct rohc_comp_rfc5225_ip_ctxt *const rfc5225_ctxt = ctxt->specific;
-	const rohc_reordering_offset_t reorder_ratio = ctxt->compressor->reorder_ratio;
+	const rohc_reordering_offset_t reorder_ratio = rfc5225_ctxt->reorder.ratio;
 	const ip_context_t *const innermost_ip_ctxt =
 		&(rfc5225_ctxt->ip_contexts[rfc5225_ctxt->ip_contexts_nr - 1]);
 	const uint16_t innermost_ip_id = rfc5225_ctxt->tmp.innermost_ip_id;
@@ -1949,6 +2037,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_decide_FO_SO_pkt(const struct rohc_com
 	 *     - sequential and inferred from MSN (and not transmitted at all).
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	if(!crc7_at_least &&
 	   rohc_comp_rfc5225_is_msn_lsb_possible(&rfc5225_ctxt->msn_wlsb,
@@ -1958,7 +2047,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_decide_FO_SO_pkt(const struct rohc_com
 	   !rfc5225_ctxt->tmp.outer_ip_flag &&
 	   !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	   !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	   !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	   !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	   !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		rohc_comp_debug(ctxt, "code pt_0_crc3 packet");
 		packet_type = ROHC_PACKET_PT_0_CRC3;
@@ -1971,6 +2061,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_decide_FO_SO_pkt(const struct rohc_com
 	 *     - sequential and inferred from MSN (and not transmitted at all).
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	else if(rohc_comp_rfc5225_is_msn_lsb_possible(&rfc5225_ctxt->msn_wlsb,
 	                                              rfc5225_ctxt->msn,
@@ -1981,7 +2072,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_decide_FO_SO_pkt(const struct rohc_com
 	        !rfc5225_ctxt->tmp.outer_ip_flag &&
 	        !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	        !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	        !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		rohc_comp_debug(ctxt, "code pt_0_crc7 packet");
 		packet_type = ROHC_PACKET_NORTP_PT_0_CRC7;
@@ -1993,6 +2085,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_decide_FO_SO_pkt(const struct rohc_com
 	 *  - 4 innermost IP-ID / SN offset bits are enough
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	else if(!crc7_at_least &&
 	        rohc_comp_rfc5225_is_msn_lsb_possible(&rfc5225_ctxt->msn_wlsb,
@@ -2005,7 +2098,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_decide_FO_SO_pkt(const struct rohc_com
 	        !rfc5225_ctxt->tmp.outer_ip_flag &&
 	        !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	        !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	        !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		assert(innermost_ip_ctxt->ctxt.vx.version == IPV4);
 		rohc_comp_debug(ctxt, "code pt_1_seq_id packet");
@@ -2017,6 +2111,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_decide_FO_SO_pkt(const struct rohc_com
 	 *  - 8 MSN bits are enough
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	else if(rohc_comp_rfc5225_is_ipid_sequential(innermost_ip_id_behavior) &&
 	        wlsb_is_kp_possible_16bits(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
@@ -2028,7 +2123,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_decide_FO_SO_pkt(const struct rohc_com
 	        !rfc5225_ctxt->tmp.outer_ip_flag &&
 	        !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	        !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	        !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		rohc_comp_debug(ctxt, "code pt_2_seq_id packet");
 		packet_type = ROHC_PACKET_NORTP_PT_2_SEQ_ID;
@@ -2147,7 +2243,7 @@ static bool rohc_comp_rfc5225_is_seq_ipid_inferred(const ip_context_t *const ip_
  * @return                  The length of the ROHC packet if successful,
  *                          -1 otherwise
  */
-static int rohc_comp_rfc5225_ip_code_IR_pkt(const struct rohc_comp_ctxt *context,
+static int rohc_comp_rfc5225_ip_code_IR_pkt(struct rohc_comp_ctxt *const context,
                                             const struct ip_packet *const ip,
                                             uint8_t *const rohc_pkt,
                                             const size_t rohc_pkt_max_len)
@@ -2210,13 +2306,18 @@ static int rohc_comp_rfc5225_ip_code_IR_pkt(const struct rohc_comp_ctxt *context
 	rohc_remain_len--;
 	rohc_hdr_len++;
 
-	/* add static chain */
-	ret = rohc_comp_rfc5225_ip_static_chain(context, ip, rohc_remain_data,
-	                                        rohc_remain_len);
-	if(ret < 0)
+	/* add static chain, the one cached in context if any */
+	ret = rohc_comp_static_chain_reuse(context, rohc_remain_data, rohc_remain_len);
+	if(ret == 0)
 	{
-		rohc_comp_warn(context, "failed to build the static chain of the IR packet");
-		goto error;
+		ret = rohc_comp_rfc5225_ip_static_chain(context, ip, rohc_remain_data,
+		                                        rohc_remain_len);
+		if(ret < 0)
+		{
+			rohc_comp_warn(context, "failed to build the static chain of the IR packet");
+			goto error;
+		}
+		rohc_comp_static_chain_cache(context, rohc_remain_data, ret);
 	}
 	rohc_remain_data += ret;
 	rohc_remain_len -= ret;
@@ -2377,12 +2478,12 @@ static int rohc_comp_rfc5225_ip_code_co_repair_pkt(const struct rohc_comp_ctxt *
 		co_repair_crc->ctrl_crc =
 			compute_crc_ctrl_fields(context->profile->id,
 			                        context->compressor->crc_table_3,
-			                        context->compressor->reorder_ratio,
+			                        rfc5225_ctxt->reorder.ratio,
 			                        rfc5225_ctxt->msn,
 			                        ip_id_behaviors, ip_id_behaviors_nr);
 		rohc_comp_debug(context, "CRC-3 on control fields = 0x%x "
 		                "(reorder_ratio = 0x%02x, MSN = 0x%04x, %zu IP-ID behaviors)",
-		                co_repair_crc->ctrl_crc, context->compressor->reorder_ratio,
+		                co_repair_crc->ctrl_crc, rfc5225_ctxt->reorder.ratio,
 		                rfc5225_ctxt->msn, ip_id_behaviors_nr);
 
 		/* skip CRCs */
@@ -2959,7 +3060,7 @@ static int rohc_comp_rfc5225_ip_dyn_ipv4_part(const struct rohc_comp_ctxt *const
 		}
 
 		ipv4_dynamic->reserved = 0;
-		ipv4_dynamic->reorder_ratio = ctxt->compressor->reorder_ratio;
+		ipv4_dynamic->reorder_ratio = rfc5225_ctxt->reorder.ratio;
 		ipv4_dynamic->df = ipv4->df;
 		ipv4_dynamic->ip_id_behavior_innermost = ip_ctxt->ctxt.v4.ip_id_behavior;
 		ipv4_dynamic->tos_tc = ipv4->tos;
@@ -3105,7 +3206,7 @@ static int rohc_comp_rfc5225_ip_dyn_ipv6_part(const struct rohc_comp_ctxt *const
 			goto error;
 		}
 
-		ipv6_endpoint_dynamic->reorder_ratio = ctxt->compressor->reorder_ratio;
+		ipv6_endpoint_dynamic->reorder_ratio = rfc5225_ctxt->reorder.ratio;
 		ipv6_endpoint_dynamic->reserved = 0;
 
 		/* MSN */
@@ -3553,7 +3654,7 @@ static int rohc_comp_rfc5225_ip_build_co_common_pkt(const struct rohc_comp_ctxt
 	}
 	co_common->ttl_hopl_ind = rfc5225_ctxt->tmp.innermost_ttl_hopl_changed;
 	co_common->tos_tc_ind = rfc5225_ctxt->tmp.innermost_tos_tc_changed;
-	co_common->reorder_ratio = context->compressor->reorder_ratio;
+	co_common->reorder_ratio = rfc5225_ctxt->reorder.ratio;
 
 	/* CRC-3 over control fields */
 	{
@@ -3580,12 +3681,12 @@ static int rohc_comp_rfc5225_ip_build_co_common_pkt(const struct rohc_comp_ctxt
 		co_common->control_crc3 =
 			compute_crc_ctrl_fields(context->profile->id,
 			                        context->compressor->crc_table_3,
-			                        context->compressor->reorder_ratio,
+			                        rfc5225_ctxt->reorder.ratio,
 			                        rfc5225_ctxt->msn,
 			                        ip_id_behaviors, ip_id_behaviors_nr);
 		rohc_comp_debug(context, "CRC-3 on control fields = 0x%x "
 		                "(reorder_ratio = 0x%02x, MSN = 0x%04x, %zu IP-ID behaviors)",
-		                co_common->control_crc3, context->compressor->reorder_ratio,
+		                co_common->control_crc3, rfc5225_ctxt->reorder.ratio,
 		                rfc5225_ctxt->msn, ip_id_behaviors_nr);
 	}
 
@@ -34,6 +34,7 @@
 #include "schemes/ipv6_exts.h"
 #include "schemes/ip_ctxt.h"
 #include "schemes/comp_wlsb.h"
+#include "schemes/comp_reorder_ratio.h"
 #include "schemes/ip_id_offset.h"
 #include "schemes/rfc4996.h" /* for c_optional_ip_id_lsb */
 #include "crc.h"
@@ -74,6 +75,9 @@ struct comp_rfc5225_tmp_variables
 	/** Whether the innermost TOS/TC or TTL/HL changed in the innermost IP header */
 	bool innermost_ip_flag;
 
+	/** Whether the reorder ratio changed */
+	bool reorder_ratio_changed;
+
 	/** The new innermost IP-ID value */
 	uint16_t innermost_ip_id;
 	/** The new innermost IP-ID / SN delta (with bits swapped if necessary) */
@@ -93,6 +97,8 @@ struct rohc_comp_rfc5225_ip_esp_ctxt
 {
 	uint32_t msn;  /**< The Master Sequence Number (MSN) */
 	struct c_wlsb msn_wlsb;    /**< The W-LSB encoding context for MSN */
+	/** The reordering state used to adapt the reorder ratio of the MSN */
+	struct c_reorder_ratio reorder;
 
 	/** The MSN of the last packet that updated the context (used to determine
 	 * if a positive ACK may cause a transition to a higher compression state) */
@@ -129,6 +135,9 @@ struct rohc_comp_rfc5225_ip_esp_ctxt
 	/** The number of innermost TTL/HL transmissions since last change */
 	uint8_t innermost_ttl_hopl_trans_nr;
 
+	/** The number of reorder ratio transmissions since last change */
+	uint8_t reorder_ratio_trans_nr;
+
 	struct comp_rfc5225_tmp_variables tmp;
 
 	/** The ESP Security Parameters Index (SPI) */
@@ -181,7 +190,7 @@ static int rohc_comp_rfc5225_ip_esp_detect_changes_ipv6(struct rohc_comp_ctxt *c
                                                         const bool is_innermost)
 	__attribute__((warn_unused_result, nonnull(1, 2, 3)));
 
-static int rohc_comp_rfc5225_ip_esp_code_IR_pkt(const struct rohc_comp_ctxt *const ctxt,
+static int rohc_comp_rfc5225_ip_esp_code_IR_pkt(struct rohc_comp_ctxt *const ctxt,
                                                 const struct ip_packet *const ip,
                                                 uint8_t *const rohc_pkt,
                                                 const size_t rohc_pkt_max_len)
@@ -321,6 +330,9 @@ static void rohc_comp_rfc5225_ip_esp_feedback_ack(struct rohc_comp_ctxt *const c
                                                   const bool sn_not_valid)
 	__attribute__((nonnull(1)));
 
+static void rohc_comp_rfc5225_ip_esp_set_wlsb_width(struct rohc_comp_ctxt *const ctxt)
+	__attribute__((nonnull(1)));
+
 /* mode and state transitions */
 static void rohc_comp_rfc5225_ip_esp_decide_state(struct rohc_comp_ctxt *const context,
                                                   const struct rohc_ts pkt_time)
@@ -485,6 +497,8 @@ static bool rohc_comp_rfc5225_ip_esp_create(struct rohc_comp_ctxt *const context
 
 	/* MSN */
 	wlsb_init(&rfc5225_ctxt->msn_wlsb, 32, comp->wlsb_window_width, ROHC_LSB_SHIFT_VAR);
+	/* reorder ratio of the MSN, adapted later to the reordering observed */
+	c_reorder_ratio_init(&rfc5225_ctxt->reorder, comp->reorder_ratio, 32);
 	/* innermost IP-ID offset */
 	wlsb_init(&rfc5225_ctxt->innermost_ip_id_offset_wlsb, 16,
 	          comp->wlsb_window_width, ROHC_LSB_SHIFT_VAR);
@@ -1107,6 +1121,10 @@ static int rohc_comp_rfc5225_ip_esp_encode(struct rohc_comp_ctxt *const context,
 	{
 		rfc5225_ctxt->innermost_ttl_hopl_trans_nr++;
 	}
+	if(rfc5225_ctxt->reorder_ratio_trans_nr < MAX_FO_COUNT)
+	{
+		rfc5225_ctxt->reorder_ratio_trans_nr++;
+	}
 
 	return rohc_len;
 
@@ -1148,6 +1166,7 @@ static bool rohc_comp_rfc5225_ip_esp_detect_changes(struct rohc_comp_ctxt *const
 	rfc5225_ctxt->tmp.innermost_ip_flag = false;
 	rfc5225_ctxt->tmp.at_least_one_df_changed = false;
 	rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed = false;
+	rfc5225_ctxt->tmp.reorder_ratio_changed = false;
 	for(ip_hdr_pos = 0; ip_hdr_pos < rfc5225_ctxt->ip_contexts_nr; ip_hdr_pos++)
 	{
 		const struct ip_hdr *const ip_hdr = (struct ip_hdr *) remain_data;
@@ -1230,6 +1249,19 @@ static bool rohc_comp_rfc5225_ip_esp_detect_changes(struct rohc_comp_ctxt *const
 		rfc5225_ctxt->msn = new_msn;
 		rohc_comp_debug(context, "MSN offset = %d", rfc5225_ctxt->tmp.msn_offset);
 
+		/* ESP packets reordered before the compressor will be received out of
+		 * order by the decompressor too */
+		if(c_reorder_ratio_add_msn(&rfc5225_ctxt->reorder, new_msn))
+		{
+			rohc_comp_debug(context, "reorder ratio changed to %u",
+			                rfc5225_ctxt->reorder.ratio);
+			rfc5225_ctxt->reorder_ratio_trans_nr = 0;
+		}
+		if(rohc_comp_wlsb_width_reorder(context, new_msn, 0xffffffffU))
+		{
+			rohc_comp_rfc5225_ip_esp_set_wlsb_width(context);
+		}
+
 		/* skip ESP header */
 #ifndef __clang_analyzer__ /* silent warning about dead in/decrement */
 		remain_data += sizeof(struct esphdr);
@@ -1438,6 +1470,15 @@ static bool rohc_comp_rfc5225_ip_esp_detect_changes(struct rohc_comp_ctxt *const
 		rfc5225_ctxt->tmp.innermost_ttl_hopl_changed = true;
 	}
 
+	/* reorder ratio that changes shall be transmitted several times */
+	if(rfc5225_ctxt->reorder_ratio_trans_nr < MAX_FO_COUNT)
+	{
+		rohc_comp_debug(context, "reorder ratio changed in last packets, "
+		                "it shall be transmitted %u times more",
+		                MAX_FO_COUNT - rfc5225_ctxt->reorder_ratio_trans_nr);
+		rfc5225_ctxt->tmp.reorder_ratio_changed = true;
+	}
+
 	return true;
 
 error:
@@ -1701,6 +1742,7 @@ static bool rohc_comp_rfc5225_ip_esp_feedback_2(struct rohc_comp_ctxt *const ctx
                                                 const uint8_t *const feedback_data,
                                                 const size_t feedback_data_len)
 {
+	struct rohc_comp_rfc5225_ip_esp_ctxt *const rfc5225_ctxt = ctxt->specific;
 	const uint8_t *remain_data = feedback_data;
 	size_t remain_len = feedback_data_len;
 	const struct rohc_feedback_2_rfc6846 *feedback2;
@@ -1769,6 +1811,12 @@ static bool rohc_comp_rfc5225_ip_esp_feedback_2(struct rohc_comp_ctxt *const ctx
 			{
 				rohc_comp_change_state(ctxt, ROHC_COMP_STATE_FO);
 			}
+			/* the current references are not robust enough against losses */
+			if(rohc_comp_wlsb_width_adapt(ctxt, feedback2->ack_type, 0))
+			{
+				rohc_comp_rfc5225_ip_esp_set_wlsb_width(ctxt);
+			}
+			c_reorder_ratio_nack(&rfc5225_ctxt->reorder);
 			/* TODO: use the SN field to determine the latest packet successfully
 			 * decompressed and then determine what fields need to be updated */
 			break;
@@ -1780,6 +1828,12 @@ static bool rohc_comp_rfc5225_ip_esp_feedback_2(struct rohc_comp_ctxt *const ctx
 			          "STATIC-NACK received for CID %zu", ctxt->cid);
 			/* the compressor transits back to the IR state */
 			rohc_comp_change_state(ctxt, ROHC_COMP_STATE_IR);
+			/* the current references are not robust enough against losses */
+			if(rohc_comp_wlsb_width_adapt(ctxt, feedback2->ack_type, 0))
+			{
+				rohc_comp_rfc5225_ip_esp_set_wlsb_width(ctxt);
+			}
+			c_reorder_ratio_nack(&rfc5225_ctxt->reorder);
 			/* TODO: use the SN field to determine the latest packet successfully
 			 * decompressed and then determine what fields need to be updated */
 			break;
@@ -1831,6 +1885,12 @@ static void rohc_comp_rfc5225_ip_esp_feedback_ack(struct rohc_comp_ctxt *const c
 		assert(sn_bits_nr <= 32);
 		assert(sn_bits <= 0xffffffffU);
 
+		/* let the positive ACKs drive the windows on reliable feedback channels */
+		wlsb_set_ack_driven(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
+		                    rohc_comp_wlsb_is_ack_driven(ctxt));
+		wlsb_set_ack_driven(&rfc5225_ctxt->msn_wlsb,
+		                    rohc_comp_wlsb_is_ack_driven(ctxt));
+
 		/* ack innermost IP-ID */
 		acked_nr = wlsb_ack(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
 		                    sn_bits, sn_bits_nr);
@@ -1840,6 +1900,31 @@ static void rohc_comp_rfc5225_ip_esp_feedback_ack(struct rohc_comp_ctxt *const c
 		acked_nr = wlsb_ack(&rfc5225_ctxt->msn_wlsb, sn_bits, sn_bits_nr);
 		rohc_comp_debug(ctxt, "FEEDBACK-2: positive ACK removed %zu values "
 		                "from MSN W-LSB", acked_nr);
+
+		/* adapt the width of the W-LSB windows to the number of packets that
+		 * were sent after the acknowledged one */
+		{
+			const uint32_t sn_mask =
+				(sn_bits_nr < 32 ? ((1U << sn_bits_nr) - 1) : 0xffffffffU);
+			const uint32_t unacked_nr = (rfc5225_ctxt->msn - sn_bits) & sn_mask;
+
+			/* the 8-bit MSN of FEEDBACK-1 may wrap around while packets are not
+			 * acknowledged yet, do not shrink the windows with it */
+			if(sn_bits_nr >= ROHC_WLSB_WIDTH_ACK_SN_BITS_MIN &&
+			   rohc_comp_wlsb_width_adapt(ctxt, ROHC_FEEDBACK_ACK, unacked_nr))
+			{
+				rohc_comp_rfc5225_ip_esp_set_wlsb_width(ctxt);
+			}
+
+			/* adapt the reorder ratio to the order of the acknowledged MSNs */
+			if(c_reorder_ratio_ack(&rfc5225_ctxt->reorder,
+			                       rfc5225_ctxt->msn - unacked_nr))
+			{
+				rohc_comp_debug(ctxt, "reorder ratio changed to %u",
+				                rfc5225_ctxt->reorder.ratio);
+				rfc5225_ctxt->reorder_ratio_trans_nr = 0;
+			}
+		}
 	}
 
 	/* RFC 6846, §5.2.2.1:
@@ -1890,6 +1975,21 @@ static void rohc_comp_rfc5225_ip_esp_feedback_ack(struct rohc_comp_ctxt *const c
 }
 
 
+/**
+ * @brief Resize the W-LSB windows of the context to the width of the context
+ *
+ * @param ctxt  The compression context
+ */
+static void rohc_comp_rfc5225_ip_esp_set_wlsb_width(struct rohc_comp_ctxt *const ctxt)
+{
+	struct rohc_comp_rfc5225_ip_esp_ctxt *const rfc5225_ctxt = ctxt->specific;
+
+	wlsb_set_window_width(&rfc5225_ctxt->msn_wlsb, ctxt->wlsb_window_width);
+	wlsb_set_window_width(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
+	                      ctxt->wlsb_window_width);
+}
+
+
 /**
  * @brief Decide the state that should be used for the next packet
  *
@@ -1904,33 +2004,35 @@ static void rohc_comp_rfc5225_ip_esp_decide_state(struct rohc_comp_ctxt *const c
 
 	if(curr_state == ROHC_COMP_STATE_IR)
 	{
-		if(context->ir_count < MAX_IR_COUNT)
+		if(context->ir_count < context->oa_repetitions_nr)
 		{
 			rohc_comp_debug(context, "not enough packets transmitted in IR state "
-			                "for the moment (%zu/%d), so stay in IR state",
-			                context->ir_count, MAX_IR_COUNT);
+			                "for the moment (%zu/%zu), so stay in IR state",
+			                context->ir_count, context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_IR;
 		}
 		else
 		{
-			rohc_comp_debug(context, "enough packets transmitted in IR state (%zu/%u), "
-			                "go to SO state", context->ir_count, MAX_IR_COUNT);
+			rohc_comp_debug(context, "enough packets transmitted in IR state (%zu/%zu), "
+			                "go to SO state", context->ir_count,
+			                context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_SO;
 		}
 	}
 	else if(curr_state == ROHC_COMP_STATE_FO)
 	{
-		if(context->fo_count < MAX_FO_COUNT)
+		if(context->fo_count < context->oa_repetitions_nr)
 		{
 			rohc_comp_debug(context, "not enough packets transmitted in FO state "
-			                "for the moment (%zu/%u), so stay in FO state",
-			                context->fo_count, MAX_FO_COUNT);
+			                "for the moment (%zu/%zu), so stay in FO state",
+			                context->fo_count, context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_FO;
 		}
 		else
 		{
-			rohc_comp_debug(context, "enough packets transmitted in FO state (%zu/%u), "
-			                "go to SO state", context->fo_count, MAX_FO_COUNT);
+			rohc_comp_debug(context, "enough packets transmitted in FO state (%zu/%zu), "
+			                "go to SO state", context->fo_count,
+			                context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_SO;
 		}
 	}
@@ -2064,7 +2166,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_esp_decide_FO_SO_pkt(const struct rohc
 {
 	struct rohc_comp_rfc5225_ip_esp_ctxt *const rfc5225_ctxt = ctxt->specific;
 	const int32_t msn_offset = rfc5225_ctxt->tmp.msn_offset;
-	const rohc_reordering_offset_t reorder_ratio = ctxt->compressor->reorder_ratio;
+	const rohc_reordering_offset_t reorder_ratio = rfc5225_ctxt->reorder.ratio;
 	const ip_context_t *const innermost_ip_ctxt =
 		&(rfc5225_ctxt->ip_contexts[rfc5225_ctxt->ip_contexts_nr - 1]);
 	const uint16_t innermost_ip_id = rfc5225_ctxt->tmp.innermost_ip_id;
@@ -2081,6 +2183,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_esp_decide_FO_SO_pkt(const struct rohc
 	 *     - sequential and inferred from MSN (and not transmitted at all).
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	if(!crc7_at_least &&
 	   rohc_comp_rfc5225_is_msn_lsb_possible(&rfc5225_ctxt->msn_wlsb,
@@ -2091,7 +2194,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_esp_decide_FO_SO_pkt(const struct rohc
 	   !rfc5225_ctxt->tmp.outer_ip_flag &&
 	   !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	   !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	   !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	   !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	   !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		rohc_comp_debug(ctxt, "code pt_0_crc3 packet");
 		packet_type = ROHC_PACKET_PT_0_CRC3;
@@ -2104,6 +2208,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_esp_decide_FO_SO_pkt(const struct rohc
 	 *     - sequential and inferred from MSN (and not transmitted at all).
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	else if(rohc_comp_rfc5225_is_msn_lsb_possible(&rfc5225_ctxt->msn_wlsb,
 	                                              rfc5225_ctxt->msn,
@@ -2114,7 +2219,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_esp_decide_FO_SO_pkt(const struct rohc
 	        !rfc5225_ctxt->tmp.outer_ip_flag &&
 	        !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	        !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	        !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		rohc_comp_debug(ctxt, "code pt_0_crc7 packet");
 		packet_type = ROHC_PACKET_NORTP_PT_0_CRC7;
@@ -2126,6 +2232,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_esp_decide_FO_SO_pkt(const struct rohc
 	 *  - 4 innermost IP-ID / SN offset bits are enough
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	else if(!crc7_at_least &&
 	        rohc_comp_rfc5225_is_msn_lsb_possible(&rfc5225_ctxt->msn_wlsb,
@@ -2138,7 +2245,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_esp_decide_FO_SO_pkt(const struct rohc
 	        !rfc5225_ctxt->tmp.outer_ip_flag &&
 	        !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	        !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	        !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		assert(innermost_ip_ctxt->ctxt.vx.version == IPV4);
 		rohc_comp_debug(ctxt, "code pt_1_seq_id packet");
@@ -2150,6 +2258,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_esp_decide_FO_SO_pkt(const struct rohc
 	 *  - 8 MSN bits are enough
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	else if(rohc_comp_rfc5225_is_ipid_sequential(innermost_ip_id_behavior) &&
 	        wlsb_is_kp_possible_16bits(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
@@ -2161,7 +2270,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_esp_decide_FO_SO_pkt(const struct rohc
 	        !rfc5225_ctxt->tmp.outer_ip_flag &&
 	        !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	        !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	        !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		rohc_comp_debug(ctxt, "code pt_2_seq_id packet");
 		packet_type = ROHC_PACKET_NORTP_PT_2_SEQ_ID;
@@ -2276,7 +2386,7 @@ static bool rohc_comp_rfc5225_is_seq_ipid_inferred(const ip_context_t *const ip_
  * @return                  The length of the ROHC packet if successful,
  *                          -1 otherwise
  */
-static int rohc_comp_rfc5225_ip_esp_code_IR_pkt(const struct rohc_comp_ctxt *context,
+static int rohc_comp_rfc5225_ip_esp_code_IR_pkt(struct rohc_comp_ctxt *const context,
                                                 const struct ip_packet *const ip,
                                                 uint8_t *const rohc_pkt,
                                                 const size_t rohc_pkt_max_len)
@@ -2339,13 +2449,18 @@ static int rohc_comp_rfc5225_ip_esp_code_IR_pkt(const struct rohc_comp_ctxt *con
 	rohc_remain_len--;
 	rohc_hdr_len++;
 
-	/* add static chain */
-	ret = rohc_comp_rfc5225_ip_esp_static_chain(context, ip, rohc_remain_data,
-	                                            rohc_remain_len);
-	if(ret < 0)
+	/* add static chain, the one cached in context if any */
+	ret = rohc_comp_static_chain_reuse(context, rohc_remain_data, rohc_remain_len);
+	if(ret == 0)
 	{
-		rohc_comp_warn(context, "failed to build the static chain of the IR packet");
-		goto error;
+		ret = rohc_comp_rfc5225_ip_esp_static_chain(context, ip, rohc_remain_data,
+		                                            rohc_remain_len);
+		if(ret < 0)
+		{
+			rohc_comp_warn(context, "failed to build the static chain of the IR packet");
+			goto error;
+		}
+		rohc_comp_static_chain_cache(context, rohc_remain_data, ret);
 	}
 	rohc_remain_data += ret;
 	rohc_remain_len -= ret;
@@ -2506,12 +2621,12 @@ static int rohc_comp_rfc5225_ip_esp_code_co_repair_pkt(const struct rohc_comp_ct
 		co_repair_crc->ctrl_crc =
 			compute_crc_ctrl_fields(context->profile->id,
 			                        context->compressor->crc_table_3,
-			                        context->compressor->reorder_ratio,
+			                        rfc5225_ctxt->reorder.ratio,
 			                        rfc5225_ctxt->msn,
 			                        ip_id_behaviors, ip_id_behaviors_nr);
 		rohc_comp_debug(context, "CRC-3 on control fields = 0x%x "
 		                "(reorder_ratio = 0x%02x, %zu IP-ID behaviors)",
-		                co_repair_crc->ctrl_crc, context->compressor->reorder_ratio,
+		                co_repair_crc->ctrl_crc, rfc5225_ctxt->reorder.ratio,
 		                ip_id_behaviors_nr);
 
 		/* skip CRCs */
@@ -3261,6 +3376,7 @@ static int rohc_comp_rfc5225_ip_esp_dyn_esp_part(const struct rohc_comp_ctxt *co
                                                  uint8_t *const rohc_data,
                                                  const size_t rohc_max_len)
 {
+	const struct rohc_comp_rfc5225_ip_esp_ctxt *const rfc5225_ctxt = ctxt->specific;
 	esp_dynamic_t *const esp_dynamic = (esp_dynamic_t *) rohc_data;
 	const size_t esp_dynamic_len = sizeof(esp_dynamic_t);
 
@@ -3274,7 +3390,7 @@ static int rohc_comp_rfc5225_ip_esp_dyn_esp_part(const struct rohc_comp_ctxt *co
 
 	esp_dynamic->sequence_number = esp->sn;
 	esp_dynamic->reserved = 0;
-	esp_dynamic->reorder_ratio = ctxt->compressor->reorder_ratio;
+	esp_dynamic->reorder_ratio = rfc5225_ctxt->reorder.ratio;
 
 	rohc_comp_dump_buf(ctxt, "ESP dynamic part", rohc_data, esp_dynamic_len);
 
@@ -3717,7 +3833,7 @@ static int rohc_comp_rfc5225_ip_esp_build_co_common_pkt(const struct rohc_comp_c
 	}
 	co_common->ttl_hopl_ind = rfc5225_ctxt->tmp.innermost_ttl_hopl_changed;
 	co_common->tos_tc_ind = rfc5225_ctxt->tmp.innermost_tos_tc_changed;
-	co_common->reorder_ratio = context->compressor->reorder_ratio;
+	co_common->reorder_ratio = rfc5225_ctxt->reorder.ratio;
 
 	/* CRC-3 over control fields */
 	{
@@ -3744,12 +3860,12 @@ static int rohc_comp_rfc5225_ip_esp_build_co_common_pkt(const struct rohc_comp_c
 		co_common->control_crc3 =
 			compute_crc_ctrl_fields(context->profile->id,
 			                        context->compressor->crc_table_3,
-			                        context->compressor->reorder_ratio,
+			                        rfc5225_ctxt->reorder.ratio,
 			                        rfc5225_ctxt->msn,
 			                        ip_id_behaviors, ip_id_behaviors_nr);
 		rohc_comp_debug(context, "CRC-3 on control fields = 0x%x "
 		                "(reorder_ratio = 0x%02x, %zu IP-ID behaviors)",
-		                co_common->control_crc3, context->compressor->reorder_ratio,
+		                co_common->control_crc3, rfc5225_ctxt->reorder.ratio,
 		                ip_id_behaviors_nr);
 	}
 
@@ -30,10 +30,12 @@
 #include "protocols/ip_numbers.h"
 #include "protocols/ip.h"
 #include "protocols/rfc5225.h"
+#include "protocols/overlay.h"
 #include "schemes/cid.h"
 #include "schemes/ipv6_exts.h"
 #include "schemes/ip_ctxt.h"
 #include "schemes/comp_wlsb.h"
+#include "schemes/comp_reorder_ratio.h"
 #include "schemes/ip_id_offset.h"
 #include "schemes/rfc4996.h" /* for c_optional_ip_id_lsb */
 #include "crc.h"
@@ -73,6 +75,9 @@ struct comp_rfc5225_tmp_variables
 	/** Whether the innermost TOS/TC or TTL/HL changed in the innermost IP header */
 	bool innermost_ip_flag;
 
+	/** Whether the reorder ratio changed */
+	bool reorder_ratio_changed;
+
 	/** The new innermost IP-ID value */
 	uint16_t innermost_ip_id;
 	/** The new innermost IP-ID / SN delta (with bits swapped if necessary) */
@@ -97,6 +102,8 @@ struct rohc_comp_rfc5225_ip_udp_ctxt
 {
 	uint16_t msn;  /**< The Master Sequence Number (MSN) */
 	struct c_wlsb msn_wlsb;    /**< The W-LSB encoding context for MSN */
+	/** The reordering state used to adapt the reorder ratio of the MSN */
+	struct c_reorder_ratio reorder;
 
 	/** The MSN of the last packet that updated the context (used to determine
 	 * if a positive ACK may cause a transition to a higher compression state) */
@@ -133,6 +140,9 @@ struct rohc_comp_rfc5225_ip_udp_ctxt
 	/** The number of innermost TTL/HL transmissions since last change */
 	uint8_t innermost_ttl_hopl_trans_nr;
 
+	/** The number of reorder ratio transmissions since last change */
+	uint8_t reorder_ratio_trans_nr;
+
 	struct comp_rfc5225_tmp_variables tmp;
 
 	/** The UDP Source port */
@@ -143,6 +153,11 @@ struct rohc_comp_rfc5225_ip_udp_ctxt
 	bool udp_checksum_used;
 	/** The number of 'UDP checksum used' transmissions since last change */
 	uint8_t udp_checksum_used_trans_nr;
+
+	/** The type of the overlay headers that follow the UDP header */
+	rohc_overlay_t overlay_type;
+	/** The overlay headers that follow the UDP header, if any */
+	uint8_t overlay_hdrs[OVERLAY_HDRS_LEN];
 };
 
 
@@ -191,7 +206,7 @@ static int rohc_comp_rfc5225_ip_udp_detect_changes_ipv6(struct rohc_comp_ctxt *c
                                                         const bool is_innermost)
 	__attribute__((warn_unused_result, nonnull(1, 2, 3)));
 
-static int rohc_comp_rfc5225_ip_udp_code_IR_pkt(const struct rohc_comp_ctxt *const ctxt,
+static int rohc_comp_rfc5225_ip_udp_code_IR_pkt(struct rohc_comp_ctxt *const ctxt,
                                                 const struct ip_packet *const ip,
                                                 uint8_t *const rohc_pkt,
                                                 const size_t rohc_pkt_max_len)
@@ -265,6 +280,10 @@ static int rohc_comp_rfc5225_ip_udp_static_udp_part(const struct rohc_comp_ctxt
                                                     uint8_t *const rohc_data,
                                                     const size_t rohc_max_len)
 	__attribute__((warn_unused_result, nonnull(1, 2, 3)));
+static int rohc_comp_rfc5225_ip_udp_static_overlay_part(const struct rohc_comp_ctxt *const ctxt,
+                                                        uint8_t *const rohc_data,
+                                                        const size_t rohc_max_len)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
 
 /* dynamic chain */
 static int rohc_comp_rfc5225_ip_udp_dyn_chain(const struct rohc_comp_ctxt *const ctxt,
@@ -336,6 +355,9 @@ static void rohc_comp_rfc5225_ip_udp_feedback_ack(struct rohc_comp_ctxt *const c
                                                   const bool sn_not_valid)
 	__attribute__((nonnull(1)));
 
+static void rohc_comp_rfc5225_ip_udp_set_wlsb_width(struct rohc_comp_ctxt *const ctxt)
+	__attribute__((nonnull(1)));
+
 /* mode and state transitions */
 static void rohc_comp_rfc5225_ip_udp_decide_state(struct rohc_comp_ctxt *const context,
                                                   const struct rohc_ts pkt_time)
@@ -355,6 +377,11 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
                                                                const bool crc7_at_least)
 	__attribute__((warn_unused_result, nonnull(1)));
 
+static rohc_overlay_t rohc_comp_rfc5225_ip_udp_get_overlay(const struct rohc_comp *const comp,
+                                                           const uint8_t *const udp_data,
+                                                           const size_t udp_len)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
+
 static bool rohc_comp_rfc5225_is_msn_lsb_possible(const struct c_wlsb *const wlsb,
                                                   const uint16_t value,
                                                   const rohc_reordering_offset_t reorder_ratio,
@@ -492,6 +519,8 @@ static bool rohc_comp_rfc5225_ip_udp_create(struct rohc_comp_ctxt *const context
 
 	/* MSN */
 	wlsb_init(&rfc5225_ctxt->msn_wlsb, 16, comp->wlsb_window_width, ROHC_LSB_SHIFT_VAR);
+	/* reorder ratio of the MSN, adapted later to the reordering observed */
+	c_reorder_ratio_init(&rfc5225_ctxt->reorder, comp->reorder_ratio, 16);
 	/* innermost IP-ID offset */
 	wlsb_init(&rfc5225_ctxt->innermost_ip_id_offset_wlsb, 16,
 	          comp->wlsb_window_width, ROHC_LSB_SHIFT_VAR);
@@ -503,6 +532,18 @@ static bool rohc_comp_rfc5225_ip_udp_create(struct rohc_comp_ctxt *const context
 		/* record the UDP source and destination ports in context */
 		rfc5225_ctxt->udp_sport = rohc_ntoh16(udp->source);
 		rfc5225_ctxt->udp_dport = rohc_ntoh16(udp->dest);
+
+		/* record the overlay headers that follow the UDP header, if any */
+		rfc5225_ctxt->overlay_type =
+			rohc_comp_rfc5225_ip_udp_get_overlay(comp, remain_data, remain_len);
+		if(rfc5225_ctxt->overlay_type != ROHC_OVERLAY_NONE)
+		{
+			rohc_comp_debug(context, "UDP payload starts with %s overlay headers",
+			                rfc5225_ctxt->overlay_type == ROHC_OVERLAY_VXLAN ?
+			                "VXLAN" : "Geneve");
+			memcpy(rfc5225_ctxt->overlay_hdrs, remain_data + sizeof(struct udphdr),
+			       OVERLAY_HDRS_LEN);
+		}
 	}
 
 	/* init the Master Sequence Number to a random value */
@@ -755,6 +796,7 @@ bad_profile:
  *    context
  *  - the UDP source port must be the same as in context
  *  - the UDP destination port must be the same as in context
+ *  - the overlay headers, if any, must be the same as in context
  *
  * This function is one of the functions that must exist in one profile for the
  * framework to work.
@@ -929,6 +971,21 @@ static bool rohc_comp_rfc5225_ip_udp_check_context(const struct rohc_comp_ctxt *
 		rohc_comp_debug(context, "  same UDP destination port");
 	}
 
+	/* check overlay headers */
+	if(rohc_comp_rfc5225_ip_udp_get_overlay(context->compressor, remain_data,
+	                                        remain_len) != rfc5225_ctxt->overlay_type)
+	{
+		rohc_comp_debug(context, "  not same type of overlay headers");
+		goto bad_context;
+	}
+	if(rfc5225_ctxt->overlay_type != ROHC_OVERLAY_NONE &&
+	   memcmp(remain_data + sizeof(struct udphdr), rfc5225_ctxt->overlay_hdrs,
+	          OVERLAY_HDRS_LEN) != 0)
+	{
+		rohc_comp_debug(context, "  not same overlay headers");
+		goto bad_context;
+	}
+
 	return true;
 
 bad_context:
@@ -1135,6 +1192,10 @@ static int rohc_comp_rfc5225_ip_udp_encode(struct rohc_comp_ctxt *const context,
 	{
 		rfc5225_ctxt->innermost_ttl_hopl_trans_nr++;
 	}
+	if(rfc5225_ctxt->reorder_ratio_trans_nr < MAX_FO_COUNT)
+	{
+		rfc5225_ctxt->reorder_ratio_trans_nr++;
+	}
 	if(rfc5225_ctxt->udp_checksum_used_trans_nr < MAX_FO_COUNT)
 	{
 		rfc5225_ctxt->udp_checksum_used_trans_nr++;
@@ -1180,6 +1241,7 @@ static bool rohc_comp_rfc5225_ip_udp_detect_changes(struct rohc_comp_ctxt *const
 	rfc5225_ctxt->tmp.innermost_ip_flag = false;
 	rfc5225_ctxt->tmp.at_least_one_df_changed = false;
 	rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed = false;
+	rfc5225_ctxt->tmp.reorder_ratio_changed = false;
 	for(ip_hdr_pos = 0; ip_hdr_pos < rfc5225_ctxt->ip_contexts_nr; ip_hdr_pos++)
 	{
 		const struct ip_hdr *const ip_hdr = (struct ip_hdr *) remain_data;
@@ -1277,6 +1339,12 @@ static bool rohc_comp_rfc5225_ip_udp_detect_changes(struct rohc_comp_ctxt *const
 		*payload_offset += sizeof(struct udphdr);
 	}
 
+	/* the overlay headers are static, they are never part of the payload */
+	if(rfc5225_ctxt->overlay_type != ROHC_OVERLAY_NONE)
+	{
+		*payload_offset += OVERLAY_HDRS_LEN;
+	}
+
 	/* compute or find the new SN */
 	rfc5225_ctxt->msn++; /* wraparound on overflow is expected */
 	rohc_comp_debug(context, "MSN = 0x%04x / %u", rfc5225_ctxt->msn, rfc5225_ctxt->msn);
@@ -1484,6 +1552,15 @@ static bool rohc_comp_rfc5225_ip_udp_detect_changes(struct rohc_comp_ctxt *const
 		rfc5225_ctxt->tmp.innermost_ttl_hopl_changed = true;
 	}
 
+	/* reorder ratio that changes shall be transmitted several times */
+	if(rfc5225_ctxt->reorder_ratio_trans_nr < MAX_FO_COUNT)
+	{
+		rohc_comp_debug(context, "reorder ratio changed in last packets, "
+		                "it shall be transmitted %u times more",
+		                MAX_FO_COUNT - rfc5225_ctxt->reorder_ratio_trans_nr);
+		rfc5225_ctxt->tmp.reorder_ratio_changed = true;
+	}
+
 	/* 'UDP checksum used' that changes shall be transmitted several times */
 	if(rfc5225_ctxt->tmp.udp_checksum_used_changed)
 	{
@@ -1761,6 +1838,7 @@ static bool rohc_comp_rfc5225_ip_udp_feedback_2(struct rohc_comp_ctxt *const ctx
                                                 const uint8_t *const feedback_data,
                                                 const size_t feedback_data_len)
 {
+	struct rohc_comp_rfc5225_ip_udp_ctxt *const rfc5225_ctxt = ctxt->specific;
 	const uint8_t *remain_data = feedback_data;
 	size_t remain_len = feedback_data_len;
 	const struct rohc_feedback_2_rfc6846 *feedback2;
@@ -1830,6 +1908,12 @@ static bool rohc_comp_rfc5225_ip_udp_feedback_2(struct rohc_comp_ctxt *const ctx
 			{
 				rohc_comp_change_state(ctxt, ROHC_COMP_STATE_FO);
 			}
+			/* the current references are not robust enough against losses */
+			if(rohc_comp_wlsb_width_adapt(ctxt, feedback2->ack_type, 0))
+			{
+				rohc_comp_rfc5225_ip_udp_set_wlsb_width(ctxt);
+			}
+			c_reorder_ratio_nack(&rfc5225_ctxt->reorder);
 			/* TODO: use the SN field to determine the latest packet successfully
 			 * decompressed and then determine what fields need to be updated */
 			break;
@@ -1841,6 +1925,12 @@ static bool rohc_comp_rfc5225_ip_udp_feedback_2(struct rohc_comp_ctxt *const ctx
 			          "STATIC-NACK received for CID %zu", ctxt->cid);
 			/* the compressor transits back to the IR state */
 			rohc_comp_change_state(ctxt, ROHC_COMP_STATE_IR);
+			/* the current references are not robust enough against losses */
+			if(rohc_comp_wlsb_width_adapt(ctxt, feedback2->ack_type, 0))
+			{
+				rohc_comp_rfc5225_ip_udp_set_wlsb_width(ctxt);
+			}
+			c_reorder_ratio_nack(&rfc5225_ctxt->reorder);
 			/* TODO: use the SN field to determine the latest packet successfully
 			 * decompressed and then determine what fields need to be updated */
 			break;
@@ -1892,6 +1982,12 @@ static void rohc_comp_rfc5225_ip_udp_feedback_ack(struct rohc_comp_ctxt *const c
 		assert(sn_bits_nr <= 16);
 		assert(sn_bits <= 0xffffU);
 
+		/* let the positive ACKs drive the windows on reliable feedback channels */
+		wlsb_set_ack_driven(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
+		                    rohc_comp_wlsb_is_ack_driven(ctxt));
+		wlsb_set_ack_driven(&rfc5225_ctxt->msn_wlsb,
+		                    rohc_comp_wlsb_is_ack_driven(ctxt));
+
 		/* ack innermost IP-ID */
 		acked_nr = wlsb_ack(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
 		                    sn_bits, sn_bits_nr);
@@ -1901,6 +1997,30 @@ static void rohc_comp_rfc5225_ip_udp_feedback_ack(struct rohc_comp_ctxt *const c
 		acked_nr = wlsb_ack(&rfc5225_ctxt->msn_wlsb, sn_bits, sn_bits_nr);
 		rohc_comp_debug(ctxt, "FEEDBACK-2: positive ACK removed %zu values "
 		                "from MSN W-LSB", acked_nr);
+
+		/* adapt the width of the W-LSB windows to the number of packets that
+		 * were sent after the acknowledged one */
+		{
+			const uint16_t sn_mask = (1U << sn_bits_nr) - 1;
+			const uint16_t unacked_nr = (rfc5225_ctxt->msn - sn_bits) & sn_mask;
+
+			/* the 8-bit MSN of FEEDBACK-1 may wrap around while packets are not
+			 * acknowledged yet, do not shrink the windows with it */
+			if(sn_bits_nr >= ROHC_WLSB_WIDTH_ACK_SN_BITS_MIN &&
+			   rohc_comp_wlsb_width_adapt(ctxt, ROHC_FEEDBACK_ACK, unacked_nr))
+			{
+				rohc_comp_rfc5225_ip_udp_set_wlsb_width(ctxt);
+			}
+
+			/* adapt the reorder ratio to the order of the acknowledged MSNs */
+			if(c_reorder_ratio_ack(&rfc5225_ctxt->reorder,
+			                       (uint16_t) (rfc5225_ctxt->msn - unacked_nr)))
+			{
+				rohc_comp_debug(ctxt, "reorder ratio changed to %u",
+				                rfc5225_ctxt->reorder.ratio);
+				rfc5225_ctxt->reorder_ratio_trans_nr = 0;
+			}
+		}
 	}
 
 	/* RFC 6846, §5.2.2.1:
@@ -1951,6 +2071,21 @@ static void rohc_comp_rfc5225_ip_udp_feedback_ack(struct rohc_comp_ctxt *const c
 }
 
 
+/**
+ * @brief Resize the W-LSB windows of the context to the width of the context
+ *
+ * @param ctxt  The compression context
+ */
+static void rohc_comp_rfc5225_ip_udp_set_wlsb_width(struct rohc_comp_ctxt *const ctxt)
+{
+	struct rohc_comp_rfc5225_ip_udp_ctxt *const rfc5225_ctxt = ctxt->specific;
+
+	wlsb_set_window_width(&rfc5225_ctxt->msn_wlsb, ctxt->wlsb_window_width);
+	wlsb_set_window_width(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
+	                      ctxt->wlsb_window_width);
+}
+
+
 /**
  * @brief Decide the state that should be used for the next packet
  *
@@ -1965,33 +2100,35 @@ static void rohc_comp_rfc5225_ip_udp_decide_state(struct rohc_comp_ctxt *const c
 
 	if(curr_state == ROHC_COMP_STATE_IR)
 	{
-		if(context->ir_count < MAX_IR_COUNT)
+		if(context->ir_count < context->oa_repetitions_nr)
 		{
 			rohc_comp_debug(context, "not enough packets transmitted in IR state "
-			                "for the moment (%zu/%d), so stay in IR state",
-			                context->ir_count, MAX_IR_COUNT);
+			                "for the moment (%zu/%zu), so stay in IR state",
+			                context->ir_count, context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_IR;
 		}
 		else
 		{
-			rohc_comp_debug(context, "enough packets transmitted in IR state (%zu/%u), "
-			                "go to SO state", context->ir_count, MAX_IR_COUNT);
+			rohc_comp_debug(context, "enough packets transmitted in IR state (%zu/%zu), "
+			                "go to SO state", context->ir_count,
+			                context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_SO;
 		}
 	}
 	else if(curr_state == ROHC_COMP_STATE_FO)
 	{
-		if(context->fo_count < MAX_FO_COUNT)
+		if(context->fo_count < context->oa_repetitions_nr)
 		{
 			rohc_comp_debug(context, "not enough packets transmitted in FO state "
-			                "for the moment (%zu/%u), so stay in FO state",
-			                context->fo_count, MAX_FO_COUNT);
+			                "for the moment (%zu/%zu), so stay in FO state",
+			                context->fo_count, context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_FO;
 		}
 		else
 		{
-			rohc_comp_debug(context, "enough packets transmitted in FO state (%zu/%u), "
-			                "go to SO state", context->fo_count, MAX_FO_COUNT);
+			rohc_comp_debug(context, "enough packets transmitted in FO state (%zu/%zu), "
+			                "go to SO state", context->fo_count,
+			                context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_SO;
 		}
 	}
@@ -2125,7 +2262,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
 {
 	struct rohc_comp_rfc5225_ip_udp_ctxt *const rfc5225_ctxt = ctxt->specific;
 	const int16_t msn_offset = rfc5225_ctxt->tmp.msn_offset;
-	const rohc_reordering_offset_t reorder_ratio = ctxt->compressor->reorder_ratio;
+	const rohc_reordering_offset_t reorder_ratio = rfc5225_ctxt->reorder.ratio;
 	const ip_context_t *const innermost_ip_ctxt =
 		&(rfc5225_ctxt->ip_contexts[rfc5225_ctxt->ip_contexts_nr - 1]);
 	const uint16_t innermost_ip_id = rfc5225_ctxt->tmp.innermost_ip_id;
@@ -2149,6 +2286,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
 	 *     - sequential and inferred from MSN (and not transmitted at all).
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	else if(!crc7_at_least &&
 	        rohc_comp_rfc5225_is_msn_lsb_possible(&rfc5225_ctxt->msn_wlsb,
@@ -2159,7 +2297,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
 	        !rfc5225_ctxt->tmp.outer_ip_flag &&
 	        !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	        !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	        !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		rohc_comp_debug(ctxt, "code pt_0_crc3 packet");
 		packet_type = ROHC_PACKET_PT_0_CRC3;
@@ -2172,6 +2311,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
 	 *     - sequential and inferred from MSN (and not transmitted at all).
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	else if(rohc_comp_rfc5225_is_msn_lsb_possible(&rfc5225_ctxt->msn_wlsb,
 	                                              rfc5225_ctxt->msn,
@@ -2182,7 +2322,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
 	        !rfc5225_ctxt->tmp.outer_ip_flag &&
 	        !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	        !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	        !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		rohc_comp_debug(ctxt, "code pt_0_crc7 packet");
 		packet_type = ROHC_PACKET_NORTP_PT_0_CRC7;
@@ -2194,6 +2335,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
 	 *  - 4 innermost IP-ID / SN offset bits are enough
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	else if(!crc7_at_least &&
 	        rohc_comp_rfc5225_is_msn_lsb_possible(&rfc5225_ctxt->msn_wlsb,
@@ -2206,7 +2348,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
 	        !rfc5225_ctxt->tmp.outer_ip_flag &&
 	        !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	        !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	        !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		assert(innermost_ip_ctxt->ctxt.vx.version == IPV4);
 		rohc_comp_debug(ctxt, "code pt_1_seq_id packet");
@@ -2218,6 +2361,7 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
 	 *  - 8 MSN bits are enough
 	 *  - the TOS/TC fields of all IP headers shall not be changing
 	 *  - the behavior of the innermost IP-ID shall not be changing
+	 *  - the reorder ratio shall not be changing
 	 */
 	else if(rohc_comp_rfc5225_is_ipid_sequential(innermost_ip_id_behavior) &&
 	        wlsb_is_kp_possible_16bits(&rfc5225_ctxt->innermost_ip_id_offset_wlsb,
@@ -2229,7 +2373,8 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
 	        !rfc5225_ctxt->tmp.outer_ip_flag &&
 	        !rfc5225_ctxt->tmp.innermost_ip_flag &&
 	        !rfc5225_ctxt->tmp.at_least_one_df_changed &&
-	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed)
+	        !rfc5225_ctxt->tmp.at_least_one_ip_id_behavior_changed &&
+	        !rfc5225_ctxt->tmp.reorder_ratio_changed)
 	{
 		rohc_comp_debug(ctxt, "code pt_2_seq_id packet");
 		packet_type = ROHC_PACKET_NORTP_PT_2_SEQ_ID;
@@ -2261,6 +2406,55 @@ static rohc_packet_t rohc_comp_rfc5225_ip_udp_decide_FO_SO_pkt(const struct rohc
 }
 
 
+/**
+ * @brief Find out whether the UDP payload starts with overlay headers
+ *
+ * Only the VXLAN headers and the Geneve headers without option that carry an
+ * inner Ethernet frame are handled. They are never detected if the UDP
+ * overlays feature is disabled.
+ *
+ * @param comp      The ROHC compressor
+ * @param udp_data  The UDP header and its payload
+ * @param udp_len   The length of the UDP header and its payload
+ * @return          The type of the overlay headers, \ref ROHC_OVERLAY_NONE
+ *                  if there is none
+ */
+static rohc_overlay_t rohc_comp_rfc5225_ip_udp_get_overlay(const struct rohc_comp *const comp,
+                                                           const uint8_t *const udp_data,
+                                                           const size_t udp_len)
+{
+	const struct udphdr *const udp = (struct udphdr *) udp_data;
+	const uint8_t *const overlay = udp_data + sizeof(struct udphdr);
+	rohc_overlay_t overlay_type = ROHC_OVERLAY_NONE;
+
+	if((comp->features & ROHC_COMP_FEATURE_UDP_OVERLAYS) == 0 ||
+	   udp_len < (sizeof(struct udphdr) + OVERLAY_HDRS_LEN))
+	{
+		overlay_type = ROHC_OVERLAY_NONE;
+	}
+	else if(rohc_ntoh16(udp->dest) == VXLAN_PORT)
+	{
+		const struct vxlanhdr *const vxlan = (struct vxlanhdr *) overlay;
+
+		if(vxlan->flags == VXLAN_FLAGS_VNI)
+		{
+			overlay_type = ROHC_OVERLAY_VXLAN;
+		}
+	}
+	else if(rohc_ntoh16(udp->dest) == GENEVE_PORT)
+	{
+		const struct genevehdr *const geneve = (struct genevehdr *) overlay;
+
+		if(geneve->ver_opt_len == 0 && rohc_ntoh16(geneve->proto) == GENEVE_PROTO_ETH)
+		{
+			overlay_type = ROHC_OVERLAY_GENEVE;
+		}
+	}
+
+	return overlay_type;
+}
+
+
 /**
  * @brief Define according to computed shift parameter if msn_lsb() is possible
  *
@@ -2348,7 +2542,7 @@ static bool rohc_comp_rfc5225_is_seq_ipid_inferred(const ip_context_t *const ip_
  * @return                  The length of the ROHC packet if successful,
  *                          -1 otherwise
  */
-static int rohc_comp_rfc5225_ip_udp_code_IR_pkt(const struct rohc_comp_ctxt *context,
+static int rohc_comp_rfc5225_ip_udp_code_IR_pkt(struct rohc_comp_ctxt *const context,
                                                 const struct ip_packet *const ip,
                                                 uint8_t *const rohc_pkt,
                                                 const size_t rohc_pkt_max_len)
@@ -2411,13 +2605,18 @@ static int rohc_comp_rfc5225_ip_udp_code_IR_pkt(const struct rohc_comp_ctxt *con
 	rohc_remain_len--;
 	rohc_hdr_len++;
 
-	/* add static chain */
-	ret = rohc_comp_rfc5225_ip_udp_static_chain(context, ip, rohc_remain_data,
-	                                            rohc_remain_len);
-	if(ret < 0)
+	/* add static chain, the one cached in context if any */
+	ret = rohc_comp_static_chain_reuse(context, rohc_remain_data, rohc_remain_len);
+	if(ret == 0)
 	{
-		rohc_comp_warn(context, "failed to build the static chain of the IR packet");
-		goto error;
+		ret = rohc_comp_rfc5225_ip_udp_static_chain(context, ip, rohc_remain_data,
+		                                            rohc_remain_len);
+		if(ret < 0)
+		{
+			rohc_comp_warn(context, "failed to build the static chain of the IR packet");
+			goto error;
+		}
+		rohc_comp_static_chain_cache(context, rohc_remain_data, ret);
 	}
 	rohc_remain_data += ret;
 	rohc_remain_len -= ret;
@@ -2578,12 +2777,12 @@ static int rohc_comp_rfc5225_ip_udp_code_co_repair_pkt(const struct rohc_comp_ct
 		co_repair_crc->ctrl_crc =
 			compute_crc_ctrl_fields(context->profile->id,
 			                        context->compressor->crc_table_3,
-			                        context->compressor->reorder_ratio,
+			                        rfc5225_ctxt->reorder.ratio,
 			                        rfc5225_ctxt->msn,
 			                        ip_id_behaviors, ip_id_behaviors_nr);
 		rohc_comp_debug(context, "CRC-3 on control fields = 0x%x "
 		                "(reorder_ratio = 0x%02x, MSN = 0x%04x, %zu IP-ID behaviors)",
-		                co_repair_crc->ctrl_crc, context->compressor->reorder_ratio,
+		                co_repair_crc->ctrl_crc, rfc5225_ctxt->reorder.ratio,
 		                rfc5225_ctxt->msn, ip_id_behaviors_nr);
 
 		/* skip CRCs */
@@ -2909,9 +3108,7 @@ static int rohc_comp_rfc5225_ip_udp_static_chain(const struct rohc_comp_ctxt *co
 			               "of the static chain");
 			goto error;
 		}
-#ifndef __clang_analyzer__ /* silent warning about dead in/decrement */
 		rohc_remain_data += ret;
-#endif
 		rohc_remain_len -= ret;
 
 #ifndef __clang_analyzer__ /* silent warning about dead in/decrement */
@@ -2920,6 +3117,23 @@ static int rohc_comp_rfc5225_ip_udp_static_chain(const struct rohc_comp_ctxt *co
 #endif
 	}
 
+	/* add overlay part to static chain (non-standard) */
+	if((ctxt->compressor->features & ROHC_COMP_FEATURE_UDP_OVERLAYS) != 0)
+	{
+		ret = rohc_comp_rfc5225_ip_udp_static_overlay_part(ctxt, rohc_remain_data,
+		                                                   rohc_remain_len);
+		if(ret < 0)
+		{
+			rohc_comp_warn(ctxt, "failed to build the overlay static part "
+			               "of the static chain");
+			goto error;
+		}
+#ifndef __clang_analyzer__ /* silent warning about dead in/decrement */
+		rohc_remain_data += ret;
+#endif
+		rohc_remain_len -= ret;
+	}
+
 	return (rohc_pkt_max_len - rohc_remain_len);
 
 error:
@@ -3085,6 +3299,55 @@ error:
 }
 
 
+/**
+ * @brief Build the static part of the overlay headers
+ *
+ * The overlay static part is not defined by RFC5225: the VXLAN or Geneve
+ * header and the inner Ethernet header are transmitted as is in the static
+ * chain, so that they are elided from all the CO packets.
+ *
+ * @param ctxt            The compression context
+ * @param[out] rohc_data  The ROHC packet being built
+ * @param rohc_max_len    The max remaining length in the ROHC buffer
+ * @return                The length appended in the ROHC buffer if positive,
+ *                        -1 in case of error
+ */
+static int rohc_comp_rfc5225_ip_udp_static_overlay_part(const struct rohc_comp_ctxt *const ctxt,
+                                                        uint8_t *const rohc_data,
+                                                        const size_t rohc_max_len)
+{
+	const struct rohc_comp_rfc5225_ip_udp_ctxt *const rfc5225_ctxt = ctxt->specific;
+	overlay_static_t *const overlay_static = (overlay_static_t *) rohc_data;
+	size_t overlay_static_len = sizeof(overlay_static_t);
+
+	if(rfc5225_ctxt->overlay_type != ROHC_OVERLAY_NONE)
+	{
+		overlay_static_len += OVERLAY_HDRS_LEN;
+	}
+	if(rohc_max_len < overlay_static_len)
+	{
+		rohc_comp_warn(ctxt, "ROHC buffer too small for the overlay static part: "
+		               "%zu bytes required, but only %zu bytes available",
+		               overlay_static_len, rohc_max_len);
+		goto error;
+	}
+
+	overlay_static->type = rfc5225_ctxt->overlay_type;
+	if(rfc5225_ctxt->overlay_type != ROHC_OVERLAY_NONE)
+	{
+		memcpy(rohc_data + sizeof(overlay_static_t), rfc5225_ctxt->overlay_hdrs,
+		       OVERLAY_HDRS_LEN);
+	}
+
+	rohc_comp_dump_buf(ctxt, "overlay static part", rohc_data, overlay_static_len);
+
+	return overlay_static_len;
+
+error:
+	return -1;
+}
+
+
 /**
  * @brief Code the dynamic chain of a ROHCv2 IP/UDP IR packet
  *
@@ -3349,7 +3612,7 @@ static int rohc_comp_rfc5225_ip_udp_dyn_udp_part(const struct rohc_comp_ctxt *co
 	udp_dynamic->checksum = udp->check;
 	udp_dynamic->msn = rohc_hton16(rfc5225_ctxt->msn);
 	udp_dynamic->reserved = 0;
-	udp_dynamic->reorder_ratio = ctxt->compressor->reorder_ratio;
+	udp_dynamic->reorder_ratio = rfc5225_ctxt->reorder.ratio;
 
 	rohc_comp_dump_buf(ctxt, "UDP dynamic part", rohc_data, udp_dynamic_len);
 
@@ -3863,7 +4126,7 @@ static int rohc_comp_rfc5225_ip_udp_build_co_common_pkt(const struct rohc_comp_c
 	}
 	co_common->ttl_hopl_ind = rfc5225_ctxt->tmp.innermost_ttl_hopl_changed;
 	co_common->tos_tc_ind = rfc5225_ctxt->tmp.innermost_tos_tc_changed;
-	co_common->reorder_ratio = context->compressor->reorder_ratio;
+	co_common->reorder_ratio = rfc5225_ctxt->reorder.ratio;
 
 	/* CRC-3 over control fields */
 	{
@@ -3890,12 +4153,12 @@ static int rohc_comp_rfc5225_ip_udp_build_co_common_pkt(const struct rohc_comp_c
 		co_common->control_crc3 =
 			compute_crc_ctrl_fields(context->profile->id,
 			                        context->compressor->crc_table_3,
-			                        context->compressor->reorder_ratio,
+			                        rfc5225_ctxt->reorder.ratio,
 			                        rfc5225_ctxt->msn,
 			                        ip_id_behaviors, ip_id_behaviors_nr);
 		rohc_comp_debug(context, "CRC-3 on control fields = 0x%x "
 		                "(reorder_ratio = 0x%02x, MSN = 0x%04x, %zu IP-ID behaviors)",
-		                co_common->control_crc3, context->compressor->reorder_ratio,
+		                co_common->control_crc3, rfc5225_ctxt->reorder.ratio,
 		                rfc5225_ctxt->msn, ip_id_behaviors_nr);
 	}
 
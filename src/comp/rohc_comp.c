@@ -118,8 +118,11 @@ static const struct rohc_comp_profile *
 	                         const rohc_profile_t profile_id)
 	__attribute__((warn_unused_result, nonnull(1)));
 
+static bool rohc_comp_profile_is_fallback(const rohc_profile_t profile_id)
+	__attribute__((warn_unused_result, const));
+
 static const struct rohc_comp_profile *
-	c_get_profile_from_packet(const struct rohc_comp *const comp,
+	c_get_profile_from_packet(struct rohc_comp *const comp,
 	                          const struct net_pkt *const packet)
 	__attribute__((warn_unused_result, nonnull(1, 2)));
 
@@ -153,6 +156,36 @@ static struct rohc_comp_ctxt *
 static struct rohc_comp_ctxt *
 	c_get_context(struct rohc_comp *const comp, const rohc_cid_t cid)
 	__attribute__((nonnull(1), warn_unused_result));
+static bool c_ctxt_evict_first(const struct rohc_comp *const comp,
+                               const struct rohc_comp_ctxt *const ctxt1,
+                               const struct rohc_comp_ctxt *const ctxt2)
+	__attribute__((nonnull(1, 2, 3), warn_unused_result));
+static bool c_are_all_ctxts_pinned(const struct rohc_comp *const comp)
+	__attribute__((nonnull(1), warn_unused_result, pure));
+static bool c_ctxt_admit(struct rohc_comp *const comp,
+                         const struct net_pkt *const packet,
+                         const struct rohc_ts arrival_time)
+	__attribute__((nonnull(1, 2), warn_unused_result));
+static bool c_is_cr_base_ctxt(const struct rohc_comp *const comp,
+                              const rohc_cid_t cid,
+                              const rohc_ctxt_key_t addrs_key)
+	__attribute__((nonnull(1), warn_unused_result, pure));
+static void c_set_cr_base_ctxt(struct rohc_comp *const comp,
+                               const struct rohc_comp_ctxt *const context)
+	__attribute__((nonnull(1, 2)));
+static bool c_get_cr_base_ctxt(const struct rohc_comp *const comp,
+                               const struct rohc_comp_profile *const profile,
+                               const struct net_pkt *const packet,
+                               rohc_cid_t *const base_cid)
+	__attribute__((nonnull(1, 2, 3, 4), warn_unused_result));
+
+static size_t rohc_comp_draw_refresh_jitter(const struct rohc_comp *const comp)
+	__attribute__((nonnull(1), warn_unused_result));
+static uint64_t rohc_comp_refresh_timeout(const struct rohc_comp_ctxt *const context,
+                                          const uint64_t timeout)
+	__attribute__((nonnull(1), warn_unused_result, pure));
+static bool rohc_comp_refresh_take_token(struct rohc_comp *const comp)
+	__attribute__((nonnull(1), warn_unused_result));
 
 
 /*
@@ -164,6 +197,10 @@ static bool __rohc_comp_deliver_feedback(struct rohc_comp *const comp,
                                          const size_t size)
 	__attribute__((warn_unused_result, nonnull(1, 2)));
 
+static void rohc_comp_oa_repetitions_adapt(struct rohc_comp_ctxt *const context,
+                                           const enum rohc_feedback_ack_type ack_type)
+	__attribute__((nonnull(1)));
+
 static bool rohc_comp_feedback_parse_cid(const struct rohc_comp *const comp,
                                          const uint8_t *const feedback,
                                          const size_t feedback_len,
@@ -182,6 +219,16 @@ static bool rohc_comp_feedback_check_opts(const struct rohc_comp_ctxt *const con
                                           const size_t opts_present[ROHC_FEEDBACK_OPT_MAX])
 	__attribute__((warn_unused_result, nonnull(1, 2)));
 
+static size_t rohc_comp_feedbacks_fit(struct rohc_comp *const comp,
+                                      const size_t max_len)
+	__attribute__((warn_unused_result, nonnull(1)));
+static void rohc_comp_feedbacks_piggyback(struct rohc_comp *const comp,
+                                          struct rohc_buf *const rohc_packet)
+	__attribute__((nonnull(1, 2)));
+static void rohc_comp_feedbacks_remove(struct rohc_comp *const comp,
+                                       const size_t len)
+	__attribute__((nonnull(1)));
+
 
 /*
  * Definitions of public functions
@@ -301,6 +348,7 @@ struct rohc_comp * rohc_comp_new2(const rohc_cid_type_t cid_type,
 	{
 		comp->enabled_profiles[i] = false;
 	}
+	memset(comp->profile_cache, 0, sizeof(comp->profile_cache));
 
 	/* reset statistics */
 	comp->num_packets = 0;
@@ -338,6 +386,26 @@ struct rohc_comp * rohc_comp_new2(const rohc_cid_type_t cid_type,
 		goto destroy_comp;
 	}
 
+	/* piggyback all the queued feedback items on the next ROHC packet by
+	 * default, and flush them as soon as asked */
+	is_fine = rohc_comp_set_piggybacking(comp, ROHC_COMP_FEEDBACKS_MAX_LEN, 0);
+	if(is_fine != true)
+	{
+		goto destroy_comp;
+	}
+
+	/* periodic refreshes are neither staggered nor rate-limited by default */
+	is_fine = rohc_comp_set_periodic_refreshes_jitter(comp, 0);
+	if(is_fine != true)
+	{
+		goto destroy_comp;
+	}
+	is_fine = rohc_comp_set_refreshes_rate(comp, 0, 1);
+	if(is_fine != true)
+	{
+		goto destroy_comp;
+	}
+
 	/* set the default number of uncompressed transmissions for list
 	 * compression */
 	is_fine = rohc_comp_set_list_trans_nr(comp, ROHC_LIST_DEFAULT_L);
@@ -346,6 +414,23 @@ struct rohc_comp * rohc_comp_new2(const rohc_cid_type_t cid_type,
 		goto destroy_comp;
 	}
 
+	/* the BER of the channel is unknown by default */
+	is_fine = rohc_comp_set_channel_ber(comp, 0);
+	if(is_fine != true)
+	{
+		goto destroy_comp;
+	}
+
+	/* recycle the least recently used context by default */
+	comp->ctxt_eviction = ROHC_COMP_EVICTION_LRU;
+
+	/* every flow gets its own context by default */
+	is_fine = rohc_comp_set_ctxt_admission(comp, 1, 1);
+	if(is_fine != true)
+	{
+		goto destroy_comp;
+	}
+
 	/* init the tables for fast CRC computation */
 	rohc_crc_init_table(comp->crc_table_3, ROHC_CRC_TYPE_3);
 	rohc_crc_init_table(comp->crc_table_7, ROHC_CRC_TYPE_7);
@@ -499,6 +584,11 @@ error:
  *       Set the \e uncomp_packet.time parameter to 0 if arrival time of the
  *       uncompressed packet is unknown or to disable the time-related features
  *       in the ROHC protocol.
+ *   \li Feedback piggybacking:
+ *       The feedback items queued with \ref rohc_comp_piggyback_feedback are
+ *       added at the beginning of the ROHC packet, as long as they fit in the
+ *       output buffer and in the limit set with
+ *       \ref rohc_comp_set_piggybacking.
  *
  * @param comp              The ROHC compressor
  * @param uncomp_packet     The uncompressed packet to compress
@@ -776,6 +866,15 @@ rohc_status_t rohc_compress4(struct rohc_comp *const comp,
 	 *  - compressor statistics
 	 *  - context statistics (global + last packet + last 16 packets) */
 	comp->num_packets++;
+	if(comp->refreshes_tokens < comp->refreshes_tokens_max)
+	{
+		comp->refreshes_tokens_pkts++;
+		if(comp->refreshes_tokens_pkts >= comp->refreshes_tokens_interval)
+		{
+			comp->refreshes_tokens++;
+			comp->refreshes_tokens_pkts = 0;
+		}
+	}
 	comp->total_uncompressed_size += uncomp_packet.len;
 	comp->total_compressed_size += rohc_packet->len;
 	comp->last_context = c;
@@ -793,6 +892,12 @@ rohc_status_t rohc_compress4(struct rohc_comp *const comp,
 	c->header_last_uncompressed_size = payload_offset;
 	c->header_last_compressed_size = rohc_hdr_size;
 
+	/* piggyback the feedback items queued for the remote compressor */
+	if(status == ROHC_STATUS_OK && comp->feedbacks_len > 0)
+	{
+		rohc_comp_feedbacks_piggyback(comp, rohc_packet);
+	}
+
 	/* compression is successful */
 	return status;
 
@@ -1336,6 +1441,137 @@ bool rohc_comp_set_periodic_refreshes_time(struct rohc_comp *const comp,
 }
 
 
+/**
+ * @brief Set the jitter of the timeouts for IR and FO periodic refreshes
+ *
+ * Contexts created together (after \ref rohc_comp_force_contexts_reinit,
+ * a restart, or a burst of new flows) reach their timeouts for periodic
+ * refreshes together, so they all send IR or FO packets at the same time.
+ *
+ * With jitter, every context shortens its timeouts for periodic refreshes by
+ * a random percentage in range [0 ; \e jitter]. The percentage is drawn
+ * again with the random callback of the compressor every time the context
+ * is created, re-initialized, or periodically refreshed to IR state, so the
+ * refreshes of the contexts get spread over time. The timeouts set with
+ * \ref rohc_comp_set_periodic_refreshes and
+ * \ref rohc_comp_set_periodic_refreshes_time are thus never exceeded.
+ *
+ * The jitter is 0 by default, ie. timeouts are never shortened.
+ *
+ * @param comp    The ROHC compressor
+ * @param jitter  The maximal jitter (in percent) of the timeouts, in range
+ *                [0 ; \ref ROHC_COMP_REFRESH_JITTER_MAX]
+ * @return        true in case of success, false in case of failure
+ *
+ * @ingroup rohc_comp
+ *
+ * @see rohc_comp_set_periodic_refreshes
+ * @see rohc_comp_set_periodic_refreshes_time
+ * @see rohc_comp_set_refreshes_rate
+ */
+bool rohc_comp_set_periodic_refreshes_jitter(struct rohc_comp *const comp,
+                                             const size_t jitter)
+{
+	/* compressor must be valid */
+	if(comp == NULL)
+	{
+		/* cannot print a trace without a valid compressor */
+		goto error;
+	}
+
+	/* check the parameter */
+	if(jitter > ROHC_COMP_REFRESH_JITTER_MAX)
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "invalid jitter for context periodic refreshes: %zu%% "
+		             "shall be in range [0 ; %u%%]", jitter,
+		             ROHC_COMP_REFRESH_JITTER_MAX);
+		goto error;
+	}
+
+	comp->periodic_refreshes_jitter = jitter;
+
+	rohc_info(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL, "jitter for "
+	          "context periodic refreshes set to %zu%%", jitter);
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Limit the rate of the IR and FO periodic refreshes
+ *
+ * Periodic refreshes of all the contexts share one token bucket: every
+ * periodic change back to the IR or FO state takes one token, and the
+ * compressor gets one more token every \e interval compressed packets up to
+ * \e burst tokens. A context that reaches one timeout while no token is
+ * available keeps its state, and retries with its next packets. Refreshes
+ * required by the decompressor through feedback or by changes in the
+ * headers are never delayed.
+ *
+ * The rate of periodic refreshes is not limited by default (\e burst = 0).
+ *
+ * @param comp      The ROHC compressor
+ * @param burst     The maximal number of periodic refreshes that may be done
+ *                  in a row, 0 to disable the rate limit
+ * @param interval  The number of packets to compress to get one more
+ *                  periodic refresh, shall be at least 1
+ * @return          true in case of success, false in case of failure
+ *
+ * @ingroup rohc_comp
+ *
+ * @see rohc_comp_set_periodic_refreshes
+ * @see rohc_comp_set_periodic_refreshes_time
+ * @see rohc_comp_set_periodic_refreshes_jitter
+ */
+bool rohc_comp_set_refreshes_rate(struct rohc_comp *const comp,
+                                  const size_t burst,
+                                  const size_t interval)
+{
+	/* compressor must be valid */
+	if(comp == NULL)
+	{
+		/* cannot print a trace without a valid compressor */
+		goto error;
+	}
+
+	/* check the parameter */
+	if(interval == 0)
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "invalid interval for the rate of periodic refreshes: "
+		             "shall not be zero");
+		goto error;
+	}
+
+	/* the bucket is full at the beginning */
+	comp->refreshes_tokens_max = burst;
+	comp->refreshes_tokens_interval = interval;
+	comp->refreshes_tokens = burst;
+	comp->refreshes_tokens_pkts = 0;
+
+	if(burst == 0)
+	{
+		rohc_info(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL, "rate of "
+		          "context periodic refreshes is not limited");
+	}
+	else
+	{
+		rohc_info(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL, "rate of "
+		          "context periodic refreshes limited to %zu refreshes in a "
+		          "row, then 1 refresh every %zu packets", burst, interval);
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
 /**
  * @brief Set the number of uncompressed transmissions for list compression
  *
@@ -1390,6 +1626,89 @@ bool rohc_comp_set_list_trans_nr(struct rohc_comp *const comp,
 }
 
 
+/**
+ * @brief Set the Bit Error Rate (BER) of the channel
+ *
+ * Set the estimated BER of the channel, expressed as the exponent of a power
+ * of ten: a value of 6 means a BER of 10^-6. The value 0 means that the BER
+ * is unknown.
+ *
+ * The compressor derives from the BER the number of repetitions of the
+ * optimistic approach: the minimal number of packets sent in the IR and FO
+ * states before transiting to the next state, and the minimal number of
+ * packets that transmit TS_STRIDE. A clean channel requires fewer
+ * repetitions than a lossy one. In U-mode, the BER is the only source of
+ * information about the channel. In O-mode, the number of repetitions is
+ * further adapted to the NACKs received from the decompressor.
+ *
+ * The BER is unknown by default and the compressor then repeats the packets
+ * \ref MAX_IR_COUNT times.
+ *
+ * @warning The value can not be modified after library initialization
+ *
+ * @param comp     The ROHC compressor
+ * @param ber_exp  The BER of the channel as a negative power of ten,
+ *                 0 if unknown
+ * @return         true if the new value is accepted,
+ *                 false if the value is rejected
+ *
+ * @ingroup rohc_comp
+ */
+bool rohc_comp_set_channel_ber(struct rohc_comp *const comp,
+                               const size_t ber_exp)
+{
+	size_t repetitions_nr;
+
+	if(comp == NULL)
+	{
+		return false;
+	}
+	if(ber_exp > 30)
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL, "invalid "
+		             "BER for the channel: 10^-%zu is too small", ber_exp);
+		return false;
+	}
+
+	/* refuse to set values if compressor is in use */
+	if(comp->num_packets > 0)
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "unable to modify the BER of the channel after "
+		             "initialization");
+		return false;
+	}
+
+	if(ber_exp == 0)
+	{
+		repetitions_nr = MAX_IR_COUNT;
+	}
+	else if(ber_exp <= ROHC_OA_PKT_BITS_LOG10)
+	{
+		repetitions_nr = ROHC_OA_REPETITIONS_MAX;
+	}
+	else
+	{
+		/* a packet of 10^PKT_BITS bits is lost with a probability of about
+		 * 10^-(BER - PKT_BITS), so n repetitions are all lost with a
+		 * probability of 10^-(n * (BER - PKT_BITS)) that shall not exceed
+		 * 10^-LOSS */
+		const size_t margin = ber_exp - ROHC_OA_PKT_BITS_LOG10;
+		repetitions_nr = (ROHC_OA_LOSS_LOG10 + margin - 1) / margin;
+	}
+	repetitions_nr = rohc_max(repetitions_nr, ROHC_OA_REPETITIONS_MIN);
+	repetitions_nr = rohc_min(repetitions_nr, ROHC_OA_REPETITIONS_MAX);
+
+	comp->oa_repetitions_nr = repetitions_nr;
+
+	rohc_info(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL, "BER of the "
+	          "channel set to 10^-%zu: %zu repetitions for the optimistic "
+	          "approach", ber_exp, repetitions_nr);
+
+	return true;
+}
+
+
 /**
  * @brief Set the RTP detection callback function
  *
@@ -1611,8 +1930,10 @@ bool rohc_comp_enable_profile(struct rohc_comp *const comp,
 		goto error;
 	}
 
-	/* mark the profile as enabled */
+	/* mark the profile as enabled, forget about the flows that no specific
+	 * profile accepted */
 	comp->enabled_profiles[profile_idx] = true;
+	memset(comp->profile_cache, 0, sizeof(comp->profile_cache));
 	rohc_info(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
 	          "ROHC compression profile (ID = 0x%04x) enabled", profile);
 
@@ -1665,8 +1986,10 @@ bool rohc_comp_disable_profile(struct rohc_comp *const comp,
 	}
 	profile_idx = ret;
 
-	/* mark the profile as disabled */
+	/* mark the profile as disabled, forget about the flows that no specific
+	 * profile accepted */
 	comp->enabled_profiles[profile_idx] = false;
+	memset(comp->profile_cache, 0, sizeof(comp->profile_cache));
 	rohc_info(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
 	          "ROHC compression profile (ID = 0x%04x) disabled", profile);
 
@@ -2044,7 +2367,11 @@ bool rohc_comp_set_features(struct rohc_comp *const comp,
 	const rohc_comp_features_t all_features =
 		ROHC_COMP_FEATURE_NO_IP_CHECKSUMS |
 		ROHC_COMP_FEATURE_DUMP_PACKETS |
-		ROHC_COMP_FEATURE_TIME_BASED_REFRESHES;
+		ROHC_COMP_FEATURE_TIME_BASED_REFRESHES |
+		ROHC_COMP_FEATURE_ACK_DRIVEN_WLSB |
+		ROHC_COMP_FEATURE_TCP_TS_UNCHANGED |
+		ROHC_COMP_FEATURE_UDP_OVERLAYS |
+		ROHC_COMP_FEATURE_SRH_UPDATES;
 
 	/* compressor must be valid */
 	if(comp == NULL)
@@ -2073,84 +2400,48 @@ error:
 
 
 /**
- * @brief Deliver a feedback packet to the compressor
+ * @brief Set the policy to select the context to recycle when all CIDs are used
  *
- * When feedback is received by the decompressor, this function is called and
- * delivers the feedback to the right profile/context of the compressor.
+ * When a new context is required but all the CIDs are already in use, the
+ * compressor recycles one existing context. The contexts with the lowest
+ * priority are recycled first (see \ref rohc_comp_set_ctxt_prio), the policy
+ * selects the context to recycle among the contexts with the same priority.
  *
- * @param comp   The ROHC compressor
- * @param packet The feedback data
- * @param size   The length of the feedback packet
- * @return       true if the feedback was successfully taken into account,
- *               false if the feedback could not be taken into account
+ * The policy is set to \ref ROHC_COMP_EVICTION_LRU by default. It may be
+ * changed at any time.
+ *
+ * @param comp    The ROHC compressor
+ * @param policy  The eviction policy
+ * @return        true if the policy was successfully set,
+ *                false if a problem occurred
+ *
+ * @ingroup rohc_comp
+ *
+ * @see rohc_comp_eviction_t
+ * @see rohc_comp_set_ctxt_prio
  */
-static bool __rohc_comp_deliver_feedback(struct rohc_comp *const comp,
-                                         const uint8_t *const packet,
-                                         const size_t size)
+bool rohc_comp_set_ctxt_eviction(struct rohc_comp *const comp,
+                                 const rohc_comp_eviction_t policy)
 {
-	struct rohc_comp_ctxt *context;
-	const uint8_t *remain_data = packet;
-	size_t remain_len = size;
-	enum rohc_feedback_type feedback_type;
-	rohc_cid_t cid;
-	size_t cid_len;
-
-	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-	           "deliver %zu byte(s) of feedback to the right context", size);
-
-	/* extract the CID from feedback */
-	if(!rohc_comp_feedback_parse_cid(comp, remain_data, remain_len, &cid, &cid_len))
-	{
-		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-		             "failed to deliver feedback: failed to extract CID from "
-		             "feedback");
-		goto error;
-	}
-	remain_data += cid_len;
-	remain_len -= cid_len;
-
-	/* find context */
-	context = c_get_context(comp, cid);
-	if(context == NULL)
+	/* compressor must be valid */
+	if(comp == NULL)
 	{
-		/* context was not found */
-		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-		             "failed to deliver feedback: context with CID = %zu not found",
-		             cid);
+		/* cannot print a trace without a valid compressor */
 		goto error;
 	}
-	assert(context->cid == cid);
-	assert(context->used == 1);
 
-	/* FEEDBACK-1 or FEEDBACK-2 ? */
-	if(remain_len == 0)
+	/* reject unsupported policies */
+	if(policy != ROHC_COMP_EVICTION_LRU && policy != ROHC_COMP_EVICTION_SLRU)
 	{
 		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-		             "failed to deliver feedback: empty feedback data");
+		             "context eviction policy %d is not supported", policy);
 		goto error;
 	}
-	else if(remain_len == 1)
-	{
-		feedback_type = ROHC_FEEDBACK_1;
-	}
-	else
-	{
-		feedback_type = ROHC_FEEDBACK_2;
-	}
 
-	/* deliver feedback to profile with the context */
-	if(!context->profile->feedback(context, feedback_type, packet, size,
-	                               remain_data, remain_len))
-	{
-		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-		             "failed to deliver feedback: failed to handle FEEDBACK-%d",
-		             feedback_type);
-		goto error;
-	}
+	comp->ctxt_eviction = policy;
 
-	/* everything went fine */
-	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-	           "FEEDBACK-%d data successfully handled", feedback_type);
+	rohc_info(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+	          "context eviction policy set to %d", policy);
 
 	return true;
 
@@ -2160,102 +2451,726 @@ error:
 
 
 /**
- * @brief Deliver a feedback packet to the compressor
+ * @brief Set the priority of the context with the given CID
  *
- * When feedback data is received by a decompressor, this function may be
- * called to deliver the feedback data to the corresponding profile/context
- * on the same-side associated compressor.
+ * When all the CIDs are in use, the contexts with the lowest priority are
+ * recycled first for new streams. Contexts with priority
+ * \ref ROHC_COMP_CTXT_PRIO_PINNED are not recycled as long as one context is
+ * not pinned.
  *
- * @param comp      The ROHC compressor
- * @param feedback  The feedback data
- * @return          true if the feedback was successfully taken into account,
- *                  false if the feedback could not be taken into account
+ * If all the contexts are pinned, the packets of new streams are compressed
+ * with the Uncompressed profile if it is enabled: they share the context of
+ * the Uncompressed profile if one exists. Otherwise, or if the Uncompressed
+ * profile is disabled, the pinned context selected by the eviction policy
+ * is recycled, so that new streams are always compressed.
+ *
+ * New contexts get the priority \ref ROHC_COMP_CTXT_PRIO_NORMAL. The CID of
+ * the context used to compress a packet is given by the
+ * \ref rohc_comp_get_last_packet_info2 function, so the priority of a stream
+ * may be set right after its first packet was compressed.
+ *
+ * @param comp  The ROHC compressor
+ * @param cid   The CID of the context
+ * @param prio  The new priority of the context
+ * @return      true if the priority was successfully set,
+ *              false if a problem occurred (eg. unused CID)
  *
  * @ingroup rohc_comp
+ *
+ * @see rohc_comp_ctxt_prio_t
+ * @see rohc_comp_set_ctxt_eviction
  */
-bool rohc_comp_deliver_feedback2(struct rohc_comp *const comp,
-                                 const struct rohc_buf feedback)
+bool rohc_comp_set_ctxt_prio(struct rohc_comp *const comp,
+                             const rohc_cid_t cid,
+                             const rohc_comp_ctxt_prio_t prio)
 {
-	struct rohc_buf remain_data = feedback;
-	size_t feedbacks_nr = 0;
-	size_t nr_failures = 0;
+	struct rohc_comp_ctxt *context;
 
-	/* sanity checks */
+	/* compressor must be valid */
 	if(comp == NULL)
 	{
+		/* cannot print a trace without a valid compressor */
 		goto error;
 	}
-	if(rohc_buf_is_malformed(remain_data))
+
+	/* reject unsupported priorities */
+	if(prio != ROHC_COMP_CTXT_PRIO_LOW &&
+	   prio != ROHC_COMP_CTXT_PRIO_NORMAL &&
+	   prio != ROHC_COMP_CTXT_PRIO_HIGH &&
+	   prio != ROHC_COMP_CTXT_PRIO_PINNED)
 	{
 		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-		             "failed to deliver feedback: feedback is malformed");
+		             "context priority %d is not supported", prio);
 		goto error;
 	}
 
-	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-	           "deliver %zu byte(s) of feedback to the right context",
-	           remain_data.len);
-
+	/* the context must be in use */
+	context = c_get_context(comp, cid);
+	if(context == NULL)
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "failed to set priority of context with CID %zu: context "
+		             "not found", cid);
+		goto error;
+	}
+
+	context->prio = prio;
+
+	rohc_comp_debug(context, "priority of context with CID %zu set to %d",
+	                cid, prio);
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Set the admission control of new contexts
+ *
+ * By default, every new flow immediately gets its own compression context.
+ * One- or two-packet flows (DNS, NTP...) then allocate contexts, send
+ * large IR packets and evict the contexts of useful flows.
+ *
+ * With admission control, a flow gets its own context only once it showed
+ * \e pkts_nr packets within one admission window of \e time_window
+ * milliseconds. Until then, its packets are compressed with the shared
+ * context of the Uncompressed profile. The packets of the flows are counted
+ * in a compact sketch, so a few flows may be admitted too early.
+ *
+ * The admission window also ends once
+ * \ref ROHC_COMP_ADMISSION_WINDOW_PKTS packets of flows without context
+ * were counted. The admission control thus keeps working if the application
+ * gives no arrival time to \ref rohc_compress4: the admission window is then
+ * counted in packets only.
+ *
+ * Admission control requires the Uncompressed profile to be enabled. It is
+ * disabled if \e pkts_nr is 1 (default).
+ *
+ * @param comp         The ROHC compressor
+ * @param pkts_nr      The number of packets a flow shall show during one
+ *                     admission window to get its own context, in range
+ *                     [1 ; \ref ROHC_COMP_ADMISSION_PKTS_MAX]
+ * @param time_window  The duration of the admission window (in milliseconds)
+ * @return             true if the admission control was successfully set,
+ *                     false if a problem occurred
+ *
+ * @ingroup rohc_comp
+ *
+ * @see rohc_comp_enable_profile
+ */
+bool rohc_comp_set_ctxt_admission(struct rohc_comp *const comp,
+                                  const size_t pkts_nr,
+                                  const uint64_t time_window)
+{
+	/* compressor must be valid */
+	if(comp == NULL)
+	{
+		/* cannot print a trace without a valid compressor */
+		goto error;
+	}
+
+	/* check the parameters */
+	if(pkts_nr < 1 || pkts_nr > ROHC_COMP_ADMISSION_PKTS_MAX)
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "invalid number of packets for context admission: %zu "
+		             "shall be in range [1 ; %u]", pkts_nr,
+		             ROHC_COMP_ADMISSION_PKTS_MAX);
+		goto error;
+	}
+	if(time_window == 0)
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "invalid admission window: shall not be zero");
+		goto error;
+	}
+
+	comp->admission_pkts_nr = pkts_nr;
+	comp->admission_time = time_window;
+
+	/* start a new admission window */
+	comp->admission_start.sec = 0;
+	comp->admission_start.nsec = 0;
+	comp->admission_window_pkts = 0;
+	memset(comp->admission_sketch, 0, sizeof(comp->admission_sketch));
+
+	rohc_info(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+	          "new flows get a context after %zu packets within %" PRIu64
+	          " ms", pkts_nr, time_window);
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Deliver a feedback packet to the compressor
+ *
+ * When feedback is received by the decompressor, this function is called and
+ * delivers the feedback to the right profile/context of the compressor.
+ *
+ * @param comp   The ROHC compressor
+ * @param packet The feedback data
+ * @param size   The length of the feedback packet
+ * @return       true if the feedback was successfully taken into account,
+ *               false if the feedback could not be taken into account
+ */
+static bool __rohc_comp_deliver_feedback(struct rohc_comp *const comp,
+                                         const uint8_t *const packet,
+                                         const size_t size)
+{
+	struct rohc_comp_ctxt *context;
+	const uint8_t *remain_data = packet;
+	size_t remain_len = size;
+	enum rohc_feedback_type feedback_type;
+	rohc_cid_t cid;
+	size_t cid_len;
+
+	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+	           "deliver %zu byte(s) of feedback to the right context", size);
+
+	/* extract the CID from feedback */
+	if(!rohc_comp_feedback_parse_cid(comp, remain_data, remain_len, &cid, &cid_len))
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "failed to deliver feedback: failed to extract CID from "
+		             "feedback");
+		goto error;
+	}
+	remain_data += cid_len;
+	remain_len -= cid_len;
+
+	/* find context */
+	context = c_get_context(comp, cid);
+	if(context == NULL)
+	{
+		/* context was not found */
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "failed to deliver feedback: context with CID = %zu not found",
+		             cid);
+		goto error;
+	}
+	assert(context->cid == cid);
+	assert(context->used == 1);
+
+	/* FEEDBACK-1 or FEEDBACK-2 ? */
+	if(remain_len == 0)
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "failed to deliver feedback: empty feedback data");
+		goto error;
+	}
+	else if(remain_len == 1)
+	{
+		feedback_type = ROHC_FEEDBACK_1;
+	}
+	else
+	{
+		feedback_type = ROHC_FEEDBACK_2;
+	}
+
+	/* deliver feedback to profile with the context */
+	if(!context->profile->feedback(context, feedback_type, packet, size,
+	                               remain_data, remain_len))
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "failed to deliver feedback: failed to handle FEEDBACK-%d",
+		             feedback_type);
+		goto error;
+	}
+
+	/* adapt the repetitions of the optimistic approach to the feedback */
+	rohc_comp_oa_repetitions_adapt(context, feedback_type == ROHC_FEEDBACK_1 ?
+	                               ROHC_FEEDBACK_ACK : (remain_data[0] >> 6));
+
+	/* everything went fine */
+	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+	           "FEEDBACK-%d data successfully handled", feedback_type);
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Deliver a feedback packet to the compressor
+ *
+ * When feedback data is received by a decompressor, this function may be
+ * called to deliver the feedback data to the corresponding profile/context
+ * on the same-side associated compressor.
+ *
+ * @param comp      The ROHC compressor
+ * @param feedback  The feedback data
+ * @return          true if the feedback was successfully taken into account,
+ *                  false if the feedback could not be taken into account
+ *
+ * @ingroup rohc_comp
+ */
+bool rohc_comp_deliver_feedback2(struct rohc_comp *const comp,
+                                 const struct rohc_buf feedback)
+{
+	struct rohc_buf remain_data = feedback;
+	size_t feedbacks_nr = 0;
+	size_t nr_failures = 0;
+
+	/* sanity checks */
+	if(comp == NULL)
+	{
+		goto error;
+	}
+	if(rohc_buf_is_malformed(remain_data))
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "failed to deliver feedback: feedback is malformed");
+		goto error;
+	}
+
+	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+	           "deliver %zu byte(s) of feedback to the right context",
+	           remain_data.len);
+
 	/* there is nothing for compressor if feedback contains no byte at all */
 	if(rohc_buf_is_empty(remain_data))
 	{
 		goto ignore;
 	}
 
-	/* parse as much feedback data as possible */
-	while(remain_data.len > 0 &&
-	      rohc_packet_is_feedback(rohc_buf_byte(remain_data)))
+	/* parse as much feedback data as possible */
+	while(remain_data.len > 0 &&
+	      rohc_packet_is_feedback(rohc_buf_byte(remain_data)))
+	{
+		size_t feedback_hdr_len;
+		size_t feedback_data_len;
+		size_t feedback_len;
+
+		feedbacks_nr++;
+
+		if(!rohc_feedback_get_size(remain_data, &feedback_hdr_len,
+		                           &feedback_data_len))
+		{
+			rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+			             "failed to parse a feedback item");
+			goto error;
+		}
+		feedback_len = feedback_hdr_len + feedback_data_len;
+		rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		           "feedback found (header = %zu bytes, data = %zu bytes)",
+		           feedback_hdr_len, feedback_data_len);
+
+		/* reject feedback item if it doesn't fit in the available data */
+		if(feedback_len > remain_data.len)
+		{
+			rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+			             "the %zu-byte feedback is too large for the %zu-byte "
+			             "remaining ROHC data", feedback_len, remain_data.len);
+			goto error;
+		}
+
+		/* skip the feedback header */
+		rohc_buf_pull(&remain_data, feedback_hdr_len);
+
+		/* deliver the feedback data to the compressor */
+		if(!__rohc_comp_deliver_feedback(comp, rohc_buf_data(remain_data),
+		                                 feedback_data_len))
+		{
+			rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+			             "failed to deliver feedback item #%zu", feedbacks_nr);
+			nr_failures++;
+		}
+
+		/* skip the feedback data */
+		rohc_buf_pull(&remain_data, feedback_data_len);
+	}
+
+	return (nr_failures == 0);
+
+ignore:
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Set how the feedback items of the local decompressor are piggybacked
+ *
+ * On a bidirectional link, the feedback items that the local decompressor
+ * generates for the remote compressor may be queued in the local compressor
+ * with \ref rohc_comp_piggyback_feedback. They are then automatically
+ * piggybacked on the next ROHC packets built by \ref rohc_compress4, so
+ * that they do not need their own frames on the link.
+ *
+ * At most \e max_pkt_len bytes of feedback items are piggybacked on one
+ * ROHC packet. Feedback items are never split. The feedback items that
+ * waited for \e max_delay milliseconds or more are returned by
+ * \ref rohc_comp_flush_feedbacks in a feedback-only ROHC packet, so that
+ * they are not delayed too much if no packet is compressed.
+ *
+ * By default, all the queued feedback items are piggybacked on the next ROHC
+ * packet, and they are flushed as soon as \ref rohc_comp_flush_feedbacks is
+ * called.
+ *
+ * @param comp         The ROHC compressor
+ * @param max_pkt_len  The maximal length (in bytes) of the feedback items
+ *                     piggybacked on one ROHC packet, 0 to only send
+ *                     them in feedback-only packets
+ * @param max_delay    The delay (in milliseconds) after which the queued
+ *                     feedback items are flushed
+ * @return             true in case of success, false in case of failure
+ *
+ * @ingroup rohc_comp
+ *
+ * @see rohc_comp_piggyback_feedback
+ * @see rohc_comp_flush_feedbacks
+ */
+bool rohc_comp_set_piggybacking(struct rohc_comp *const comp,
+                                const size_t max_pkt_len,
+                                const uint64_t max_delay)
+{
+	/* compressor must be valid */
+	if(comp == NULL)
+	{
+		/* cannot print a trace without a valid compressor */
+		goto error;
+	}
+
+	comp->feedbacks_max_pkt_len = max_pkt_len;
+	comp->feedbacks_max_delay = max_delay;
+
+	rohc_info(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL, "piggyback up "
+	          "to %zu bytes of feedback per ROHC packet, flush feedback after "
+	          "%" PRIu64 " ms", max_pkt_len, max_delay);
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Queue feedback items of the local decompressor for piggybacking
+ *
+ * The feedback data shall be made of complete feedback items, as the
+ * \e feedback_send buffer returned by \ref rohc_decompress3 is. The time
+ * of the feedback buffer is the time the feedback items are queued at.
+ *
+ * The queued feedback items are piggybacked on the next ROHC packets built by
+ * \ref rohc_compress4, or returned by \ref rohc_comp_flush_feedbacks.
+ *
+ * @param comp      The ROHC compressor
+ * @param feedback  The feedback items to send to the remote compressor
+ * @return          true if the feedback items were queued,
+ *                  false if they are malformed or if the queue is full
+ *
+ * @ingroup rohc_comp
+ *
+ * @see rohc_comp_set_piggybacking
+ * @see rohc_comp_flush_feedbacks
+ */
+bool rohc_comp_piggyback_feedback(struct rohc_comp *const comp,
+                                  const struct rohc_buf feedback)
+{
+	struct rohc_comp_feedbacks_buf *last_buf = NULL;
+	struct rohc_buf remain_data = feedback;
+
+	/* sanity checks */
+	if(comp == NULL)
+	{
+		goto error;
+	}
+	if(rohc_buf_is_malformed(feedback))
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "failed to queue feedback: feedback is malformed");
+		goto error;
+	}
+
+	/* nothing to queue if feedback contains no byte at all */
+	if(rohc_buf_is_empty(feedback))
+	{
+		goto ignore;
+	}
+
+	/* the feedback data shall be made of complete feedback items, so that the
+	 * queued feedback items may be piggybacked one by one */
+	while(remain_data.len > 0)
+	{
+		size_t feedback_hdr_len;
+		size_t feedback_data_len;
+
+		if(!rohc_packet_is_feedback(rohc_buf_byte(remain_data)) ||
+		   !rohc_feedback_get_size(remain_data, &feedback_hdr_len,
+		                           &feedback_data_len) ||
+		   (feedback_hdr_len + feedback_data_len) > remain_data.len)
+		{
+			rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+			             "failed to queue feedback: feedback is not made of "
+			             "complete feedback items");
+			goto error;
+		}
+		rohc_buf_pull(&remain_data, feedback_hdr_len + feedback_data_len);
+	}
+
+	if(feedback.len > (ROHC_COMP_FEEDBACKS_MAX_LEN - comp->feedbacks_len))
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "failed to queue feedback: the %zu-byte feedback does not "
+		             "fit in the %zu bytes left in queue", feedback.len,
+		             ROHC_COMP_FEEDBACKS_MAX_LEN - comp->feedbacks_len);
+		goto error;
+	}
+
+	/* remember the time of every queued feedback buffer, so that the time of
+	 * the oldest feedback item still queued is known once the first ones are
+	 * sent; the buffers queued at the same time share one record */
+	if(comp->feedbacks_bufs_nr > 0)
+	{
+		last_buf = &(comp->feedbacks_bufs[comp->feedbacks_bufs_nr - 1]);
+	}
+	if(last_buf != NULL && last_buf->time.sec == feedback.time.sec &&
+	   last_buf->time.nsec == feedback.time.nsec)
+	{
+		last_buf->len += feedback.len;
+	}
+	else if(comp->feedbacks_bufs_nr < ROHC_COMP_FEEDBACKS_MAX_NR)
+	{
+		comp->feedbacks_bufs[comp->feedbacks_bufs_nr].len = feedback.len;
+		comp->feedbacks_bufs[comp->feedbacks_bufs_nr].time = feedback.time;
+		comp->feedbacks_bufs_nr++;
+	}
+	else
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "failed to queue feedback: %u feedback buffers are "
+		             "already queued", ROHC_COMP_FEEDBACKS_MAX_NR);
+		goto error;
+	}
+	memcpy(comp->feedbacks + comp->feedbacks_len, rohc_buf_data(feedback),
+	       feedback.len);
+	comp->feedbacks_len += feedback.len;
+
+	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+	           "%zu byte(s) of feedback queued for piggybacking, %zu byte(s) "
+	           "in queue", feedback.len, comp->feedbacks_len);
+
+ignore:
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Flush the feedback items that waited too long for piggybacking
+ *
+ * If the oldest queued feedback item waited for the delay set with
+ * \ref rohc_comp_set_piggybacking or more, the queued feedback items are
+ * returned in a feedback-only ROHC packet, as many as the given buffer may
+ * contain. Otherwise, the returned ROHC packet is empty.
+ *
+ * The function shall be called periodically if the local compressor may not
+ * compress packets for a while.
+ *
+ * @param comp              The ROHC compressor
+ * @param time              The current time
+ * @param[out] rohc_packet  The feedback-only ROHC packet, empty if there is
+ *                          no feedback item to flush yet
+ * @return                  true in case of success, false in case of failure
+ *
+ * @ingroup rohc_comp
+ *
+ * @see rohc_comp_set_piggybacking
+ * @see rohc_comp_piggyback_feedback
+ */
+bool rohc_comp_flush_feedbacks(struct rohc_comp *const comp,
+                               const struct rohc_ts time,
+                               struct rohc_buf *const rohc_packet)
+{
+	size_t feedbacks_len;
+
+	/* sanity checks */
+	if(comp == NULL)
+	{
+		goto error;
+	}
+	if(rohc_packet == NULL)
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "given rohc_packet is NULL");
+		goto error;
+	}
+	if(rohc_buf_is_malformed(*rohc_packet))
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "given rohc_packet is malformed");
+		goto error;
+	}
+	if(!rohc_buf_is_empty(*rohc_packet))
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "given rohc_packet is not empty");
+		goto error;
+	}
+
+	/* no feedback to flush yet? */
+	if(comp->feedbacks_len == 0 ||
+	   rohc_time_interval(comp->feedbacks_bufs[0].time, time) <
+	   comp->feedbacks_max_delay * 1000U)
+	{
+		goto ignore;
+	}
+
+	feedbacks_len = rohc_comp_feedbacks_fit(comp, rohc_buf_avail_len(*rohc_packet));
+	if(feedbacks_len == 0)
+	{
+		rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		             "the %zu-byte output buffer is too small for the first "
+		             "feedback item", rohc_buf_avail_len(*rohc_packet));
+		goto error;
+	}
+	rohc_buf_append(rohc_packet, comp->feedbacks, feedbacks_len);
+	rohc_comp_feedbacks_remove(comp, feedbacks_len);
+
+	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+	           "%zu byte(s) of feedback flushed, %zu byte(s) left in queue",
+	           feedbacks_len, comp->feedbacks_len);
+
+ignore:
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Get the length of the first queued feedback items that fit
+ *
+ * @param comp     The ROHC compressor
+ * @param max_len  The maximal length (in bytes) of the feedback items
+ * @return         The length of the first complete feedback items that fit
+ *                 in \e max_len bytes
+ */
+static size_t rohc_comp_feedbacks_fit(struct rohc_comp *const comp,
+                                      const size_t max_len)
+{
+	struct rohc_buf feedbacks =
+		rohc_buf_init_full(comp->feedbacks, comp->feedbacks_len,
+		                   comp->feedbacks_bufs[0].time);
+	size_t fit_len = 0;
+
+	while(feedbacks.len > 0)
 	{
 		size_t feedback_hdr_len;
 		size_t feedback_data_len;
 		size_t feedback_len;
 
-		feedbacks_nr++;
-
-		if(!rohc_feedback_get_size(remain_data, &feedback_hdr_len,
+		/* feedback items were checked when they were queued */
+		if(!rohc_feedback_get_size(feedbacks, &feedback_hdr_len,
 		                           &feedback_data_len))
 		{
-			rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-			             "failed to parse a feedback item");
-			goto error;
+			assert(0);
+			break;
 		}
 		feedback_len = feedback_hdr_len + feedback_data_len;
-		rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-		           "feedback found (header = %zu bytes, data = %zu bytes)",
-		           feedback_hdr_len, feedback_data_len);
-
-		/* reject feedback item if it doesn't fit in the available data */
-		if(feedback_len > remain_data.len)
+		if((fit_len + feedback_len) > max_len)
 		{
-			rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-			             "the %zu-byte feedback is too large for the %zu-byte "
-			             "remaining ROHC data", feedback_len, remain_data.len);
-			goto error;
+			break;
 		}
+		fit_len += feedback_len;
+		rohc_buf_pull(&feedbacks, feedback_len);
+	}
 
-		/* skip the feedback header */
-		rohc_buf_pull(&remain_data, feedback_hdr_len);
+	return fit_len;
+}
 
-		/* deliver the feedback data to the compressor */
-		if(!__rohc_comp_deliver_feedback(comp, rohc_buf_data(remain_data),
-		                                 feedback_data_len))
-		{
-			rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-			             "failed to deliver feedback item #%zu", feedbacks_nr);
-			nr_failures++;
-		}
 
-		/* skip the feedback data */
-		rohc_buf_pull(&remain_data, feedback_data_len);
+/**
+ * @brief Piggyback the queued feedback items on the given ROHC packet
+ *
+ * The ROHC packet is moved towards the end of the output buffer, so the
+ * bytes before the ROHC packet that the application may use are kept intact.
+ *
+ * @param comp                 The ROHC compressor
+ * @param[in,out] rohc_packet  The ROHC packet to piggyback feedback on
+ */
+static void rohc_comp_feedbacks_piggyback(struct rohc_comp *const comp,
+                                          struct rohc_buf *const rohc_packet)
+{
+	const size_t avail_len = rohc_buf_avail_len(*rohc_packet);
+	const size_t max_len = rohc_min(avail_len, comp->feedbacks_max_pkt_len);
+	const size_t feedbacks_len = rohc_comp_feedbacks_fit(comp, max_len);
+
+	if(feedbacks_len == 0)
+	{
+		rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		           "no room left for the %zu queued byte(s) of feedback",
+		           comp->feedbacks_len);
+		return;
 	}
 
-	return (nr_failures == 0);
+	memmove(rohc_buf_data_at(*rohc_packet, feedbacks_len),
+	        rohc_buf_data(*rohc_packet), rohc_packet->len);
+	memcpy(rohc_buf_data(*rohc_packet), comp->feedbacks, feedbacks_len);
+	rohc_packet->len += feedbacks_len;
+	rohc_comp_feedbacks_remove(comp, feedbacks_len);
 
-ignore:
-	return true;
+	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+	           "%zu byte(s) of feedback piggybacked, %zu byte(s) left in queue",
+	           feedbacks_len, comp->feedbacks_len);
+}
 
-error:
-	return false;
+
+/**
+ * @brief Remove the first queued feedback items once they were sent
+ *
+ * The feedback buffers that were entirely sent are forgotten, so that the
+ * flush delay then runs from the time of the oldest feedback item still
+ * queued.
+ *
+ * @param comp  The ROHC compressor
+ * @param len   The length (in bytes) of the feedback items to remove
+ */
+static void rohc_comp_feedbacks_remove(struct rohc_comp *const comp,
+                                       const size_t len)
+{
+	size_t remain_len = len;
+	size_t bufs_nr = 0;
+
+	assert(len <= comp->feedbacks_len);
+	memmove(comp->feedbacks, comp->feedbacks + len, comp->feedbacks_len - len);
+	comp->feedbacks_len -= len;
+
+	/* forget the feedback buffers that were entirely sent */
+	while(bufs_nr < comp->feedbacks_bufs_nr &&
+	      comp->feedbacks_bufs[bufs_nr].len <= remain_len)
+	{
+		remain_len -= comp->feedbacks_bufs[bufs_nr].len;
+		bufs_nr++;
+	}
+	memmove(comp->feedbacks_bufs, comp->feedbacks_bufs + bufs_nr,
+	        (comp->feedbacks_bufs_nr - bufs_nr) *
+	        sizeof(struct rohc_comp_feedbacks_buf));
+	comp->feedbacks_bufs_nr -= bufs_nr;
+	if(comp->feedbacks_bufs_nr > 0)
+	{
+		assert(remain_len < comp->feedbacks_bufs[0].len);
+		comp->feedbacks_bufs[0].len -= remain_len;
+	}
+	else
+	{
+		assert(remain_len == 0);
+		assert(comp->feedbacks_len == 0);
+	}
 }
 
 
@@ -2268,6 +3183,7 @@ error:
  * \ref rohc_comp_last_packet_info2_t structure with the \e version_major and
  * \e version_minor fields set to one of the following supported versions:
  *  - Major 0, minor 0
+ *  - Major 0, minor 1
  *
  * See the \ref rohc_comp_last_packet_info2_t structure for details about
  * fields that are supported in the above versions.
@@ -2319,7 +3235,11 @@ bool rohc_comp_get_last_packet_info2(const struct rohc_comp *const comp,
 		info->header_last_comp_size = comp->last_context->header_last_compressed_size;
 
 		/* new fields added by minor versions */
-		if(info->version_minor > 0)
+		if(info->version_minor >= 1)
+		{
+			info->context_wlsb_width = comp->last_context->wlsb_window_width;
+		}
+		if(info->version_minor > 1)
 		{
 			rohc_error(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
 			           "unsupported minor version (%u) of the structure for "
@@ -2477,19 +3397,65 @@ static const struct rohc_comp_profile *
 }
 
 
+/**
+ * @brief Whether the given profile is used for packets no specific profile
+ *        accepts
+ *
+ * @param profile_id  The ID of the profile
+ * @return            true for the IP-only and Uncompressed profiles,
+ *                    false otherwise
+ */
+static bool rohc_comp_profile_is_fallback(const rohc_profile_t profile_id)
+{
+	return (profile_id == ROHC_PROFILE_IP ||
+	        profile_id == ROHCv2_PROFILE_IP ||
+	        profile_id == ROHC_PROFILE_UNCOMPRESSED);
+}
+
+
 /**
  * @brief Find out a ROHC profile given an IP protocol ID
  *
+ * The flows that no specific profile accepts (IP fragments, unsupported
+ * extension headers...) are remembered in a small cache, so that their next
+ * packets are given to the IP-only or Uncompressed profile without asking
+ * every specific profile again. All the profiles are checked again after
+ * \ref ROHC_COMP_PROFILE_CACHE_HITS_MAX packets.
+ *
  * @param comp    The ROHC compressor
  * @param packet  The packet to find a compression profile for
  * @return        The ROHC profile if found, NULL otherwise
  */
 static const struct rohc_comp_profile *
-	c_get_profile_from_packet(const struct rohc_comp *const comp,
+	c_get_profile_from_packet(struct rohc_comp *const comp,
 	                          const struct net_pkt *const packet)
 {
+	const size_t cache_idx = packet->key % ROHC_COMP_PROFILE_CACHE_SIZE;
+	size_t rejected_nr = 0;
 	size_t i;
 
+	/* was the flow rejected by all the specific profiles recently? */
+	if(comp->profile_cache[cache_idx].used &&
+	   comp->profile_cache[cache_idx].key == packet->key &&
+	   comp->profile_cache[cache_idx].hits_nr < ROHC_COMP_PROFILE_CACHE_HITS_MAX)
+	{
+		const uint8_t profile_idx = comp->profile_cache[cache_idx].profile_idx;
+		const struct rohc_comp_profile *const profile =
+			rohc_comp_profiles[profile_idx];
+
+		if(comp->enabled_profiles[profile_idx] &&
+		   profile->check_profile(comp, packet))
+		{
+			rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+			           "flow with key 0x%08x was rejected by all specific "
+			           "profiles, use profile '%s' (0x%04x)", packet->key,
+			           rohc_get_profile_descr(profile->id), profile->id);
+			comp->profile_cache[cache_idx].hits_nr++;
+			return profile;
+		}
+		comp->profile_cache[cache_idx].used = false;
+	}
+
 	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
 	           "try to find the best profile for packet with transport "
 	           "protocol %u", packet->transport->proto);
@@ -2517,9 +3483,20 @@ static const struct rohc_comp_profile *
 			           "skip profile '%s' (0x%04x) because it does not match "
 			           "packet",rohc_get_profile_descr(rohc_comp_profiles[i]->id),
 			           rohc_comp_profiles[i]->id);
+			rejected_nr++;
 			continue;
 		}
 
+		/* remember the flows that all the specific profiles rejected */
+		if(rejected_nr > 0 &&
+		   rohc_comp_profile_is_fallback(rohc_comp_profiles[i]->id))
+		{
+			comp->profile_cache[cache_idx].used = true;
+			comp->profile_cache[cache_idx].profile_idx = i;
+			comp->profile_cache[cache_idx].hits_nr = 0;
+			comp->profile_cache[cache_idx].key = packet->key;
+		}
+
 		/* the packet is compatible with the profile, let's go with it! */
 		return rohc_comp_profiles[i];
 	}
@@ -2554,32 +3531,45 @@ static struct rohc_comp_ctxt *
 	cid_to_use = 0;
 
 	/* if all the contexts in the array are used:
-	 *   => recycle the oldest context to make room
+	 *   => recycle the context selected by the eviction policy to make room
 	 * if at least one context in the array is not used:
 	 *   => pick the first unused context
 	 */
 	if(comp->num_contexts_used > comp->medium.max_cid)
 	{
-		/* all the contexts in the array were used, recycle the oldest context
-		 * to make some room */
+		/* all the contexts in the array were used, recycle one context to make
+		 * some room */
 
-		uint64_t oldest;
+		const struct rohc_comp_ctxt *evicted_ctxt = NULL;
 		rohc_cid_t i;
 
-		/* find the oldest context */
-		oldest = 0xffffffff;
+		/* find the context to recycle, pinned contexts are recycled only if
+		 * all the contexts are pinned */
 		for(i = 0; i <= comp->medium.max_cid; i++)
 		{
-			if(comp->contexts[i].latest_used < oldest)
+			const struct rohc_comp_ctxt *const ctxt = &(comp->contexts[i]);
+
+			if(evicted_ctxt == NULL || c_ctxt_evict_first(comp, ctxt, evicted_ctxt))
 			{
-				oldest = comp->contexts[i].latest_used;
+				evicted_ctxt = ctxt;
 				cid_to_use = i;
 			}
 		}
+		assert(evicted_ctxt != NULL);
+		if(evicted_ctxt->prio == ROHC_COMP_CTXT_PRIO_PINNED)
+		{
+			rohc_warning(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+			             "all the %zu contexts are pinned, recycle the pinned "
+			             "context with CID %zu for the new stream",
+			             comp->medium.max_cid + 1, cid_to_use);
+		}
 
-		/* destroy the oldest context before replacing it with a new one */
+		/* destroy the context before replacing it with a new one */
 		rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-		           "recycle oldest context (CID = %zu)", cid_to_use);
+		           "recycle context (CID = %zu) with priority %d and %d packets "
+		           "sent, last used at use #%" PRIu64, cid_to_use,
+		           evicted_ctxt->prio, evicted_ctxt->num_sent_packets,
+		           evicted_ctxt->last_use_nr);
 		comp->contexts[cid_to_use].profile->destroy(&comp->contexts[cid_to_use]);
 		comp->contexts[cid_to_use].used = 0;
 		assert(comp->num_contexts_used > 0);
@@ -2634,6 +3624,7 @@ static struct rohc_comp_ctxt *
 	c->go_back_fo_time = arrival_time;
 	c->go_back_ir_count = 0;
 	c->go_back_ir_time = arrival_time;
+	c->refresh_jitter = rohc_comp_draw_refresh_jitter(comp);
 
 	c->total_uncompressed_size = 0;
 	c->total_compressed_size = 0;
@@ -2646,9 +3637,26 @@ static struct rohc_comp_ctxt *
 	c->header_last_compressed_size = 0;
 
 	c->num_sent_packets = 0;
+	c->prio = ROHC_COMP_CTXT_PRIO_NORMAL;
+
+	/* the W-LSB windows of a replicated context are copied from the base
+	 * context, so is their width */
+	if(!c->do_ctxt_replication)
+	{
+		c->wlsb_window_width = comp->wlsb_window_width;
+	}
+	c->wlsb_acks_nr = 0;
+	c->wlsb_in_order_nr = 0;
+	c->is_wlsb_sn_max_init = false;
+	c->wlsb_sn_max = 0;
+	c->oa_repetitions_nr = comp->oa_repetitions_nr;
+	c->oa_acks_nr = 0;
+	c->static_chain_len = 0;
 
 	c->cid = cid_to_use;
 	c->profile = profile;
+	c->key = packet->key;
+	c->addrs_key = packet->addrs_key;
 
 	c->mode = ROHC_U_MODE;
 
@@ -2659,38 +3667,304 @@ static struct rohc_comp_ctxt *
 	}
 	else
 	{
-		c->state = ROHC_COMP_STATE_IR;
+		c->state = ROHC_COMP_STATE_IR;
+	}
+
+	c->compressor = comp;
+
+	/* create profile-specific context */
+	if(c->do_ctxt_replication)
+	{
+		if(!profile->clone(c, &(comp->contexts[cid_for_replication])))
+		{
+			return NULL;
+		}
+	}
+	else
+	{
+		if(!profile->create(c, packet))
+		{
+			return NULL;
+		}
+	}
+
+	/* if creation is successful, mark the context as used */
+	c->used = 1;
+	c->first_used = arrival_time.sec;
+	c->latest_used = arrival_time.sec;
+	comp->ctxt_uses_nr++;
+	c->last_use_nr = comp->ctxt_uses_nr;
+	assert(comp->num_contexts_used <= comp->medium.max_cid);
+	comp->num_contexts_used++;
+
+	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+	           "context (CID = %zu) created at %" PRIu64 " seconds (num_used = %zu)",
+	           c->cid, c->latest_used, comp->num_contexts_used);
+	return c;
+}
+
+
+/**
+ * @brief Whether all the contexts are in use and pinned
+ *
+ * @param comp  The ROHC compressor
+ * @return      true if all the contexts are in use and pinned,
+ *              false otherwise
+ */
+static bool c_are_all_ctxts_pinned(const struct rohc_comp *const comp)
+{
+	rohc_cid_t i;
+
+	if(comp->num_contexts_used <= comp->medium.max_cid)
+	{
+		return false;
+	}
+
+	for(i = 0; i <= comp->medium.max_cid; i++)
+	{
+		if(comp->contexts[i].prio != ROHC_COMP_CTXT_PRIO_PINNED)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Whether a context shall be recycled before another one
+ *
+ * The context with the lowest priority is recycled first. Among contexts
+ * with the same priority, the eviction policy of the compressor decides:
+ *  \li \ref ROHC_COMP_EVICTION_LRU recycles the least recently used context,
+ *  \li \ref ROHC_COMP_EVICTION_SLRU recycles the contexts that compressed
+ *      less than \ref ROHC_COMP_SLRU_PROTECTED_PKTS packets first, then the
+ *      least recently used context.
+ *
+ * @param comp   The ROHC compressor
+ * @param ctxt1  The first context to compare
+ * @param ctxt2  The second context to compare
+ * @return       true if ctxt1 shall be recycled before ctxt2,
+ *               false otherwise
+ */
+static bool c_ctxt_evict_first(const struct rohc_comp *const comp,
+                               const struct rohc_comp_ctxt *const ctxt1,
+                               const struct rohc_comp_ctxt *const ctxt2)
+{
+	if(ctxt1->prio != ctxt2->prio)
+	{
+		return (ctxt1->prio < ctxt2->prio);
+	}
+
+	if(comp->ctxt_eviction == ROHC_COMP_EVICTION_SLRU)
+	{
+		const bool is_ctxt1_protected =
+			(ctxt1->num_sent_packets >= ROHC_COMP_SLRU_PROTECTED_PKTS);
+		const bool is_ctxt2_protected =
+			(ctxt2->num_sent_packets >= ROHC_COMP_SLRU_PROTECTED_PKTS);
+
+		if(is_ctxt1_protected != is_ctxt2_protected)
+		{
+			return is_ctxt2_protected;
+		}
+	}
+
+	return (ctxt1->last_use_nr < ctxt2->last_use_nr);
+}
+
+
+/**
+ * @brief Whether the flow of the given packet may get its own context
+ *
+ * The packets of the flows without context are counted in a count-min
+ * sketch indexed by the flow key. The sketch is reset at the beginning of
+ * every admission window. A flow is admitted once it showed the configured
+ * number of packets during one admission window.
+ *
+ * The admission window ends after its duration or after
+ * \ref ROHC_COMP_ADMISSION_WINDOW_PKTS packets, whatever comes first. The
+ * sketch is thus reset even if the arrival times of packets are all zero,
+ * and its 8-bit counters do not stay saturated forever.
+ *
+ * @param comp          The ROHC compressor
+ * @param packet        The packet of the flow without context
+ * @param arrival_time  The time at which packet was received
+ * @return              true if the flow is admitted, false otherwise
+ */
+static bool c_ctxt_admit(struct rohc_comp *const comp,
+                         const struct net_pkt *const packet,
+                         const struct rohc_ts arrival_time)
+{
+	const size_t cols_nr = (1U << ROHC_COMP_ADMISSION_BITS);
+	size_t cols[ROHC_COMP_ADMISSION_ROWS];
+	uint8_t count = UINT8_MAX;
+	size_t row;
+
+	/* context admission disabled */
+	if(comp->admission_pkts_nr <= 1)
+	{
+		return true;
+	}
+
+	/* start a new admission window if the current one is over */
+	if(rohc_time_interval(comp->admission_start, arrival_time) >=
+	   comp->admission_time * 1000U ||
+	   comp->admission_window_pkts >= ROHC_COMP_ADMISSION_WINDOW_PKTS)
+	{
+		memset(comp->admission_sketch, 0, sizeof(comp->admission_sketch));
+		comp->admission_start = arrival_time;
+		comp->admission_window_pkts = 0;
+	}
+	comp->admission_window_pkts++;
+
+	/* one column per row, computed from different bits of the flow key */
+	cols[0] = packet->key & (cols_nr - 1);
+	cols[1] = (packet->key * 2654435761U) >> (32 - ROHC_COMP_ADMISSION_BITS);
+
+	/* conservative update: only increment the smallest counters */
+	for(row = 0; row < ROHC_COMP_ADMISSION_ROWS; row++)
+	{
+		if(comp->admission_sketch[row][cols[row]] < count)
+		{
+			count = comp->admission_sketch[row][cols[row]];
+		}
+	}
+	if(count < UINT8_MAX)
+	{
+		count++;
+	}
+	for(row = 0; row < ROHC_COMP_ADMISSION_ROWS; row++)
+	{
+		if(comp->admission_sketch[row][cols[row]] < count)
+		{
+			comp->admission_sketch[row][cols[row]] = count;
+		}
+	}
+	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+	           "flow with key 0x%08x showed %u/%zu packets during the "
+	           "admission window", packet->key, count, comp->admission_pkts_nr);
+
+	return (count >= comp->admission_pkts_nr);
+}
+
+
+/**
+ * @brief Whether the given context is an established base context for the
+ *        given IP addresses
+ *
+ * A context is a base context for Context Replication while it is in use for
+ * the same IP addresses and while it is established with the decompressor,
+ * ie. its static part was acknowledged through feedback.
+ *
+ * @param comp       The ROHC compressor
+ * @param cid        The CID of the context to check
+ * @param addrs_key  The key of the IP addresses
+ * @return           true if the context is a base context for the IP
+ *                   addresses, false otherwise
+ */
+static bool c_is_cr_base_ctxt(const struct rohc_comp *const comp,
+                              const rohc_cid_t cid,
+                              const rohc_ctxt_key_t addrs_key)
+{
+	const struct rohc_comp_ctxt *ctxt;
+
+	if(cid > comp->medium.max_cid)
+	{
+		return false;
+	}
+	ctxt = &(comp->contexts[cid]);
+
+	return (ctxt->used &&
+	        ctxt->addrs_key == addrs_key &&
+	        ctxt->mode > ROHC_U_MODE &&
+	        (ctxt->state == ROHC_COMP_STATE_FO ||
+	         ctxt->state == ROHC_COMP_STATE_SO));
+}
+
+
+/**
+ * @brief Record the given context as base context for Context Replication
+ *
+ * The entry of the index that the IP addresses of the context hash to is
+ * updated if it is free, if it already records the same IP addresses, or if
+ * its context is no longer a base context. The base context of other IP
+ * addresses that collide on the same entry is not replaced.
+ *
+ * @param comp     The ROHC compressor
+ * @param context  The established context to record
+ */
+static void c_set_cr_base_ctxt(struct rohc_comp *const comp,
+                               const struct rohc_comp_ctxt *const context)
+{
+	struct rohc_comp_cr_entry *const cr_entry =
+		&(comp->cr_index[context->addrs_key % (comp->medium.max_cid + 1)]);
+
+	if(cr_entry->addrs_key != context->addrs_key &&
+	   c_is_cr_base_ctxt(comp, cr_entry->cid, cr_entry->addrs_key))
+	{
+		rohc_comp_debug(context, "context CID %zu is not recorded as base for "
+		                "Context Replication: context CID %zu is the base for "
+		                "other IP addresses", context->cid, cr_entry->cid);
+		return;
+	}
+	cr_entry->addrs_key = context->addrs_key;
+	cr_entry->cid = context->cid;
+}
+
+
+/**
+ * @brief Find the base context for Context Replication for the given packet
+ *
+ * The index of base contexts stores the key of the IP addresses and the CID
+ * of one established context per entry, so the base context is found without
+ * scanning all the contexts. The entry is used only if it was recorded for
+ * the key of the IP addresses of the packet, and if its context is still
+ * established for these IP addresses (see \ref c_is_cr_base_ctxt) with the
+ * same profile. The profile then compares the IP addresses themselves before
+ * it accepts the context as base context.
+ *
+ * @param comp           The ROHC compressor
+ * @param profile        The profile selected for the packet
+ * @param packet         The packet that needs a new context
+ * @param[out] base_cid  The CID of the base context if any
+ * @return               true if a base context was found, false otherwise
+ */
+static bool c_get_cr_base_ctxt(const struct rohc_comp *const comp,
+                               const struct rohc_comp_profile *const profile,
+                               const struct net_pkt *const packet,
+                               rohc_cid_t *const base_cid)
+{
+	const struct rohc_comp_cr_entry *const cr_entry =
+		&(comp->cr_index[packet->addrs_key % (comp->medium.max_cid + 1)]);
+	const rohc_cid_t cid = cr_entry->cid;
+	const struct rohc_comp_ctxt *base_ctxt;
+	size_t cr_score = 0;
+
+	if(cr_entry->addrs_key != packet->addrs_key ||
+	   !c_is_cr_base_ctxt(comp, cid, packet->addrs_key))
+	{
+		goto not_found;
 	}
+	base_ctxt = &(comp->contexts[cid]);
 
-	c->compressor = comp;
-
-	/* create profile-specific context */
-	if(c->do_ctxt_replication)
+	if(base_ctxt->profile->id != profile->id)
 	{
-		if(!profile->clone(c, &(comp->contexts[cid_for_replication])))
-		{
-			return NULL;
-		}
+		goto not_found;
 	}
-	else
+	if(base_ctxt->profile->check_context(base_ctxt, packet, &cr_score) ||
+	   cr_score == 0)
 	{
-		if(!profile->create(c, packet))
-		{
-			return NULL;
-		}
+		goto not_found;
 	}
 
-	/* if creation is successful, mark the context as used */
-	c->used = 1;
-	c->first_used = arrival_time.sec;
-	c->latest_used = arrival_time.sec;
-	assert(comp->num_contexts_used <= comp->medium.max_cid);
-	comp->num_contexts_used++;
+	rohc_comp_debug(base_ctxt, "context CID %zu scores %zu for Context "
+	                "Replication", base_ctxt->cid, cr_score);
+	*base_cid = cid;
+	return true;
 
-	rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-	           "context (CID = %zu) created at %" PRIu64 " seconds (num_used = %zu)",
-	           c->cid, c->latest_used, comp->num_contexts_used);
-	return c;
+not_found:
+	return false;
 }
 
 
@@ -2749,9 +4023,19 @@ static struct rohc_comp_ctxt *
 		bool is_ctxt_established;
 		size_t cr_score = 0;
 
+		/* if all used contexts were checked, no need go search further */
+		if(num_used_ctxt_seen >= comp->num_contexts_used)
+		{
+			rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+			           "no context was found");
+			context = NULL;
+			break;
+		}
+
 		context = &comp->contexts[i];
 
-		/* don't even look at unused contexts */
+		/* don't even look at unused contexts, count the used ones before they
+		 * are skipped for their profile or their key */
 		if(!context->used)
 		{
 			continue;
@@ -2764,6 +4048,14 @@ static struct rohc_comp_ctxt *
 			continue;
 		}
 
+		/* the packets that match a context of a specific profile share the key
+		 * of the flow the context was created for */
+		if(!rohc_comp_profile_is_fallback(profile->id) &&
+		   context->key != packet->key)
+		{
+			continue;
+		}
+
 		rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
 		           "check context CID = %zu with same profile", context->cid);
 
@@ -2833,18 +4125,45 @@ static struct rohc_comp_ctxt *
 			rohc_comp_debug(context, "context CID %zu is best for Context Replication",
 			                context->cid);
 		}
+	}
+	if(context == NULL || i > comp->medium.max_cid)
+	{
+		/* context not found: short-lived flows are not worth a context of their
+		 * own, so compress them with the Uncompressed profile until they show
+		 * enough packets */
+		if(profile->id != ROHC_PROFILE_UNCOMPRESSED &&
+		   rohc_comp_profile_enabled(comp, ROHC_PROFILE_UNCOMPRESSED) &&
+		   !c_ctxt_admit(comp, packet, arrival_time))
+		{
+			rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+			           "flow with key 0x%08x not admitted yet, use the "
+			           "Uncompressed profile", packet->key);
+			return rohc_comp_find_ctxt(comp, packet, ROHC_PROFILE_UNCOMPRESSED,
+			                           arrival_time);
+		}
 
-		/* if all used contexts were checked, no need go search further */
-		if(num_used_ctxt_seen >= comp->num_contexts_used)
+		/* all the contexts are pinned: compress the flow with the Uncompressed
+		 * profile, so that an existing Uncompressed context is used rather than
+		 * a pinned context recycled */
+		if(profile->id != ROHC_PROFILE_UNCOMPRESSED &&
+		   rohc_comp_profile_enabled(comp, ROHC_PROFILE_UNCOMPRESSED) &&
+		   c_are_all_ctxts_pinned(comp))
 		{
 			rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
-			           "no context was found");
-			context = NULL;
-			break;
+			           "all the contexts are pinned, use the Uncompressed "
+			           "profile for flow with key 0x%08x", packet->key);
+			return rohc_comp_find_ctxt(comp, packet, ROHC_PROFILE_UNCOMPRESSED,
+			                           arrival_time);
 		}
-	}
-	if(context == NULL || i > comp->medium.max_cid)
-	{
+
+		/* the base context for Context Replication is the last established
+		 * context with the same IP addresses */
+		if(!do_ctxt_replication)
+		{
+			do_ctxt_replication =
+				c_get_cr_base_ctxt(comp, profile, packet, &best_ctxt_for_replication);
+		}
+
 		/* context not found, create a new one */
 		rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
 		           "no existing context found for packet, create a new one");
@@ -2859,8 +4178,16 @@ static struct rohc_comp_ctxt *
 	}
 	else
 	{
-		/* matching context found, update use timestamp */
+		/* matching context found, update use timestamp and LRU order */
 		context->latest_used = arrival_time.sec;
+		comp->ctxt_uses_nr++;
+		context->last_use_nr = comp->ctxt_uses_nr;
+
+		/* remember the established contexts as base for Context Replication */
+		if(c_is_cr_base_ctxt(comp, context->cid, context->addrs_key))
+		{
+			c_set_cr_base_ctxt(comp, context);
+		}
 		rohc_debug(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
 		           "context (CID = %zu) used at %" PRIu64 " seconds",
 		           context->cid, context->latest_used);
@@ -2910,9 +4237,12 @@ not_found:
  */
 static bool c_create_contexts(struct rohc_comp *const comp)
 {
+	rohc_cid_t i;
+
 	assert(comp->contexts == NULL);
 
 	comp->num_contexts_used = 0;
+	comp->ctxt_uses_nr = 0;
 
 	rohc_info(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
 	          "create enough room for %zu contexts (MAX_CID = %zu)",
@@ -2927,8 +4257,26 @@ static bool c_create_contexts(struct rohc_comp *const comp)
 		goto error;
 	}
 
+	/* no base context for Context Replication yet */
+	comp->cr_index = calloc(comp->medium.max_cid + 1,
+	                        sizeof(struct rohc_comp_cr_entry));
+	if(comp->cr_index == NULL)
+	{
+		rohc_error(comp, ROHC_TRACE_COMP, ROHC_PROFILE_GENERAL,
+		           "cannot allocate memory for the index of base contexts");
+		goto free_contexts;
+	}
+	for(i = 0; i <= comp->medium.max_cid; i++)
+	{
+		comp->cr_index[i].addrs_key = 0;
+		comp->cr_index[i].cid = ROHC_LARGE_CID_MAX + 1;
+	}
+
 	return true;
 
+free_contexts:
+	free(comp->contexts);
+	comp->contexts = NULL;
 error:
 	return false;
 }
@@ -2963,6 +4311,8 @@ static void c_destroy_contexts(struct rohc_comp *const comp)
 	}
 	assert(comp->num_contexts_used == 0);
 
+	free(comp->cr_index);
+	comp->cr_index = NULL;
 	free(comp->contexts);
 	comp->contexts = NULL;
 }
@@ -3033,58 +4383,95 @@ void rohc_comp_change_state(struct rohc_comp_ctxt *const context,
  * @brief Periodically change the context state after a certain number
  *        of packets.
  *
+ * The timeouts of the periodic refreshes are shortened by the jitter of the
+ * context, and the periodic refreshes of all the contexts are rate-limited
+ * by the token bucket of the compressor.
+ *
  * @param context   The compression context
  * @param pkt_time  The time of packet arrival
+ *
+ * @see rohc_comp_set_periodic_refreshes_jitter
+ * @see rohc_comp_set_refreshes_rate
  */
 void rohc_comp_periodic_down_transition(struct rohc_comp_ctxt *const context,
                                         const struct rohc_ts pkt_time)
 {
+	struct rohc_comp *const comp = context->compressor;
+	const uint64_t ir_timeout_pkts =
+		rohc_comp_refresh_timeout(context, comp->periodic_refreshes_ir_timeout_pkts);
+	const uint64_t ir_timeout_time =
+		rohc_comp_refresh_timeout(context, comp->periodic_refreshes_ir_timeout_time);
+	const uint64_t fo_timeout_pkts =
+		rohc_comp_refresh_timeout(context, comp->periodic_refreshes_fo_timeout_pkts);
+	const uint64_t fo_timeout_time =
+		rohc_comp_refresh_timeout(context, comp->periodic_refreshes_fo_timeout_time);
+	rohc_comp_state_t refresh_state;
 	rohc_comp_state_t next_state;
 
-	rohc_debug(context->compressor, ROHC_TRACE_COMP, context->profile->id,
-	           "CID %zu: timeouts for periodic refreshes: FO = %zu / %zu, "
-	           "IR = %zu / %zu", context->cid, context->go_back_fo_count,
-	           context->compressor->periodic_refreshes_fo_timeout_pkts,
-	           context->go_back_ir_count,
-	           context->compressor->periodic_refreshes_ir_timeout_pkts);
+	rohc_debug(comp, ROHC_TRACE_COMP, context->profile->id,
+	           "CID %zu: timeouts for periodic refreshes: FO = %zu / %" PRIu64
+	           ", IR = %zu / %" PRIu64, context->cid, context->go_back_fo_count,
+	           fo_timeout_pkts, context->go_back_ir_count, ir_timeout_pkts);
 
-	if(context->go_back_ir_count >=
-	   context->compressor->periodic_refreshes_ir_timeout_pkts)
+	if(context->go_back_ir_count >= ir_timeout_pkts)
 	{
-		rohc_info(context->compressor, ROHC_TRACE_COMP, context->profile->id,
+		rohc_info(comp, ROHC_TRACE_COMP, context->profile->id,
 		          "CID %zu: periodic change to IR state", context->cid);
-		context->go_back_ir_count = 0;
-		next_state = ROHC_COMP_STATE_IR;
+		refresh_state = ROHC_COMP_STATE_IR;
 	}
-	else if((context->compressor->features & ROHC_COMP_FEATURE_TIME_BASED_REFRESHES) != 0 &&
+	else if((comp->features & ROHC_COMP_FEATURE_TIME_BASED_REFRESHES) != 0 &&
 	        rohc_time_interval(context->go_back_ir_time, pkt_time) >=
-	        context->compressor->periodic_refreshes_ir_timeout_time * 1000U)
+	        ir_timeout_time * 1000U)
 	{
 		const uint64_t interval_since_ir_refresh =
 			rohc_time_interval(context->go_back_ir_time, pkt_time);
-		rohc_info(context->compressor, ROHC_TRACE_COMP, context->profile->id,
+		rohc_info(comp, ROHC_TRACE_COMP, context->profile->id,
 		          "CID %zu: force IR refresh since %" PRIu64 " us elapsed since "
 		          "last IR packet", context->cid, interval_since_ir_refresh);
-		context->go_back_ir_count = 0;
-		next_state = ROHC_COMP_STATE_IR;
+		refresh_state = ROHC_COMP_STATE_IR;
 	}
-	else if(context->go_back_fo_count >=
-	        context->compressor->periodic_refreshes_fo_timeout_pkts)
+	else if(context->go_back_fo_count >= fo_timeout_pkts)
 	{
-		rohc_info(context->compressor, ROHC_TRACE_COMP, context->profile->id,
+		rohc_info(comp, ROHC_TRACE_COMP, context->profile->id,
 		          "CID %zu: periodic change to FO state", context->cid);
-		context->go_back_fo_count = 0;
-		next_state = ROHC_COMP_STATE_FO;
+		refresh_state = ROHC_COMP_STATE_FO;
 	}
-	else if((context->compressor->features & ROHC_COMP_FEATURE_TIME_BASED_REFRESHES) != 0 &&
+	else if((comp->features & ROHC_COMP_FEATURE_TIME_BASED_REFRESHES) != 0 &&
 	        rohc_time_interval(context->go_back_fo_time, pkt_time) >=
-	        context->compressor->periodic_refreshes_fo_timeout_time * 1000U)
+	        fo_timeout_time * 1000U)
 	{
 		const uint64_t interval_since_fo_refresh =
 			rohc_time_interval(context->go_back_fo_time, pkt_time);
-		rohc_info(context->compressor, ROHC_TRACE_COMP, context->profile->id,
+		rohc_info(comp, ROHC_TRACE_COMP, context->profile->id,
 		          "CID %zu: force FO refresh since %" PRIu64 " us elapsed since "
 		          "last FO packet", context->cid, interval_since_fo_refresh);
+		refresh_state = ROHC_COMP_STATE_FO;
+	}
+	else
+	{
+		refresh_state = ROHC_COMP_STATE_UNKNOWN;
+	}
+
+	/* a periodic refresh that changes the state takes one token, if the rate
+	 * of refreshes is limited; without token, the refresh is postponed to one
+	 * of the next packets */
+	if(refresh_state != ROHC_COMP_STATE_UNKNOWN &&
+	   refresh_state != context->state &&
+	   !rohc_comp_refresh_take_token(comp))
+	{
+		rohc_debug(comp, ROHC_TRACE_COMP, context->profile->id,
+		           "CID %zu: periodic refresh postponed because of the rate "
+		           "limit", context->cid);
+		next_state = context->state;
+	}
+	else if(refresh_state == ROHC_COMP_STATE_IR)
+	{
+		context->go_back_ir_count = 0;
+		context->refresh_jitter = rohc_comp_draw_refresh_jitter(comp);
+		next_state = ROHC_COMP_STATE_IR;
+	}
+	else if(refresh_state == ROHC_COMP_STATE_FO)
+	{
 		context->go_back_fo_count = 0;
 		next_state = ROHC_COMP_STATE_FO;
 	}
@@ -3128,10 +4515,358 @@ bool rohc_comp_reinit_context(struct rohc_comp_ctxt *const context)
 	rohc_comp_change_mode(context, ROHC_U_MODE);
 	rohc_comp_change_state(context, ROHC_COMP_STATE_IR);
 
+	/* contexts re-initialized together shall not refresh together */
+	context->refresh_jitter = rohc_comp_draw_refresh_jitter(context->compressor);
+
+	return true;
+}
+
+
+/**
+ * @brief Draw the jitter of the timeouts of periodic refreshes for one context
+ *
+ * @param comp  The ROHC compressor
+ * @return      The jitter (in percent) in range [0 ; jitter of compressor]
+ */
+static size_t rohc_comp_draw_refresh_jitter(const struct rohc_comp *const comp)
+{
+	/* do not consume random numbers if jitter is disabled */
+	if(comp->periodic_refreshes_jitter == 0)
+	{
+		return 0;
+	}
+
+	return ((unsigned int) comp->random_cb(comp, comp->random_cb_ctxt)) %
+	       (comp->periodic_refreshes_jitter + 1);
+}
+
+
+/**
+ * @brief Shorten one timeout of periodic refreshes by the jitter of context
+ *
+ * @param context  The compression context
+ * @param timeout  The timeout configured for the compressor
+ * @return         The timeout for the context, never zero
+ */
+static uint64_t rohc_comp_refresh_timeout(const struct rohc_comp_ctxt *const context,
+                                          const uint64_t timeout)
+{
+	const uint64_t jitter = (timeout * context->refresh_jitter) / 100U;
+
+	return (jitter < timeout ? timeout - jitter : 1);
+}
+
+
+/**
+ * @brief Take one token for a periodic refresh
+ *
+ * @param comp  The ROHC compressor
+ * @return      true if the periodic refresh may be done,
+ *              false if it shall be postponed
+ */
+static bool rohc_comp_refresh_take_token(struct rohc_comp *const comp)
+{
+	/* rate of periodic refreshes is not limited */
+	if(comp->refreshes_tokens_max == 0)
+	{
+		return true;
+	}
+
+	if(comp->refreshes_tokens == 0)
+	{
+		return false;
+	}
+	comp->refreshes_tokens--;
+
+	return true;
+}
+
+
+/**
+ * @brief Copy the static chain cached in the given context in an IR packet
+ *
+ * @param context         The compression context
+ * @param[out] rohc_data  The ROHC packet being built
+ * @param rohc_max_len    The max remaining length in the ROHC buffer
+ * @return                The length of the static chain copied in the ROHC
+ *                        buffer, 0 if no static chain is cached or if the
+ *                        ROHC buffer is too small for it
+ */
+size_t rohc_comp_static_chain_reuse(const struct rohc_comp_ctxt *const context,
+                                    uint8_t *const rohc_data,
+                                    const size_t rohc_max_len)
+{
+	if(context->static_chain_len == 0 ||
+	   context->static_chain_len > rohc_max_len)
+	{
+		return 0;
+	}
+
+	memcpy(rohc_data, context->static_chain, context->static_chain_len);
+	rohc_comp_debug(context, "reuse the %zu-byte static chain cached in context",
+	                context->static_chain_len);
+
+	return context->static_chain_len;
+}
+
+
+/**
+ * @brief Cache the static chain just encoded for the given context
+ *
+ * The static chains longer than \ref ROHC_COMP_STATIC_CHAIN_MAX_LEN are not
+ * cached.
+ *
+ * @param context           The compression context
+ * @param static_chain      The static chain encoded in the IR packet
+ * @param static_chain_len  The length of the static chain
+ */
+void rohc_comp_static_chain_cache(struct rohc_comp_ctxt *const context,
+                                  const uint8_t *const static_chain,
+                                  const size_t static_chain_len)
+{
+	if(static_chain_len > ROHC_COMP_STATIC_CHAIN_MAX_LEN)
+	{
+		context->static_chain_len = 0;
+	}
+	else
+	{
+		memcpy(context->static_chain, static_chain, static_chain_len);
+		context->static_chain_len = static_chain_len;
+	}
+}
+
+
+/**
+ * @brief Adapt the repetitions of the optimistic approach of the given context
+ *
+ * The number of repetitions is adapted to the feedback received from the
+ * decompressor in O-mode:
+ *  \li a NACK or STATIC-NACK increases the number of repetitions by one
+ *      since the channel lost some of the packets,
+ *  \li enough consecutive positive ACKs reduce it by one.
+ *
+ * The number of repetitions is never adapted in U-mode where it only depends
+ * on the BER configured for the compressor, nor in R-mode where the
+ * compressor does not rely on the optimistic approach.
+ *
+ * @param context   The compression context
+ * @param ack_type  The type of the feedback received for the context
+ */
+static void rohc_comp_oa_repetitions_adapt(struct rohc_comp_ctxt *const context,
+                                           const enum rohc_feedback_ack_type ack_type)
+{
+	size_t new_nr = context->oa_repetitions_nr;
+
+	if(context->mode != ROHC_O_MODE)
+	{
+		return;
+	}
+
+	if(ack_type == ROHC_FEEDBACK_ACK)
+	{
+		context->oa_acks_nr++;
+		if(context->oa_acks_nr >= ROHC_OA_REPETITIONS_ACKS_NR &&
+		   new_nr > ROHC_OA_REPETITIONS_MIN)
+		{
+			new_nr--;
+		}
+	}
+	else if(ack_type == ROHC_FEEDBACK_NACK ||
+	        ack_type == ROHC_FEEDBACK_STATIC_NACK)
+	{
+		new_nr = rohc_min(new_nr + 1, ROHC_OA_REPETITIONS_MAX);
+		context->oa_acks_nr = 0;
+	}
+
+	if(new_nr == context->oa_repetitions_nr)
+	{
+		return;
+	}
+
+	rohc_comp_debug(context, "repetitions of the optimistic approach: %zu -> %zu",
+	                context->oa_repetitions_nr, new_nr);
+	context->oa_repetitions_nr = new_nr;
+	context->oa_acks_nr = 0;
+}
+
+
+/**
+ * @brief Adapt the width of the W-LSB windows of the given context
+ *
+ * The width is adapted to the feedback received from the decompressor:
+ *  \li a NACK or STATIC-NACK doubles the width (up to the width configured
+ *      for the compressor) since the current references are not robust
+ *      enough against packet losses,
+ *  \li a positive ACK raises the width if it does not cover all the packets
+ *      not acknowledged yet, or reduces it by one entry once enough
+ *      consecutive ACKs were received.
+ *
+ * The width is not adapted to losses in U-mode: without feedback, the
+ * compressor cannot detect them, see \ref rohc_comp_wlsb_width_reorder for
+ * the adaptation to reordering in U-mode.
+ *
+ * The caller shall resize all the W-LSB windows of the context if the width
+ * changed.
+ *
+ * @param context     The compression context
+ * @param ack_type    The type of the feedback received for the context
+ * @param unacked_nr  The number of packets not acknowledged yet by the
+ *                    decompressor (only for positive ACKs)
+ * @return            true if the width changed, false otherwise
+ */
+bool rohc_comp_wlsb_width_adapt(struct rohc_comp_ctxt *const context,
+                                const enum rohc_feedback_ack_type ack_type,
+                                const size_t unacked_nr)
+{
+	const size_t width_max = context->compressor->wlsb_window_width;
+	const size_t width_min = rohc_min(ROHC_WLSB_WIDTH_MIN, width_max);
+	size_t new_width = context->wlsb_window_width;
+
+	if(context->mode == ROHC_U_MODE)
+	{
+		return false;
+	}
+
+	if(ack_type == ROHC_FEEDBACK_ACK)
+	{
+		/* the window shall contain the references that the decompressor may
+		 * use: the acknowledged one and the ones not acknowledged yet */
+		const size_t width_floor =
+			rohc_max(width_min, rohc_min(unacked_nr + 1, width_max));
+
+		context->wlsb_acks_nr++;
+		if(new_width < width_floor)
+		{
+			new_width = width_floor;
+		}
+		else if(new_width > width_floor &&
+		        context->wlsb_acks_nr >= ROHC_WLSB_WIDTH_ACKS_NR)
+		{
+			new_width--;
+		}
+	}
+	else /* NACK or STATIC-NACK */
+	{
+		new_width = rohc_min(new_width * 2, width_max);
+		context->wlsb_acks_nr = 0;
+	}
+
+	if(new_width == context->wlsb_window_width)
+	{
+		return false;
+	}
+
+	rohc_comp_debug(context, "W-LSB window width: %zu -> %zu (%zu packets not "
+	                "acknowledged yet)", context->wlsb_window_width, new_width,
+	                unacked_nr);
+	context->wlsb_window_width = new_width;
+	context->wlsb_acks_nr = 0;
+
+	return true;
+}
+
+
+/**
+ * @brief Adapt the width of the W-LSB windows of the given context to the
+ *        reordering of the packets given to the compressor
+ *
+ * Without feedback, the compressor knows nothing about the losses on the
+ * channel, so the width configured for the compressor is kept as the minimal
+ * width. The SN of some profiles (eg. the RTP or ESP sequence numbers) is
+ * however copied from the packets: a packet reordered before the compressor
+ * will be received out of order by the decompressor too, and it will become
+ * the reference of the decompressor for the next packets. The width is thus
+ * raised by the reordering depth observed, then reduced by one entry every
+ * \ref ROHC_WLSB_WIDTH_PKTS_NR packets received in order.
+ *
+ * The width is adapted in U-mode only, see \ref rohc_comp_wlsb_width_adapt
+ * for the O- and R-modes.
+ *
+ * The caller shall resize all the W-LSB windows of the context if the width
+ * changed.
+ *
+ * @param context  The compression context
+ * @param sn       The SN of the packet given to the compressor
+ * @param sn_mask  The mask for the SN (16-bit or 32-bit SN)
+ * @return         true if the width changed, false otherwise
+ */
+bool rohc_comp_wlsb_width_reorder(struct rohc_comp_ctxt *const context,
+                                  const uint32_t sn,
+                                  const uint32_t sn_mask)
+{
+	const size_t width_min = context->compressor->wlsb_window_width;
+	const uint32_t depth = (context->wlsb_sn_max - sn) & sn_mask;
+	size_t new_width = context->wlsb_window_width;
+
+	if(context->mode != ROHC_U_MODE)
+	{
+		return false;
+	}
+
+	if(!context->is_wlsb_sn_max_init || depth > (sn_mask >> 1))
+	{
+		/* first SN or SN greater than all the previous ones */
+		context->wlsb_sn_max = sn;
+		context->is_wlsb_sn_max_init = true;
+		context->wlsb_in_order_nr++;
+		if(new_width > width_min &&
+		   context->wlsb_in_order_nr >= ROHC_WLSB_WIDTH_PKTS_NR)
+		{
+			new_width--;
+		}
+	}
+	else if(depth > 0)
+	{
+		/* SN smaller than a previous one: the windows shall keep the references
+		 * of the packets sent after the reordered one */
+		context->wlsb_in_order_nr = 0;
+		if(depth < (ROHC_WLSB_WIDTH_MAX - width_min))
+		{
+			new_width = rohc_max(new_width, width_min + depth);
+		}
+		else
+		{
+			new_width = ROHC_WLSB_WIDTH_MAX;
+		}
+	}
+
+	if(new_width == context->wlsb_window_width)
+	{
+		return false;
+	}
+
+	rohc_comp_debug(context, "W-LSB window width: %zu -> %zu (SN %u received "
+	                "after SN %u)", context->wlsb_window_width, new_width, sn,
+	                context->wlsb_sn_max);
+	context->wlsb_window_width = new_width;
+	context->wlsb_in_order_nr = 0;
+
 	return true;
 }
 
 
+/**
+ * @brief Whether the positive ACKs shall drive the W-LSB windows of the context
+ *
+ * The W-LSB windows are always ACK-driven in R-mode. In O-mode, they are
+ * ACK-driven only if the \ref ROHC_COMP_FEATURE_ACK_DRIVEN_WLSB feature is
+ * enabled. The windows then keep all the references not acknowledged yet and
+ * shrink on every positive ACK.
+ *
+ * @param context  The compression context
+ * @return         true if the W-LSB windows are ACK-driven, false otherwise
+ */
+bool rohc_comp_wlsb_is_ack_driven(const struct rohc_comp_ctxt *const context)
+{
+	/* the R-mode case is unreachable for the moment: rohc_comp_change_mode()
+	 * refuses the transitions to R-mode as long as R-mode is not supported,
+	 * so only the O-mode case drives the W-LSB windows with ACKs */
+	return (context->mode == ROHC_R_MODE ||
+	        (context->mode == ROHC_O_MODE &&
+	         (context->compressor->features & ROHC_COMP_FEATURE_ACK_DRIVEN_WLSB) != 0));
+}
+
+
 /**
  * @brief Parse ROHC feedback CID
  *
@@ -126,6 +126,7 @@ typedef enum
  *    is_context_init, context_mode, context_state, context_used, profile_id,
  *    packet_type, total_last_uncomp_size, header_last_uncomp_size,
  *    total_last_comp_size, and header_last_comp_size
+ *  - Major 0 / Minor 1 adds: context_wlsb_width
  *
  * @ingroup rohc_comp
  *
@@ -159,6 +160,9 @@ typedef struct
 	unsigned long total_last_comp_size;
 	/** The compressed size (in bytes) of the last compressed header */
 	unsigned long header_last_comp_size;
+	/** The width of the W-LSB windows currently used by the last context
+	 *  (adapted to the feedback received from the decompressor) */
+	unsigned long context_wlsb_width;
 } __attribute__((packed)) rohc_comp_last_packet_info2_t;
 
 
@@ -235,10 +239,77 @@ typedef enum
 	ROHC_COMP_FEATURE_DUMP_PACKETS    = (1 << 3),
 	/** Allow periodic refreshes based on inter-packet time */
 	ROHC_COMP_FEATURE_TIME_BASED_REFRESHES = (1 << 4),
+	/** Let the positive ACKs drive the width of the W-LSB windows once the
+	 *  feedback channel is established (for reliable feedback channels) */
+	ROHC_COMP_FEATURE_ACK_DRIVEN_WLSB = (1 << 5),
+	/** Encode unchanged TCP timestamps with the 1-byte and 2-byte forms
+	 *  (non-standard, the decompressor shall enable
+	 *  \ref ROHC_DECOMP_FEATURE_TCP_TS_UNCHANGED too) */
+	ROHC_COMP_FEATURE_TCP_TS_UNCHANGED = (1 << 6),
+	/** Compress the VXLAN/Geneve and inner Ethernet headers of the ROHCv2
+	 *  IP/UDP flows as static chain elements (non-standard, the decompressor
+	 *  shall enable \ref ROHC_DECOMP_FEATURE_UDP_OVERLAYS too) */
+	ROHC_COMP_FEATURE_UDP_OVERLAYS = (1 << 7),
+	/** Update the Segment Routing Headers of the IPv6 extension lists without
+	 *  their unchanged segment lists (non-standard, the decompressor shall
+	 *  enable \ref ROHC_DECOMP_FEATURE_SRH_UPDATES too) */
+	ROHC_COMP_FEATURE_SRH_UPDATES = (1 << 8),
 
 } rohc_comp_features_t;
 
 
+/**
+ * @brief The policies to select the context to recycle when all CIDs are used
+ *
+ * When a new context is required but all the CIDs are already in use, the
+ * ROHC compressor recycles one of the existing contexts. Contexts with a
+ * lower priority are always recycled first, and pinned contexts are never
+ * recycled (see \ref rohc_comp_set_ctxt_prio). The policy selects the context
+ * to recycle among the contexts of same priority.
+ *
+ * The policy is set with the function \ref rohc_comp_set_ctxt_eviction.
+ *
+ * @ingroup rohc_comp
+ *
+ * @see rohc_comp_set_ctxt_eviction
+ */
+typedef enum
+{
+	/** Recycle the least recently used context (default) */
+	ROHC_COMP_EVICTION_LRU  = 0,
+	/** Recycle the least recently used context, but recycle the contexts that
+	 *  compressed only a few packets before the well-established ones, so that
+	 *  a burst of short flows cannot evict the long-lived flows */
+	ROHC_COMP_EVICTION_SLRU = 1,
+
+} rohc_comp_eviction_t;
+
+
+/**
+ * @brief The priorities of the compression contexts
+ *
+ * When all the CIDs are in use, the contexts with the lowest priority are
+ * recycled first. The priority of a context is set with the function
+ * \ref rohc_comp_set_ctxt_prio.
+ *
+ * @ingroup rohc_comp
+ *
+ * @see rohc_comp_set_ctxt_prio
+ */
+typedef enum
+{
+	/** The context is recycled before the other ones */
+	ROHC_COMP_CTXT_PRIO_LOW    = 0,
+	/** The default priority of new contexts */
+	ROHC_COMP_CTXT_PRIO_NORMAL = 1,
+	/** The context is recycled after the other ones */
+	ROHC_COMP_CTXT_PRIO_HIGH   = 2,
+	/** The context is recycled only if all the contexts are pinned */
+	ROHC_COMP_CTXT_PRIO_PINNED = 3,
+
+} rohc_comp_ctxt_prio_t;
+
+
 /**
  * @brief The prototype of the RTP detection callback
  *
@@ -372,10 +443,38 @@ bool ROHC_EXPORT rohc_comp_set_features(struct rohc_comp *const comp,
                                         const rohc_comp_features_t features)
 	__attribute__((warn_unused_result));
 
+bool ROHC_EXPORT rohc_comp_set_ctxt_eviction(struct rohc_comp *const comp,
+                                             const rohc_comp_eviction_t policy)
+	__attribute__((warn_unused_result));
+
+bool ROHC_EXPORT rohc_comp_set_ctxt_prio(struct rohc_comp *const comp,
+                                         const rohc_cid_t cid,
+                                         const rohc_comp_ctxt_prio_t prio)
+	__attribute__((warn_unused_result));
+
+bool ROHC_EXPORT rohc_comp_set_ctxt_admission(struct rohc_comp *const comp,
+                                              const size_t pkts_nr,
+                                              const uint64_t time_window)
+	__attribute__((warn_unused_result));
+
 bool ROHC_EXPORT rohc_comp_deliver_feedback2(struct rohc_comp *const comp,
                                              const struct rohc_buf feedback)
 	__attribute__((warn_unused_result));
 
+bool ROHC_EXPORT rohc_comp_set_piggybacking(struct rohc_comp *const comp,
+                                            const size_t max_pkt_len,
+                                            const uint64_t max_delay)
+	__attribute__((warn_unused_result));
+
+bool ROHC_EXPORT rohc_comp_piggyback_feedback(struct rohc_comp *const comp,
+                                              const struct rohc_buf feedback)
+	__attribute__((warn_unused_result));
+
+bool ROHC_EXPORT rohc_comp_flush_feedbacks(struct rohc_comp *const comp,
+                                           const struct rohc_ts time,
+                                           struct rohc_buf *const rohc_packet)
+	__attribute__((warn_unused_result));
+
 
 /*
  * Prototypes of public functions that configure robustness to packet
@@ -400,10 +499,23 @@ bool ROHC_EXPORT rohc_comp_set_periodic_refreshes_time(struct rohc_comp *const c
                                                        const uint64_t fo_timeout)
 	__attribute__((warn_unused_result));
 
+bool ROHC_EXPORT rohc_comp_set_periodic_refreshes_jitter(struct rohc_comp *const comp,
+                                                         const size_t jitter)
+	__attribute__((warn_unused_result));
+
+bool ROHC_EXPORT rohc_comp_set_refreshes_rate(struct rohc_comp *const comp,
+                                              const size_t burst,
+                                              const size_t interval)
+	__attribute__((warn_unused_result));
+
 bool ROHC_EXPORT rohc_comp_set_list_trans_nr(struct rohc_comp *const comp,
                                              const size_t list_trans_nr)
 	__attribute__((warn_unused_result));
 
+bool ROHC_EXPORT rohc_comp_set_channel_ber(struct rohc_comp *const comp,
+                                           const size_t ber_exp)
+	__attribute__((warn_unused_result));
+
 
 /*
  * Prototypes of public functions related to ROHC compression statistics
@@ -77,6 +77,84 @@
  *  state before being able to switch to the SEND_SCALED state */
 #define ROHC_INIT_TS_STRIDE_MIN  3U
 
+/** The minimal number of repetitions of the optimistic approach when the
+ *  number is adapted to the quality of the channel */
+#define ROHC_OA_REPETITIONS_MIN  1U
+
+/** The maximal number of repetitions of the optimistic approach when the
+ *  number is adapted to the quality of the channel */
+#define ROHC_OA_REPETITIONS_MAX  8U
+
+/** The number of consecutive positive ACKs that must be received before the
+ *  number of repetitions of the optimistic approach is reduced by one */
+#define ROHC_OA_REPETITIONS_ACKS_NR  8U
+
+/** The order of magnitude (log10) of the number of bits of the packets sent
+ *  by the optimistic approach, used to derive the packet loss rate from the
+ *  Bit Error Rate (BER) of the channel */
+#define ROHC_OA_PKT_BITS_LOG10  3U
+
+/** The order of magnitude (log10) of the probability that all the
+ *  repetitions of the optimistic approach are lost */
+#define ROHC_OA_LOSS_LOG10  6U
+
+/** The minimal width of the W-LSB windows when the width is adapted to the
+ *  feedback received from the decompressor (O- and R-modes only) */
+#define ROHC_WLSB_WIDTH_MIN  2U
+
+/** The number of consecutive positive ACKs that must be received before the
+ *  width of the W-LSB windows is reduced by one entry */
+#define ROHC_WLSB_WIDTH_ACKS_NR  4U
+
+/** The number of consecutive packets received in order by the compressor
+ *  before the width of the W-LSB windows is reduced by one entry (U-mode) */
+#define ROHC_WLSB_WIDTH_PKTS_NR  32U
+
+/** The minimal number of MSN bits that a positive ACK shall carry for the
+ *  width of the W-LSB windows to be adapted: the 8-bit MSN of FEEDBACK-1
+ *  may wrap around while packets are not acknowledged yet */
+#define ROHC_WLSB_WIDTH_ACK_SN_BITS_MIN  14U
+
+/** The number of packets a context shall compress before it is protected
+ *  against recycling by the \ref ROHC_COMP_EVICTION_SLRU policy */
+#define ROHC_COMP_SLRU_PROTECTED_PKTS  16
+
+/** The maximal number of packets a flow may be required to show before it
+ *  is admitted for compression */
+#define ROHC_COMP_ADMISSION_PKTS_MAX  255U
+
+/** The number of bits of the flow key used to index one row of the sketch
+ *  for context admission */
+#define ROHC_COMP_ADMISSION_BITS  10U
+
+/** The number of rows of the sketch for context admission */
+#define ROHC_COMP_ADMISSION_ROWS  2U
+
+/** The maximal number of packets of flows without context counted during
+ *  one admission window, whatever its duration */
+#define ROHC_COMP_ADMISSION_WINDOW_PKTS  (1U << ROHC_COMP_ADMISSION_BITS)
+
+/** The maximal length of the feedback items queued for piggybacking */
+#define ROHC_COMP_FEEDBACKS_MAX_LEN  1024U
+
+/** The maximal number of feedback buffers queued for piggybacking */
+#define ROHC_COMP_FEEDBACKS_MAX_NR  64U
+
+/** The maximal jitter (in percent) of the timeouts of periodic refreshes */
+#define ROHC_COMP_REFRESH_JITTER_MAX  50U
+
+/** The number of entries in the cache of the flows that no specific profile
+ *  accepts */
+#define ROHC_COMP_PROFILE_CACHE_SIZE  64U
+
+/** The number of packets that may use one entry of the cache of the flows
+ *  that no specific profile accepts before all the profiles are checked again */
+#define ROHC_COMP_PROFILE_CACHE_HITS_MAX  64U
+
+/** The maximal length of the static chain that a context may cache for its
+ *  IR packets, the longer static chains are encoded for every IR packet */
+#define ROHC_COMP_STATIC_CHAIN_MAX_LEN  128U
+
 /**
  * @brief Default number of transmission for lists to become a reference list
  *
@@ -123,6 +201,26 @@ struct rohc_comp_ctxt;
  */
 
 
+/** One entry of the index of the base contexts for Context Replication */
+struct rohc_comp_cr_entry
+{
+	/** The key of the IP addresses of the base context */
+	rohc_ctxt_key_t addrs_key;
+	/** The CID of the base context, ROHC_LARGE_CID_MAX + 1 if none */
+	rohc_cid_t cid;
+};
+
+
+/** One feedback buffer queued for piggybacking */
+struct rohc_comp_feedbacks_buf
+{
+	/** The length of the feedback items of the buffer still queued */
+	size_t len;
+	/** The time the feedback buffer was queued at */
+	struct rohc_ts time;
+};
+
+
 /**
  * @brief The ROHC compressor
  */
@@ -136,12 +234,45 @@ struct rohc_comp
 
 	/** The array of compression contexts that use the compressor */
 	struct rohc_comp_ctxt *contexts;
+	/** The index of the base contexts for Context Replication: the key of the
+	 *  IP addresses and the CID of one established context per entry */
+	struct rohc_comp_cr_entry *cr_index;
 	/** The number of compression contexts in use in the array */
 	size_t num_contexts_used;
+	/** The policy to select the context to recycle when all CIDs are used */
+	rohc_comp_eviction_t ctxt_eviction;
+	/** The number of times a context was used, the LRU order of contexts */
+	uint64_t ctxt_uses_nr;
+
+	/* variables related to context admission */
+
+	/** The number of packets a flow shall show during the admission window
+	 *  to get its own context (1 to disable context admission) */
+	size_t admission_pkts_nr;
+	/** The duration of the admission window (in milliseconds) */
+	uint64_t admission_time;
+	/** The beginning of the current admission window */
+	struct rohc_ts admission_start;
+	/** The number of packets of flows without context counted during the
+	 *  current admission window */
+	size_t admission_window_pkts;
+	/** The count-min sketch of the number of packets per flow without
+	 *  context during the current admission window */
+	uint8_t admission_sketch[ROHC_COMP_ADMISSION_ROWS][1U << ROHC_COMP_ADMISSION_BITS];
 
 	/** Which profiles are enabled and with one are not? */
 	bool enabled_profiles[C_NUM_PROFILES];
 
+	/** The cache of the flows that no specific profile accepts, so that their
+	 *  next packets skip the profiles that will reject them anyway */
+	struct
+	{
+		bool used;            /**< Whether the entry is in use */
+		uint8_t profile_idx;  /**< The index of the fallback profile */
+		uint8_t hits_nr;      /**< The number of packets that used the entry */
+		rohc_ctxt_key_t key;  /**< The key of the flow */
+	} profile_cache[ROHC_COMP_PROFILE_CACHE_SIZE];
+
 
 	/* CRC-related variables: */
 
@@ -166,6 +297,24 @@ struct rohc_comp
 	size_t rru_len;
 
 
+	/* variables related to feedback piggybacking */
+
+	/** The feedback items of the local decompressor queued for being
+	 *  piggybacked on the next ROHC packets (in ROHC format) */
+	uint8_t feedbacks[ROHC_COMP_FEEDBACKS_MAX_LEN];
+	/** The length of the feedback items queued for piggybacking */
+	size_t feedbacks_len;
+	/** The feedback buffers queued for piggybacking, the oldest first */
+	struct rohc_comp_feedbacks_buf feedbacks_bufs[ROHC_COMP_FEEDBACKS_MAX_NR];
+	/** The number of feedback buffers queued for piggybacking */
+	size_t feedbacks_bufs_nr;
+	/** The maximal length of feedback items piggybacked on one ROHC packet */
+	size_t feedbacks_max_pkt_len;
+	/** The maximal delay (in milliseconds) before the queued feedback items
+	 *  are flushed in feedback-only packets */
+	uint64_t feedbacks_max_delay;
+
+
 	/* variables related to RTP detection */
 
 	/** The callback function used to detect RTP packet */
@@ -199,6 +348,10 @@ struct rohc_comp
 
 	/** The width of the W-LSB sliding window */
 	size_t wlsb_window_width;
+	/** The number of repetitions of the optimistic approach for the new
+	 *  contexts, derived from the BER of the channel
+	 *  @see rohc_comp_set_channel_ber */
+	size_t oa_repetitions_nr;
 	/** The reorder offset specifies how much reordering is handled by the
 	 *  W-LSB encoding of the MSN in ROHCv2 profiles */
 	rohc_reordering_offset_t reorder_ratio;
@@ -214,6 +367,19 @@ struct rohc_comp
 	/** The maximal delay spent in > FO states (= SO state) before changing back
 	 *  the state to FO (periodic refreshes) */
 	uint64_t periodic_refreshes_fo_timeout_time;
+	/** The maximal jitter (in percent) that shortens the timeouts of the
+	 *  periodic refreshes of every context (0 to disable jitter) */
+	size_t periodic_refreshes_jitter;
+	/** The maximal number of periodic refreshes that may be done in a row by
+	 *  all the contexts (0 to disable the rate limit) */
+	size_t refreshes_tokens_max;
+	/** The number of packets to compress to get one more periodic refresh */
+	size_t refreshes_tokens_interval;
+	/** The number of periodic refreshes that may be done right now */
+	size_t refreshes_tokens;
+	/** The number of packets compressed since the last periodic refresh was
+	 *  granted */
+	size_t refreshes_tokens_pkts;
 	/** Maximum Reconstructed Reception Unit */
 	size_t mrru;
 	/** The connection type (currently not used) */
@@ -331,6 +497,16 @@ struct rohc_comp_ctxt
 	uint64_t latest_used;
 	/** The time when the context was last used (in seconds) */
 	uint64_t first_used;
+	/** The value of the compressor use counter when the context was last
+	 *  used, the LRU order of the context */
+	uint64_t last_use_nr;
+	/** The priority of the context when one context shall be recycled */
+	rohc_comp_ctxt_prio_t prio;
+
+	/** The key of the flow the context was created for */
+	rohc_ctxt_key_t key;
+	/** The key of the IP addresses of the flow the context was created for */
+	rohc_ctxt_key_t addrs_key;
 
 	/** The context unique ID (CID) */
 	rohc_cid_t cid;
@@ -392,6 +568,65 @@ struct rohc_comp_ctxt
 	 * @see rohc_comp_periodic_down_transition
 	 */
 	struct rohc_ts go_back_ir_time;
+	/**
+	 * @brief The jitter (in percent) that shortens the timeouts of the next
+	 *        periodic refreshes of the context
+	 * @see rohc_comp_periodic_down_transition
+	 */
+	size_t refresh_jitter;
+
+	/**
+	 * @brief The width of the W-LSB windows currently used by the context
+	 *
+	 * The width is adapted to the feedback received from the decompressor in
+	 * O- and R-modes, it then never exceeds the width configured for the
+	 * compressor. In U-mode, the width is adapted to the reordering of the
+	 * packets given to the compressor, it then never goes below the width
+	 * configured for the compressor.
+	 *
+	 * @see rohc_comp_wlsb_width_adapt
+	 * @see rohc_comp_wlsb_width_reorder
+	 */
+	size_t wlsb_window_width;
+	/** The number of consecutive positive ACKs received since the last change
+	 *  of the W-LSB window width */
+	size_t wlsb_acks_nr;
+	/** The number of consecutive packets received in order since the last
+	 *  change of the W-LSB window width (U-mode only) */
+	size_t wlsb_in_order_nr;
+	/** Whether one SN was already given to the W-LSB width adaptation */
+	bool is_wlsb_sn_max_init;
+	/** The greatest SN given to the W-LSB width adaptation so far */
+	uint32_t wlsb_sn_max;
+
+	/**
+	 * @brief The number of repetitions of the optimistic approach
+	 *
+	 * The minimal number of packets sent in IR and FO states before the next
+	 * state, and the minimal number of times TS_STRIDE is sent. It is derived
+	 * from the BER configured for the compressor, then adapted to the NACKs
+	 * received from the decompressor in O-mode.
+	 *
+	 * @see rohc_comp_oa_repetitions_adapt
+	 */
+	size_t oa_repetitions_nr;
+	/** The number of consecutive positive ACKs received since the last change
+	 *  of the number of repetitions of the optimistic approach */
+	size_t oa_acks_nr;
+
+	/**
+	 * @brief The static chain last encoded for the context
+	 *
+	 * The static chain does not change as long as the static fields of the
+	 * packets do not change, so the IR packets reuse it instead of encoding it
+	 * again. The profiles invalidate it whenever one static field changes.
+	 *
+	 * @see rohc_comp_static_chain_reuse
+	 * @see rohc_comp_static_chain_cache
+	 */
+	uint8_t static_chain[ROHC_COMP_STATIC_CHAIN_MAX_LEN];
+	/** The length of the cached static chain, 0 if no static chain is cached */
+	size_t static_chain_len;
 
 	/** The cumulated size of the uncompressed packets */
 	int total_uncompressed_size;
@@ -431,6 +666,29 @@ void rohc_comp_periodic_down_transition(struct rohc_comp_ctxt *const context,
 bool rohc_comp_reinit_context(struct rohc_comp_ctxt *const context)
 	__attribute__((warn_unused_result, nonnull(1)));
 
+bool rohc_comp_wlsb_width_adapt(struct rohc_comp_ctxt *const context,
+                                const enum rohc_feedback_ack_type ack_type,
+                                const size_t unacked_nr)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+bool rohc_comp_wlsb_width_reorder(struct rohc_comp_ctxt *const context,
+                                  const uint32_t sn,
+                                  const uint32_t sn_mask)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+bool rohc_comp_wlsb_is_ack_driven(const struct rohc_comp_ctxt *const context)
+	__attribute__((warn_unused_result, nonnull(1), pure));
+
+size_t rohc_comp_static_chain_reuse(const struct rohc_comp_ctxt *const context,
+                                    uint8_t *const rohc_data,
+                                    const size_t rohc_max_len)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
+
+void rohc_comp_static_chain_cache(struct rohc_comp_ctxt *const context,
+                                  const uint8_t *const static_chain,
+                                  const size_t static_chain_len)
+	__attribute__((nonnull(1, 2)));
+
 bool rohc_comp_feedback_parse_opts(const struct rohc_comp_ctxt *const context,
                                    const uint8_t *const packet,
                                    const size_t packet_len,
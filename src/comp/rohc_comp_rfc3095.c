@@ -76,6 +76,7 @@
 static void ip_header_info_new(struct ip_header_info *const header_info,
                                const struct ip_packet *const ip,
                                const size_t list_trans_nr,
+                               const bool srh_updates,
                                const size_t wlsb_window_width,
                                rohc_trace_callback2_t trace_cb,
                                void *const trace_cb_priv,
@@ -86,29 +87,84 @@ static void ip_header_info_free(struct ip_header_info *const header_info)
 
 static void c_init_tmp_variables(struct generic_tmp_vars *const tmp_vars);
 
+/**
+ * @brief The requirements of one extension of the UO-1-ID/UOR-2 packets
+ *
+ * Extensions 0, 1 & 2 are IPv4 only because of the IP-ID.
+ */
+struct rohc_ext_rule
+{
+	rohc_ext_t ext;           /**< The extension that the rule selects */
+	bool sn_le4;              /**< Whether SN bits are counted for a field of
+	                               4 bits or less */
+	uint8_t sn_max;           /**< The max number of SN bits */
+	uint8_t ts_max;           /**< The max number of TS bits */
+	bool ts_deducible_ok;     /**< Whether more TS bits are allowed if TS is
+	                               deducible from SN */
+	uint8_t ip_id_inner_min;  /**< The min number of innermost IP-ID bits */
+	uint8_t ip_id_inner_max;  /**< The max number of innermost IP-ID bits */
+	uint8_t ip_id_outer_max;  /**< The max number of outermost IP-ID bits */
+	uint8_t ip_hdr_nr_min;    /**< The min number of IP headers */
+	bool no_marker;           /**< Whether the RTP Marker bit shall be unset */
+};
+
+/** The extensions of the UOR-2 packet (non-RTP profiles) */
+static const struct rohc_ext_rule rohc_ext_rules_uor2[] =
+{
+	{ ROHC_EXT_NONE, false, 5, 0, false, 0,  0,  0, 1, false },
+	{ ROHC_EXT_0,    false, 8, 0, false, 1,  3,  0, 1, false },
+	{ ROHC_EXT_1,    false, 8, 0, false, 1, 11,  0, 1, false },
+	{ ROHC_EXT_2,    false, 8, 0, false, 1,  8, 11, 2, false },
+	{ ROHC_EXT_3,    false, 0, 0, false, 0,  0,  0, 0, false },
+};
+
+/** The extensions of the UOR-2-RTP packet */
+static const struct rohc_ext_rule rohc_ext_rules_uor2rtp[] =
+{
+	{ ROHC_EXT_NONE, false, 6,  6, false, 0, 0, 0, 1, false },
+	{ ROHC_EXT_0,    false, 9,  9, false, 0, 0, 0, 1, false },
+	{ ROHC_EXT_1,    false, 9, 17, false, 0, 0, 0, 1, false },
+	{ ROHC_EXT_2,    false, 9, 25, false, 0, 0, 0, 1, false },
+	{ ROHC_EXT_3,    false, 0,  0, false, 0, 0, 0, 0, false },
+};
+
+/** The extensions of the UOR-2-TS packet */
+static const struct rohc_ext_rule rohc_ext_rules_uor2ts[] =
+{
+	{ ROHC_EXT_NONE, false, 6,  5, false, 0, 0, 0, 1, false },
+	{ ROHC_EXT_0,    false, 9,  8, false, 0, 0, 0, 1, false },
+	{ ROHC_EXT_1,    false, 9,  8, false, 0, 8, 0, 1, false },
+	{ ROHC_EXT_2,    false, 9, 16, false, 0, 8, 0, 1, false },
+	{ ROHC_EXT_3,    false, 0,  0, false, 0, 0, 0, 0, false },
+};
+
+/** The extensions of the UOR-2-ID packet */
+static const struct rohc_ext_rule rohc_ext_rules_uor2id[] =
+{
+	{ ROHC_EXT_NONE, false, 6, 0, true,  0,  5, 0, 1, false },
+	{ ROHC_EXT_0,    false, 9, 0, true,  0,  8, 0, 1, false },
+	{ ROHC_EXT_1,    false, 9, 8, false, 0,  8, 0, 1, false },
+	{ ROHC_EXT_2,    false, 9, 8, false, 0, 16, 0, 1, false },
+	{ ROHC_EXT_3,    false, 0, 0, false, 0,  0, 0, 0, false },
+};
+
+/** The extensions of the UO-1-ID packet */
+static const struct rohc_ext_rule rohc_ext_rules_uo1id[] =
+{
+	{ ROHC_EXT_NONE, true,  4, 0, true,  0,  5, 0, 1, true },
+	{ ROHC_EXT_0,    false, 7, 0, true,  0,  8, 0, 1, true },
+	{ ROHC_EXT_1,    false, 7, 8, false, 0,  8, 0, 1, true },
+	{ ROHC_EXT_2,    false, 7, 8, false, 0, 16, 0, 1, true },
+	{ ROHC_EXT_3,    false, 0, 0, false, 0,  0, 0, 0, false },
+};
+
+
 static rohc_packet_t decide_packet(struct rohc_comp_ctxt *const context)
 	__attribute__((warn_unused_result, nonnull(1)));
 
-static rohc_ext_t decide_extension_uor2(const struct rohc_comp_ctxt *const context,
-                                        const size_t nr_innermost_ip_id_bits,
-                                        const size_t nr_outermost_ip_id_bits)
-	__attribute__((warn_unused_result, nonnull(1)));
-static rohc_ext_t decide_extension_uor2rtp(const struct rohc_comp_ctxt *const context,
-                                           const size_t nr_innermost_ip_id_bits,
-                                           const size_t nr_outermost_ip_id_bits)
-	__attribute__((warn_unused_result, nonnull(1)));
-static rohc_ext_t decide_extension_uor2ts(const struct rohc_comp_ctxt *const context,
-                                          const size_t nr_innermost_ip_id_bits,
-                                          const size_t nr_outermost_ip_id_bits)
-	__attribute__((warn_unused_result, nonnull(1)));
-static rohc_ext_t decide_extension_uor2id(const struct rohc_comp_ctxt *const context,
-                                          const size_t nr_innermost_ip_id_bits,
-                                          const size_t nr_outermost_ip_id_bits)
-	__attribute__((warn_unused_result, nonnull(1)));
-static rohc_ext_t decide_extension_uo1id(const struct rohc_comp_ctxt *const context,
-                                         const size_t nr_innermost_ip_id_bits,
-                                         const size_t nr_outermost_ip_id_bits)
-	__attribute__((warn_unused_result, nonnull(1)));
+static rohc_ext_t decide_extension_from_rules(const struct rohc_comp_ctxt *const context,
+                                              const struct rohc_ext_rule *const rules)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
 
 static int code_packet(struct rohc_comp_ctxt *const context,
                        const struct net_pkt *const uncomp_pkt,
@@ -387,6 +443,14 @@ static void rohc_comp_rfc3095_feedback_ack(struct rohc_comp_ctxt *const context,
                                            const bool sn_not_valid)
 	__attribute__((nonnull(1)));
 
+static void rohc_comp_rfc3095_ack_wlsb(struct rohc_comp_ctxt *const context,
+                                       const uint32_t sn_bits,
+                                       const size_t sn_bits_nr)
+	__attribute__((nonnull(1)));
+
+static void rohc_comp_rfc3095_set_wlsb_width(struct rohc_comp_ctxt *const context)
+	__attribute__((nonnull(1)));
+
 
 
 /*
@@ -418,6 +482,8 @@ static bool is_field_changed(const unsigned short changed_fields,
  * @param ip                 The IP header
  * @param list_trans_nr      The number of uncompressed transmissions for
  *                           list compression (L)
+ * @param srh_updates        Whether the Segment Routing Headers may be updated
+ *                           without their unchanged segment list
  * @param wlsb_window_width  The width of the W-LSB sliding window for IPv4
  *                           IP-ID (must be > 0)
  * @param trace_cb           The function to call for printing traces
@@ -427,6 +493,7 @@ static bool is_field_changed(const unsigned short changed_fields,
 static void ip_header_info_new(struct ip_header_info *const header_info,
                                const struct ip_packet *const ip,
                                const size_t list_trans_nr,
+                               const bool srh_updates,
                                const size_t wlsb_window_width,
                                rohc_trace_callback2_t trace_cb,
                                void *const trace_cb_priv,
@@ -460,7 +527,7 @@ static void ip_header_info_new(struct ip_header_info *const header_info,
 	{
 		/* init the compression context for IPv6 extension header list */
 		rohc_comp_list_ipv6_new(&header_info->info.v6.ext_comp, list_trans_nr,
-		                        trace_cb, trace_cb_priv, profile_id);
+		                        srh_updates, trace_cb, trace_cb_priv, profile_id);
 	}
 }
 
@@ -553,6 +620,8 @@ bool rohc_comp_rfc3095_create(struct rohc_comp_ctxt *const context,
 	ip_header_info_new(&rfc3095_ctxt->outer_ip_flags,
 	                   &packet->outer_ip,
 	                   context->compressor->list_trans_nr,
+	                   (context->compressor->features &
+	                    ROHC_COMP_FEATURE_SRH_UPDATES) != 0,
 	                   context->compressor->wlsb_window_width,
 	                   context->compressor->trace_callback,
 	                   context->compressor->trace_callback_priv,
@@ -562,6 +631,8 @@ bool rohc_comp_rfc3095_create(struct rohc_comp_ctxt *const context,
 		ip_header_info_new(&rfc3095_ctxt->inner_ip_flags,
 		                   &packet->inner_ip,
 		                   context->compressor->list_trans_nr,
+		                   (context->compressor->features &
+		                    ROHC_COMP_FEATURE_SRH_UPDATES) != 0,
 		                   context->compressor->wlsb_window_width,
 		                   context->compressor->trace_callback,
 		                   context->compressor->trace_callback_priv,
@@ -1036,6 +1107,11 @@ static bool rohc_comp_rfc3095_feedback_2(struct rohc_comp_ctxt *const context,
 			{
 				rohc_comp_change_state(context, ROHC_COMP_STATE_FO);
 			}
+			/* the current references are not robust enough against losses */
+			if(rohc_comp_wlsb_width_adapt(context, feedback2->ack_type, 0))
+			{
+				rohc_comp_rfc3095_set_wlsb_width(context);
+			}
 			/* TODO: use the SN field to determine the latest packet successfully
 			 * decompressed and then determine what fields need to be updated */
 			break;
@@ -1047,6 +1123,11 @@ static bool rohc_comp_rfc3095_feedback_2(struct rohc_comp_ctxt *const context,
 			          "STATIC-NACK received for CID %zu", context->cid);
 			/* the compressor transits back to the IR state */
 			rohc_comp_change_state(context, ROHC_COMP_STATE_IR);
+			/* the current references are not robust enough against losses */
+			if(rohc_comp_wlsb_width_adapt(context, feedback2->ack_type, 0))
+			{
+				rohc_comp_rfc3095_set_wlsb_width(context);
+			}
 			/* TODO: use the SN field to determine the latest packet successfully
 			 * decompressed and then determine what fields need to be updated */
 			break;
@@ -1177,7 +1258,7 @@ static void rohc_comp_rfc3095_feedback_ack(struct rohc_comp_ctxt *const context,
 				rtp_context->rtp_pt_change_count = MAX_IR_COUNT;
 				if(rtp_context->ts_sc.nr_init_stride_packets > 0)
 				{
-					rtp_context->ts_sc.nr_init_stride_packets = ROHC_INIT_TS_STRIDE_MIN;
+					rtp_context->ts_sc.nr_init_stride_packets = context->oa_repetitions_nr;
 				}
 			}
 		}
@@ -1194,36 +1275,15 @@ static void rohc_comp_rfc3095_feedback_ack(struct rohc_comp_ctxt *const context,
 		 * field and whether it is one IR packet ; if yes, transit upward */
 		rohc_comp_debug(context, "ACK(R) received, but not fully supported, so "
 		                "do not transit to SO state more quickly");
+	}
 
-		/* RFC 3095, §4.5.2: ack W-LSB values only in R-mode since U/O-mode uses
-		 * a sliding window with a limited maximum width */
-		/* acknowledge IP-ID and SN only if SN is considered as valid */
-		if(!sn_not_valid)
-		{
-			size_t acked_nr;
-
-			/* ack outer IP-ID only if IPv4 */
-			if(rfc3095_ctxt->outer_ip_flags.version == IPV4)
-			{
-				acked_nr = wlsb_ack(&rfc3095_ctxt->outer_ip_flags.info.v4.ip_id_window,
-				                    sn_bits, sn_bits_nr);
-				rohc_comp_debug(context, "FEEDBACK-2: positive ACK removed %zu "
-				                "values from inner IP-ID W-LSB", acked_nr);
-			}
-			/* inner IP-ID only if present and if IPv4 */
-			if(rfc3095_ctxt->ip_hdr_nr > 1 &&
-			   rfc3095_ctxt->inner_ip_flags.version == IPV4)
-			{
-				acked_nr = wlsb_ack(&rfc3095_ctxt->inner_ip_flags.info.v4.ip_id_window,
-				                    sn_bits, sn_bits_nr);
-				rohc_comp_debug(context, "FEEDBACK-2: positive ACK removed %zu "
-				                "values from outer IP-ID W-LSB", acked_nr);
-			}
-			/* always ack SN */
-			acked_nr = wlsb_ack(&rfc3095_ctxt->sn_window, sn_bits, sn_bits_nr);
-			rohc_comp_debug(context, "FEEDBACK-2: positive ACK removed %zu values "
-			                "from SN W-LSB", acked_nr);
-		}
+	/* RFC 3095, §4.5.2: ack W-LSB values only if the windows are ACK-driven
+	 * (always in R-mode) since U/O-mode uses a sliding window with a limited
+	 * maximum width */
+	/* acknowledge IP-ID and SN only if SN is considered as valid */
+	if(rohc_comp_wlsb_is_ack_driven(context) && !sn_not_valid)
+	{
+		rohc_comp_rfc3095_ack_wlsb(context, sn_bits, sn_bits_nr);
 	}
 
 	/* RFC 3095, §5.8.2.1:
@@ -1269,6 +1329,99 @@ static void rohc_comp_rfc3095_feedback_ack(struct rohc_comp_ctxt *const context,
 	/* TODO: ack the compressed lists */
 	rohc_comp_debug(context, "ACK received, but not fully supported, so do not "
 	                "acknowledge compressed list more quickly");
+
+	/* adapt the width of the W-LSB windows to the number of packets that are
+	 * not acknowledged yet (the acknowledged SN is kept in the MSN window) */
+	if(!sn_not_valid && rfc3095_ctxt->msn_non_acked.count > 0)
+	{
+		const size_t unacked_nr = rfc3095_ctxt->msn_non_acked.count - 1;
+		if(rohc_comp_wlsb_width_adapt(context, ROHC_FEEDBACK_ACK, unacked_nr))
+		{
+			rohc_comp_rfc3095_set_wlsb_width(context);
+		}
+	}
+}
+
+
+/**
+ * @brief Remove the acknowledged values from the ACK-driven W-LSB windows
+ *
+ * The windows of the SN and of the IP-IDs become ACK-driven: they keep the
+ * acknowledged value and all the values sent after it, whatever their width.
+ *
+ * @param context       The compression context that received a positive ACK
+ * @param sn_bits       The LSB bits of the acknowledged SN
+ * @param sn_bits_nr    The number of LSB bits of the acknowledged SN
+ */
+static void rohc_comp_rfc3095_ack_wlsb(struct rohc_comp_ctxt *const context,
+                                       const uint32_t sn_bits,
+                                       const size_t sn_bits_nr)
+{
+	struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt = context->specific;
+	size_t acked_nr;
+
+	/* ack outer IP-ID only if IPv4 */
+	if(rfc3095_ctxt->outer_ip_flags.version == IPV4)
+	{
+		struct c_wlsb *const ip_id_window =
+			&rfc3095_ctxt->outer_ip_flags.info.v4.ip_id_window;
+
+		wlsb_set_ack_driven(ip_id_window, true);
+		acked_nr = wlsb_ack(ip_id_window, sn_bits, sn_bits_nr);
+		rohc_comp_debug(context, "FEEDBACK-2: positive ACK removed %zu "
+		                "values from outer IP-ID W-LSB", acked_nr);
+	}
+	/* inner IP-ID only if present and if IPv4 */
+	if(rfc3095_ctxt->ip_hdr_nr > 1 &&
+	   rfc3095_ctxt->inner_ip_flags.version == IPV4)
+	{
+		struct c_wlsb *const ip_id_window =
+			&rfc3095_ctxt->inner_ip_flags.info.v4.ip_id_window;
+
+		wlsb_set_ack_driven(ip_id_window, true);
+		acked_nr = wlsb_ack(ip_id_window, sn_bits, sn_bits_nr);
+		rohc_comp_debug(context, "FEEDBACK-2: positive ACK removed %zu "
+		                "values from inner IP-ID W-LSB", acked_nr);
+	}
+	/* always ack SN */
+	wlsb_set_ack_driven(&rfc3095_ctxt->sn_window, true);
+	acked_nr = wlsb_ack(&rfc3095_ctxt->sn_window, sn_bits, sn_bits_nr);
+	rohc_comp_debug(context, "FEEDBACK-2: positive ACK removed %zu values "
+	                "from SN W-LSB", acked_nr);
+}
+
+
+/**
+ * @brief Resize the W-LSB windows of the context to the width of the context
+ *
+ * The MSN window used to track the packets not acknowledged yet is not
+ * resized: it keeps the width configured for the compressor.
+ *
+ * @param context  The compression context
+ */
+static void rohc_comp_rfc3095_set_wlsb_width(struct rohc_comp_ctxt *const context)
+{
+	struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt = context->specific;
+	const size_t width = context->wlsb_window_width;
+
+	wlsb_set_window_width(&rfc3095_ctxt->sn_window, width);
+	if(rfc3095_ctxt->outer_ip_flags.version == IPV4)
+	{
+		wlsb_set_window_width(&rfc3095_ctxt->outer_ip_flags.info.v4.ip_id_window,
+		                      width);
+	}
+	if(rfc3095_ctxt->ip_hdr_nr > 1 &&
+	   rfc3095_ctxt->inner_ip_flags.version == IPV4)
+	{
+		wlsb_set_window_width(&rfc3095_ctxt->inner_ip_flags.info.v4.ip_id_window,
+		                      width);
+	}
+	if(context->profile->id == ROHC_PROFILE_RTP)
+	{
+		struct sc_rtp_context *const rtp_context = rfc3095_ctxt->specific;
+		wlsb_set_window_width(&rtp_context->ts_sc.ts_scaled_wlsb, width);
+		wlsb_set_window_width(&rtp_context->ts_sc.ts_unscaled_wlsb, width);
+	}
 }
 
 
@@ -1290,17 +1443,30 @@ static bool rohc_comp_rfc3095_detect_changes(struct rohc_comp_ctxt *const contex
 	rfc3095_ctxt->sn = rfc3095_ctxt->get_next_sn(context, uncomp_pkt);
 	rohc_comp_debug(context, "SN = %u", rfc3095_ctxt->sn);
 
+	/* the RTP and ESP sequence numbers are copied from the packets: in U-mode,
+	 * adapt the width of the W-LSB windows to their reordering */
+	if(rohc_comp_wlsb_width_reorder(context, rfc3095_ctxt->sn,
+	                                rfc3095_ctxt->sn_window.bits == 32 ?
+	                                0xffffffffU :
+	                                ((1U << rfc3095_ctxt->sn_window.bits) - 1)))
+	{
+		rohc_comp_rfc3095_set_wlsb_width(context);
+	}
+
 	/* init or free the context of the inner IP header if the number of IP
 	 * headers changed */
 	if(uncomp_pkt->ip_hdr_nr != rfc3095_ctxt->ip_hdr_nr)
 	{
+		context->static_chain_len = 0;
 		if(uncomp_pkt->ip_hdr_nr > 1)
 		{
 			rohc_comp_debug(context, "packet got one more IP header than context");
 			ip_header_info_new(&rfc3095_ctxt->inner_ip_flags,
 			                   &uncomp_pkt->inner_ip,
 			                   context->compressor->list_trans_nr,
-			                   context->compressor->wlsb_window_width,
+			                   (context->compressor->features &
+			                    ROHC_COMP_FEATURE_SRH_UPDATES) != 0,
+			                   context->wlsb_window_width,
 			                   context->compressor->trace_callback,
 			                   context->compressor->trace_callback_priv,
 			                   context->profile->id);
@@ -1391,11 +1557,11 @@ void rohc_comp_rfc3095_decide_state(struct rohc_comp_ctxt *const context)
 
 	if(curr_state == ROHC_COMP_STATE_IR)
 	{
-		if(context->ir_count < MAX_IR_COUNT)
+		if(context->ir_count < context->oa_repetitions_nr)
 		{
 			rohc_comp_debug(context, "no enough packets transmitted in IR state "
-			                "for the moment (%zu/%u), so stay in IR state",
-			                context->ir_count, MAX_IR_COUNT);
+			                "for the moment (%zu/%zu), so stay in IR state",
+			                context->ir_count, context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_IR;
 		}
 		else if(rfc3095_ctxt->tmp.send_static)
@@ -1431,11 +1597,11 @@ void rohc_comp_rfc3095_decide_state(struct rohc_comp_ctxt *const context)
 	}
 	else if(curr_state == ROHC_COMP_STATE_FO)
 	{
-		if(context->fo_count < MAX_FO_COUNT)
+		if(context->fo_count < context->oa_repetitions_nr)
 		{
 			rohc_comp_debug(context, "no enough packets transmitted in FO state "
-			                "for the moment (%zu/%u), so stay in FO state",
-			                context->fo_count, MAX_FO_COUNT);
+			                "for the moment (%zu/%zu), so stay in FO state",
+			                context->fo_count, context->oa_repetitions_nr);
 			next_state = ROHC_COMP_STATE_FO;
 		}
 		else if(rfc3095_ctxt->tmp.send_static || rfc3095_ctxt->tmp.send_dynamic)
@@ -1572,30 +1738,33 @@ static rohc_packet_t decide_packet(struct rohc_comp_ctxt *const context)
 	}
 	rohc_comp_debug(context, "packet '%s' chosen", rohc_get_packet_descr(packet));
 
-	/* force IR-DYN packet because some bits shall be sent for the list of IPv6
-	 * extension headers of the outer IP header */
+	/* the list of IPv6 extension headers may be transmitted in the extension 3
+	 * of the UOR-2* packets (IPX/IPX2 flags), force IR-DYN packet only if some
+	 * bits shall be sent for one list and the chosen packet cannot carry them */
 	if(packet > ROHC_PACKET_IR_DYN &&
-	   is_field_changed(rfc3095_ctxt->tmp.changed_fields,
-	                    MOD_IPV6_EXT_LIST_STRUCT | MOD_IPV6_EXT_LIST_CONTENT))
+	   packet != ROHC_PACKET_UOR_2 &&
+	   packet != ROHC_PACKET_UOR_2_RTP &&
+	   packet != ROHC_PACKET_UOR_2_ID &&
+	   packet != ROHC_PACKET_UOR_2_TS)
 	{
-		rohc_comp_debug(context, "force IR-DYN packet because some bits shall "
-		                "be sent for the extension header list of the outer "
-		                "IPv6 header");
-		/* TODO: could be UOR-2 with extension 3 and IPX=1 */
-		packet = ROHC_PACKET_IR_DYN;
-	}
-	/* force IR-DYN packet because some bits shall be sent for the list of IPv6
-	 * extension headers of the inner IP header */
-	else if(packet > ROHC_PACKET_IR_DYN &&
-	        rfc3095_ctxt->ip_hdr_nr > 1 &&
-	        is_field_changed(rfc3095_ctxt->tmp.changed_fields2,
-	                         MOD_IPV6_EXT_LIST_STRUCT | MOD_IPV6_EXT_LIST_CONTENT))
-	{
-		rohc_comp_debug(context, "force IR-DYN packet because some bits shall "
-		                "be sent for the extension header list of the inner "
-		                "IPv6 header");
-		/* TODO: could be UOR-2 with extension 3 and IPX2=1 */
-		packet = ROHC_PACKET_IR_DYN;
+		if(is_field_changed(rfc3095_ctxt->tmp.changed_fields,
+		                    MOD_IPV6_EXT_LIST_STRUCT | MOD_IPV6_EXT_LIST_CONTENT))
+		{
+			rohc_comp_debug(context, "force IR-DYN packet because some bits shall "
+			                "be sent for the extension header list of the outer "
+			                "IPv6 header");
+			packet = ROHC_PACKET_IR_DYN;
+		}
+		else if(rfc3095_ctxt->ip_hdr_nr > 1 &&
+		        is_field_changed(rfc3095_ctxt->tmp.changed_fields2,
+		                         MOD_IPV6_EXT_LIST_STRUCT |
+		                         MOD_IPV6_EXT_LIST_CONTENT))
+		{
+			rohc_comp_debug(context, "force IR-DYN packet because some bits shall "
+			                "be sent for the extension header list of the inner "
+			                "IPv6 header");
+			packet = ROHC_PACKET_IR_DYN;
+		}
 	}
 
 	return packet;
@@ -1808,13 +1977,29 @@ static int code_IR_packet(struct rohc_comp_ctxt *const context,
 	rohc_pkt[counter] = 0;
 	counter++;
 
-	/* part 6: static part */
-	ret = rohc_code_static_part(context, uncomp_pkt, rohc_pkt, counter);
-	if(ret < 0)
+	/* part 6: static part, the one cached in context if the static fields did
+	 * not change since it was encoded */
+	ret = rohc_comp_static_chain_reuse(context, rohc_pkt + counter,
+	                                   rohc_pkt_max_len - counter);
+	if(ret > 0)
 	{
-		goto error;
+		rfc3095_ctxt->outer_ip_flags.protocol_count++;
+		if(nr_of_ip_hdr > 1)
+		{
+			rfc3095_ctxt->inner_ip_flags.protocol_count++;
+		}
+		counter += ret;
+	}
+	else
+	{
+		ret = rohc_code_static_part(context, uncomp_pkt, rohc_pkt, counter);
+		if(ret < 0)
+		{
+			goto error;
+		}
+		rohc_comp_static_chain_cache(context, rohc_pkt + counter, ret - counter);
+		counter = ret;
 	}
-	counter = ret;
 
 	/* part 7: if we do not want dynamic part in IR packet, we should not
 	 * send the following */
@@ -5443,6 +5628,10 @@ static int code_EXT3_rtp_packet(struct rohc_comp_ctxt *const context,
 	{
 		counter = header_fields(context, inner_ip_flags, inner_ip_changed_fields,
 		                        inner_ip, 0, ROHC_IP_HDR_SECOND, dest, counter);
+		if(counter < 0)
+		{
+			goto error;
+		}
 	}
 
 	/* part 7 */
@@ -5476,6 +5665,10 @@ static int code_EXT3_rtp_packet(struct rohc_comp_ctxt *const context,
 	{
 		counter = header_fields(context, outer_ip_flags, outer_ip_changed_fields,
 		                        outer_ip, I2, ROHC_IP_HDR_FIRST, dest, counter);
+		if(counter < 0)
+		{
+			goto error;
+		}
 	}
 
 	/* part 9 */
@@ -5488,8 +5681,6 @@ static int code_EXT3_rtp_packet(struct rohc_comp_ctxt *const context,
 		}
 	}
 
-	/* no IP extension until list compression */
-
 	return counter;
 
 error:
@@ -5672,6 +5863,10 @@ static int code_EXT3_nortp_packet(struct rohc_comp_ctxt *const context,
 	{
 		counter = header_fields(context, inner_ip_flags, inner_ip_changed_fields,
 		                        inner_ip, 0, ROHC_IP_HDR_SECOND, dest, counter);
+		if(counter < 0)
+		{
+			goto error;
+		}
 	}
 
 	/* part 6 */
@@ -5705,11 +5900,16 @@ static int code_EXT3_nortp_packet(struct rohc_comp_ctxt *const context,
 	{
 		counter = header_fields(context, outer_ip_flags, outer_ip_changed_fields,
 		                        outer_ip, I2, ROHC_IP_HDR_FIRST, dest, counter);
+		if(counter < 0)
+		{
+			goto error;
+		}
 	}
 
-	/* no IP extension until list compression */
-
 	return counter;
+
+error:
+	return -1;
 }
 
 
@@ -5834,20 +6034,20 @@ static int rtp_header_flags_and_fields(const struct rohc_comp_ctxt *const contex
 
 		/* do we transmit the scaled RTP Timestamp (TS) in the next packet ? */
 		rtp_context->ts_sc.nr_init_stride_packets++;
-		if(rtp_context->ts_sc.nr_init_stride_packets >= ROHC_INIT_TS_STRIDE_MIN)
+		if(rtp_context->ts_sc.nr_init_stride_packets >= context->oa_repetitions_nr)
 		{
-			rohc_comp_debug(context, "TS_STRIDE transmitted at least %u times, so "
+			rohc_comp_debug(context, "TS_STRIDE transmitted at least %zu times, so "
 			                "change from state INIT_STRIDE to SEND_SCALED",
-			                ROHC_INIT_TS_STRIDE_MIN);
+			                context->oa_repetitions_nr);
 			rtp_context->ts_sc.state = SEND_SCALED;
 		}
 		else
 		{
 			rohc_comp_debug(context, "TS_STRIDE transmitted only %zd times, so stay "
-			                "in state INIT_STRIDE (at least %u times are required to "
+			                "in state INIT_STRIDE (at least %zu times are required to "
 			                "change to state SEND_SCALED)",
 			                rtp_context->ts_sc.nr_init_stride_packets,
-			                ROHC_INIT_TS_STRIDE_MIN);
+			                context->oa_repetitions_nr);
 		}
 	}
 
@@ -5930,6 +6130,15 @@ static int header_flags(const struct rohc_comp_ctxt *const context,
 		flags |= 0x10;
 	}
 
+	/* IPX is an IPv6 specific flag: set it if some bits shall be sent for
+	 * the list of IPv6 extension headers */
+	if(header_info->version == IPV6 &&
+	   is_field_changed(changed_f, MOD_IPV6_EXT_LIST_STRUCT |
+	                               MOD_IPV6_EXT_LIST_CONTENT))
+	{
+		flags |= 0x08;
+	}
+
 	/* DF, NBO, RND and I2 are IPv4 specific flags,
 	 * there are always set to 0 for IPv6 */
 	if(header_info->version == IPV4)
@@ -5993,8 +6202,6 @@ static int header_flags(const struct rohc_comp_ctxt *const context,
      ..... ..... ..... ..... ..... ..... ..... .....    if I2 = 1
 
 \endverbatim
- *
- * Part 4 is not supported.
  *
  * @param context        The compression context
  * @param header_info    The header info stored in the profile
@@ -6007,6 +6214,7 @@ static int header_flags(const struct rohc_comp_ctxt *const context,
  * @param counter        The current position in the rohc-packet-under-build
  *                       buffer
  * @return               The new position in the rohc-packet-under-build buffer
+ *                       if successful, -1 otherwise
  *
  * @see changed_fields
  */
@@ -6055,6 +6263,21 @@ static int header_fields(const struct rohc_comp_ctxt *const context,
 		counter++;
 	}
 
+	/* part 4: only for IPv6 header if the list of extension headers changed */
+	if(header_info->version == IPV6 &&
+	   is_field_changed(changed_f, MOD_IPV6_EXT_LIST_STRUCT |
+	                               MOD_IPV6_EXT_LIST_CONTENT))
+	{
+		rohc_comp_debug(context, "extension header list of IP header #%u: "
+		                "send some bits", ip_hdr_pos);
+		counter = rohc_list_encode(&header_info->info.v6.ext_comp, dest, counter);
+		if(counter < 0)
+		{
+			rohc_comp_warn(context, "failed to encode list");
+			goto error;
+		}
+	}
+
 	/* part 5: only for outer IP header if IPv4 */
 	if(ip_hdr_pos == ROHC_IP_HDR_FIRST && I == 1)
 	{
@@ -6069,6 +6292,9 @@ static int header_fields(const struct rohc_comp_ctxt *const context,
 	}
 
 	return counter;
+
+error:
+	return -1;
 }
 
 
@@ -6274,6 +6500,7 @@ static int changed_static_one_hdr(struct rohc_comp_ctxt *const context,
 		{
 			header_info->protocol_count = 0;
 			context->fo_count = 0;
+			context->static_chain_len = 0;
 		}
 		nb_fields += 1;
 	}
@@ -6737,6 +6964,8 @@ static bool encode_uncomp_fields(struct rohc_comp_ctxt *const context,
                                  const struct net_pkt *const uncomp_pkt)
 {
 	struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt = context->specific;
+	size_t nr_innermost_ip_id_bits;
+	size_t nr_outermost_ip_id_bits;
 
 	rohc_comp_debug(context, "compressor is in state %u", context->state);
 
@@ -6749,21 +6978,26 @@ static bool encode_uncomp_fields(struct rohc_comp_ctxt *const context,
 		if(context->profile->id == ROHC_PROFILE_RTP)
 		{
 			rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 =
-				wlsb_get_mink_16bits(&rfc3095_ctxt->sn_window, rfc3095_ctxt->sn, 5);
+				wlsb_get_minkp_16bits_memo(&rfc3095_ctxt->sn_window, rfc3095_ctxt->sn, 5,
+				                           rfc3095_ctxt->sn_window.p);
 			rfc3095_ctxt->tmp.nr_sn_bits_less_equal_than_4 =
-				wlsb_get_k_16bits(&rfc3095_ctxt->sn_window, rfc3095_ctxt->sn);
+				wlsb_get_minkp_16bits_memo(&rfc3095_ctxt->sn_window, rfc3095_ctxt->sn, 0,
+				                           rfc3095_ctxt->sn_window.p);
 		}
 		else if(context->profile->id == ROHC_PROFILE_ESP)
 		{
 			rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 =
-				wlsb_get_mink_32bits(&rfc3095_ctxt->sn_window, rfc3095_ctxt->sn, 5);
+				wlsb_get_minkp_32bits_memo(&rfc3095_ctxt->sn_window, rfc3095_ctxt->sn, 5,
+				                           rfc3095_ctxt->sn_window.p);
 			rfc3095_ctxt->tmp.nr_sn_bits_less_equal_than_4 =
-				wlsb_get_k_32bits(&rfc3095_ctxt->sn_window, rfc3095_ctxt->sn);
+				wlsb_get_minkp_32bits_memo(&rfc3095_ctxt->sn_window, rfc3095_ctxt->sn, 0,
+				                           rfc3095_ctxt->sn_window.p);
 		}
 		else
 		{
 			rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 =
-				wlsb_get_k_16bits(&rfc3095_ctxt->sn_window, rfc3095_ctxt->sn);
+				wlsb_get_minkp_16bits_memo(&rfc3095_ctxt->sn_window, rfc3095_ctxt->sn, 0,
+				                           rfc3095_ctxt->sn_window.p);
 			rfc3095_ctxt->tmp.nr_sn_bits_less_equal_than_4 =
 				rfc3095_ctxt->tmp.nr_sn_bits_more_than_4;
 		}
@@ -6809,8 +7043,9 @@ static bool encode_uncomp_fields(struct rohc_comp_ctxt *const context,
 		{
 			/* send only required bits in FO or SO states */
 			rfc3095_ctxt->tmp.nr_ip_id_bits =
-				wlsb_get_k_16bits(&rfc3095_ctxt->outer_ip_flags.info.v4.ip_id_window,
-				                  rfc3095_ctxt->outer_ip_flags.info.v4.id_delta);
+				wlsb_get_minkp_16bits_memo(&rfc3095_ctxt->outer_ip_flags.info.v4.ip_id_window,
+				                           rfc3095_ctxt->outer_ip_flags.info.v4.id_delta, 0,
+				                           rfc3095_ctxt->outer_ip_flags.info.v4.ip_id_window.p);
 		}
 		rohc_comp_debug(context, "%zd bits are required to encode new outer "
 		                "IP-ID delta", rfc3095_ctxt->tmp.nr_ip_id_bits);
@@ -6855,8 +7090,9 @@ static bool encode_uncomp_fields(struct rohc_comp_ctxt *const context,
 		{
 			/* send only required bits in FO or SO states */
 			rfc3095_ctxt->tmp.nr_ip_id_bits2 =
-				wlsb_get_k_16bits(&rfc3095_ctxt->inner_ip_flags.info.v4.ip_id_window,
-				                  rfc3095_ctxt->inner_ip_flags.info.v4.id_delta);
+				wlsb_get_minkp_16bits_memo(&rfc3095_ctxt->inner_ip_flags.info.v4.ip_id_window,
+				                           rfc3095_ctxt->inner_ip_flags.info.v4.id_delta, 0,
+				                           rfc3095_ctxt->inner_ip_flags.info.v4.ip_id_window.p);
 		}
 		rohc_comp_debug(context, "%zd bits are required to encode new inner "
 		                "IP-ID delta", rfc3095_ctxt->tmp.nr_ip_id_bits2);
@@ -6870,6 +7106,18 @@ static bool encode_uncomp_fields(struct rohc_comp_ctxt *const context,
 		rfc3095_ctxt->tmp.nr_ip_id_bits2 = 0;
 	}
 
+	/* gather the numbers of bits once for the selection of the packet type
+	 * and of the extension, the profile completes them with its own fields */
+	rohc_get_ipid_bits(context, &nr_innermost_ip_id_bits,
+	                   &nr_outermost_ip_id_bits);
+	rfc3095_ctxt->tmp.bits.sn_le4 = rfc3095_ctxt->tmp.nr_sn_bits_less_equal_than_4;
+	rfc3095_ctxt->tmp.bits.sn_gt4 = rfc3095_ctxt->tmp.nr_sn_bits_more_than_4;
+	rfc3095_ctxt->tmp.bits.ip_id_innermost = nr_innermost_ip_id_bits;
+	rfc3095_ctxt->tmp.bits.ip_id_outermost = nr_outermost_ip_id_bits;
+	rfc3095_ctxt->tmp.bits.ts = 0;
+	rfc3095_ctxt->tmp.bits.ts_deducible = false;
+	rfc3095_ctxt->tmp.bits.marker = false;
+
 	/* update info related to transport header */
 	if(rfc3095_ctxt->encode_uncomp_fields != NULL &&
 	   !rfc3095_ctxt->encode_uncomp_fields(context, uncomp_pkt))
@@ -6899,8 +7147,6 @@ error:
 rohc_ext_t decide_extension(const struct rohc_comp_ctxt *const context)
 {
 	const struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt = context->specific;
-	size_t nr_innermost_ip_id_bits;
-	size_t nr_outermost_ip_id_bits;
 	rohc_ext_t ext;
 
 	/* force extension type 3 if at least one static or dynamic field changed */
@@ -6912,32 +7158,22 @@ rohc_ext_t decide_extension(const struct rohc_comp_ctxt *const context)
 	}
 	else
 	{
-		/* determine the number of IP-ID bits and the IP-ID offset of the
-		 * innermost IPv4 header with non-random IP-ID */
-		rohc_get_ipid_bits(context, &nr_innermost_ip_id_bits,
-		                   &nr_outermost_ip_id_bits);
-
 		switch(rfc3095_ctxt->tmp.packet_type)
 		{
 			case ROHC_PACKET_UOR_2:
-				ext = decide_extension_uor2(context, nr_innermost_ip_id_bits,
-				                            nr_outermost_ip_id_bits);
+				ext = decide_extension_from_rules(context, rohc_ext_rules_uor2);
 				break;
 			case ROHC_PACKET_UOR_2_RTP:
-				ext = decide_extension_uor2rtp(context, nr_innermost_ip_id_bits,
-				                               nr_outermost_ip_id_bits);
+				ext = decide_extension_from_rules(context, rohc_ext_rules_uor2rtp);
 				break;
 			case ROHC_PACKET_UOR_2_TS:
-				ext = decide_extension_uor2ts(context, nr_innermost_ip_id_bits,
-				                              nr_outermost_ip_id_bits);
+				ext = decide_extension_from_rules(context, rohc_ext_rules_uor2ts);
 				break;
 			case ROHC_PACKET_UOR_2_ID:
-				ext = decide_extension_uor2id(context, nr_innermost_ip_id_bits,
-				                              nr_outermost_ip_id_bits);
+				ext = decide_extension_from_rules(context, rohc_ext_rules_uor2id);
 				break;
 			case ROHC_PACKET_UO_1_ID:
-				ext = decide_extension_uo1id(context, nr_innermost_ip_id_bits,
-				                             nr_outermost_ip_id_bits);
+				ext = decide_extension_from_rules(context, rohc_ext_rules_uo1id);
 				break;
 			default:
 				rohc_assert(context->compressor, ROHC_TRACE_COMP, context->profile->id,
@@ -6954,296 +7190,42 @@ error:
 
 
 /**
- * @brief Decide what extension shall be used in the UOR-2 packet (non-RTP).
- *
- * Extensions 0, 1 & 2 are IPv4 only because of the IP-ID.
- *
- * @param context                  The compression context
- * @param nr_innermost_ip_id_bits  The number of IP-ID bits of the innermost
- *                                 IPv4 header
- * @param nr_outermost_ip_id_bits  The number of IP-ID bits of the outermost
- *                                 IPv4 header
- * @return                         The extension code among ROHC_EXT_NONE,
- *                                 ROHC_EXT_0, ROHC_EXT_1 and ROHC_EXT_3
- */
-static rohc_ext_t decide_extension_uor2(const struct rohc_comp_ctxt *const context,
-                                        const size_t nr_innermost_ip_id_bits,
-                                        const size_t nr_outermost_ip_id_bits)
-{
-	const struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt = context->specific;
-	rohc_ext_t ext;
-
-	if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 5 &&
-	   nr_innermost_ip_id_bits == 0 &&
-	   nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_NONE;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 8 &&
-	        nr_innermost_ip_id_bits != 0 && nr_innermost_ip_id_bits <= 3 &&
-	        nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_0;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 8 &&
-	        nr_innermost_ip_id_bits != 0 && nr_innermost_ip_id_bits <= 11 &&
-	        nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_1;
-	}
-	else if(rfc3095_ctxt->ip_hdr_nr > 1 &&
-	        rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 8 &&
-	        nr_innermost_ip_id_bits != 0 && nr_innermost_ip_id_bits <= 8 &&
-	        nr_outermost_ip_id_bits <= 11)
-	{
-		ext = ROHC_EXT_2;
-	}
-	else
-	{
-		ext = ROHC_EXT_3;
-	}
-
-	return ext;
-}
-
-
-/**
- * @brief Decide what extension shall be used in the UOR-2 packet (RTP).
+ * @brief Decide what extension shall be used according to a set of rules
  *
- * Extensions 0, 1 & 2 are IPv4 only because of the IP-ID.
+ * The rules are checked in order, the first one that matches the numbers of
+ * bits required by the packet gives the extension. Extension 3 is used if no
+ * rule matches.
  *
- * @param context                  The compression context
- * @param nr_innermost_ip_id_bits  The number of IP-ID bits of the innermost
- *                                 IPv4 header
- * @param nr_outermost_ip_id_bits  The number of IP-ID bits of the outermost
- *                                 IPv4 header
- * @return                         The extension code among ROHC_EXT_NONE,
- *                                 ROHC_EXT_0, ROHC_EXT_1 and ROHC_EXT_3
- */
-static rohc_ext_t decide_extension_uor2rtp(const struct rohc_comp_ctxt *const context,
-                                           const size_t nr_innermost_ip_id_bits,
-                                           const size_t nr_outermost_ip_id_bits)
-{
-	const struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt = context->specific;
-	const struct sc_rtp_context *const rtp_context = rfc3095_ctxt->specific;
-	const size_t nr_ts_bits = rtp_context->tmp.nr_ts_bits_more_than_2;
-	rohc_ext_t ext;
-
-	if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 6 &&
-	   nr_ts_bits <= 6 &&
-	   nr_innermost_ip_id_bits == 0 &&
-	   nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_NONE;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 9 &&
-	        nr_ts_bits <= 9 &&
-	        nr_innermost_ip_id_bits == 0 &&
-	        nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_0;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 9 &&
-	        nr_ts_bits <= 17 &&
-	        nr_innermost_ip_id_bits == 0 &&
-	        nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_1;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 9 &&
-	        nr_ts_bits <= 25 &&
-	        nr_innermost_ip_id_bits == 0 &&
-	        nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_2;
-	}
-	else
-	{
-		ext = ROHC_EXT_3;
-	}
-
-	return ext;
-}
-
-
-/**
- * @brief Decide what extension shall be used in the UO-1-ID/UOR-2 packet.
- *
- * Extensions 0, 1 & 2 are IPv4 only because of the IP-ID.
- *
- * @param context                  The compression context
- * @param nr_innermost_ip_id_bits  The number of IP-ID bits of the innermost
- *                                 IPv4 header
- * @param nr_outermost_ip_id_bits  The number of IP-ID bits of the outermost
- *                                 IPv4 header
- * @return                         The extension code among ROHC_EXT_NONE,
- *                                 ROHC_EXT_0, ROHC_EXT_1 and ROHC_EXT_3
- */
-static rohc_ext_t decide_extension_uor2ts(const struct rohc_comp_ctxt *const context,
-                                          const size_t nr_innermost_ip_id_bits,
-                                          const size_t nr_outermost_ip_id_bits)
-{
-	const struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt = context->specific;
-	const struct sc_rtp_context *const rtp_context = rfc3095_ctxt->specific;
-	const size_t nr_ts_bits = rtp_context->tmp.nr_ts_bits_more_than_2;
-	rohc_ext_t ext;
-
-	if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 6 &&
-	   nr_ts_bits <= 5 &&
-	   nr_innermost_ip_id_bits == 0 &&
-	   nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_NONE;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 9 &&
-	        nr_ts_bits <= 8 &&
-	        nr_innermost_ip_id_bits == 0 &&
-	        nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_0;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 9 &&
-	        nr_ts_bits <= 8 &&
-	        nr_innermost_ip_id_bits <= 8 &&
-	        nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_1;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 9 &&
-	        nr_ts_bits <= 16 &&
-	        nr_innermost_ip_id_bits <= 8 &&
-	        nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_2;
-	}
-	else
-	{
-		ext = ROHC_EXT_3;
-	}
-
-	return ext;
-}
-
-
-/**
- * @brief Decide what extension shall be used in the UOR-2-ID packet.
- *
- * Extensions 0, 1 & 2 are IPv4 only because of the IP-ID.
- *
- * @param context                  The compression context
- * @param nr_innermost_ip_id_bits  The number of IP-ID bits of the innermost
- *                                 IPv4 header
- * @param nr_outermost_ip_id_bits  The number of IP-ID bits of the outermost
- *                                 IPv4 header
- * @return                         The extension code among ROHC_EXT_NONE,
- *                                 ROHC_EXT_0, ROHC_EXT_1 and ROHC_EXT_3
+ * @param context  The compression context
+ * @param rules    The rules of the packet type, terminated by ROHC_EXT_3
+ * @return         The extension code among ROHC_EXT_NONE, ROHC_EXT_0,
+ *                 ROHC_EXT_1, ROHC_EXT_2 and ROHC_EXT_3
  */
-static rohc_ext_t decide_extension_uor2id(const struct rohc_comp_ctxt *const context,
-                                          const size_t nr_innermost_ip_id_bits,
-                                          const size_t nr_outermost_ip_id_bits)
+static rohc_ext_t decide_extension_from_rules(const struct rohc_comp_ctxt *const context,
+                                              const struct rohc_ext_rule *const rules)
 {
 	const struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt = context->specific;
-	const struct sc_rtp_context *const rtp_context = rfc3095_ctxt->specific;
-	const size_t nr_ts_bits = rtp_context->tmp.nr_ts_bits_more_than_2;
-	rohc_ext_t ext;
+	const struct rohc_comp_rfc3095_bits *const bits = &rfc3095_ctxt->tmp.bits;
+	const struct rohc_ext_rule *rule;
 
-	if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 6 &&
-	   (nr_ts_bits == 0 || rohc_ts_sc_is_deducible(&rtp_context->ts_sc)) &&
-	   nr_innermost_ip_id_bits <= 5 &&
-	   nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_NONE;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 9 &&
-	        (nr_ts_bits == 0 || rohc_ts_sc_is_deducible(&rtp_context->ts_sc)) &&
-	        nr_innermost_ip_id_bits <= 8 &&
-	        nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_0;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 9 &&
-	        nr_ts_bits <= 8 &&
-	        nr_innermost_ip_id_bits <= 8 &&
-	        nr_outermost_ip_id_bits == 0)
-	{
-		ext = ROHC_EXT_1;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 9 &&
-	        nr_ts_bits <= 8 &&
-	        nr_innermost_ip_id_bits <= 16 &&
-	        nr_outermost_ip_id_bits == 0)
+	for(rule = rules; rule->ext != ROHC_EXT_3; rule++)
 	{
-		ext = ROHC_EXT_2;
-	}
-	else
-	{
-		ext = ROHC_EXT_3;
-	}
-
-	return ext;
-}
-
-
-/**
- * @brief Decide what extension shall be used in the UO-1-ID packet.
- *
- * Extensions 0, 1 & 2 are IPv4 only because of the IP-ID.
- *
- * @param context                  The compression context
- * @param nr_innermost_ip_id_bits  The number of IP-ID bits of the innermost
- *                                 IPv4 header
- * @param nr_outermost_ip_id_bits  The number of IP-ID bits of the outermost
- *                                 IPv4 header
- * @return                         The extension code among ROHC_EXT_NONE,
- *                                 ROHC_EXT_0, ROHC_EXT_1 and ROHC_EXT_3
- */
-static rohc_ext_t decide_extension_uo1id(const struct rohc_comp_ctxt *const context,
-                                         const size_t nr_innermost_ip_id_bits,
-                                         const size_t nr_outermost_ip_id_bits)
-{
-	const struct rohc_comp_rfc3095_ctxt *const rfc3095_ctxt = context->specific;
-	const struct sc_rtp_context *const rtp_context = rfc3095_ctxt->specific;
-	const size_t nr_ts_bits = rtp_context->tmp.nr_ts_bits_more_than_2;
-	rohc_ext_t ext;
+		const uint8_t sn_bits = (rule->sn_le4 ? bits->sn_le4 : bits->sn_gt4);
 
-	if(rfc3095_ctxt->tmp.nr_sn_bits_less_equal_than_4 <= 4 &&
-	   (nr_ts_bits == 0 || rohc_ts_sc_is_deducible(&rtp_context->ts_sc)) &&
-	   nr_innermost_ip_id_bits <= 5 &&
-	   nr_outermost_ip_id_bits == 0 &&
-	   !rtp_context->tmp.is_marker_bit_set)
-	{
-		ext = ROHC_EXT_NONE;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 7 &&
-	        (nr_ts_bits == 0 || rohc_ts_sc_is_deducible(&rtp_context->ts_sc)) &&
-	        nr_innermost_ip_id_bits <= 8 &&
-	        nr_outermost_ip_id_bits == 0 &&
-	        !rtp_context->tmp.is_marker_bit_set)
-	{
-		ext = ROHC_EXT_0;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 7 &&
-	        nr_ts_bits <= 8 &&
-	        nr_innermost_ip_id_bits <= 8 &&
-	        nr_outermost_ip_id_bits == 0 &&
-	        !rtp_context->tmp.is_marker_bit_set)
-	{
-		ext = ROHC_EXT_1;
-	}
-	else if(rfc3095_ctxt->tmp.nr_sn_bits_more_than_4 <= 7 &&
-	        nr_ts_bits <= 8 &&
-	        nr_innermost_ip_id_bits <= 16 &&
-	        nr_outermost_ip_id_bits == 0 &&
-	        !rtp_context->tmp.is_marker_bit_set)
-	{
-		ext = ROHC_EXT_2;
-	}
-	else
-	{
-		ext = ROHC_EXT_3;
+		if(rfc3095_ctxt->ip_hdr_nr >= rule->ip_hdr_nr_min &&
+		   sn_bits <= rule->sn_max &&
+		   (bits->ts <= rule->ts_max ||
+		    (rule->ts_deducible_ok && bits->ts_deducible)) &&
+		   bits->ip_id_innermost >= rule->ip_id_inner_min &&
+		   bits->ip_id_innermost <= rule->ip_id_inner_max &&
+		   bits->ip_id_outermost <= rule->ip_id_outer_max &&
+		   (!rule->no_marker || !bits->marker))
+		{
+			break;
+		}
 	}
 
-	return ext;
+	return rule->ext;
 }
 
 
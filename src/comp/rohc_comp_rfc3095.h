@@ -136,6 +136,34 @@ struct ip_header_info
 };
 
 
+/**
+ * @brief The numbers of bits required to transmit the fields of one packet
+ *
+ * The numbers of bits are gathered once per packet, after the fields were
+ * encoded. The packet type and the extension are then selected from them.
+ */
+struct rohc_comp_rfc3095_bits
+{
+	/** The number of SN bits required in a field of 4 bits or less */
+	uint8_t sn_le4;
+	/** The number of SN bits required in a field of more than 4 bits */
+	uint8_t sn_gt4;
+	/** The number of IP-ID bits of the innermost IPv4 header with a
+	 *  non-random IP-ID */
+	uint8_t ip_id_innermost;
+	/** The number of IP-ID bits of the outermost IPv4 header with a
+	 *  non-random IP-ID */
+	uint8_t ip_id_outermost;
+	/** The number of TS bits required in a field of more than 2 bits
+	 *  (RTP profile only) */
+	uint8_t ts;
+	/** Whether the TS is deducible from the SN (RTP profile only) */
+	bool ts_deducible;
+	/** Whether the RTP Marker bit is set (RTP profile only) */
+	bool marker;
+};
+
+
 /**
  * @brief Structure that contains variables that are used during one single
  *        compression of packet.
@@ -167,6 +195,9 @@ struct generic_tmp_vars
 	/// The number of bits needed to encode the IP-ID of the inner IP header
 	size_t nr_ip_id_bits2;
 
+	/** The numbers of bits required to transmit the fields of the packet */
+	struct rohc_comp_rfc3095_bits bits;
+
 	/// The type of packet the compressor must send: IR, IR-DYN, UO*
 	rohc_packet_t packet_type;
 };
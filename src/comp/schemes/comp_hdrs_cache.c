@@ -0,0 +1,198 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   src/comp/schemes/comp_hdrs_cache.c
+ * @brief  Word-wise detection of the changes in the uncompressed headers
+ * @author agent <agent@local>
+ */
+
+#include "comp_hdrs_cache.h"
+
+#include <string.h>
+#include <assert.h>
+
+
+/**
+ * @brief Forget the cached header chain
+ *
+ * The next header chain compared against the cache is considered as fully
+ * changed.
+ *
+ * @param[in,out] cache  The header cache to reset
+ */
+void c_hdrs_cache_reset(struct c_hdrs_cache *const cache)
+{
+	cache->len = 0;
+}
+
+
+/**
+ * @brief Start the classification of a new header chain
+ *
+ * All the bits of the new header chain are classified as transmitted dynamic
+ * fields until the profile classifies them otherwise.
+ *
+ * @param[in,out] cache  The header cache
+ * @param len            The length of the new header chain
+ * @return               true if the header chain may be cached,
+ *                       false if it is too long to be cached
+ */
+bool c_hdrs_cache_set_len(struct c_hdrs_cache *const cache, const size_t len)
+{
+	if(len == 0 || len > ROHC_HDRS_CACHE_MAX)
+	{
+		cache->len = 0;
+		return false;
+	}
+
+	cache->len = len;
+	memset(cache->static_mask, 0, len);
+	memset(cache->inferred_mask, 0, len);
+	memset(cache->dyn_mask, 0xff, len);
+
+	return true;
+}
+
+
+/**
+ * @brief Classify some bits of some bytes of the cached header chain
+ *
+ * @param[in,out] cache  The header cache
+ * @param offset         The offset of the first byte to classify
+ * @param len            The number of bytes to classify
+ * @param bits           The bits to classify in every byte
+ * @param class          The class of the bits
+ */
+void c_hdrs_cache_classify(struct c_hdrs_cache *const cache,
+                           const size_t offset,
+                           const size_t len,
+                           const uint8_t bits,
+                           const rohc_hdrs_class_t class)
+{
+	size_t i;
+
+	assert((offset + len) <= cache->len);
+
+	for(i = offset; i < (offset + len); i++)
+	{
+		cache->static_mask[i] &= ~bits;
+		cache->inferred_mask[i] &= ~bits;
+		cache->dyn_mask[i] &= ~bits;
+
+		switch(class)
+		{
+			case ROHC_HDRS_STATIC:
+				cache->static_mask[i] |= bits;
+				break;
+			case ROHC_HDRS_INFERRED:
+				cache->inferred_mask[i] |= bits;
+				break;
+			case ROHC_HDRS_DYNAMIC:
+			default:
+				cache->dyn_mask[i] |= bits;
+				break;
+		}
+	}
+}
+
+
+/**
+ * @brief Record the header chain of the last packet
+ *
+ * @param[in,out] cache  The header cache
+ * @param hdrs           The header chain, at least \e cache->len bytes long
+ */
+void c_hdrs_cache_store(struct c_hdrs_cache *const cache,
+                        const uint8_t *const hdrs)
+{
+	memcpy(cache->hdrs, hdrs, cache->len);
+}
+
+
+/**
+ * @brief Find out which classes of fields changed since the last packet
+ *
+ * The header chains are compared 64 bits at a time, only the trailing bytes
+ * are compared one by one.
+ *
+ * @param cache     The header cache
+ * @param hdrs      The header chain of the new packet
+ * @param hdrs_len  The length of the data available at \e hdrs
+ * @return          The classes of the fields that changed, see
+ *                  \ref rohc_hdrs_class_t, \ref ROHC_HDRS_ALL if nothing is
+ *                  cached or if the new header chain is too short
+ */
+uint8_t c_hdrs_cache_cmp(const struct c_hdrs_cache *const cache,
+                         const uint8_t *const hdrs,
+                         const size_t hdrs_len)
+{
+	uint64_t static_diff = 0;
+	uint64_t inferred_diff = 0;
+	uint64_t dyn_diff = 0;
+	uint8_t changed = 0;
+	size_t i;
+
+	if(cache->len == 0 || hdrs_len < cache->len)
+	{
+		return ROHC_HDRS_ALL;
+	}
+
+	for(i = 0; (i + sizeof(uint64_t)) <= cache->len; i += sizeof(uint64_t))
+	{
+		uint64_t old_word;
+		uint64_t new_word;
+		uint64_t mask;
+		uint64_t diff;
+
+		memcpy(&old_word, cache->hdrs + i, sizeof(uint64_t));
+		memcpy(&new_word, hdrs + i, sizeof(uint64_t));
+		diff = old_word ^ new_word;
+
+		memcpy(&mask, cache->static_mask + i, sizeof(uint64_t));
+		static_diff |= diff & mask;
+		memcpy(&mask, cache->inferred_mask + i, sizeof(uint64_t));
+		inferred_diff |= diff & mask;
+		memcpy(&mask, cache->dyn_mask + i, sizeof(uint64_t));
+		dyn_diff |= diff & mask;
+	}
+	for( ; i < cache->len; i++)
+	{
+		const uint8_t diff = cache->hdrs[i] ^ hdrs[i];
+
+		static_diff |= diff & cache->static_mask[i];
+		inferred_diff |= diff & cache->inferred_mask[i];
+		dyn_diff |= diff & cache->dyn_mask[i];
+	}
+
+	if(static_diff != 0)
+	{
+		changed |= ROHC_HDRS_STATIC;
+	}
+	if(inferred_diff != 0)
+	{
+		changed |= ROHC_HDRS_INFERRED;
+	}
+	if(dyn_diff != 0)
+	{
+		changed |= ROHC_HDRS_DYNAMIC;
+	}
+
+	return changed;
+}
+
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   src/comp/schemes/comp_hdrs_cache.h
+ * @brief  Word-wise detection of the changes in the uncompressed headers
+ * @author agent <agent@local>
+ */
+
+#ifndef ROHC_COMP_HDRS_CACHE_H
+#define ROHC_COMP_HDRS_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+
+/** The maximum length (in bytes) of the header chain that may be cached */
+#define ROHC_HDRS_CACHE_MAX  128U
+
+
+/** The classes of the bits of the cached header chain */
+typedef enum
+{
+	/** The static fields: a change requires a new context or the static chain */
+	ROHC_HDRS_STATIC   = (1 << 0),
+	/** The dynamic fields that are inferred (lengths, checksums) or encoded
+	 *  in every packet (IP-ID, TCP sequence and ACK numbers) */
+	ROHC_HDRS_INFERRED = (1 << 1),
+	/** The other dynamic fields: they are transmitted only when they change */
+	ROHC_HDRS_DYNAMIC  = (1 << 2),
+} rohc_hdrs_class_t;
+
+/** All the classes of the bits of the cached header chain */
+#define ROHC_HDRS_ALL  (ROHC_HDRS_STATIC | ROHC_HDRS_INFERRED | ROHC_HDRS_DYNAMIC)
+
+
+/**
+ * @brief The copy of the last header chain of one compression context
+ *
+ * The profile classifies every bit of the header chain once, when the
+ * structure of the header chain changes. The header chain of every new packet
+ * is then compared against the copy of the last one with a few XOR and AND
+ * operations on 64-bit words. Only the classes of fields that changed need to
+ * be checked field by field.
+ */
+struct c_hdrs_cache
+{
+	/** The length of the cached header chain, 0 if nothing is cached */
+	size_t len;
+	/** The copy of the last header chain */
+	uint8_t hdrs[ROHC_HDRS_CACHE_MAX];
+	/** The bits of the static fields */
+	uint8_t static_mask[ROHC_HDRS_CACHE_MAX];
+	/** The bits of the inferred dynamic fields */
+	uint8_t inferred_mask[ROHC_HDRS_CACHE_MAX];
+	/** The bits of the transmitted dynamic fields */
+	uint8_t dyn_mask[ROHC_HDRS_CACHE_MAX];
+};
+
+
+void c_hdrs_cache_reset(struct c_hdrs_cache *const cache)
+	__attribute__((nonnull(1)));
+
+bool c_hdrs_cache_set_len(struct c_hdrs_cache *const cache, const size_t len)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+void c_hdrs_cache_classify(struct c_hdrs_cache *const cache,
+                           const size_t offset,
+                           const size_t len,
+                           const uint8_t bits,
+                           const rohc_hdrs_class_t class)
+	__attribute__((nonnull(1)));
+
+void c_hdrs_cache_store(struct c_hdrs_cache *const cache,
+                        const uint8_t *const hdrs)
+	__attribute__((nonnull(1, 2)));
+
+uint8_t c_hdrs_cache_cmp(const struct c_hdrs_cache *const cache,
+                         const uint8_t *const hdrs,
+                         const size_t hdrs_len)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
+
+#endif
+
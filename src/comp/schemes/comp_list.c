@@ -41,6 +41,12 @@ static bool build_ipv6_ext_pkt_list(struct list_comp *const comp,
                                     struct rohc_list *const pkt_list)
 	__attribute__((warn_unused_result, nonnull(1, 2, 3)));
 
+static bool rohc_list_item_is_srh_update(const struct rohc_list_item *const item,
+                                         const uint8_t ext_type,
+                                         const uint8_t *const ext_data,
+                                         const size_t ext_len)
+	__attribute__((warn_unused_result, nonnull(1, 3), pure));
+
 static unsigned int rohc_list_get_nearest_list(const struct list_comp *const comp,
                                                const struct rohc_list *const pkt_list,
                                                bool *const is_new_list)
@@ -116,6 +122,10 @@ static int rohc_list_build_XIs_4(const struct list_comp *const comp,
                                  uint8_t *const first_4b_xi)
 	__attribute__((warn_unused_result, nonnull(1, 2, 4, 6)));
 
+static size_t rohc_list_encode_item(const struct rohc_list_item *const item,
+                                    uint8_t *const dest)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
+
 
 
 /**
@@ -250,7 +260,9 @@ static bool build_ipv6_ext_pkt_list(struct list_comp *const comp,
 	 *  - create the list for the packet */
 	do
 	{
+		struct rohc_list_item *item;
 		bool entry_changed = false;
+		size_t ext_len;
 		int index_table;
 		int ret;
 
@@ -272,17 +284,35 @@ static bool build_ipv6_ext_pkt_list(struct list_comp *const comp,
 			goto error;
 		}
 
+		item = &(comp->trans_table[index_table]);
+		ext_len = comp->get_size(ext);
+
 		/* update item in translation table if it changed */
 		/* TODO: context should not be overwritten until compression is fully OK */
 		/* TODO: put comp const in params once context is not overwritten any more */
-		ret = rohc_list_item_update_if_changed(comp->cmp_item,
-		                                       &(comp->trans_table[index_table]),
-		                                       ext_type, ext, comp->get_size(ext));
+		if(comp->srh_updates &&
+		   rohc_list_item_is_srh_update(item, ext_type, ext, ext_len))
+		{
+			/* the decompressor already knows the segment list, transmit the
+			 * fixed part of the Segment Routing Header only */
+			memcpy(item->data, ext, ext_len);
+			item->known = false;
+			item->counter = 0;
+			item->fixed_part_only = true;
+			rc_list_debug(comp, "  only the fixed part of the Segment Routing "
+			              "Header changed");
+			ret = 1;
+		}
+		else
+		{
+			ret = rohc_list_item_update_if_changed(comp->cmp_item, item,
+			                                       ext_type, ext, ext_len);
+		}
 		if(ret < 0)
 		{
 			rohc_comp_list_warn(comp, "failed to update entry #%d in translation "
-			                    "table with %u-byte extension", index_table,
-			                    comp->get_size(ext));
+			                    "table with %zu-byte extension", index_table,
+			                    ext_len);
 			goto error;
 		}
 		else if(ret == 1)
@@ -321,6 +351,57 @@ error:
 }
 
 
+/**
+ * @brief Whether only the fixed part of a Segment Routing Header changed
+ *
+ * The fixed part of the IPv6 Segment Routing Header (SRH) contains the
+ * Segments Left, Last Entry, Flags and Tag fields. It may be transmitted
+ * alone if the decompressor already knows the segment list and the TLVs that
+ * follow it.
+ *
+ * @param item      The item in the translation table
+ * @param ext_type  The IPv6 Next Header type of the extension header
+ * @param ext_data  The extension header in the packet
+ * @param ext_len   The length (in bytes) of the extension header
+ * @return          true if only the fixed part of the SRH changed,
+ *                  false if the SRH did not change or if its segment list
+ *                  changed or is not known by the decompressor
+ */
+static bool rohc_list_item_is_srh_update(const struct rohc_list_item *const item,
+                                         const uint8_t ext_type,
+                                         const uint8_t *const ext_data,
+                                         const size_t ext_len)
+{
+	const size_t fixed_len = sizeof(struct ipv6_srh);
+
+	if(ext_type != ROHC_IPPROTO_ROUTING || item->type != RTHDR)
+	{
+		return false;
+	}
+	if(item->length != ext_len || ext_len <= fixed_len)
+	{
+		return false;
+	}
+	if(ext_data[2] != IPV6_ROUTING_TYPE_SRH ||
+	   item->data[2] != IPV6_ROUTING_TYPE_SRH)
+	{
+		return false;
+	}
+
+	/* the segment list shall be known by the decompressor: either the whole
+	 * item was transmitted enough times, or only its fixed part was updated
+	 * since then */
+	if(!item->known && !item->fixed_part_only)
+	{
+		return false;
+	}
+
+	return (memcmp(item->data + fixed_len, ext_data + fixed_len,
+	               ext_len - fixed_len) == 0 &&
+	        memcmp(item->data + 2, ext_data + 2, fixed_len - 2) != 0);
+}
+
+
 /**
  * @brief Generic encoding of compressed list
  *
@@ -920,12 +1001,10 @@ static int rohc_list_encode_type_0(struct list_comp *const comp,
 		/* copy the list element if not known yet */
 		if(!item->known)
 		{
+			const size_t item_len = rohc_list_encode_item(item, dest + counter);
 			rc_list_debug(comp, "add %zu-byte not-yet-known item #%zu in "
-			              "packet", item->length, k);
-			assert(item->length > 1);
-			dest[counter] = item->type & 0xff;
-			memcpy(dest + counter + 1, item->data + 1, item->length - 1);
-			counter += item->length;
+			              "packet", item_len, k);
+			counter += item_len;
 		}
 	}
 
@@ -1112,12 +1191,10 @@ static int rohc_list_encode_type_1(struct list_comp *const comp,
 		/* copy the list element if not known yet */
 		if(!item->known)
 		{
+			const size_t item_len = rohc_list_encode_item(item, dest + counter);
 			rc_list_debug(comp, "add %zu-byte unknown item #%zu in packet",
-			              item->length, k);
-			assert(item->length > 1);
-			dest[counter] = item->type & 0xff;
-			memcpy(dest + counter + 1, item->data + 1, item->length - 1);
-			counter += item->length;
+			              item_len, k);
+			counter += item_len;
 		}
 	}
 
@@ -1449,12 +1526,10 @@ static int rohc_list_encode_type_3(struct list_comp *const comp,
 		/* copy the list element if not known yet */
 		if(!item->known)
 		{
+			const size_t item_len = rohc_list_encode_item(item, dest + counter);
 			rc_list_debug(comp, "add %zu-byte unknown item #%zu in packet",
-			              item->length, k);
-			assert(item->length > 1);
-			dest[counter] = item->type & 0xff;
-			memcpy(dest + counter + 1, item->data + 1, item->length - 1);
-			counter += item->length;
+			              item_len, k);
+			counter += item_len;
 		}
 	}
 
@@ -2024,3 +2099,40 @@ error:
 	return -1;
 }
 
+
+/**
+ * @brief Write one list item in the ROHC packet
+ *
+ * The Next Header byte of the item is replaced by the type of the item. Only
+ * the fixed part of a Segment Routing Header is written if its segment list
+ * is already known by the decompressor: its Hdr Ext Len is then set to 0, a
+ * value that no valid SRH uses since an SRH contains at least one segment.
+ *
+ * @param item  The item to write
+ * @param dest  The ROHC packet under build
+ * @return      The length (in bytes) of the item in the ROHC packet
+ */
+static size_t rohc_list_encode_item(const struct rohc_list_item *const item,
+                                    uint8_t *const dest)
+{
+	size_t item_len;
+
+	assert(item->length > 1);
+	dest[0] = item->type & 0xff;
+
+	if(item->fixed_part_only)
+	{
+		item_len = sizeof(struct ipv6_srh);
+		assert(item->length > item_len);
+		dest[1] = 0;
+		memcpy(dest + 2, item->data + 2, item_len - 2);
+	}
+	else
+	{
+		item_len = item->length;
+		memcpy(dest + 1, item->data + 1, item_len - 1);
+	}
+
+	return item_len;
+}
+
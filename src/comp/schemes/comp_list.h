@@ -55,6 +55,9 @@ struct list_comp
 
 	/** The number of uncompressed transmissions for list compression (L) */
 	size_t list_trans_nr;
+	/** Whether the Segment Routing Headers may be updated without their
+	 *  unchanged segment list (non-standard) */
+	bool srh_updates;
 
 	/* Functions for handling the data to compress */
 
@@ -44,12 +44,15 @@ static bool cmp_ipv6_ext(const struct rohc_list_item *const item,
  *
  * @param comp            The context to create
  * @param list_trans_nr   The number of uncompressed transmissions (L)
+ * @param srh_updates     Whether the Segment Routing Headers may be updated
+ *                        without their unchanged segment list (non-standard)
  * @param trace_cb        The function to call for printing traces
  * @param trace_cb_priv   An optional private context, may be NULL
  * @param profile_id      The ID of the associated decompression profile
  */
 void rohc_comp_list_ipv6_new(struct list_comp *const comp,
                              const size_t list_trans_nr,
+                             const bool srh_updates,
                              rohc_trace_callback2_t trace_cb,
                              void *const trace_cb_priv,
                              const int profile_id)
@@ -73,6 +76,7 @@ void rohc_comp_list_ipv6_new(struct list_comp *const comp,
 	}
 
 	comp->list_trans_nr = list_trans_nr;
+	comp->srh_updates = srh_updates;
 
 	/* specific callbacks for IPv6 extension headers */
 	comp->get_size = ip_get_extension_size;
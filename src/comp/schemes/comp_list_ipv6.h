@@ -31,6 +31,7 @@
 
 void rohc_comp_list_ipv6_new(struct list_comp *const comp,
                              const size_t list_trans_nr,
+                             const bool srh_updates,
                              rohc_trace_callback2_t trace_cb,
                              void *const trace_cb_priv,
                              const int profile_id)
@@ -0,0 +1,198 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   src/comp/schemes/comp_reorder_ratio.c
+ * @brief  Adaptive reorder ratio for the MSN of the ROHCv2 profiles
+ * @author agent <agent@local>
+ */
+
+#include "comp_reorder_ratio.h"
+#include "interval.h"
+
+#include <assert.h>
+
+
+/*
+ * Private function prototypes:
+ */
+
+static bool c_reorder_ratio_reordered(struct c_reorder_ratio *const reorder,
+                                      const uint32_t depth)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Initialize the reordering state of one ROHCv2 context
+ *
+ * @param[out] reorder    The reordering state to initialize
+ * @param ratio           The reorder ratio configured for the compressor, it
+ *                        is the initial and the minimal reorder ratio
+ * @param msn_bits_nr     The number of bits of the MSN (16 or 32)
+ */
+void c_reorder_ratio_init(struct c_reorder_ratio *const reorder,
+                          const rohc_reordering_offset_t ratio,
+                          const size_t msn_bits_nr)
+{
+	assert(msn_bits_nr == 16 || msn_bits_nr == 32);
+
+	reorder->ratio = ratio;
+	reorder->ratio_min = ratio;
+	reorder->msn_mask = (msn_bits_nr == 32 ? 0xffffffffU : 0xffffU);
+	reorder->is_msn_max_init = false;
+	reorder->msn_max = 0;
+	reorder->is_msn_acked_init = false;
+	reorder->msn_acked_max = 0;
+	reorder->in_order_acks_nr = 0;
+}
+
+
+/**
+ * @brief Record the MSN of a new packet given to the compressor
+ *
+ * The MSN of some profiles (eg. the ESP sequence number) is not generated by
+ * the compressor: a MSN smaller than a previous one means that the packets
+ * are already reordered before the compressor, so they will be received out
+ * of order by the decompressor.
+ *
+ * @param reorder  The reordering state of the context
+ * @param msn      The MSN of the new packet
+ * @return         true if the reorder ratio changed, false otherwise
+ */
+bool c_reorder_ratio_add_msn(struct c_reorder_ratio *const reorder,
+                             const uint32_t msn)
+{
+	const uint32_t depth = (reorder->msn_max - msn) & reorder->msn_mask;
+
+	if(!reorder->is_msn_max_init || depth == 0 ||
+	   depth > (reorder->msn_mask >> 1))
+	{
+		/* first MSN or MSN greater than all the previous ones */
+		reorder->msn_max = msn;
+		reorder->is_msn_max_init = true;
+		return false;
+	}
+
+	return c_reorder_ratio_reordered(reorder, depth);
+}
+
+
+/**
+ * @brief Record a MSN acknowledged by the decompressor
+ *
+ * An ACK for a MSN smaller than an already acknowledged MSN means that the
+ * decompressor received the packets out of order. Consecutive ACKs received
+ * in order progressively decrease the reorder ratio, but never below the
+ * reorder ratio configured for the compressor.
+ *
+ * @param reorder    The reordering state of the context
+ * @param msn_acked  The MSN acknowledged by the decompressor
+ * @return           true if the reorder ratio changed, false otherwise
+ */
+bool c_reorder_ratio_ack(struct c_reorder_ratio *const reorder,
+                         const uint32_t msn_acked)
+{
+	const uint32_t depth = (reorder->msn_acked_max - msn_acked) & reorder->msn_mask;
+
+	if(reorder->is_msn_acked_init && depth == 0)
+	{
+		/* same MSN acknowledged twice, nothing learned */
+		return false;
+	}
+	else if(reorder->is_msn_acked_init && depth <= (reorder->msn_mask >> 1))
+	{
+		/* ACK for an older MSN */
+		return c_reorder_ratio_reordered(reorder, depth);
+	}
+
+	/* first ACK or ACK for a newer MSN */
+	reorder->msn_acked_max = msn_acked;
+	reorder->is_msn_acked_init = true;
+	reorder->in_order_acks_nr++;
+
+	if(reorder->in_order_acks_nr < ROHC_REORDER_RATIO_ACKS_NR ||
+	   reorder->ratio <= reorder->ratio_min)
+	{
+		return false;
+	}
+
+	/* no reordering observed for a while, reduce the ratio by one step */
+	reorder->ratio = (rohc_reordering_offset_t) (reorder->ratio - 1);
+	reorder->in_order_acks_nr = 0;
+
+	return true;
+}
+
+
+/**
+ * @brief Record a NACK or STATIC-NACK received from the decompressor
+ *
+ * A NACK does not tell whether the decompressor lost some packets or
+ * received them out of order, so the reorder ratio is kept unchanged, but
+ * it shall not be decreased until enough ACKs are received in order.
+ *
+ * @param reorder  The reordering state of the context
+ */
+void c_reorder_ratio_nack(struct c_reorder_ratio *const reorder)
+{
+	reorder->in_order_acks_nr = 0;
+}
+
+
+/*
+ * Private functions
+ */
+
+/**
+ * @brief Raise the reorder ratio to cope with the given reordering depth
+ *
+ * The ratio is chosen so that even the smallest MSN field (4 bits) may be
+ * decoded by the decompressor when the packet is received after packets
+ * with MSN up to \e depth greater.
+ *
+ * @param reorder  The reordering state of the context
+ * @param depth    The reordering depth observed (in packets)
+ * @return         true if the reorder ratio changed, false otherwise
+ */
+static bool c_reorder_ratio_reordered(struct c_reorder_ratio *const reorder,
+                                      const uint32_t depth)
+{
+	rohc_reordering_offset_t ratio = reorder->ratio;
+
+	reorder->in_order_acks_nr = 0;
+
+	while(ratio < ROHC_REORDERING_THREEQUARTERS &&
+	      rohc_interval_get_rfc5225_msn_p(4, ratio) < ((int64_t) depth))
+	{
+		ratio = (rohc_reordering_offset_t) (ratio + 1);
+	}
+
+	if(ratio == reorder->ratio)
+	{
+		return false;
+	}
+
+	reorder->ratio = ratio;
+
+	return true;
+}
+
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   src/comp/schemes/comp_reorder_ratio.h
+ * @brief  Adaptive reorder ratio for the MSN of the ROHCv2 profiles
+ * @author agent <agent@local>
+ */
+
+#ifndef ROHC_COMP_REORDER_RATIO_H
+#define ROHC_COMP_REORDER_RATIO_H
+
+#include "rohc.h" /* for rohc_reordering_offset_t */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+
+/** The number of consecutive in-order ACKs required before the reorder ratio
+ *  is decreased by one step */
+#define ROHC_REORDER_RATIO_ACKS_NR  32U
+
+
+/**
+ * @brief The reordering state of one ROHCv2 compression context
+ *
+ * The reorder ratio defines how much of the MSN interpretation interval is
+ * dedicated to packets reordered on the channel (RFC 5225, §6.6.11). It is
+ * raised as soon as reordering is observed, and lowered step by step down to
+ * the configured ratio once the decompressor acknowledged enough packets in
+ * order.
+ */
+struct c_reorder_ratio
+{
+	/** The reorder ratio currently used */
+	rohc_reordering_offset_t ratio;
+	/** The reorder ratio configured for the compressor, the ratio is never
+	 *  lowered below it */
+	rohc_reordering_offset_t ratio_min;
+
+	/** The mask for the MSN (16-bit or 32-bit MSN) */
+	uint32_t msn_mask;
+
+	/** Whether one MSN was already given to the compressor */
+	bool is_msn_max_init;
+	/** The greatest MSN given to the compressor so far */
+	uint32_t msn_max;
+
+	/** Whether one MSN was already acknowledged by the decompressor */
+	bool is_msn_acked_init;
+	/** The greatest MSN acknowledged by the decompressor so far */
+	uint32_t msn_acked_max;
+
+	/** The number of consecutive in-order ACKs since the last change */
+	size_t in_order_acks_nr;
+};
+
+
+void c_reorder_ratio_init(struct c_reorder_ratio *const reorder,
+                          const rohc_reordering_offset_t ratio,
+                          const size_t msn_bits_nr)
+	__attribute__((nonnull(1)));
+
+bool c_reorder_ratio_add_msn(struct c_reorder_ratio *const reorder,
+                             const uint32_t msn)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+bool c_reorder_ratio_ack(struct c_reorder_ratio *const reorder,
+                         const uint32_t msn_acked)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+void c_reorder_ratio_nack(struct c_reorder_ratio *const reorder)
+	__attribute__((nonnull(1)));
+
+#endif
+
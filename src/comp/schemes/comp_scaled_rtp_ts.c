@@ -39,6 +39,26 @@
 	           format, ##__VA_ARGS__)
 
 
+/*
+ * Private function prototypes
+ */
+
+static uint32_t c_ts_sc_gcd(uint32_t a, uint32_t b)
+	__attribute__((warn_unused_result, const));
+
+static bool c_ts_sc_is_known_delta(const struct ts_sc_comp *const ts_sc)
+	__attribute__((nonnull(1), warn_unused_result, pure));
+
+static void c_ts_sc_record_delta(struct ts_sc_comp *const ts_sc)
+	__attribute__((nonnull(1)));
+
+static uint32_t c_ts_sc_window_gcd(const struct ts_sc_comp *const ts_sc)
+	__attribute__((nonnull(1), warn_unused_result, pure));
+
+static uint32_t c_ts_sc_estimate_stride(const struct ts_sc_comp *const ts_sc)
+	__attribute__((nonnull(1), warn_unused_result, pure));
+
+
 /**
  * @brief Create the ts_sc_comp object
  *
@@ -68,6 +88,10 @@ void c_init_sc(struct ts_sc_comp *const ts_sc,
 	ts_sc->state = INIT_TS;
 	ts_sc->are_old_val_init = false;
 	ts_sc->nr_init_stride_packets = 0;
+	ts_sc->nr_resync_packets = 0;
+	ts_sc->ts_deltas_nr = 0;
+	ts_sc->ts_deltas_next = 0;
+	ts_sc->nr_larger_stride_deltas = 0;
 
 	ts_sc->trace_callback = trace_cb;
 	ts_sc->trace_callback_priv = trace_cb_priv;
@@ -83,14 +107,25 @@ void c_init_sc(struct ts_sc_comp *const ts_sc,
 /**
  * @brief Store the new TS, calculate new values and update the state
  *
- * @param ts_sc        The ts_sc_comp object
- * @param ts           The timestamp to add
- * @param sn           The sequence number of the RTP packet
+ * TS_STRIDE is estimated as the greatest common divisor of the last TS
+ * deltas, so that variable packetisation at source does not prevent the
+ * scaling of the timestamps. An irregular TS delta that is not explained by
+ * the packetisation (jitter at source) does not change TS_STRIDE: TS_OFFSET
+ * is re-synchronised instead.
+ *
+ * @param ts_sc           The ts_sc_comp object
+ * @param ts              The timestamp to add
+ * @param sn              The sequence number of the RTP packet
+ * @param repetitions_nr  The number of packets that transmit TS_SCALED bits
+ *                        after a TS delta that is not deducible from SN
  */
 void c_add_ts(struct ts_sc_comp *const ts_sc,
               const uint32_t ts,
-              const uint16_t sn)
+              const uint16_t sn,
+              const size_t repetitions_nr)
 {
+	uint32_t new_stride;
+	bool is_known_delta;
 	uint16_t sn_delta;
 
 	ts_debug(ts_sc, "Timestamp = %u", ts);
@@ -157,6 +192,13 @@ void c_add_ts(struct ts_sc_comp *const ts_sc,
 		return;
 	}
 
+	/* record the TS delta for the estimation of TS_STRIDE */
+	is_known_delta = c_ts_sc_is_known_delta(ts_sc);
+	if(sn_delta == 1)
+	{
+		c_ts_sc_record_delta(ts_sc);
+	}
+
 	/* TS_STRIDE can be computed, so leave INIT_TS state */
 	if(ts_sc->state == INIT_TS)
 	{
@@ -171,16 +213,20 @@ void c_add_ts(struct ts_sc_comp *const ts_sc,
 		 * not transmitted enough times to the decompressor to be used */
 		ts_debug(ts_sc, "state INIT_STRIDE");
 
+		/* estimate TS_STRIDE */
+		new_stride = c_ts_sc_estimate_stride(ts_sc);
+
 		/* reset INIT_STRIDE counter if TS_STRIDE/TS_OFFSET changed */
-		if(ts_sc->ts_delta != ts_sc->ts_stride ||
-		   (ts_sc->ts % ts_sc->ts_delta) != ts_sc->ts_offset)
+		if(new_stride != ts_sc->ts_stride ||
+		   (ts_sc->ts % new_stride) != ts_sc->ts_offset)
 		{
 			ts_debug(ts_sc, "TS_STRIDE and/or TS_OFFSET changed");
 			ts_sc->nr_init_stride_packets = 0;
 		}
 
 		/* compute TS_STRIDE, TS_OFFSET and TS_SCALED */
-		ts_sc->ts_stride = ts_sc->ts_delta;
+		ts_sc->ts_stride = new_stride;
+		ts_sc->nr_resync_packets = 0;
 		ts_debug(ts_sc, "TS_STRIDE = %u", ts_sc->ts_stride);
 		assert(ts_sc->ts_stride != 0);
 		ts_sc->ts_offset = ts_sc->ts % ts_sc->ts_stride;
@@ -203,22 +249,52 @@ void c_add_ts(struct ts_sc_comp *const ts_sc,
 		/* does TS_STRIDE changed? */
 		ts_debug(ts_sc, "TS_STRIDE calculated = %u", ts_sc->ts_delta);
 		ts_debug(ts_sc, "previous TS_STRIDE = %u", ts_sc->ts_stride);
-		if(ts_sc->ts_delta != ts_sc->ts_stride)
+		new_stride = c_ts_sc_estimate_stride(ts_sc);
+		if(new_stride != ts_sc->ts_stride)
+		{
+			/* TS deltas are not multiples of the previous TS_STRIDE anymore,
+			 * or they all are multiples of a larger TS_STRIDE: record the new
+			 * value as TS_STRIDE and transmit it several times for robustness
+			 * purposes */
+			ts_debug(ts_sc, "/!\\ TS_STRIDE changed from %u to %u, so "
+			         "transmit it several times along all TS bits (probably a "
+			         "change of packetisation at source)", ts_sc->ts_stride,
+			         new_stride);
+			ts_sc->state = INIT_STRIDE;
+			ts_sc->nr_init_stride_packets = 0;
+			ts_sc->nr_resync_packets = 0;
+			ts_debug(ts_sc, "state -> INIT_STRIDE");
+			ts_sc->ts_stride = new_stride;
+		}
+		else if(ts_sc->ts_delta != ts_sc->ts_stride)
 		{
 			assert(ts_sc->ts_stride != 0);
 			if((ts_sc->ts_delta % ts_sc->ts_stride) != 0)
 			{
-				/* TS delta changed and is not a multiple of previous TS_STRIDE:
-				 * record the new value as TS_STRIDE and transmit it several
-				 * times for robustness purposes */
-				ts_debug(ts_sc, "/!\\ TS_STRIDE changed and is not a multiple "
-				         "of previous TS_STRIDE, so change TS_STRIDE and "
-				         "transmit it several times along all TS bits "
-				         "(probably a clock resync at source)");
+				/* TS delta is not a multiple of TS_STRIDE, but it is not
+				 * explained by a change of packetisation: do not change
+				 * TS_STRIDE, but re-synchronise TS_OFFSET by transmitting all
+				 * TS bits several times */
+				ts_debug(ts_sc, "/!\\ TS delta is not a multiple of TS_STRIDE, "
+				         "so do not change TS_STRIDE, but retransmit it several "
+				         "times along all TS bits (probably some jitter at "
+				         "source)");
 				ts_sc->state = INIT_STRIDE;
 				ts_sc->nr_init_stride_packets = 0;
+				ts_sc->nr_resync_packets = 0;
 				ts_debug(ts_sc, "state -> INIT_STRIDE");
-				ts_sc->ts_stride = ts_sc->ts_delta;
+			}
+			else if((ts_sc->ts_delta / ts_sc->ts_stride) != sn_delta &&
+			        is_known_delta)
+			{
+				/* TS delta changed, is a multiple of TS_STRIDE and was already
+				 * seen recently: keep TS_STRIDE and transmit TS_SCALED bits
+				 * in the next packets for robustness purposes */
+				ts_debug(ts_sc, "/!\\ TS delta changed, but is a multiple of "
+				         "TS_STRIDE seen recently, so keep TS_SCALED and transmit "
+				         "it in the next %zu packets (probably a variable "
+				         "packetisation at source)", repetitions_nr);
+				ts_sc->nr_resync_packets = repetitions_nr + 1;
 			}
 			else if((ts_sc->ts_delta / ts_sc->ts_stride) != sn_delta)
 			{
@@ -231,6 +307,7 @@ void c_add_ts(struct ts_sc_comp *const ts_sc,
 				         "(probably a RTP TS jump at source)");
 				ts_sc->state = INIT_STRIDE;
 				ts_sc->nr_init_stride_packets = 0;
+				ts_sc->nr_resync_packets = 0;
 				ts_debug(ts_sc, "state -> INIT_STRIDE");
 			}
 			else
@@ -292,6 +369,12 @@ void c_add_ts(struct ts_sc_comp *const ts_sc,
 				}
 			}
 		}
+		if(ts_sc->nr_resync_packets > 0)
+		{
+			/* TS_SCALED bits are transmitted after an irregular TS delta */
+			ts_sc->nr_resync_packets--;
+			ts_sc->is_deducible = false;
+		}
 		if(ts_sc->is_deducible)
 		{
 			ts_debug(ts_sc, "TS can be deducted from SN (old TS_SCALED = %u, "
@@ -342,14 +425,15 @@ void c_add_ts(struct ts_sc_comp *const ts_sc,
  *                                        TS_SCALED in a field that is strictly
  *                                        larger than to 2 bits
  */
-void nb_bits_unscaled(const struct ts_sc_comp *const ts_sc,
+void nb_bits_unscaled(struct ts_sc_comp *const ts_sc,
                       size_t *const bits_nr_less_equal_than_2,
                       size_t *const bits_nr_more_than_2)
 {
 	*bits_nr_less_equal_than_2 =
-		wlsb_get_kp_32bits(&ts_sc->ts_unscaled_wlsb, ts_sc->ts, 0);
+		wlsb_get_minkp_32bits_memo(&ts_sc->ts_unscaled_wlsb, ts_sc->ts, 0, 0);
 	*bits_nr_more_than_2 =
-		wlsb_get_mink_32bits(&ts_sc->ts_unscaled_wlsb, ts_sc->ts, 3);
+		wlsb_get_minkp_32bits_memo(&ts_sc->ts_unscaled_wlsb, ts_sc->ts, 3,
+		                           ts_sc->ts_unscaled_wlsb.p);
 }
 
 
@@ -376,14 +460,15 @@ void add_unscaled(struct ts_sc_comp *const ts_sc, const uint16_t sn)
  *                                        TS_SCALED in a field that is strictly
  *                                        larger than to 2 bits
  */
-void nb_bits_scaled(const struct ts_sc_comp *const ts_sc,
+void nb_bits_scaled(struct ts_sc_comp *const ts_sc,
                     size_t *const bits_nr_less_equal_than_2,
                     size_t *const bits_nr_more_than_2)
 {
 	*bits_nr_less_equal_than_2 =
-		wlsb_get_kp_32bits(&ts_sc->ts_scaled_wlsb, ts_sc->ts_scaled, 0);
+		wlsb_get_minkp_32bits_memo(&ts_sc->ts_scaled_wlsb, ts_sc->ts_scaled, 0, 0);
 	*bits_nr_more_than_2 =
-		wlsb_get_mink_32bits(&ts_sc->ts_scaled_wlsb, ts_sc->ts_scaled, 3);
+		wlsb_get_minkp_32bits_memo(&ts_sc->ts_scaled_wlsb, ts_sc->ts_scaled, 3,
+		                           ts_sc->ts_scaled_wlsb.p);
 
 	/* do not send 0 bit of TS if TS is not deducible, because decompressor
 	 * will interprets a 0-bit value as deducible */
@@ -461,3 +546,161 @@ bool rohc_ts_sc_is_deducible(const struct ts_sc_comp *const ts_sc)
 	return ts_sc->is_deducible;
 }
 
+
+/**
+ * @brief Compute the greatest common divisor of two TS deltas
+ *
+ * @param a  The first TS delta
+ * @param b  The second TS delta
+ * @return   The greatest common divisor of the two TS deltas
+ */
+static uint32_t c_ts_sc_gcd(uint32_t a, uint32_t b)
+{
+	while(b != 0)
+	{
+		const uint32_t r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+
+/**
+ * @brief Whether the current TS delta was recently seen
+ *
+ * @param ts_sc  The ts_sc_comp object
+ * @return       true if the current TS delta is one of the last TS deltas
+ */
+static bool c_ts_sc_is_known_delta(const struct ts_sc_comp *const ts_sc)
+{
+	size_t i;
+
+	for(i = 0; i < ts_sc->ts_deltas_nr; i++)
+	{
+		if(ts_sc->ts_deltas[i] == ts_sc->ts_delta)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/**
+ * @brief Record the current TS delta in the window of the last TS deltas
+ *
+ * Count how many TS deltas in a row were recorded while all the last TS
+ * deltas were multiples of a TS_STRIDE larger than the current one.
+ *
+ * @param ts_sc  The ts_sc_comp object
+ */
+static void c_ts_sc_record_delta(struct ts_sc_comp *const ts_sc)
+{
+	uint32_t window_gcd;
+
+	ts_sc->ts_deltas[ts_sc->ts_deltas_next] = ts_sc->ts_delta;
+	ts_sc->ts_deltas_next = (ts_sc->ts_deltas_next + 1) % ROHC_TS_STRIDE_WINDOW;
+	if(ts_sc->ts_deltas_nr < ROHC_TS_STRIDE_WINDOW)
+	{
+		ts_sc->ts_deltas_nr++;
+	}
+
+	window_gcd = c_ts_sc_window_gcd(ts_sc);
+	if(ts_sc->ts_stride != 0 && window_gcd > ts_sc->ts_stride &&
+	   (window_gcd % ts_sc->ts_stride) == 0)
+	{
+		ts_sc->nr_larger_stride_deltas++;
+	}
+	else
+	{
+		ts_sc->nr_larger_stride_deltas = 0;
+	}
+}
+
+
+/**
+ * @brief Compute the greatest common divisor of the last TS deltas
+ *
+ * @param ts_sc  The ts_sc_comp object
+ * @return       The greatest common divisor of the last TS deltas,
+ *               0 if not enough TS deltas were recorded yet
+ */
+static uint32_t c_ts_sc_window_gcd(const struct ts_sc_comp *const ts_sc)
+{
+	uint32_t gcd = 0;
+	size_t i;
+
+	if(ts_sc->ts_deltas_nr < ROHC_TS_STRIDE_WINDOW)
+	{
+		return 0;
+	}
+
+	for(i = 0; i < ts_sc->ts_deltas_nr; i++)
+	{
+		gcd = c_ts_sc_gcd(ts_sc->ts_deltas[i], gcd);
+	}
+	return gcd;
+}
+
+
+/**
+ * @brief Estimate TS_STRIDE from the current TS delta and the last ones
+ *
+ * The current TS_STRIDE is kept as long as TS deltas are multiples of it.
+ * It grows back only once all the last TS deltas were multiples of a larger
+ * TS_STRIDE for ROHC_TS_STRIDE_GROW_DELTAS TS deltas in a row: a stream that
+ * mixes full and half frames thus keeps the smaller TS_STRIDE.
+ *
+ * A TS delta that is not a multiple of the current TS_STRIDE changes
+ * TS_STRIDE to the greatest common divisor of both (variable packetisation at
+ * source), or to the greatest common divisor of the last TS deltas (change of
+ * packetisation at source). A greatest common divisor that is much smaller
+ * than the current TS_STRIDE is considered as caused by some jitter at
+ * source and is ignored.
+ *
+ * @param ts_sc  The ts_sc_comp object
+ * @return       The new TS_STRIDE, never zero
+ */
+static uint32_t c_ts_sc_estimate_stride(const struct ts_sc_comp *const ts_sc)
+{
+	const uint32_t window_gcd = c_ts_sc_window_gcd(ts_sc);
+	uint32_t delta_gcd;
+
+	assert(ts_sc->ts_delta != 0);
+
+	if(ts_sc->ts_stride == 0)
+	{
+		return ts_sc->ts_delta;
+	}
+
+	if((ts_sc->ts_delta % ts_sc->ts_stride) == 0)
+	{
+		/* were all the last TS deltas multiples of a larger TS_STRIDE for
+		 * long enough? */
+		if(ts_sc->nr_larger_stride_deltas >= ROHC_TS_STRIDE_GROW_DELTAS &&
+		   window_gcd > ts_sc->ts_stride && (window_gcd % ts_sc->ts_stride) == 0)
+		{
+			return window_gcd;
+		}
+		return ts_sc->ts_stride;
+	}
+
+	/* variable packetisation at source? */
+	delta_gcd = c_ts_sc_gcd(ts_sc->ts_stride, ts_sc->ts_delta);
+	if((((uint64_t) delta_gcd) * ROHC_TS_STRIDE_GCD_RATIO) >= ts_sc->ts_stride)
+	{
+		return delta_gcd;
+	}
+
+	/* change of packetisation at source? */
+	if(window_gcd != 0 &&
+	   (((uint64_t) window_gcd) * ROHC_TS_STRIDE_GCD_RATIO) >= ts_sc->ts_stride)
+	{
+		return window_gcd;
+	}
+
+	/* jitter at source */
+	return ts_sc->ts_stride;
+}
+
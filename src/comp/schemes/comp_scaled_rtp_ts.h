@@ -37,6 +37,28 @@
 #include <stdbool.h>
 
 
+/** The number of the last TS deltas used to estimate TS_STRIDE */
+#define ROHC_TS_STRIDE_WINDOW  4U
+
+/**
+ * @brief The maximal ratio between the current TS_STRIDE and a new estimate
+ *
+ * A TS_STRIDE estimate that is more than this ratio smaller than the current
+ * TS_STRIDE is considered as caused by some jitter at source, not by a
+ * change of the packetisation.
+ */
+#define ROHC_TS_STRIDE_GCD_RATIO  4U
+
+/**
+ * @brief The number of TS deltas that shall show a larger TS_STRIDE in a row
+ *        before TS_STRIDE grows back
+ *
+ * A smaller TS_STRIDE is kept for some time once seen, so that a stream that
+ * mixes full and half frames does not switch TS_STRIDE back and forth.
+ */
+#define ROHC_TS_STRIDE_GROW_DELTAS  32U
+
+
 /**
  * @brief State of scaled RTP Timestamp encoding
  *
@@ -94,9 +116,22 @@ struct ts_sc_comp
 	bool are_old_val_init;
 	/// The number of packets sent in state INIT_STRIDE
 	size_t nr_init_stride_packets;
+	/** The number of packets that shall still transmit TS_SCALED bits after
+	 *  an irregular TS delta */
+	size_t nr_resync_packets;
 
 	/// The difference between old and current TS
 	uint32_t ts_delta;
+	/** The last TS deltas between packets with consecutive SN, used to
+	 *  estimate TS_STRIDE */
+	uint32_t ts_deltas[ROHC_TS_STRIDE_WINDOW];
+	/** The number of TS deltas recorded in \e ts_deltas */
+	size_t ts_deltas_nr;
+	/** The index of the next TS delta to record in \e ts_deltas */
+	size_t ts_deltas_next;
+	/** The number of TS deltas in a row that were recorded while all the last
+	 *  TS deltas were multiples of a TS_STRIDE larger than the current one */
+	size_t nr_larger_stride_deltas;
 
 	/** The callback function used to manage traces */
 	rohc_trace_callback2_t trace_callback;
@@ -118,17 +153,18 @@ void c_init_sc(struct ts_sc_comp *const ts_sc,
 
 void c_add_ts(struct ts_sc_comp *const ts_sc,
               const uint32_t ts,
-              const uint16_t sn)
+              const uint16_t sn,
+              const size_t repetitions_nr)
 	__attribute__((nonnull(1)));
 
-void nb_bits_unscaled(const struct ts_sc_comp *const ts_sc,
+void nb_bits_unscaled(struct ts_sc_comp *const ts_sc,
                       size_t *const bits_nr_less_equal_than_2,
                       size_t *const bits_nr_more_than_2)
 	__attribute__((nonnull(1, 2, 3)));
 void add_unscaled(struct ts_sc_comp *const ts_sc, const uint16_t sn)
 	__attribute__((nonnull(1)));
 
-void nb_bits_scaled(const struct ts_sc_comp *const ts_sc,
+void nb_bits_scaled(struct ts_sc_comp *const ts_sc,
                     size_t *const bits_nr_less_equal_than_2,
                     size_t *const bits_nr_more_than_2)
 	__attribute__((nonnull(1, 2, 3)));
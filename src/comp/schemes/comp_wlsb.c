@@ -27,6 +27,7 @@
 
 #include "comp_wlsb.h"
 #include "interval.h" /* for the rohc_f_*bits() functions */
+#include "rohc_utils.h"
 
 #include <string.h>
 #include <assert.h>
@@ -42,6 +43,18 @@ static size_t wlsb_get_minkp_32bits(const struct c_wlsb *const wlsb,
                                     const rohc_lsb_shift_t p)
 	__attribute__((warn_unused_result, nonnull(1)));
 
+static bool wlsb_is_steady(const struct c_wlsb *const wlsb,
+                           const uint32_t value,
+                           uint32_t *const delta)
+	__attribute__((warn_unused_result, nonnull(1, 3)));
+
+static size_t wlsb_get_minkp_memo(struct c_wlsb *const wlsb,
+                                  const uint32_t value,
+                                  const size_t value_bits,
+                                  const size_t min_k,
+                                  const rohc_lsb_shift_t p)
+	__attribute__((warn_unused_result, nonnull(1)));
+
 static size_t wlsb_get_next_older(const size_t entry, const size_t max)
 	__attribute__((warn_unused_result, const));
 
@@ -75,14 +88,120 @@ void wlsb_init(struct c_wlsb *const wlsb,
 	wlsb->oldest = 0;
 	wlsb->next = 0;
 	wlsb->count = 0;
+	wlsb->is_ack_driven = false;
 	wlsb->window_width = window_width;
 	wlsb->bits = bits;
 	wlsb->p = p;
+	wlsb->delta = 0;
+	wlsb->delta_nr = 0;
+	wlsb->memos_next = 0;
 
 	for(i = 0; i < wlsb->window_width; i++)
 	{
 		wlsb->window[i].used = false;
 	}
+	for(i = 0; i < ROHC_WLSB_MEMO_MAX; i++)
+	{
+		wlsb->memos[i].used = false;
+	}
+}
+
+
+/**
+ * @brief Remove all the values stored in the given W-LSB encoding object
+ *
+ * The window width, the maximal number of bits and the shift parameter are
+ * kept. The next values will be encoded with all their bits until new
+ * references are added to the window.
+ *
+ * @param[in,out] wlsb  The W-LSB encoding object to reset
+ */
+void wlsb_reset(struct c_wlsb *const wlsb)
+{
+	size_t i;
+
+	wlsb->oldest = 0;
+	wlsb->next = 0;
+	wlsb->count = 0;
+	wlsb->delta_nr = 0;
+
+	for(i = 0; i < wlsb->window_width; i++)
+	{
+		wlsb->window[i].used = false;
+	}
+}
+
+
+/**
+ * @brief Change the width of the window of the given W-LSB encoding object
+ *
+ * The most recent values stored in the window are kept. If the new window is
+ * smaller than the number of values stored in the window, the oldest values
+ * are dropped, unless the window is ACK-driven: an ACK-driven window is never
+ * shrunk below its number of values. The maximal number of bits and the shift
+ * parameter are kept.
+ *
+ * @param[in,out] wlsb    The W-LSB encoding object to resize
+ * @param new_width       The new number of entries in the window
+ */
+void wlsb_set_window_width(struct c_wlsb *const wlsb,
+                           const size_t new_width)
+{
+	struct c_window window[ROHC_WLSB_WIDTH_MAX];
+	size_t window_width = new_width;
+	size_t count;
+	size_t i;
+
+	assert(new_width > 0);
+	assert(new_width <= ROHC_WLSB_WIDTH_MAX);
+
+	/* do not drop the references not acknowledged yet */
+	if(wlsb->is_ack_driven && window_width < wlsb->count)
+	{
+		window_width = wlsb->count;
+	}
+
+	if(window_width == wlsb->window_width)
+	{
+		return;
+	}
+
+	/* copy the most recent entries, from the oldest one to the newest one */
+	count = (wlsb->count < window_width ? wlsb->count : window_width);
+	for(i = 0; i < count; i++)
+	{
+		const size_t entry =
+			(wlsb->next + wlsb->window_width - count + i) % wlsb->window_width;
+		memcpy(&window[i], &wlsb->window[entry], sizeof(struct c_window));
+	}
+	for(i = count; i < window_width; i++)
+	{
+		window[i].used = false;
+	}
+
+	memcpy(wlsb->window, window, window_width * sizeof(struct c_window));
+	wlsb->window_width = window_width;
+	wlsb->oldest = 0;
+	wlsb->next = count % window_width;
+	wlsb->count = count;
+}
+
+
+/**
+ * @brief Let the positive ACKs drive the width of the given W-LSB window
+ *
+ * See RFC 3095, §4.5.2: in R-mode, the window contains the last value
+ * acknowledged by the decompressor (the secure reference) and all the values
+ * sent since then. The window grows until the next positive ACK, then
+ * shrinks to the acknowledged value and the values sent after it.
+ *
+ * @param[in,out] wlsb     The W-LSB encoding object
+ * @param is_ack_driven    Whether the window is driven by the positive ACKs
+ */
+void wlsb_set_ack_driven(struct c_wlsb *const wlsb,
+                         const bool is_ack_driven)
+{
+	wlsb->is_ack_driven = is_ack_driven;
 }
 
 
@@ -97,6 +216,58 @@ void c_add_wlsb(struct c_wlsb *const wlsb,
                 const uint32_t sn,
                 const uint32_t value)
 {
+	/* count the successive values that increase by the same delta */
+	if(wlsb->count == 0)
+	{
+		wlsb->delta_nr = 0;
+	}
+	else
+	{
+		const size_t newest =
+			(wlsb->next + wlsb->window_width - 1) % wlsb->window_width;
+		const uint32_t delta = value - wlsb->window[newest].value;
+
+		if(wlsb->delta_nr > 0 && delta == wlsb->delta)
+		{
+			if(wlsb->delta_nr < ROHC_WLSB_WIDTH_MAX)
+			{
+				wlsb->delta_nr++;
+			}
+		}
+		else
+		{
+			wlsb->delta = delta;
+			wlsb->delta_nr = 1;
+		}
+	}
+
+	/* an ACK-driven window grows instead of overwriting the references
+	 * not acknowledged yet */
+	if(wlsb->is_ack_driven && wlsb->count == wlsb->window_width)
+	{
+		if(wlsb->window_width < ROHC_WLSB_WIDTH_MAX)
+		{
+			wlsb_set_window_width(wlsb, rohc_min(wlsb->window_width * 2,
+			                                     ROHC_WLSB_WIDTH_MAX));
+		}
+		else
+		{
+			/* the window cannot grow anymore: keep the secure reference and
+			 * drop the next oldest value in its place */
+			const size_t second = (wlsb->oldest + 1) % wlsb->window_width;
+
+			memcpy(&wlsb->window[second], &wlsb->window[wlsb->oldest],
+			       sizeof(struct c_window));
+			wlsb->window[wlsb->oldest].used = false;
+			wlsb->oldest = second;
+			wlsb->count--;
+
+			/* the delta between the secure reference and the next value
+			 * changed */
+			wlsb->delta_nr = rohc_min(wlsb->delta_nr, wlsb->count - 1);
+		}
+	}
+
 	/* if window is full, an entry is overwritten */
 	if(wlsb->count == wlsb->window_width)
 	{
@@ -443,6 +614,29 @@ size_t wlsb_get_minkp_16bits(const struct c_wlsb *const wlsb,
 }
 
 
+/**
+ * @brief Find out the minimal number of bits of the to-be-encoded value
+ *        required to be able to uniquely recreate it given the window
+ *
+ * The function is dedicated to 16-bit fields. It returns the same number of
+ * bits as wlsb_get_minkp_16bits(), but it reuses the number of bits computed
+ * for a previous value when the window is steady.
+ *
+ * @param wlsb   The W-LSB object
+ * @param value  The value to encode using the LSB algorithm
+ * @param min_k  The minimum number of bits to find out
+ * @param p      The shift parameter p
+ * @return       The number of bits required to uniquely recreate the value
+ */
+size_t wlsb_get_minkp_16bits_memo(struct c_wlsb *const wlsb,
+                                  const uint16_t value,
+                                  const size_t min_k,
+                                  const rohc_lsb_shift_t p)
+{
+	return wlsb_get_minkp_memo(wlsb, value, 16, min_k, p);
+}
+
+
 /**
  * @brief Find out whether the given number of bits is enough to encode value
  *
@@ -670,6 +864,29 @@ static size_t wlsb_get_minkp_32bits(const struct c_wlsb *const wlsb,
 }
 
 
+/**
+ * @brief Find out the minimal number of bits of the to-be-encoded value
+ *        required to be able to uniquely recreate it given the window
+ *
+ * The function is dedicated to 32-bit fields. It returns the same number of
+ * bits as wlsb_get_minkp_32bits(), but it reuses the number of bits computed
+ * for a previous value when the window is steady.
+ *
+ * @param wlsb   The W-LSB object
+ * @param value  The value to encode using the LSB algorithm
+ * @param min_k  The minimum number of bits to find out
+ * @param p      The shift parameter p
+ * @return       The number of bits required to uniquely recreate the value
+ */
+size_t wlsb_get_minkp_32bits_memo(struct c_wlsb *const wlsb,
+                                  const uint32_t value,
+                                  const size_t min_k,
+                                  const rohc_lsb_shift_t p)
+{
+	return wlsb_get_minkp_memo(wlsb, value, 32, min_k, p);
+}
+
+
 /**
  * @brief Find out whether the given number of bits is enough to encode value
  *
@@ -835,6 +1052,113 @@ bool wlsb_is_sn_present(struct c_wlsb *const wlsb, const uint32_t sn)
  */
 
 
+/**
+ * @brief Whether the window is steady for the given value
+ *
+ * The window is steady if all its values increase by the same delta, and if
+ * the given value increases by the same delta too. The window then only
+ * depends on the given value, the delta and the number of values, and so does
+ * the minimal number of bits required to encode the given value.
+ *
+ * @param wlsb        The W-LSB object
+ * @param value       The value to encode using the LSB algorithm
+ * @param[out] delta  The delta between the value and the newest reference
+ * @return            true if the window is steady, false if it is not
+ */
+static bool wlsb_is_steady(const struct c_wlsb *const wlsb,
+                           const uint32_t value,
+                           uint32_t *const delta)
+{
+	size_t newest;
+
+	if(wlsb->count == 0)
+	{
+		return false;
+	}
+
+	newest = (wlsb->next + wlsb->window_width - 1) % wlsb->window_width;
+	*delta = value - wlsb->window[newest].value;
+
+	/* a window with one single reference is always steady */
+	return (wlsb->count == 1 ||
+	        (wlsb->delta_nr >= (wlsb->count - 1) &&
+	         wlsb->delta == (*delta)));
+}
+
+
+/**
+ * @brief Find out the minimal number of bits of the to-be-encoded value,
+ *        memoize it for the next values if the window is steady
+ *
+ * @param wlsb        The W-LSB object
+ * @param value       The value to encode using the LSB algorithm
+ * @param value_bits  The size of the encoded field (16 or 32 bits)
+ * @param min_k       The minimum number of bits to find out
+ * @param p           The shift parameter p
+ * @return            The number of bits required to uniquely recreate the value
+ */
+static size_t wlsb_get_minkp_memo(struct c_wlsb *const wlsb,
+                                  const uint32_t value,
+                                  const size_t value_bits,
+                                  const size_t min_k,
+                                  const rohc_lsb_shift_t p)
+{
+	struct c_wlsb_memo *memo;
+	uint32_t delta;
+	size_t k;
+	size_t i;
+
+	assert(value_bits == 16 || value_bits == 32);
+
+	/* compute the number of bits if the window is not steady */
+	if(!wlsb_is_steady(wlsb, value, &delta))
+	{
+		if(value_bits == 16)
+		{
+			return wlsb_get_minkp_16bits(wlsb, value, min_k, p);
+		}
+		return wlsb_get_minkp_32bits(wlsb, value, min_k, p);
+	}
+
+	/* reuse the number of bits computed for a previous steady window with
+	 * the same number of references and delta if any */
+	for(i = 0; i < ROHC_WLSB_MEMO_MAX; i++)
+	{
+		memo = &(wlsb->memos[i]);
+		if(memo->used &&
+		   memo->value_bits == value_bits &&
+		   memo->min_k == min_k &&
+		   memo->p == p &&
+		   memo->count == wlsb->count &&
+		   memo->delta == delta)
+		{
+			return memo->k;
+		}
+	}
+
+	/* compute the number of bits, then memoize it in place of the oldest memo */
+	if(value_bits == 16)
+	{
+		k = wlsb_get_minkp_16bits(wlsb, value, min_k, p);
+	}
+	else
+	{
+		k = wlsb_get_minkp_32bits(wlsb, value, min_k, p);
+	}
+	memo = &(wlsb->memos[wlsb->memos_next]);
+	memo->used = true;
+	memo->value_bits = value_bits;
+	memo->min_k = min_k;
+	memo->p = p;
+	memo->count = wlsb->count;
+	memo->delta = delta;
+	memo->k = k;
+	wlsb->memos_next = (wlsb->memos_next + 1) % ROHC_WLSB_MEMO_MAX;
+
+	return k;
+}
+
+
 /**
  * @brief Get the next older entry
  *
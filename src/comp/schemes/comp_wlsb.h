@@ -50,13 +50,38 @@ struct c_window
 };
 
 
+/** The number of bit widths memoized by one W-LSB encoding object */
+#define ROHC_WLSB_MEMO_MAX  4U
+
+
+/**
+ * @brief One bit width memoized for a steady W-LSB window
+ *
+ * A W-LSB window is steady if all its values increase by the same delta, and
+ * if the value to encode increases by the same delta too. The number of bits
+ * required to encode the value only depends on the differences between the
+ * value and the references of the window, so it is the same for all the
+ * steady windows with the same number of references and delta.
+ */
+struct c_wlsb_memo
+{
+	bool used;            /**< Whether the memo is used or not */
+	size_t value_bits;    /**< The size of the encoded field (16 or 32 bits) */
+	size_t min_k;         /**< The minimum number of bits that was requested */
+	rohc_lsb_shift_t p;   /**< The shift parameter that was requested */
+	size_t count;         /**< The number of references of the steady window */
+	uint32_t delta;       /**< The delta between the values of the window */
+	size_t k;             /**< The number of bits required for the value */
+};
+
+
 /**
  * @brief One W-LSB encoding object
  */
 struct c_wlsb
 {
 	/** The width of the window */
-	size_t window_width; /* TODO: R-mode needs a non-fixed window width */
+	size_t window_width;
 
 	/** A pointer on the oldest entry in the window (change on acknowledgement) */
 	size_t oldest;
@@ -66,6 +91,17 @@ struct c_wlsb
 	/** The count of entries in the window */
 	size_t count;
 
+	/**
+	 * @brief Whether the window is driven by the positive ACKs
+	 *
+	 * An ACK-driven window never drops the references that the decompressor
+	 * did not acknowledge yet: it grows beyond its width until the next
+	 * positive ACK removes the acknowledged references. Once the window
+	 * reaches \ref ROHC_WLSB_WIDTH_MAX, the oldest reference (the last one
+	 * that was acknowledged) is kept and the next oldest one is dropped.
+	 */
+	bool is_ack_driven;
+
 	/** The maximal number of bits for representing the value */
 	size_t bits;
 	/** The shift parameter (see 4.5.2 in the RFC 3095) */
@@ -73,6 +109,16 @@ struct c_wlsb
 
 	/** The window in which previous values of the encoded value are stored */
 	struct c_window window[ROHC_WLSB_WIDTH_MAX];
+
+	/** The delta between the two newest values of the window */
+	uint32_t delta;
+	/** The number of successive values added with the same delta */
+	size_t delta_nr;
+
+	/** The bit widths memoized for the steady window */
+	struct c_wlsb_memo memos[ROHC_WLSB_MEMO_MAX];
+	/** The next memo to replace */
+	size_t memos_next;
 };
 
 
@@ -86,6 +132,17 @@ void wlsb_init(struct c_wlsb *const wlsb,
                const rohc_lsb_shift_t p)
 	__attribute__((nonnull(1)));
 
+void wlsb_reset(struct c_wlsb *const wlsb)
+	__attribute__((nonnull(1)));
+
+void wlsb_set_window_width(struct c_wlsb *const wlsb,
+                           const size_t window_width)
+	__attribute__((nonnull(1)));
+
+void wlsb_set_ack_driven(struct c_wlsb *const wlsb,
+                         const bool is_ack_driven)
+	__attribute__((nonnull(1)));
+
 void c_add_wlsb(struct c_wlsb *const wlsb,
                 const uint32_t sn,
                 const uint32_t value)
@@ -122,6 +179,12 @@ size_t wlsb_get_minkp_16bits(const struct c_wlsb *const wlsb,
                              const rohc_lsb_shift_t p)
 	__attribute__((warn_unused_result, nonnull(1)));
 
+size_t wlsb_get_minkp_16bits_memo(struct c_wlsb *const wlsb,
+                                  const uint16_t value,
+                                  const size_t min_k,
+                                  const rohc_lsb_shift_t p)
+	__attribute__((warn_unused_result, nonnull(1)));
+
 bool wlsb_is_kp_possible_16bits(const struct c_wlsb *const wlsb,
                                 const uint16_t value,
                                 const size_t k,
@@ -140,6 +203,12 @@ size_t wlsb_get_kp_32bits(const struct c_wlsb *const wlsb,
                           const rohc_lsb_shift_t p)
 	__attribute__((warn_unused_result, nonnull(1)));
 
+size_t wlsb_get_minkp_32bits_memo(struct c_wlsb *const wlsb,
+                                  const uint32_t value,
+                                  const size_t min_k,
+                                  const rohc_lsb_shift_t p)
+	__attribute__((warn_unused_result, nonnull(1)));
+
 bool wlsb_is_kp_possible_32bits(const struct c_wlsb *const wlsb,
                                 const uint32_t value,
                                 const size_t k,
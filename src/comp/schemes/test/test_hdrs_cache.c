@@ -0,0 +1,234 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file    /comp/comp/schemes/test/test_hdrs_cache.c
+ * @brief   Test the word-wise detection of the changes in the headers
+ * @author  agent <agent@local>
+ */
+
+#include "comp_hdrs_cache.h"
+
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include "config.h" /* for HAVE_CMOCKA_RUN(_GROUP)?_TESTS */
+
+
+/** The length of the test header chain: not a multiple of 64 bits */
+#define TEST_HDRS_LEN  43U
+
+
+/**
+ * @brief Classify the test header chain and record it
+ *
+ * Bytes 0 to 3 are static, bytes 4 to 11 are inferred, byte 20 is half
+ * static and half inferred, byte 40 is static, all the other bytes are
+ * transmitted dynamic fields.
+ *
+ * @param[out] cache  The header cache
+ * @param hdrs        The header chain to record
+ */
+static void setup_cache(struct c_hdrs_cache *const cache,
+                        const uint8_t *const hdrs)
+{
+	c_hdrs_cache_reset(cache);
+	assert_true(c_hdrs_cache_set_len(cache, TEST_HDRS_LEN));
+	c_hdrs_cache_classify(cache, 0, 4, 0xff, ROHC_HDRS_STATIC);
+	c_hdrs_cache_classify(cache, 4, 8, 0xff, ROHC_HDRS_INFERRED);
+	c_hdrs_cache_classify(cache, 20, 1, 0xf0, ROHC_HDRS_STATIC);
+	c_hdrs_cache_classify(cache, 20, 1, 0x0f, ROHC_HDRS_INFERRED);
+	c_hdrs_cache_classify(cache, 40, 1, 0xff, ROHC_HDRS_STATIC);
+	c_hdrs_cache_store(cache, hdrs);
+}
+
+
+/** Test the length of the cached header chain */
+static void test_hdrs_cache_len(void **state __attribute__((unused)))
+{
+	struct c_hdrs_cache cache;
+	uint8_t hdrs[ROHC_HDRS_CACHE_MAX + 1];
+
+	memset(hdrs, 0x55, ROHC_HDRS_CACHE_MAX + 1);
+
+	/* nothing cached: everything changed */
+	c_hdrs_cache_reset(&cache);
+	assert_int_equal(c_hdrs_cache_cmp(&cache, hdrs, TEST_HDRS_LEN),
+	                 ROHC_HDRS_ALL);
+
+	/* empty and too long header chains cannot be cached */
+	assert_false(c_hdrs_cache_set_len(&cache, 0));
+	assert_int_equal(cache.len, 0);
+	assert_false(c_hdrs_cache_set_len(&cache, ROHC_HDRS_CACHE_MAX + 1));
+	assert_int_equal(cache.len, 0);
+	assert_int_equal(c_hdrs_cache_cmp(&cache, hdrs, ROHC_HDRS_CACHE_MAX + 1),
+	                 ROHC_HDRS_ALL);
+
+	/* the longest header chain may be cached */
+	assert_true(c_hdrs_cache_set_len(&cache, ROHC_HDRS_CACHE_MAX));
+	c_hdrs_cache_store(&cache, hdrs);
+	assert_int_equal(c_hdrs_cache_cmp(&cache, hdrs, ROHC_HDRS_CACHE_MAX), 0);
+
+	/* a header chain shorter than the cached one changed entirely */
+	setup_cache(&cache, hdrs);
+	assert_int_equal(c_hdrs_cache_cmp(&cache, hdrs, TEST_HDRS_LEN), 0);
+	assert_int_equal(c_hdrs_cache_cmp(&cache, hdrs, TEST_HDRS_LEN - 1),
+	                 ROHC_HDRS_ALL);
+
+	/* the data after the cached header chain is ignored */
+	hdrs[TEST_HDRS_LEN] ^= 0xff;
+	assert_int_equal(c_hdrs_cache_cmp(&cache, hdrs, TEST_HDRS_LEN + 1), 0);
+
+	/* a reset cache forgets the header chain */
+	c_hdrs_cache_reset(&cache);
+	assert_int_equal(c_hdrs_cache_cmp(&cache, hdrs, TEST_HDRS_LEN),
+	                 ROHC_HDRS_ALL);
+}
+
+
+/** Test the classes of the fields that changed */
+static void test_hdrs_cache_cmp(void **state __attribute__((unused)))
+{
+	const struct
+	{
+		size_t offset;   /* the byte to change */
+		uint8_t bits;    /* the bits to change in the byte */
+		uint8_t changed; /* the expected classes of changed fields */
+	} changes[] = {
+		{ 0, 0x01, ROHC_HDRS_STATIC },
+		{ 3, 0x80, ROHC_HDRS_STATIC },
+		{ 4, 0xff, ROHC_HDRS_INFERRED },
+		{ 11, 0x10, ROHC_HDRS_INFERRED },
+		{ 12, 0x01, ROHC_HDRS_DYNAMIC },
+		{ 20, 0x10, ROHC_HDRS_STATIC },
+		{ 20, 0x01, ROHC_HDRS_INFERRED },
+		{ 20, 0x11, ROHC_HDRS_STATIC | ROHC_HDRS_INFERRED },
+		/* the trailing bytes are compared one by one */
+		{ 39, 0x02, ROHC_HDRS_DYNAMIC },
+		{ 40, 0x04, ROHC_HDRS_STATIC },
+		{ 42, 0x80, ROHC_HDRS_DYNAMIC },
+	};
+	struct c_hdrs_cache cache;
+	uint8_t old_hdrs[TEST_HDRS_LEN];
+	uint8_t new_hdrs[TEST_HDRS_LEN];
+	size_t i;
+
+	for(i = 0; i < TEST_HDRS_LEN; i++)
+	{
+		old_hdrs[i] = i * 37;
+	}
+	setup_cache(&cache, old_hdrs);
+
+	/* same header chain: nothing changed */
+	memcpy(new_hdrs, old_hdrs, TEST_HDRS_LEN);
+	assert_int_equal(c_hdrs_cache_cmp(&cache, new_hdrs, TEST_HDRS_LEN), 0);
+
+	/* one change at a time */
+	for(i = 0; i < (sizeof(changes) / sizeof(changes[0])); i++)
+	{
+		memcpy(new_hdrs, old_hdrs, TEST_HDRS_LEN);
+		new_hdrs[changes[i].offset] ^= changes[i].bits;
+		assert_int_equal(c_hdrs_cache_cmp(&cache, new_hdrs, TEST_HDRS_LEN),
+		                 changes[i].changed);
+	}
+
+	/* several changes at once */
+	memcpy(new_hdrs, old_hdrs, TEST_HDRS_LEN);
+	new_hdrs[2] ^= 0xff;
+	new_hdrs[8] ^= 0xff;
+	new_hdrs[30] ^= 0xff;
+	assert_int_equal(c_hdrs_cache_cmp(&cache, new_hdrs, TEST_HDRS_LEN),
+	                 ROHC_HDRS_ALL);
+
+	/* the new header chain becomes the reference once recorded */
+	c_hdrs_cache_store(&cache, new_hdrs);
+	assert_int_equal(c_hdrs_cache_cmp(&cache, new_hdrs, TEST_HDRS_LEN), 0);
+	assert_int_equal(c_hdrs_cache_cmp(&cache, old_hdrs, TEST_HDRS_LEN),
+	                 ROHC_HDRS_ALL);
+}
+
+
+/** Test that the bits classified again leave their former class */
+static void test_hdrs_cache_classify(void **state __attribute__((unused)))
+{
+	struct c_hdrs_cache cache;
+	uint8_t old_hdrs[TEST_HDRS_LEN];
+	uint8_t new_hdrs[TEST_HDRS_LEN];
+
+	memset(old_hdrs, 0, TEST_HDRS_LEN);
+	setup_cache(&cache, old_hdrs);
+
+	/* static bits become dynamic */
+	c_hdrs_cache_classify(&cache, 0, 1, 0x0f, ROHC_HDRS_DYNAMIC);
+	memcpy(new_hdrs, old_hdrs, TEST_HDRS_LEN);
+	new_hdrs[0] ^= 0x0f;
+	assert_int_equal(c_hdrs_cache_cmp(&cache, new_hdrs, TEST_HDRS_LEN),
+	                 ROHC_HDRS_DYNAMIC);
+	new_hdrs[0] ^= 0xf0;
+	assert_int_equal(c_hdrs_cache_cmp(&cache, new_hdrs, TEST_HDRS_LEN),
+	                 ROHC_HDRS_STATIC | ROHC_HDRS_DYNAMIC);
+
+	/* dynamic bits become inferred */
+	c_hdrs_cache_classify(&cache, 30, 13, 0xff, ROHC_HDRS_INFERRED);
+	memcpy(new_hdrs, old_hdrs, TEST_HDRS_LEN);
+	new_hdrs[35] ^= 0xff;
+	new_hdrs[42] ^= 0x01;
+	assert_int_equal(c_hdrs_cache_cmp(&cache, new_hdrs, TEST_HDRS_LEN),
+	                 ROHC_HDRS_INFERRED);
+
+	/* a new header chain starts with transmitted dynamic fields only */
+	assert_true(c_hdrs_cache_set_len(&cache, TEST_HDRS_LEN));
+	c_hdrs_cache_store(&cache, old_hdrs);
+	memcpy(new_hdrs, old_hdrs, TEST_HDRS_LEN);
+	new_hdrs[0] ^= 0xff;
+	new_hdrs[4] ^= 0xff;
+	assert_int_equal(c_hdrs_cache_cmp(&cache, new_hdrs, TEST_HDRS_LEN),
+	                 ROHC_HDRS_DYNAMIC);
+}
+
+
+/**
+ * @brief Run all the tests of the word-wise detection of header changes
+ *
+ * @param argc  The number of command line arguments
+ * @param argv  The command line arguments
+ * @return      0 if all tests succeeded, non-zero otherwise
+ */
+int main(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
+{
+#if defined(HAVE_CMOCKA_RUN_GROUP_TESTS) && HAVE_CMOCKA_RUN_GROUP_TESTS == 1
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_hdrs_cache_len),
+		cmocka_unit_test(test_hdrs_cache_cmp),
+		cmocka_unit_test(test_hdrs_cache_classify),
+	};
+	return cmocka_run_group_tests(tests, NULL, NULL);
+#elif defined(HAVE_CMOCKA_RUN_TESTS) && HAVE_CMOCKA_RUN_TESTS == 1
+	const UnitTest tests[] = {
+		unit_test(test_hdrs_cache_len),
+		unit_test(test_hdrs_cache_cmp),
+		unit_test(test_hdrs_cache_classify),
+	};
+	return run_tests(tests);
+#else
+#  error "no function found to run cmocka tests"
+#endif
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file    /comp/comp/schemes/test/test_reorder_ratio.c
+ * @brief   Test the adaptive reorder ratio of the ROHCv2 profiles
+ * @author  agent <agent@local>
+ */
+
+#include "comp_reorder_ratio.h"
+
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <cmocka.h>
+
+#include "config.h" /* for HAVE_CMOCKA_RUN(_GROUP)?_TESTS */
+
+
+/** Test \ref c_reorder_ratio_add_msn */
+static void test_reorder_ratio_add_msn(void **state __attribute__((unused)))
+{
+	struct c_reorder_ratio reorder;
+	uint32_t msn;
+
+	c_reorder_ratio_init(&reorder, ROHC_REORDERING_NONE, 16);
+	assert_true(reorder.ratio == ROHC_REORDERING_NONE);
+
+	/* MSN in order: no change */
+	for(msn = 100; msn <= 110; msn++)
+	{
+		assert_false(c_reorder_ratio_add_msn(&reorder, msn));
+	}
+	assert_true(reorder.ratio == ROHC_REORDERING_NONE);
+
+	/* MSN 2 packets late: 1/4 of the interval covers it */
+	assert_true(c_reorder_ratio_add_msn(&reorder, 108));
+	assert_true(reorder.ratio == ROHC_REORDERING_QUARTER);
+
+	/* MSN 5 packets late: 1/2 of the interval covers it */
+	assert_true(c_reorder_ratio_add_msn(&reorder, 105));
+	assert_true(reorder.ratio == ROHC_REORDERING_HALF);
+
+	/* MSN 1 packet late: the ratio is never lowered by reordering */
+	assert_false(c_reorder_ratio_add_msn(&reorder, 109));
+	assert_true(reorder.ratio == ROHC_REORDERING_HALF);
+
+	/* MSN 20 packets late: 3/4 of the interval is the maximum */
+	assert_true(c_reorder_ratio_add_msn(&reorder, 90));
+	assert_true(reorder.ratio == ROHC_REORDERING_THREEQUARTERS);
+	assert_false(c_reorder_ratio_add_msn(&reorder, 80));
+	assert_true(reorder.ratio == ROHC_REORDERING_THREEQUARTERS);
+
+	/* 16-bit MSN wraparound is not reordering */
+	c_reorder_ratio_init(&reorder, ROHC_REORDERING_NONE, 16);
+	assert_false(c_reorder_ratio_add_msn(&reorder, 0xfffe));
+	assert_false(c_reorder_ratio_add_msn(&reorder, 0xffff));
+	assert_false(c_reorder_ratio_add_msn(&reorder, 0x0000));
+	assert_false(c_reorder_ratio_add_msn(&reorder, 0x0001));
+	assert_true(reorder.ratio == ROHC_REORDERING_NONE);
+	assert_true(c_reorder_ratio_add_msn(&reorder, 0xfffd));
+	assert_true(reorder.ratio == ROHC_REORDERING_HALF);
+
+	/* 32-bit MSN wraparound is not reordering */
+	c_reorder_ratio_init(&reorder, ROHC_REORDERING_NONE, 32);
+	assert_false(c_reorder_ratio_add_msn(&reorder, 0xffffffff));
+	assert_false(c_reorder_ratio_add_msn(&reorder, 0x00000000));
+	assert_true(reorder.ratio == ROHC_REORDERING_NONE);
+	assert_true(c_reorder_ratio_add_msn(&reorder, 0xfffffffe));
+	assert_true(reorder.ratio == ROHC_REORDERING_QUARTER);
+}
+
+
+/** Test \ref c_reorder_ratio_ack and \ref c_reorder_ratio_nack */
+static void test_reorder_ratio_ack(void **state __attribute__((unused)))
+{
+	struct c_reorder_ratio reorder;
+	uint32_t msn;
+	size_t i;
+
+	c_reorder_ratio_init(&reorder, ROHC_REORDERING_NONE, 16);
+
+	/* ACKs in order: no change */
+	assert_false(c_reorder_ratio_ack(&reorder, 10));
+	assert_false(c_reorder_ratio_ack(&reorder, 11));
+	assert_false(c_reorder_ratio_ack(&reorder, 11));
+	assert_true(reorder.ratio == ROHC_REORDERING_NONE);
+
+	/* ACK for a MSN 3 packets older than the newest acknowledged one */
+	assert_true(c_reorder_ratio_ack(&reorder, 8));
+	assert_true(reorder.ratio == ROHC_REORDERING_QUARTER);
+
+	/* the ratio is lowered by one step after enough ACKs in order */
+	msn = 12;
+	for(i = 0; i < (ROHC_REORDER_RATIO_ACKS_NR - 1); i++, msn++)
+	{
+		assert_false(c_reorder_ratio_ack(&reorder, msn));
+	}
+	assert_true(reorder.ratio == ROHC_REORDERING_QUARTER);
+	assert_true(c_reorder_ratio_ack(&reorder, msn));
+	msn++;
+	assert_true(reorder.ratio == ROHC_REORDERING_NONE);
+
+	/* a NACK restarts the count of ACKs in order */
+	assert_true(c_reorder_ratio_ack(&reorder, msn - 3));
+	assert_true(reorder.ratio == ROHC_REORDERING_QUARTER);
+	for(i = 0; i < (ROHC_REORDER_RATIO_ACKS_NR - 1); i++, msn++)
+	{
+		assert_false(c_reorder_ratio_ack(&reorder, msn));
+	}
+	c_reorder_ratio_nack(&reorder);
+	for(i = 0; i < (ROHC_REORDER_RATIO_ACKS_NR - 1); i++, msn++)
+	{
+		assert_false(c_reorder_ratio_ack(&reorder, msn));
+	}
+	assert_true(reorder.ratio == ROHC_REORDERING_QUARTER);
+	assert_true(c_reorder_ratio_ack(&reorder, msn));
+	assert_true(reorder.ratio == ROHC_REORDERING_NONE);
+}
+
+
+/** Test that \ref c_reorder_ratio_ack never goes below the configured ratio */
+static void test_reorder_ratio_ack_min(void **state __attribute__((unused)))
+{
+	struct c_reorder_ratio reorder;
+	uint32_t msn;
+	size_t i;
+
+	c_reorder_ratio_init(&reorder, ROHC_REORDERING_HALF, 16);
+
+	/* many ACKs in order: the configured ratio is kept */
+	for(msn = 0; msn < (ROHC_REORDER_RATIO_ACKS_NR * 3); msn++)
+	{
+		assert_false(c_reorder_ratio_ack(&reorder, msn));
+	}
+	assert_true(reorder.ratio == ROHC_REORDERING_HALF);
+
+	/* ACK for a MSN 10 packets older than the newest acknowledged one */
+	assert_true(c_reorder_ratio_ack(&reorder, msn - 11));
+	assert_true(reorder.ratio == ROHC_REORDERING_THREEQUARTERS);
+
+	/* the ratio is lowered back to the configured ratio, not below */
+	for(i = 0; i < (ROHC_REORDER_RATIO_ACKS_NR - 1); i++, msn++)
+	{
+		assert_false(c_reorder_ratio_ack(&reorder, msn));
+	}
+	assert_true(c_reorder_ratio_ack(&reorder, msn));
+	msn++;
+	assert_true(reorder.ratio == ROHC_REORDERING_HALF);
+	for(i = 0; i < (ROHC_REORDER_RATIO_ACKS_NR * 3); i++, msn++)
+	{
+		assert_false(c_reorder_ratio_ack(&reorder, msn));
+	}
+	assert_true(reorder.ratio == ROHC_REORDERING_HALF);
+}
+
+
+/**
+ * @brief Run all the tests of the adaptive reorder ratio
+ *
+ * @param argc  The number of command line arguments
+ * @param argv  The command line arguments
+ * @return      0 if all tests succeeded, non-zero otherwise
+ */
+int main(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
+{
+#if defined(HAVE_CMOCKA_RUN_GROUP_TESTS) && HAVE_CMOCKA_RUN_GROUP_TESTS == 1
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_reorder_ratio_add_msn),
+		cmocka_unit_test(test_reorder_ratio_ack),
+		cmocka_unit_test(test_reorder_ratio_ack_min),
+	};
+	return cmocka_run_group_tests(tests, NULL, NULL);
+#elif defined(HAVE_CMOCKA_RUN_TESTS) && HAVE_CMOCKA_RUN_TESTS == 1
+	const UnitTest tests[] = {
+		unit_test(test_reorder_ratio_add_msn),
+		unit_test(test_reorder_ratio_ack),
+		unit_test(test_reorder_ratio_ack_min),
+	};
+	return run_tests(tests);
+#else
+#  error "no function found to run cmocka tests"
+#endif
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file    /comp/comp/schemes/test/test_ts_stride.c
+ * @brief   Test the estimation of TS_STRIDE from the last TS deltas
+ * @author  agent <agent@local>
+ */
+
+#include "comp_scaled_rtp_ts.h"
+
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <cmocka.h>
+
+#include "config.h" /* for HAVE_CMOCKA_RUN(_GROUP)?_TESTS */
+
+
+/** The number of repetitions of the optimistic approach */
+#define TEST_REPETITIONS_NR  3U
+
+/** The TS delta of one full frame */
+#define TEST_FULL_FRAME  960U
+
+/** The TS delta of one half frame */
+#define TEST_HALF_FRAME  480U
+
+
+/** The scaled RTP TS encoding of one RTP stream */
+struct test_stream
+{
+	struct ts_sc_comp ts_sc;  /**< The scaled RTP TS encoding */
+	uint32_t ts;              /**< The RTP TS of the next packet */
+	uint16_t sn;              /**< The RTP SN of the next packet */
+	size_t stride_changes;    /**< The number of changes of TS_STRIDE */
+};
+
+
+/**
+ * @brief Start one RTP stream
+ *
+ * @param stream  The RTP stream to start
+ */
+static void test_stream_init(struct test_stream *const stream)
+{
+	c_init_sc(&stream->ts_sc, 4, NULL, NULL);
+	stream->ts = 0x12345678;
+	stream->sn = 0xfff0;
+	stream->stride_changes = 0;
+}
+
+
+/**
+ * @brief Add the next packet of one RTP stream to the scaled RTP TS encoding
+ *
+ * The transitions from state INIT_STRIDE to state SEND_SCALED are the ones
+ * of the RTP profile once the packet is sent.
+ *
+ * @param stream    The RTP stream
+ * @param ts_delta  The TS delta between the previous packet and this one
+ */
+static void test_stream_add(struct test_stream *const stream,
+                            const uint32_t ts_delta)
+{
+	const uint32_t old_stride = get_ts_stride(&stream->ts_sc);
+
+	stream->ts += ts_delta;
+	stream->sn++;
+	c_add_ts(&stream->ts_sc, stream->ts, stream->sn, TEST_REPETITIONS_NR);
+	if(stream->ts_sc.state == INIT_STRIDE)
+	{
+		stream->ts_sc.nr_init_stride_packets++;
+		if(stream->ts_sc.nr_init_stride_packets >= TEST_REPETITIONS_NR)
+		{
+			stream->ts_sc.state = SEND_SCALED;
+		}
+	}
+
+	if(old_stride != 0 && get_ts_stride(&stream->ts_sc) != old_stride)
+	{
+		stream->stride_changes++;
+	}
+}
+
+
+/**
+ * @brief Add packets with the same TS delta to one RTP stream
+ *
+ * @param stream      The RTP stream
+ * @param ts_delta    The TS delta between the packets
+ * @param packets_nr  The number of packets to add
+ */
+static void test_stream_add_steady(struct test_stream *const stream,
+                                   const uint32_t ts_delta,
+                                   const size_t packets_nr)
+{
+	size_t i;
+
+	for(i = 0; i < packets_nr; i++)
+	{
+		test_stream_add(stream, ts_delta);
+	}
+}
+
+
+/** Test that TS_STRIDE shrinks when half frames show up */
+static void test_ts_stride_shrink(void **state __attribute__((unused)))
+{
+	struct test_stream stream;
+
+	test_stream_init(&stream);
+	test_stream_add_steady(&stream, TEST_FULL_FRAME, 20);
+	assert_int_equal(get_ts_stride(&stream.ts_sc), TEST_FULL_FRAME);
+	assert_int_equal(stream.ts_sc.state, SEND_SCALED);
+	assert_true(rohc_ts_sc_is_deducible(&stream.ts_sc));
+
+	/* one half frame: TS_STRIDE is the GCD of both frame sizes */
+	test_stream_add(&stream, TEST_HALF_FRAME);
+	assert_int_equal(get_ts_stride(&stream.ts_sc), TEST_HALF_FRAME);
+	assert_int_equal(stream.ts_sc.state, INIT_STRIDE);
+	assert_int_equal(stream.stride_changes, 1);
+
+	/* half frames only: TS_STRIDE is stable and TS is deducible again */
+	test_stream_add_steady(&stream, TEST_HALF_FRAME, 10);
+	assert_int_equal(get_ts_stride(&stream.ts_sc), TEST_HALF_FRAME);
+	assert_int_equal(stream.ts_sc.state, SEND_SCALED);
+	assert_true(rohc_ts_sc_is_deducible(&stream.ts_sc));
+	assert_int_equal(stream.stride_changes, 1);
+}
+
+
+/** Test that TS_STRIDE grows back only after many full frames in a row */
+static void test_ts_stride_grow_back(void **state __attribute__((unused)))
+{
+	struct test_stream stream;
+	size_t i;
+
+	test_stream_init(&stream);
+	test_stream_add_steady(&stream, TEST_FULL_FRAME, 20);
+	test_stream_add(&stream, TEST_HALF_FRAME);
+	assert_int_equal(get_ts_stride(&stream.ts_sc), TEST_HALF_FRAME);
+	assert_int_equal(stream.stride_changes, 1);
+
+	/* full frames with one half frame every 10 packets: the smaller TS_STRIDE
+	 * is kept, it does not flip between both frame sizes */
+	for(i = 0; i < 20; i++)
+	{
+		test_stream_add_steady(&stream, TEST_FULL_FRAME, 9);
+		test_stream_add(&stream, TEST_HALF_FRAME);
+		assert_int_equal(get_ts_stride(&stream.ts_sc), TEST_HALF_FRAME);
+	}
+	assert_int_equal(stream.stride_changes, 1);
+
+	/* full frames only: TS_STRIDE grows back, but not right away */
+	test_stream_add_steady(&stream, TEST_FULL_FRAME, ROHC_TS_STRIDE_GROW_DELTAS);
+	assert_int_equal(get_ts_stride(&stream.ts_sc), TEST_HALF_FRAME);
+	assert_int_equal(stream.stride_changes, 1);
+	test_stream_add_steady(&stream, TEST_FULL_FRAME, ROHC_TS_STRIDE_WINDOW);
+	assert_int_equal(get_ts_stride(&stream.ts_sc), TEST_FULL_FRAME);
+	assert_int_equal(stream.stride_changes, 2);
+
+	/* TS is deducible from SN again once the new TS_STRIDE was repeated */
+	test_stream_add_steady(&stream, TEST_FULL_FRAME, TEST_REPETITIONS_NR + 1);
+	assert_int_equal(stream.ts_sc.state, SEND_SCALED);
+	assert_true(rohc_ts_sc_is_deducible(&stream.ts_sc));
+	assert_int_equal(stream.stride_changes, 2);
+}
+
+
+/** Test that some jitter at source does not change TS_STRIDE */
+static void test_ts_stride_jitter(void **state __attribute__((unused)))
+{
+	struct test_stream stream;
+	size_t i;
+
+	test_stream_init(&stream);
+	test_stream_add_steady(&stream, TEST_FULL_FRAME, 20);
+	assert_int_equal(get_ts_stride(&stream.ts_sc), TEST_FULL_FRAME);
+
+	/* one frame 1 tick late, the next one on time, several times */
+	for(i = 0; i < 10; i++)
+	{
+		test_stream_add(&stream, TEST_FULL_FRAME + 1);
+		assert_int_equal(get_ts_stride(&stream.ts_sc), TEST_FULL_FRAME);
+		test_stream_add(&stream, TEST_FULL_FRAME - 1);
+		assert_int_equal(get_ts_stride(&stream.ts_sc), TEST_FULL_FRAME);
+		test_stream_add_steady(&stream, TEST_FULL_FRAME, 5);
+	}
+	assert_int_equal(stream.stride_changes, 0);
+
+	/* TS_OFFSET is re-synchronised and TS is deducible from SN again */
+	test_stream_add_steady(&stream, TEST_FULL_FRAME, TEST_REPETITIONS_NR + 1);
+	assert_int_equal(stream.ts_sc.state, SEND_SCALED);
+	assert_true(rohc_ts_sc_is_deducible(&stream.ts_sc));
+	assert_int_equal(stream.ts_sc.ts_offset, stream.ts % TEST_FULL_FRAME);
+}
+
+
+/**
+ * @brief Run all the tests of the estimation of TS_STRIDE
+ *
+ * @param argc  The number of command line arguments
+ * @param argv  The command line arguments
+ * @return      0 if all tests succeeded, non-zero otherwise
+ */
+int main(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
+{
+#if defined(HAVE_CMOCKA_RUN_GROUP_TESTS) && HAVE_CMOCKA_RUN_GROUP_TESTS == 1
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_ts_stride_shrink),
+		cmocka_unit_test(test_ts_stride_grow_back),
+		cmocka_unit_test(test_ts_stride_jitter),
+	};
+	return cmocka_run_group_tests(tests, NULL, NULL);
+#elif defined(HAVE_CMOCKA_RUN_TESTS) && HAVE_CMOCKA_RUN_TESTS == 1
+	const UnitTest tests[] = {
+		unit_test(test_ts_stride_shrink),
+		unit_test(test_ts_stride_grow_back),
+		unit_test(test_ts_stride_jitter),
+	};
+	return run_tests(tests);
+#else
+#  error "no function found to run cmocka tests"
+#endif
+}
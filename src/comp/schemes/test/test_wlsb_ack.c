@@ -0,0 +1,284 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file    /comp/comp/schemes/test/test_wlsb_ack.c
+ * @brief   Test the W-LSB windows driven by the positive ACKs
+ * @author  agent <agent@local>
+ */
+
+#include "comp_wlsb.h"
+
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <cmocka.h>
+
+#include "config.h" /* for HAVE_CMOCKA_RUN(_GROUP)?_TESTS */
+
+
+/** The initial width of the W-LSB windows */
+#define TEST_WIDTH  4U
+
+/** The delta between the successive values of the W-LSB windows */
+#define TEST_DELTA  1000U
+
+
+/**
+ * @brief Create an ACK-driven W-LSB window for 32-bit values
+ *
+ * @param[out] wlsb  The W-LSB object
+ */
+static void test_wlsb_init(struct c_wlsb *const wlsb)
+{
+	wlsb_init(wlsb, 32, TEST_WIDTH, ROHC_LSB_SHIFT_SN);
+	wlsb_set_ack_driven(wlsb, true);
+}
+
+
+/**
+ * @brief Add the values of the given SNs to the W-LSB window
+ *
+ * The value of SN n is n * TEST_DELTA.
+ *
+ * @param wlsb      The W-LSB object
+ * @param first_sn  The first SN to add
+ * @param last_sn   The last SN to add
+ */
+static void test_wlsb_add(struct c_wlsb *const wlsb,
+                          const uint32_t first_sn,
+                          const uint32_t last_sn)
+{
+	uint32_t sn;
+
+	for(sn = first_sn; sn <= last_sn; sn++)
+	{
+		c_add_wlsb(wlsb, sn, sn * TEST_DELTA);
+	}
+}
+
+
+/**
+ * @brief Whether the W-LSB object memoized a bit width for the given window
+ *
+ * @param wlsb   The W-LSB object
+ * @param count  The number of references of the steady window
+ * @param k      The memoized bit width
+ * @return       true if the bit width was memoized, false otherwise
+ */
+static bool is_memoized(const struct c_wlsb *const wlsb,
+                        const size_t count,
+                        const size_t k)
+{
+	size_t i;
+
+	for(i = 0; i < ROHC_WLSB_MEMO_MAX; i++)
+	{
+		if(wlsb->memos[i].used &&
+		   wlsb->memos[i].count == count &&
+		   wlsb->memos[i].delta == TEST_DELTA &&
+		   wlsb->memos[i].k == k)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/** Test that an ACK-driven window grows until the next ACK */
+static void test_wlsb_ack_grow(void **state __attribute__((unused)))
+{
+	struct c_wlsb wlsb;
+	uint32_t sn;
+
+	test_wlsb_init(&wlsb);
+
+	/* no ACK: all the values are kept beyond the initial width */
+	test_wlsb_add(&wlsb, 0, 19);
+	assert_int_equal(wlsb.count, 20);
+	assert_true(wlsb.window_width >= 20);
+	for(sn = 0; sn <= 19; sn++)
+	{
+		assert_true(wlsb_is_sn_present(&wlsb, sn));
+	}
+
+	/* a window that is not ACK-driven keeps the last values only */
+	wlsb_set_ack_driven(&wlsb, false);
+	wlsb_set_window_width(&wlsb, TEST_WIDTH);
+	assert_int_equal(wlsb.count, TEST_WIDTH);
+	test_wlsb_add(&wlsb, 20, 29);
+	assert_int_equal(wlsb.count, TEST_WIDTH);
+	assert_false(wlsb_is_sn_present(&wlsb, 25));
+	assert_true(wlsb_is_sn_present(&wlsb, 26));
+}
+
+
+/** Test that an ACK shrinks the window to the secure reference */
+static void test_wlsb_ack_shrink(void **state __attribute__((unused)))
+{
+	struct c_wlsb wlsb;
+	size_t k_secure;
+	uint32_t sn;
+
+	test_wlsb_init(&wlsb);
+	test_wlsb_add(&wlsb, 0, 19);
+
+	/* the ACK of SN 12 removes the 12 older values, SN 12 is kept as the
+	 * secure reference */
+	assert_int_equal(wlsb_ack(&wlsb, 12, 32), 12);
+	assert_int_equal(wlsb.count, 8);
+	for(sn = 0; sn < 12; sn++)
+	{
+		assert_false(wlsb_is_sn_present(&wlsb, sn));
+	}
+	for(sn = 12; sn <= 19; sn++)
+	{
+		assert_true(wlsb_is_sn_present(&wlsb, sn));
+	}
+
+	/* the values are encoded against the secure reference: the new value
+	 * is 8000 away from it, so it needs 13 bits at least */
+	k_secure = wlsb_get_kp_32bits(&wlsb, 20 * TEST_DELTA, ROHC_LSB_SHIFT_SN);
+	assert_true(k_secure >= 13);
+
+	/* the ACK of an unknown SN removes nothing */
+	assert_int_equal(wlsb_ack(&wlsb, 5, 32), 0);
+	assert_int_equal(wlsb.count, 8);
+
+	/* the ACK of the newest SN leaves it alone in the window */
+	assert_int_equal(wlsb_ack(&wlsb, 19, 32), 7);
+	assert_int_equal(wlsb.count, 1);
+	assert_true(wlsb_get_kp_32bits(&wlsb, 20 * TEST_DELTA,
+	                               ROHC_LSB_SHIFT_SN) < k_secure);
+}
+
+
+/** Test that the secure reference survives once the window is at its max */
+static void test_wlsb_ack_max_width(void **state __attribute__((unused)))
+{
+	const uint32_t last_sn = ROHC_WLSB_WIDTH_MAX + 20;
+	struct c_wlsb wlsb;
+	uint32_t sn;
+
+	test_wlsb_init(&wlsb);
+	test_wlsb_add(&wlsb, 0, 5);
+	assert_int_equal(wlsb_ack(&wlsb, 5, 32), 5);
+
+	/* no ACK anymore: the window cannot grow beyond ROHC_WLSB_WIDTH_MAX, the
+	 * next oldest values are dropped in place of the secure reference */
+	test_wlsb_add(&wlsb, 6, last_sn);
+	assert_int_equal(wlsb.window_width, ROHC_WLSB_WIDTH_MAX);
+	assert_int_equal(wlsb.count, ROHC_WLSB_WIDTH_MAX);
+	assert_true(wlsb_is_sn_present(&wlsb, 5));
+	for(sn = 6; sn <= (last_sn - ROHC_WLSB_WIDTH_MAX + 1); sn++)
+	{
+		assert_false(wlsb_is_sn_present(&wlsb, sn));
+	}
+	for(; sn <= last_sn; sn++)
+	{
+		assert_true(wlsb_is_sn_present(&wlsb, sn));
+	}
+
+	/* the next value is still encoded against the secure reference */
+	assert_true(wlsb_get_kp_32bits(&wlsb, (last_sn + 1) * TEST_DELTA,
+	                               ROHC_LSB_SHIFT_SN) >= 17);
+
+	/* a late ACK shrinks the window again */
+	assert_int_equal(wlsb_ack(&wlsb, last_sn - 1, 32),
+	                 ROHC_WLSB_WIDTH_MAX - 2);
+	assert_int_equal(wlsb.count, 2);
+}
+
+
+/** Test that the memoized bit widths are keyed on the number of references */
+static void test_wlsb_ack_memo_count(void **state __attribute__((unused)))
+{
+	struct c_wlsb wlsb;
+	size_t k_large;
+	size_t k_small;
+	size_t k;
+	uint32_t sn;
+
+	test_wlsb_init(&wlsb);
+
+	/* the steady window grows without ACK: every number of references gets
+	 * the bit width of the full search */
+	for(sn = 0; sn < 16; sn++)
+	{
+		const uint32_t value = sn * TEST_DELTA;
+
+		k = wlsb_get_minkp_32bits_memo(&wlsb, value, 0, ROHC_LSB_SHIFT_SN);
+		assert_int_equal(k, wlsb_get_kp_32bits(&wlsb, value, ROHC_LSB_SHIFT_SN));
+		c_add_wlsb(&wlsb, sn, value);
+	}
+	k_large = wlsb_get_minkp_32bits_memo(&wlsb, 16 * TEST_DELTA, 0,
+	                                     ROHC_LSB_SHIFT_SN);
+	assert_true(is_memoized(&wlsb, 16, k_large));
+
+	/* the ACK shrinks the window: the memo of the larger window is not
+	 * reused for the same delta */
+	assert_int_equal(wlsb_ack(&wlsb, 14, 32), 14);
+	assert_int_equal(wlsb.count, 2);
+	k_small = wlsb_get_minkp_32bits_memo(&wlsb, 16 * TEST_DELTA, 0,
+	                                     ROHC_LSB_SHIFT_SN);
+	assert_int_equal(k_small, wlsb_get_kp_32bits(&wlsb, 16 * TEST_DELTA,
+	                                             ROHC_LSB_SHIFT_SN));
+	assert_true(k_small < k_large);
+	assert_true(is_memoized(&wlsb, 2, k_small));
+	assert_true(is_memoized(&wlsb, 16, k_large));
+
+	/* the next window with 2 references reuses the memo */
+	assert_int_equal(wlsb_ack(&wlsb, 15, 32), 1);
+	c_add_wlsb(&wlsb, 16, 16 * TEST_DELTA);
+	assert_int_equal(wlsb.count, 2);
+	assert_int_equal(wlsb_get_minkp_32bits_memo(&wlsb, 17 * TEST_DELTA, 0,
+	                                            ROHC_LSB_SHIFT_SN),
+	                 k_small);
+}
+
+
+/**
+ * @brief Run all the tests of the ACK-driven W-LSB windows
+ *
+ * @param argc  The number of command line arguments
+ * @param argv  The command line arguments
+ * @return      0 if all tests succeeded, non-zero otherwise
+ */
+int main(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
+{
+#if defined(HAVE_CMOCKA_RUN_GROUP_TESTS) && HAVE_CMOCKA_RUN_GROUP_TESTS == 1
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_wlsb_ack_grow),
+		cmocka_unit_test(test_wlsb_ack_shrink),
+		cmocka_unit_test(test_wlsb_ack_max_width),
+		cmocka_unit_test(test_wlsb_ack_memo_count),
+	};
+	return cmocka_run_group_tests(tests, NULL, NULL);
+#elif defined(HAVE_CMOCKA_RUN_TESTS) && HAVE_CMOCKA_RUN_TESTS == 1
+	const UnitTest tests[] = {
+		unit_test(test_wlsb_ack_grow),
+		unit_test(test_wlsb_ack_shrink),
+		unit_test(test_wlsb_ack_max_width),
+		unit_test(test_wlsb_ack_memo_count),
+	};
+	return run_tests(tests);
+#else
+#  error "no function found to run cmocka tests"
+#endif
+}
@@ -0,0 +1,346 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file    /comp/comp/schemes/test/test_wlsb_memo.c
+ * @brief   Test the bit widths memoized for the steady W-LSB windows
+ * @author  agent <agent@local>
+ */
+
+#include "comp_wlsb.h"
+
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <cmocka.h>
+
+#include "config.h" /* for HAVE_CMOCKA_RUN(_GROUP)?_TESTS */
+
+
+/** One search of the minimal number of bits */
+struct test_search
+{
+	size_t min_k;         /**< The minimum number of bits to find out */
+	rohc_lsb_shift_t p;   /**< The shift parameter p */
+};
+
+
+/**
+ * The searches to check the 32-bit fields with, the W-LSB objects are all
+ * created with the shift parameter for the scaled TCP sequence numbers
+ */
+static const struct test_search test_searches_32bits[] = {
+	{ 0, ROHC_LSB_SHIFT_SN },
+	{ 0, ROHC_LSB_SHIFT_IP_ID },
+	{ 0, ROHC_LSB_SHIFT_TCP_SN },
+	{ 0, ROHC_LSB_SHIFT_TCP_SEQ_SCALED },
+	{ 0, ROHC_LSB_SHIFT_TCP_WINDOW },
+	{ 0, ROHC_LSB_SHIFT_TCP_TS_3B },
+	{ 8, ROHC_LSB_SHIFT_TCP_SEQ_SCALED },
+	{ 16, ROHC_LSB_SHIFT_TCP_SEQ_SCALED },
+};
+
+/** The searches to check the 16-bit fields with */
+static const struct test_search test_searches_16bits[] = {
+	{ 0, ROHC_LSB_SHIFT_SN },
+	{ 0, ROHC_LSB_SHIFT_IP_ID },
+	{ 0, ROHC_LSB_SHIFT_TCP_SN },
+	{ 0, ROHC_LSB_SHIFT_TCP_WINDOW },
+	{ 4, ROHC_LSB_SHIFT_IP_ID },
+	{ 8, ROHC_LSB_SHIFT_IP_ID },
+};
+
+
+/**
+ * @brief Check the memoized bit width of a 32-bit value, then add it
+ *
+ * The memoized search shall return the same number of bits as the full
+ * search. Every W-LSB object is always searched with the same parameters,
+ * as the compression profiles do, so that the memos are actually used.
+ *
+ * @param wlsb    The W-LSB object
+ * @param search  The parameters of the search
+ * @param sn      The SN of the value
+ * @param value   The value to encode
+ */
+static void check_and_add_32bits(struct c_wlsb *const wlsb,
+                                 const struct test_search *const search,
+                                 const uint32_t sn,
+                                 const uint32_t value)
+{
+	const size_t k = wlsb_get_minkp_32bits_memo(wlsb, value, search->min_k,
+	                                            search->p);
+
+	if(search->min_k == 0)
+	{
+		assert_int_equal(k, wlsb_get_kp_32bits(wlsb, value, search->p));
+	}
+	else
+	{
+		assert_int_equal(search->p, wlsb->p);
+		assert_int_equal(k, wlsb_get_mink_32bits(wlsb, value, search->min_k));
+	}
+
+	c_add_wlsb(wlsb, sn, value);
+}
+
+
+/**
+ * @brief Check the memoized bit width of a 16-bit value, then add it
+ *
+ * @param wlsb    The W-LSB object
+ * @param search  The parameters of the search
+ * @param sn      The SN of the value
+ * @param value   The value to encode
+ */
+static void check_and_add_16bits(struct c_wlsb *const wlsb,
+                                 const struct test_search *const search,
+                                 const uint32_t sn,
+                                 const uint16_t value)
+{
+	assert_int_equal(wlsb_get_minkp_16bits_memo(wlsb, value, search->min_k,
+	                                            search->p),
+	                 wlsb_get_minkp_16bits(wlsb, value, search->min_k,
+	                                       search->p));
+
+	c_add_wlsb(wlsb, sn, value);
+}
+
+
+/**
+ * @brief Whether the W-LSB object memoized a bit width for the given delta
+ *
+ * @param wlsb   The W-LSB object
+ * @param delta  The delta between the values of the steady window
+ * @return       true if a bit width was memoized, false otherwise
+ */
+static bool is_memoized(const struct c_wlsb *const wlsb, const uint32_t delta)
+{
+	size_t i;
+
+	for(i = 0; i < ROHC_WLSB_MEMO_MAX; i++)
+	{
+		if(wlsb->memos[i].used &&
+		   wlsb->memos[i].count == wlsb->count &&
+		   wlsb->memos[i].delta == delta)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/** Test the memoized bit widths of steady 32-bit windows */
+static void test_wlsb_memo_steady(void **state __attribute__((unused)))
+{
+	const size_t widths[] = { 1, 4, 16 };
+	const uint32_t deltas[] = { 0, 1, 1448, 0x10000 };
+	struct c_wlsb wlsb;
+	size_t search;
+	size_t i;
+	size_t j;
+	uint32_t sn;
+
+	for(search = 0; search < (sizeof(test_searches_32bits) /
+	                          sizeof(struct test_search)); search++)
+	{
+		for(i = 0; i < (sizeof(widths) / sizeof(size_t)); i++)
+		{
+			for(j = 0; j < (sizeof(deltas) / sizeof(uint32_t)); j++)
+			{
+				/* start close to the wraparound of the field */
+				uint32_t value = 0xffffffff - 20 * deltas[j];
+
+				wlsb_init(&wlsb, 32, widths[i], ROHC_LSB_SHIFT_TCP_SEQ_SCALED);
+				for(sn = 0; sn < 50; sn++)
+				{
+					check_and_add_32bits(&wlsb, &test_searches_32bits[search], sn,
+					                     value);
+					value += deltas[j];
+				}
+				assert_true(is_memoized(&wlsb, deltas[j]));
+			}
+		}
+	}
+}
+
+
+/** Test the memoized bit widths of 32-bit windows that are not steady */
+static void test_wlsb_memo_unsteady(void **state __attribute__((unused)))
+{
+	const size_t widths[] = { 4, 16 };
+	const struct test_search *search;
+	struct c_wlsb wlsb;
+	uint32_t value;
+	size_t i;
+	size_t j;
+	uint32_t sn;
+
+	for(j = 0; j < (sizeof(test_searches_32bits) /
+	                sizeof(struct test_search)); j++)
+	{
+		search = &test_searches_32bits[j];
+
+		for(i = 0; i < (sizeof(widths) / sizeof(size_t)); i++)
+		{
+			wlsb_init(&wlsb, 32, widths[i], ROHC_LSB_SHIFT_TCP_SEQ_SCALED);
+
+			/* steady window, then a jump forward and a jump backward: the window
+			 * keeps the jumps for a while, it is not steady until they leave it */
+			value = 1000;
+			for(sn = 0; sn < 30; sn++)
+			{
+				check_and_add_32bits(&wlsb, search, sn, value);
+				value++;
+			}
+			assert_true(is_memoized(&wlsb, 1));
+			value += 100000;
+			for(; sn < 60; sn++)
+			{
+				check_and_add_32bits(&wlsb, search, sn, value);
+				value++;
+			}
+			value -= 200000;
+			for(; sn < 90; sn++)
+			{
+				check_and_add_32bits(&wlsb, search, sn, value);
+				value++;
+			}
+
+			/* TCP bulk transfer: full segments with a short one every 45
+			 * segments, and pure ACKs that do not change the sequence number */
+			value = 0x10000000;
+			for(; sn < 500; sn++)
+			{
+				check_and_add_32bits(&wlsb, search, sn, value);
+				if((sn % 45) == 0)
+				{
+					value += 700;
+				}
+				else if((sn % 7) != 0)
+				{
+					value += 1448;
+				}
+			}
+
+			/* the window is resized while it is steady */
+			for(; sn < 550; sn++)
+			{
+				check_and_add_32bits(&wlsb, search, sn, value);
+				value += 1448;
+			}
+			wlsb_set_window_width(&wlsb, widths[i] / 2);
+			for(; sn < 600; sn++)
+			{
+				check_and_add_32bits(&wlsb, search, sn, value);
+				value += 1448;
+			}
+
+			/* the window is reset while it is steady */
+			wlsb_reset(&wlsb);
+			for(; sn < 650; sn++)
+			{
+				check_and_add_32bits(&wlsb, search, sn, value);
+				value += 3;
+			}
+
+			/* the window is driven by the positive ACKs: it grows until the
+			 * next ACK, then shrinks to the acknowledged value and the next
+			 * ones */
+			wlsb_set_ack_driven(&wlsb, true);
+			for(; sn < 750; sn++)
+			{
+				check_and_add_32bits(&wlsb, search, sn, value);
+				value += ((sn % 10) == 0 ? 500 : 3);
+				if((sn % 8) == 0)
+				{
+					assert_true(wlsb_ack(&wlsb, sn - 1, 32) > 0);
+				}
+			}
+		}
+	}
+}
+
+
+/** Test the memoized bit widths of 16-bit windows */
+static void test_wlsb_memo_16bits(void **state __attribute__((unused)))
+{
+	const struct test_search *search;
+	struct c_wlsb wlsb;
+	uint16_t value;
+	size_t i;
+	uint32_t sn;
+
+	for(i = 0; i < (sizeof(test_searches_16bits) /
+	                sizeof(struct test_search)); i++)
+	{
+		search = &test_searches_16bits[i];
+		wlsb_init(&wlsb, 16, 4, ROHC_LSB_SHIFT_IP_ID);
+
+		/* sequential IP-ID across the wraparound of the field */
+		value = 0xffe0;
+		for(sn = 0; sn < 100; sn++)
+		{
+			check_and_add_16bits(&wlsb, search, sn, value);
+			value++;
+		}
+		assert_true(is_memoized(&wlsb, 1));
+
+		/* byte-swapped sequential IP-ID, then random jumps */
+		for(; sn < 200; sn++)
+		{
+			check_and_add_16bits(&wlsb, search, sn, value);
+			value += 0x100;
+		}
+		for(; sn < 300; sn++)
+		{
+			check_and_add_16bits(&wlsb, search, sn, value);
+			value += (sn * 7919) & 0x3ff;
+		}
+	}
+}
+
+
+/**
+ * @brief Run all the tests of the memoized W-LSB bit widths
+ *
+ * @param argc  The number of command line arguments
+ * @param argv  The command line arguments
+ * @return      0 if all tests succeeded, non-zero otherwise
+ */
+int main(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
+{
+#if defined(HAVE_CMOCKA_RUN_GROUP_TESTS) && HAVE_CMOCKA_RUN_GROUP_TESTS == 1
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_wlsb_memo_steady),
+		cmocka_unit_test(test_wlsb_memo_unsteady),
+		cmocka_unit_test(test_wlsb_memo_16bits),
+	};
+	return cmocka_run_group_tests(tests, NULL, NULL);
+#elif defined(HAVE_CMOCKA_RUN_TESTS) && HAVE_CMOCKA_RUN_TESTS == 1
+	const UnitTest tests[] = {
+		unit_test(test_wlsb_memo_steady),
+		unit_test(test_wlsb_memo_unsteady),
+		unit_test(test_wlsb_memo_16bits),
+	};
+	return run_tests(tests);
+#else
+#  error "no function found to run cmocka tests"
+#endif
+}
@@ -253,12 +253,31 @@ int main(int argc, char *argv[])
 	CHECK(rohc_comp_set_periodic_refreshes_time(comp, 5, 10) == false);
 	CHECK(rohc_comp_set_periodic_refreshes_time(comp, 10, 5) == true);
 
+	/* rohc_comp_set_periodic_refreshes_jitter() */
+	CHECK(rohc_comp_set_periodic_refreshes_jitter(NULL, 10) == false);
+	CHECK(rohc_comp_set_periodic_refreshes_jitter(comp, 51) == false);
+	CHECK(rohc_comp_set_periodic_refreshes_jitter(comp, 50) == true);
+	CHECK(rohc_comp_set_periodic_refreshes_jitter(comp, 0) == true);
+
+	/* rohc_comp_set_refreshes_rate() */
+	CHECK(rohc_comp_set_refreshes_rate(NULL, 2, 10) == false);
+	CHECK(rohc_comp_set_refreshes_rate(comp, 2, 0) == false);
+	CHECK(rohc_comp_set_refreshes_rate(comp, 2, 10) == true);
+	CHECK(rohc_comp_set_refreshes_rate(comp, 0, 1) == true);
+
 	/* rohc_comp_set_list_trans_nr() */
 	CHECK(rohc_comp_set_list_trans_nr(NULL, 5) == false);
 	CHECK(rohc_comp_set_list_trans_nr(comp, 0) == false);
 	CHECK(rohc_comp_set_list_trans_nr(comp, 1) == true);
 	CHECK(rohc_comp_set_list_trans_nr(comp, 5) == true);
 
+	/* rohc_comp_set_channel_ber() */
+	CHECK(rohc_comp_set_channel_ber(NULL, 6) == false);
+	CHECK(rohc_comp_set_channel_ber(comp, 31) == false);
+	CHECK(rohc_comp_set_channel_ber(comp, 0) == true);
+	CHECK(rohc_comp_set_channel_ber(comp, 2) == true);
+	CHECK(rohc_comp_set_channel_ber(comp, 6) == true);
+
 	/* rohc_comp_set_rtp_detection_cb() */
 	{
 		rohc_rtp_detection_callback_t fct =
@@ -373,6 +392,9 @@ int main(int argc, char *argv[])
 		CHECK(rohc_comp_get_last_packet_info2(comp, &info) == false);
 		info.version_minor = 0;
 		CHECK(rohc_comp_get_last_packet_info2(comp, &info) == true);
+		info.version_minor = 1;
+		CHECK(rohc_comp_get_last_packet_info2(comp, &info) == true);
+		CHECK(info.context_wlsb_width == 16);
 	}
 
 	/* rohc_comp_get_general_info() */
@@ -405,8 +427,34 @@ int main(int argc, char *argv[])
 	CHECK(rohc_comp_set_features(comp, ROHC_COMP_FEATURE_NO_IP_CHECKSUMS) == true);
 	CHECK(rohc_comp_set_features(comp, ROHC_COMP_FEATURE_DUMP_PACKETS) == true);
 	CHECK(rohc_comp_set_features(comp, ROHC_COMP_FEATURE_TIME_BASED_REFRESHES) == true);
+	CHECK(rohc_comp_set_features(comp, ROHC_COMP_FEATURE_ACK_DRIVEN_WLSB) == true);
+	CHECK(rohc_comp_set_features(comp, ROHC_COMP_FEATURE_TCP_TS_UNCHANGED) == true);
+	CHECK(rohc_comp_set_features(comp, ROHC_COMP_FEATURE_UDP_OVERLAYS) == true);
+	CHECK(rohc_comp_set_features(comp, ROHC_COMP_FEATURE_SRH_UPDATES) == true);
 	CHECK(rohc_comp_set_features(comp, ROHC_COMP_FEATURE_NONE) == true);
 
+	/* rohc_comp_set_ctxt_eviction() */
+	CHECK(rohc_comp_set_ctxt_eviction(NULL, ROHC_COMP_EVICTION_LRU) == false);
+	CHECK(rohc_comp_set_ctxt_eviction(comp, ROHC_COMP_EVICTION_SLRU + 1) == false);
+	CHECK(rohc_comp_set_ctxt_eviction(comp, ROHC_COMP_EVICTION_SLRU) == true);
+	CHECK(rohc_comp_set_ctxt_eviction(comp, ROHC_COMP_EVICTION_LRU) == true);
+
+	/* rohc_comp_set_ctxt_prio() */
+	CHECK(rohc_comp_set_ctxt_prio(NULL, 0, ROHC_COMP_CTXT_PRIO_HIGH) == false);
+	CHECK(rohc_comp_set_ctxt_prio(comp, 0, ROHC_COMP_CTXT_PRIO_PINNED + 1) == false);
+	CHECK(rohc_comp_set_ctxt_prio(comp, ROHC_SMALL_CID_MAX, ROHC_COMP_CTXT_PRIO_HIGH) == false);
+	CHECK(rohc_comp_set_ctxt_prio(comp, ROHC_SMALL_CID_MAX + 1, ROHC_COMP_CTXT_PRIO_HIGH) == false);
+	CHECK(rohc_comp_set_ctxt_prio(comp, 0, ROHC_COMP_CTXT_PRIO_PINNED) == true);
+	CHECK(rohc_comp_set_ctxt_prio(comp, 0, ROHC_COMP_CTXT_PRIO_NORMAL) == true);
+
+	/* rohc_comp_set_ctxt_admission() */
+	CHECK(rohc_comp_set_ctxt_admission(NULL, 3, 100) == false);
+	CHECK(rohc_comp_set_ctxt_admission(comp, 0, 100) == false);
+	CHECK(rohc_comp_set_ctxt_admission(comp, 256, 100) == false);
+	CHECK(rohc_comp_set_ctxt_admission(comp, 3, 0) == false);
+	CHECK(rohc_comp_set_ctxt_admission(comp, 255, 100) == true);
+	CHECK(rohc_comp_set_ctxt_admission(comp, 1, 1) == true);
+
 	/* rohc_comp_deliver_feedback2() */
 	{
 		const struct rohc_ts ts = { .sec = 0, .nsec = 0 };
@@ -422,6 +470,43 @@ int main(int argc, char *argv[])
 		pkt.len = 5; CHECK(rohc_comp_deliver_feedback2(comp, pkt) == true);
 	}
 
+	/* rohc_comp_set_piggybacking() */
+	CHECK(rohc_comp_set_piggybacking(NULL, 100, 10) == false);
+	CHECK(rohc_comp_set_piggybacking(comp, 0, 10) == true);
+	CHECK(rohc_comp_set_piggybacking(comp, 100, 0) == true);
+
+	/* rohc_comp_piggyback_feedback() */
+	{
+		const struct rohc_ts ts = { .sec = 0, .nsec = 0 };
+		uint8_t buf[] = { 0xf4, 0x20, 0x01, 0x11, 0x39 };
+		struct rohc_buf pkt = rohc_buf_init_full(buf, 5, ts);
+
+		CHECK(rohc_comp_piggyback_feedback(NULL, pkt) == false);
+		pkt.len = 0; CHECK(rohc_comp_piggyback_feedback(comp, pkt) == true);
+		pkt.len = 1; CHECK(rohc_comp_piggyback_feedback(comp, pkt) == false);
+		pkt.len = 4; CHECK(rohc_comp_piggyback_feedback(comp, pkt) == false);
+		pkt.len = 5; CHECK(rohc_comp_piggyback_feedback(comp, pkt) == true);
+	}
+
+	/* rohc_comp_flush_feedbacks() */
+	{
+		const struct rohc_ts ts = { .sec = 0, .nsec = 0 };
+		uint8_t buf[5];
+		struct rohc_buf pkt = rohc_buf_init_empty(buf, 5);
+
+		CHECK(rohc_comp_flush_feedbacks(NULL, ts, &pkt) == false);
+		CHECK(rohc_comp_flush_feedbacks(comp, ts, NULL) == false);
+		pkt.max_len = 4;
+		CHECK(rohc_comp_flush_feedbacks(comp, ts, &pkt) == false);
+		pkt.max_len = 5;
+		CHECK(rohc_comp_flush_feedbacks(comp, ts, &pkt) == true);
+		CHECK(pkt.len == 5);
+		CHECK(rohc_comp_flush_feedbacks(comp, ts, &pkt) == false);
+		pkt.len = 0;
+		CHECK(rohc_comp_flush_feedbacks(comp, ts, &pkt) == true);
+		CHECK(pkt.len == 0);
+	}
+
 	/* several functions with some packets already compressed */
 	{
 		rohc_trace_callback2_t fct = (rohc_trace_callback2_t) NULL;
@@ -432,6 +517,7 @@ int main(int argc, char *argv[])
 		CHECK(rohc_comp_set_periodic_refreshes(comp, 10, 5) == false);
 
 		CHECK(rohc_comp_set_list_trans_nr(comp, 5) == false);
+		CHECK(rohc_comp_set_channel_ber(comp, 6) == false);
 	}
 
 	/* rohc_comp_free() */
@@ -261,6 +261,7 @@ int ip_parse_ext3(const struct rohc_decomp_ctxt *const context,
                   const rohc_packet_t packet_type,
                   struct rohc_extr_bits *const bits)
 {
+	struct rohc_decomp_rfc3095_ctxt *const rfc3095_ctxt = context->persist_ctxt;
 	const uint8_t *ip_flags_pos = NULL;
 	const uint8_t *ip2_flags_pos = NULL;
 	uint8_t S;
@@ -360,13 +361,15 @@ int ip_parse_ext3(const struct rohc_decomp_ctxt *const context,
 		{
 			size = parse_inner_header_flags(context, ip2_flags_pos,
 			                                rohc_remain_data, rohc_remain_len,
-			                                &bits->inner_ip);
+			                                &bits->inner_ip,
+			                                &rfc3095_ctxt->list_decomp2);
 		}
 		else
 		{
 			size = parse_inner_header_flags(context, ip_flags_pos,
 			                                rohc_remain_data, rohc_remain_len,
-			                                &bits->outer_ip);
+			                                &bits->outer_ip,
+			                                &rfc3095_ctxt->list_decomp1);
 		}
 		if(size < 0)
 		{
@@ -408,7 +411,8 @@ int ip_parse_ext3(const struct rohc_decomp_ctxt *const context,
 	if(ip2)
 	{
 		size = parse_outer_header_flags(context, ip_flags_pos, rohc_remain_data,
-		                                rohc_remain_len, &bits->outer_ip);
+		                                rohc_remain_len, &bits->outer_ip,
+		                                &rfc3095_ctxt->list_decomp1);
 		if(size == -1)
 		{
 			rohc_decomp_warn(context, "cannot decode the outer IP header flags "
@@ -508,6 +512,7 @@ error:
  * @param length      The length of the ROHC packet part that contains some IP
  *                    header fields
  * @param bits        OUT: The bits extracted from extension 3
+ * @param list_decomp The list decompressor for the IPv6 extension headers
  * @return            The data length read from the ROHC packet,
  *                    -1 in case of error
  */
@@ -515,7 +520,8 @@ int parse_inner_header_flags(const struct rohc_decomp_ctxt *const context,
                              const uint8_t *const flags,
                              const uint8_t *fields,
                              const size_t length,
-                             struct rohc_extr_ip_bits *const bits)
+                             struct rohc_extr_ip_bits *const bits,
+                             struct list_decomp *const list_decomp)
 {
 	uint8_t is_tos;
 	uint8_t is_ttl;
@@ -597,10 +603,27 @@ int parse_inner_header_flags(const struct rohc_decomp_ctxt *const context,
 	/* get the IP extension headers */
 	if(is_ipx)
 	{
-		/* TODO: list compression */
-		rohc_decomp_warn(context, "IP extension headers list compression is "
-		                 "not supported");
-		goto error;
+		int size_ext;
+
+		/* the list of extension headers is compressed only for IPv6 */
+		if(bits->version != IPV6)
+		{
+			rohc_decomp_warn(context, "IPX flag set and IP header is IPv4");
+			goto error;
+		}
+
+		/* decode the compressed list of IPv6 extension headers */
+		size_ext = rohc_list_decode_maybe(list_decomp, fields, length - read);
+		if(size_ext < 0)
+		{
+			rohc_decomp_warn(context, "failed to decode IPv6 extensions list");
+			goto error;
+		}
+		rohc_decomp_debug(context, "IPv6 extensions list = %d bytes", size_ext);
+#ifndef __clang_analyzer__ /* silent warning about dead increment */
+		fields += size_ext;
+#endif
+		read += size_ext;
 	}
 
 	/* get the NBO and RND flags if IPv4 */
@@ -673,6 +696,8 @@ error:
  * @param length              The length of the ROHC packet part that contains
  *                            some IP header fields
  * @param bits                OUT: The bits extracted from extension 3
+ * @param list_decomp         The list decompressor for the IPv6 extension
+ *                            headers
  * @return                    The data length read from the ROHC packet,
  *                            -1 in case of error
  */
@@ -680,7 +705,8 @@ int parse_outer_header_flags(const struct rohc_decomp_ctxt *const context,
                              const uint8_t *const flags,
                              const uint8_t *fields,
                              const size_t length,
-                             struct rohc_extr_ip_bits *const bits)
+                             struct rohc_extr_ip_bits *const bits,
+                             struct list_decomp *const list_decomp)
 {
 	size_t inner_header_flags;
 	uint8_t is_I2;
@@ -688,7 +714,8 @@ int parse_outer_header_flags(const struct rohc_decomp_ctxt *const context,
 
 	/* decode some outer IP header flags and fields that are identical
 	 * to inner IP header flags and fields */
-	read = parse_inner_header_flags(context, flags, fields, length, bits);
+	read = parse_inner_header_flags(context, flags, fields, length, bits,
+	                                list_decomp);
 	if(read == -1)
 	{
 		goto error;
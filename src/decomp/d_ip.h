@@ -58,15 +58,17 @@ int parse_outer_header_flags(const struct rohc_decomp_ctxt *const context,
                              const uint8_t *const flags,
                              const uint8_t *fields,
                              const size_t length,
-                             struct rohc_extr_ip_bits *const bits)
-	__attribute__((warn_unused_result, nonnull(1, 2, 3, 5)));
+                             struct rohc_extr_ip_bits *const bits,
+                             struct list_decomp *const list_decomp)
+	__attribute__((warn_unused_result, nonnull(1, 2, 3, 5, 6)));
 
 int parse_inner_header_flags(const struct rohc_decomp_ctxt *const context,
                              const uint8_t *const flags,
                              const uint8_t *fields,
                              const size_t length,
-                             struct rohc_extr_ip_bits *const bits)
-	__attribute__((warn_unused_result, nonnull(1, 2, 3, 5)));
+                             struct rohc_extr_ip_bits *const bits,
+                             struct list_decomp *const list_decomp)
+	__attribute__((warn_unused_result, nonnull(1, 2, 3, 5, 6)));
 
 #endif
 
@@ -862,7 +862,7 @@ static int rtp_parse_ext3(const struct rohc_decomp_ctxt *const context,
                           const rohc_packet_t packet_type,
                           struct rohc_extr_bits *const bits)
 {
-	const struct rohc_decomp_rfc3095_ctxt *const rfc3095_ctxt = context->persist_ctxt;
+	struct rohc_decomp_rfc3095_ctxt *const rfc3095_ctxt = context->persist_ctxt;
 	uint8_t S;
 	uint8_t rts;
 	uint8_t I;
@@ -876,6 +876,7 @@ static int rtp_parse_ext3(const struct rohc_decomp_ctxt *const context,
 	const uint8_t *inner_ip_flags_pos = NULL;
 	struct rohc_extr_ip_bits *inner_ip;
 	struct rohc_decomp_rfc3095_changes *inner_ip_changes;
+	struct list_decomp *inner_list_decomp;
 
 	const uint8_t *outer_ip_flags_pos = NULL;
 	struct rohc_extr_ip_bits *outer_ip;
@@ -899,6 +900,7 @@ static int rtp_parse_ext3(const struct rohc_decomp_ctxt *const context,
 	{
 		inner_ip = &bits->inner_ip;
 		inner_ip_changes = rfc3095_ctxt->inner_ip_changes;
+		inner_list_decomp = &rfc3095_ctxt->list_decomp2;
 		outer_ip = &bits->outer_ip;
 		outer_ip_changes = rfc3095_ctxt->outer_ip_changes;
 	}
@@ -906,6 +908,7 @@ static int rtp_parse_ext3(const struct rohc_decomp_ctxt *const context,
 	{
 		inner_ip = &bits->outer_ip;
 		inner_ip_changes = rfc3095_ctxt->outer_ip_changes;
+		inner_list_decomp = &rfc3095_ctxt->list_decomp1;
 		outer_ip = NULL;
 		outer_ip_changes = NULL;
 	}
@@ -1014,7 +1017,7 @@ static int rtp_parse_ext3(const struct rohc_decomp_ctxt *const context,
 	{
 		size = parse_inner_header_flags(context, inner_ip_flags_pos,
 		                                rohc_remain_data, rohc_remain_len,
-		                                inner_ip);
+		                                inner_ip, inner_list_decomp);
 		if(size < 0)
 		{
 			rohc_decomp_warn(context, "cannot decode the innermost IP header "
@@ -1087,7 +1090,7 @@ static int rtp_parse_ext3(const struct rohc_decomp_ctxt *const context,
 
 		size = parse_outer_header_flags(context, outer_ip_flags_pos,
 		                                rohc_remain_data, rohc_remain_len,
-		                                outer_ip);
+		                                outer_ip, &rfc3095_ctxt->list_decomp1);
 		if(size == -1)
 		{
 			rohc_decomp_warn(context, "cannot decode the outermost IP header "
@@ -88,14 +88,16 @@ static bool d_tcp_parse_packet(const struct rohc_decomp_ctxt *const context,
                                const size_t large_cid_len,
                                rohc_packet_t *const packet_type,
                                struct rohc_decomp_crc *const extr_crc,
+                               struct rohc_decomp_static_chain *const static_chain,
                                struct rohc_tcp_extr_bits *const extr_bits,
                                size_t *const rohc_hdr_len)
-	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7)));
+	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7, 8)));
 static bool d_tcp_parse_ir(const struct rohc_decomp_ctxt *const context,
                            const uint8_t *const rohc_packet,
                            const size_t rohc_length,
                            const size_t large_cid_len,
                            struct rohc_decomp_crc *const extr_crc,
+                           struct rohc_decomp_static_chain *const static_chain,
                            struct rohc_tcp_extr_bits *const bits,
                            size_t *const rohc_hdr_len)
 	__attribute__((warn_unused_result, nonnull(1, 2, 5, 6, 7)));
@@ -717,6 +719,7 @@ error:
  * @param[in,out] packet_type  IN:  The type of the ROHC packet to parse
  *                             OUT: The type of the parsed ROHC packet
  * @param[out] extr_crc        The CRC bits extracted from the ROHC header
+ * @param[out] static_chain    The static chain found in the ROHC packet
  * @param[out] extr_bits       The bits extracted from the ROHC packet
  * @param[out] rohc_hdr_len    The length of the ROHC header (in bytes)
  * @return                     true if parsing was successful,
@@ -727,6 +730,7 @@ static bool d_tcp_parse_packet(const struct rohc_decomp_ctxt *const context,
                                const size_t large_cid_len,
                                rohc_packet_t *const packet_type,
                                struct rohc_decomp_crc *const extr_crc,
+                               struct rohc_decomp_static_chain *const static_chain,
                                struct rohc_tcp_extr_bits *const extr_bits,
                                size_t *const rohc_hdr_len)
 {
@@ -743,7 +747,7 @@ static bool d_tcp_parse_packet(const struct rohc_decomp_ctxt *const context,
 		/* decode IR packet */
 		parsing_ok = d_tcp_parse_ir(context, rohc_buf_data(rohc_packet),
 		                            rohc_packet.len, large_cid_len,
-		                            extr_crc, extr_bits, rohc_hdr_len);
+		                            extr_crc, static_chain, extr_bits, rohc_hdr_len);
 	}
 	else if((*packet_type) == ROHC_PACKET_IR_CR)
 	{
@@ -779,6 +783,7 @@ static bool d_tcp_parse_packet(const struct rohc_decomp_ctxt *const context,
  * @param rohc_length        The length of the ROHC packet to decode
  * @param large_cid_len      The length of the optional large CID field
  * @param[out] extr_crc      The CRC bits extracted from the ROHC header
+ * @param[out] static_chain  The static chain found in the IR packet
  * @param[out] bits          The bits extracted from the IR packet
  * @param[out] rohc_hdr_len  The length of the ROHC header (in bytes)
  * @return                   true if parsing was successful,
@@ -789,6 +794,7 @@ static bool d_tcp_parse_ir(const struct rohc_decomp_ctxt *const context,
                            const size_t rohc_length,
                            const size_t large_cid_len,
                            struct rohc_decomp_crc *const extr_crc,
+                           struct rohc_decomp_static_chain *const static_chain,
                            struct rohc_tcp_extr_bits *const bits,
                            size_t *const rohc_hdr_len)
 {
@@ -821,12 +827,23 @@ static bool d_tcp_parse_ir(const struct rohc_decomp_ctxt *const context,
 	remain_data++;
 	remain_len--;
 
-	/* parse static chain */
-	if(!tcp_parse_static_chain(context, remain_data, remain_len,
-	                           bits, &static_chain_len))
+	/* parse static chain, unless it is the one already in context: the static
+	 * fields are then taken from context as for IR-DYN packets */
+	if(rohc_decomp_static_chain_unchanged(context, remain_data, remain_len,
+	                                      static_chain))
 	{
-		rohc_decomp_warn(context, "failed to parse the static chain");
-		goto error;
+		static_chain_len = static_chain->len;
+	}
+	else
+	{
+		if(!tcp_parse_static_chain(context, remain_data, remain_len,
+		                           bits, &static_chain_len))
+		{
+			rohc_decomp_warn(context, "failed to parse the static chain");
+			goto error;
+		}
+		static_chain->data = remain_data;
+		static_chain->len = static_chain_len;
 	}
 	remain_data += static_chain_len;
 	remain_len -= static_chain_len;
@@ -3248,6 +3265,7 @@ static bool d_tcp_decode_bits_tcp_hdr(const struct rohc_decomp_ctxt *const conte
 		}
 		decoded->seq_num = decoded->seq_num_scaled * payload_len +
 		                   tcp_context->seq_num_residue;
+		decoded->seq_num_residue = tcp_context->seq_num_residue;
 		rohc_decomp_debug(context, "  seq_number_scaled = 0x%x, payload size = %zu, "
 		                  "seq_number_residue = 0x%x -> seq_number = 0x%x",
 		                  decoded->seq_num_scaled, payload_len,
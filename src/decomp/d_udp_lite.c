@@ -89,9 +89,10 @@ static bool d_udp_lite_parse(const struct rohc_decomp_ctxt *const context,
                              const size_t large_cid_len,
                              rohc_packet_t *const packet_type,
                              struct rohc_decomp_crc *const extr_crc,
+                             struct rohc_decomp_static_chain *const static_chain,
                              struct rohc_extr_bits *const bits,
                              size_t *const rohc_hdr_len)
-	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7)));
+	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7, 8)));
 
 static int udp_lite_parse_dynamic_udp(const struct rohc_decomp_ctxt *const context,
                                       const uint8_t *packet,
@@ -331,6 +332,7 @@ error:
  * @param[in,out] packet_type  IN:  The type of the ROHC packet to parse
  *                             OUT: The type of the parsed ROHC packet
  * @param[out] extr_crc        The CRC bits extracted from the ROHC header
+ * @param[out] static_chain    The static chain transmitted in IR packets
  * @param[out] bits            The bits extracted from the ROHC header
  * @param[out] rohc_hdr_len    The length of the ROHC header (in bytes)
  * @return                     true if packet is successfully parsed,
@@ -341,6 +343,7 @@ static bool d_udp_lite_parse(const struct rohc_decomp_ctxt *const context,
                              const size_t large_cid_len,
                              rohc_packet_t *const packet_type,
                              struct rohc_decomp_crc *const extr_crc,
+                             struct rohc_decomp_static_chain *const static_chain,
                              struct rohc_extr_bits *const bits,
                              size_t *const rohc_hdr_len)
 {
@@ -399,7 +402,8 @@ static bool d_udp_lite_parse(const struct rohc_decomp_ctxt *const context,
 	/* decode the remaining part of the part as a normal IP-based packet
 	 * (with a fake length for the large CID field eventually) */
 	return rfc3095_decomp_parse_pkt(context, rohc_remain_data, new_large_cid_len,
-	                                packet_type, extr_crc, bits, rohc_hdr_len);
+	                                packet_type, extr_crc, static_chain, bits,
+	                                rohc_hdr_len);
 
 error_malformed:
 	return ROHC_STATUS_MALFORMED;
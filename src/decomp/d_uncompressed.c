@@ -78,9 +78,10 @@ static bool uncomp_parse_pkt(const struct rohc_decomp_ctxt *const context,
                              const size_t large_cid_len,
                              rohc_packet_t *const packet_type,
                              struct rohc_decomp_crc *const extr_crc,
+                             struct rohc_decomp_static_chain *const static_chain,
                              struct rohc_uncomp_extr_bits *const extr_bits,
                              size_t *const rohc_hdr_len)
-	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7)));
+	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7, 8)));
 
 static bool uncomp_parse_ir(const struct rohc_decomp_ctxt *const context,
                             const struct rohc_buf rohc_packet,
@@ -246,6 +247,8 @@ static rohc_packet_t uncomp_detect_pkt_type(const struct rohc_decomp_ctxt *const
  * @param[in,out] packet_type  IN:  The type of the ROHC packet to parse
  *                             OUT: The type of the parsed ROHC packet
  * @param[out] extr_crc        The CRC bits extracted from the ROHC packet
+ * @param static_chain         Unused: the IR packets of the Uncompressed
+ *                             profile carry no static chain
  * @param[out] extr_bits       The bits extracted from the ROHC packet
  * @param[out] rohc_hdr_len    The length of the ROHC header (in bytes)
  * @return                     true if parsing was successful,
@@ -256,6 +259,7 @@ static bool uncomp_parse_pkt(const struct rohc_decomp_ctxt *const context,
                              const size_t large_cid_len,
                              rohc_packet_t *const packet_type,
                              struct rohc_decomp_crc *const extr_crc,
+                             struct rohc_decomp_static_chain *const static_chain __attribute__((unused)),
                              struct rohc_uncomp_extr_bits *const extr_bits,
                              size_t *const rohc_hdr_len)
 {
@@ -180,9 +180,10 @@ static bool decomp_rfc5225_ip_esp_parse_pkt(const struct rohc_decomp_ctxt *const
                                             const size_t large_cid_len,
                                             rohc_packet_t *const packet_type,
                                             struct rohc_decomp_crc *const extr_crc,
+                                            struct rohc_decomp_static_chain *const static_chain,
                                             struct rohc_rfc5225_bits *const bits,
                                             size_t *const rohc_hdr_len)
-	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7)));
+	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7, 8)));
 
 static void decomp_rfc5225_ip_esp_reset_extr_bits(const struct rohc_decomp_ctxt *const ctxt,
                                                   struct rohc_rfc5225_bits *const bits)
@@ -192,9 +193,10 @@ static bool decomp_rfc5225_ip_esp_parse_ir(const struct rohc_decomp_ctxt *const
                                            const struct rohc_buf rohc_pkt,
                                            const size_t large_cid_len,
                                            struct rohc_decomp_crc *const extr_crc,
+                                           struct rohc_decomp_static_chain *const static_chain,
                                            struct rohc_rfc5225_bits *const bits,
                                            size_t *const rohc_hdr_len)
-	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6)));
+	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7)));
 
 static bool decomp_rfc5225_ip_esp_parse_co_repair(const struct rohc_decomp_ctxt *const ctxt,
                                                   const struct rohc_buf rohc_pkt,
@@ -550,6 +552,7 @@ static rohc_packet_t decomp_rfc5225_ip_esp_detect_pkt_type(const struct rohc_dec
  * @param[in,out] packet_type  IN:  The type of the ROHC packet to parse
  *                             OUT: The type of the parsed ROHC packet
  * @param[out] extr_crc        The CRC bits extracted from the ROHC packet
+ * @param[out] static_chain    The static chain found in the ROHC packet
  * @param[out] bits            The bits extracted from the ROHC packet
  * @param[out] rohc_hdr_len    The length of the ROHC header (in bytes)
  * @return                     true if parsing was successful,
@@ -560,6 +563,7 @@ static bool decomp_rfc5225_ip_esp_parse_pkt(const struct rohc_decomp_ctxt *const
                                             const size_t large_cid_len,
                                             rohc_packet_t *const packet_type,
                                             struct rohc_decomp_crc *const extr_crc,
+                                            struct rohc_decomp_static_chain *const static_chain,
                                             struct rohc_rfc5225_bits *const bits,
                                             size_t *const rohc_hdr_len)
 {
@@ -571,7 +575,8 @@ static bool decomp_rfc5225_ip_esp_parse_pkt(const struct rohc_decomp_ctxt *const
 	if((*packet_type) == ROHC_PACKET_IR)
 	{
 		status = decomp_rfc5225_ip_esp_parse_ir(context, rohc_packet, large_cid_len,
-		                                        extr_crc, bits, rohc_hdr_len);
+		                                        extr_crc, static_chain, bits,
+		                                        rohc_hdr_len);
 	}
 	else if((*packet_type) == ROHC_PACKET_CO_REPAIR)
 	{
@@ -658,6 +663,7 @@ static void decomp_rfc5225_ip_esp_reset_extr_bits(const struct rohc_decomp_ctxt
  * @param rohc_pkt           The ROHC packet to decode
  * @param large_cid_len      The length of the optional large CID field
  * @param[out] extr_crc      The CRC extracted from the ROHC packet
+ * @param[out] static_chain  The static chain found in the IR packet
  * @param[out] bits          The bits extracted from the ROHC packet
  * @param[out] rohc_hdr_len  The length of the ROHC header (in bytes)
  * @return                   true if parsing was successful,
@@ -667,6 +673,7 @@ static bool decomp_rfc5225_ip_esp_parse_ir(const struct rohc_decomp_ctxt *const
                                            const struct rohc_buf rohc_pkt,
                                            const size_t large_cid_len,
                                            struct rohc_decomp_crc *const extr_crc,
+                                           struct rohc_decomp_static_chain *const static_chain,
                                            struct rohc_rfc5225_bits *const bits,
                                            size_t *const rohc_hdr_len)
 {
@@ -696,12 +703,23 @@ static bool decomp_rfc5225_ip_esp_parse_ir(const struct rohc_decomp_ctxt *const
 	remain_data++;
 	remain_len--;
 
-	/* parse static chain */
-	if(!decomp_rfc5225_ip_esp_parse_static_chain(ctxt, remain_data, remain_len,
-	                                             bits, &static_chain_len))
+	/* parse static chain, unless it is the one already in context: the static
+	 * fields are then taken from context as for CO packets */
+	if(rohc_decomp_static_chain_unchanged(ctxt, remain_data, remain_len,
+	                                      static_chain))
 	{
-		rohc_decomp_warn(ctxt, "failed to parse the static chain");
-		goto error;
+		static_chain_len = static_chain->len;
+	}
+	else
+	{
+		if(!decomp_rfc5225_ip_esp_parse_static_chain(ctxt, remain_data, remain_len,
+		                                             bits, &static_chain_len))
+		{
+			rohc_decomp_warn(ctxt, "failed to parse the static chain");
+			goto error;
+		}
+		static_chain->data = remain_data;
+		static_chain->len = static_chain_len;
 	}
 	remain_data += static_chain_len;
 	remain_len -= static_chain_len;
@@ -2114,8 +2132,13 @@ static rohc_status_t decomp_rfc5225_ip_esp_decode_bits(const struct rohc_decomp_
 	}
 	else
 	{
+		/* the reorder ratio transmitted in the packet (if any) applies to the
+		 * MSN of the same packet */
+		const rohc_reordering_offset_t reorder_ratio =
+			(bits->reorder_ratio_nr > 0 ? bits->reorder_ratio :
+			 rfc5225_ctxt->reorder_ratio);
 		const rohc_lsb_shift_t p_computed =
-			rohc_interval_get_rfc5225_msn_p(bits->msn.bits_nr, bits->reorder_ratio);
+			rohc_interval_get_rfc5225_msn_p(bits->msn.bits_nr, reorder_ratio);
 		uint32_t msn_decoded32;
 
 		assert(bits->msn.bits_nr > 0); /* all packets contain some MSN bits */
@@ -2961,6 +2984,9 @@ static void decomp_rfc5225_ip_esp_update_ctxt(struct rohc_decomp_ctxt *const con
 	rohc_lsb_set_ref(&rfc5225_ctxt->msn_lsb_ctxt, msn, false);
 	rohc_decomp_debug(context, "MSN 0x%08x / %u is the new reference", msn, msn);
 
+	/* reorder ratio */
+	rfc5225_ctxt->reorder_ratio = decoded->reorder_ratio;
+
 	/* update context for IP headers */
 	assert(decoded->ip_nr > 0);
 	for(ip_hdr_nr = 0; ip_hdr_nr < decoded->ip_nr; ip_hdr_nr++)
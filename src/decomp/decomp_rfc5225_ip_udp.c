@@ -30,6 +30,7 @@
 #include "protocols/ip_numbers.h"
 #include "protocols/ip.h"
 #include "protocols/rfc5225.h"
+#include "protocols/overlay.h"
 #include "schemes/ip_ctxt.h"
 #include "schemes/decomp_wlsb.h"
 #include "schemes/decomp_crc.h"
@@ -63,6 +64,11 @@ struct rohc_decomp_rfc5225_ip_udp_ctxt
 	uint16_t udp_dport;
 	/** Whether the UDP checksum is used or not */
 	bool udp_checksum_used;
+
+	/** The type of the overlay headers that follow the UDP header */
+	rohc_overlay_t overlay_type;
+	/** The overlay headers that follow the UDP header, if any */
+	uint8_t overlay_hdrs[OVERLAY_HDRS_LEN];
 };
 
 
@@ -126,6 +132,10 @@ struct rohc_rfc5225_bits
 	size_t udp_dport_nr; /**< The number of UDP destination port bits */
 	uint16_t udp_checksum;  /**< The UDP checksum bits */
 	size_t udp_checksum_nr; /**< The number of UDP checksum bits */
+
+	rohc_overlay_t overlay_type;  /**< The type of the overlay headers */
+	size_t overlay_type_nr;       /**< The number of overlay type bits */
+	uint8_t overlay_hdrs[OVERLAY_HDRS_LEN]; /**< The overlay headers */
 };
 
 
@@ -163,6 +173,9 @@ struct rohc_rfc5225_decoded
 	uint16_t udp_dport; /**< The UDP destination port decoded */
 	uint16_t udp_checksum; /**< The UDP checksum decoded */
 	bool udp_checksum_used; /**< Whether the UDP checksum is used or not */
+
+	rohc_overlay_t overlay_type; /**< The type of the overlay headers decoded */
+	uint8_t overlay_hdrs[OVERLAY_HDRS_LEN]; /**< The overlay headers decoded */
 };
 
 
@@ -190,9 +203,10 @@ static bool decomp_rfc5225_ip_udp_parse_pkt(const struct rohc_decomp_ctxt *const
                                             const size_t large_cid_len,
                                             rohc_packet_t *const packet_type,
                                             struct rohc_decomp_crc *const extr_crc,
+                                            struct rohc_decomp_static_chain *const static_chain,
                                             struct rohc_rfc5225_bits *const bits,
                                             size_t *const rohc_hdr_len)
-	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7)));
+	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7, 8)));
 
 static void decomp_rfc5225_ip_udp_reset_extr_bits(const struct rohc_decomp_ctxt *const ctxt,
                                                   struct rohc_rfc5225_bits *const bits)
@@ -202,9 +216,10 @@ static bool decomp_rfc5225_ip_udp_parse_ir(const struct rohc_decomp_ctxt *const
                                            const struct rohc_buf rohc_pkt,
                                            const size_t large_cid_len,
                                            struct rohc_decomp_crc *const extr_crc,
+                                           struct rohc_decomp_static_chain *const static_chain,
                                            struct rohc_rfc5225_bits *const bits,
                                            size_t *const rohc_hdr_len)
-	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6)));
+	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7)));
 
 static bool decomp_rfc5225_ip_udp_parse_co_repair(const struct rohc_decomp_ctxt *const ctxt,
                                                   const struct rohc_buf rohc_pkt,
@@ -281,6 +296,11 @@ static int decomp_rfc5225_ip_udp_parse_static_udp(const struct rohc_decomp_ctxt
                                                   const size_t rohc_len,
                                                   struct rohc_rfc5225_bits *const bits)
 	__attribute__((warn_unused_result, nonnull(1, 2, 4)));
+static int decomp_rfc5225_ip_udp_parse_static_overlay(const struct rohc_decomp_ctxt *const ctxt,
+                                                      const uint8_t *rohc_pkt,
+                                                      const size_t rohc_len,
+                                                      struct rohc_rfc5225_bits *const bits)
+	__attribute__((warn_unused_result, nonnull(1, 2, 4)));
 
 /* dynamic chain */
 static bool decomp_rfc5225_ip_udp_parse_dyn_chain(const struct rohc_decomp_ctxt *const ctxt,
@@ -375,6 +395,11 @@ static bool decomp_rfc5225_ip_udp_build_udp_hdr(const struct rohc_decomp_ctxt *c
                                                 struct rohc_buf *const uncomp_packet,
                                                 size_t *const udp_hdr_len)
 	__attribute__((warn_unused_result, nonnull(1, 2, 4, 5)));
+static bool decomp_rfc5225_ip_udp_build_overlay_hdrs(const struct rohc_decomp_ctxt *const ctxt,
+                                                     const struct rohc_rfc5225_decoded *const decoded,
+                                                     struct rohc_buf *const uncomp_pkt,
+                                                     size_t *const overlay_hdrs_len)
+	__attribute__((warn_unused_result, nonnull(1, 2, 3, 4)));
 
 /* updating context */
 static void decomp_rfc5225_ip_udp_update_ctxt(struct rohc_decomp_ctxt *const context,
@@ -560,6 +585,7 @@ static rohc_packet_t decomp_rfc5225_ip_udp_detect_pkt_type(const struct rohc_dec
  * @param[in,out] packet_type  IN:  The type of the ROHC packet to parse
  *                             OUT: The type of the parsed ROHC packet
  * @param[out] extr_crc        The CRC bits extracted from the ROHC packet
+ * @param[out] static_chain    The static chain found in the ROHC packet
  * @param[out] bits            The bits extracted from the ROHC packet
  * @param[out] rohc_hdr_len    The length of the ROHC header (in bytes)
  * @return                     true if parsing was successful,
@@ -570,6 +596,7 @@ static bool decomp_rfc5225_ip_udp_parse_pkt(const struct rohc_decomp_ctxt *const
                                             const size_t large_cid_len,
                                             rohc_packet_t *const packet_type,
                                             struct rohc_decomp_crc *const extr_crc,
+                                            struct rohc_decomp_static_chain *const static_chain,
                                             struct rohc_rfc5225_bits *const bits,
                                             size_t *const rohc_hdr_len)
 {
@@ -581,7 +608,8 @@ static bool decomp_rfc5225_ip_udp_parse_pkt(const struct rohc_decomp_ctxt *const
 	if((*packet_type) == ROHC_PACKET_IR)
 	{
 		status = decomp_rfc5225_ip_udp_parse_ir(context, rohc_packet, large_cid_len,
-		                                        extr_crc, bits, rohc_hdr_len);
+		                                        extr_crc, static_chain, bits,
+		                                        rohc_hdr_len);
 	}
 	else if((*packet_type) == ROHC_PACKET_CO_REPAIR)
 	{
@@ -642,6 +670,7 @@ static void decomp_rfc5225_ip_udp_reset_extr_bits(const struct rohc_decomp_ctxt
 	bits->outer_ip_flag_nr = 0;
 	bits->ctrl_crc.type = ROHC_CRC_TYPE_NONE;
 	bits->ctrl_crc.bits_nr = 0;
+	bits->overlay_type_nr = 0;
 
 	/* if context handled at least one packet, init the list of IP headers */
 	if(ctxt->num_recv_packets >= 1)
@@ -668,6 +697,7 @@ static void decomp_rfc5225_ip_udp_reset_extr_bits(const struct rohc_decomp_ctxt
  * @param rohc_pkt           The ROHC packet to decode
  * @param large_cid_len      The length of the optional large CID field
  * @param[out] extr_crc      The CRC extracted from the ROHC packet
+ * @param[out] static_chain  The static chain found in the IR packet
  * @param[out] bits          The bits extracted from the ROHC packet
  * @param[out] rohc_hdr_len  The length of the ROHC header (in bytes)
  * @return                   true if parsing was successful,
@@ -677,6 +707,7 @@ static bool decomp_rfc5225_ip_udp_parse_ir(const struct rohc_decomp_ctxt *const
                                            const struct rohc_buf rohc_pkt,
                                            const size_t large_cid_len,
                                            struct rohc_decomp_crc *const extr_crc,
+                                           struct rohc_decomp_static_chain *const static_chain,
                                            struct rohc_rfc5225_bits *const bits,
                                            size_t *const rohc_hdr_len)
 {
@@ -706,12 +737,23 @@ static bool decomp_rfc5225_ip_udp_parse_ir(const struct rohc_decomp_ctxt *const
 	remain_data++;
 	remain_len--;
 
-	/* parse static chain */
-	if(!decomp_rfc5225_ip_udp_parse_static_chain(ctxt, remain_data, remain_len,
-	                                             bits, &static_chain_len))
+	/* parse static chain, unless it is the one already in context: the static
+	 * fields are then taken from context as for CO packets */
+	if(rohc_decomp_static_chain_unchanged(ctxt, remain_data, remain_len,
+	                                      static_chain))
 	{
-		rohc_decomp_warn(ctxt, "failed to parse the static chain");
-		goto error;
+		static_chain_len = static_chain->len;
+	}
+	else
+	{
+		if(!decomp_rfc5225_ip_udp_parse_static_chain(ctxt, remain_data, remain_len,
+		                                             bits, &static_chain_len))
+		{
+			rohc_decomp_warn(ctxt, "failed to parse the static chain");
+			goto error;
+		}
+		static_chain->data = remain_data;
+		static_chain->len = static_chain_len;
 	}
 	remain_data += static_chain_len;
 	remain_len -= static_chain_len;
@@ -1457,12 +1499,30 @@ static bool decomp_rfc5225_ip_udp_parse_static_chain(const struct rohc_decomp_ct
 	}
 	rohc_decomp_debug(ctxt, "UDP static part is %d-byte length",ret);
 	assert(remain_len >= ((size_t) ret));
-#ifndef __clang_analyzer__ /* silent warning about dead in/decrement */
 	remain_data += ret;
 	remain_len -= ret;
-#endif
 	(*parsed_len) += ret;
 
+	/* parse static overlay part (non-standard) */
+	if((ctxt->decompressor->features & ROHC_DECOMP_FEATURE_UDP_OVERLAYS) != 0)
+	{
+		ret = decomp_rfc5225_ip_udp_parse_static_overlay(ctxt, remain_data,
+		                                                 remain_len, bits);
+		if(ret < 0)
+		{
+			rohc_decomp_warn(ctxt, "malformed ROHC packet: malformed overlay "
+			                 "static part");
+			goto error;
+		}
+		rohc_decomp_debug(ctxt, "overlay static part is %d-byte length", ret);
+		assert(remain_len >= ((size_t) ret));
+#ifndef __clang_analyzer__ /* silent warning about dead in/decrement */
+		remain_data += ret;
+		remain_len -= ret;
+#endif
+		(*parsed_len) += ret;
+	}
+
 	return true;
 
 error:
@@ -1683,6 +1743,71 @@ error:
 }
 
 
+/**
+ * @brief Decode the static overlay part of the ROHC packet
+ *
+ * The overlay static part is not defined by RFC5225: the VXLAN or Geneve
+ * header and the inner Ethernet header are transmitted as is after the type
+ * of the overlay headers.
+ *
+ * @param ctxt      The decompression context
+ * @param rohc_pkt  The ROHC packet to decode
+ * @param rohc_len  The length of the ROHC packet
+ * @param bits      OUT: The bits extracted from the ROHC header
+ * @return          The number of bytes read in the ROHC packet,
+ *                  -1 in case of failure
+ */
+static int decomp_rfc5225_ip_udp_parse_static_overlay(const struct rohc_decomp_ctxt *const ctxt,
+                                                      const uint8_t *rohc_pkt,
+                                                      const size_t rohc_len,
+                                                      struct rohc_rfc5225_bits *const bits)
+{
+	const overlay_static_t *const overlay_static = (overlay_static_t *) rohc_pkt;
+	size_t size = sizeof(overlay_static_t);
+
+	/* check the minimal length to parse the overlay static part */
+	if(rohc_len < size)
+	{
+		rohc_decomp_warn(ctxt, "ROHC packet too small (len = %zu)", rohc_len);
+		goto error;
+	}
+
+	switch(overlay_static->type)
+	{
+		case ROHC_OVERLAY_NONE:
+			rohc_decomp_debug(ctxt, "no overlay header");
+			break;
+		case ROHC_OVERLAY_VXLAN:
+		case ROHC_OVERLAY_GENEVE:
+			rohc_decomp_debug(ctxt, "%s overlay headers",
+			                  overlay_static->type == ROHC_OVERLAY_VXLAN ?
+			                  "VXLAN" : "Geneve");
+			if(rohc_len < (size + OVERLAY_HDRS_LEN))
+			{
+				rohc_decomp_warn(ctxt, "ROHC packet too small for the %u-byte "
+				                 "overlay headers (len = %zu)",
+				                 (unsigned int) OVERLAY_HDRS_LEN, rohc_len);
+				goto error;
+			}
+			memcpy(bits->overlay_hdrs, rohc_pkt + size, OVERLAY_HDRS_LEN);
+			size += OVERLAY_HDRS_LEN;
+			break;
+		default:
+			rohc_decomp_warn(ctxt, "unknown type %u of overlay headers",
+			                 overlay_static->type);
+			goto error;
+	}
+	bits->overlay_type = overlay_static->type;
+	bits->overlay_type_nr = 8;
+
+	rohc_decomp_dump_buf(ctxt, "overlay static part", rohc_pkt, size);
+	return size;
+
+error:
+	return -1;
+}
+
+
 /**
  * @brief Parse the dynamic chain of the IR packet
  *
@@ -2197,8 +2322,13 @@ static rohc_status_t decomp_rfc5225_ip_udp_decode_bits(const struct rohc_decomp_
 	}
 	else
 	{
+		/* the reorder ratio transmitted in the packet (if any) applies to the
+		 * MSN of the same packet */
+		const rohc_reordering_offset_t reorder_ratio =
+			(bits->reorder_ratio_nr > 0 ? bits->reorder_ratio :
+			 rfc5225_ctxt->reorder_ratio);
 		const rohc_lsb_shift_t p_computed =
-			rohc_interval_get_rfc5225_msn_p(bits->msn.bits_nr, bits->reorder_ratio);
+			rohc_interval_get_rfc5225_msn_p(bits->msn.bits_nr, reorder_ratio);
 		uint32_t msn_decoded32;
 
 		assert(bits->msn.bits_nr > 0); /* all packets contain some MSN bits */
@@ -2268,6 +2398,21 @@ static rohc_status_t decomp_rfc5225_ip_udp_decode_bits(const struct rohc_decomp_
 		                  decoded->udp_checksum_used);
 	}
 
+	/* decode overlay headers */
+	if(bits->overlay_type_nr == 8)
+	{
+		decoded->overlay_type = bits->overlay_type;
+		memcpy(decoded->overlay_hdrs, bits->overlay_hdrs, OVERLAY_HDRS_LEN);
+		rohc_decomp_debug(ctxt, "decoded overlay type = %u", decoded->overlay_type);
+	}
+	else
+	{
+		decoded->overlay_type = rfc5225_ctxt->overlay_type;
+		memcpy(decoded->overlay_hdrs, rfc5225_ctxt->overlay_hdrs, OVERLAY_HDRS_LEN);
+		rohc_decomp_debug(ctxt, "overlay type = %u taken from context",
+		                  decoded->overlay_type);
+	}
+
 	/* decode reorder ratio */
 	if(bits->reorder_ratio_nr > 0)
 	{
@@ -2679,6 +2824,7 @@ static rohc_status_t decomp_rfc5225_ip_udp_build_hdrs(const struct rohc_decomp *
 	size_t ip_hdrs_len = 0;
 	size_t ip_hdr_nr;
 	size_t udp_hdr_len;
+	size_t overlay_hdrs_len;
 
 	rohc_decomp_debug(context, "build IP/UDP headers");
 
@@ -2702,6 +2848,15 @@ static rohc_status_t decomp_rfc5225_ip_udp_build_hdrs(const struct rohc_decomp *
 	}
 	*uncomp_hdrs_len += udp_hdr_len;
 
+	/* build overlay headers */
+	if(!decomp_rfc5225_ip_udp_build_overlay_hdrs(context, decoded, uncomp_hdrs,
+	                                             &overlay_hdrs_len))
+	{
+		rohc_decomp_warn(context, "failed to build uncompressed overlay headers");
+		goto error_output_too_small;
+	}
+	*uncomp_hdrs_len += overlay_hdrs_len;
+
 	/* unhide the IP headers */
 	rohc_buf_push(uncomp_hdrs, *uncomp_hdrs_len);
 
@@ -3031,6 +3186,8 @@ static bool decomp_rfc5225_ip_udp_build_udp_hdr(const struct rohc_decomp_ctxt *c
 {
 	struct udphdr *const udp = (struct udphdr *) rohc_buf_data(*uncomp_pkt);
 	const size_t hdr_len = sizeof(struct udphdr);
+	const size_t overlay_hdrs_len =
+		(decoded->overlay_type != ROHC_OVERLAY_NONE ? OVERLAY_HDRS_LEN : 0);
 
 	rohc_decomp_debug(ctxt, "  build %zu-byte UDP header", hdr_len);
 
@@ -3052,7 +3209,7 @@ static bool decomp_rfc5225_ip_udp_build_udp_hdr(const struct rohc_decomp_ctxt *c
 	rohc_decomp_debug(ctxt, "    checksum = 0x%04x", rohc_ntoh16(udp->check));
 
 	/* inferred fields */
-	udp->len = rohc_hton16(hdr_len + payload_len);
+	udp->len = rohc_hton16(hdr_len + overlay_hdrs_len + payload_len);
 	rohc_decomp_debug(ctxt, "    length = 0x%04x", rohc_ntoh16(udp->len));
 
 	/* skip UDP header */
@@ -3067,6 +3224,47 @@ error:
 }
 
 
+/**
+ * @brief Build the uncompressed overlay headers, if any
+ *
+ * @param ctxt                   The decompression context
+ * @param decoded                The values decoded from the ROHC header
+ * @param[out] uncomp_pkt        The uncompressed packet being built
+ * @param[out] overlay_hdrs_len  The length of the overlay headers
+ * @return                       true if overlay headers were successfully
+ *                               built, false if the output \e uncomp_pkt
+ *                               was not large enough
+ */
+static bool decomp_rfc5225_ip_udp_build_overlay_hdrs(const struct rohc_decomp_ctxt *const ctxt,
+                                                     const struct rohc_rfc5225_decoded *const decoded,
+                                                     struct rohc_buf *const uncomp_pkt,
+                                                     size_t *const overlay_hdrs_len)
+{
+	*overlay_hdrs_len = 0;
+
+	if(decoded->overlay_type != ROHC_OVERLAY_NONE)
+	{
+		rohc_decomp_debug(ctxt, "  build %u-byte overlay headers",
+		                  (unsigned int) OVERLAY_HDRS_LEN);
+
+		if(rohc_buf_avail_len(*uncomp_pkt) < OVERLAY_HDRS_LEN)
+		{
+			rohc_decomp_warn(ctxt, "output buffer too small for the %u-byte "
+			                 "overlay headers", (unsigned int) OVERLAY_HDRS_LEN);
+			goto error;
+		}
+		rohc_buf_append(uncomp_pkt, decoded->overlay_hdrs, OVERLAY_HDRS_LEN);
+		rohc_buf_pull(uncomp_pkt, OVERLAY_HDRS_LEN);
+		*overlay_hdrs_len = OVERLAY_HDRS_LEN;
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
 /**
  * @brief Update the decompression context with the infos of current packet
  *
@@ -3092,6 +3290,9 @@ static void decomp_rfc5225_ip_udp_update_ctxt(struct rohc_decomp_ctxt *const con
 	rohc_lsb_set_ref(&rfc5225_ctxt->msn_lsb_ctxt, msn, false);
 	rohc_decomp_debug(context, "MSN 0x%04x / %u is the new reference", msn, msn);
 
+	/* reorder ratio */
+	rfc5225_ctxt->reorder_ratio = decoded->reorder_ratio;
+
 	/* update context for IP headers */
 	assert(decoded->ip_nr > 0);
 	for(ip_hdr_nr = 0; ip_hdr_nr < decoded->ip_nr; ip_hdr_nr++)
@@ -3151,6 +3352,10 @@ static void decomp_rfc5225_ip_udp_update_ctxt(struct rohc_decomp_ctxt *const con
 
 	/* update context for the UDP header */
 	rfc5225_ctxt->udp_checksum_used = decoded->udp_checksum_used;
+
+	/* update context for the overlay headers */
+	rfc5225_ctxt->overlay_type = decoded->overlay_type;
+	memcpy(rfc5225_ctxt->overlay_hdrs, decoded->overlay_hdrs, OVERLAY_HDRS_LEN);
 }
 
 
@@ -168,7 +168,7 @@ static rohc_status_t d_decode_header(struct rohc_decomp *decomp,
                                      struct rohc_decomp_stream *const stream)
 	__attribute__((nonnull(1, 3, 5), warn_unused_result));
 
-static bool rohc_decomp_decode_cid(struct rohc_decomp *decomp,
+static bool rohc_decomp_decode_cid(const struct rohc_decomp *const decomp,
                                    const uint8_t *packet,
                                    unsigned int len,
                                    rohc_cid_t *const cid,
@@ -233,11 +233,11 @@ static void rohc_decomp_update_context(struct rohc_decomp_ctxt *const context,
 	__attribute__((nonnull(1, 2, 5)));
 
 /* functions to receive feedbacks for the same-site ROHC compressor */
-static bool rohc_decomp_parse_feedbacks(struct rohc_decomp *const decomp,
+static bool rohc_decomp_parse_feedbacks(const struct rohc_decomp *const decomp,
                                         struct rohc_buf *const rohc_data,
                                         struct rohc_buf *const feedbacks)
 	__attribute__((warn_unused_result, nonnull(1, 2)));
-static bool rohc_decomp_parse_feedback(struct rohc_decomp *const decomp,
+static bool rohc_decomp_parse_feedback(const struct rohc_decomp *const decomp,
                                        struct rohc_buf *const rohc_data,
                                        struct rohc_buf *const feedback,
                                        size_t *const feedback_len)
@@ -360,6 +360,9 @@ static struct rohc_decomp_ctxt * context_create(struct rohc_decomp *decomp,
 	context->first_used = arrival_time.sec;
 	context->latest_used = arrival_time.sec;
 
+	/* no static chain received yet */
+	context->static_chain_len = 0;
+
 	/* create the profile-specific parts of the decompression context (performed
 	 * at the every end so that everything is initialized in context first) */
 	if(!profile->new_context(context, &context->persist_ctxt, &context->volat_ctxt))
@@ -943,6 +946,125 @@ error:
 }
 
 
+/**
+ * @brief Get the Context ID (CID) of the given ROHC packet
+ *
+ * Parse the beginning of the given ROHC packet in order to find the CID of
+ * the context it belongs to. The packet is not decompressed and the
+ * decompressor is not modified: padding and feedback items are skipped, then
+ * the Add-CID octet or the SDVL-encoded large CID is decoded according to the
+ * CID type of the decompressor.
+ *
+ * The function is designed to spread the packets of one single ROHC channel
+ * among several decompressors, for example one decompressor per thread:
+ *  \li every decompressor is created with the same CID type and MAX_CID as
+ *      the ROHC channel,
+ *  \li the dispatcher calls this function with any of the decompressors,
+ *  \li the dispatcher always gives the packets of one given CID to the same
+ *      decompressor, so that every decompressor handles a disjoint set of
+ *      CIDs and that the order of the packets of every context is kept,
+ *  \li the feedback items that the decompressors return through their
+ *      \e feedback_send parameter shall be sent to the remote compressor
+ *      by the application on the shared feedback channel.
+ *
+ * The CID of a ROHC segment is only known once the whole Reconstructed
+ * Reception Unit (RRU) is received. All the segments of the channel shall
+ * thus be given to the same decompressor.
+ *
+ * The function only reads the decompressor configuration, so it may be
+ * called from the dispatcher while the decompressors are working.
+ *
+ * @param decomp     The ROHC decompressor
+ * @param packet     The ROHC packet to parse
+ * @param[out] cid   The CID of the context the ROHC packet belongs to
+ * @return           Possible return values:
+ *                   \li \ref ROHC_STATUS_OK if the CID was found
+ *                   \li \ref ROHC_STATUS_SEGMENT if the ROHC packet is a
+ *                       segment, so its CID is unknown
+ *                   \li \ref ROHC_STATUS_NO_CONTEXT if the ROHC packet
+ *                       contains only feedback data, or if its CID is
+ *                       greater than MAX_CID
+ *                   \li \ref ROHC_STATUS_MALFORMED if the ROHC packet is
+ *                       malformed
+ *                   \li \ref ROHC_STATUS_ERROR if another problem occurred
+ *
+ * @ingroup rohc_decomp
+ *
+ * @see rohc_decompress3
+ */
+rohc_status_t rohc_decomp_get_cid(const struct rohc_decomp *const decomp,
+                                  const struct rohc_buf packet,
+                                  rohc_cid_t *const cid)
+{
+	struct rohc_buf remain_data = packet;
+	size_t add_cid_len;
+	size_t large_cid_len;
+
+	if(decomp == NULL || cid == NULL || rohc_buf_is_malformed(packet))
+	{
+		goto error;
+	}
+
+	/* skip padding and feedback items as rohc_decompress3() does */
+	rohc_decomp_parse_padding(decomp, &remain_data);
+	if(remain_data.len == 0)
+	{
+		rohc_debug(decomp, ROHC_TRACE_DECOMP, ROHC_PROFILE_GENERAL,
+		           "empty or padding-only packet");
+		goto error_malformed;
+	}
+	if(!rohc_decomp_parse_feedbacks(decomp, &remain_data, NULL))
+	{
+		rohc_warning(decomp, ROHC_TRACE_DECOMP, ROHC_PROFILE_GENERAL,
+		             "failed to skip feedback items at the beginning of the "
+		             "ROHC packet");
+		goto error_malformed;
+	}
+	if(remain_data.len == 0)
+	{
+		rohc_debug(decomp, ROHC_TRACE_DECOMP, ROHC_PROFILE_GENERAL,
+		           "feedback-only packet, no CID");
+		goto error_no_context;
+	}
+
+	/* the CID of a segment is located in the RRU */
+	if(rohc_decomp_packet_is_segment(rohc_buf_data(remain_data)))
+	{
+		rohc_debug(decomp, ROHC_TRACE_DECOMP, ROHC_PROFILE_GENERAL,
+		           "ROHC segment, CID is unknown until the RRU is complete");
+		goto error_segment;
+	}
+
+	/* decode small or large CID */
+	if(!rohc_decomp_decode_cid(decomp, rohc_buf_data(remain_data),
+	                           remain_data.len, cid, &add_cid_len,
+	                           &large_cid_len))
+	{
+		rohc_warning(decomp, ROHC_TRACE_DECOMP, ROHC_PROFILE_GENERAL,
+		             "failed to decode small or large CID in packet");
+		goto error_malformed;
+	}
+	if((*cid) > decomp->medium.max_cid)
+	{
+		rohc_warning(decomp, ROHC_TRACE_DECOMP, ROHC_PROFILE_GENERAL,
+		             "unexpected CID %zu received: MAX_CID was set to %zu",
+		             *cid, decomp->medium.max_cid);
+		goto error_no_context;
+	}
+
+	return ROHC_STATUS_OK;
+
+error_segment:
+	return ROHC_STATUS_SEGMENT;
+error_no_context:
+	return ROHC_STATUS_NO_CONTEXT;
+error_malformed:
+	return ROHC_STATUS_MALFORMED;
+error:
+	return ROHC_STATUS_ERROR;
+}
+
+
 /**
  * @brief Decompress the compressed headers.
  *
@@ -1359,6 +1481,8 @@ static rohc_status_t rohc_decomp_decode_pkt(struct rohc_decomp *const decomp,
 {
 	const struct rohc_decomp_profile *const profile = context->profile;
 	struct rohc_decomp_crc *const extr_crc_bits = &context->volat_ctxt.crc;
+	struct rohc_decomp_static_chain *const static_chain =
+		&context->volat_ctxt.static_chain;
 	void *const extr_bits = context->volat_ctxt.extr_bits;
 	void *const decoded_values = context->volat_ctxt.decoded_values;
 
@@ -1387,9 +1511,11 @@ static rohc_status_t rohc_decomp_decode_pkt(struct rohc_decomp *const decomp,
 	                  rohc_get_packet_descr(*packet_type), *packet_type);
 
 	/* let's parse the packet! */
+	static_chain->data = NULL;
+	static_chain->len = 0;
 	parsing_ok = profile->parse_pkt(context, rohc_packet, large_cid_len,
-	                                packet_type, extr_crc_bits, extr_bits,
-	                                &rohc_hdr_len);
+	                                packet_type, extr_crc_bits, static_chain,
+	                                extr_bits, &rohc_hdr_len);
 	if(!parsing_ok)
 	{
 		rohc_decomp_warn(context, "failed to parse the %s header",
@@ -1639,6 +1765,23 @@ static rohc_status_t rohc_decomp_decode_pkt(struct rohc_decomp *const decomp,
 	rohc_decomp_update_context(context, decoded_values, payload_len,
 	                           rohc_packet.time, do_change_mode);
 
+	/* keep the static chain of the IR packet to detect the next IR refreshes
+	 * that do not change it (IR-CR packets replicate the static part of the
+	 * context without any static chain) */
+	if((*packet_type) == ROHC_PACKET_IR || (*packet_type) == ROHC_PACKET_IR_CR)
+	{
+		if(static_chain->len == 0 ||
+		   static_chain->len > ROHC_DECOMP_STATIC_CHAIN_MAX_LEN)
+		{
+			context->static_chain_len = 0;
+		}
+		else if(static_chain->data != context->static_chain)
+		{
+			memcpy(context->static_chain, static_chain->data, static_chain->len);
+			context->static_chain_len = static_chain->len;
+		}
+	}
+
 	/* update statistics */
 	rohc_decomp_stats_add_success(context, rohc_hdr_len, uncomp_hdr_len);
 
@@ -1824,6 +1967,45 @@ static void rohc_decomp_update_context(struct rohc_decomp_ctxt *const context,
 }
 
 
+/**
+ * @brief Whether the static chain of an IR packet is the one kept in context
+ *
+ * The profiles call the function before parsing the static chain of an IR
+ * packet: if the static chain is byte-identical to the one of the last IR
+ * packet that updated the context, the static part of the context is already
+ * up-to-date, so the profile may skip the static chain and parse the dynamic
+ * chain only, the same way it parses IR-DYN packets.
+ *
+ * @param context            The decompression context
+ * @param rohc_data          The static chain of the IR packet and the data
+ *                           that follows
+ * @param rohc_len           The length of the remaining ROHC data
+ * @param[out] static_chain  The static chain found in the IR packet
+ * @return                   true if the static chain did not change,
+ *                           false if it shall be parsed
+ */
+bool rohc_decomp_static_chain_unchanged(const struct rohc_decomp_ctxt *const context,
+                                        const uint8_t *const rohc_data,
+                                        const size_t rohc_len,
+                                        struct rohc_decomp_static_chain *const static_chain)
+{
+	if(context->num_recv_packets == 0 ||
+	   context->static_chain_len == 0 ||
+	   context->static_chain_len > rohc_len ||
+	   memcmp(rohc_data, context->static_chain, context->static_chain_len) != 0)
+	{
+		return false;
+	}
+
+	rohc_decomp_debug(context, "the %zu-byte static chain did not change, skip it",
+	                  context->static_chain_len);
+	static_chain->data = context->static_chain;
+	static_chain->len = context->static_chain_len;
+
+	return true;
+}
+
+
 /**
  * @brief Build a positive ACK feedback
  *
@@ -3330,7 +3512,10 @@ bool rohc_decomp_set_features(struct rohc_decomp *const decomp,
 {
 	const rohc_decomp_features_t all_features =
 		ROHC_DECOMP_FEATURE_CRC_REPAIR |
-		ROHC_DECOMP_FEATURE_DUMP_PACKETS;
+		ROHC_DECOMP_FEATURE_DUMP_PACKETS |
+		ROHC_DECOMP_FEATURE_TCP_TS_UNCHANGED |
+		ROHC_DECOMP_FEATURE_UDP_OVERLAYS |
+		ROHC_DECOMP_FEATURE_SRH_UPDATES;
 
 	/* decompressor must be valid */
 	if(decomp == NULL)
@@ -3814,7 +3999,7 @@ static const struct rohc_decomp_profile * find_profile(const struct rohc_decomp
  * @param[out] large_cid_len  The length of large CID in ROHC packet
  * @return                    true in case of success, false in case of failure
  */
-static bool rohc_decomp_decode_cid(struct rohc_decomp *decomp,
+static bool rohc_decomp_decode_cid(const struct rohc_decomp *const decomp,
                                    const uint8_t *packet,
                                    unsigned int len,
                                    rohc_cid_t *const cid,
@@ -4132,7 +4317,7 @@ error_no_context:
  * @return                    true if parsing of feedback items is successful,
  *                            false if at least one feedback is malformed
  */
-static bool rohc_decomp_parse_feedbacks(struct rohc_decomp *const decomp,
+static bool rohc_decomp_parse_feedbacks(const struct rohc_decomp *const decomp,
                                         struct rohc_buf *const rohc_data,
                                         struct rohc_buf *const feedbacks)
 {
@@ -4198,7 +4383,7 @@ error:
  * @return                   true if feedback parsing was successful,
  *                           false if feedback is malformed
  */
-static bool rohc_decomp_parse_feedback(struct rohc_decomp *const decomp,
+static bool rohc_decomp_parse_feedback(const struct rohc_decomp *const decomp,
                                        struct rohc_buf *const rohc_data,
                                        struct rohc_buf *const feedback,
                                        size_t *const feedback_len)
@@ -303,6 +303,18 @@ typedef enum
 	ROHC_DECOMP_FEATURE_COMPAT_1_6_x = (1 << 1),
 	/** Dump content of packets in traces (beware: performance impact) */
 	ROHC_DECOMP_FEATURE_DUMP_PACKETS = (1 << 3),
+	/** Decode unchanged TCP timestamps from the 1-byte and 2-byte forms
+	 *  (non-standard, the compressor shall enable
+	 *  \ref ROHC_COMP_FEATURE_TCP_TS_UNCHANGED too) */
+	ROHC_DECOMP_FEATURE_TCP_TS_UNCHANGED = (1 << 4),
+	/** Decompress the VXLAN/Geneve and inner Ethernet headers of the ROHCv2
+	 *  IP/UDP flows as static chain elements (non-standard, the compressor
+	 *  shall enable \ref ROHC_COMP_FEATURE_UDP_OVERLAYS too) */
+	ROHC_DECOMP_FEATURE_UDP_OVERLAYS = (1 << 5),
+	/** Update the Segment Routing Headers of the IPv6 extension lists without
+	 *  their unchanged segment lists (non-standard, the compressor shall
+	 *  enable \ref ROHC_COMP_FEATURE_SRH_UPDATES too) */
+	ROHC_DECOMP_FEATURE_SRH_UPDATES = (1 << 6),
 
 } rohc_decomp_features_t;
 
@@ -326,6 +338,11 @@ rohc_status_t ROHC_EXPORT rohc_decompress3(struct rohc_decomp *const decomp,
                                            struct rohc_buf *const feedback_send)
 	__attribute__((warn_unused_result));
 
+rohc_status_t ROHC_EXPORT rohc_decomp_get_cid(const struct rohc_decomp *const decomp,
+                                              const struct rohc_buf packet,
+                                              rohc_cid_t *const cid)
+	__attribute__((warn_unused_result));
+
 
 
 /*
@@ -42,6 +42,10 @@
 /** The number of ROHC profiles ready to be used */
 #define D_NUM_PROFILES 10U
 
+/** The maximal length of the static chain that a context may keep to detect
+ *  the IR refreshes that do not change its static part */
+#define ROHC_DECOMP_STATIC_CHAIN_MAX_LEN  128U
+
 
 /** Print a warning trace for the given decompression context */
 #define rohc_decomp_warn(context, format, ...) \
@@ -246,6 +250,14 @@ struct rohc_decomp_crc
 };
 
 
+/** The static chain found in a ROHC packet */
+struct rohc_decomp_static_chain
+{
+	const uint8_t *data;  /**< The static chain in the ROHC packet */
+	size_t len;           /**< The length of the static chain, 0 if none */
+};
+
+
 /**
  * @brief The volatile part of the ROHC decompression context
  *
@@ -258,6 +270,9 @@ struct rohc_decomp_volat_ctxt
 	/** The CRC information extracted from the ROHC packet being parsed */
 	struct rohc_decomp_crc crc;
 
+	/** The static chain found in the ROHC packet being parsed */
+	struct rohc_decomp_static_chain static_chain;
+
 	/** The profile-specific data for bits extracted from the ROHC packet,
 	 * defined by the profiles */
 	void *extr_bits;
@@ -304,6 +319,18 @@ struct rohc_decomp_ctxt
 	/** The context for corrections upon CRC failure */
 	struct rohc_decomp_crc_corr_ctxt crc_corr;
 
+	/**
+	 * @brief The static chain of the last IR packet that updated the context
+	 *
+	 * The IR refreshes usually transmit the very same static chain again: the
+	 * profiles do not parse it again if it is byte-identical to this one.
+	 *
+	 * @see rohc_decomp_static_chain_unchanged
+	 */
+	uint8_t static_chain[ROHC_DECOMP_STATIC_CHAIN_MAX_LEN];
+	/** The length of the static chain kept in context, 0 if none */
+	size_t static_chain_len;
+
 	/* below are some statistics */
 
 	/** The type of the last decompressed ROHC packet */
@@ -366,9 +393,10 @@ typedef bool (*rohc_decomp_parse_pkt_t)(const struct rohc_decomp_ctxt *const con
                                         const size_t large_cid_len,
                                         rohc_packet_t *const packet_type,
                                         struct rohc_decomp_crc *const extr_crc,
+                                        struct rohc_decomp_static_chain *const static_chain,
                                         void *const extr_bits,
                                         size_t *const rohc_hdr_len)
-	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7)));
+	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7, 8)));
 
 typedef rohc_status_t (*rohc_decomp_decode_bits_t)(const struct rohc_decomp_ctxt *const context,
                                                    const void *const extr_bits,
@@ -447,5 +475,12 @@ struct rohc_decomp_profile
 	rohc_decomp_get_sn_t get_sn;
 };
 
+
+bool rohc_decomp_static_chain_unchanged(const struct rohc_decomp_ctxt *const context,
+                                        const uint8_t *const rohc_data,
+                                        const size_t rohc_len,
+                                        struct rohc_decomp_static_chain *const static_chain)
+	__attribute__((warn_unused_result, nonnull(1, 2, 4)));
+
 #endif
 
@@ -97,9 +97,15 @@ static bool parse_ir(const struct rohc_decomp_ctxt *const context,
                      const size_t large_cid_len,
                      rohc_packet_t *const packet_type,
                      struct rohc_decomp_crc *const extr_crc,
+                     struct rohc_decomp_static_chain *const static_chain,
                      struct rohc_extr_bits *const bits,
                      size_t *const rohc_hdr_len)
-	__attribute__((warn_unused_result, nonnull(1, 2, 5, 6, 7, 8)));
+	__attribute__((warn_unused_result, nonnull(1, 2, 5, 6, 7, 8, 9)));
+static int parse_static_chain(const struct rohc_decomp_ctxt *const context,
+                              const uint8_t *const rohc_packet,
+                              const size_t rohc_length,
+                              struct rohc_extr_bits *const bits)
+	__attribute__((warn_unused_result, nonnull(1, 2, 4)));
 
 static bool parse_irdyn(const struct rohc_decomp_ctxt *const context,
                         const uint8_t *const rohc_packet,
@@ -366,6 +372,8 @@ bool rohc_decomp_rfc3095_create(const struct rohc_decomp_ctxt *const context,
                                 void *const trace_cb_priv,
                                 const int profile_id)
 {
+	const bool srh_updates =
+		!!(context->decompressor->features & ROHC_DECOMP_FEATURE_SRH_UPDATES);
 	struct rohc_decomp_rfc3095_ctxt *rfc3095_ctxt;
 
 	/* allocate memory for the generic context */
@@ -401,9 +409,9 @@ bool rohc_decomp_rfc3095_create(const struct rohc_decomp_ctxt *const context,
 
 	/* init the context used to compress the list of IPv6 extension headers
 	 * for the outer and inner IP headers */
-	rohc_decomp_list_ipv6_init(&rfc3095_ctxt->list_decomp1,
+	rohc_decomp_list_ipv6_init(&rfc3095_ctxt->list_decomp1, srh_updates,
 	                           trace_cb, trace_cb_priv, profile_id);
-	rohc_decomp_list_ipv6_init(&rfc3095_ctxt->list_decomp2,
+	rohc_decomp_list_ipv6_init(&rfc3095_ctxt->list_decomp2, srh_updates,
 	                           trace_cb, trace_cb_priv, profile_id);
 
 	/* no default next header */
@@ -485,6 +493,7 @@ void rohc_decomp_rfc3095_destroy(struct rohc_decomp_rfc3095_ctxt *const rfc3095_
  * @param[in,out] packet_type  IN:  The type of the ROHC packet to parse
  *                             OUT: The type of the parsed ROHC packet
  * @param[out] extr_crc        The CRC bits extracted from the ROHC header
+ * @param[out] static_chain    The static chain transmitted in IR packets
  * @param[out] bits            The bits extracted from the ROHC header
  * @param[out] rohc_hdr_len    The length of the ROHC header (in bytes)
  * @return                     true if packet is successfully parsed,
@@ -507,6 +516,7 @@ bool rfc3095_decomp_parse_pkt(const struct rohc_decomp_ctxt *const context,
                               const size_t large_cid_len,
                               rohc_packet_t *const packet_type,
                               struct rohc_decomp_crc *const extr_crc,
+                              struct rohc_decomp_static_chain *const static_chain,
                               struct rohc_extr_bits *const bits,
                               size_t *const rohc_hdr_len)
 {
@@ -523,14 +533,16 @@ bool rfc3095_decomp_parse_pkt(const struct rohc_decomp_ctxt *const context,
 	              size_t *const _rohc_hdr_len)
 		__attribute__((warn_unused_result, nonnull(1, 2, 5, 6, 7, 8)));
 
+	/* the IR packet is the only one that may transmit the static chain */
+	if((*packet_type) == ROHC_PACKET_IR)
+	{
+		return parse_ir(context, rohc_packet_data, rohc_length, large_cid_len,
+		                packet_type, extr_crc, static_chain, bits, rohc_hdr_len);
+	}
+
 	/* what function to call for parsing the packet? */
 	switch(*packet_type)
 	{
-		case ROHC_PACKET_IR:
-		{
-			parse = parse_ir;
-			break;
-		}
 		case ROHC_PACKET_IR_DYN:
 		{
 			parse = parse_irdyn;
@@ -642,6 +654,7 @@ error:
  * @param packet_type    IN:  The type of the ROHC packet to parse
  *                       OUT: The type of the parsed ROHC packet
  * @param[out] extr_crc  The CRC extracted from the ROHC packet
+ * @param[out] static_chain  The static chain transmitted in the IR packet
  * @param bits           OUT: The bits extracted from the IR header
  * @param rohc_hdr_len   OUT: The size of the IR header
  * @return               true if IR is successfully parsed, false otherwise
@@ -652,6 +665,7 @@ static bool parse_ir(const struct rohc_decomp_ctxt *const context,
                      const size_t large_cid_len,
                      rohc_packet_t *const packet_type,
                      struct rohc_decomp_crc *const extr_crc,
+                     struct rohc_decomp_static_chain *const static_chain,
                      struct rohc_extr_bits *const bits,
                      size_t *const rohc_hdr_len)
 {
@@ -709,6 +723,123 @@ static bool parse_ir(const struct rohc_decomp_ctxt *const context,
 	rohc_remain_len--;
 	(*rohc_hdr_len)++;
 
+	/* parse the static chain, unless it is the one already in context: the
+	 * static fields are then taken from context as for IR-DYN packets */
+	if(rohc_decomp_static_chain_unchanged(context, rohc_remain_data,
+	                                      rohc_remain_len, static_chain))
+	{
+		size = static_chain->len;
+	}
+	else
+	{
+		size = parse_static_chain(context, rohc_remain_data, rohc_remain_len, bits);
+		if(size == -1)
+		{
+			rohc_decomp_warn(context, "cannot parse the static chain");
+			goto error;
+		}
+		static_chain->data = rohc_remain_data;
+		static_chain->len = size;
+	}
+	rohc_remain_data += size;
+	rohc_remain_len -= size;
+	*rohc_hdr_len += size;
+
+	/* decode the dynamic part of the ROHC packet */
+	if(dynamic_present)
+	{
+		/* decode the dynamic part of the outer IP header */
+		size = parse_dynamic_part_ip(context, rohc_remain_data, rohc_remain_len,
+		                             &bits->outer_ip, &rfc3095_ctxt->list_decomp1);
+		if(size == -1)
+		{
+			rohc_decomp_warn(context, "cannot parse outer IP dynamic part");
+			goto error;
+		}
+		rohc_remain_data += size;
+		rohc_remain_len -= size;
+		*rohc_hdr_len += size;
+
+		/* decode the dynamic part of the inner IP header */
+		if(bits->multiple_ip)
+		{
+			size = parse_dynamic_part_ip(context, rohc_remain_data, rohc_remain_len,
+			                             &bits->inner_ip, &rfc3095_ctxt->list_decomp2);
+			if(size == -1)
+			{
+				rohc_decomp_warn(context, "cannot parse inner IP dynamic part");
+				goto error;
+			}
+			rohc_remain_data += size;
+			rohc_remain_len -= size;
+			*rohc_hdr_len += size;
+		}
+
+		/* parse the dynamic part of the next header header if necessary */
+		if(rfc3095_ctxt->parse_dyn_next_hdr != NULL)
+		{
+			size = rfc3095_ctxt->parse_dyn_next_hdr(context, rohc_remain_data,
+			                                        rohc_remain_len, bits);
+			if(size == -1)
+			{
+				rohc_decomp_warn(context, "cannot parse next header dynamic part");
+				goto error;
+			}
+#ifndef __clang_analyzer__ /* silent warning about dead increment */
+			rohc_remain_data += size;
+			rohc_remain_len -= size;
+#endif
+			*rohc_hdr_len += size;
+		}
+	}
+	else if(context->state != ROHC_DECOMP_STATE_FC)
+	{
+		/* in 'Static Context' or 'No Context' state and the packet does not
+		 * contain a dynamic part */
+		rohc_decomp_warn(context, "receive IR packet without a dynamic part, "
+		                 "but not in Full Context state");
+		goto error;
+	}
+
+	/* sanity checks */
+	assert((*rohc_hdr_len) <= rohc_length);
+
+	/* invalid CRC-STATIC cache since some STATIC fields may have changed */
+	rfc3095_ctxt->is_crc_static_3_cached_valid = false;
+	rfc3095_ctxt->is_crc_static_7_cached_valid = false;
+
+	/* IR packet was successfully parsed */
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Parse the static chain of one IR packet
+ *
+ * The static chain is made of the static parts of the outer IP header, of the
+ * optional inner IP header, and of the optional next header.
+ *
+ * @param context        The decompression context
+ * @param rohc_packet    The ROHC data to parse, starting with the static chain
+ * @param rohc_length    The length of the ROHC data to parse
+ * @param bits           OUT: The bits extracted from the static chain
+ * @return               The length of the static chain (in bytes),
+ *                       -1 in case of failure
+ */
+static int parse_static_chain(const struct rohc_decomp_ctxt *const context,
+                              const uint8_t *const rohc_packet,
+                              const size_t rohc_length,
+                              struct rohc_extr_bits *const bits)
+{
+	struct rohc_decomp_rfc3095_ctxt *const rfc3095_ctxt = context->persist_ctxt;
+	const uint8_t *rohc_remain_data = rohc_packet;
+	size_t rohc_remain_len = rohc_length;
+	size_t static_chain_len = 0;
+	int size;
+
 	/* decode the static part of the outer header */
 	size = parse_static_part_ip(context, rohc_remain_data, rohc_remain_len,
 	                            &bits->outer_ip);
@@ -719,7 +850,7 @@ static bool parse_ir(const struct rohc_decomp_ctxt *const context,
 	}
 	rohc_remain_data += size;
 	rohc_remain_len -= size;
-	*rohc_hdr_len += size;
+	static_chain_len += size;
 
 	/* check for IP version switch during context re-use */
 	if(context->num_recv_packets >= 1 &&
@@ -774,7 +905,7 @@ static bool parse_ir(const struct rohc_decomp_ctxt *const context,
 		}
 		rohc_remain_data += size;
 		rohc_remain_len -= size;
-		*rohc_hdr_len += size;
+		static_chain_len += size;
 
 		/* check for IP version switch during context re-use */
 		if(context->num_recv_packets >= 1 &&
@@ -798,79 +929,17 @@ static bool parse_ir(const struct rohc_decomp_ctxt *const context,
 			rohc_decomp_warn(context, "cannot parse next header static part");
 			goto error;
 		}
+#ifndef __clang_analyzer__ /* silent warning about dead increment */
 		rohc_remain_data += size;
 		rohc_remain_len -= size;
-		*rohc_hdr_len += size;
-	}
-
-	/* decode the dynamic part of the ROHC packet */
-	if(dynamic_present)
-	{
-		/* decode the dynamic part of the outer IP header */
-		size = parse_dynamic_part_ip(context, rohc_remain_data, rohc_remain_len,
-		                             &bits->outer_ip, &rfc3095_ctxt->list_decomp1);
-		if(size == -1)
-		{
-			rohc_decomp_warn(context, "cannot parse outer IP dynamic part");
-			goto error;
-		}
-		rohc_remain_data += size;
-		rohc_remain_len -= size;
-		*rohc_hdr_len += size;
-
-		/* decode the dynamic part of the inner IP header */
-		if(bits->multiple_ip)
-		{
-			size = parse_dynamic_part_ip(context, rohc_remain_data, rohc_remain_len,
-			                             &bits->inner_ip, &rfc3095_ctxt->list_decomp2);
-			if(size == -1)
-			{
-				rohc_decomp_warn(context, "cannot parse inner IP dynamic part");
-				goto error;
-			}
-			rohc_remain_data += size;
-			rohc_remain_len -= size;
-			*rohc_hdr_len += size;
-		}
-
-		/* parse the dynamic part of the next header header if necessary */
-		if(rfc3095_ctxt->parse_dyn_next_hdr != NULL)
-		{
-			size = rfc3095_ctxt->parse_dyn_next_hdr(context, rohc_remain_data,
-			                                        rohc_remain_len, bits);
-			if(size == -1)
-			{
-				rohc_decomp_warn(context, "cannot parse next header dynamic part");
-				goto error;
-			}
-#ifndef __clang_analyzer__ /* silent warning about dead increment */
-			rohc_remain_data += size;
-			rohc_remain_len -= size;
 #endif
-			*rohc_hdr_len += size;
-		}
-	}
-	else if(context->state != ROHC_DECOMP_STATE_FC)
-	{
-		/* in 'Static Context' or 'No Context' state and the packet does not
-		 * contain a dynamic part */
-		rohc_decomp_warn(context, "receive IR packet without a dynamic part, "
-		                 "but not in Full Context state");
-		goto error;
+		static_chain_len += size;
 	}
 
-	/* sanity checks */
-	assert((*rohc_hdr_len) <= rohc_length);
-
-	/* invalid CRC-STATIC cache since some STATIC fields may have changed */
-	rfc3095_ctxt->is_crc_static_3_cached_valid = false;
-	rfc3095_ctxt->is_crc_static_7_cached_valid = false;
-
-	/* IR packet was successfully parsed */
-	return true;
+	return static_chain_len;
 
 error:
-	return false;
+	return -1;
 }
 
 
@@ -473,9 +473,10 @@ bool rfc3095_decomp_parse_pkt(const struct rohc_decomp_ctxt *const context,
                               const size_t large_cid_len,
                               rohc_packet_t *const packet_type,
                               struct rohc_decomp_crc *const extr_crc,
+                              struct rohc_decomp_static_chain *const static_chain,
                               struct rohc_extr_bits *const bits,
                               size_t *const rohc_hdr_len)
-	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7)));
+	__attribute__((warn_unused_result, nonnull(1, 4, 5, 6, 7, 8)));
 
 rohc_status_t rfc3095_decomp_build_hdrs(const struct rohc_decomp *const decomp,
                                         const struct rohc_decomp_ctxt *const context,
@@ -59,6 +59,10 @@ struct list_decomp
 	/** The temporary packet list (not persistent across packets) */
 	struct rohc_list pkt_list;
 
+	/** Whether the Segment Routing Headers may be updated without their
+	 *  unchanged segment list (non-standard) */
+	bool srh_updates;
+
 
 	/* Functions for handling the data to decompress */
 
@@ -28,6 +28,7 @@
 #include "rohc_traces_internal.h"
 
 #include <string.h>
+#include <assert.h>
 
 
 static bool check_ip6_item(const struct list_decomp *const decomp,
@@ -50,6 +51,12 @@ static bool create_ip6_item(const uint8_t *const data,
                             struct list_decomp *const decomp)
 	__attribute__((warn_unused_result, nonnull(1, 4)));
 
+static bool update_ip6_srh_item(const uint8_t *const data,
+                                const size_t length,
+                                const size_t index_table,
+                                struct list_decomp *const decomp)
+	__attribute__((warn_unused_result, nonnull(1, 4)));
+
 static size_t rohc_build_ip6_extension(const struct list_decomp *const decomp,
                                        const uint8_t ip_nh_type,
                                        uint8_t *const dest)
@@ -61,11 +68,14 @@ static size_t rohc_build_ip6_extension(const struct list_decomp *const decomp,
  * @brief Init one context for decompressing lists of IPv6 extension headers
  *
  * @param decomp         The context to create
+ * @param srh_updates    Whether the Segment Routing Headers may be updated
+ *                       without their unchanged segment list (non-standard)
  * @param trace_cb       The function to call for printing traces
  * @param trace_cb_priv  An optional private context, may be NULL
  * @param profile_id     The ID of the associated decompression profile
  */
 void rohc_decomp_list_ipv6_init(struct list_decomp *const decomp,
+                                const bool srh_updates,
                                 rohc_trace_callback2_t trace_cb,
                                 void *const trace_cb_priv,
                                 const int profile_id)
@@ -76,6 +86,7 @@ void rohc_decomp_list_ipv6_init(struct list_decomp *const decomp,
 	decomp->cmp_item = cmp_ipv6_ext;
 	decomp->create_item = create_ip6_item;
 	decomp->build_uncomp_item = rohc_build_ip6_extension;
+	decomp->srh_updates = srh_updates;
 
 	/* traces */
 	decomp->trace_callback = trace_cb;
@@ -185,6 +196,14 @@ static bool create_ip6_item(const uint8_t *const data,
 	}
 	item_type = data[0];
 
+	/* only the fixed part of a Segment Routing Header? */
+	if(decomp->srh_updates && item_type == ROHC_IPPROTO_ROUTING &&
+	   length == sizeof(struct ipv6_srh) &&
+	   data[2] == IPV6_ROUTING_TYPE_SRH)
+	{
+		return update_ip6_srh_item(data, length, index_table, decomp);
+	}
+
 	ret = rohc_list_item_update_if_changed(decomp->cmp_item,
 	                                       &decomp->trans_table[index_table],
 	                                       item_type, data, length);
@@ -205,6 +224,51 @@ error:
 }
 
 
+/**
+ * @brief Update the fixed part of a Segment Routing Header item
+ *
+ * The compressor transmits only the fixed part of the Segment Routing Header
+ * (SRH) if its segment list did not change. A Hdr Ext Len of 0 identifies
+ * such an update since a valid SRH contains at least one segment.
+ *
+ * @param data         The fixed part of the SRH
+ * @param length       The length of the fixed part of the SRH
+ * @param index_table  The index of the item in based table
+ * @param decomp       The list decompressor
+ * @return             true in case of success, false otherwise
+ */
+static bool update_ip6_srh_item(const uint8_t *const data,
+                                const size_t length,
+                                const size_t index_table,
+                                struct list_decomp *const decomp)
+{
+	struct rohc_list_item *const item = &decomp->trans_table[index_table];
+
+	assert(length == sizeof(struct ipv6_srh));
+
+	if(item->type != RTHDR || item->length <= length ||
+	   item->data[2] != IPV6_ROUTING_TYPE_SRH)
+	{
+		rd_list_warn(decomp, "malformed list item #%zu: fixed part of Segment "
+		             "Routing Header received while no segment list is known",
+		             index_table);
+		goto error;
+	}
+
+	/* keep the Next Header, the Hdr Ext Len and the segment list */
+	memcpy(item->data + 2, data + 2, length - 2);
+	item->known = true;
+
+	rd_list_debug(decomp, "fixed part of the %zu-byte Segment Routing Header "
+	              "updated in list item #%zu", item->length, index_table);
+
+	return true;
+
+error:
+	return false;
+}
+
+
 /**
  * @brief Build an extension list in IPv6 header
  *
@@ -29,6 +29,7 @@
 #include "schemes/decomp_list.h"
 
 void rohc_decomp_list_ipv6_init(struct list_decomp *const decomp,
+                                const bool srh_updates,
                                 rohc_trace_callback2_t trace_cb,
                                 void *const trace_cb_priv,
                                 const int profile_id)
@@ -38,6 +38,9 @@
  *
  * See RFC4996 page 65
  *
+ * The 1-byte and 2-byte forms may encode an unchanged TS value if the
+ * \ref ROHC_DECOMP_FEATURE_TCP_TS_UNCHANGED feature is enabled.
+ *
  * @param context        The decompression context
  * @param data           The data to decode
  * @param data_len       The length of the data to decode
@@ -50,6 +53,8 @@ int d_tcp_ts_lsb_parse(const struct rohc_decomp_ctxt *const context,
                        const size_t data_len,
                        struct rohc_lsb_field32 *const ts_field)
 {
+	const bool is_unchanged_allowed =
+		((context->decompressor->features & ROHC_DECOMP_FEATURE_TCP_TS_UNCHANGED) != 0);
 	const uint8_t *remain_data;
 	size_t remain_len;
 
@@ -70,7 +75,8 @@ int d_tcp_ts_lsb_parse(const struct rohc_decomp_ctxt *const context,
 		rohc_decomp_debug(context, "TCP TS option: TS field is 1-byte long");
 		ts_field->bits = remain_data[0];
 		ts_field->bits_nr = 7;
-		ts_field->p = ROHC_LSB_SHIFT_TCP_TS_1B;
+		ts_field->p = (is_unchanged_allowed ? ROHC_LSB_SHIFT_TCP_TS_UNCHANGED :
+		               ROHC_LSB_SHIFT_TCP_TS_1B);
 		remain_len--;
 	}
 	else if((remain_data[0] & 0x40) == 0)
@@ -87,7 +93,8 @@ int d_tcp_ts_lsb_parse(const struct rohc_decomp_ctxt *const context,
 		ts_field->bits = (remain_data[0] & 0x3f) << 8;
 		ts_field->bits |= remain_data[1];
 		ts_field->bits_nr = 14;
-		ts_field->p = ROHC_LSB_SHIFT_TCP_TS_2B;
+		ts_field->p = (is_unchanged_allowed ? ROHC_LSB_SHIFT_TCP_TS_UNCHANGED :
+		               ROHC_LSB_SHIFT_TCP_TS_2B);
 		remain_len -= 2;
 	}
 	else if((remain_data[0] & 0x20) == 0)
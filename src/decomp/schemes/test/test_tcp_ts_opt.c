@@ -145,6 +145,69 @@ static void test_tcp_ts_opt(void **state)
 		assert_true(lsb32.bits_nr == 29);
 		assert_true(lsb32.p == ROHC_LSB_SHIFT_TCP_TS_4B);
 	}
+
+	/* 1-byte and 2-byte long that may encode an unchanged value */
+	decomp.features = ROHC_DECOMP_FEATURE_TCP_TS_UNCHANGED;
+	{
+		const uint8_t data[6] = { 0x7f, 0xbf, 0xff, 0xc0, 0x00, 0x01 };
+
+		ret = d_tcp_ts_lsb_parse(&context, data, 1, &lsb32);
+		assert_true(ret == 1);
+		assert_true(lsb32.bits == 0x7f);
+		assert_true(lsb32.bits_nr == 7);
+		assert_true(lsb32.p == ROHC_LSB_SHIFT_TCP_TS_UNCHANGED);
+
+		ret = d_tcp_ts_lsb_parse(&context, data + 1, 2, &lsb32);
+		assert_true(ret == 2);
+		assert_true(lsb32.bits == 0x3fff);
+		assert_true(lsb32.bits_nr == 14);
+		assert_true(lsb32.p == ROHC_LSB_SHIFT_TCP_TS_UNCHANGED);
+
+		ret = d_tcp_ts_lsb_parse(&context, data + 3, 3, &lsb32);
+		assert_true(ret == 3);
+		assert_true(lsb32.bits == 0x1);
+		assert_true(lsb32.bits_nr == 21);
+		assert_true(lsb32.p == ROHC_LSB_SHIFT_TCP_TS_3B);
+	}
+
+	/* boundaries of the interpretation intervals of the 1-byte and 2-byte
+	 * forms, with and without unchanged values */
+	for(i = 0; i < 2; i++)
+	{
+		const uint32_t refs[2] = { 0x12345678, 0xffffffc0 };
+		const uint8_t data[3] = { 0x00, 0x80, 0x00 };
+		struct rohc_interval32 interval;
+
+		/* standard 1-byte form: from ref + 1 to ref + 128 */
+		decomp.features = ROHC_DECOMP_FEATURE_NONE;
+		ret = d_tcp_ts_lsb_parse(&context, data, 1, &lsb32);
+		assert_true(ret == 1);
+		interval = rohc_f_32bits(refs[i], lsb32.bits_nr, lsb32.p);
+		assert_true(interval.min == (refs[i] + 1));
+		assert_true(interval.max == (refs[i] + 128));
+
+		/* standard 2-byte form: from ref + 1 to ref + 16384 */
+		ret = d_tcp_ts_lsb_parse(&context, data + 1, 2, &lsb32);
+		assert_true(ret == 2);
+		interval = rohc_f_32bits(refs[i], lsb32.bits_nr, lsb32.p);
+		assert_true(interval.min == (refs[i] + 1));
+		assert_true(interval.max == (refs[i] + 16384));
+
+		/* 1-byte form with unchanged values: from ref to ref + 127 */
+		decomp.features = ROHC_DECOMP_FEATURE_TCP_TS_UNCHANGED;
+		ret = d_tcp_ts_lsb_parse(&context, data, 1, &lsb32);
+		assert_true(ret == 1);
+		interval = rohc_f_32bits(refs[i], lsb32.bits_nr, lsb32.p);
+		assert_true(interval.min == refs[i]);
+		assert_true(interval.max == (refs[i] + 127));
+
+		/* 2-byte form with unchanged values: from ref to ref + 16383 */
+		ret = d_tcp_ts_lsb_parse(&context, data + 1, 2, &lsb32);
+		assert_true(ret == 2);
+		interval = rohc_f_32bits(refs[i], lsb32.bits_nr, lsb32.p);
+		assert_true(interval.min == refs[i]);
+		assert_true(interval.max == (refs[i] + 16383));
+	}
 }
 
 
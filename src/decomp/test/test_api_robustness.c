@@ -283,6 +283,9 @@ int main(int argc, char *argv[])
 	/* rohc_decomp_set_features */
 	CHECK(rohc_decomp_set_features(decomp, ROHC_DECOMP_FEATURE_COMPAT_1_6_x) == false);
 	CHECK(rohc_decomp_set_features(decomp, ROHC_DECOMP_FEATURE_CRC_REPAIR) == true);
+	CHECK(rohc_decomp_set_features(decomp, ROHC_DECOMP_FEATURE_TCP_TS_UNCHANGED) == true);
+	CHECK(rohc_decomp_set_features(decomp, ROHC_DECOMP_FEATURE_UDP_OVERLAYS) == true);
+	CHECK(rohc_decomp_set_features(decomp, ROHC_DECOMP_FEATURE_SRH_UPDATES) == true);
 	CHECK(rohc_decomp_set_features(decomp, ROHC_DECOMP_FEATURE_NONE) == true);
 
 	/* rohc_decompress3() */
@@ -358,6 +361,39 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	/* rohc_decomp_get_cid() */
+	{
+		const struct rohc_ts ts = { .sec = 0, .nsec = 0 };
+		uint8_t buf_ir[] = { 0xe0, 0xf1, 0x00, 0xfd, 0x05, 0x00 };
+		struct rohc_buf pkt_ir = rohc_buf_init_full(buf_ir, sizeof(buf_ir), ts);
+		uint8_t buf_big_cid[] = { 0xfd, 0x10, 0x00 };
+		struct rohc_buf pkt_big_cid =
+			rohc_buf_init_full(buf_big_cid, sizeof(buf_big_cid), ts);
+		uint8_t buf_feedback[] = { 0xe0, 0xf1, 0x00 };
+		struct rohc_buf pkt_feedback =
+			rohc_buf_init_full(buf_feedback, sizeof(buf_feedback), ts);
+		uint8_t buf_segment[] = { 0xff, 0x00, 0x00 };
+		struct rohc_buf pkt_segment =
+			rohc_buf_init_full(buf_segment, sizeof(buf_segment), ts);
+		uint8_t buf_padding[] = { 0xe0, 0xe0 };
+		struct rohc_buf pkt_padding =
+			rohc_buf_init_full(buf_padding, sizeof(buf_padding), ts);
+		uint8_t buf_truncated[] = { 0xfd };
+		struct rohc_buf pkt_truncated =
+			rohc_buf_init_full(buf_truncated, sizeof(buf_truncated), ts);
+		rohc_cid_t cid;
+
+		CHECK(rohc_decomp_get_cid(NULL, pkt_ir, &cid) == ROHC_STATUS_ERROR);
+		CHECK(rohc_decomp_get_cid(decomp, pkt_ir, NULL) == ROHC_STATUS_ERROR);
+		CHECK(rohc_decomp_get_cid(decomp, pkt_ir, &cid) == ROHC_STATUS_OK);
+		CHECK(cid == 5);
+		CHECK(rohc_decomp_get_cid(decomp, pkt_big_cid, &cid) == ROHC_STATUS_NO_CONTEXT);
+		CHECK(rohc_decomp_get_cid(decomp, pkt_feedback, &cid) == ROHC_STATUS_NO_CONTEXT);
+		CHECK(rohc_decomp_get_cid(decomp, pkt_segment, &cid) == ROHC_STATUS_SEGMENT);
+		CHECK(rohc_decomp_get_cid(decomp, pkt_padding, &cid) == ROHC_STATUS_MALFORMED);
+		CHECK(rohc_decomp_get_cid(decomp, pkt_truncated, &cid) == ROHC_STATUS_MALFORMED);
+	}
+
 	/* rohc_decomp_get_last_packet_info() */
 	{
 		rohc_decomp_last_packet_info_t info;
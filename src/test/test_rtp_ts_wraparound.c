@@ -192,7 +192,7 @@ bool run_test(bool be_verbose, const unsigned int incr)
 		      i, value, real_incr);
 
 		/* update encoding context */
-		c_add_ts(&ts_sc_comp, value, i);
+		c_add_ts(&ts_sc_comp, value, i, ROHC_INIT_TS_STRIDE_MIN);
 
 		/* transmit the required bits wrt to encoding state */
 		switch(ts_sc_comp.state)
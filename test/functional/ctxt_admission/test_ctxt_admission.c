@@ -0,0 +1,500 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_ctxt_admission.c
+ * @brief  Check the admission control of the contexts of new flows
+ * @author agent <agent@local>
+ *
+ * The application configures the compressor to give a context only to the
+ * flows that show 3 packets. All packets are given without arrival time.
+ * The short flows shall be compressed with the context of the Uncompressed
+ * profile, the other flows shall get their own context once they showed
+ * enough packets. All packets shall be decompressed correctly.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+#include <stdarg.h>
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/udp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The number of packets a flow shall show to get its own context */
+#define TEST_ADMISSION_PKTS_NR  3U
+
+/** The number of one-packet flows that end the admission window */
+#define TEST_SHORT_FLOWS_NR  1100U
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_ctxt_admission(void);
+static bool build_packet(const size_t flow_num,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(3)));
+static bool compress_one(struct rohc_comp *const comp,
+                         struct rohc_decomp *const decomp,
+                         const size_t flow_num,
+                         const size_t pkt_num,
+                         const int exp_profile_id,
+                         int *const cid)
+	__attribute__((warn_unused_result, nonnull(1, 2, 6)));
+static void print_rohc_traces(void *const priv_ctxt,
+                              const rohc_trace_level_t level,
+                              const rohc_trace_entity_t entity,
+                              const int profile,
+                              const char *const format,
+                              ...)
+	__attribute__((format(printf, 5, 6), nonnull(5)));
+static int gen_false_random_num(const struct rohc_comp *const comp,
+                                void *const user_context)
+	__attribute__((nonnull(1)));
+
+
+/**
+ * @brief Check the admission control of the contexts of new flows
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	status = test_ctxt_admission();
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the admission control of the contexts of new flows\n"
+	        "\n"
+	        "usage: test_ctxt_admission [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Compress short and long flows with admission control
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_ctxt_admission(void)
+{
+	struct rohc_comp *comp;
+	struct rohc_decomp *decomp;
+	int uncomp_cid;
+	int cid;
+	int cid_flow1;
+	int cid_flow2;
+	size_t flow_num;
+	size_t pkt_num;
+	int is_failure = 1;
+
+	/* create the ROHC compressor with small CID */
+	comp = rohc_comp_new2(ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                      gen_false_random_num, NULL);
+	if(comp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC compressor\n");
+		goto error;
+	}
+	if(!rohc_comp_set_traces_cb2(comp, print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "compressor\n");
+		goto destroy_comp;
+	}
+	if(!rohc_comp_enable_profiles(comp, ROHC_PROFILE_UNCOMPRESSED,
+	                              ROHC_PROFILE_UDP, -1))
+	{
+		fprintf(stderr, "failed to enable the compression profiles\n");
+		goto destroy_comp;
+	}
+	if(!rohc_comp_set_ctxt_admission(comp, TEST_ADMISSION_PKTS_NR, 1000))
+	{
+		fprintf(stderr, "failed to set the admission control\n");
+		goto destroy_comp;
+	}
+
+	/* create the ROHC decompressor in unidirectional mode */
+	decomp = rohc_decomp_new2(ROHC_SMALL_CID, ROHC_SMALL_CID_MAX, ROHC_U_MODE);
+	if(decomp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC decompressor\n");
+		goto destroy_comp;
+	}
+	if(!rohc_decomp_set_traces_cb2(decomp, print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "decompressor\n");
+		goto destroy_decomp;
+	}
+	if(!rohc_decomp_enable_profiles(decomp, ROHC_PROFILE_UNCOMPRESSED,
+	                                ROHC_PROFILE_UDP, -1))
+	{
+		fprintf(stderr, "failed to enable the decompression profiles\n");
+		goto destroy_decomp;
+	}
+
+	/* flow #0 shows 2 packets only: it shall be compressed with the
+	 * Uncompressed profile */
+	if(!compress_one(comp, decomp, 0, 0, ROHC_PROFILE_UNCOMPRESSED,
+	                 &uncomp_cid) ||
+	   !compress_one(comp, decomp, 0, 1, ROHC_PROFILE_UNCOMPRESSED, &cid))
+	{
+		goto destroy_decomp;
+	}
+	if(cid != uncomp_cid)
+	{
+		fprintf(stderr, "short flow #0 did not use the shared Uncompressed "
+		        "context\n");
+		goto destroy_decomp;
+	}
+	fprintf(stderr, "short flow #0 used the Uncompressed context with CID "
+	        "%d\n", uncomp_cid);
+
+	/* flow #1 gets its own context at its 3rd packet */
+	for(pkt_num = 0; pkt_num < (TEST_ADMISSION_PKTS_NR - 1); pkt_num++)
+	{
+		if(!compress_one(comp, decomp, 1, pkt_num, ROHC_PROFILE_UNCOMPRESSED,
+		                 &cid))
+		{
+			goto destroy_decomp;
+		}
+	}
+	for(; pkt_num < 10; pkt_num++)
+	{
+		if(!compress_one(comp, decomp, 1, pkt_num, ROHC_PROFILE_UDP,
+		                 &cid_flow1))
+		{
+			goto destroy_decomp;
+		}
+	}
+	if(cid_flow1 == uncomp_cid)
+	{
+		fprintf(stderr, "flow #1 did not get its own context\n");
+		goto destroy_decomp;
+	}
+	fprintf(stderr, "flow #1 got its own context with CID %d\n", cid_flow1);
+
+	/* flow #2 gets another context at its 3rd packet */
+	for(pkt_num = 0; pkt_num < (TEST_ADMISSION_PKTS_NR - 1); pkt_num++)
+	{
+		if(!compress_one(comp, decomp, 2, pkt_num, ROHC_PROFILE_UNCOMPRESSED,
+		                 &cid))
+		{
+			goto destroy_decomp;
+		}
+	}
+	if(!compress_one(comp, decomp, 2, pkt_num, ROHC_PROFILE_UDP, &cid_flow2))
+	{
+		goto destroy_decomp;
+	}
+	if(cid_flow2 == uncomp_cid || cid_flow2 == cid_flow1)
+	{
+		fprintf(stderr, "flow #2 did not get its own context\n");
+		goto destroy_decomp;
+	}
+	fprintf(stderr, "flow #2 got its own context with CID %d\n", cid_flow2);
+
+	/* flow #1 still uses its own context */
+	if(!compress_one(comp, decomp, 1, 10, ROHC_PROFILE_UDP, &cid))
+	{
+		goto destroy_decomp;
+	}
+	if(cid != cid_flow1)
+	{
+		fprintf(stderr, "flow #1 did not keep its own context\n");
+		goto destroy_decomp;
+	}
+
+	/* flow #3 shows 2 packets, then many one-packet flows end the admission
+	 * window even without arrival time: the 3rd packet of flow #3 shall not
+	 * be admitted */
+	for(pkt_num = 0; pkt_num < (TEST_ADMISSION_PKTS_NR - 1); pkt_num++)
+	{
+		if(!compress_one(comp, decomp, 3, pkt_num, ROHC_PROFILE_UNCOMPRESSED,
+		                 &cid))
+		{
+			goto destroy_decomp;
+		}
+	}
+	for(flow_num = 4; flow_num < (4 + TEST_SHORT_FLOWS_NR); flow_num++)
+	{
+		if(!compress_one(comp, decomp, flow_num, 0, ROHC_PROFILE_UNCOMPRESSED,
+		                 &cid))
+		{
+			goto destroy_decomp;
+		}
+	}
+	if(!compress_one(comp, decomp, 3, pkt_num, ROHC_PROFILE_UNCOMPRESSED,
+	                 &cid))
+	{
+		fprintf(stderr, "flow #3 was admitted with packets of a previous "
+		        "admission window\n");
+		goto destroy_decomp;
+	}
+	fprintf(stderr, "%u one-packet flows used the Uncompressed context\n",
+	        TEST_SHORT_FLOWS_NR);
+
+	is_failure = 0;
+
+destroy_decomp:
+	rohc_decomp_free(decomp);
+destroy_comp:
+	rohc_comp_free(comp);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Build the given packet of the given IPv4/UDP flow
+ *
+ * @param flow_num        The number of the IPv4/UDP flow
+ * @param pkt_num         The number of the packet in the IPv4/UDP flow
+ * @param[out] ip_packet  The IPv4/UDP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const size_t flow_num,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t payload_len = 20;
+	const size_t ip_len =
+		sizeof(struct ipv4_hdr) + sizeof(struct udphdr) + payload_len;
+	struct ipv4_hdr *ip_header;
+	struct udphdr *udp_header;
+	uint32_t csum = 0;
+	size_t i;
+
+	if(ip_packet->max_len < ip_len)
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+
+	/* generate the IPv4 header with a sequential IP-ID */
+	ip_packet->len = ip_len;
+	memset(rohc_buf_data(*ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(*ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + pkt_num);
+	ip_header->ttl = 64;
+	ip_header->protocol = ROHC_IPPROTO_UDP;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(*ip_packet, i) << 8) |
+		        rohc_buf_byte_at(*ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* generate the UDP header and its payload, one UDP source port per flow */
+	udp_header = (struct udphdr *) (ip_header + 1);
+	udp_header->source = htons(10000 + flow_num);
+	udp_header->dest = htons(53);
+	udp_header->len = htons(sizeof(struct udphdr) + payload_len);
+	udp_header->check = 0;
+	for(i = ip_len - payload_len; i < ip_len; i++)
+	{
+		rohc_buf_byte_at(*ip_packet, i) = (i + pkt_num) & 0xff;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Compress and decompress the given packet of the given IPv4/UDP flow
+ *
+ * @param comp            The ROHC compressor
+ * @param decomp          The ROHC decompressor
+ * @param flow_num        The number of the IPv4/UDP flow
+ * @param pkt_num         The number of the packet in the IPv4/UDP flow
+ * @param exp_profile_id  The profile expected for the packet
+ * @param[out] cid        The CID of the context used for the packet
+ * @return                true if the packet was compressed with the expected
+ *                        profile and decompressed correctly,
+ *                        false otherwise
+ */
+static bool compress_one(struct rohc_comp *const comp,
+                         struct rohc_decomp *const decomp,
+                         const size_t flow_num,
+                         const size_t pkt_num,
+                         const int exp_profile_id,
+                         int *const cid)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf ip_packet = rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf rohc_packet =
+		rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+	uint8_t uncomp_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf uncomp_packet =
+		rohc_buf_init_empty(uncomp_buffer, TEST_MAX_PKT_SIZE);
+	rohc_comp_last_packet_info2_t info;
+	rohc_status_t status;
+
+	if(!build_packet(flow_num, pkt_num, &ip_packet))
+	{
+		goto error;
+	}
+
+	/* compress the packet without arrival time */
+	status = rohc_compress4(comp, ip_packet, &rohc_packet);
+	if(status != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "failed to compress packet #%zu of flow #%zu\n",
+		        pkt_num + 1, flow_num);
+		goto error;
+	}
+	info.version_major = 0;
+	info.version_minor = 0;
+	if(!rohc_comp_get_last_packet_info2(comp, &info))
+	{
+		fprintf(stderr, "failed to get compression info for packet #%zu of "
+		        "flow #%zu\n", pkt_num + 1, flow_num);
+		goto error;
+	}
+	if(info.profile_id != exp_profile_id)
+	{
+		fprintf(stderr, "packet #%zu of flow #%zu was compressed with profile "
+		        "0x%04x instead of profile 0x%04x\n", pkt_num + 1, flow_num,
+		        info.profile_id, exp_profile_id);
+		goto error;
+	}
+	*cid = info.context_id;
+
+	/* decompress the packet and check it */
+	status = rohc_decompress3(decomp, rohc_packet, &uncomp_packet, NULL, NULL);
+	if(status != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "failed to decompress packet #%zu of flow #%zu\n",
+		        pkt_num + 1, flow_num);
+		goto error;
+	}
+	if(uncomp_packet.len != ip_packet.len ||
+	   memcmp(rohc_buf_data(uncomp_packet), rohc_buf_data(ip_packet),
+	          ip_packet.len) != 0)
+	{
+		fprintf(stderr, "packet #%zu of flow #%zu was not decompressed "
+		        "correctly\n", pkt_num + 1, flow_num);
+		goto error;
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Callback to print traces of the ROHC library
+ *
+ * @param priv_ctxt  An optional private context, may be NULL
+ * @param level      The priority level of the trace
+ * @param entity     The entity that emitted the trace among:
+ *                    \li ROHC_TRACE_COMP
+ *                    \li ROHC_TRACE_DECOMP
+ * @param profile    The ID of the ROHC compression/decompression profile
+ *                   the trace is related to
+ * @param format     The format string of the trace
+ */
+static void print_rohc_traces(void *const priv_ctxt,
+                              const rohc_trace_level_t level,
+                              const rohc_trace_entity_t entity,
+                              const int profile,
+                              const char *const format,
+                              ...)
+{
+	va_list args;
+
+	if(level >= ROHC_TRACE_WARNING)
+	{
+		va_start(args, format);
+		vfprintf(stdout, format, args);
+		va_end(args);
+	}
+}
+
+
+/**
+ * @brief Generate a false random number for testing the ROHC library
+ *
+ * @param comp          The ROHC compressor
+ * @param user_context  Should always be NULL
+ * @return              Always 0
+ */
+static int gen_false_random_num(const struct rohc_comp *const comp,
+                                void *const user_context)
+{
+	return 0;
+}
@@ -0,0 +1,539 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_ctxt_eviction.c
+ * @brief  Check the contexts that the compressor recycles for new flows
+ * @author agent <agent@local>
+ *
+ * The compressor has 4 contexts only. The application compresses more flows
+ * than that and checks the context that every new flow recycles:
+ *  - the least recently used one with the LRU policy,
+ *  - the least recently used one among the contexts of short flows with the
+ *    SLRU policy,
+ *  - the one with the lowest priority first,
+ *  - no pinned context as long as the Uncompressed context may be shared,
+ *  - the least recently used pinned context otherwise.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/udp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The MAX_CID of the channel: 4 contexts only */
+#define TEST_MAX_CID  3U
+
+/** An IP protocol that no specific profile accepts */
+#define TEST_OTHER_PROTO  253U
+
+/** The number of packets that protect a context with the SLRU policy */
+#define TEST_SLRU_PROTECTED_PKTS  16U
+
+
+/** One flow of IPv4 packets */
+struct test_flow
+{
+	uint8_t protocol;  /**< The IP protocol of the flow */
+	uint16_t port;     /**< The UDP source port of the flow */
+	size_t pkts_nr;    /**< The number of packets of the flow sent so far */
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_ctxt_eviction_policy(const rohc_comp_eviction_t policy);
+static int test_ctxt_eviction_prio(void);
+static int test_ctxt_eviction_pinned(void);
+static bool create_channel(struct test_channel *const channel)
+	__attribute__((warn_unused_result, nonnull(1)));
+static bool build_packet(const struct test_flow *const flow,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
+static bool transmit(struct test_channel *const channel,
+                     struct test_flow *const flow,
+                     const size_t pkts_nr,
+                     const rohc_cid_t exp_cid,
+                     const int exp_profile_id,
+                     const bool exp_new_ctxt)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
+
+
+/**
+ * @brief Check the contexts that the compressor recycles for new flows
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	status = test_ctxt_eviction_policy(ROHC_COMP_EVICTION_LRU);
+	if(status == 0)
+	{
+		status = test_ctxt_eviction_policy(ROHC_COMP_EVICTION_SLRU);
+	}
+	if(status == 0)
+	{
+		status = test_ctxt_eviction_prio();
+	}
+	if(status == 0)
+	{
+		status = test_ctxt_eviction_pinned();
+	}
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the contexts that the compressor recycles for new flows\n"
+	        "\n"
+	        "usage: test_ctxt_eviction [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Check the context that the LRU or SLRU policy recycles
+ *
+ * One long flow and 3 short flows use the 4 contexts, the long flow is the
+ * least recently used one. The LRU policy recycles the context of the long
+ * flow, the SLRU policy the least recently used context of the short flows.
+ *
+ * @param policy  The eviction policy to check
+ * @return        0 in case of success,
+ *                1 in case of failure
+ */
+static int test_ctxt_eviction_policy(const rohc_comp_eviction_t policy)
+{
+	struct test_flow flows[TEST_MAX_CID + 2];
+	const rohc_cid_t exp_cid = (policy == ROHC_COMP_EVICTION_LRU ? 0 : 1);
+	struct test_channel channel;
+	rohc_cid_t cid;
+	int is_failure = 1;
+
+	if(!create_channel(&channel))
+	{
+		goto error;
+	}
+	if(!rohc_comp_set_ctxt_eviction(channel.comp, policy))
+	{
+		fprintf(stderr, "failed to set the eviction policy\n");
+		goto free_channel;
+	}
+
+	/* one long flow, then 3 short flows, each one in its own context */
+	for(cid = 0; cid <= (TEST_MAX_CID + 1); cid++)
+	{
+		flows[cid].protocol = ROHC_IPPROTO_UDP;
+		flows[cid].port = 1000 + cid;
+		flows[cid].pkts_nr = 0;
+	}
+	if(!transmit(&channel, &flows[0], TEST_SLRU_PROTECTED_PKTS, 0,
+	             ROHC_PROFILE_UDP, true))
+	{
+		goto free_channel;
+	}
+	for(cid = 1; cid <= TEST_MAX_CID; cid++)
+	{
+		if(!transmit(&channel, &flows[cid], 1, cid, ROHC_PROFILE_UDP, true))
+		{
+			goto free_channel;
+		}
+	}
+	for(cid = 1; cid <= TEST_MAX_CID; cid++)
+	{
+		if(!transmit(&channel, &flows[cid], 1, cid, ROHC_PROFILE_UDP, false))
+		{
+			goto free_channel;
+		}
+	}
+
+	/* the new flow recycles the context selected by the policy */
+	if(!transmit(&channel, &flows[TEST_MAX_CID + 1], 1, exp_cid,
+	             ROHC_PROFILE_UDP, true))
+	{
+		goto free_channel;
+	}
+	fprintf(stderr, "%s policy: new flow recycled context with CID %zu\n",
+	        (policy == ROHC_COMP_EVICTION_LRU ? "LRU" : "SLRU"), exp_cid);
+
+	is_failure = 0;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Check that the contexts with the lowest priority are recycled first
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_ctxt_eviction_prio(void)
+{
+	struct test_flow flows[TEST_MAX_CID + 3];
+	struct test_channel channel;
+	rohc_cid_t cid;
+	int is_failure = 1;
+
+	if(!create_channel(&channel))
+	{
+		goto error;
+	}
+
+	/* 4 flows, each one in its own context */
+	for(cid = 0; cid <= (TEST_MAX_CID + 2); cid++)
+	{
+		flows[cid].protocol = ROHC_IPPROTO_UDP;
+		flows[cid].port = 2000 + cid;
+		flows[cid].pkts_nr = 0;
+	}
+	for(cid = 0; cid <= TEST_MAX_CID; cid++)
+	{
+		if(!transmit(&channel, &flows[cid], 1, cid, ROHC_PROFILE_UDP, true))
+		{
+			goto free_channel;
+		}
+	}
+
+	/* the least recently used flow gets a high priority, the most recently
+	 * used one a low priority */
+	if(!rohc_comp_set_ctxt_prio(channel.comp, 0, ROHC_COMP_CTXT_PRIO_HIGH) ||
+	   !rohc_comp_set_ctxt_prio(channel.comp, TEST_MAX_CID,
+	                            ROHC_COMP_CTXT_PRIO_LOW))
+	{
+		fprintf(stderr, "failed to set the priorities of the contexts\n");
+		goto free_channel;
+	}
+
+	/* the first new flow recycles the context with the low priority, the
+	 * second one the least recently used context with the normal priority */
+	if(!transmit(&channel, &flows[TEST_MAX_CID + 1], 1, TEST_MAX_CID,
+	             ROHC_PROFILE_UDP, true) ||
+	   !transmit(&channel, &flows[TEST_MAX_CID + 2], 1, 1,
+	             ROHC_PROFILE_UDP, true))
+	{
+		goto free_channel;
+	}
+
+	/* the flow with the high priority kept its context */
+	if(!transmit(&channel, &flows[0], 1, 0, ROHC_PROFILE_UDP, false))
+	{
+		goto free_channel;
+	}
+	fprintf(stderr, "priorities: low priority recycled first, high priority "
+	        "kept\n");
+
+	is_failure = 0;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Check the contexts that new flows use once all contexts are pinned
+ *
+ * New flows share the pinned Uncompressed context rather than recycling one
+ * of the pinned contexts. Once the Uncompressed profile is disabled, the
+ * least recently used pinned context is recycled.
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_ctxt_eviction_pinned(void)
+{
+	struct test_flow flows[TEST_MAX_CID + 3];
+	struct test_channel channel;
+	rohc_cid_t cid;
+	int is_failure = 1;
+
+	if(!create_channel(&channel))
+	{
+		goto error;
+	}
+
+	/* 3 UDP flows and one flow that only the Uncompressed profile accepts,
+	 * each one in its own pinned context */
+	for(cid = 0; cid <= (TEST_MAX_CID + 2); cid++)
+	{
+		flows[cid].protocol = ROHC_IPPROTO_UDP;
+		flows[cid].port = 3000 + cid;
+		flows[cid].pkts_nr = 0;
+	}
+	flows[TEST_MAX_CID].protocol = TEST_OTHER_PROTO;
+	for(cid = 0; cid <= TEST_MAX_CID; cid++)
+	{
+		const int exp_profile_id =
+			(cid == TEST_MAX_CID ? ROHC_PROFILE_UNCOMPRESSED : ROHC_PROFILE_UDP);
+
+		if(!transmit(&channel, &flows[cid], 1, cid, exp_profile_id, true))
+		{
+			goto free_channel;
+		}
+		if(!rohc_comp_set_ctxt_prio(channel.comp, cid,
+		                            ROHC_COMP_CTXT_PRIO_PINNED))
+		{
+			fprintf(stderr, "failed to pin the context with CID %zu\n", cid);
+			goto free_channel;
+		}
+	}
+
+	/* the new flow shares the Uncompressed context */
+	if(!transmit(&channel, &flows[TEST_MAX_CID + 1], 5, TEST_MAX_CID,
+	             ROHC_PROFILE_UNCOMPRESSED, false))
+	{
+		goto free_channel;
+	}
+
+	/* the pinned UDP flows kept their contexts */
+	for(cid = 0; cid < TEST_MAX_CID; cid++)
+	{
+		if(!transmit(&channel, &flows[cid], 1, cid, ROHC_PROFILE_UDP, false))
+		{
+			goto free_channel;
+		}
+	}
+	fprintf(stderr, "all contexts pinned: new flow shares the Uncompressed "
+	        "context\n");
+
+	/* without the Uncompressed profile, the new flow recycles the least
+	 * recently used pinned context */
+	if(!rohc_comp_disable_profile(channel.comp, ROHC_PROFILE_UNCOMPRESSED))
+	{
+		fprintf(stderr, "failed to disable the Uncompressed profile\n");
+		goto free_channel;
+	}
+	if(!transmit(&channel, &flows[TEST_MAX_CID + 2], 1, TEST_MAX_CID,
+	             ROHC_PROFILE_UDP, true))
+	{
+		goto free_channel;
+	}
+	fprintf(stderr, "all contexts pinned, no Uncompressed profile: new flow "
+	        "recycled the least recently used pinned context\n");
+
+	is_failure = 0;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Create a channel with 4 contexts, the UDP and Uncompressed profiles
+ *
+ * @param[out] channel  The channel to create
+ * @return              true if the channel was created, false otherwise
+ */
+static bool create_channel(struct test_channel *const channel)
+{
+	if(!test_channel_new(channel, ROHC_SMALL_CID, TEST_MAX_CID, ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_enable_profile(channel, ROHC_PROFILE_UNCOMPRESSED) ||
+	   !test_channel_enable_profile(channel, ROHC_PROFILE_UDP))
+	{
+		goto free_channel;
+	}
+	return true;
+
+free_channel:
+	test_channel_free(channel);
+error:
+	return false;
+}
+
+
+/**
+ * @brief Build the next packet of the given flow
+ *
+ * @param flow            The flow
+ * @param[out] ip_packet  The IPv4 packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const struct test_flow *const flow,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t payload_len = 28;
+	const size_t ip_len = sizeof(struct ipv4_hdr) + payload_len;
+	struct ipv4_hdr *ip_header;
+	uint32_t csum = 0;
+	size_t i;
+
+	if(ip_packet->max_len < ip_len)
+	{
+		fprintf(stderr, "buffer too small for packet\n");
+		return false;
+	}
+
+	/* generate the IPv4 header with a sequential IP-ID */
+	ip_packet->len = ip_len;
+	memset(rohc_buf_data(*ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(*ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + flow->pkts_nr);
+	ip_header->ttl = 64;
+	ip_header->protocol = flow->protocol;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(*ip_packet, i) << 8) |
+		        rohc_buf_byte_at(*ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* generate the payload, a UDP header first for UDP flows */
+	for(i = sizeof(struct ipv4_hdr); i < ip_len; i++)
+	{
+		rohc_buf_byte_at(*ip_packet, i) = (i + flow->pkts_nr) & 0xff;
+	}
+	if(flow->protocol == ROHC_IPPROTO_UDP)
+	{
+		struct udphdr *const udp_header = (struct udphdr *) (ip_header + 1);
+		udp_header->source = htons(flow->port);
+		udp_header->dest = htons(1234);
+		udp_header->len = htons(payload_len);
+		udp_header->check = 0;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Compress and decompress the next packets of the given flow
+ *
+ * @param channel         The ROHC channel
+ * @param flow            The flow
+ * @param pkts_nr         The number of packets to compress
+ * @param exp_cid         The CID expected for the packets
+ * @param exp_profile_id  The profile expected for the packets
+ * @param exp_new_ctxt    Whether the first packet shall create a context
+ * @return                true if the packets were compressed as expected
+ *                        and decompressed correctly, false otherwise
+ */
+static bool transmit(struct test_channel *const channel,
+                     struct test_flow *const flow,
+                     const size_t pkts_nr,
+                     const rohc_cid_t exp_cid,
+                     const int exp_profile_id,
+                     const bool exp_new_ctxt)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	rohc_comp_last_packet_info2_t info;
+	size_t i;
+
+	for(i = 0; i < pkts_nr; i++, flow->pkts_nr++)
+	{
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+		const bool exp_init = (exp_new_ctxt && i == 0);
+
+		if(!build_packet(flow, &ip_packet))
+		{
+			goto error;
+		}
+		if(!test_channel_transmit(channel, flow->pkts_nr, ip_packet,
+		                          &rohc_packet, &info))
+		{
+			goto error;
+		}
+		if(info.context_id != exp_cid || info.profile_id != exp_profile_id ||
+		   info.is_context_init != exp_init)
+		{
+			fprintf(stderr, "packet #%zu of flow with port %u was compressed "
+			        "in %s context with CID %u and profile 0x%04x instead of "
+			        "%s context with CID %zu and profile 0x%04x\n",
+			        flow->pkts_nr + 1, flow->port,
+			        (info.is_context_init ? "new" : "existing"),
+			        info.context_id, info.profile_id,
+			        (exp_init ? "new" : "existing"), exp_cid, exp_profile_id);
+			goto error;
+		}
+	}
+
+	return true;
+
+error:
+	return false;
+}
@@ -0,0 +1,374 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_ctxt_replication.c
+ * @brief  Check the selection of the base context for Context Replication
+ * @author agent <agent@local>
+ *
+ * The application compresses several TCP flows with the same or different IP
+ * addresses. A new flow shall start with an IR-CR packet only if an
+ * established context in bi-directional mode with the same IP addresses is
+ * still available, with an IR packet otherwise. All packets shall be
+ * decompressed correctly.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/tcp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The number of packets to establish a context */
+#define TEST_ESTABLISH_PKTS_NR  20U
+
+
+/* prototypes of private functions */
+static void usage(void);
+static bool test_ctxt_replication(const rohc_cid_t max_cid,
+                                  const bool with_feedback,
+                                  const uint32_t saddr_b,
+                                  const uint32_t saddr_c,
+                                  const uint32_t saddr_d,
+                                  const rohc_packet_t exp_packet_type)
+	__attribute__((warn_unused_result));
+static bool build_packet(const uint32_t saddr,
+                         const uint16_t sport,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(4)));
+static bool compress_flow(struct test_channel *const channel,
+                          const uint32_t saddr,
+                          const uint16_t sport,
+                          const size_t pkts_nr,
+                          rohc_packet_t *const first_packet_type,
+                          size_t *const first_packet_len)
+	__attribute__((warn_unused_result, nonnull(1, 5, 6)));
+
+
+/**
+ * @brief Check the selection of the base context for Context Replication
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	const uint32_t addr_x = 0xc0a80001;
+	const uint32_t addr_y = 0xc0a80101;
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	/* a 2nd flow with the same addresses is replicated from the 1st flow */
+	fprintf(stderr, "flow with the same addresses as an established flow:\n");
+	if(!test_ctxt_replication(15, true, addr_x, addr_y, addr_y,
+	                          ROHC_PACKET_IR_CR))
+	{
+		goto error;
+	}
+
+	/* no replication without feedback: the 1st flow is not established in
+	 * bi-directional mode */
+	fprintf(stderr, "flow with the same addresses as an established flow, "
+	        "without feedback:\n");
+	if(!test_ctxt_replication(15, false, addr_x, addr_y, addr_y,
+	                          ROHC_PACKET_IR))
+	{
+		goto error;
+	}
+
+	/* no replication once the context of the flows with the same addresses
+	 * was recycled for flows with other addresses */
+	fprintf(stderr, "flow with the same addresses as a recycled flow:\n");
+	if(!test_ctxt_replication(1, true, addr_y, addr_y, addr_x,
+	                          ROHC_PACKET_IR))
+	{
+		goto error;
+	}
+
+	status = 0;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the selection of the base context for Context Replication\n"
+	        "\n"
+	        "usage: test_ctxt_replication [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Compress 4 TCP flows and check how the 4th one starts
+ *
+ * Flow #1 uses the source address 192.168.0.1, flows #2 and #3 the given
+ * source addresses. Flow #4 uses the source address of flow #1 with another
+ * source port.
+ *
+ * @param max_cid          The MAX_CID of the ROHC channel
+ * @param with_feedback    Whether the feedback of the decompressor is
+ *                         delivered to the compressor
+ * @param saddr_b          The source address of flow #2
+ * @param saddr_c          The source address of flow #3
+ * @param saddr_d          The source address of flow #4
+ * @param exp_packet_type  The type of the first packet of flow #4
+ * @return                 true if the test succeeded, false otherwise
+ */
+static bool test_ctxt_replication(const rohc_cid_t max_cid,
+                                  const bool with_feedback,
+                                  const uint32_t saddr_b,
+                                  const uint32_t saddr_c,
+                                  const uint32_t saddr_d,
+                                  const rohc_packet_t exp_packet_type)
+{
+	const uint32_t saddr_a = 0xc0a80001;
+	struct test_channel channel;
+	rohc_packet_t packet_type;
+	size_t ir_len;
+	size_t packet_len;
+	bool is_success = false;
+
+	/* create the ROHC compressor and decompressor in bi-directional mode */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, max_cid, ROHC_O_MODE))
+	{
+		goto error;
+	}
+	channel.with_feedback = with_feedback;
+	if(!test_channel_enable_profile(&channel, ROHC_PROFILE_TCP))
+	{
+		goto free_channel;
+	}
+
+	/* establish 3 flows */
+	if(!compress_flow(&channel, saddr_a, 1000, TEST_ESTABLISH_PKTS_NR,
+	                  &packet_type, &ir_len))
+	{
+		goto free_channel;
+	}
+	if(packet_type != ROHC_PACKET_IR)
+	{
+		fprintf(stderr, "flow #1 did not start with an IR packet\n");
+		goto free_channel;
+	}
+	if(!compress_flow(&channel, saddr_b, 1001, TEST_ESTABLISH_PKTS_NR,
+	                  &packet_type, &packet_len) ||
+	   !compress_flow(&channel, saddr_c, 1002, TEST_ESTABLISH_PKTS_NR,
+	                  &packet_type, &packet_len))
+	{
+		goto free_channel;
+	}
+
+	/* how does the 4th flow start? */
+	if(!compress_flow(&channel, saddr_d, 1003, TEST_ESTABLISH_PKTS_NR,
+	                  &packet_type, &packet_len))
+	{
+		goto free_channel;
+	}
+	fprintf(stderr, "\tflow #4 started with a %zu-byte %s packet (IR packet "
+	        "of flow #1 was %zu bytes)\n", packet_len,
+	        rohc_get_packet_descr(packet_type), ir_len);
+	if(packet_type != exp_packet_type)
+	{
+		fprintf(stderr, "\tflow #4 shall have started with a %s packet\n",
+		        rohc_get_packet_descr(exp_packet_type));
+		goto free_channel;
+	}
+	if(packet_type == ROHC_PACKET_IR_CR && packet_len >= ir_len)
+	{
+		fprintf(stderr, "\tIR-CR packet shall be smaller than IR packet\n");
+		goto free_channel;
+	}
+
+	is_success = true;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_success;
+}
+
+
+/**
+ * @brief Build the given packet of the given IPv4/TCP flow
+ *
+ * @param saddr           The IPv4 source address of the flow
+ * @param sport           The TCP source port of the flow
+ * @param pkt_num         The number of the packet in the IPv4/TCP flow
+ * @param[out] ip_packet  The IPv4/TCP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const uint32_t saddr,
+                         const uint16_t sport,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t payload_len = 100;
+	const size_t ip_len =
+		sizeof(struct ipv4_hdr) + sizeof(struct tcphdr) + payload_len;
+	struct ipv4_hdr *ip_header;
+	struct tcphdr *tcp_header;
+	uint32_t csum = 0;
+	size_t i;
+
+	if(ip_packet->max_len < ip_len)
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+
+	/* generate the IPv4 header with a sequential IP-ID */
+	ip_packet->len = ip_len;
+	memset(rohc_buf_data(*ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(*ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + pkt_num);
+	ip_header->df = 1;
+	ip_header->ttl = 64;
+	ip_header->protocol = ROHC_IPPROTO_TCP;
+	ip_header->saddr = htonl(saddr);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(*ip_packet, i) << 8) |
+		        rohc_buf_byte_at(*ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* generate the TCP header of a bulk transfer and its payload */
+	tcp_header = (struct tcphdr *) (ip_header + 1);
+	tcp_header->src_port = htons(sport);
+	tcp_header->dst_port = htons(80);
+	tcp_header->seq_num = htonl(0x10000000 + pkt_num * payload_len);
+	tcp_header->ack_num = htonl(0x20000000);
+	tcp_header->data_offset = sizeof(struct tcphdr) / 4;
+	tcp_header->ack_flag = 1;
+	tcp_header->window = htons(8000);
+	tcp_header->checksum = htons(0x1234 + pkt_num);
+	for(i = ip_len - payload_len; i < ip_len; i++)
+	{
+		rohc_buf_byte_at(*ip_packet, i) = (i + pkt_num) & 0xff;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Compress and decompress the packets of the given IPv4/TCP flow
+ *
+ * @param channel                 The compressor and decompressor
+ * @param saddr                   The IPv4 source address of the flow
+ * @param sport                   The TCP source port of the flow
+ * @param pkts_nr                 The number of packets to compress
+ * @param[out] first_packet_type  The type of the first ROHC packet
+ * @param[out] first_packet_len   The length of the first ROHC packet
+ * @return                        true if the packets were compressed and
+ *                                decompressed correctly, false otherwise
+ */
+static bool compress_flow(struct test_channel *const channel,
+                          const uint32_t saddr,
+                          const uint16_t sport,
+                          const size_t pkts_nr,
+                          rohc_packet_t *const first_packet_type,
+                          size_t *const first_packet_len)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	rohc_comp_last_packet_info2_t info;
+	size_t pkt_num;
+
+	for(pkt_num = 0; pkt_num < pkts_nr; pkt_num++)
+	{
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+		if(!build_packet(saddr, sport, pkt_num, &ip_packet))
+		{
+			goto error;
+		}
+
+		if(!test_channel_transmit(channel, pkt_num, ip_packet, &rohc_packet,
+		                          &info))
+		{
+			fprintf(stderr, "\tflow with port %u failed\n", sport);
+			goto error;
+		}
+		if(pkt_num == 0)
+		{
+			*first_packet_type = info.packet_type;
+			*first_packet_len = rohc_packet.len;
+		}
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
@@ -0,0 +1,465 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_decomp_sharding.c
+ * @brief  Check the dispatch of one ROHC channel among several decompressors
+ * @author agent <agent@local>
+ *
+ * One compressor compresses many UDP flows on one ROHC channel. The
+ * application dispatches the ROHC packets among 3 decompressors in O-mode
+ * as a multi-threaded receiver would do, without the threads:
+ *  \li the dispatcher gets the CID of every ROHC packet with
+ *      rohc_decomp_get_cid() and checks it against the CID that the
+ *      compressor used,
+ *  \li every decompressor owns a disjoint range of CIDs and receives the
+ *      packets of its CIDs in order, so it decompresses all of them,
+ *  \li the feedback of all the decompressors is merged in one outbox that
+ *      is delivered to the compressor, so every context of the compressor
+ *      switches to O-mode.
+ *
+ * The test runs with small CIDs (Add-CID octet) and large CIDs (SDVL-encoded
+ * on 1 or 2 bytes).
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/udp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The max size of the feedback outbox shared by the decompressors */
+#define TEST_OUTBOX_SIZE  4096U
+
+/** The number of decompressors the ROHC channel is dispatched among */
+#define TEST_WORKERS_NR  3U
+
+/** The number of rounds of packets, one packet of every flow per round */
+#define TEST_ROUNDS_NR  6U
+
+
+/** One compressor and the decompressors that share its ROHC channel */
+struct test_sharding
+{
+	struct rohc_comp *comp;                        /**< The compressor */
+	struct rohc_decomp *workers[TEST_WORKERS_NR];  /**< The decompressors */
+	rohc_cid_t max_cid;                            /**< The MAX_CID */
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_decomp_sharding(const rohc_cid_type_t cid_type,
+                                const rohc_cid_t max_cid,
+                                const size_t flows_nr);
+static bool create_sharding(struct test_sharding *const sharding,
+                            const rohc_cid_type_t cid_type,
+                            const rohc_cid_t max_cid)
+	__attribute__((warn_unused_result, nonnull(1)));
+static void free_sharding(struct test_sharding *const sharding)
+	__attribute__((nonnull(1)));
+static size_t dispatch(const struct test_sharding *const sharding,
+                       const rohc_cid_t cid)
+	__attribute__((warn_unused_result, nonnull(1)));
+static bool build_packet(const uint16_t port,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(3)));
+
+
+/**
+ * @brief Check the dispatch of one ROHC channel among several decompressors
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	/* small CIDs: all the contexts of the channel are used */
+	status = test_decomp_sharding(ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                              ROHC_SMALL_CID_MAX + 1);
+	if(status == 0)
+	{
+		/* large CIDs: CIDs above 127 are SDVL-encoded on 2 bytes */
+		status = test_decomp_sharding(ROHC_LARGE_CID, 199, 140);
+	}
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the dispatch of one ROHC channel among several "
+	        "decompressors\n"
+	        "\n"
+	        "usage: test_decomp_sharding [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Dispatch the packets of many flows among the decompressors
+ *
+ * @param cid_type  The CID type of the ROHC channel
+ * @param max_cid   The MAX_CID of the ROHC channel
+ * @param flows_nr  The number of flows, one context each
+ * @return          0 in case of success,
+ *                  1 in case of failure
+ */
+static int test_decomp_sharding(const rohc_cid_type_t cid_type,
+                                const rohc_cid_t max_cid,
+                                const size_t flows_nr)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t decomp_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t outbox_buffer[TEST_OUTBOX_SIZE];
+	struct rohc_buf outbox = rohc_buf_init_empty(outbox_buffer, TEST_OUTBOX_SIZE);
+	size_t worker_pkts_nr[TEST_WORKERS_NR] = { 0 };
+	struct test_sharding sharding;
+	size_t round;
+	size_t i;
+	int is_failure = 1;
+
+	fprintf(stderr, "dispatch %zu flows with %s CIDs among %u decompressors\n",
+	        flows_nr, cid_type == ROHC_SMALL_CID ? "small" : "large",
+	        TEST_WORKERS_NR);
+
+	if(!create_sharding(&sharding, cid_type, max_cid))
+	{
+		goto error;
+	}
+
+	for(round = 0; round < TEST_ROUNDS_NR; round++)
+	{
+		for(i = 0; i < flows_nr; i++)
+		{
+			struct rohc_buf ip_packet =
+				rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+			struct rohc_buf rohc_packet =
+				rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+			struct rohc_buf decomp_packet =
+				rohc_buf_init_empty(decomp_buffer, TEST_MAX_PKT_SIZE);
+			struct rohc_buf feedback_send =
+				rohc_buf_init_empty(rohc_buf_data_at(outbox, outbox.len),
+				                    TEST_OUTBOX_SIZE - outbox.len);
+			rohc_comp_last_packet_info2_t info;
+			rohc_cid_t cid;
+			size_t worker;
+
+			/* compress the next packet of the flow */
+			if(!build_packet(1000 + i, round, &ip_packet) ||
+			   rohc_compress4(sharding.comp, ip_packet, &rohc_packet) !=
+			   ROHC_STATUS_OK)
+			{
+				fprintf(stderr, "failed to compress packet #%zu of flow #%zu\n",
+				        round + 1, i + 1);
+				goto free_sharding;
+			}
+			info.version_major = 0;
+			info.version_minor = 0;
+			if(!rohc_comp_get_last_packet_info2(sharding.comp, &info))
+			{
+				fprintf(stderr, "failed to get compression info\n");
+				goto free_sharding;
+			}
+			if(round == (TEST_ROUNDS_NR - 1) && info.context_mode != ROHC_O_MODE)
+			{
+				fprintf(stderr, "the feedback for flow #%zu did not reach the "
+				        "compressor: context still in mode %d\n", i + 1,
+				        info.context_mode);
+				goto free_sharding;
+			}
+
+			/* the dispatcher may get the CID with any decompressor */
+			if(rohc_decomp_get_cid(sharding.workers[round % TEST_WORKERS_NR],
+			                       rohc_packet, &cid) != ROHC_STATUS_OK)
+			{
+				fprintf(stderr, "failed to get the CID of packet #%zu of flow "
+				        "#%zu\n", round + 1, i + 1);
+				goto free_sharding;
+			}
+			if(cid != info.context_id)
+			{
+				fprintf(stderr, "CID %zu found in packet #%zu of flow #%zu, CID %u "
+				        "expected\n", cid, round + 1, i + 1, info.context_id);
+				goto free_sharding;
+			}
+
+			/* the decompressor that owns the CID decompresses the packet and
+			 * writes its feedback at the end of the shared outbox */
+			worker = dispatch(&sharding, cid);
+			if(rohc_decompress3(sharding.workers[worker], rohc_packet,
+			                    &decomp_packet, NULL, &feedback_send) !=
+			   ROHC_STATUS_OK)
+			{
+				fprintf(stderr, "decompressor #%zu failed to decompress packet "
+				        "#%zu of flow #%zu with CID %zu\n", worker + 1, round + 1,
+				        i + 1, cid);
+				goto free_sharding;
+			}
+			if(decomp_packet.len != ip_packet.len ||
+			   memcmp(rohc_buf_data(decomp_packet), rohc_buf_data(ip_packet),
+			          ip_packet.len) != 0)
+			{
+				fprintf(stderr, "packet #%zu of flow #%zu was not decompressed "
+				        "correctly\n", round + 1, i + 1);
+				goto free_sharding;
+			}
+			outbox.len += feedback_send.len;
+			worker_pkts_nr[worker]++;
+		}
+
+		/* deliver the feedback of all the decompressors at once */
+		if(!rohc_comp_deliver_feedback2(sharding.comp, outbox))
+		{
+			fprintf(stderr, "failed to deliver the %zu bytes of the feedback "
+			        "outbox\n", outbox.len);
+			goto free_sharding;
+		}
+		rohc_buf_reset(&outbox);
+	}
+
+	/* every decompressor had its share of the channel */
+	for(i = 0; i < TEST_WORKERS_NR; i++)
+	{
+		fprintf(stderr, "\tdecompressor #%zu decompressed %zu packets\n", i + 1,
+		        worker_pkts_nr[i]);
+		if(worker_pkts_nr[i] == 0)
+		{
+			fprintf(stderr, "decompressor #%zu got no packet\n", i + 1);
+			goto free_sharding;
+		}
+	}
+
+	is_failure = 0;
+
+free_sharding:
+	free_sharding(&sharding);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Create one compressor and the decompressors that share its channel
+ *
+ * All the decompressors are created with the CID type and the MAX_CID of
+ * the ROHC channel.
+ *
+ * @param[out] sharding  The compressor and the decompressors
+ * @param cid_type       The CID type of the ROHC channel
+ * @param max_cid        The MAX_CID of the ROHC channel
+ * @return               true if created successfully, false otherwise
+ */
+static bool create_sharding(struct test_sharding *const sharding,
+                            const rohc_cid_type_t cid_type,
+                            const rohc_cid_t max_cid)
+{
+	size_t i;
+
+	sharding->max_cid = max_cid;
+	sharding->comp = rohc_comp_new2(cid_type, max_cid, test_gen_false_random_num,
+	                                NULL);
+	if(sharding->comp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC compressor\n");
+		goto error;
+	}
+	if(!rohc_comp_set_traces_cb2(sharding->comp, test_print_rohc_traces, NULL) ||
+	   !rohc_comp_enable_profile(sharding->comp, ROHC_PROFILE_UDP))
+	{
+		fprintf(stderr, "failed to configure the ROHC compressor\n");
+		goto free_comp;
+	}
+
+	for(i = 0; i < TEST_WORKERS_NR; i++)
+	{
+		sharding->workers[i] = rohc_decomp_new2(cid_type, max_cid, ROHC_O_MODE);
+		if(sharding->workers[i] == NULL)
+		{
+			fprintf(stderr, "failed to create ROHC decompressor #%zu\n", i + 1);
+			goto free_workers;
+		}
+		if(!rohc_decomp_set_traces_cb2(sharding->workers[i],
+		                               test_print_rohc_traces, NULL) ||
+		   !rohc_decomp_enable_profile(sharding->workers[i], ROHC_PROFILE_UDP))
+		{
+			fprintf(stderr, "failed to configure ROHC decompressor #%zu\n",
+			        i + 1);
+			rohc_decomp_free(sharding->workers[i]);
+			goto free_workers;
+		}
+	}
+
+	return true;
+
+free_workers:
+	while(i > 0)
+	{
+		i--;
+		rohc_decomp_free(sharding->workers[i]);
+	}
+free_comp:
+	rohc_comp_free(sharding->comp);
+error:
+	return false;
+}
+
+
+/**
+ * @brief Destroy the compressor and the decompressors
+ *
+ * @param sharding  The compressor and the decompressors
+ */
+static void free_sharding(struct test_sharding *const sharding)
+{
+	size_t i;
+
+	for(i = 0; i < TEST_WORKERS_NR; i++)
+	{
+		rohc_decomp_free(sharding->workers[i]);
+	}
+	rohc_comp_free(sharding->comp);
+}
+
+
+/**
+ * @brief Get the decompressor that owns the given CID
+ *
+ * The CIDs of the channel are split in disjoint ranges of consecutive CIDs,
+ * one range per decompressor.
+ *
+ * @param sharding  The compressor and the decompressors
+ * @param cid       The CID of the ROHC packet
+ * @return          The index of the decompressor
+ */
+static size_t dispatch(const struct test_sharding *const sharding,
+                       const rohc_cid_t cid)
+{
+	return (cid * TEST_WORKERS_NR) / (sharding->max_cid + 1);
+}
+
+
+/**
+ * @brief Build one packet of one UDP flow
+ *
+ * @param port            The UDP source port of the flow
+ * @param pkt_num         The number of the packet in the flow
+ * @param[out] ip_packet  The IPv4/UDP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const uint16_t port,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t payload_len = 28;
+	const size_t ip_len = sizeof(struct ipv4_hdr) + payload_len;
+	struct ipv4_hdr *ip_header;
+	struct udphdr *udp_header;
+	uint32_t csum = 0;
+	size_t i;
+
+	if(ip_packet->max_len < ip_len)
+	{
+		fprintf(stderr, "buffer too small for packet\n");
+		return false;
+	}
+
+	/* generate the IPv4 header with a sequential IP-ID */
+	ip_packet->len = ip_len;
+	memset(rohc_buf_data(*ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(*ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + pkt_num);
+	ip_header->ttl = 64;
+	ip_header->protocol = ROHC_IPPROTO_UDP;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(*ip_packet, i) << 8) |
+		        rohc_buf_byte_at(*ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* generate the UDP header and the payload */
+	for(i = sizeof(struct ipv4_hdr); i < ip_len; i++)
+	{
+		rohc_buf_byte_at(*ip_packet, i) = (i + pkt_num) & 0xff;
+	}
+	udp_header = (struct udphdr *) (ip_header + 1);
+	udp_header->source = htons(port);
+	udp_header->dest = htons(1234);
+	udp_header->len = htons(payload_len);
+	udp_header->check = 0;
+
+	return true;
+}
+
@@ -0,0 +1,856 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_ext_selection.c
+ * @brief  Check the packet types and extensions of the RFC3095 profiles
+ * @author agent <agent@local>
+ *
+ * The application compresses IP/UDP and IP/UDP/RTP flows with one or two IP
+ * headers. The IP-ID, RTP SN and RTP TS fields jump from time to time by
+ * 2^0 up to 2^16, so that the compressor selects the UO-1*, UOR-2* and IR-DYN
+ * packets with all their extensions. The type and the header length of every
+ * ROHC packet that transmits a jump shall be the expected ones, and all
+ * packets shall be decompressed correctly.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/ipv6.h>
+#include <protocols/udp.h>
+#include <protocols/rtp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The number of packets between two jumps of the fields */
+#define TEST_JUMP_PERIOD  6U
+
+/** The largest jump of the fields is 2^TEST_JUMP_MAX_BITS */
+#define TEST_JUMP_MAX_BITS  16U
+
+/** The length of the payload of every packet */
+#define TEST_PAYLOAD_LEN  20U
+
+
+/** The IP headers of the flows */
+enum test_ip_hdrs
+{
+	TEST_IPV4,       /**< One IPv4 header */
+	TEST_IPV4_IPV4,  /**< Two IPv4 headers */
+	TEST_IPV6,       /**< One IPv6 header */
+};
+
+
+/** The jumps of the fields, every jump is done with all the sizes */
+enum test_jump
+{
+	TEST_JUMP_IP_ID,         /**< The innermost IP-ID jumps */
+	TEST_JUMP_OUTER_IP_ID,   /**< The outermost IP-ID jumps */
+	TEST_JUMP_IP_IDS,        /**< Both IP-IDs jump */
+	TEST_JUMP_SN,            /**< The RTP SN and TS jump */
+	TEST_JUMP_TS,            /**< The RTP TS jumps */
+	TEST_JUMP_SN_IP_ID,      /**< The RTP SN and TS, and the innermost IP-ID
+	                              jump */
+	TEST_JUMP_TS_IP_ID,      /**< The RTP TS and the innermost IP-ID jump */
+	TEST_JUMP_MARKER_IP_ID,  /**< The RTP Marker is set and the innermost
+	                              IP-ID jumps */
+	TEST_JUMP_MAX,
+};
+
+/** The number of jumps in every flow */
+#define TEST_JUMPS_NR  (TEST_JUMP_MAX * (TEST_JUMP_MAX_BITS + 1))
+
+/** The number of packets of every flow */
+#define TEST_PKTS_NR  ((TEST_JUMPS_NR + 1) * TEST_JUMP_PERIOD)
+
+
+/** The expected ROHC packet */
+struct test_pkt
+{
+	rohc_packet_t type;   /**< The type of the ROHC packet */
+	size_t hdr_len;       /**< The length of the ROHC header */
+};
+
+
+/** The description of one test */
+struct test_case
+{
+	const char *descr;            /**< The description of the test */
+	int profile;                  /**< The profile to compress with */
+	enum test_ip_hdrs ip_hdrs;    /**< The IP headers of the flow */
+	const struct test_pkt *pkts;  /**< The expected ROHC packets that
+	                                   transmit the jumps */
+};
+
+
+/** The varying fields of one flow */
+struct test_fields
+{
+	uint16_t ip_id_inner;  /**< The IP-ID of the innermost IPv4 header */
+	uint16_t ip_id_outer;  /**< The IP-ID of the outermost IPv4 header */
+	uint16_t sn;           /**< The RTP Sequence Number */
+	uint32_t ts;           /**< The RTP TimeStamp */
+	bool marker;           /**< The RTP Marker bit */
+};
+
+
+/** The ROHC packets that transmit the jumps of the IPv4/UDP flow */
+static const struct test_pkt test_pkts_ipv4_udp[TEST_JUMPS_NR] = {
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+};
+
+/** The ROHC packets that transmit the jumps of the IPv4/IPv4/UDP flow */
+static const struct test_pkt test_pkts_ipv4_ipv4_udp[TEST_JUMPS_NR] = {
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 7 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 7 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 7 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 7 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 7 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 }, { ROHC_PACKET_UO_1, 4 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 11 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UOR_2, 8 }, { ROHC_PACKET_UOR_2, 8 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+};
+
+/** The ROHC packets that transmit the jumps of the IPv4/UDP/RTP flow */
+static const struct test_pkt test_pkts_ipv4_rtp[TEST_JUMPS_NR] = {
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UOR_2_TS, 10 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UOR_2_TS, 10 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UOR_2_TS, 10 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UOR_2_TS, 10 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_TS, 6 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 13 }, { ROHC_PACKET_UOR_2_RTP, 9 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 14 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 14 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 14 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 14 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 14 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 14 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UOR_2_ID, 11 },
+	{ ROHC_PACKET_UOR_2_TS, 12 }, { ROHC_PACKET_UOR_2_RTP, 12 },
+	{ ROHC_PACKET_UOR_2_RTP, 14 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UOR_2_ID, 11 },
+	{ ROHC_PACKET_UOR_2_TS, 12 }, { ROHC_PACKET_UOR_2_RTP, 12 },
+	{ ROHC_PACKET_UOR_2_RTP, 15 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_IR_DYN, 20 },
+	{ ROHC_PACKET_UOR_2_TS, 12 }, { ROHC_PACKET_IR_DYN, 23 },
+	{ ROHC_PACKET_UOR_2_RTP, 15 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_IR_DYN, 20 },
+	{ ROHC_PACKET_IR_DYN, 23 }, { ROHC_PACKET_IR_DYN, 23 },
+	{ ROHC_PACKET_IR_DYN, 23 }, { ROHC_PACKET_IR_DYN, 20 },
+	{ ROHC_PACKET_IR_DYN, 20 }, { ROHC_PACKET_IR_DYN, 20 },
+	{ ROHC_PACKET_IR_DYN, 20 }, { ROHC_PACKET_IR_DYN, 23 },
+	{ ROHC_PACKET_IR_DYN, 23 }, { ROHC_PACKET_IR_DYN, 23 },
+	{ ROHC_PACKET_IR_DYN, 23 }, { ROHC_PACKET_IR_DYN, 20 },
+};
+
+/** The ROHC packets that transmit the jumps of the IPv4/IPv4/UDP/RTP flow */
+static const struct test_pkt test_pkts_ipv4_ipv4_rtp[TEST_JUMPS_NR] = {
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 12 },
+	{ ROHC_PACKET_UOR_2_TS, 10 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 12 },
+	{ ROHC_PACKET_UOR_2_TS, 10 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 12 },
+	{ ROHC_PACKET_UOR_2_TS, 10 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 12 },
+	{ ROHC_PACKET_UOR_2_TS, 10 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UO_1_ID, 4 }, { ROHC_PACKET_UO_1_ID, 10 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 13 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UO_1_ID, 11 },
+	{ ROHC_PACKET_UO_1_ID, 10 }, { ROHC_PACKET_UO_1_ID, 7 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_UO_1_ID, 13 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_ID, 12 },
+	{ ROHC_PACKET_UOR_2_TS, 14 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_UO_1_ID, 13 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 14 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_UO_1_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 14 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_UO_1_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 14 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_UO_1_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 14 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_UO_1_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 14 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_UO_1_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 11 }, { ROHC_PACKET_UOR_2_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 14 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_UOR_2_ID, 15 },
+	{ ROHC_PACKET_UOR_2_TS, 12 }, { ROHC_PACKET_UOR_2_ID, 14 },
+	{ ROHC_PACKET_UOR_2_TS, 15 }, { ROHC_PACKET_UOR_2_TS, 11 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_UOR_2_ID, 15 },
+	{ ROHC_PACKET_UOR_2_TS, 12 }, { ROHC_PACKET_UOR_2_ID, 15 },
+	{ ROHC_PACKET_UOR_2_TS, 15 }, { ROHC_PACKET_UOR_2_TS, 11 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_IR_DYN, 26 },
+	{ ROHC_PACKET_UOR_2_TS, 12 }, { ROHC_PACKET_IR_DYN, 29 },
+	{ ROHC_PACKET_UOR_2_TS, 15 }, { ROHC_PACKET_UOR_2_TS, 11 },
+	{ ROHC_PACKET_UOR_2_TS, 9 }, { ROHC_PACKET_UOR_2_TS, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 12 }, { ROHC_PACKET_IR_DYN, 26 },
+	{ ROHC_PACKET_IR_DYN, 29 }, { ROHC_PACKET_IR_DYN, 29 },
+	{ ROHC_PACKET_IR_DYN, 29 }, { ROHC_PACKET_IR_DYN, 26 },
+	{ ROHC_PACKET_IR_DYN, 26 }, { ROHC_PACKET_IR_DYN, 26 },
+	{ ROHC_PACKET_IR_DYN, 26 }, { ROHC_PACKET_IR_DYN, 29 },
+	{ ROHC_PACKET_IR_DYN, 29 }, { ROHC_PACKET_IR_DYN, 29 },
+	{ ROHC_PACKET_IR_DYN, 29 }, { ROHC_PACKET_IR_DYN, 26 },
+};
+
+/** The ROHC packets that transmit the jumps of the IPv6/UDP/RTP flow */
+static const struct test_pkt test_pkts_ipv6_rtp[TEST_JUMPS_NR] = {
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UO_1_RTP, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 10 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 10 }, { ROHC_PACKET_UO_1_RTP, 4 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UO_1_RTP, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 10 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 10 }, { ROHC_PACKET_UO_1_RTP, 4 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 5 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 5 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UO_1_RTP, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 5 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UOR_2_RTP, 6 }, { ROHC_PACKET_UOR_2_RTP, 10 },
+	{ ROHC_PACKET_UO_1_RTP, 4 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 6 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 6 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 6 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 6 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 6 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 6 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 6 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 7 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 6 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 8 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 8 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 7 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 8 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 8 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 7 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 8 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 8 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 7 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 8 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UOR_2_RTP, 11 },
+	{ ROHC_PACKET_UOR_2_RTP, 7 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UOR_2_RTP, 12 },
+	{ ROHC_PACKET_UOR_2_RTP, 9 }, { ROHC_PACKET_UOR_2_RTP, 12 },
+	{ ROHC_PACKET_UOR_2_RTP, 7 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_IR_DYN, 17 }, { ROHC_PACKET_UOR_2_RTP, 12 },
+	{ ROHC_PACKET_IR_DYN, 20 }, { ROHC_PACKET_UOR_2_RTP, 12 },
+	{ ROHC_PACKET_UOR_2_RTP, 7 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_UO_0, 3 }, { ROHC_PACKET_UO_0, 3 },
+	{ ROHC_PACKET_IR_DYN, 17 }, { ROHC_PACKET_IR_DYN, 20 },
+	{ ROHC_PACKET_IR_DYN, 20 }, { ROHC_PACKET_IR_DYN, 20 },
+	{ ROHC_PACKET_IR_DYN, 17 }, { ROHC_PACKET_IR_DYN, 17 },
+	{ ROHC_PACKET_IR_DYN, 17 }, { ROHC_PACKET_IR_DYN, 17 },
+	{ ROHC_PACKET_IR_DYN, 20 }, { ROHC_PACKET_IR_DYN, 20 },
+	{ ROHC_PACKET_IR_DYN, 20 }, { ROHC_PACKET_IR_DYN, 20 },
+	{ ROHC_PACKET_IR_DYN, 17 },
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static bool test_ext_selection(const struct test_case *const test)
+	__attribute__((warn_unused_result, nonnull(1)));
+static void update_fields(struct test_fields *const fields,
+                          const size_t pkt_num)
+	__attribute__((nonnull(1)));
+static bool build_packet(const struct test_case *const test,
+                         const struct test_fields *const fields,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(1, 2, 4)));
+static bool rtp_detect(const unsigned char *const ip,
+                       const unsigned char *const udp,
+                       const unsigned char *const payload,
+                       const unsigned int payload_size,
+                       void *const rtp_private)
+	__attribute__((warn_unused_result));
+
+
+/**
+ * @brief Check the packet types and extensions of the RFC3095 profiles
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	const struct test_case tests[] = {
+		{ "IPv4/UDP", ROHC_PROFILE_UDP, TEST_IPV4, test_pkts_ipv4_udp },
+		{ "IPv4/IPv4/UDP", ROHC_PROFILE_UDP, TEST_IPV4_IPV4,
+		  test_pkts_ipv4_ipv4_udp },
+		{ "IPv4/UDP/RTP", ROHC_PROFILE_RTP, TEST_IPV4, test_pkts_ipv4_rtp },
+		{ "IPv4/IPv4/UDP/RTP", ROHC_PROFILE_RTP, TEST_IPV4_IPV4,
+		  test_pkts_ipv4_ipv4_rtp },
+		{ "IPv6/UDP/RTP", ROHC_PROFILE_RTP, TEST_IPV6, test_pkts_ipv6_rtp },
+	};
+	size_t i;
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	for(i = 0; i < (sizeof(tests) / sizeof(tests[0])); i++)
+	{
+		fprintf(stderr, "%s:\n", tests[i].descr);
+		if(!test_ext_selection(&tests[i]))
+		{
+			goto error;
+		}
+	}
+
+	status = 0;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the packet types and extensions of the RFC3095 profiles\n"
+	        "\n"
+	        "usage: test_ext_selection [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Compress one flow and check the ROHC packets
+ *
+ * @param test  The test to run
+ * @return      true if the test succeeded, false otherwise
+ */
+static bool test_ext_selection(const struct test_case *const test)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct test_fields fields = {
+		.ip_id_inner = 0x1000,
+		.ip_id_outer = 0x5000,
+		.sn = 0x2000,
+		.ts = 0x10000000,
+		.marker = false,
+	};
+	struct test_channel channel;
+	rohc_comp_last_packet_info2_t info;
+	size_t pkt_num;
+	bool is_success = false;
+
+	/* create the ROHC compressor and decompressor in unidirectional mode */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_enable_profile(&channel, test->profile))
+	{
+		goto free_channel;
+	}
+	if(!rohc_comp_set_rtp_detection_cb(channel.comp, rtp_detect, NULL))
+	{
+		fprintf(stderr, "failed to set the RTP detection callback\n");
+		goto free_channel;
+	}
+
+	for(pkt_num = 0; pkt_num < TEST_PKTS_NR; pkt_num++)
+	{
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+		update_fields(&fields, pkt_num);
+		if(!build_packet(test, &fields, pkt_num, &ip_packet))
+		{
+			goto free_channel;
+		}
+
+		/* compress the packet and check the type and length of its header */
+		if(!test_channel_compress(&channel, pkt_num, ip_packet, &rohc_packet,
+		                          &info))
+		{
+			goto free_channel;
+		}
+		if(info.profile_id != test->profile)
+		{
+			fprintf(stderr, "\tpacket #%zu was compressed with profile 0x%04x\n",
+			        pkt_num + 1, info.profile_id);
+			goto free_channel;
+		}
+		if(pkt_num > 0 && (pkt_num % TEST_JUMP_PERIOD) == 0)
+		{
+			const struct test_pkt *const expected_pkt =
+				&test->pkts[pkt_num / TEST_JUMP_PERIOD - 1];
+
+			if(info.packet_type != expected_pkt->type ||
+			   info.header_last_comp_size != expected_pkt->hdr_len)
+			{
+				fprintf(stderr, "\tpacket #%zu was compressed as a %lu-byte %s "
+				        "header instead of a %zu-byte %s header\n", pkt_num + 1,
+				        info.header_last_comp_size,
+				        rohc_get_packet_descr(info.packet_type),
+				        expected_pkt->hdr_len,
+				        rohc_get_packet_descr(expected_pkt->type));
+				goto free_channel;
+			}
+		}
+
+		/* decompress the packet and check it */
+		if(!test_channel_decompress(&channel, pkt_num, rohc_packet, ip_packet))
+		{
+			goto free_channel;
+		}
+	}
+	fprintf(stderr, "\t%u packets compressed as expected and decompressed "
+	        "correctly\n", TEST_PKTS_NR);
+
+	is_success = true;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_success;
+}
+
+
+/**
+ * @brief Compute the varying fields of the given packet
+ *
+ * The fields increase regularly, and jump from time to time by different
+ * amounts so that the compressor needs more and more bits to transmit them.
+ * The jump of 2^16 of a 16-bit field does not change it.
+ *
+ * @param[in,out] fields  The varying fields of the previous packet, then the
+ *                        ones of the new packet
+ * @param pkt_num         The number of the new packet in the flow
+ */
+static void update_fields(struct test_fields *const fields,
+                          const size_t pkt_num)
+{
+	if(pkt_num == 0)
+	{
+		return;
+	}
+
+	fields->ip_id_inner++;
+	fields->ip_id_outer++;
+	fields->sn++;
+	fields->ts += 160;
+	fields->marker = false;
+
+	/* every TEST_JUMP_PERIOD packets, one kind of jump occurs; every kind
+	 * of jump is done with 2^0, then 2^1... and 2^TEST_JUMP_MAX_BITS */
+	if((pkt_num % TEST_JUMP_PERIOD) == 0)
+	{
+		const size_t jump_num = pkt_num / TEST_JUMP_PERIOD - 1;
+		const uint32_t jump = 1U << (jump_num / TEST_JUMP_MAX);
+
+		switch(jump_num % TEST_JUMP_MAX)
+		{
+			case TEST_JUMP_IP_ID:
+				fields->ip_id_inner += jump;
+				break;
+			case TEST_JUMP_OUTER_IP_ID:
+				fields->ip_id_outer += jump;
+				break;
+			case TEST_JUMP_IP_IDS:
+				fields->ip_id_inner += jump;
+				fields->ip_id_outer += jump;
+				break;
+			case TEST_JUMP_SN:
+				fields->sn += jump;
+				fields->ts += jump * 160U;
+				break;
+			case TEST_JUMP_TS:
+				fields->ts += jump * 160U;
+				break;
+			case TEST_JUMP_SN_IP_ID:
+				fields->sn += jump;
+				fields->ts += jump * 160U;
+				fields->ip_id_inner += jump;
+				break;
+			case TEST_JUMP_TS_IP_ID:
+				fields->ts += jump * 160U;
+				fields->ip_id_inner += jump;
+				break;
+			case TEST_JUMP_MARKER_IP_ID:
+			default:
+				fields->marker = true;
+				fields->ip_id_inner += jump;
+				break;
+		}
+	}
+}
+
+
+/**
+ * @brief Build the given packet of the given flow
+ *
+ * @param test            The test that describes the flow
+ * @param fields          The varying fields of the packet
+ * @param pkt_num         The number of the packet in the flow
+ * @param[out] ip_packet  The IP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const struct test_case *const test,
+                         const struct test_fields *const fields,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const bool is_rtp = (test->profile == ROHC_PROFILE_RTP);
+	const size_t udp_len = sizeof(struct udphdr) +
+		(is_rtp ? sizeof(struct rtphdr) : 0) + TEST_PAYLOAD_LEN;
+	uint8_t *data = rohc_buf_data(*ip_packet);
+	struct udphdr *udp_header;
+	size_t hdrs_len = 0;
+	size_t ip_hdrs_nr;
+	size_t i;
+	size_t j;
+
+	memset(data, 0, ip_packet->max_len);
+
+	/* IP headers */
+	if(test->ip_hdrs == TEST_IPV6)
+	{
+		struct ipv6_hdr *const ip_header = (struct ipv6_hdr *) data;
+
+		ip_header->version = 6;
+		ip_header->plen = htons(udp_len);
+		ip_header->nh = ROHC_IPPROTO_UDP;
+		ip_header->hl = 64;
+		ip_header->saddr.u8[0] = 0x20;
+		ip_header->saddr.u8[15] = 0x01;
+		ip_header->daddr.u8[0] = 0x20;
+		ip_header->daddr.u8[15] = 0x02;
+		hdrs_len = sizeof(struct ipv6_hdr);
+	}
+	else
+	{
+		ip_hdrs_nr = (test->ip_hdrs == TEST_IPV4_IPV4 ? 2 : 1);
+		for(i = 0; i < ip_hdrs_nr; i++)
+		{
+			struct ipv4_hdr *const ip_header =
+				(struct ipv4_hdr *) (data + hdrs_len);
+			const bool is_inner = (i == (ip_hdrs_nr - 1));
+			uint32_t csum = 0;
+
+			ip_header->version = 4;
+			ip_header->ihl = 5;
+			ip_header->tot_len =
+				htons((ip_hdrs_nr - i) * sizeof(struct ipv4_hdr) + udp_len);
+			ip_header->id =
+				htons(is_inner ? fields->ip_id_inner : fields->ip_id_outer);
+			ip_header->ttl = 64;
+			ip_header->protocol =
+				(is_inner ? ROHC_IPPROTO_UDP : ROHC_IPPROTO_IPIP);
+			ip_header->saddr = htonl(0xc0a80001 + (i << 8));
+			ip_header->daddr = htonl(0xc0a80002 + (i << 8));
+			for(j = 0; j < sizeof(struct ipv4_hdr); j += 2)
+			{
+				csum += (data[hdrs_len + j] << 8) | data[hdrs_len + j + 1];
+			}
+			csum = (csum & 0xffff) + (csum >> 16);
+			csum = (csum & 0xffff) + (csum >> 16);
+			ip_header->check = htons((~csum) & 0xffff);
+			hdrs_len += sizeof(struct ipv4_hdr);
+		}
+	}
+
+	/* UDP header */
+	udp_header = (struct udphdr *) (data + hdrs_len);
+	udp_header->source = htons(1234);
+	udp_header->dest = htons(1234);
+	udp_header->len = htons(udp_len);
+	udp_header->check = htons(0x1234 + pkt_num);
+	hdrs_len += sizeof(struct udphdr);
+
+	/* RTP header */
+	if(is_rtp)
+	{
+		struct rtphdr *const rtp_header = (struct rtphdr *) (data + hdrs_len);
+
+		rtp_header->version = 2;
+		rtp_header->m = (fields->marker ? 1 : 0);
+		rtp_header->pt = 96;
+		rtp_header->sn = htons(fields->sn);
+		rtp_header->timestamp = htonl(fields->ts);
+		rtp_header->ssrc = htonl(0x12345678);
+		hdrs_len += sizeof(struct rtphdr);
+	}
+
+	/* payload */
+	if(ip_packet->max_len < (hdrs_len + TEST_PAYLOAD_LEN))
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+	for(i = hdrs_len; i < (hdrs_len + TEST_PAYLOAD_LEN); i++)
+	{
+		data[i] = (i + pkt_num) & 0xff;
+	}
+	ip_packet->len = hdrs_len + TEST_PAYLOAD_LEN;
+
+	return true;
+}
+
+
+/**
+ * @brief Detect all the UDP flows as RTP flows
+ *
+ * @param ip           The innermost IP packet
+ * @param udp          The UDP header of the packet
+ * @param payload      The UDP payload of the packet
+ * @param payload_size The size of the UDP payload (in bytes)
+ * @param rtp_private  Should always be NULL
+ * @return             Always true
+ */
+static bool rtp_detect(const unsigned char *const ip,
+                       const unsigned char *const udp,
+                       const unsigned char *const payload,
+                       const unsigned int payload_size,
+                       void *const rtp_private)
+{
+	return true;
+}
+
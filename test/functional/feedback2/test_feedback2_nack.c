@@ -0,0 +1,506 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_feedback2_nack.c
+ * @brief  Check that a stale ACK does not cancel the refresh requested by a
+ *         NACK or a STATIC-NACK
+ * @author agent <agent@local>
+ *
+ * The application compresses a TCP flow until the compressor reaches the SO
+ * state, then delivers a (STATIC-)NACK followed by a positive ACK for one
+ * packet sent before the NACK. The next packet shall refresh the context of
+ * the decompressor (IR-DYN for a NACK, IR for a STATIC-NACK). Once the ACK
+ * of the refresh packet is received, the compressor shall transit to the
+ * SO state again.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+#include <stdarg.h>
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/tcp.h>
+
+/* ROHC internal includes */
+#include <feedback.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The first MSN used by the TCP compression context */
+#define TEST_FIRST_MSN  0x1231U
+
+/** The number of packets to compress before the negative feedback */
+#define TEST_PKTS_BEFORE_NACK  15U
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_nack_then_stale_ack(const bool is_static_nack);
+static bool compress_one(struct rohc_comp *const comp,
+                         struct rohc_decomp *const decomp,
+                         const size_t pkt_num,
+                         rohc_packet_t *const packet_type,
+                         rohc_comp_state_t *const state)
+	__attribute__((warn_unused_result, nonnull(1, 2, 4, 5)));
+static bool deliver_feedback2(struct rohc_comp *const comp,
+                              const enum rohc_feedback_ack_type ack_type,
+                              const uint16_t msn)
+	__attribute__((warn_unused_result, nonnull(1)));
+static uint8_t crc8(const uint8_t *const data, const size_t len)
+	__attribute__((warn_unused_result, nonnull(1)));
+static void print_rohc_traces(void *const priv_ctxt,
+                              const rohc_trace_level_t level,
+                              const rohc_trace_entity_t entity,
+                              const int profile,
+                              const char *const format,
+                              ...)
+	__attribute__((format(printf, 5, 6), nonnull(5)));
+static int gen_false_random_num(const struct rohc_comp *const comp,
+                                void *const user_context)
+	__attribute__((nonnull(1)));
+
+
+/**
+ * @brief Check that a positive ACK received after a (STATIC-)NACK does not
+ *        move the compressor to the SO state before the context is refreshed
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	/* NACK then stale ACK => IR-DYN expected */
+	status = test_nack_then_stale_ack(false);
+	if(status != 0)
+	{
+		goto error;
+	}
+
+	/* STATIC-NACK then stale ACK => IR expected */
+	status = test_nack_then_stale_ack(true);
+	if(status != 0)
+	{
+		goto error;
+	}
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check that a stale ACK does not cancel the refresh requested by a "
+	        "NACK or a STATIC-NACK\n"
+	        "\n"
+	        "usage: test_feedback2_nack [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Deliver a (STATIC-)NACK then a stale ACK and check the next packets
+ *
+ * @param is_static_nack  Whether to test a STATIC-NACK or a NACK
+ * @return                0 in case of success,
+ *                        1 in case of failure
+ */
+static int test_nack_then_stale_ack(const bool is_static_nack)
+{
+	const enum rohc_feedback_ack_type nack_type =
+		(is_static_nack ? ROHC_FEEDBACK_STATIC_NACK : ROHC_FEEDBACK_NACK);
+	const rohc_packet_t refresh_type =
+		(is_static_nack ? ROHC_PACKET_IR : ROHC_PACKET_IR_DYN);
+	const rohc_comp_state_t refresh_state =
+		(is_static_nack ? ROHC_COMP_STATE_IR : ROHC_COMP_STATE_FO);
+	struct rohc_comp *comp;
+	struct rohc_decomp *decomp;
+	rohc_packet_t packet_type;
+	rohc_comp_state_t state;
+	size_t pkt_num;
+	int is_failure = 1;
+
+	fprintf(stderr, "test %s followed by a stale ACK\n",
+	        is_static_nack ? "STATIC-NACK" : "NACK");
+
+	/* create the ROHC compressor with small CID */
+	comp = rohc_comp_new2(ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                      gen_false_random_num, NULL);
+	if(comp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC compressor\n");
+		goto error;
+	}
+	if(!rohc_comp_set_traces_cb2(comp, print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "compressor\n");
+		goto destroy_comp;
+	}
+	if(!rohc_comp_enable_profile(comp, ROHC_PROFILE_TCP))
+	{
+		fprintf(stderr, "failed to enable the TCP profile\n");
+		goto destroy_comp;
+	}
+
+	/* create the ROHC decompressor in bi-directional mode */
+	decomp = rohc_decomp_new2(ROHC_SMALL_CID, ROHC_SMALL_CID_MAX, ROHC_O_MODE);
+	if(decomp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC decompressor\n");
+		goto destroy_comp;
+	}
+	if(!rohc_decomp_set_traces_cb2(decomp, print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "decompressor\n");
+		goto destroy_decomp;
+	}
+	if(!rohc_decomp_enable_profile(decomp, ROHC_PROFILE_TCP))
+	{
+		fprintf(stderr, "failed to enable the TCP profile\n");
+		goto destroy_decomp;
+	}
+
+	/* establish the context */
+	for(pkt_num = 0; pkt_num < TEST_PKTS_BEFORE_NACK; pkt_num++)
+	{
+		if(!compress_one(comp, decomp, pkt_num, &packet_type, &state))
+		{
+			goto destroy_decomp;
+		}
+	}
+	if(state != ROHC_COMP_STATE_SO)
+	{
+		fprintf(stderr, "compressor did not reach the SO state after %u "
+		        "packets\n", TEST_PKTS_BEFORE_NACK);
+		goto destroy_decomp;
+	}
+
+	/* the decompressor reports a damaged context for the last packet, then an
+	 * ACK sent before the damage is received late */
+	if(!deliver_feedback2(comp, nack_type, TEST_FIRST_MSN + pkt_num - 1))
+	{
+		fprintf(stderr, "failed to deliver the negative feedback\n");
+		goto destroy_decomp;
+	}
+	if(!deliver_feedback2(comp, ROHC_FEEDBACK_ACK, TEST_FIRST_MSN + 2))
+	{
+		fprintf(stderr, "failed to deliver the stale positive feedback\n");
+		goto destroy_decomp;
+	}
+
+	/* the next packet shall refresh the context */
+	if(!compress_one(comp, decomp, pkt_num, &packet_type, &state))
+	{
+		goto destroy_decomp;
+	}
+	if(packet_type != refresh_type || state != refresh_state)
+	{
+		fprintf(stderr, "stale ACK cancelled the context refresh: %s packet "
+		        "sent in state %s instead of %s packet in state %s\n",
+		        rohc_get_packet_descr(packet_type),
+		        rohc_comp_get_state_descr(state),
+		        rohc_get_packet_descr(refresh_type),
+		        rohc_comp_get_state_descr(refresh_state));
+		goto destroy_decomp;
+	}
+	fprintf(stderr, "\t%s packet sent in state %s after stale ACK as expected\n",
+	        rohc_get_packet_descr(packet_type), rohc_comp_get_state_descr(state));
+
+	/* the ACK of the refresh packet allows the upward transition again */
+	if(!deliver_feedback2(comp, ROHC_FEEDBACK_ACK, TEST_FIRST_MSN + pkt_num))
+	{
+		fprintf(stderr, "failed to deliver the positive feedback\n");
+		goto destroy_decomp;
+	}
+	pkt_num++;
+	if(!compress_one(comp, decomp, pkt_num, &packet_type, &state))
+	{
+		goto destroy_decomp;
+	}
+	if(state != ROHC_COMP_STATE_SO)
+	{
+		fprintf(stderr, "ACK of the refresh packet did not make the compressor "
+		        "transit to SO state: %s packet sent in state %s\n",
+		        rohc_get_packet_descr(packet_type),
+		        rohc_comp_get_state_descr(state));
+		goto destroy_decomp;
+	}
+	fprintf(stderr, "\t%s packet sent in SO state after ACK of refresh packet\n",
+	        rohc_get_packet_descr(packet_type));
+
+	is_failure = 0;
+
+destroy_decomp:
+	rohc_decomp_free(decomp);
+destroy_comp:
+	rohc_comp_free(comp);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Compress and decompress the given packet of the TCP flow
+ *
+ * @param comp              The ROHC compressor
+ * @param decomp            The ROHC decompressor
+ * @param pkt_num           The number of the packet in the TCP flow
+ * @param[out] packet_type  The type of ROHC packet that was created
+ * @param[out] state        The compressor state used for the packet
+ * @return                  true if the packet was successfully compressed
+ *                          and decompressed, false otherwise
+ */
+static bool compress_one(struct rohc_comp *const comp,
+                         struct rohc_decomp *const decomp,
+                         const size_t pkt_num,
+                         rohc_packet_t *const packet_type,
+                         rohc_comp_state_t *const state)
+{
+	const size_t payload_len = 10;
+	const size_t ip_len =
+		sizeof(struct ipv4_hdr) + sizeof(struct tcphdr) + payload_len;
+
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf ip_packet = rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf rohc_packet =
+		rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+	uint8_t uncomp_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf uncomp_packet =
+		rohc_buf_init_empty(uncomp_buffer, TEST_MAX_PKT_SIZE);
+
+	rohc_comp_last_packet_info2_t info;
+	struct ipv4_hdr *ip_header;
+	struct tcphdr *tcp_header;
+	uint32_t csum = 0;
+	rohc_status_t status;
+	size_t i;
+
+	/* generate the IPv4/TCP packet */
+	ip_packet.len = ip_len;
+	memset(rohc_buf_data(ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + pkt_num);
+	ip_header->ttl = 64;
+	ip_header->protocol = ROHC_IPPROTO_TCP;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(ip_packet, i) << 8) |
+		        rohc_buf_byte_at(ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+	tcp_header = (struct tcphdr *) (ip_header + 1);
+	tcp_header->src_port = htons(1234);
+	tcp_header->dst_port = htons(80);
+	tcp_header->seq_num = htonl(0x10000000 + pkt_num * payload_len);
+	tcp_header->ack_num = htonl(0x20000000);
+	tcp_header->data_offset = sizeof(struct tcphdr) / 4;
+	tcp_header->ack_flag = 1;
+	tcp_header->window = htons(8192);
+	tcp_header->checksum = htons(0x1234 + pkt_num);
+	for(i = sizeof(struct ipv4_hdr) + sizeof(struct tcphdr); i < ip_len; i++)
+	{
+		rohc_buf_byte_at(ip_packet, i) = i & 0xff;
+	}
+
+	/* compress the packet */
+	status = rohc_compress4(comp, ip_packet, &rohc_packet);
+	if(status != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "failed to compress packet #%zu\n", pkt_num + 1);
+		goto error;
+	}
+	info.version_major = 0;
+	info.version_minor = 0;
+	if(!rohc_comp_get_last_packet_info2(comp, &info))
+	{
+		fprintf(stderr, "failed to get compression info for packet #%zu\n",
+		        pkt_num + 1);
+		goto error;
+	}
+	*packet_type = info.packet_type;
+	*state = info.context_state;
+
+	/* decompress the packet and check that it was rebuilt correctly */
+	status = rohc_decompress3(decomp, rohc_packet, &uncomp_packet, NULL, NULL);
+	if(status != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "failed to decompress packet #%zu\n", pkt_num + 1);
+		goto error;
+	}
+	if(uncomp_packet.len != ip_packet.len ||
+	   memcmp(rohc_buf_data(uncomp_packet), rohc_buf_data(ip_packet),
+	          ip_packet.len) != 0)
+	{
+		fprintf(stderr, "packet #%zu was not decompressed correctly\n",
+		        pkt_num + 1);
+		goto error;
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Deliver one TCP FEEDBACK-2 for CID 0 to the compressor
+ *
+ * @param comp      The ROHC compressor
+ * @param ack_type  The type of feedback: ACK, NACK or STATIC-NACK
+ * @param msn       The MSN acknowledged by the feedback
+ * @return          true if the feedback was successfully delivered,
+ *                  false otherwise
+ */
+static bool deliver_feedback2(struct rohc_comp *const comp,
+                              const enum rohc_feedback_ack_type ack_type,
+                              const uint16_t msn)
+{
+	const struct rohc_ts arrival_time = { .sec = 0, .nsec = 0 };
+	uint8_t feedback_data[4];
+	const struct rohc_buf feedback =
+		rohc_buf_init_full(feedback_data, 4, arrival_time);
+
+	/* RFC 6846, §8.3.2: Acktype, 14-bit MSN and CRC-8 */
+	feedback_data[0] = 0xf0 | 3; /* feedback type + size */
+	feedback_data[1] = ((ack_type & 0x3) << 6) | ((msn >> 8) & 0x3f);
+	feedback_data[2] = msn & 0xff;
+	feedback_data[3] = 0x00;
+	feedback_data[3] = crc8(feedback_data + 1, 3);
+
+	return rohc_comp_deliver_feedback2(comp, feedback);
+}
+
+
+/**
+ * @brief Compute the 8-bit CRC of the feedback as defined by RFC 3095
+ *
+ * @param data  The data to compute the CRC for
+ * @param len   The length of the data
+ * @return      The 8-bit CRC
+ */
+static uint8_t crc8(const uint8_t *const data, const size_t len)
+{
+	uint8_t crc = 0xff;
+	size_t i;
+	size_t j;
+
+	for(i = 0; i < len; i++)
+	{
+		crc ^= data[i];
+		for(j = 0; j < 8; j++)
+		{
+			crc = (crc & 1) ? ((crc >> 1) ^ 0xe0) : (crc >> 1);
+		}
+	}
+
+	return crc;
+}
+
+
+/**
+ * @brief Callback to print traces of the ROHC library
+ *
+ * @param priv_ctxt  An optional private context, may be NULL
+ * @param level      The priority level of the trace
+ * @param entity     The entity that emitted the trace among:
+ *                    \li ROHC_TRACE_COMP
+ *                    \li ROHC_TRACE_DECOMP
+ * @param profile    The ID of the ROHC compression/decompression profile
+ *                   the trace is related to
+ * @param format     The format string of the trace
+ */
+static void print_rohc_traces(void *const priv_ctxt,
+                              const rohc_trace_level_t level,
+                              const rohc_trace_entity_t entity,
+                              const int profile,
+                              const char *const format,
+                              ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	vfprintf(stdout, format, args);
+	va_end(args);
+}
+
+
+/**
+ * @brief Generate a false random number for testing the ROHC library
+ *
+ * The TCP compression context uses it as first MSN, so that the test knows
+ * the MSN of every packet.
+ *
+ * @param comp          The ROHC compressor
+ * @param user_context  Should always be NULL
+ * @return              Always the same number
+ */
+static int gen_false_random_num(const struct rohc_comp *const comp,
+                                void *const user_context)
+{
+	return (TEST_FIRST_MSN - 1);
+}
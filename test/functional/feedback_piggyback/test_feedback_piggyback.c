@@ -0,0 +1,519 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_feedback_piggyback.c
+ * @brief  Check the feedback piggybacked on the ROHC packets of the other way
+ * @author agent <agent@local>
+ *
+ * Two hosts A and B compress and decompress the flows of a bidirectional
+ * link. The feedback of the decompressor of host B is queued in the
+ * compressor of host B, piggybacked on the ROHC packets from B to A, then
+ * delivered to the compressor of host A.
+ *
+ * The application then checks the flush of the feedback items that waited
+ * too long: the flush delay runs from the time of the oldest feedback item
+ * still queued, not from the time of the items that were already
+ * piggybacked.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/udp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The number of packets sent every way of the link */
+#define TEST_PKTS_NR  20U
+
+/** The delay (in milliseconds) after which queued feedback is flushed */
+#define TEST_FLUSH_DELAY  100U
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_feedback_piggyback_round_trip(void);
+static int test_feedback_piggyback_flush(void);
+static struct rohc_ts test_time(const uint64_t ms)
+	__attribute__((warn_unused_result, const));
+static bool build_packet(const uint16_t port,
+                         const size_t pkt_num,
+                         const struct rohc_ts time,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(4)));
+static bool decompress(struct rohc_decomp *const decomp,
+                       const size_t pkt_num,
+                       const struct rohc_buf rohc_packet,
+                       const struct rohc_buf ip_packet,
+                       struct rohc_buf *const rcvd_feedback,
+                       struct rohc_buf *const feedback_send)
+	__attribute__((warn_unused_result, nonnull(1, 5, 6)));
+
+
+/**
+ * @brief Check the feedback piggybacked on the ROHC packets of the other way
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	status = test_feedback_piggyback_round_trip();
+	if(status == 0)
+	{
+		status = test_feedback_piggyback_flush();
+	}
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the feedback piggybacked on the ROHC packets of the other "
+	        "way\n"
+	        "\n"
+	        "usage: test_feedback_piggyback [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Piggyback the feedback of B on the packets from B to A
+ *
+ * The decompressor of host B works in O-mode: its feedback items reach the
+ * compressor of host A only through the packets from B to A, so the context
+ * of host A switches to O-mode only if piggybacking works.
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_feedback_piggyback_round_trip(void)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rcvd_feedback_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t feedback_send_buffer[TEST_MAX_PKT_SIZE];
+	struct test_channel a_to_b;
+	struct test_channel b_to_a;
+	rohc_comp_last_packet_info2_t info;
+	size_t fb_queued_len = 0;
+	size_t fb_rcvd_len = 0;
+	size_t i;
+	int is_failure = 1;
+
+	/* host A compresses with the compressor of channel A->B and decompresses
+	 * with the decompressor of channel B->A, host B the other way around */
+	if(!test_channel_new(&a_to_b, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_O_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_new(&b_to_a, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_O_MODE))
+	{
+		goto free_a_to_b;
+	}
+	if(!test_channel_enable_profile(&a_to_b, ROHC_PROFILE_UDP) ||
+	   !test_channel_enable_profile(&b_to_a, ROHC_PROFILE_UDP))
+	{
+		goto free_b_to_a;
+	}
+
+	for(i = 0; i < TEST_PKTS_NR; i++)
+	{
+		const struct rohc_ts now = test_time(i * 20);
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rcvd_feedback =
+			rohc_buf_init_empty(rcvd_feedback_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf feedback_send =
+			rohc_buf_init_empty(feedback_send_buffer, TEST_MAX_PKT_SIZE);
+
+		/* A -> B: the feedback of B is queued for piggybacking */
+		if(!build_packet(1000, i, now, &ip_packet) ||
+		   !test_channel_compress(&a_to_b, i, ip_packet, &rohc_packet, &info) ||
+		   !decompress(a_to_b.decomp, i, rohc_packet, ip_packet, &rcvd_feedback,
+		               &feedback_send))
+		{
+			goto free_b_to_a;
+		}
+		if(i > 0 && info.context_mode != ROHC_O_MODE)
+		{
+			fprintf(stderr, "packet #%zu from A to B was compressed in mode "
+			        "%d instead of O-mode\n", i + 1, info.context_mode);
+			goto free_b_to_a;
+		}
+		feedback_send.time = now;
+		if(!rohc_comp_piggyback_feedback(b_to_a.comp, feedback_send))
+		{
+			fprintf(stderr, "failed to queue the feedback of packet #%zu\n",
+			        i + 1);
+			goto free_b_to_a;
+		}
+		fb_queued_len += feedback_send.len;
+
+		/* B -> A: the feedback of B is delivered to the compressor of A */
+		ip_packet = (struct rohc_buf) rohc_buf_init_empty(ip_buffer,
+		                                                 TEST_MAX_PKT_SIZE);
+		rohc_packet = (struct rohc_buf) rohc_buf_init_empty(rohc_buffer,
+		                                                   TEST_MAX_PKT_SIZE);
+		rohc_buf_reset(&rcvd_feedback);
+		rohc_buf_reset(&feedback_send);
+		if(!build_packet(2000, i, now, &ip_packet) ||
+		   !test_channel_compress(&b_to_a, i, ip_packet, &rohc_packet, &info) ||
+		   !decompress(b_to_a.decomp, i, rohc_packet, ip_packet, &rcvd_feedback,
+		               &feedback_send))
+		{
+			goto free_b_to_a;
+		}
+		fb_rcvd_len += rcvd_feedback.len;
+		if(!rohc_buf_is_empty(rcvd_feedback) &&
+		   !rohc_comp_deliver_feedback2(a_to_b.comp, rcvd_feedback))
+		{
+			fprintf(stderr, "failed to deliver the feedback piggybacked on "
+			        "packet #%zu\n", i + 1);
+			goto free_b_to_a;
+		}
+	}
+
+	/* all the feedback of B was piggybacked, none is left to flush */
+	fprintf(stderr, "%zu bytes of feedback queued, %zu bytes piggybacked\n",
+	        fb_queued_len, fb_rcvd_len);
+	if(fb_queued_len == 0 || fb_rcvd_len != fb_queued_len)
+	{
+		fprintf(stderr, "all the queued feedback shall be piggybacked\n");
+		goto free_b_to_a;
+	}
+	{
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+		if(!rohc_comp_flush_feedbacks(b_to_a.comp, test_time(10000),
+		                              &rohc_packet) ||
+		   !rohc_buf_is_empty(rohc_packet))
+		{
+			fprintf(stderr, "no feedback shall be left to flush\n");
+			goto free_b_to_a;
+		}
+	}
+
+	is_failure = 0;
+
+free_b_to_a:
+	test_channel_free(&b_to_a);
+free_a_to_b:
+	test_channel_free(&a_to_b);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Flush the feedback of B after the delay of the oldest item left
+ *
+ * Two feedback items are queued at 0 and 90 ms. Only the first one fits in
+ * the packet from B to A at 50 ms. The second one shall not be flushed
+ * before 190 ms.
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_feedback_piggyback_flush(void)
+{
+	/* FEEDBACK-1 items for CID 0 */
+	uint8_t feedback1[] = { 0xf1, 0x01 };
+	uint8_t feedback2[] = { 0xf1, 0x02 };
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rcvd_feedback_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t feedback_send_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf ip_packet =
+		rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+	struct rohc_buf rohc_packet =
+		rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+	struct rohc_buf rcvd_feedback =
+		rohc_buf_init_empty(rcvd_feedback_buffer, TEST_MAX_PKT_SIZE);
+	struct rohc_buf feedback_send =
+		rohc_buf_init_empty(feedback_send_buffer, TEST_MAX_PKT_SIZE);
+	const struct rohc_buf fb1 =
+		rohc_buf_init_full(feedback1, sizeof(feedback1), test_time(0));
+	const struct rohc_buf fb2 =
+		rohc_buf_init_full(feedback2, sizeof(feedback2), test_time(90));
+	struct test_channel b_to_a;
+	rohc_comp_last_packet_info2_t info;
+	int is_failure = 1;
+
+	if(!test_channel_new(&b_to_a, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_enable_profile(&b_to_a, ROHC_PROFILE_UDP))
+	{
+		goto free_channel;
+	}
+
+	/* one feedback item per ROHC packet at most */
+	if(!rohc_comp_set_piggybacking(b_to_a.comp, sizeof(feedback1),
+	                               TEST_FLUSH_DELAY))
+	{
+		fprintf(stderr, "failed to configure piggybacking\n");
+		goto free_channel;
+	}
+	if(!rohc_comp_piggyback_feedback(b_to_a.comp, fb1) ||
+	   !rohc_comp_piggyback_feedback(b_to_a.comp, fb2))
+	{
+		fprintf(stderr, "failed to queue the feedback items\n");
+		goto free_channel;
+	}
+
+	/* the first feedback item is piggybacked at 50 ms */
+	if(!build_packet(2000, 0, test_time(50), &ip_packet) ||
+	   !test_channel_compress(&b_to_a, 0, ip_packet, &rohc_packet, &info) ||
+	   !decompress(b_to_a.decomp, 0, rohc_packet, ip_packet, &rcvd_feedback,
+	               &feedback_send))
+	{
+		goto free_channel;
+	}
+	if(rcvd_feedback.len != sizeof(feedback1) ||
+	   memcmp(rohc_buf_data(rcvd_feedback), feedback1, sizeof(feedback1)) != 0)
+	{
+		fprintf(stderr, "the first feedback item shall be piggybacked\n");
+		goto free_channel;
+	}
+
+	/* the second feedback item waited for 30 ms only at 120 ms */
+	rohc_packet = (struct rohc_buf) rohc_buf_init_empty(rohc_buffer,
+	                                                   TEST_MAX_PKT_SIZE);
+	if(!rohc_comp_flush_feedbacks(b_to_a.comp, test_time(120), &rohc_packet))
+	{
+		fprintf(stderr, "failed to flush feedback at 120 ms\n");
+		goto free_channel;
+	}
+	if(!rohc_buf_is_empty(rohc_packet))
+	{
+		fprintf(stderr, "the second feedback item shall not be flushed at "
+		        "120 ms, it was queued at 90 ms\n");
+		goto free_channel;
+	}
+
+	/* the second feedback item waited for 100 ms at 190 ms */
+	if(!rohc_comp_flush_feedbacks(b_to_a.comp, test_time(190), &rohc_packet))
+	{
+		fprintf(stderr, "failed to flush feedback at 190 ms\n");
+		goto free_channel;
+	}
+	rohc_buf_reset(&rcvd_feedback);
+	rohc_buf_reset(&feedback_send);
+	ip_packet.len = 0;
+	if(rohc_buf_is_empty(rohc_packet) ||
+	   !decompress(b_to_a.decomp, 1, rohc_packet, ip_packet, &rcvd_feedback,
+	               &feedback_send))
+	{
+		fprintf(stderr, "the second feedback item shall be flushed at 190 ms\n");
+		goto free_channel;
+	}
+	if(rcvd_feedback.len != sizeof(feedback2) ||
+	   memcmp(rohc_buf_data(rcvd_feedback), feedback2, sizeof(feedback2)) != 0)
+	{
+		fprintf(stderr, "the flushed packet shall contain the second feedback "
+		        "item\n");
+		goto free_channel;
+	}
+	fprintf(stderr, "feedback flushed %u ms after the oldest item left was "
+	        "queued\n", TEST_FLUSH_DELAY);
+
+	is_failure = 0;
+
+free_channel:
+	test_channel_free(&b_to_a);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Get the time of the test at the given number of milliseconds
+ *
+ * @param ms  The number of milliseconds since the beginning of the test
+ * @return    The time of the test
+ */
+static struct rohc_ts test_time(const uint64_t ms)
+{
+	const struct rohc_ts time = {
+		.sec = 1000 + ms / 1000,
+		.nsec = (ms % 1000) * 1000000,
+	};
+	return time;
+}
+
+
+/**
+ * @brief Build the given packet of the IPv4/UDP flow with the given port
+ *
+ * @param port            The UDP source port of the flow
+ * @param pkt_num         The number of the packet in the flow
+ * @param time            The arrival time of the packet
+ * @param[out] ip_packet  The IPv4/UDP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const uint16_t port,
+                         const size_t pkt_num,
+                         const struct rohc_ts time,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t payload_len = 28;
+	const size_t ip_len = sizeof(struct ipv4_hdr) + payload_len;
+	struct ipv4_hdr *ip_header;
+	struct udphdr *udp_header;
+	uint32_t csum = 0;
+	size_t i;
+
+	if(ip_packet->max_len < ip_len)
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+
+	/* generate the IPv4 header with a sequential IP-ID */
+	ip_packet->time = time;
+	ip_packet->len = ip_len;
+	memset(rohc_buf_data(*ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(*ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + pkt_num);
+	ip_header->ttl = 64;
+	ip_header->protocol = ROHC_IPPROTO_UDP;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(*ip_packet, i) << 8) |
+		        rohc_buf_byte_at(*ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* generate the UDP header and the payload */
+	for(i = sizeof(struct ipv4_hdr); i < ip_len; i++)
+	{
+		rohc_buf_byte_at(*ip_packet, i) = (i + pkt_num) & 0xff;
+	}
+	udp_header = (struct udphdr *) (ip_header + 1);
+	udp_header->source = htons(port);
+	udp_header->dest = htons(1234);
+	udp_header->len = htons(payload_len);
+	udp_header->check = 0;
+
+	return true;
+}
+
+
+/**
+ * @brief Decompress one ROHC packet, get the feedback it carries
+ *
+ * @param decomp              The ROHC decompressor
+ * @param pkt_num             The number of the packet, for traces
+ * @param rohc_packet         The ROHC packet to decompress
+ * @param ip_packet           The IP packet that the ROHC packet shall give
+ *                            back, empty for feedback-only ROHC packets
+ * @param[out] rcvd_feedback  The feedback piggybacked on the ROHC packet
+ * @param[out] feedback_send  The feedback of the decompressor
+ * @return                    true if the packet was decompressed correctly,
+ *                            false otherwise
+ */
+static bool decompress(struct rohc_decomp *const decomp,
+                       const size_t pkt_num,
+                       const struct rohc_buf rohc_packet,
+                       const struct rohc_buf ip_packet,
+                       struct rohc_buf *const rcvd_feedback,
+                       struct rohc_buf *const feedback_send)
+{
+	uint8_t uncomp_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf uncomp_packet =
+		rohc_buf_init_empty(uncomp_buffer, TEST_MAX_PKT_SIZE);
+
+	if(rohc_decompress3(decomp, rohc_packet, &uncomp_packet, rcvd_feedback,
+	                    feedback_send) != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "\tfailed to decompress packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+	if(uncomp_packet.len != ip_packet.len ||
+	   memcmp(rohc_buf_data(uncomp_packet), rohc_buf_data(ip_packet),
+	          ip_packet.len) != 0)
+	{
+		fprintf(stderr, "\tpacket #%zu was not decompressed correctly\n",
+		        pkt_num + 1);
+		return false;
+	}
+
+	return true;
+}
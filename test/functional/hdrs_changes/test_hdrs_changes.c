@@ -0,0 +1,373 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_hdrs_changes.c
+ * @brief  Check the detection of the header changes of TCP flows
+ * @author agent <agent@local>
+ *
+ * The application compresses interleaved IPv4/TCP and IPv6/TCP flows that
+ * differ by one single static field. Some flows share the same flow key, so
+ * only the comparison of their static fields tells them apart. Every flow
+ * shall keep its own context.
+ * The dynamic fields of the flows change from time to time, among them the
+ * content of an IPv6 Destination Options extension header. All packets shall
+ * be decompressed correctly.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/ipv6.h>
+#include <protocols/tcp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The number of packets of every flow */
+#define TEST_PKTS_NR  40U
+
+/** The number of packets between two changes of the dynamic fields */
+#define TEST_CHANGE_PERIOD  8U
+
+
+/** One TCP flow */
+struct test_flow
+{
+	int ip_version;       /**< The IP version of the flow */
+	uint32_t saddr;       /**< The IPv4 source address, or the last byte of
+	                           the IPv6 source address */
+	uint32_t flow_label;  /**< The IPv6 flow label */
+	uint16_t sport;       /**< The TCP source port */
+	uint16_t dport;       /**< The TCP destination port */
+	rohc_cid_t cid;       /**< The CID of the flow */
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static bool test_hdrs_changes(struct test_flow *const flows,
+                              const size_t flows_nr)
+	__attribute__((warn_unused_result, nonnull(1)));
+static bool build_packet(const struct test_flow *const flow,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(1, 3)));
+
+
+/**
+ * @brief Check the detection of the header changes of TCP flows
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	/* every flow differs from the first flow of the same IP version by one
+	 * single static field, the flows marked with (*) share the flow key of
+	 * the first flow of the same IP version */
+	struct test_flow flows[] = {
+		{ 4, 0xc0a80001, 0, 1000, 80, 0 },
+		{ 4, 0xc0a80001, 0, 1001, 80, 0 },
+		{ 4, 0xc0a80001, 0, 19724, 48509, 0 },   /* (*) */
+		{ 4, 0xc0a80003, 0, 1000, 80, 0 },
+		{ 4, 0x9816c81f, 0, 1000, 80, 0 },       /* (*) */
+		{ 6, 0x01, 0x12345, 1000, 80, 0 },
+		{ 6, 0x01, 0x12346, 1000, 80, 0 },       /* (*) */
+		{ 6, 0x01, 0x12345, 1001, 80, 0 },
+		{ 6, 0x01, 0x12345, 18772, 17741, 0 },   /* (*) */
+		{ 6, 0x03, 0x12345, 1000, 80, 0 },
+	};
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	if(!test_hdrs_changes(flows, sizeof(flows) / sizeof(flows[0])))
+	{
+		goto error;
+	}
+
+	status = 0;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the detection of the header changes of TCP flows\n"
+	        "\n"
+	        "usage: test_hdrs_changes [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Compress and decompress the interleaved packets of the given flows
+ *
+ * @param flows     The TCP flows
+ * @param flows_nr  The number of TCP flows
+ * @return          true if the test succeeded, false otherwise
+ */
+static bool test_hdrs_changes(struct test_flow *const flows,
+                              const size_t flows_nr)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct test_channel channel;
+	rohc_comp_last_packet_info2_t info;
+	size_t pkt_num;
+	size_t i;
+	size_t j;
+	bool is_success = false;
+
+	/* create the ROHC compressor and decompressor in unidirectional mode */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_enable_profile(&channel, ROHC_PROFILE_TCP))
+	{
+		goto free_channel;
+	}
+
+	for(pkt_num = 0; pkt_num < TEST_PKTS_NR; pkt_num++)
+	{
+		for(i = 0; i < flows_nr; i++)
+		{
+			struct rohc_buf ip_packet =
+				rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+			struct rohc_buf rohc_packet =
+				rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+			if(!build_packet(&flows[i], pkt_num, &ip_packet))
+			{
+				goto free_channel;
+			}
+
+			/* compress the packet, every flow shall keep its own context */
+			if(!test_channel_compress(&channel, pkt_num, ip_packet, &rohc_packet,
+			                          &info))
+			{
+				goto free_channel;
+			}
+			if(info.profile_id != ROHC_PROFILE_TCP)
+			{
+				fprintf(stderr, "packet #%zu of flow #%zu was compressed with "
+				        "profile 0x%04x\n", pkt_num + 1, i + 1, info.profile_id);
+				goto free_channel;
+			}
+			if(pkt_num == 0)
+			{
+				if(info.packet_type != ROHC_PACKET_IR)
+				{
+					fprintf(stderr, "flow #%zu did not start with an IR packet\n",
+					        i + 1);
+					goto free_channel;
+				}
+				for(j = 0; j < i; j++)
+				{
+					if(flows[j].cid == info.context_id)
+					{
+						fprintf(stderr, "flows #%zu and #%zu share CID %u\n",
+						        j + 1, i + 1, info.context_id);
+						goto free_channel;
+					}
+				}
+				flows[i].cid = info.context_id;
+			}
+			else if(info.context_id != flows[i].cid)
+			{
+				fprintf(stderr, "packet #%zu of flow #%zu was compressed with CID "
+				        "%u instead of CID %zu\n", pkt_num + 1, i + 1,
+				        info.context_id, flows[i].cid);
+				goto free_channel;
+			}
+
+			/* decompress the packet and check it */
+			if(!test_channel_decompress(&channel, pkt_num, rohc_packet,
+			                            ip_packet))
+			{
+				goto free_channel;
+			}
+		}
+	}
+	fprintf(stderr, "%zu flows with %u packets each were compressed in their "
+	        "own contexts and decompressed correctly\n", flows_nr, TEST_PKTS_NR);
+
+	is_success = true;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_success;
+}
+
+
+/**
+ * @brief Build the given packet of the given TCP flow
+ *
+ * The TTL/Hop Limit, the TOS/Traffic Class and the content of the IPv6
+ * Destination Options extension header change every few packets.
+ *
+ * @param flow            The TCP flow
+ * @param pkt_num         The number of the packet in the flow
+ * @param[out] ip_packet  The IP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const struct test_flow *const flow,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t payload_len = 60;
+	const size_t change_nr = pkt_num / TEST_CHANGE_PERIOD;
+	uint8_t *data = rohc_buf_data(*ip_packet);
+	struct tcphdr *tcp_header;
+	size_t hdrs_len;
+	size_t i;
+
+	memset(data, 0, ip_packet->max_len);
+
+	if(flow->ip_version == 4)
+	{
+		struct ipv4_hdr *const ip_header = (struct ipv4_hdr *) data;
+
+		ip_header->version = 4;
+		ip_header->ihl = 5;
+		ip_header->tos = (change_nr % 2) * 0x20;
+		ip_header->id = htons(0x1000 + pkt_num);
+		ip_header->df = 1;
+		ip_header->ttl = 64 - (change_nr % 3);
+		ip_header->protocol = ROHC_IPPROTO_TCP;
+		ip_header->saddr = htonl(flow->saddr);
+		ip_header->daddr = htonl(0xc0a80002);
+		hdrs_len = sizeof(struct ipv4_hdr);
+	}
+	else
+	{
+		struct ipv6_hdr *const ip_header = (struct ipv6_hdr *) data;
+
+		/* IPv6 header with a Destination Options extension header */
+		ip_header->version_tc_flow =
+			htonl((6U << 28) | (((change_nr % 2) * 0x20) << 20) | flow->flow_label);
+		ip_header->nh = ROHC_IPPROTO_DSTOPTS;
+		ip_header->hl = 64 - (change_nr % 3);
+		ip_header->saddr.u8[0] = 0x20;
+		ip_header->saddr.u8[15] = flow->saddr;
+		ip_header->daddr.u8[0] = 0x20;
+		ip_header->daddr.u8[15] = 0x02;
+		hdrs_len = sizeof(struct ipv6_hdr);
+
+		/* Next Header, Hdr Ext Len, then one 4-byte option of unknown type
+		 * whose value changes */
+		data[hdrs_len] = ROHC_IPPROTO_TCP;
+		data[hdrs_len + 1] = 0;
+		data[hdrs_len + 2] = 0x1e;
+		data[hdrs_len + 3] = 4;
+		data[hdrs_len + 7] = change_nr & 0xff;
+		hdrs_len += 8;
+	}
+
+	/* TCP header of a bulk transfer */
+	tcp_header = (struct tcphdr *) (data + hdrs_len);
+	tcp_header->src_port = htons(flow->sport);
+	tcp_header->dst_port = htons(flow->dport);
+	tcp_header->seq_num = htonl(0x10000000 + pkt_num * payload_len);
+	tcp_header->ack_num = htonl(0x20000000);
+	tcp_header->data_offset = sizeof(struct tcphdr) / 4;
+	tcp_header->ack_flag = 1;
+	tcp_header->window = htons(8000);
+	tcp_header->checksum = htons(0x1234 + pkt_num);
+	hdrs_len += sizeof(struct tcphdr);
+
+	/* payload */
+	if(ip_packet->max_len < (hdrs_len + payload_len))
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+	for(i = hdrs_len; i < (hdrs_len + payload_len); i++)
+	{
+		data[i] = (i + pkt_num) & 0xff;
+	}
+	ip_packet->len = hdrs_len + payload_len;
+
+	/* IP lengths and checksum */
+	if(flow->ip_version == 4)
+	{
+		struct ipv4_hdr *const ip_header = (struct ipv4_hdr *) data;
+		uint32_t csum = 0;
+
+		ip_header->tot_len = htons(ip_packet->len);
+		for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+		{
+			csum += (data[i] << 8) | data[i + 1];
+		}
+		csum = (csum & 0xffff) + (csum >> 16);
+		csum = (csum & 0xffff) + (csum >> 16);
+		ip_header->check = htons((~csum) & 0xffff);
+	}
+	else
+	{
+		struct ipv6_hdr *const ip_header = (struct ipv6_hdr *) data;
+		ip_header->plen = htons(ip_packet->len - sizeof(struct ipv6_hdr));
+	}
+
+	return true;
+}
+
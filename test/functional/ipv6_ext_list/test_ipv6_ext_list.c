@@ -0,0 +1,462 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_ipv6_ext_list.c
+ * @brief  Check that changes of the IPv6 extension headers are transmitted
+ *         in the extension 3 of UOR-2 packets
+ * @author agent <agent@local>
+ *
+ * The application compresses an IPv6/UDP flow with the IP/UDP profile until
+ * the compressor reaches the SO state. The content of the Destination Options
+ * extension header is then changed, and later the extension header is
+ * removed. Both changes shall be transmitted in UOR-2 packets with the IPX
+ * flag of the extension 3 set, not in IR-DYN packets. Every packet shall be
+ * decompressed correctly.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+#include <stdarg.h>
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv6.h>
+#include <protocols/udp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The length of the Destination Options extension header */
+#define TEST_DSTOPTS_LEN  8U
+
+/** The number of packets to compress in every phase of the test */
+#define TEST_PKTS_PER_PHASE  20U
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_ipv6_ext_list(void);
+static bool compress_one(struct rohc_comp *const comp,
+                         struct rohc_decomp *const decomp,
+                         const size_t pkt_num,
+                         const bool with_dstopts,
+                         const uint8_t dstopts_value,
+                         rohc_packet_t *const packet_type,
+                         rohc_comp_state_t *const state)
+	__attribute__((warn_unused_result, nonnull(1, 2, 6, 7)));
+static bool check_list_change(struct rohc_comp *const comp,
+                              struct rohc_decomp *const decomp,
+                              size_t *const pkt_num,
+                              const bool with_dstopts,
+                              const uint8_t dstopts_value)
+	__attribute__((warn_unused_result, nonnull(1, 2, 3)));
+static void print_rohc_traces(void *const priv_ctxt,
+                              const rohc_trace_level_t level,
+                              const rohc_trace_entity_t entity,
+                              const int profile,
+                              const char *const format,
+                              ...)
+	__attribute__((format(printf, 5, 6), nonnull(5)));
+static int gen_random_num(const struct rohc_comp *const comp,
+                          void *const user_context)
+	__attribute__((nonnull(1)));
+
+
+/**
+ * @brief Check that changes of the IPv6 extension headers are transmitted
+ *        in UOR-2 packets
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	status = test_ipv6_ext_list();
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check that changes of the IPv6 extension headers are transmitted "
+	        "in UOR-2 packets\n"
+	        "\n"
+	        "usage: test_ipv6_ext_list [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Change the IPv6 extension headers of an established flow
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_ipv6_ext_list(void)
+{
+	struct rohc_comp *comp;
+	struct rohc_decomp *decomp;
+	rohc_packet_t packet_type;
+	rohc_comp_state_t state;
+	size_t pkt_num;
+	int is_failure = 1;
+
+	/* create the ROHC compressor with small CID */
+	comp = rohc_comp_new2(ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                      gen_random_num, NULL);
+	if(comp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC compressor\n");
+		goto error;
+	}
+	if(!rohc_comp_set_traces_cb2(comp, print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "compressor\n");
+		goto destroy_comp;
+	}
+	if(!rohc_comp_enable_profile(comp, ROHC_PROFILE_UDP))
+	{
+		fprintf(stderr, "failed to enable the IP/UDP profile\n");
+		goto destroy_comp;
+	}
+
+	/* create the ROHC decompressor in unidirectional mode */
+	decomp = rohc_decomp_new2(ROHC_SMALL_CID, ROHC_SMALL_CID_MAX, ROHC_U_MODE);
+	if(decomp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC decompressor\n");
+		goto destroy_comp;
+	}
+	if(!rohc_decomp_set_traces_cb2(decomp, print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "decompressor\n");
+		goto destroy_decomp;
+	}
+	if(!rohc_decomp_enable_profile(decomp, ROHC_PROFILE_UDP))
+	{
+		fprintf(stderr, "failed to enable the IP/UDP profile\n");
+		goto destroy_decomp;
+	}
+
+	/* establish the context with one Destination Options extension header */
+	for(pkt_num = 0; pkt_num < TEST_PKTS_PER_PHASE; pkt_num++)
+	{
+		if(!compress_one(comp, decomp, pkt_num, true, 0x11,
+		                 &packet_type, &state))
+		{
+			goto destroy_decomp;
+		}
+	}
+	if(state != ROHC_COMP_STATE_SO)
+	{
+		fprintf(stderr, "compressor did not reach the SO state after %u "
+		        "packets\n", TEST_PKTS_PER_PHASE);
+		goto destroy_decomp;
+	}
+
+	/* change the content of the extension header */
+	fprintf(stderr, "change the content of the Destination Options header\n");
+	if(!check_list_change(comp, decomp, &pkt_num, true, 0x22))
+	{
+		goto destroy_decomp;
+	}
+
+	/* remove the extension header */
+	fprintf(stderr, "remove the Destination Options header\n");
+	if(!check_list_change(comp, decomp, &pkt_num, false, 0x00))
+	{
+		goto destroy_decomp;
+	}
+
+	is_failure = 0;
+
+destroy_decomp:
+	rohc_decomp_free(decomp);
+destroy_comp:
+	rohc_comp_free(comp);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Change the IPv6 extension headers and check the packets sent
+ *
+ * The first packet with the new extension headers shall be an UOR-2 packet.
+ * The next packets shall be compressed and decompressed successfully.
+ *
+ * @param comp           The ROHC compressor
+ * @param decomp         The ROHC decompressor
+ * @param[in,out] pkt_num  The number of the next packet in the flow
+ * @param with_dstopts   Whether the packets contain a Destination Options
+ *                       extension header
+ * @param dstopts_value  The value of the option in the Destination Options
+ *                       extension header
+ * @return               true if the change was transmitted as expected,
+ *                       false otherwise
+ */
+static bool check_list_change(struct rohc_comp *const comp,
+                              struct rohc_decomp *const decomp,
+                              size_t *const pkt_num,
+                              const bool with_dstopts,
+                              const uint8_t dstopts_value)
+{
+	const size_t last_pkt_num = (*pkt_num) + TEST_PKTS_PER_PHASE;
+	rohc_packet_t packet_type;
+	rohc_comp_state_t state;
+
+	if(!compress_one(comp, decomp, *pkt_num, with_dstopts, dstopts_value,
+	                 &packet_type, &state))
+	{
+		goto error;
+	}
+	if(packet_type != ROHC_PACKET_UOR_2)
+	{
+		fprintf(stderr, "\tchange of extension headers transmitted in %s packet "
+		        "instead of %s packet\n", rohc_get_packet_descr(packet_type),
+		        rohc_get_packet_descr(ROHC_PACKET_UOR_2));
+		goto error;
+	}
+	fprintf(stderr, "\tchange of extension headers transmitted in %s packet "
+	        "as expected\n", rohc_get_packet_descr(packet_type));
+	(*pkt_num)++;
+
+	for( ; (*pkt_num) < last_pkt_num; (*pkt_num)++)
+	{
+		if(!compress_one(comp, decomp, *pkt_num, with_dstopts, dstopts_value,
+		                 &packet_type, &state))
+		{
+			goto error;
+		}
+		if(packet_type == ROHC_PACKET_IR || packet_type == ROHC_PACKET_IR_DYN)
+		{
+			fprintf(stderr, "\tunexpected %s packet for packet #%zu\n",
+			        rohc_get_packet_descr(packet_type), (*pkt_num) + 1);
+			goto error;
+		}
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Compress and decompress the given packet of the IPv6/UDP flow
+ *
+ * @param comp              The ROHC compressor
+ * @param decomp            The ROHC decompressor
+ * @param pkt_num           The number of the packet in the IPv6/UDP flow
+ * @param with_dstopts      Whether the packet contains a Destination Options
+ *                          extension header
+ * @param dstopts_value     The value of the option in the Destination Options
+ *                          extension header
+ * @param[out] packet_type  The type of ROHC packet that was created
+ * @param[out] state        The compressor state used for the packet
+ * @return                  true if the packet was successfully compressed
+ *                          and decompressed, false otherwise
+ */
+static bool compress_one(struct rohc_comp *const comp,
+                         struct rohc_decomp *const decomp,
+                         const size_t pkt_num,
+                         const bool with_dstopts,
+                         const uint8_t dstopts_value,
+                         rohc_packet_t *const packet_type,
+                         rohc_comp_state_t *const state)
+{
+	const size_t payload_len = 20;
+	const size_t ext_len = (with_dstopts ? TEST_DSTOPTS_LEN : 0);
+	const size_t ip_len =
+		sizeof(struct ipv6_hdr) + ext_len + sizeof(struct udphdr) + payload_len;
+
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf ip_packet = rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf rohc_packet =
+		rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+	uint8_t uncomp_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf uncomp_packet =
+		rohc_buf_init_empty(uncomp_buffer, TEST_MAX_PKT_SIZE);
+
+	rohc_comp_last_packet_info2_t info;
+	struct ipv6_hdr *ip_header;
+	struct udphdr *udp_header;
+	uint8_t *ext;
+	rohc_status_t status;
+	size_t i;
+
+	/* generate the IPv6 header */
+	ip_packet.len = ip_len;
+	memset(rohc_buf_data(ip_packet), 0, ip_len);
+	ip_header = (struct ipv6_hdr *) rohc_buf_data(ip_packet);
+	ip_header->version_tc_flow = htonl(0x60000000);
+	ip_header->plen = htons(ip_len - sizeof(struct ipv6_hdr));
+	ip_header->nh = (with_dstopts ? ROHC_IPPROTO_DSTOPTS : ROHC_IPPROTO_UDP);
+	ip_header->hl = 64;
+	ip_header->saddr.u8[0] = 0x20;
+	ip_header->saddr.u8[1] = 0x01;
+	ip_header->saddr.u8[15] = 0x01;
+	ip_header->daddr.u8[0] = 0x20;
+	ip_header->daddr.u8[1] = 0x01;
+	ip_header->daddr.u8[15] = 0x02;
+	ext = (uint8_t *) (ip_header + 1);
+
+	/* generate the Destination Options extension header with one option
+	 * that is skipped by the nodes that do not recognize it */
+	if(with_dstopts)
+	{
+		ext[0] = ROHC_IPPROTO_UDP; /* next header */
+		ext[1] = (TEST_DSTOPTS_LEN / 8) - 1; /* length */
+		ext[2] = 0x1e; /* option type */
+		ext[3] = 4; /* option length */
+		memset(ext + 4, dstopts_value, 4);
+	}
+
+	/* generate the UDP header and its payload */
+	udp_header = (struct udphdr *) (ext + ext_len);
+	udp_header->source = htons(1234);
+	udp_header->dest = htons(1235);
+	udp_header->len = htons(sizeof(struct udphdr) + payload_len);
+	udp_header->check = htons(0x1234 + pkt_num);
+	for(i = ip_len - payload_len; i < ip_len; i++)
+	{
+		rohc_buf_byte_at(ip_packet, i) = i & 0xff;
+	}
+
+	/* compress the packet */
+	status = rohc_compress4(comp, ip_packet, &rohc_packet);
+	if(status != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "failed to compress packet #%zu\n", pkt_num + 1);
+		goto error;
+	}
+	info.version_major = 0;
+	info.version_minor = 0;
+	if(!rohc_comp_get_last_packet_info2(comp, &info))
+	{
+		fprintf(stderr, "failed to get compression info for packet #%zu\n",
+		        pkt_num + 1);
+		goto error;
+	}
+	*packet_type = info.packet_type;
+	*state = info.context_state;
+
+	/* decompress the packet and check that it was rebuilt correctly */
+	status = rohc_decompress3(decomp, rohc_packet, &uncomp_packet, NULL, NULL);
+	if(status != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "failed to decompress packet #%zu\n", pkt_num + 1);
+		goto error;
+	}
+	if(uncomp_packet.len != ip_packet.len ||
+	   memcmp(rohc_buf_data(uncomp_packet), rohc_buf_data(ip_packet),
+	          ip_packet.len) != 0)
+	{
+		fprintf(stderr, "packet #%zu was not decompressed correctly\n",
+		        pkt_num + 1);
+		goto error;
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Callback to print traces of the ROHC library
+ *
+ * @param priv_ctxt  An optional private context, may be NULL
+ * @param level      The priority level of the trace
+ * @param entity     The entity that emitted the trace among:
+ *                    \li ROHC_TRACE_COMP
+ *                    \li ROHC_TRACE_DECOMP
+ * @param profile    The ID of the ROHC compression/decompression profile
+ *                   the trace is related to
+ * @param format     The format string of the trace
+ */
+static void print_rohc_traces(void *const priv_ctxt,
+                              const rohc_trace_level_t level,
+                              const rohc_trace_entity_t entity,
+                              const int profile,
+                              const char *const format,
+                              ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	vfprintf(stdout, format, args);
+	va_end(args);
+}
+
+
+/**
+ * @brief Generate a random number for testing the ROHC library
+ *
+ * @param comp          The ROHC compressor
+ * @param user_context  Should always be NULL
+ * @return              A random number
+ */
+static int gen_random_num(const struct rohc_comp *const comp,
+                          void *const user_context)
+{
+	return rand();
+}
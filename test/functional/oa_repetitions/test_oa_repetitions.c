@@ -0,0 +1,496 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_oa_repetitions.c
+ * @brief  Check that the repetitions of the optimistic approach follow the
+ *         channel
+ * @author agent <agent@local>
+ *
+ * The application compresses one TCP flow and counts the packets that the
+ * compressor sends in the IR state (after the creation of the context or a
+ * STATIC-NACK) or in the FO state (after a NACK) before it reaches the SO
+ * state:
+ *  \li in U-mode, the number of packets per state shall follow the BER
+ *      configured with rohc_comp_set_channel_ber(),
+ *  \li in O-mode, every NACK or STATIC-NACK shall add one packet per state,
+ *      every group of 8 consecutive positive ACKs shall remove one.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/tcp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* ROHC internal includes */
+#include <feedback.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The max number of packets to compress before the SO state is reached */
+#define TEST_MAX_PKTS_TO_SO  30U
+
+
+/** The number of repetitions expected for one BER of the channel */
+struct test_ber
+{
+	size_t ber_exp;         /**< The BER as a negative power of ten */
+	size_t repetitions_nr;  /**< The number of repetitions expected */
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_oa_repetitions_ber(const struct test_ber *const ber)
+	__attribute__((warn_unused_result, nonnull(1)));
+static int test_oa_repetitions_feedback(void)
+	__attribute__((warn_unused_result));
+static bool compress_until_so(struct test_channel *const channel,
+                              size_t *const pkt_num,
+                              const size_t ir_expected,
+                              const size_t fo_expected)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
+static bool build_packet(const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(2)));
+static bool deliver_feedback2(struct rohc_comp *const comp,
+                              const enum rohc_feedback_ack_type ack_type,
+                              const size_t pkt_num)
+	__attribute__((warn_unused_result, nonnull(1)));
+static uint8_t crc8(const uint8_t *const data, const size_t len)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+
+/**
+ * @brief Check that the repetitions of the optimistic approach follow the
+ *        channel
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	const struct test_ber bers[] = {
+		{ .ber_exp = 0, .repetitions_nr = 3 }, /* unknown BER, the default */
+		{ .ber_exp = 9, .repetitions_nr = 1 },
+		{ .ber_exp = 6, .repetitions_nr = 2 },
+		{ .ber_exp = 5, .repetitions_nr = 3 },
+		{ .ber_exp = 4, .repetitions_nr = 6 },
+		{ .ber_exp = 3, .repetitions_nr = 8 },
+	};
+	int status = 1;
+	size_t i;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	for(i = 0; i < sizeof(bers) / sizeof(bers[0]); i++)
+	{
+		status = test_oa_repetitions_ber(&bers[i]);
+		if(status != 0)
+		{
+			goto error;
+		}
+	}
+
+	status = test_oa_repetitions_feedback();
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check that the repetitions of the optimistic approach follow the "
+	        "channel\n"
+	        "\n"
+	        "usage: test_oa_repetitions [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Check the repetitions derived from the BER of the channel in U-mode
+ *
+ * @param ber  The BER to configure and the number of repetitions expected
+ * @return     0 in case of success,
+ *             1 in case of failure
+ */
+static int test_oa_repetitions_ber(const struct test_ber *const ber)
+{
+	struct test_channel channel;
+	size_t pkt_num = 0;
+	int is_failure = 1;
+
+	fprintf(stderr, "test BER 10^-%zu: %zu repetitions expected\n",
+	        ber->ber_exp, ber->repetitions_nr);
+
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_enable_profile(&channel, ROHC_PROFILE_TCP))
+	{
+		goto free_channel;
+	}
+	if(!rohc_comp_set_channel_ber(channel.comp, ber->ber_exp))
+	{
+		fprintf(stderr, "failed to set the BER of the channel\n");
+		goto free_channel;
+	}
+
+	if(!compress_until_so(&channel, &pkt_num, ber->repetitions_nr, 0))
+	{
+		goto free_channel;
+	}
+
+	is_failure = 0;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Check the repetitions adapted to the feedback in O-mode
+ *
+ * The BER of the channel is unknown, so the compressor starts with 3
+ * repetitions. Two NACKs raise them to 5, two groups of 8 positive ACKs
+ * lower them to 3, one STATIC-NACK raises them to 4, and a burst of 10 NACKs
+ * raises them to the maximum of 8.
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_oa_repetitions_feedback(void)
+{
+	struct test_channel channel;
+	size_t pkt_num = 0;
+	size_t i;
+	int is_failure = 1;
+
+	fprintf(stderr, "test repetitions adapted to feedback in O-mode\n");
+
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_O_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_enable_profile(&channel, ROHC_PROFILE_TCP))
+	{
+		goto free_channel;
+	}
+
+	/* establish the context with the default number of repetitions */
+	if(!compress_until_so(&channel, &pkt_num, 3, 0))
+	{
+		goto free_channel;
+	}
+
+	/* two NACKs: one more repetition each */
+	for(i = 0; i < 2; i++)
+	{
+		if(!deliver_feedback2(channel.comp, ROHC_FEEDBACK_NACK, pkt_num - 1))
+		{
+			goto free_channel;
+		}
+	}
+	if(!compress_until_so(&channel, &pkt_num, 0, 5))
+	{
+		goto free_channel;
+	}
+
+	/* two groups of 8 positive ACKs: one repetition less each */
+	for(i = 0; i < 16; i++)
+	{
+		if(!deliver_feedback2(channel.comp, ROHC_FEEDBACK_ACK, pkt_num - 1))
+		{
+			goto free_channel;
+		}
+	}
+
+	/* one STATIC-NACK: one more repetition */
+	if(!deliver_feedback2(channel.comp, ROHC_FEEDBACK_STATIC_NACK, pkt_num - 1))
+	{
+		goto free_channel;
+	}
+	if(!compress_until_so(&channel, &pkt_num, 4, 0))
+	{
+		goto free_channel;
+	}
+
+	/* a burst of NACKs: the repetitions are capped */
+	for(i = 0; i < 10; i++)
+	{
+		if(!deliver_feedback2(channel.comp, ROHC_FEEDBACK_NACK, pkt_num - 1))
+		{
+			goto free_channel;
+		}
+	}
+	if(!compress_until_so(&channel, &pkt_num, 0, 8))
+	{
+		goto free_channel;
+	}
+
+	is_failure = 0;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Compress the TCP flow until the compressor reaches the SO state
+ *
+ * @param channel         The test channel
+ * @param pkt_num         IN: the number of the next packet in the TCP flow,
+ *                        OUT: the number of the packet after the first one
+ *                        sent in the SO state
+ * @param ir_expected     The number of packets expected in the IR state
+ * @param fo_expected     The number of packets expected in the FO state
+ * @return                true if the number of packets per state is the
+ *                        expected one, false otherwise
+ */
+static bool compress_until_so(struct test_channel *const channel,
+                              size_t *const pkt_num,
+                              const size_t ir_expected,
+                              const size_t fo_expected)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	rohc_comp_last_packet_info2_t info;
+	size_t ir_nr = 0;
+	size_t fo_nr = 0;
+	size_t i;
+
+	info.context_state = ROHC_COMP_STATE_UNKNOWN;
+	for(i = 0; i < TEST_MAX_PKTS_TO_SO &&
+	           info.context_state != ROHC_COMP_STATE_SO; i++)
+	{
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+		if(!build_packet(*pkt_num, &ip_packet) ||
+		   !test_channel_transmit(channel, *pkt_num, ip_packet, &rohc_packet,
+		                          &info))
+		{
+			return false;
+		}
+		(*pkt_num)++;
+
+		if(info.context_state == ROHC_COMP_STATE_IR)
+		{
+			ir_nr++;
+		}
+		else if(info.context_state == ROHC_COMP_STATE_FO)
+		{
+			fo_nr++;
+		}
+	}
+	fprintf(stderr, "\t%zu packets in IR state, %zu packets in FO state\n",
+	        ir_nr, fo_nr);
+
+	if(info.context_state != ROHC_COMP_STATE_SO)
+	{
+		fprintf(stderr, "\tcompressor did not reach the SO state after %u "
+		        "packets\n", TEST_MAX_PKTS_TO_SO);
+		return false;
+	}
+	if(ir_nr != ir_expected || fo_nr != fo_expected)
+	{
+		fprintf(stderr, "\t%zu packets in IR state and %zu packets in FO "
+		        "state expected\n", ir_expected, fo_expected);
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Build one packet of the IPv4/TCP flow
+ *
+ * @param pkt_num         The number of the packet in the TCP flow
+ * @param[out] ip_packet  The IPv4/TCP packet
+ * @return                true if the packet was built, false otherwise
+ */
+static bool build_packet(const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t payload_len = 10;
+	const size_t ip_len =
+		sizeof(struct ipv4_hdr) + sizeof(struct tcphdr) + payload_len;
+	struct ipv4_hdr *ip_header;
+	struct tcphdr *tcp_header;
+	uint32_t csum = 0;
+	size_t i;
+
+	if(ip_len > rohc_buf_avail_len(*ip_packet))
+	{
+		fprintf(stderr, "\tno room for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+
+	ip_packet->len = ip_len;
+	memset(rohc_buf_data(*ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(*ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + pkt_num);
+	ip_header->ttl = 64;
+	ip_header->protocol = ROHC_IPPROTO_TCP;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(*ip_packet, i) << 8) |
+		        rohc_buf_byte_at(*ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+	tcp_header = (struct tcphdr *) (ip_header + 1);
+	tcp_header->src_port = htons(1234);
+	tcp_header->dst_port = htons(80);
+	tcp_header->seq_num = htonl(0x10000000 + pkt_num * payload_len);
+	tcp_header->ack_num = htonl(0x20000000);
+	tcp_header->data_offset = sizeof(struct tcphdr) / 4;
+	tcp_header->ack_flag = 1;
+	tcp_header->window = htons(8192);
+	tcp_header->checksum = htons(0x1234 + pkt_num);
+	for(i = sizeof(struct ipv4_hdr) + sizeof(struct tcphdr); i < ip_len; i++)
+	{
+		rohc_buf_byte_at(*ip_packet, i) = i & 0xff;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Deliver one TCP FEEDBACK-2 for CID 0 to the compressor
+ *
+ * The MSN of the TCP context starts at 1 since the random callback of the
+ * test channel always returns 0.
+ *
+ * @param comp      The ROHC compressor
+ * @param ack_type  The type of feedback: ACK, NACK or STATIC-NACK
+ * @param pkt_num   The number of the packet acknowledged by the feedback
+ * @return          true if the feedback was successfully delivered,
+ *                  false otherwise
+ */
+static bool deliver_feedback2(struct rohc_comp *const comp,
+                              const enum rohc_feedback_ack_type ack_type,
+                              const size_t pkt_num)
+{
+	const struct rohc_ts arrival_time = { .sec = 0, .nsec = 0 };
+	const uint16_t msn = (pkt_num + 1) & 0xffff;
+	uint8_t feedback_data[4];
+	const struct rohc_buf feedback =
+		rohc_buf_init_full(feedback_data, 4, arrival_time);
+
+	/* RFC 6846, §8.3.2: Acktype, 14-bit MSN and CRC-8 */
+	feedback_data[0] = 0xf0 | 3; /* feedback type + size */
+	feedback_data[1] = ((ack_type & 0x3) << 6) | ((msn >> 8) & 0x3f);
+	feedback_data[2] = msn & 0xff;
+	feedback_data[3] = 0x00;
+	feedback_data[3] = crc8(feedback_data + 1, 3);
+
+	if(!rohc_comp_deliver_feedback2(comp, feedback))
+	{
+		fprintf(stderr, "\tfailed to deliver the feedback for packet #%zu\n",
+		        pkt_num + 1);
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Compute the 8-bit CRC of the feedback as defined by RFC 3095
+ *
+ * @param data  The data to compute the CRC for
+ * @param len   The length of the data
+ * @return      The 8-bit CRC
+ */
+static uint8_t crc8(const uint8_t *const data, const size_t len)
+{
+	uint8_t crc = 0xff;
+	size_t i;
+	size_t j;
+
+	for(i = 0; i < len; i++)
+	{
+		crc ^= data[i];
+		for(j = 0; j < 8; j++)
+		{
+			crc = (crc & 1) ? ((crc >> 1) ^ 0xe0) : (crc >> 1);
+		}
+	}
+
+	return crc;
+}
+
@@ -0,0 +1,515 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_profile_cache.c
+ * @brief  Check the cache of the flows that no specific profile accepts
+ * @author agent <agent@local>
+ *
+ * The compressor remembers the flows that all the specific profiles reject,
+ * and gives their next packets to the IP-only or Uncompressed profile
+ * directly. The application compresses such flows while it enables and
+ * disables profiles: every packet shall be compressed with the best enabled
+ * profile, and decompressed correctly.
+ *
+ * The application then compresses a flow of UDP fragments: the first bytes
+ * of the non-first fragments are payload, not UDP ports, so all the
+ * fragments shall share the entry of the flow in the cache.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/udp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** An IP protocol that no specific profile accepts */
+#define TEST_OTHER_PROTO  253U
+
+/** The number of packets of the flow of UDP fragments */
+#define TEST_FRAGS_NR  40U
+
+
+/** The lookups of profiles that the compressor made */
+struct test_lookups
+{
+	size_t cache_hits_nr;  /**< The lookups answered by the cache */
+	size_t full_nr;        /**< The lookups that asked every profile */
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_profile_cache(void);
+static int test_profile_cache_fragments(void);
+static bool build_packet(const uint8_t protocol,
+                         const bool is_fragmented,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(4)));
+static bool compress_flow(struct test_channel *const channel,
+                          const uint8_t protocol,
+                          const bool is_fragmented,
+                          size_t *const pkt_num,
+                          const size_t pkts_nr,
+                          const int exp_profile_id)
+	__attribute__((warn_unused_result, nonnull(1, 4)));
+static void count_lookups(void *const priv_ctxt,
+                          const rohc_trace_level_t level,
+                          const rohc_trace_entity_t entity,
+                          const int profile,
+                          const char *const format,
+                          ...)
+	__attribute__((format(printf, 5, 6), nonnull(1, 5)));
+
+
+/**
+ * @brief Check the cache of the flows that no specific profile accepts
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	status = test_profile_cache();
+	if(status == 0)
+	{
+		status = test_profile_cache_fragments();
+	}
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the cache of the flows that no specific profile accepts\n"
+	        "\n"
+	        "usage: test_profile_cache [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Compress flows that no specific profile accepts, toggle profiles
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_profile_cache(void)
+{
+	struct test_channel channel;
+	size_t other_pkt_num = 0;
+	size_t udp_pkt_num = 0;
+	int is_failure = 1;
+
+	/* create the ROHC compressor and decompressor with small CID in
+	 * unidirectional mode */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!rohc_comp_enable_profiles(channel.comp, ROHC_PROFILE_UNCOMPRESSED,
+	                              ROHC_PROFILE_UDP, ROHC_PROFILE_ESP,
+	                              ROHC_PROFILE_IP, -1))
+	{
+		fprintf(stderr, "failed to enable the compression profiles\n");
+		goto free_channel;
+	}
+	if(!rohc_decomp_enable_profiles(channel.decomp, ROHC_PROFILE_UNCOMPRESSED,
+	                                ROHC_PROFILE_UDP, ROHC_PROFILE_ESP,
+	                                ROHC_PROFILE_IP, -1))
+	{
+		fprintf(stderr, "failed to enable the decompression profiles\n");
+		goto free_channel;
+	}
+
+	/* the UDP flow is compressed with the UDP profile */
+	if(!compress_flow(&channel, ROHC_IPPROTO_UDP, false, &udp_pkt_num, 10,
+	                  ROHC_PROFILE_UDP))
+	{
+		goto free_channel;
+	}
+
+	/* the other flow is compressed with the IP-only profile, even once its
+	 * entry in the cache expired */
+	if(!compress_flow(&channel, TEST_OTHER_PROTO, false, &other_pkt_num, 150,
+	                  ROHC_PROFILE_IP))
+	{
+		goto free_channel;
+	}
+	fprintf(stderr, "flow rejected by specific profiles compressed with the "
+	        "IP-only profile\n");
+
+	/* once the IP-only profile is disabled, the other flow is compressed with
+	 * the Uncompressed profile */
+	if(!rohc_comp_disable_profile(channel.comp, ROHC_PROFILE_IP))
+	{
+		fprintf(stderr, "failed to disable the IP-only profile\n");
+		goto free_channel;
+	}
+	if(!compress_flow(&channel, TEST_OTHER_PROTO, false, &other_pkt_num, 10,
+	                  ROHC_PROFILE_UNCOMPRESSED))
+	{
+		goto free_channel;
+	}
+	fprintf(stderr, "IP-only profile disabled: flow compressed with the "
+	        "Uncompressed profile\n");
+
+	/* once the IP-only profile is enabled again, the other flow shall not
+	 * stick to the Uncompressed profile remembered in the cache */
+	if(!rohc_comp_enable_profile(channel.comp, ROHC_PROFILE_IP))
+	{
+		fprintf(stderr, "failed to enable the IP-only profile\n");
+		goto free_channel;
+	}
+	if(!compress_flow(&channel, TEST_OTHER_PROTO, false, &other_pkt_num, 10,
+	                  ROHC_PROFILE_IP))
+	{
+		goto free_channel;
+	}
+	fprintf(stderr, "IP-only profile enabled: flow compressed with the "
+	        "IP-only profile again\n");
+
+	/* once the UDP profile is disabled, the UDP flow is rejected by the ESP
+	 * profile and compressed with the IP-only profile */
+	if(!rohc_comp_disable_profile(channel.comp, ROHC_PROFILE_UDP))
+	{
+		fprintf(stderr, "failed to disable the UDP profile\n");
+		goto free_channel;
+	}
+	if(!compress_flow(&channel, ROHC_IPPROTO_UDP, false, &udp_pkt_num, 10,
+	                  ROHC_PROFILE_IP))
+	{
+		goto free_channel;
+	}
+	fprintf(stderr, "UDP profile disabled: UDP flow compressed with the "
+	        "IP-only profile\n");
+
+	/* once the UDP profile is enabled again, the UDP flow shall not stick to
+	 * the IP-only profile remembered in the cache */
+	if(!rohc_comp_enable_profile(channel.comp, ROHC_PROFILE_UDP))
+	{
+		fprintf(stderr, "failed to enable the UDP profile\n");
+		goto free_channel;
+	}
+	if(!compress_flow(&channel, ROHC_IPPROTO_UDP, false, &udp_pkt_num, 10,
+	                  ROHC_PROFILE_UDP))
+	{
+		goto free_channel;
+	}
+	fprintf(stderr, "UDP profile enabled: UDP flow compressed with the UDP "
+	        "profile again\n");
+
+	is_failure = 0;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Compress a flow of UDP fragments, count the lookups of profiles
+ *
+ * The first packet of the flow asks every profile, all the next ones shall
+ * be answered by the cache, the first fragments as well as the non-first
+ * ones.
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_profile_cache_fragments(void)
+{
+	struct test_lookups lookups = { .cache_hits_nr = 0, .full_nr = 0 };
+	struct test_channel channel;
+	size_t pkt_num = 0;
+	int is_failure = 1;
+
+	/* create the ROHC compressor and decompressor with small CID in
+	 * unidirectional mode, count the lookups of profiles in the traces */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!rohc_comp_set_traces_cb2(channel.comp, count_lookups, &lookups))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "compressor\n");
+		goto free_channel;
+	}
+	if(!rohc_comp_enable_profiles(channel.comp, ROHC_PROFILE_UNCOMPRESSED,
+	                              ROHC_PROFILE_UDP, ROHC_PROFILE_IP, -1))
+	{
+		fprintf(stderr, "failed to enable the compression profiles\n");
+		goto free_channel;
+	}
+	if(!rohc_decomp_enable_profiles(channel.decomp, ROHC_PROFILE_UNCOMPRESSED,
+	                                ROHC_PROFILE_UDP, ROHC_PROFILE_IP, -1))
+	{
+		fprintf(stderr, "failed to enable the decompression profiles\n");
+		goto free_channel;
+	}
+
+	/* the UDP fragments are compressed with the Uncompressed profile */
+	if(!compress_flow(&channel, ROHC_IPPROTO_UDP, true, &pkt_num,
+	                  TEST_FRAGS_NR, ROHC_PROFILE_UNCOMPRESSED))
+	{
+		goto free_channel;
+	}
+	fprintf(stderr, "%zu UDP fragments: %zu profile lookups answered by the "
+	        "cache, %zu full lookups\n", pkt_num, lookups.cache_hits_nr,
+	        lookups.full_nr);
+	if(lookups.full_nr != 1 || lookups.cache_hits_nr != (TEST_FRAGS_NR - 1))
+	{
+		fprintf(stderr, "all the UDP fragments but the first one shall be "
+		        "answered by the cache\n");
+		goto free_channel;
+	}
+
+	is_failure = 0;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Build the given packet of the IPv4 flow with the given protocol
+ *
+ * The packets of a fragmented flow are alternatively a first fragment and
+ * the last fragment of an IP datagram.
+ *
+ * @param protocol        The IP protocol of the flow
+ * @param is_fragmented   Whether the packets of the flow are IP fragments
+ * @param pkt_num         The number of the packet in the IPv4 flow
+ * @param[out] ip_packet  The IPv4 packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const uint8_t protocol,
+                         const bool is_fragmented,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const bool is_first_fragment = ((pkt_num % 2) == 0);
+	const size_t payload_len = 28;
+	const size_t ip_len = sizeof(struct ipv4_hdr) + payload_len;
+	struct ipv4_hdr *ip_header;
+	uint32_t csum = 0;
+	size_t i;
+
+	if(ip_packet->max_len < ip_len)
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+
+	/* generate the IPv4 header with a sequential IP-ID */
+	ip_packet->len = ip_len;
+	memset(rohc_buf_data(*ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(*ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + pkt_num);
+	if(is_fragmented)
+	{
+		ip_header->frag_off = htons(is_first_fragment ? IPV4_MF : 3);
+	}
+	ip_header->ttl = 64;
+	ip_header->protocol = protocol;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(*ip_packet, i) << 8) |
+		        rohc_buf_byte_at(*ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* generate the payload, a UDP header first for UDP flows but in non-first
+	 * fragments */
+	for(i = sizeof(struct ipv4_hdr); i < ip_len; i++)
+	{
+		rohc_buf_byte_at(*ip_packet, i) = (i + pkt_num) & 0xff;
+	}
+	if(protocol == ROHC_IPPROTO_UDP && (!is_fragmented || is_first_fragment))
+	{
+		struct udphdr *const udp_header = (struct udphdr *) (ip_header + 1);
+		udp_header->source = htons(1234);
+		udp_header->dest = htons(1235);
+		udp_header->len = htons(payload_len);
+		udp_header->check = 0;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Compress and decompress packets of the IPv4 flow with given protocol
+ *
+ * @param channel         The ROHC channel
+ * @param protocol        The IP protocol of the flow
+ * @param is_fragmented   Whether the packets of the flow are IP fragments
+ * @param pkt_num         IN: the number of the first packet to compress,
+ *                        OUT: the number of the next packet to compress
+ * @param pkts_nr         The number of packets to compress
+ * @param exp_profile_id  The profile expected for the packets
+ * @return                true if the packets were compressed with the
+ *                        expected profile and decompressed correctly,
+ *                        false otherwise
+ */
+static bool compress_flow(struct test_channel *const channel,
+                          const uint8_t protocol,
+                          const bool is_fragmented,
+                          size_t *const pkt_num,
+                          const size_t pkts_nr,
+                          const int exp_profile_id)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	rohc_comp_last_packet_info2_t info;
+	size_t i;
+
+	for(i = 0; i < pkts_nr; i++, (*pkt_num)++)
+	{
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+		if(!build_packet(protocol, is_fragmented, *pkt_num, &ip_packet))
+		{
+			goto error;
+		}
+
+		if(!test_channel_compress(channel, *pkt_num, ip_packet, &rohc_packet,
+		                          &info))
+		{
+			goto error;
+		}
+		if(info.profile_id != exp_profile_id)
+		{
+			fprintf(stderr, "packet #%zu of protocol %u was compressed with "
+			        "profile 0x%04x instead of profile 0x%04x\n", *pkt_num + 1,
+			        protocol, info.profile_id, exp_profile_id);
+			goto error;
+		}
+
+		if(!test_channel_decompress(channel, *pkt_num, rohc_packet, ip_packet))
+		{
+			goto error;
+		}
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Callback to count the lookups of profiles in the compressor traces
+ *
+ * The traces are printed as with \ref test_print_rohc_traces.
+ *
+ * @param priv_ctxt  The lookups of profiles counted so far
+ * @param level      The priority level of the trace
+ * @param entity     The entity that emitted the trace
+ * @param profile    The ID of the ROHC compression/decompression profile
+ *                   the trace is related to
+ * @param format     The format string of the trace
+ */
+static void count_lookups(void *const priv_ctxt,
+                          const rohc_trace_level_t level,
+                          const rohc_trace_entity_t entity,
+                          const int profile,
+                          const char *const format,
+                          ...)
+{
+	struct test_lookups *const lookups = priv_ctxt;
+	va_list args;
+
+	if(strstr(format, "was rejected by all specific profiles") != NULL)
+	{
+		lookups->cache_hits_nr++;
+	}
+	else if(strstr(format, "try to find the best profile") != NULL)
+	{
+		lookups->full_nr++;
+	}
+
+	va_start(args, format);
+	vfprintf(stdout, format, args);
+	va_end(args);
+}
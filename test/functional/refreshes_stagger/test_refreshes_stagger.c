@@ -0,0 +1,550 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_refreshes_stagger.c
+ * @brief  Check the stagger and the rate limit of the periodic refreshes
+ * @author agent <agent@local>
+ *
+ * The application creates the contexts of 8 UDP flows at the same time,
+ * then compresses one packet of every flow per round. It records the rounds
+ * in which the contexts leave the SO state for a periodic refresh:
+ *  \li without jitter, all the contexts refresh in the same round,
+ *  \li with jitter, the refreshes are spread over several rounds, and no
+ *      context refreshes later than without jitter,
+ *  \li with a rate limit, the contexts that find the token bucket empty
+ *      postpone their refreshes, and the refreshes never exceed the tokens
+ *      that the compressed packets earned.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/udp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The number of flows, one context each */
+#define TEST_FLOWS_NR  8U
+
+/** The number of rounds of packets, one packet of every flow per round */
+#define TEST_ROUNDS_NR  40U
+
+/** The timeout (in packets) for the periodic refreshes to the IR state,
+ *  larger than the test */
+#define TEST_IR_TIMEOUT  1000U
+
+/** The timeout (in packets) for the periodic refreshes to the FO state */
+#define TEST_FO_TIMEOUT  20U
+
+/** The max jitter (in percent) of the timeouts of the periodic refreshes */
+#define TEST_JITTER  50U
+
+/** The number of periodic refreshes that may be done in a row */
+#define TEST_RATE_BURST  2U
+
+/** The number of packets to compress to get one more periodic refresh */
+#define TEST_RATE_INTERVAL  4U
+
+
+/** One UDP flow and the periodic refreshes of its context */
+struct test_flow
+{
+	uint16_t port;               /**< The UDP source port of the flow */
+	size_t pkts_nr;              /**< The number of packets sent so far */
+	rohc_comp_state_t state;     /**< The state of the context */
+	size_t first_refresh_round;  /**< The round of the first refresh */
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_refreshes_stagger(void);
+static int test_refreshes_rate(void);
+static bool create_channel(struct test_channel *const channel,
+                           unsigned int *const seed,
+                           const size_t jitter,
+                           const size_t rate_burst)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
+static bool run_flows(struct test_channel *const channel,
+                      struct test_flow flows[TEST_FLOWS_NR],
+                      const size_t rate_burst)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
+static bool build_packet(const struct test_flow *const flow,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(1, 2)));
+static int gen_random_num(const struct rohc_comp *const comp,
+                          void *const user_context)
+	__attribute__((nonnull(1, 2)));
+
+
+/**
+ * @brief Check the stagger and the rate limit of the periodic refreshes
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	status = test_refreshes_stagger();
+	if(status == 0)
+	{
+		status = test_refreshes_rate();
+	}
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the stagger and the rate limit of the periodic refreshes\n"
+	        "\n"
+	        "usage: test_refreshes_stagger [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Check that the jitter staggers the refreshes of contexts created
+ *        at the same time
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_refreshes_stagger(void)
+{
+	struct test_flow flows[TEST_FLOWS_NR];
+	struct test_channel channel;
+	unsigned int seed = 1;
+	size_t rounds_nr[TEST_ROUNDS_NR] = { 0 };
+	size_t sync_round;
+	size_t distinct_rounds_nr = 0;
+	size_t i;
+	int is_failure = 1;
+
+	/* without jitter, all the contexts refresh in the same round */
+	if(!create_channel(&channel, &seed, 0, 0))
+	{
+		goto error;
+	}
+	if(!run_flows(&channel, flows, 0))
+	{
+		goto free_channel;
+	}
+	test_channel_free(&channel);
+	sync_round = flows[0].first_refresh_round;
+	for(i = 1; i < TEST_FLOWS_NR; i++)
+	{
+		if(flows[i].first_refresh_round != sync_round)
+		{
+			fprintf(stderr, "without jitter, context #%zu refreshed in round "
+			        "#%zu instead of round #%zu\n", i,
+			        flows[i].first_refresh_round + 1, sync_round + 1);
+			goto error;
+		}
+	}
+	fprintf(stderr, "without jitter, all the contexts refreshed in round "
+	        "#%zu\n", sync_round + 1);
+
+	/* with jitter, the refreshes are spread, never later */
+	if(!create_channel(&channel, &seed, TEST_JITTER, 0))
+	{
+		goto error;
+	}
+	if(!run_flows(&channel, flows, 0))
+	{
+		goto free_channel;
+	}
+	for(i = 0; i < TEST_FLOWS_NR; i++)
+	{
+		fprintf(stderr, "with jitter, context #%zu refreshed in round #%zu\n",
+		        i, flows[i].first_refresh_round + 1);
+		if(flows[i].first_refresh_round > sync_round)
+		{
+			fprintf(stderr, "the jitter shall never delay the refreshes\n");
+			goto free_channel;
+		}
+		rounds_nr[flows[i].first_refresh_round]++;
+		if(rounds_nr[flows[i].first_refresh_round] == 1)
+		{
+			distinct_rounds_nr++;
+		}
+	}
+	if(distinct_rounds_nr < (TEST_FLOWS_NR / 2))
+	{
+		fprintf(stderr, "the refreshes of the %u contexts shall be spread over "
+		        "%u rounds at least, not %zu\n", TEST_FLOWS_NR,
+		        TEST_FLOWS_NR / 2, distinct_rounds_nr);
+		goto free_channel;
+	}
+
+	is_failure = 0;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Check that the token bucket postpones the refreshes once the rate
+ *        is used up
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_refreshes_rate(void)
+{
+	struct test_flow flows[TEST_FLOWS_NR];
+	struct test_channel channel;
+	unsigned int seed = 1;
+	size_t sync_round = TEST_ROUNDS_NR;
+	size_t postponed_nr = 0;
+	size_t i;
+	int is_failure = 1;
+
+	if(!create_channel(&channel, &seed, 0, TEST_RATE_BURST))
+	{
+		goto error;
+	}
+	if(!run_flows(&channel, flows, TEST_RATE_BURST))
+	{
+		goto free_channel;
+	}
+
+	/* all the timeouts expired in the same round, but only the contexts that
+	 * found a token refreshed: the full bucket plus the tokens earned by the
+	 * packets of the round, the next contexts waited for new tokens */
+	for(i = 0; i < TEST_FLOWS_NR; i++)
+	{
+		if(flows[i].first_refresh_round < sync_round)
+		{
+			sync_round = flows[i].first_refresh_round;
+		}
+	}
+	for(i = 0; i < TEST_FLOWS_NR; i++)
+	{
+		fprintf(stderr, "with rate limit, context #%zu refreshed in round "
+		        "#%zu\n", i, flows[i].first_refresh_round + 1);
+		if(flows[i].first_refresh_round > sync_round)
+		{
+			postponed_nr++;
+		}
+	}
+	if(postponed_nr < (TEST_FLOWS_NR - TEST_RATE_BURST -
+	                   TEST_FLOWS_NR / TEST_RATE_INTERVAL))
+	{
+		fprintf(stderr, "only %zu refreshes postponed, %u at least expected\n",
+		        postponed_nr, TEST_FLOWS_NR - TEST_RATE_BURST -
+		        TEST_FLOWS_NR / TEST_RATE_INTERVAL);
+		goto free_channel;
+	}
+
+	is_failure = 0;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Create a channel for the UDP flows with periodic refreshes
+ *
+ * The compressor of the test channel always gets the same random number, so
+ * all its contexts would draw the same jitter. It is replaced by a
+ * compressor that gets pseudo-random numbers.
+ *
+ * @param[out] channel  The channel to create
+ * @param seed          The seed of the pseudo-random numbers
+ * @param jitter        The jitter of the timeouts of periodic refreshes
+ * @param rate_burst    The burst of the rate limit, 0 for no rate limit
+ * @return              true if the channel was created, false otherwise
+ */
+static bool create_channel(struct test_channel *const channel,
+                           unsigned int *const seed,
+                           const size_t jitter,
+                           const size_t rate_burst)
+{
+	if(!test_channel_new(channel, ROHC_SMALL_CID, TEST_FLOWS_NR - 1,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	rohc_comp_free(channel->comp);
+	channel->comp = rohc_comp_new2(ROHC_SMALL_CID, TEST_FLOWS_NR - 1,
+	                               gen_random_num, seed);
+	if(channel->comp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC compressor\n");
+		goto free_decomp;
+	}
+	if(!rohc_comp_set_traces_cb2(channel->comp, test_print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "compressor\n");
+		goto free_channel;
+	}
+	if(!test_channel_enable_profile(channel, ROHC_PROFILE_UDP))
+	{
+		goto free_channel;
+	}
+
+	if(!rohc_comp_set_periodic_refreshes(channel->comp, TEST_IR_TIMEOUT,
+	                                     TEST_FO_TIMEOUT))
+	{
+		fprintf(stderr, "failed to set the timeouts of periodic refreshes\n");
+		goto free_channel;
+	}
+	if(!rohc_comp_set_periodic_refreshes_jitter(channel->comp, jitter))
+	{
+		fprintf(stderr, "failed to set the jitter of periodic refreshes\n");
+		goto free_channel;
+	}
+	if(!rohc_comp_set_refreshes_rate(channel->comp, rate_burst,
+	                                 TEST_RATE_INTERVAL))
+	{
+		fprintf(stderr, "failed to set the rate of periodic refreshes\n");
+		goto free_channel;
+	}
+
+	return true;
+
+free_channel:
+	test_channel_free(channel);
+	goto error;
+free_decomp:
+	rohc_decomp_free(channel->decomp);
+error:
+	return false;
+}
+
+
+/**
+ * @brief Create the contexts of the flows together, then compress packets
+ *        until the end of the test
+ *
+ * Every time a context leaves the SO state for a periodic refresh, the
+ * refreshes done so far are checked against the tokens that the compressed
+ * packets earned, if the rate of refreshes is limited.
+ *
+ * @param channel     The test channel
+ * @param[out] flows  The flows and the rounds of their first refreshes
+ * @param rate_burst  The burst of the rate limit, 0 for no rate limit
+ * @return            true if all the contexts refreshed without exceeding
+ *                    the rate limit, false otherwise
+ */
+static bool run_flows(struct test_channel *const channel,
+                      struct test_flow flows[TEST_FLOWS_NR],
+                      const size_t rate_burst)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	rohc_comp_last_packet_info2_t info;
+	size_t refreshes_nr = 0;
+	size_t pkts_nr = 0;
+	size_t round;
+	size_t i;
+
+	for(i = 0; i < TEST_FLOWS_NR; i++)
+	{
+		flows[i].port = 1000 + i;
+		flows[i].pkts_nr = 0;
+		flows[i].state = ROHC_COMP_STATE_UNKNOWN;
+		flows[i].first_refresh_round = TEST_ROUNDS_NR;
+	}
+
+	for(round = 0; round < TEST_ROUNDS_NR; round++)
+	{
+		for(i = 0; i < TEST_FLOWS_NR; i++)
+		{
+			struct rohc_buf ip_packet =
+				rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+			struct rohc_buf rohc_packet =
+				rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+			if(!build_packet(&flows[i], &ip_packet) ||
+			   !test_channel_transmit(channel, pkts_nr, ip_packet, &rohc_packet,
+			                          &info))
+			{
+				return false;
+			}
+			flows[i].pkts_nr++;
+
+			/* one periodic refresh more? its token was earned by the packets
+			 * compressed before the current one */
+			if(flows[i].state == ROHC_COMP_STATE_SO &&
+			   info.context_state != ROHC_COMP_STATE_SO)
+			{
+				refreshes_nr++;
+				if(flows[i].first_refresh_round == TEST_ROUNDS_NR)
+				{
+					flows[i].first_refresh_round = round;
+				}
+				if(rate_burst > 0 &&
+				   refreshes_nr > (rate_burst + pkts_nr / TEST_RATE_INTERVAL))
+				{
+					fprintf(stderr, "%zu periodic refreshes after %zu packets "
+					        "exceed the rate limit\n", refreshes_nr, pkts_nr);
+					return false;
+				}
+			}
+			flows[i].state = info.context_state;
+			pkts_nr++;
+		}
+	}
+
+	for(i = 0; i < TEST_FLOWS_NR; i++)
+	{
+		if(flows[i].first_refresh_round == TEST_ROUNDS_NR)
+		{
+			fprintf(stderr, "context #%zu was never refreshed\n", i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Build the next packet of the given flow
+ *
+ * @param flow            The flow
+ * @param[out] ip_packet  The IPv4/UDP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const struct test_flow *const flow,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t payload_len = 28;
+	const size_t ip_len = sizeof(struct ipv4_hdr) + payload_len;
+	struct ipv4_hdr *ip_header;
+	struct udphdr *udp_header;
+	uint32_t csum = 0;
+	size_t i;
+
+	if(ip_packet->max_len < ip_len)
+	{
+		fprintf(stderr, "buffer too small for packet\n");
+		return false;
+	}
+
+	/* generate the IPv4 header with a sequential IP-ID */
+	ip_packet->len = ip_len;
+	memset(rohc_buf_data(*ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(*ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + flow->pkts_nr);
+	ip_header->ttl = 64;
+	ip_header->protocol = ROHC_IPPROTO_UDP;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(*ip_packet, i) << 8) |
+		        rohc_buf_byte_at(*ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* generate the UDP header and the payload */
+	for(i = sizeof(struct ipv4_hdr); i < ip_len; i++)
+	{
+		rohc_buf_byte_at(*ip_packet, i) = (i + flow->pkts_nr) & 0xff;
+	}
+	udp_header = (struct udphdr *) (ip_header + 1);
+	udp_header->source = htons(flow->port);
+	udp_header->dest = htons(1234);
+	udp_header->len = htons(payload_len);
+	udp_header->check = 0;
+
+	return true;
+}
+
+
+/**
+ * @brief Generate pseudo-random numbers for testing the ROHC library
+ *
+ * A linear congruential generator makes the test reproducible.
+ *
+ * @param comp          The ROHC compressor
+ * @param user_context  The seed of the generator
+ * @return              The next pseudo-random number
+ */
+static int gen_random_num(const struct rohc_comp *const comp,
+                          void *const user_context)
+{
+	unsigned int *const seed = user_context;
+
+	*seed = (*seed) * 1103515245U + 12345U;
+
+	return ((*seed) >> 16) & 0x7fff;
+}
+
@@ -0,0 +1,559 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_reorder_ratio.c
+ * @brief  Check that the ROHCv2 reorder ratio is adapted to reordered ACKs
+ * @author agent <agent@local>
+ *
+ * The application compresses an IPv4/UDP flow with the ROHCv2 IP/UDP profile
+ * and configures the compressor without reordering (the default). The
+ * decompressor then acknowledges packets out of order: the compressor shall
+ * raise the reorder ratio and transmit it in co_common packets. Once the new
+ * ratio is transmitted, packets reordered on the channel shall be decompressed
+ * correctly with the reorder ratio saved in the context of the decompressor.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+#include <stdarg.h>
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/udp.h>
+
+/* ROHC internal includes */
+#include <feedback.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The first MSN used by the ROHCv2 compression context */
+#define TEST_FIRST_MSN  0x1231U
+
+/** The number of packets to compress before the reordered ACKs */
+#define TEST_PKTS_BEFORE_ACKS  20U
+
+/** The number of packets reordered on the channel */
+#define TEST_REORDERED_PKTS_NR  8U
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_reorder_ratio(void);
+static bool build_packet(const size_t pkt_num, struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(2)));
+static bool compress_one(struct rohc_comp *const comp,
+                         const size_t pkt_num,
+                         struct rohc_buf *const rohc_packet,
+                         rohc_packet_t *const packet_type)
+	__attribute__((warn_unused_result, nonnull(1, 3, 4)));
+static bool decompress_one(struct rohc_decomp *const decomp,
+                           const size_t pkt_num,
+                           const struct rohc_buf rohc_packet)
+	__attribute__((warn_unused_result, nonnull(1)));
+static bool deliver_ack(struct rohc_comp *const comp, const uint16_t msn)
+	__attribute__((warn_unused_result, nonnull(1)));
+static uint8_t crc8(const uint8_t *const data, const size_t len)
+	__attribute__((warn_unused_result, nonnull(1)));
+static void print_rohc_traces(void *const priv_ctxt,
+                              const rohc_trace_level_t level,
+                              const rohc_trace_entity_t entity,
+                              const int profile,
+                              const char *const format,
+                              ...)
+	__attribute__((format(printf, 5, 6), nonnull(5)));
+static int gen_false_random_num(const struct rohc_comp *const comp,
+                                void *const user_context)
+	__attribute__((nonnull(1)));
+
+
+/**
+ * @brief Check that the ROHCv2 reorder ratio is adapted to reordered ACKs
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	status = test_reorder_ratio();
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check that the ROHCv2 reorder ratio is adapted to reordered ACKs\n"
+	        "\n"
+	        "usage: test_reorder_ratio [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Acknowledge packets out of order, then reorder packets on the channel
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_reorder_ratio(void)
+{
+	/* the order of the packets on the channel */
+	const size_t reordered[TEST_REORDERED_PKTS_NR] = { 0, 1, 2, 3, 7, 4, 5, 6 };
+	uint8_t rohc_buffers[TEST_REORDERED_PKTS_NR][TEST_MAX_PKT_SIZE];
+	struct rohc_buf rohc_packets[TEST_REORDERED_PKTS_NR];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf rohc_packet =
+		rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+	struct rohc_comp *comp;
+	struct rohc_decomp *decomp;
+	rohc_packet_t packet_type;
+	size_t co_common_nr;
+	size_t first_pkt_num;
+	size_t pkt_num;
+	size_t i;
+	int is_failure = 1;
+
+	/* create the ROHC compressor with small CID and no reordering */
+	comp = rohc_comp_new2(ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                      gen_false_random_num, NULL);
+	if(comp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC compressor\n");
+		goto error;
+	}
+	if(!rohc_comp_set_traces_cb2(comp, print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "compressor\n");
+		goto destroy_comp;
+	}
+	if(!rohc_comp_set_reorder_ratio(comp, ROHC_REORDERING_NONE))
+	{
+		fprintf(stderr, "failed to set the reorder ratio\n");
+		goto destroy_comp;
+	}
+	if(!rohc_comp_enable_profile(comp, ROHCv2_PROFILE_IP_UDP))
+	{
+		fprintf(stderr, "failed to enable the ROHCv2 IP/UDP profile\n");
+		goto destroy_comp;
+	}
+
+	/* create the ROHC decompressor in bi-directional mode */
+	decomp = rohc_decomp_new2(ROHC_SMALL_CID, ROHC_SMALL_CID_MAX, ROHC_O_MODE);
+	if(decomp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC decompressor\n");
+		goto destroy_comp;
+	}
+	if(!rohc_decomp_set_traces_cb2(decomp, print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "decompressor\n");
+		goto destroy_decomp;
+	}
+	if(!rohc_decomp_enable_profile(decomp, ROHCv2_PROFILE_IP_UDP))
+	{
+		fprintf(stderr, "failed to enable the ROHCv2 IP/UDP profile\n");
+		goto destroy_decomp;
+	}
+
+	/* establish the context */
+	for(pkt_num = 0; pkt_num < TEST_PKTS_BEFORE_ACKS; pkt_num++)
+	{
+		if(!compress_one(comp, pkt_num, &rohc_packet, &packet_type) ||
+		   !decompress_one(decomp, pkt_num, rohc_packet))
+		{
+			goto destroy_decomp;
+		}
+	}
+
+	/* the decompressor acknowledges the last packet, then a packet sent
+	 * 10 packets before */
+	if(!deliver_ack(comp, TEST_FIRST_MSN + pkt_num - 1) ||
+	   !deliver_ack(comp, TEST_FIRST_MSN + pkt_num - 11))
+	{
+		goto destroy_decomp;
+	}
+
+	/* the new reorder ratio shall be transmitted in co_common packets */
+	co_common_nr = 0;
+	for(i = 0; i < 10; i++, pkt_num++)
+	{
+		if(!compress_one(comp, pkt_num, &rohc_packet, &packet_type) ||
+		   !decompress_one(decomp, pkt_num, rohc_packet))
+		{
+			goto destroy_decomp;
+		}
+		if(packet_type == ROHC_PACKET_CO_COMMON)
+		{
+			co_common_nr++;
+		}
+		else if(co_common_nr == 0)
+		{
+			fprintf(stderr, "new reorder ratio not transmitted: %s packet "
+			        "sent\n", rohc_get_packet_descr(packet_type));
+			goto destroy_decomp;
+		}
+		if(!deliver_ack(comp, TEST_FIRST_MSN + pkt_num))
+		{
+			goto destroy_decomp;
+		}
+	}
+	fprintf(stderr, "new reorder ratio transmitted in %zu co_common packets\n",
+	        co_common_nr);
+	if(packet_type == ROHC_PACKET_CO_COMMON)
+	{
+		fprintf(stderr, "co_common packets still sent after the reorder ratio "
+		        "was transmitted\n");
+		goto destroy_decomp;
+	}
+
+	/* packets reordered on the channel shall be decompressed with the new
+	 * reorder ratio */
+	first_pkt_num = pkt_num;
+	for(i = 0; i < TEST_REORDERED_PKTS_NR; i++, pkt_num++)
+	{
+		const struct rohc_buf empty_packet =
+			rohc_buf_init_empty(rohc_buffers[i], TEST_MAX_PKT_SIZE);
+
+		rohc_packets[i] = empty_packet;
+		if(!compress_one(comp, pkt_num, &rohc_packets[i], &packet_type))
+		{
+			goto destroy_decomp;
+		}
+	}
+	for(i = 0; i < TEST_REORDERED_PKTS_NR; i++)
+	{
+		if(!decompress_one(decomp, first_pkt_num + reordered[i],
+		                   rohc_packets[reordered[i]]))
+		{
+			fprintf(stderr, "packet reordered on the channel was not "
+			        "decompressed correctly\n");
+			goto destroy_decomp;
+		}
+	}
+	fprintf(stderr, "packets reordered on the channel were decompressed "
+	        "correctly\n");
+
+	is_failure = 0;
+
+destroy_decomp:
+	rohc_decomp_free(decomp);
+destroy_comp:
+	rohc_comp_free(comp);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Build the given packet of the IPv4/UDP flow
+ *
+ * @param pkt_num         The number of the packet in the IPv4/UDP flow
+ * @param[out] ip_packet  The IPv4/UDP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const size_t pkt_num, struct rohc_buf *const ip_packet)
+{
+	const size_t payload_len = 20;
+	const size_t ip_len =
+		sizeof(struct ipv4_hdr) + sizeof(struct udphdr) + payload_len;
+	struct ipv4_hdr *ip_header;
+	struct udphdr *udp_header;
+	uint32_t csum = 0;
+	size_t i;
+
+	if(ip_packet->max_len < ip_len)
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+
+	/* generate the IPv4 header with a sequential IP-ID */
+	ip_packet->len = ip_len;
+	memset(rohc_buf_data(*ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(*ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + pkt_num);
+	ip_header->ttl = 64;
+	ip_header->protocol = ROHC_IPPROTO_UDP;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(*ip_packet, i) << 8) |
+		        rohc_buf_byte_at(*ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* generate the UDP header and its payload */
+	udp_header = (struct udphdr *) (ip_header + 1);
+	udp_header->source = htons(1234);
+	udp_header->dest = htons(1235);
+	udp_header->len = htons(sizeof(struct udphdr) + payload_len);
+	udp_header->check = htons(0x1234 + pkt_num);
+	for(i = ip_len - payload_len; i < ip_len; i++)
+	{
+		rohc_buf_byte_at(*ip_packet, i) = (i + pkt_num) & 0xff;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Compress the given packet of the IPv4/UDP flow
+ *
+ * @param comp              The ROHC compressor
+ * @param pkt_num           The number of the packet in the IPv4/UDP flow
+ * @param[out] rohc_packet  The ROHC packet
+ * @param[out] packet_type  The type of ROHC packet that was created
+ * @return                  true if the packet was successfully compressed,
+ *                          false otherwise
+ */
+static bool compress_one(struct rohc_comp *const comp,
+                         const size_t pkt_num,
+                         struct rohc_buf *const rohc_packet,
+                         rohc_packet_t *const packet_type)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf ip_packet = rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+	rohc_comp_last_packet_info2_t info;
+	rohc_status_t status;
+
+	if(!build_packet(pkt_num, &ip_packet))
+	{
+		goto error;
+	}
+
+	rohc_packet->len = 0;
+	status = rohc_compress4(comp, ip_packet, rohc_packet);
+	if(status != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "failed to compress packet #%zu\n", pkt_num + 1);
+		goto error;
+	}
+	info.version_major = 0;
+	info.version_minor = 0;
+	if(!rohc_comp_get_last_packet_info2(comp, &info))
+	{
+		fprintf(stderr, "failed to get compression info for packet #%zu\n",
+		        pkt_num + 1);
+		goto error;
+	}
+	*packet_type = info.packet_type;
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Decompress the given ROHC packet and check the IPv4/UDP packet
+ *
+ * @param decomp       The ROHC decompressor
+ * @param pkt_num      The number of the packet in the IPv4/UDP flow
+ * @param rohc_packet  The ROHC packet to decompress
+ * @return             true if the packet was successfully decompressed,
+ *                     false otherwise
+ */
+static bool decompress_one(struct rohc_decomp *const decomp,
+                           const size_t pkt_num,
+                           const struct rohc_buf rohc_packet)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf ip_packet = rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+	uint8_t uncomp_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf uncomp_packet =
+		rohc_buf_init_empty(uncomp_buffer, TEST_MAX_PKT_SIZE);
+	rohc_status_t status;
+
+	if(!build_packet(pkt_num, &ip_packet))
+	{
+		goto error;
+	}
+
+	status = rohc_decompress3(decomp, rohc_packet, &uncomp_packet, NULL, NULL);
+	if(status != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "failed to decompress packet #%zu\n", pkt_num + 1);
+		goto error;
+	}
+	if(uncomp_packet.len != ip_packet.len ||
+	   memcmp(rohc_buf_data(uncomp_packet), rohc_buf_data(ip_packet),
+	          ip_packet.len) != 0)
+	{
+		fprintf(stderr, "packet #%zu was not decompressed correctly\n",
+		        pkt_num + 1);
+		goto error;
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Deliver one positive ACK (FEEDBACK-2) for CID 0 to the compressor
+ *
+ * @param comp  The ROHC compressor
+ * @param msn   The MSN acknowledged by the feedback
+ * @return      true if the feedback was successfully delivered,
+ *              false otherwise
+ */
+static bool deliver_ack(struct rohc_comp *const comp, const uint16_t msn)
+{
+	const struct rohc_ts arrival_time = { .sec = 0, .nsec = 0 };
+	uint8_t feedback_data[4];
+	const struct rohc_buf feedback =
+		rohc_buf_init_full(feedback_data, 4, arrival_time);
+
+	/* RFC 5225, §6.9.1: Acktype, 14-bit MSN and CRC-8 */
+	feedback_data[0] = 0xf0 | 3; /* feedback type + size */
+	feedback_data[1] = (ROHC_FEEDBACK_ACK << 6) | ((msn >> 8) & 0x3f);
+	feedback_data[2] = msn & 0xff;
+	feedback_data[3] = 0x00;
+	feedback_data[3] = crc8(feedback_data + 1, 3);
+
+	if(!rohc_comp_deliver_feedback2(comp, feedback))
+	{
+		fprintf(stderr, "failed to deliver the positive feedback for MSN "
+		        "0x%04x\n", msn);
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Compute the 8-bit CRC of the feedback as defined by RFC 3095
+ *
+ * @param data  The data to compute the CRC for
+ * @param len   The length of the data
+ * @return      The 8-bit CRC
+ */
+static uint8_t crc8(const uint8_t *const data, const size_t len)
+{
+	uint8_t crc = 0xff;
+	size_t i;
+	size_t j;
+
+	for(i = 0; i < len; i++)
+	{
+		crc ^= data[i];
+		for(j = 0; j < 8; j++)
+		{
+			crc = (crc & 1) ? ((crc >> 1) ^ 0xe0) : (crc >> 1);
+		}
+	}
+
+	return crc;
+}
+
+
+/**
+ * @brief Callback to print traces of the ROHC library
+ *
+ * @param priv_ctxt  An optional private context, may be NULL
+ * @param level      The priority level of the trace
+ * @param entity     The entity that emitted the trace among:
+ *                    \li ROHC_TRACE_COMP
+ *                    \li ROHC_TRACE_DECOMP
+ * @param profile    The ID of the ROHC compression/decompression profile
+ *                   the trace is related to
+ * @param format     The format string of the trace
+ */
+static void print_rohc_traces(void *const priv_ctxt,
+                              const rohc_trace_level_t level,
+                              const rohc_trace_entity_t entity,
+                              const int profile,
+                              const char *const format,
+                              ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	vfprintf(stdout, format, args);
+	va_end(args);
+}
+
+
+/**
+ * @brief Generate a false random number for testing the ROHC library
+ *
+ * The ROHCv2 compression context uses it as first MSN, so that the test
+ * knows the MSN of every packet.
+ *
+ * @param comp          The ROHC compressor
+ * @param user_context  Should always be NULL
+ * @return              Always the same number
+ */
+static int gen_false_random_num(const struct rohc_comp *const comp,
+                                void *const user_context)
+{
+	return (TEST_FIRST_MSN - 1);
+}
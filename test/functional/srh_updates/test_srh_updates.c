@@ -0,0 +1,367 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_srh_updates.c
+ * @brief  Check the updates of the IPv6 Segment Routing Headers
+ * @author agent <agent@local>
+ *
+ * The application compresses IPv6/SRH/UDP flows with the IP/UDP profile, once
+ * with the SRH updates feature enabled on both ends, and once with the
+ * feature disabled. The Tag of the Segment Routing Header (SRH) changes
+ * periodically in one flow, the last segment of the SRH changes periodically
+ * in the other flow.
+ *
+ * With the feature enabled, the Tag changes shall be transmitted without the
+ * segment list of the SRH, so the ROHC packets shall be shorter. The segment
+ * changes shall be transmitted with the whole SRH, as without the feature.
+ * All packets shall be decompressed correctly.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv6.h>
+#include <protocols/udp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  300U
+
+/** The number of packets of every flow */
+#define TEST_PKTS_NR  200U
+
+/** The SRH changes every TEST_CHANGE_PERIOD packets */
+#define TEST_CHANGE_PERIOD  25U
+
+/** The number of segments in the SRH */
+#define TEST_SEGMENTS_NR  3U
+
+/** The length of the UDP payload */
+#define TEST_PAYLOAD_LEN  20U
+
+/** The max number of packet types in one flow */
+#define TEST_PKT_TYPES_MAX  4U
+
+
+/** The field of the SRH that changes in the test flows */
+typedef enum
+{
+	TEST_SRH_TAG,      /**< The Tag of the SRH changes */
+	TEST_SRH_SEGMENT,  /**< The last segment of the SRH changes */
+} test_srh_change_t;
+
+
+/** The number of packets of one type */
+struct test_pkt_count
+{
+	rohc_packet_t type;  /**< The type of the ROHC packets */
+	size_t count;        /**< The number of ROHC packets of that type */
+};
+
+
+/** One flow to compress and decompress */
+struct test_flow
+{
+	const char *descr;           /**< The description of the flow */
+	test_srh_change_t change;    /**< The field of the SRH that changes */
+	bool use_feature;            /**< Whether the SRH updates feature is used */
+	/** The expected number of ROHC packets of every type */
+	struct test_pkt_count pkt_counts[TEST_PKT_TYPES_MAX];
+	size_t rohc_len;             /**< The expected length of all ROHC packets */
+};
+
+
+/**
+ * The test flows: every SRH change is transmitted in 5 UOR-2 packets, the SRH
+ * updates feature saves the 48-byte segment list in the ones that transmit
+ * the Tag changes, but not in the ones that transmit the segment changes
+ */
+static const struct test_flow test_flows[] = {
+	{ "Tag changes with SRH updates", TEST_SRH_TAG, true,
+	  { { ROHC_PACKET_IR, 3 }, { ROHC_PACKET_UO_0, 159 },
+	    { ROHC_PACKET_UOR_2, 38 } }, 5530 },
+	{ "Tag changes without SRH updates", TEST_SRH_TAG, false,
+	  { { ROHC_PACKET_IR, 3 }, { ROHC_PACKET_UO_0, 159 },
+	    { ROHC_PACKET_UOR_2, 38 } }, 7210 },
+	{ "segment changes with SRH updates", TEST_SRH_SEGMENT, true,
+	  { { ROHC_PACKET_IR, 3 }, { ROHC_PACKET_UO_0, 159 },
+	    { ROHC_PACKET_UOR_2, 38 } }, 7210 },
+	{ "segment changes without SRH updates", TEST_SRH_SEGMENT, false,
+	  { { ROHC_PACKET_IR, 3 }, { ROHC_PACKET_UO_0, 159 },
+	    { ROHC_PACKET_UOR_2, 38 } }, 7210 },
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static bool test_srh_updates(const struct test_flow *const flow)
+	__attribute__((warn_unused_result, nonnull(1)));
+static bool build_packet(const test_srh_change_t change,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(3)));
+
+
+/**
+ * @brief Check the updates of the IPv6 Segment Routing Headers
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+	size_t i;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	for(i = 0; i < (sizeof(test_flows) / sizeof(test_flows[0])); i++)
+	{
+		fprintf(stderr, "%s:\n", test_flows[i].descr);
+		if(!test_srh_updates(&test_flows[i]))
+		{
+			goto error;
+		}
+	}
+
+	status = 0;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the updates of the IPv6 Segment Routing Headers\n"
+	        "\n"
+	        "usage: test_srh_updates [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Compress and decompress one flow
+ *
+ * @param flow  The flow to compress and decompress
+ * @return      true if the test succeeded, false otherwise
+ */
+static bool test_srh_updates(const struct test_flow *const flow)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct test_channel channel;
+	rohc_comp_last_packet_info2_t info;
+	size_t pkts_nr[ROHC_PACKET_MAX] = { 0 };
+	size_t rohc_len = 0;
+	size_t pkt_num;
+	size_t i;
+	size_t j;
+	bool is_success = false;
+
+	/* create the ROHC compressor and decompressor in unidirectional mode */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_enable_profile(&channel, ROHC_PROFILE_UDP))
+	{
+		goto free_channel;
+	}
+	if(flow->use_feature &&
+	   !test_channel_set_features(&channel, ROHC_COMP_FEATURE_SRH_UPDATES,
+	                              ROHC_DECOMP_FEATURE_SRH_UPDATES))
+	{
+		goto free_channel;
+	}
+
+	for(pkt_num = 0; pkt_num < TEST_PKTS_NR; pkt_num++)
+	{
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+		if(!build_packet(flow->change, pkt_num, &ip_packet))
+		{
+			goto free_channel;
+		}
+
+		/* compress the packet, then decompress it and check it */
+		if(!test_channel_transmit(&channel, pkt_num, ip_packet, &rohc_packet,
+		                          &info))
+		{
+			goto free_channel;
+		}
+		pkts_nr[info.packet_type]++;
+		rohc_len += rohc_packet.len;
+	}
+
+	/* check the types and the length of the ROHC packets */
+	for(i = 0; i < ROHC_PACKET_MAX; i++)
+	{
+		size_t expected_nr = 0;
+
+		for(j = 0; j < TEST_PKT_TYPES_MAX; j++)
+		{
+			if(flow->pkt_counts[j].type == i)
+			{
+				expected_nr += flow->pkt_counts[j].count;
+			}
+		}
+		if(pkts_nr[i] != expected_nr)
+		{
+			fprintf(stderr, "\t%zu %s packets instead of %zu\n", pkts_nr[i],
+			        rohc_get_packet_descr(i), expected_nr);
+			goto free_channel;
+		}
+	}
+	if(rohc_len != flow->rohc_len)
+	{
+		fprintf(stderr, "\t%zu bytes of ROHC packets instead of %zu\n",
+		        rohc_len, flow->rohc_len);
+		goto free_channel;
+	}
+	fprintf(stderr, "\t%u packets compressed as expected and decompressed "
+	        "correctly\n", TEST_PKTS_NR);
+
+	is_success = true;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_success;
+}
+
+
+/**
+ * @brief Build the given packet of one flow
+ *
+ * The IPv6 header is followed by a Segment Routing Header with 3 segments,
+ * then by the UDP header and its payload.
+ *
+ * @param change          The field of the SRH that changes in the flow
+ * @param pkt_num         The number of the packet in the flow
+ * @param[out] ip_packet  The IP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const test_srh_change_t change,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t change_num = pkt_num / TEST_CHANGE_PERIOD;
+	uint8_t *data = rohc_buf_data(*ip_packet);
+	struct ipv6_hdr *const ip_header = (struct ipv6_hdr *) data;
+	struct ipv6_srh *const srh = (struct ipv6_srh *) (ip_header + 1);
+	struct ipv6_addr *const segments = (struct ipv6_addr *) (srh + 1);
+	struct udphdr *const udp_header =
+		(struct udphdr *) (segments + TEST_SEGMENTS_NR);
+	const size_t srh_len =
+		sizeof(struct ipv6_srh) + TEST_SEGMENTS_NR * sizeof(struct ipv6_addr);
+	const size_t udp_len = sizeof(struct udphdr) + TEST_PAYLOAD_LEN;
+	const size_t pkt_len = sizeof(struct ipv6_hdr) + srh_len + udp_len;
+	size_t i;
+
+	if(ip_packet->max_len < pkt_len)
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+	memset(data, 0, pkt_len);
+
+	/* SRH: the last segment is the final destination, the active segment is
+	 * the destination of the IPv6 header */
+	srh->next_header = ROHC_IPPROTO_UDP;
+	srh->length = srh_len / 8 - 1;
+	srh->routing_type = IPV6_ROUTING_TYPE_SRH;
+	srh->segments_left = 1;
+	srh->last_entry = TEST_SEGMENTS_NR - 1;
+	srh->tag = htons(change == TEST_SRH_TAG ? change_num : 0);
+	for(i = 0; i < TEST_SEGMENTS_NR; i++)
+	{
+		segments[i].u8[0] = 0x20;
+		segments[i].u8[1] = 0x01;
+		segments[i].u8[15] = i + 1;
+	}
+	if(change == TEST_SRH_SEGMENT)
+	{
+		segments[0].u8[14] = change_num;
+	}
+
+	/* IPv6 header */
+	ip_header->version = 6;
+	ip_header->plen = htons(srh_len + udp_len);
+	ip_header->nh = ROHC_IPPROTO_ROUTING;
+	ip_header->hl = 64;
+	ip_header->saddr.u8[0] = 0x20;
+	ip_header->saddr.u8[1] = 0x01;
+	ip_header->saddr.u8[15] = 0xff;
+	memcpy(&ip_header->daddr, &segments[srh->segments_left],
+	       sizeof(struct ipv6_addr));
+
+	/* UDP header and payload */
+	udp_header->source = htons(1234);
+	udp_header->dest = htons(5678);
+	udp_header->len = htons(udp_len);
+	udp_header->check = htons(0x1234 + pkt_num);
+	for(i = pkt_len - TEST_PAYLOAD_LEN; i < pkt_len; i++)
+	{
+		data[i] = (i + pkt_num) & 0xff;
+	}
+	ip_packet->len = pkt_len;
+
+	return true;
+}
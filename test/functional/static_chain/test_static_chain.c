@@ -0,0 +1,555 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_static_chain.c
+ * @brief  Check the static chains cached for the periodic IR refreshes
+ * @author agent <agent@local>
+ *
+ * The application compresses flows with frequent periodic IR refreshes, with
+ * the RFC 3095, ROHCv2 and TCP profiles. The IR refreshes of one flow shall
+ * all have the same size. When an IPv6 extension header is added within the
+ * context of a TCP flow, the next IR packets shall carry the new static
+ * chain. All packets shall be decompressed correctly.
+ *
+ * The application then compresses several IPv4/TCP flows that recycle the
+ * two CIDs of a ROHC channel in bi-directional mode, one of them with an
+ * IR-CR packet. The decompressor shall parse the static chain of every IR
+ * packet that starts a flow on a recycled CID, even when the static chain
+ * is the one of an older flow on the same CID.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/ipv6.h>
+#include <protocols/udp.h>
+#include <protocols/tcp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The number of packets of every flow */
+#define TEST_PKTS_NR  60U
+
+/** The packet of every flow from which a static field changes */
+#define TEST_CHANGE_PKT  30U
+
+/** The number of packets between two periodic IR refreshes */
+#define TEST_IR_TIMEOUT  10U
+
+/** The number of packets of every step of the test with recycled CIDs */
+#define TEST_STEP_PKTS_NR  20U
+
+/** The IPv4 destination address of all flows */
+#define TEST_DADDR  0xc0a80002U
+
+
+/** The kinds of flows */
+enum test_flow_kind
+{
+	TEST_FLOW_IPV4,      /**< IPv4 with an unknown protocol */
+	TEST_FLOW_IPV4_UDP,  /**< IPv4/UDP */
+	TEST_FLOW_IPV4_TCP,  /**< IPv4/TCP */
+	TEST_FLOW_IPV6_TCP,  /**< IPv6/TCP */
+};
+
+
+/** One IPv4 flow */
+struct test_flow
+{
+	uint32_t saddr;                 /**< The IPv4 source address */
+	uint16_t sport;                 /**< The UDP or TCP source port */
+	size_t pkts_nr;                 /**< The number of packets already sent */
+};
+
+
+/** The description of one test */
+struct test_case
+{
+	const char *descr;              /**< The description of the test */
+	int profile;                    /**< The profile to compress with */
+	enum test_flow_kind kind;       /**< The kind of flow */
+	bool do_change;                 /**< Whether a static field changes */
+};
+
+
+/** One step of the test with recycled CIDs */
+struct test_step
+{
+	size_t flow;                    /**< The flow to compress */
+	rohc_packet_t first_type;       /**< The expected type of the 1st packet,
+	                                     ROHC_PACKET_UNKNOWN to ignore it */
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static bool test_static_chain(const struct test_case *const test)
+	__attribute__((warn_unused_result, nonnull(1)));
+static bool test_static_chain_recycled(void)
+	__attribute__((warn_unused_result));
+static bool build_packet(const enum test_flow_kind kind,
+                         const struct test_flow *const flow,
+                         const size_t pkt_num,
+                         const bool is_changed,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(2, 5)));
+
+
+/**
+ * @brief Check the static chains cached for the periodic IR refreshes
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	const struct test_case tests[] = {
+		{ "IP-only", ROHC_PROFILE_IP, TEST_FLOW_IPV4, false },
+		{ "IP/UDP", ROHC_PROFILE_UDP, TEST_FLOW_IPV4_UDP, false },
+		{ "ROHCv2 IP/UDP", ROHCv2_PROFILE_IP_UDP, TEST_FLOW_IPV4_UDP, false },
+		{ "TCP", ROHC_PROFILE_TCP, TEST_FLOW_IPV6_TCP, false },
+		{ "TCP with a new IPv6 extension header", ROHC_PROFILE_TCP,
+		  TEST_FLOW_IPV6_TCP, true },
+	};
+	size_t i;
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	for(i = 0; i < (sizeof(tests) / sizeof(tests[0])); i++)
+	{
+		fprintf(stderr, "%s:\n", tests[i].descr);
+		if(!test_static_chain(&tests[i]))
+		{
+			goto error;
+		}
+	}
+
+	fprintf(stderr, "TCP flows on recycled CIDs:\n");
+	if(!test_static_chain_recycled())
+	{
+		goto error;
+	}
+
+	status = 0;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the static chains cached for the periodic IR refreshes\n"
+	        "\n"
+	        "usage: test_static_chain [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Compress one flow with periodic IR refreshes
+ *
+ * @param test  The test to run
+ * @return      true if the test succeeded, false otherwise
+ */
+static bool test_static_chain(const struct test_case *const test)
+{
+	const struct test_flow flow = { .saddr = 0xc0a80001, .sport = 1234 };
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct test_channel channel;
+	rohc_comp_last_packet_info2_t info;
+	size_t ir_lens[2] = { 0, 0 };
+	size_t ir_nr = 0;
+	size_t pkt_num;
+	bool is_success = false;
+
+	/* create the ROHC compressor with frequent periodic IR refreshes and the
+	 * ROHC decompressor in unidirectional mode */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!rohc_comp_set_periodic_refreshes(channel.comp, TEST_IR_TIMEOUT,
+	                                     TEST_IR_TIMEOUT / 2))
+	{
+		fprintf(stderr, "failed to set the periodic refreshes\n");
+		goto free_channel;
+	}
+	if(!test_channel_enable_profile(&channel, test->profile))
+	{
+		goto free_channel;
+	}
+
+	for(pkt_num = 0; pkt_num < TEST_PKTS_NR; pkt_num++)
+	{
+		const bool is_changed = (test->do_change && pkt_num >= TEST_CHANGE_PKT);
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+		if(!build_packet(test->kind, &flow, pkt_num, is_changed, &ip_packet))
+		{
+			goto free_channel;
+		}
+
+		/* compress the packet, all the IR packets of the flow shall have the
+		 * same size, before and after the change */
+		if(!test_channel_compress(&channel, pkt_num, ip_packet, &rohc_packet,
+		                          &info))
+		{
+			goto free_channel;
+		}
+		if(info.profile_id != test->profile)
+		{
+			fprintf(stderr, "\tpacket #%zu was compressed with profile 0x%04x\n",
+			        pkt_num + 1, info.profile_id);
+			goto free_channel;
+		}
+		if(info.packet_type == ROHC_PACKET_IR)
+		{
+			if(ir_lens[is_changed] == 0)
+			{
+				ir_lens[is_changed] = rohc_packet.len;
+			}
+			else if(rohc_packet.len != ir_lens[is_changed])
+			{
+				fprintf(stderr, "\tIR packet #%zu is %zu bytes while the first "
+				        "IR packet was %zu bytes\n", pkt_num + 1, rohc_packet.len,
+				        ir_lens[is_changed]);
+				goto free_channel;
+			}
+			ir_nr++;
+		}
+
+		/* decompress the packet and check it */
+		if(!test_channel_decompress(&channel, pkt_num, rohc_packet, ip_packet))
+		{
+			goto free_channel;
+		}
+	}
+	if(ir_nr < (TEST_PKTS_NR / TEST_IR_TIMEOUT) ||
+	   (test->do_change && ir_lens[1] == 0))
+	{
+		fprintf(stderr, "\tnot enough IR refreshes: only %zu IR packets\n",
+		        ir_nr);
+		goto free_channel;
+	}
+	fprintf(stderr, "\t%zu IR packets of %zu bytes", ir_nr, ir_lens[0]);
+	if(test->do_change)
+	{
+		fprintf(stderr, ", then of %zu bytes after the change", ir_lens[1]);
+	}
+	fprintf(stderr, ", all decompressed correctly\n");
+
+	is_success = true;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_success;
+}
+
+
+/**
+ * @brief Compress IPv4/TCP flows that recycle the CIDs of the ROHC channel
+ *
+ * The ROHC channel has 2 CIDs and works in bi-directional mode. Flow A takes
+ * CID 0, flow C takes CID 1. Flow B has the same addresses as flow A, so it
+ * recycles CID 1 with an IR-CR packet. Flow C then recycles CID 1 again with
+ * an IR packet whose static chain is the one of the former flow C on the same
+ * CID. Flow D finally recycles CID 0 with an IR packet.
+ *
+ * @return  true if the test succeeded, false otherwise
+ */
+static bool test_static_chain_recycled(void)
+{
+	struct test_flow flows[] = {
+		{ .saddr = 0xc0a80001, .sport = 1000, .pkts_nr = 0 }, /* A */
+		{ .saddr = 0xc0a80001, .sport = 1001, .pkts_nr = 0 }, /* B */
+		{ .saddr = 0xc0a80101, .sport = 2000, .pkts_nr = 0 }, /* C */
+		{ .saddr = 0xc0a80201, .sport = 3000, .pkts_nr = 0 }, /* D */
+	};
+	const struct test_step steps[] = {
+		{ 0, ROHC_PACKET_IR },
+		{ 2, ROHC_PACKET_IR },
+		{ 0, ROHC_PACKET_UNKNOWN },
+		{ 1, ROHC_PACKET_IR_CR },
+		{ 0, ROHC_PACKET_UNKNOWN },
+		{ 2, ROHC_PACKET_IR },
+		{ 3, ROHC_PACKET_IR },
+	};
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct test_channel channel;
+	rohc_comp_last_packet_info2_t info;
+	size_t step_num;
+	size_t i;
+	bool is_success = false;
+
+	/* create the ROHC compressor and decompressor with 2 CIDs in
+	 * bi-directional mode, the feedback is delivered to the compressor */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, 1, ROHC_O_MODE))
+	{
+		goto error;
+	}
+	channel.with_feedback = true;
+	if(!test_channel_enable_profile(&channel, ROHC_PROFILE_TCP))
+	{
+		goto free_channel;
+	}
+
+	for(step_num = 0; step_num < (sizeof(steps) / sizeof(steps[0])); step_num++)
+	{
+		const struct test_step *const step = &steps[step_num];
+		struct test_flow *const flow = &flows[step->flow];
+
+		for(i = 0; i < TEST_STEP_PKTS_NR; i++)
+		{
+			const size_t pkt_num = flow->pkts_nr;
+			struct rohc_buf ip_packet =
+				rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+			struct rohc_buf rohc_packet =
+				rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+			if(!build_packet(TEST_FLOW_IPV4_TCP, flow, pkt_num, false,
+			                 &ip_packet))
+			{
+				goto free_channel;
+			}
+			flow->pkts_nr++;
+
+			if(!test_channel_compress(&channel, pkt_num, ip_packet, &rohc_packet,
+			                          &info))
+			{
+				goto free_channel;
+			}
+			if(i == 0)
+			{
+				fprintf(stderr, "\tflow with port %u went on with a %zu-byte %s "
+				        "packet on CID %u\n", flow->sport, rohc_packet.len,
+				        rohc_get_packet_descr(info.packet_type), info.context_id);
+				if(step->first_type != ROHC_PACKET_UNKNOWN &&
+				   info.packet_type != step->first_type)
+				{
+					fprintf(stderr, "\tflow with port %u shall have gone on with "
+					        "a %s packet\n", flow->sport,
+					        rohc_get_packet_descr(step->first_type));
+					goto free_channel;
+				}
+			}
+
+			/* decompress the packet, check it and deliver the feedback */
+			if(!test_channel_decompress(&channel, pkt_num, rohc_packet,
+			                            ip_packet))
+			{
+				goto free_channel;
+			}
+		}
+	}
+	fprintf(stderr, "\tall packets decompressed correctly\n");
+
+	is_success = true;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_success;
+}
+
+
+/**
+ * @brief Build the given packet of the given flow
+ *
+ * @param kind            The kind of flow
+ * @param flow            The addresses and ports of the flow (IPv4 flows only)
+ * @param pkt_num         The number of the packet in the flow
+ * @param is_changed      Whether a static field of the flow changed (IPv6/TCP
+ *                        flows only)
+ * @param[out] ip_packet  The IP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const enum test_flow_kind kind,
+                         const struct test_flow *const flow,
+                         const size_t pkt_num,
+                         const bool is_changed,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t payload_len = 40;
+	uint8_t *data = rohc_buf_data(*ip_packet);
+	size_t hdrs_len;
+	size_t i;
+
+	memset(data, 0, ip_packet->max_len);
+
+	if(kind == TEST_FLOW_IPV6_TCP)
+	{
+		struct ipv6_hdr *const ip_header = (struct ipv6_hdr *) data;
+		struct tcphdr *tcp_header;
+
+		/* IPv6 header, with a Destination Options extension header once
+		 * changed */
+		ip_header->version = 6;
+		ip_header->nh = (is_changed ? ROHC_IPPROTO_DSTOPTS : ROHC_IPPROTO_TCP);
+		ip_header->hl = 64;
+		ip_header->saddr.u8[0] = 0x20;
+		ip_header->saddr.u8[15] = 0x01;
+		ip_header->daddr.u8[0] = 0x20;
+		ip_header->daddr.u8[15] = 0x02;
+		hdrs_len = sizeof(struct ipv6_hdr);
+		if(is_changed)
+		{
+			/* Next Header, Hdr Ext Len and a PadN option */
+			data[hdrs_len] = ROHC_IPPROTO_TCP;
+			data[hdrs_len + 1] = 0;
+			data[hdrs_len + 2] = 1;
+			data[hdrs_len + 3] = 4;
+			hdrs_len += 8;
+		}
+
+		/* TCP header of a bulk transfer */
+		tcp_header = (struct tcphdr *) (data + hdrs_len);
+		tcp_header->src_port = htons(1234);
+		tcp_header->dst_port = htons(80);
+		tcp_header->seq_num = htonl(0x10000000 + pkt_num * payload_len);
+		tcp_header->ack_num = htonl(0x20000000);
+		tcp_header->data_offset = sizeof(struct tcphdr) / 4;
+		tcp_header->ack_flag = 1;
+		tcp_header->window = htons(8000);
+		tcp_header->checksum = htons(0x1234 + pkt_num);
+		hdrs_len += sizeof(struct tcphdr);
+
+		ip_header->plen = htons(hdrs_len - sizeof(struct ipv6_hdr) + payload_len);
+	}
+	else
+	{
+		struct ipv4_hdr *const ip_header = (struct ipv4_hdr *) data;
+		uint32_t csum = 0;
+
+		/* IPv4 header with a sequential IP-ID */
+		ip_header->version = 4;
+		ip_header->ihl = 5;
+		ip_header->id = htons(0x1000 + pkt_num);
+		ip_header->ttl = 64;
+		if(kind == TEST_FLOW_IPV4_UDP)
+		{
+			ip_header->protocol = ROHC_IPPROTO_UDP;
+		}
+		else if(kind == TEST_FLOW_IPV4_TCP)
+		{
+			ip_header->df = 1;
+			ip_header->protocol = ROHC_IPPROTO_TCP;
+		}
+		else
+		{
+			ip_header->protocol = 253;
+		}
+		ip_header->saddr = htonl(flow->saddr);
+		ip_header->daddr = htonl(TEST_DADDR);
+		hdrs_len = sizeof(struct ipv4_hdr);
+		if(kind == TEST_FLOW_IPV4_UDP)
+		{
+			struct udphdr *const udp_header = (struct udphdr *) (ip_header + 1);
+			udp_header->source = htons(flow->sport);
+			udp_header->dest = htons(1235);
+			udp_header->len = htons(sizeof(struct udphdr) + payload_len);
+			udp_header->check = htons(0x1234 + pkt_num);
+			hdrs_len += sizeof(struct udphdr);
+		}
+		else if(kind == TEST_FLOW_IPV4_TCP)
+		{
+			/* TCP header of a bulk transfer */
+			struct tcphdr *const tcp_header = (struct tcphdr *) (ip_header + 1);
+			tcp_header->src_port = htons(flow->sport);
+			tcp_header->dst_port = htons(80);
+			tcp_header->seq_num = htonl(0x10000000 + pkt_num * payload_len);
+			tcp_header->ack_num = htonl(0x20000000);
+			tcp_header->data_offset = sizeof(struct tcphdr) / 4;
+			tcp_header->ack_flag = 1;
+			tcp_header->window = htons(8000);
+			tcp_header->checksum = htons(0x1234 + pkt_num);
+			hdrs_len += sizeof(struct tcphdr);
+		}
+		ip_header->tot_len = htons(hdrs_len + payload_len);
+		for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+		{
+			csum += (data[i] << 8) | data[i + 1];
+		}
+		csum = (csum & 0xffff) + (csum >> 16);
+		csum = (csum & 0xffff) + (csum >> 16);
+		ip_header->check = htons((~csum) & 0xffff);
+	}
+
+	/* payload */
+	if(ip_packet->max_len < (hdrs_len + payload_len))
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+	for(i = hdrs_len; i < (hdrs_len + payload_len); i++)
+	{
+		data[i] = (i + pkt_num) & 0xff;
+	}
+	ip_packet->len = hdrs_len + payload_len;
+
+	return true;
+}
+
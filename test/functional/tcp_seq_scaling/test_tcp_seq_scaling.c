@@ -0,0 +1,391 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_tcp_seq_scaling.c
+ * @brief  Check the scaling of the TCP sequence numbers of bulk transfers
+ * @author agent <agent@local>
+ *
+ * The application compresses one IPv4/TCP bulk transfer: full segments of
+ * 1448 bytes, a short segment of 700 bytes every 45 segments, and pure ACKs
+ * between the segments. Most of the segments shall be compressed with the
+ * scaled sequence number, and all packets shall be decompressed correctly.
+ *
+ * The application then damages the sequence number of one segment that is
+ * transmitted unscaled just before the scaled ones. The decompressor shall
+ * reject the damaged segment, but not keep the residue computed from it:
+ * all the next segments shall be decompressed correctly.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/tcp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  1600U
+
+/** The number of packets of the flow */
+#define TEST_PKTS_NR  500U
+
+/** The payload length of the full segments */
+#define TEST_MSS  1448U
+
+/** The payload length of the short segments */
+#define TEST_SHORT_LEN  700U
+
+/** One short segment every TEST_SHORT_PERIOD segments */
+#define TEST_SHORT_PERIOD  45U
+
+/** One pure ACK every TEST_ACK_PERIOD packets */
+#define TEST_ACK_PERIOD  7U
+
+/**
+ * The packet to damage: the last segment with the unscaled sequence number
+ * after the first short segment, a pure ACK follows it, then the segments
+ * with the scaled sequence number
+ */
+#define TEST_DAMAGED_PKT  54U
+
+
+/** The number of packets of one type */
+struct test_pkt_count
+{
+	rohc_packet_t type;  /**< The type of the ROHC packets */
+	size_t count;        /**< The number of ROHC packets of that type */
+};
+
+
+/**
+ * The expected ROHC packets of the bulk transfer: the full segments are
+ * compressed as seq_2 packets with the scaled sequence number, except the few
+ * ones that follow the short segments
+ */
+static const struct test_pkt_count test_pkt_counts[] = {
+	{ ROHC_PACKET_IR, 3 },
+	{ ROHC_PACKET_TCP_CO_COMMON, 3 },
+	{ ROHC_PACKET_TCP_SEQ_1, 36 },
+	{ ROHC_PACKET_TCP_SEQ_2, 386 },
+	{ ROHC_PACKET_TCP_SEQ_5, 70 },
+	{ ROHC_PACKET_TCP_SEQ_8, 2 },
+};
+
+/** The expected length of all the ROHC headers of the bulk transfer */
+#define TEST_HDRS_LEN  2878U
+
+
+/* prototypes of private functions */
+static void usage(void);
+static bool test_tcp_seq_scaling(const size_t damaged_pkt)
+	__attribute__((warn_unused_result));
+static bool build_packet(const size_t pkt_num,
+                         uint32_t *const seq_num,
+                         uint32_t *const ack_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(2, 3, 4)));
+
+
+/**
+ * @brief Check the scaling of the TCP sequence numbers of bulk transfers
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	fprintf(stderr, "bulk transfer:\n");
+	if(!test_tcp_seq_scaling(TEST_PKTS_NR))
+	{
+		goto error;
+	}
+	fprintf(stderr, "bulk transfer with one damaged segment:\n");
+	if(!test_tcp_seq_scaling(TEST_DAMAGED_PKT))
+	{
+		goto error;
+	}
+
+	status = 0;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the scaling of the TCP sequence numbers of bulk transfers\n"
+	        "\n"
+	        "usage: test_tcp_seq_scaling [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Compress and decompress the bulk transfer
+ *
+ * @param damaged_pkt  The number of the packet to damage, TEST_PKTS_NR to
+ *                     damage no packet
+ * @return             true if the test succeeded, false otherwise
+ */
+static bool test_tcp_seq_scaling(const size_t damaged_pkt)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t uncomp_buffer[TEST_MAX_PKT_SIZE];
+	struct test_channel channel;
+	rohc_comp_last_packet_info2_t info;
+	uint32_t seq_num = 0x10000000;
+	uint32_t ack_num = 0x20000000;
+	size_t pkts_nr[ROHC_PACKET_MAX] = { 0 };
+	size_t hdrs_len = 0;
+	size_t pkt_num;
+	size_t i;
+	size_t j;
+	bool is_success = false;
+
+	/* create the ROHC compressor and decompressor in unidirectional mode */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_enable_profile(&channel, ROHC_PROFILE_TCP))
+	{
+		goto free_channel;
+	}
+
+	for(pkt_num = 0; pkt_num < TEST_PKTS_NR; pkt_num++)
+	{
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf uncomp_packet =
+			rohc_buf_init_empty(uncomp_buffer, TEST_MAX_PKT_SIZE);
+
+		if(!build_packet(pkt_num, &seq_num, &ack_num, &ip_packet))
+		{
+			goto free_channel;
+		}
+
+		/* compress the packet */
+		if(!test_channel_compress(&channel, pkt_num, ip_packet, &rohc_packet,
+		                          &info))
+		{
+			goto free_channel;
+		}
+		pkts_nr[info.packet_type]++;
+		hdrs_len += info.header_last_comp_size;
+
+		/* damage the LSB of the 16-bit sequence number of the seq_1 packet, the
+		 * decompressor shall reject it */
+		if(pkt_num == damaged_pkt)
+		{
+			if(info.packet_type != ROHC_PACKET_TCP_SEQ_1)
+			{
+				fprintf(stderr, "\tpacket #%zu was compressed as a %s header "
+				        "instead of a seq_1 header\n", pkt_num + 1,
+				        rohc_get_packet_descr(info.packet_type));
+				goto free_channel;
+			}
+			rohc_buf_byte_at(rohc_packet, 2) ^= 0x01;
+			if(rohc_decompress3(channel.decomp, rohc_packet,
+			                    &uncomp_packet, NULL, NULL) == ROHC_STATUS_OK)
+			{
+				fprintf(stderr, "\tdamaged packet #%zu was decompressed\n",
+				        pkt_num + 1);
+				goto free_channel;
+			}
+			fprintf(stderr, "\tdamaged packet #%zu was rejected as expected\n",
+			        pkt_num + 1);
+			continue;
+		}
+
+		/* decompress the packet and check it */
+		if(!test_channel_decompress(&channel, pkt_num, rohc_packet, ip_packet))
+		{
+			goto free_channel;
+		}
+	}
+
+	/* check the types of the ROHC packets and the length of their headers */
+	for(i = 0; i < ROHC_PACKET_MAX; i++)
+	{
+		size_t expected_nr = 0;
+
+		for(j = 0; j < (sizeof(test_pkt_counts) / sizeof(test_pkt_counts[0])); j++)
+		{
+			if(test_pkt_counts[j].type == i)
+			{
+				expected_nr = test_pkt_counts[j].count;
+			}
+		}
+		if(pkts_nr[i] != expected_nr)
+		{
+			fprintf(stderr, "\t%zu %s packets instead of %zu\n", pkts_nr[i],
+			        rohc_get_packet_descr(i), expected_nr);
+			goto free_channel;
+		}
+	}
+	if(hdrs_len != TEST_HDRS_LEN)
+	{
+		fprintf(stderr, "\t%zu bytes of ROHC headers instead of %u\n", hdrs_len,
+		        TEST_HDRS_LEN);
+		goto free_channel;
+	}
+	fprintf(stderr, "\t%u packets compressed as expected and decompressed "
+	        "correctly\n", TEST_PKTS_NR);
+
+	is_success = true;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_success;
+}
+
+
+/**
+ * @brief Build the given packet of the bulk transfer
+ *
+ * @param pkt_num         The number of the packet in the flow
+ * @param[in,out] seq_num The TCP sequence number of the packet, then the one
+ *                        of the next packet
+ * @param[in,out] ack_num The TCP acknowledgment number of the packet, then
+ *                        the one of the next packet
+ * @param[out] ip_packet  The IP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const size_t pkt_num,
+                         uint32_t *const seq_num,
+                         uint32_t *const ack_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t segment_num = pkt_num - pkt_num / TEST_ACK_PERIOD;
+	uint8_t *data = rohc_buf_data(*ip_packet);
+	struct ipv4_hdr *const ip_header = (struct ipv4_hdr *) data;
+	struct tcphdr *const tcp_header = (struct tcphdr *) (ip_header + 1);
+	const size_t hdrs_len = sizeof(struct ipv4_hdr) + sizeof(struct tcphdr);
+	size_t payload_len;
+	uint32_t csum = 0;
+	size_t i;
+
+	/* pure ACKs between the segments, and one short segment once in a while */
+	if((pkt_num % TEST_ACK_PERIOD) == (TEST_ACK_PERIOD - 1))
+	{
+		payload_len = 0;
+	}
+	else if((segment_num % TEST_SHORT_PERIOD) == (TEST_SHORT_PERIOD - 1))
+	{
+		payload_len = TEST_SHORT_LEN;
+	}
+	else
+	{
+		payload_len = TEST_MSS;
+	}
+	if(ip_packet->max_len < (hdrs_len + payload_len))
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+	memset(data, 0, hdrs_len);
+
+	/* IPv4 header with a sequential IP-ID */
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(hdrs_len + payload_len);
+	ip_header->id = htons(0x1000 + pkt_num);
+	ip_header->ttl = 64;
+	ip_header->protocol = ROHC_IPPROTO_TCP;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (data[i] << 8) | data[i + 1];
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* TCP header: the pure ACKs acknowledge the data of the other direction */
+	if(payload_len == 0)
+	{
+		(*ack_num) += 100;
+	}
+	tcp_header->src_port = htons(1234);
+	tcp_header->dst_port = htons(80);
+	tcp_header->seq_num = htonl(*seq_num);
+	tcp_header->ack_num = htonl(*ack_num);
+	tcp_header->data_offset = sizeof(struct tcphdr) / 4;
+	tcp_header->ack_flag = 1;
+	tcp_header->window = htons(8000);
+	tcp_header->checksum = htons(0x1234 + pkt_num);
+	(*seq_num) += payload_len;
+
+	/* payload */
+	for(i = hdrs_len; i < (hdrs_len + payload_len); i++)
+	{
+		data[i] = (i + pkt_num) & 0xff;
+	}
+	ip_packet->len = hdrs_len + payload_len;
+
+	return true;
+}
+
@@ -0,0 +1,305 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_channel.c
+ * @brief  One ROHC channel shared by the functional tests
+ * @author agent <agent@local>
+ */
+
+#include "test_channel.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+
+
+/**
+ * @brief Create the compressor and the decompressor of a test channel
+ *
+ * Both ends print their traces on the standard output. No profile is
+ * enabled, no feedback is delivered.
+ *
+ * @param[out] channel  The test channel to create
+ * @param cid_type      The CID type of the channel
+ * @param max_cid       The MAX_CID of the channel
+ * @param mode          The operation mode of the decompressor
+ * @return              true if the channel was created, false otherwise
+ */
+bool test_channel_new(struct test_channel *const channel,
+                      const rohc_cid_type_t cid_type,
+                      const rohc_cid_t max_cid,
+                      const rohc_mode_t mode)
+{
+	channel->with_feedback = false;
+
+	/* create the ROHC compressor */
+	channel->comp = rohc_comp_new2(cid_type, max_cid, test_gen_false_random_num,
+	                               NULL);
+	if(channel->comp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC compressor\n");
+		goto error;
+	}
+	if(!rohc_comp_set_traces_cb2(channel->comp, test_print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "compressor\n");
+		goto destroy_comp;
+	}
+
+	/* create the ROHC decompressor */
+	channel->decomp = rohc_decomp_new2(cid_type, max_cid, mode);
+	if(channel->decomp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC decompressor\n");
+		goto destroy_comp;
+	}
+	if(!rohc_decomp_set_traces_cb2(channel->decomp, test_print_rohc_traces,
+	                               NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "decompressor\n");
+		goto destroy_decomp;
+	}
+
+	return true;
+
+destroy_decomp:
+	rohc_decomp_free(channel->decomp);
+destroy_comp:
+	rohc_comp_free(channel->comp);
+error:
+	return false;
+}
+
+
+/**
+ * @brief Destroy the compressor and the decompressor of a test channel
+ *
+ * @param channel  The test channel to destroy
+ */
+void test_channel_free(struct test_channel *const channel)
+{
+	rohc_decomp_free(channel->decomp);
+	rohc_comp_free(channel->comp);
+}
+
+
+/**
+ * @brief Enable one profile on both ends of a test channel
+ *
+ * @param channel  The test channel
+ * @param profile  The profile to enable
+ * @return         true if the profile was enabled, false otherwise
+ */
+bool test_channel_enable_profile(struct test_channel *const channel,
+                                 const rohc_profile_t profile)
+{
+	if(!rohc_comp_enable_profile(channel->comp, profile))
+	{
+		fprintf(stderr, "failed to enable the %s profile on compressor\n",
+		        rohc_get_profile_descr(profile));
+		return false;
+	}
+	if(!rohc_decomp_enable_profile(channel->decomp, profile))
+	{
+		fprintf(stderr, "failed to enable the %s profile on decompressor\n",
+		        rohc_get_profile_descr(profile));
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * @brief Enable features on both ends of a test channel
+ *
+ * @param channel          The test channel
+ * @param comp_features    The features of the compressor
+ * @param decomp_features  The features of the decompressor
+ * @return                 true if the features were enabled, false otherwise
+ */
+bool test_channel_set_features(struct test_channel *const channel,
+                               const rohc_comp_features_t comp_features,
+                               const rohc_decomp_features_t decomp_features)
+{
+	if(!rohc_comp_set_features(channel->comp, comp_features))
+	{
+		fprintf(stderr, "failed to set the features of the compressor\n");
+		return false;
+	}
+	if(!rohc_decomp_set_features(channel->decomp, decomp_features))
+	{
+		fprintf(stderr, "failed to set the features of the decompressor\n");
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * @brief Compress one IP packet on a test channel
+ *
+ * @param channel           The test channel
+ * @param pkt_num           The number of the packet in the test, for traces
+ * @param ip_packet         The IP packet to compress
+ * @param[out] rohc_packet  The ROHC packet
+ * @param[out] info         The information about the ROHC packet
+ * @return                  true if the packet was compressed, false otherwise
+ */
+bool test_channel_compress(struct test_channel *const channel,
+                           const size_t pkt_num,
+                           const struct rohc_buf ip_packet,
+                           struct rohc_buf *const rohc_packet,
+                           rohc_comp_last_packet_info2_t *const info)
+{
+	if(rohc_compress4(channel->comp, ip_packet, rohc_packet) != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "\tfailed to compress packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+
+	info->version_major = 0;
+	info->version_minor = 0;
+	if(!rohc_comp_get_last_packet_info2(channel->comp, info))
+	{
+		fprintf(stderr, "\tfailed to get compression info for packet #%zu\n",
+		        pkt_num + 1);
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Decompress one ROHC packet on a test channel and check it
+ *
+ * The feedback that the decompressor builds is delivered to the compressor
+ * if the channel is configured so.
+ *
+ * @param channel      The test channel
+ * @param pkt_num      The number of the packet in the test, for traces
+ * @param rohc_packet  The ROHC packet to decompress
+ * @param ip_packet    The IP packet that the ROHC packet shall give back
+ * @return             true if the packet was decompressed correctly,
+ *                     false otherwise
+ */
+bool test_channel_decompress(struct test_channel *const channel,
+                             const size_t pkt_num,
+                             const struct rohc_buf rohc_packet,
+                             const struct rohc_buf ip_packet)
+{
+	uint8_t uncomp_buffer[TEST_CHANNEL_MAX_PKT_SIZE];
+	struct rohc_buf uncomp_packet =
+		rohc_buf_init_empty(uncomp_buffer, TEST_CHANNEL_MAX_PKT_SIZE);
+	uint8_t feedback_buffer[TEST_CHANNEL_MAX_PKT_SIZE];
+	struct rohc_buf feedback_send =
+		rohc_buf_init_empty(feedback_buffer, TEST_CHANNEL_MAX_PKT_SIZE);
+
+	if(rohc_decompress3(channel->decomp, rohc_packet, &uncomp_packet, NULL,
+	                    &feedback_send) != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "\tfailed to decompress packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+	if(uncomp_packet.len != ip_packet.len ||
+	   memcmp(rohc_buf_data(uncomp_packet), rohc_buf_data(ip_packet),
+	          ip_packet.len) != 0)
+	{
+		fprintf(stderr, "\tpacket #%zu was not decompressed correctly\n",
+		        pkt_num + 1);
+		return false;
+	}
+
+	if(channel->with_feedback && !rohc_buf_is_empty(feedback_send) &&
+	   !rohc_comp_deliver_feedback2(channel->comp, feedback_send))
+	{
+		fprintf(stderr, "\tfailed to deliver the feedback for packet #%zu\n",
+		        pkt_num + 1);
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Compress one IP packet on a test channel, then decompress it
+ *
+ * @param channel           The test channel
+ * @param pkt_num           The number of the packet in the test, for traces
+ * @param ip_packet         The IP packet to transmit
+ * @param[out] rohc_packet  The ROHC packet
+ * @param[out] info         The information about the ROHC packet
+ * @return                  true if the packet was compressed and
+ *                          decompressed correctly, false otherwise
+ */
+bool test_channel_transmit(struct test_channel *const channel,
+                           const size_t pkt_num,
+                           const struct rohc_buf ip_packet,
+                           struct rohc_buf *const rohc_packet,
+                           rohc_comp_last_packet_info2_t *const info)
+{
+	return (test_channel_compress(channel, pkt_num, ip_packet, rohc_packet,
+	                              info) &&
+	        test_channel_decompress(channel, pkt_num, *rohc_packet, ip_packet));
+}
+
+
+/**
+ * @brief Callback to print traces of the ROHC library
+ *
+ * @param priv_ctxt  An optional private context, may be NULL
+ * @param level      The priority level of the trace
+ * @param entity     The entity that emitted the trace among:
+ *                    \li ROHC_TRACE_COMP
+ *                    \li ROHC_TRACE_DECOMP
+ * @param profile    The ID of the ROHC compression/decompression profile
+ *                   the trace is related to
+ * @param format     The format string of the trace
+ */
+void test_print_rohc_traces(void *const priv_ctxt,
+                            const rohc_trace_level_t level,
+                            const rohc_trace_entity_t entity,
+                            const int profile,
+                            const char *const format,
+                            ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	vfprintf(stdout, format, args);
+	va_end(args);
+}
+
+
+/**
+ * @brief Generate a false random number for testing the ROHC library
+ *
+ * @param comp          The ROHC compressor
+ * @param user_context  Should always be NULL
+ * @return              Always 0
+ */
+int test_gen_false_random_num(const struct rohc_comp *const comp,
+                              void *const user_context)
+{
+	return 0;
+}
+
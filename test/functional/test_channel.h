@@ -0,0 +1,105 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_channel.h
+ * @brief  One ROHC channel shared by the functional tests
+ * @author agent <agent@local>
+ *
+ * A test channel is made of one ROHC compressor and one ROHC decompressor
+ * with the same CID type and MAX_CID. The test applications compress their
+ * IP packets on the channel, decompress the ROHC packets and check that they
+ * get the original IP packets back.
+ */
+
+#ifndef ROHC_TEST_CHANNEL__H
+#define ROHC_TEST_CHANNEL__H
+
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/** The max size of the IP and ROHC packets on a test channel */
+#define TEST_CHANNEL_MAX_PKT_SIZE  2048U
+
+
+/** One ROHC compressor and one ROHC decompressor */
+struct test_channel
+{
+	struct rohc_comp *comp;      /**< The ROHC compressor */
+	struct rohc_decomp *decomp;  /**< The ROHC decompressor */
+	bool with_feedback;          /**< Whether feedback is delivered */
+};
+
+
+bool test_channel_new(struct test_channel *const channel,
+                      const rohc_cid_type_t cid_type,
+                      const rohc_cid_t max_cid,
+                      const rohc_mode_t mode)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+void test_channel_free(struct test_channel *const channel)
+	__attribute__((nonnull(1)));
+
+bool test_channel_enable_profile(struct test_channel *const channel,
+                                 const rohc_profile_t profile)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+bool test_channel_set_features(struct test_channel *const channel,
+                               const rohc_comp_features_t comp_features,
+                               const rohc_decomp_features_t decomp_features)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+bool test_channel_compress(struct test_channel *const channel,
+                           const size_t pkt_num,
+                           const struct rohc_buf ip_packet,
+                           struct rohc_buf *const rohc_packet,
+                           rohc_comp_last_packet_info2_t *const info)
+	__attribute__((warn_unused_result, nonnull(1, 4, 5)));
+
+bool test_channel_decompress(struct test_channel *const channel,
+                             const size_t pkt_num,
+                             const struct rohc_buf rohc_packet,
+                             const struct rohc_buf ip_packet)
+	__attribute__((warn_unused_result, nonnull(1)));
+
+bool test_channel_transmit(struct test_channel *const channel,
+                           const size_t pkt_num,
+                           const struct rohc_buf ip_packet,
+                           struct rohc_buf *const rohc_packet,
+                           rohc_comp_last_packet_info2_t *const info)
+	__attribute__((warn_unused_result, nonnull(1, 4, 5)));
+
+void test_print_rohc_traces(void *const priv_ctxt,
+                            const rohc_trace_level_t level,
+                            const rohc_trace_entity_t entity,
+                            const int profile,
+                            const char *const format,
+                            ...)
+	__attribute__((format(printf, 5, 6), nonnull(5)));
+
+int test_gen_false_random_num(const struct rohc_comp *const comp,
+                              void *const user_context)
+	__attribute__((const, nonnull(1)));
+
+#endif
+
@@ -0,0 +1,381 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_udp_overlays.c
+ * @brief  Check the compression of the VXLAN and Geneve overlay headers
+ * @author agent <agent@local>
+ *
+ * The application compresses IPv4/UDP flows that carry VXLAN or Geneve
+ * overlay headers with the ROHCv2 IP/UDP profile, once with the UDP overlays
+ * feature enabled on both ends, and once with the feature disabled. The VNI
+ * of the overlay changes in the middle of every flow.
+ *
+ * With the feature enabled, the overlay headers shall be sent in the IR
+ * packets only: the ROHC packets of the next ones shall be 22 bytes shorter,
+ * and the compressor shall create a new context when the VNI changes. With
+ * the feature disabled, or for the VXLAN headers without a valid VNI, the
+ * overlay headers shall be compressed as payload. All packets shall be
+ * decompressed correctly.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/udp.h>
+#include <protocols/overlay.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  200U
+
+/** The number of packets of every flow */
+#define TEST_PKTS_NR  100U
+
+/** The VNI of the overlay changes at this packet */
+#define TEST_VNI_CHANGE_PKT  50U
+
+/** The length of the tenant payload after the inner Ethernet header */
+#define TEST_INNER_LEN  46U
+
+
+/** The overlay headers of the test flows */
+typedef enum
+{
+	TEST_OVERLAY_VXLAN,         /**< VXLAN headers with a valid VNI */
+	TEST_OVERLAY_GENEVE,        /**< Geneve headers without option */
+	TEST_OVERLAY_VXLAN_NO_VNI,  /**< VXLAN headers without the I flag */
+} test_overlay_t;
+
+
+/** One flow to compress and decompress */
+struct test_flow
+{
+	const char *descr;        /**< The description of the flow */
+	test_overlay_t overlay;   /**< The overlay headers of the flow */
+	bool use_feature;         /**< Whether the UDP overlays feature is used */
+	size_t ir_nr;             /**< The expected number of IR packets */
+	size_t co_nr;             /**< The expected number of pt_0_crc3 packets */
+	size_t rohc_len;          /**< The expected length of all ROHC packets */
+};
+
+
+/**
+ * The test flows: with the feature, the IR packets are 1 byte longer, the
+ * other packets are 22 bytes shorter, and the VNI change starts a new context
+ * with 3 more IR packets. Without valid overlay headers, the feature only
+ * adds 1 byte to the IR packets.
+ */
+static const struct test_flow test_flows[] = {
+	{ "VXLAN with UDP overlays",        TEST_OVERLAY_VXLAN,        true,  6, 94, 5044 },
+	{ "VXLAN without UDP overlays",     TEST_OVERLAY_VXLAN,        false, 3, 97, 6978 },
+	{ "Geneve with UDP overlays",       TEST_OVERLAY_GENEVE,       true,  6, 94, 5044 },
+	{ "Geneve without UDP overlays",    TEST_OVERLAY_GENEVE,       false, 3, 97, 6978 },
+	{ "VXLAN without VNI with UDP overlays",
+	                                    TEST_OVERLAY_VXLAN_NO_VNI, true,  3, 97, 6981 },
+	{ "VXLAN without VNI without UDP overlays",
+	                                    TEST_OVERLAY_VXLAN_NO_VNI, false, 3, 97, 6978 },
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static bool test_udp_overlays(const struct test_flow *const flow)
+	__attribute__((warn_unused_result, nonnull(1)));
+static bool build_packet(const test_overlay_t overlay,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((warn_unused_result, nonnull(3)));
+
+
+/**
+ * @brief Check the compression of the VXLAN and Geneve overlay headers
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+	size_t i;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	for(i = 0; i < (sizeof(test_flows) / sizeof(test_flows[0])); i++)
+	{
+		fprintf(stderr, "%s:\n", test_flows[i].descr);
+		if(!test_udp_overlays(&test_flows[i]))
+		{
+			goto error;
+		}
+	}
+
+	status = 0;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the compression of the VXLAN and Geneve overlay headers\n"
+	        "\n"
+	        "usage: test_udp_overlays [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Compress and decompress one flow
+ *
+ * @param flow  The flow to compress and decompress
+ * @return      true if the test succeeded, false otherwise
+ */
+static bool test_udp_overlays(const struct test_flow *const flow)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct test_channel channel;
+	rohc_comp_last_packet_info2_t info;
+	size_t ir_nr = 0;
+	size_t co_nr = 0;
+	size_t rohc_len = 0;
+	size_t pkt_num;
+	bool is_success = false;
+
+	/* create the ROHC compressor and decompressor in unidirectional mode */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_enable_profile(&channel, ROHCv2_PROFILE_IP_UDP))
+	{
+		goto free_channel;
+	}
+	if(flow->use_feature &&
+	   !test_channel_set_features(&channel, ROHC_COMP_FEATURE_UDP_OVERLAYS,
+	                              ROHC_DECOMP_FEATURE_UDP_OVERLAYS))
+	{
+		goto free_channel;
+	}
+
+	for(pkt_num = 0; pkt_num < TEST_PKTS_NR; pkt_num++)
+	{
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+		if(!build_packet(flow->overlay, pkt_num, &ip_packet))
+		{
+			goto free_channel;
+		}
+
+		/* compress the packet */
+		if(!test_channel_compress(&channel, pkt_num, ip_packet, &rohc_packet,
+		                          &info))
+		{
+			goto free_channel;
+		}
+		if(info.profile_id != ROHCv2_PROFILE_IP_UDP)
+		{
+			fprintf(stderr, "\tpacket #%zu was compressed with profile 0x%04x "
+			        "instead of the ROHCv2 IP/UDP profile\n", pkt_num + 1,
+			        info.profile_id);
+			goto free_channel;
+		}
+		if(info.packet_type == ROHC_PACKET_IR)
+		{
+			ir_nr++;
+		}
+		else if(info.packet_type == ROHC_PACKET_PT_0_CRC3)
+		{
+			co_nr++;
+		}
+		else
+		{
+			fprintf(stderr, "\tpacket #%zu was compressed as an unexpected %s "
+			        "packet\n", pkt_num + 1,
+			        rohc_get_packet_descr(info.packet_type));
+			goto free_channel;
+		}
+		rohc_len += rohc_packet.len;
+
+		/* decompress the packet and check it */
+		if(!test_channel_decompress(&channel, pkt_num, rohc_packet, ip_packet))
+		{
+			goto free_channel;
+		}
+	}
+
+	/* check the types and the length of the ROHC packets */
+	if(ir_nr != flow->ir_nr || co_nr != flow->co_nr)
+	{
+		fprintf(stderr, "\t%zu IR and %zu pt_0_crc3 packets instead of %zu "
+		        "and %zu\n", ir_nr, co_nr, flow->ir_nr, flow->co_nr);
+		goto free_channel;
+	}
+	if(rohc_len != flow->rohc_len)
+	{
+		fprintf(stderr, "\t%zu bytes of ROHC packets instead of %zu\n",
+		        rohc_len, flow->rohc_len);
+		goto free_channel;
+	}
+	fprintf(stderr, "\t%u packets compressed as expected and decompressed "
+	        "correctly\n", TEST_PKTS_NR);
+
+	is_success = true;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_success;
+}
+
+
+/**
+ * @brief Build the given packet of one flow
+ *
+ * The outer IPv4/UDP headers carry the overlay headers, then the inner
+ * Ethernet header and a tenant payload that changes with every packet.
+ *
+ * @param overlay         The overlay headers of the flow
+ * @param pkt_num         The number of the packet in the flow
+ * @param[out] ip_packet  The IP packet
+ * @return                true if the packet was successfully built,
+ *                        false otherwise
+ */
+static bool build_packet(const test_overlay_t overlay,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const uint8_t eth_hdr[OVERLAY_ETH_HDR_LEN] = {
+		0x02, 0x00, 0x00, 0x00, 0x00, 0x02, /* destination MAC address */
+		0x02, 0x00, 0x00, 0x00, 0x00, 0x01, /* source MAC address */
+		0x08, 0x00                          /* IPv4 */
+	};
+	const uint32_t vni = (pkt_num < TEST_VNI_CHANGE_PKT ? 0x123456 : 0x654321);
+	uint8_t *data = rohc_buf_data(*ip_packet);
+	struct ipv4_hdr *const ip_header = (struct ipv4_hdr *) data;
+	struct udphdr *const udp_header = (struct udphdr *) (ip_header + 1);
+	uint8_t *const overlay_hdr = (uint8_t *) (udp_header + 1);
+	const size_t pkt_len = sizeof(struct ipv4_hdr) + sizeof(struct udphdr) +
+	                       OVERLAY_HDRS_LEN + TEST_INNER_LEN;
+	uint32_t csum = 0;
+	size_t i;
+
+	if(ip_packet->max_len < pkt_len)
+	{
+		fprintf(stderr, "buffer too small for packet #%zu\n", pkt_num + 1);
+		return false;
+	}
+	memset(data, 0, pkt_len);
+
+	/* IPv4 header with a sequential IP-ID */
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(pkt_len);
+	ip_header->id = htons(0x1000 + pkt_num);
+	ip_header->ttl = 64;
+	ip_header->protocol = ROHC_IPPROTO_UDP;
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (data[i] << 8) | data[i + 1];
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* UDP header without checksum, as the overlay tunnels usually do */
+	udp_header->source = htons(49152);
+	udp_header->len = htons(pkt_len - sizeof(struct ipv4_hdr));
+	udp_header->check = 0;
+
+	/* overlay header */
+	if(overlay == TEST_OVERLAY_GENEVE)
+	{
+		struct genevehdr *const geneve = (struct genevehdr *) overlay_hdr;
+
+		udp_header->dest = htons(GENEVE_PORT);
+		geneve->proto = htons(GENEVE_PROTO_ETH);
+		geneve->vni[0] = (vni >> 16) & 0xff;
+		geneve->vni[1] = (vni >> 8) & 0xff;
+		geneve->vni[2] = vni & 0xff;
+	}
+	else
+	{
+		struct vxlanhdr *const vxlan = (struct vxlanhdr *) overlay_hdr;
+
+		udp_header->dest = htons(VXLAN_PORT);
+		vxlan->flags = (overlay == TEST_OVERLAY_VXLAN ? VXLAN_FLAGS_VNI : 0);
+		vxlan->vni[0] = (vni >> 16) & 0xff;
+		vxlan->vni[1] = (vni >> 8) & 0xff;
+		vxlan->vni[2] = vni & 0xff;
+	}
+
+	/* inner Ethernet header, then the tenant payload */
+	memcpy(overlay_hdr + sizeof(struct vxlanhdr), eth_hdr, OVERLAY_ETH_HDR_LEN);
+	for(i = pkt_len - TEST_INNER_LEN; i < pkt_len; i++)
+	{
+		data[i] = (i + pkt_num) & 0xff;
+	}
+	ip_packet->len = pkt_len;
+
+	return true;
+}
+
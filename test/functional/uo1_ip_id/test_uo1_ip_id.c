@@ -0,0 +1,318 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_uo1_ip_id.c
+ * @brief  Check the IP-ID bits that UO-1 transmits for two IP headers
+ * @author agent <agent@local>
+ *
+ * The application compresses IPv4/IPv4/UDP flows with the IP/UDP profile.
+ * The IP-ID of one of the two IPv4 headers jumps from time to time by a few
+ * units, so that less than 6 IP-ID bits are required to transmit it.
+ *
+ * The UO-1 packet transmits the IP-ID bits of the innermost IPv4 header
+ * only. It shall be used for the jumps of the inner IP-ID, and it shall not
+ * be used for the jumps of the outer IP-ID, otherwise the outer IP-ID is
+ * lost and the packet is not decompressed correctly.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/udp.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+#include <rohc_decomp.h>
+
+/* test includes */
+#include "test_channel.h"
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The number of packets between two jumps of the IP-ID */
+#define TEST_JUMP_PERIOD  6U
+
+/** The largest jump of the IP-ID is 2^TEST_JUMP_MAX_BITS */
+#define TEST_JUMP_MAX_BITS  4U
+
+/** The number of packets of every flow */
+#define TEST_PKTS_NR  ((TEST_JUMP_MAX_BITS + 3) * TEST_JUMP_PERIOD)
+
+/** The length of the payload of every packet */
+#define TEST_PAYLOAD_LEN  20U
+
+
+/** The description of one test */
+struct test_case
+{
+	const char *descr;     /**< The description of the test */
+	bool is_outer_jump;    /**< Whether the outer or the inner IP-ID jumps */
+	bool is_uo1_expected;  /**< Whether the jumps shall be transmitted in
+	                            UO-1 packets */
+};
+
+
+/* prototypes of private functions */
+static void usage(void);
+static bool test_uo1_ip_id(const struct test_case *const test)
+	__attribute__((warn_unused_result, nonnull(1)));
+static void build_packet(const uint16_t ip_id_outer,
+                         const uint16_t ip_id_inner,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+	__attribute__((nonnull(4)));
+
+
+/**
+ * @brief Check the IP-ID bits that UO-1 transmits for two IP headers
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	const struct test_case tests[] = {
+		{ "jumps of the inner IP-ID", false, true },
+		{ "jumps of the outer IP-ID", true, false },
+	};
+	size_t i;
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	for(i = 0; i < (sizeof(tests) / sizeof(tests[0])); i++)
+	{
+		fprintf(stderr, "IPv4/IPv4/UDP with %s:\n", tests[i].descr);
+		if(!test_uo1_ip_id(&tests[i]))
+		{
+			goto error;
+		}
+	}
+
+	status = 0;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the IP-ID bits that UO-1 transmits for two IP headers\n"
+	        "\n"
+	        "usage: test_uo1_ip_id [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Compress one flow and check the ROHC packets that transmit the jumps
+ *
+ * @param test  The test to run
+ * @return      true if the test succeeded, false otherwise
+ */
+static bool test_uo1_ip_id(const struct test_case *const test)
+{
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	uint16_t ip_id_outer = 0x5000;
+	uint16_t ip_id_inner = 0x1000;
+	struct test_channel channel;
+	rohc_comp_last_packet_info2_t info;
+	size_t pkt_num;
+	bool is_success = false;
+
+	/* create the ROHC compressor and decompressor in unidirectional mode */
+	if(!test_channel_new(&channel, ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                     ROHC_U_MODE))
+	{
+		goto error;
+	}
+	if(!test_channel_enable_profile(&channel, ROHC_PROFILE_UDP))
+	{
+		goto free_channel;
+	}
+
+	for(pkt_num = 0; pkt_num < TEST_PKTS_NR; pkt_num++)
+	{
+		struct rohc_buf ip_packet =
+			rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+		struct rohc_buf rohc_packet =
+			rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+		const bool is_jump = (pkt_num > TEST_JUMP_PERIOD &&
+		                      (pkt_num % TEST_JUMP_PERIOD) == 0);
+
+		/* both IP-IDs increase by one, one of them jumps by 2^0 up to
+		 * 2^TEST_JUMP_MAX_BITS every TEST_JUMP_PERIOD packets once the
+		 * compressor reached the SO state */
+		if(pkt_num > 0)
+		{
+			ip_id_outer++;
+			ip_id_inner++;
+		}
+		if(is_jump)
+		{
+			const uint16_t jump = 1U << (pkt_num / TEST_JUMP_PERIOD - 2);
+
+			if(test->is_outer_jump)
+			{
+				ip_id_outer += jump;
+			}
+			else
+			{
+				ip_id_inner += jump;
+			}
+		}
+		build_packet(ip_id_outer, ip_id_inner, pkt_num, &ip_packet);
+
+		/* compress the packet and check the type of the packets that
+		 * transmit the jumps */
+		if(!test_channel_compress(&channel, pkt_num, ip_packet, &rohc_packet,
+		                          &info))
+		{
+			goto free_channel;
+		}
+		if(is_jump)
+		{
+			const bool is_uo1 = (info.packet_type == ROHC_PACKET_UO_1);
+
+			fprintf(stderr, "\tpacket #%zu with a jump of the %s IP-ID was "
+			        "compressed as a %lu-byte %s header\n", pkt_num + 1,
+			        test->is_outer_jump ? "outer" : "inner",
+			        info.header_last_comp_size,
+			        rohc_get_packet_descr(info.packet_type));
+			if(is_uo1 != test->is_uo1_expected)
+			{
+				fprintf(stderr, "\tpacket #%zu shall %sbe a UO-1 packet\n",
+				        pkt_num + 1, test->is_uo1_expected ? "" : "not ");
+				goto free_channel;
+			}
+		}
+
+		/* decompress the packet and check it */
+		if(!test_channel_decompress(&channel, pkt_num, rohc_packet, ip_packet))
+		{
+			goto free_channel;
+		}
+	}
+	fprintf(stderr, "\t%u packets compressed as expected and decompressed "
+	        "correctly\n", TEST_PKTS_NR);
+
+	is_success = true;
+
+free_channel:
+	test_channel_free(&channel);
+error:
+	return is_success;
+}
+
+
+/**
+ * @brief Build the given IPv4/IPv4/UDP packet
+ *
+ * @param ip_id_outer     The IP-ID of the outer IPv4 header
+ * @param ip_id_inner     The IP-ID of the inner IPv4 header
+ * @param pkt_num         The number of the packet in the flow
+ * @param[out] ip_packet  The IP packet
+ */
+static void build_packet(const uint16_t ip_id_outer,
+                         const uint16_t ip_id_inner,
+                         const size_t pkt_num,
+                         struct rohc_buf *const ip_packet)
+{
+	const size_t udp_len = sizeof(struct udphdr) + TEST_PAYLOAD_LEN;
+	uint8_t *data = rohc_buf_data(*ip_packet);
+	struct udphdr *udp_header;
+	size_t hdrs_len = 0;
+	size_t i;
+	size_t j;
+
+	memset(data, 0, ip_packet->max_len);
+
+	/* outer then inner IPv4 headers */
+	for(i = 0; i < 2; i++)
+	{
+		struct ipv4_hdr *const ip_header = (struct ipv4_hdr *) (data + hdrs_len);
+		const bool is_inner = (i == 1);
+		uint32_t csum = 0;
+
+		ip_header->version = 4;
+		ip_header->ihl = 5;
+		ip_header->tot_len = htons((2 - i) * sizeof(struct ipv4_hdr) + udp_len);
+		ip_header->id = htons(is_inner ? ip_id_inner : ip_id_outer);
+		ip_header->ttl = 64;
+		ip_header->protocol = (is_inner ? ROHC_IPPROTO_UDP : ROHC_IPPROTO_IPIP);
+		ip_header->saddr = htonl(0xc0a80001 + (i << 8));
+		ip_header->daddr = htonl(0xc0a80002 + (i << 8));
+		for(j = 0; j < sizeof(struct ipv4_hdr); j += 2)
+		{
+			csum += (data[hdrs_len + j] << 8) | data[hdrs_len + j + 1];
+		}
+		csum = (csum & 0xffff) + (csum >> 16);
+		csum = (csum & 0xffff) + (csum >> 16);
+		ip_header->check = htons((~csum) & 0xffff);
+		hdrs_len += sizeof(struct ipv4_hdr);
+	}
+
+	/* UDP header */
+	udp_header = (struct udphdr *) (data + hdrs_len);
+	udp_header->source = htons(1234);
+	udp_header->dest = htons(1234);
+	udp_header->len = htons(udp_len);
+	udp_header->check = htons(0x1234 + pkt_num);
+	hdrs_len += sizeof(struct udphdr);
+
+	/* payload */
+	for(i = hdrs_len; i < (hdrs_len + TEST_PAYLOAD_LEN); i++)
+	{
+		data[i] = (i + pkt_num) & 0xff;
+	}
+	ip_packet->len = hdrs_len + TEST_PAYLOAD_LEN;
+}
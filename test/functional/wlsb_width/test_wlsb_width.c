@@ -0,0 +1,601 @@
+/*
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   test_wlsb_width.c
+ * @brief  Check the adaptation of the width of the W-LSB windows
+ * @author agent <agent@local>
+ *
+ * The application checks that:
+ *  - in U-mode, the width of the W-LSB windows of an ESP context is raised
+ *    when the ESP packets are reordered before the compressor, then reduced
+ *    step by step once the packets are received in order again,
+ *  - the 8-bit MSN of FEEDBACK-1 does not shrink the W-LSB windows of a
+ *    ROHCv2 context since it may wrap around, while the 14-bit MSN of
+ *    FEEDBACK-2 does.
+ */
+
+#include "test.h"
+#include "config.h" /* for HAVE_*_H */
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_WINSOCK2_H == 1
+#  include <winsock2.h> /* for htons() on Windows */
+#endif
+#if HAVE_ARPA_INET_H == 1
+#  include <arpa/inet.h> /* for htons() on Linux */
+#endif
+#include <stdarg.h>
+
+/* includes for network headers */
+#include <protocols/ip_numbers.h>
+#include <protocols/ipv4.h>
+#include <protocols/udp.h>
+#include <protocols/esp.h>
+
+/* ROHC internal includes */
+#include <feedback.h>
+
+/* ROHC includes */
+#include <rohc.h>
+#include <rohc_comp.h>
+
+
+/** The max size of the test packets */
+#define TEST_MAX_PKT_SIZE  500U
+
+/** The first MSN used by the ROHCv2 compression context */
+#define TEST_FIRST_MSN  0x1231U
+
+/** The width of the W-LSB windows configured for the ROHCv2 test */
+#define TEST_ROHCV2_WIDTH  16U
+
+/** The number of packets compressed before the ROHCv2 feedback */
+#define TEST_ROHCV2_PKTS_NR  300U
+
+
+/* prototypes of private functions */
+static void usage(void);
+static int test_wlsb_width_reorder(void);
+static int test_wlsb_width_feedback1(void);
+static struct rohc_comp * create_comp(const rohc_profile_t profile,
+                                      const size_t wlsb_width)
+	__attribute__((warn_unused_result));
+static bool compress_one(struct rohc_comp *const comp,
+                         const bool is_esp,
+                         const uint32_t sn,
+                         size_t *const wlsb_width)
+	__attribute__((warn_unused_result, nonnull(1, 4)));
+static bool deliver_feedback(struct rohc_comp *const comp,
+                             const bool is_feedback1,
+                             const uint16_t msn)
+	__attribute__((warn_unused_result, nonnull(1)));
+static uint8_t crc8(const uint8_t *const data, const size_t len)
+	__attribute__((warn_unused_result, nonnull(1)));
+static void print_rohc_traces(void *const priv_ctxt,
+                              const rohc_trace_level_t level,
+                              const rohc_trace_entity_t entity,
+                              const int profile,
+                              const char *const format,
+                              ...)
+	__attribute__((format(printf, 5, 6), nonnull(5)));
+static int gen_false_random_num(const struct rohc_comp *const comp,
+                                void *const user_context)
+	__attribute__((nonnull(1)));
+
+
+/**
+ * @brief Check the adaptation of the width of the W-LSB windows
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = 1;
+
+	/* parse program arguments, print the help message in case of failure */
+	if(argc != 1)
+	{
+		usage();
+		goto error;
+	}
+
+	/* reordering before the compressor in U-mode */
+	status = test_wlsb_width_reorder();
+	if(status != 0)
+	{
+		goto error;
+	}
+
+	/* positive ACKs with 8-bit and 14-bit MSN */
+	status = test_wlsb_width_feedback1();
+	if(status != 0)
+	{
+		goto error;
+	}
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Check the adaptation of the width of the W-LSB windows\n"
+	        "\n"
+	        "usage: test_wlsb_width [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -h           Print this usage and exit\n");
+}
+
+
+/**
+ * @brief Reorder ESP packets before the compressor in U-mode
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_wlsb_width_reorder(void)
+{
+	struct rohc_comp *comp;
+	size_t wlsb_width;
+	uint32_t sn;
+	size_t i;
+	int is_failure = 1;
+
+	fprintf(stderr, "test ESP packets reordered before the compressor\n");
+
+	comp = create_comp(ROHC_PROFILE_ESP, 4);
+	if(comp == NULL)
+	{
+		goto error;
+	}
+
+	/* packets in order: width is the configured one */
+	for(sn = 1; sn <= 10; sn++)
+	{
+		if(!compress_one(comp, true, sn, &wlsb_width))
+		{
+			goto destroy_comp;
+		}
+	}
+	if(wlsb_width != 4)
+	{
+		fprintf(stderr, "\tW-LSB width is %zu instead of 4 for packets in "
+		        "order\n", wlsb_width);
+		goto destroy_comp;
+	}
+
+	/* one packet reordered by 3 packets: width is raised by 3 entries */
+	if(!compress_one(comp, true, 7, &wlsb_width))
+	{
+		goto destroy_comp;
+	}
+	if(wlsb_width != 7)
+	{
+		fprintf(stderr, "\tW-LSB width is %zu instead of 7 after reordering\n",
+		        wlsb_width);
+		goto destroy_comp;
+	}
+	fprintf(stderr, "\tW-LSB width raised to %zu after reordering\n",
+	        wlsb_width);
+
+	/* packets in order again: width is reduced by one entry after 32 of them */
+	for(i = 0; i < 31; i++, sn++)
+	{
+		if(!compress_one(comp, true, sn, &wlsb_width))
+		{
+			goto destroy_comp;
+		}
+	}
+	if(wlsb_width != 7)
+	{
+		fprintf(stderr, "\tW-LSB width is %zu instead of 7 after 31 packets in "
+		        "order\n", wlsb_width);
+		goto destroy_comp;
+	}
+	if(!compress_one(comp, true, sn, &wlsb_width))
+	{
+		goto destroy_comp;
+	}
+	sn++;
+	if(wlsb_width != 6)
+	{
+		fprintf(stderr, "\tW-LSB width is %zu instead of 6 after 32 packets in "
+		        "order\n", wlsb_width);
+		goto destroy_comp;
+	}
+
+	/* the width never goes below the configured one */
+	for(i = 0; i < 32 * 5; i++, sn++)
+	{
+		if(!compress_one(comp, true, sn, &wlsb_width))
+		{
+			goto destroy_comp;
+		}
+	}
+	if(wlsb_width != 4)
+	{
+		fprintf(stderr, "\tW-LSB width is %zu instead of 4 after many packets in "
+		        "order\n", wlsb_width);
+		goto destroy_comp;
+	}
+	fprintf(stderr, "\tW-LSB width reduced back to %zu\n", wlsb_width);
+
+	is_failure = 0;
+
+destroy_comp:
+	rohc_comp_free(comp);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Acknowledge old ROHCv2 packets with FEEDBACK-1 then FEEDBACK-2
+ *
+ * The packet acknowledged was sent \ref TEST_ROHCV2_PKTS_NR - 40 packets
+ * before the last one: its 8-bit MSN looks like the MSN of a packet sent only
+ * a few packets ago.
+ *
+ * @return  0 in case of success,
+ *          1 in case of failure
+ */
+static int test_wlsb_width_feedback1(void)
+{
+	const uint16_t old_msn = TEST_FIRST_MSN + 40;
+	struct rohc_comp *comp;
+	size_t wlsb_width;
+	uint32_t i;
+	int is_failure = 1;
+
+	fprintf(stderr, "test positive ACKs with 8-bit MSN\n");
+
+	comp = create_comp(ROHCv2_PROFILE_IP_UDP, TEST_ROHCV2_WIDTH);
+	if(comp == NULL)
+	{
+		goto error;
+	}
+
+	for(i = 0; i < TEST_ROHCV2_PKTS_NR; i++)
+	{
+		if(!compress_one(comp, false, i, &wlsb_width))
+		{
+			goto destroy_comp;
+		}
+	}
+
+	/* FEEDBACK-1: the 8-bit MSN may have wrapped around, keep the width */
+	for(i = 0; i < 8; i++)
+	{
+		if(!deliver_feedback(comp, true, old_msn))
+		{
+			goto destroy_comp;
+		}
+	}
+	if(!compress_one(comp, false, TEST_ROHCV2_PKTS_NR, &wlsb_width))
+	{
+		goto destroy_comp;
+	}
+	if(wlsb_width != TEST_ROHCV2_WIDTH)
+	{
+		fprintf(stderr, "\tW-LSB width is %zu instead of %u after FEEDBACK-1 "
+		        "for a MSN sent %u packets ago\n", wlsb_width, TEST_ROHCV2_WIDTH,
+		        TEST_ROHCV2_PKTS_NR - 40);
+		goto destroy_comp;
+	}
+	fprintf(stderr, "\tW-LSB width kept to %zu after FEEDBACK-1\n", wlsb_width);
+
+	/* FEEDBACK-2: the 14-bit MSN of the last packet reduces the width */
+	for(i = 0; i < 8; i++)
+	{
+		if(!deliver_feedback(comp, false, TEST_FIRST_MSN + TEST_ROHCV2_PKTS_NR))
+		{
+			goto destroy_comp;
+		}
+	}
+	if(!compress_one(comp, false, TEST_ROHCV2_PKTS_NR + 1, &wlsb_width))
+	{
+		goto destroy_comp;
+	}
+	if(wlsb_width >= TEST_ROHCV2_WIDTH)
+	{
+		fprintf(stderr, "\tW-LSB width is %zu after FEEDBACK-2 for the last "
+		        "packet, it should be smaller than %u\n", wlsb_width,
+		        TEST_ROHCV2_WIDTH);
+		goto destroy_comp;
+	}
+	fprintf(stderr, "\tW-LSB width reduced to %zu after FEEDBACK-2\n",
+	        wlsb_width);
+
+	is_failure = 0;
+
+destroy_comp:
+	rohc_comp_free(comp);
+error:
+	return is_failure;
+}
+
+
+/**
+ * @brief Create one ROHC compressor with the given profile
+ *
+ * @param profile     The profile to enable
+ * @param wlsb_width  The width of the W-LSB windows
+ * @return            The new compressor, NULL in case of failure
+ */
+static struct rohc_comp * create_comp(const rohc_profile_t profile,
+                                      const size_t wlsb_width)
+{
+	struct rohc_comp *comp;
+
+	comp = rohc_comp_new2(ROHC_SMALL_CID, ROHC_SMALL_CID_MAX,
+	                      gen_false_random_num, NULL);
+	if(comp == NULL)
+	{
+		fprintf(stderr, "failed to create the ROHC compressor\n");
+		goto error;
+	}
+	if(!rohc_comp_set_traces_cb2(comp, print_rohc_traces, NULL))
+	{
+		fprintf(stderr, "failed to set the callback for traces on "
+		        "compressor\n");
+		goto destroy_comp;
+	}
+	if(!rohc_comp_set_wlsb_window_width(comp, wlsb_width))
+	{
+		fprintf(stderr, "failed to set the W-LSB window width\n");
+		goto destroy_comp;
+	}
+	if(!rohc_comp_enable_profile(comp, profile))
+	{
+		fprintf(stderr, "failed to enable the profile 0x%04x\n", profile);
+		goto destroy_comp;
+	}
+
+	return comp;
+
+destroy_comp:
+	rohc_comp_free(comp);
+error:
+	return NULL;
+}
+
+
+/**
+ * @brief Compress one IPv4/ESP or IPv4/UDP packet
+ *
+ * @param comp              The ROHC compressor
+ * @param is_esp            Whether to compress an IPv4/ESP or IPv4/UDP packet
+ * @param sn                The ESP sequence number, or the number of the
+ *                          packet in the IPv4/UDP flow
+ * @param[out] wlsb_width   The width of the W-LSB windows of the context
+ * @return                  true if the packet was successfully compressed,
+ *                          false otherwise
+ */
+static bool compress_one(struct rohc_comp *const comp,
+                         const bool is_esp,
+                         const uint32_t sn,
+                         size_t *const wlsb_width)
+{
+	const size_t payload_len = 20;
+	const size_t l4_len = (is_esp ? sizeof(struct esphdr) : sizeof(struct udphdr));
+	const size_t ip_len = sizeof(struct ipv4_hdr) + l4_len + payload_len;
+
+	uint8_t ip_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf ip_packet = rohc_buf_init_empty(ip_buffer, TEST_MAX_PKT_SIZE);
+	uint8_t rohc_buffer[TEST_MAX_PKT_SIZE];
+	struct rohc_buf rohc_packet =
+		rohc_buf_init_empty(rohc_buffer, TEST_MAX_PKT_SIZE);
+
+	rohc_comp_last_packet_info2_t info;
+	struct ipv4_hdr *ip_header;
+	uint32_t csum = 0;
+	rohc_status_t status;
+	size_t i;
+
+	/* generate the IPv4 header */
+	ip_packet.len = ip_len;
+	memset(rohc_buf_data(ip_packet), 0, ip_len);
+	ip_header = (struct ipv4_hdr *) rohc_buf_data(ip_packet);
+	ip_header->version = 4;
+	ip_header->ihl = 5;
+	ip_header->tot_len = htons(ip_len);
+	ip_header->id = htons(0x1000 + sn);
+	ip_header->ttl = 64;
+	ip_header->protocol = (is_esp ? ROHC_IPPROTO_ESP : ROHC_IPPROTO_UDP);
+	ip_header->saddr = htonl(0xc0a80001);
+	ip_header->daddr = htonl(0xc0a80002);
+	for(i = 0; i < sizeof(struct ipv4_hdr); i += 2)
+	{
+		csum += (rohc_buf_byte_at(ip_packet, i) << 8) |
+		        rohc_buf_byte_at(ip_packet, i + 1);
+	}
+	csum = (csum & 0xffff) + (csum >> 16);
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip_header->check = htons((~csum) & 0xffff);
+
+	/* generate the ESP or UDP header */
+	if(is_esp)
+	{
+		struct esphdr *const esp_header = (struct esphdr *) (ip_header + 1);
+		esp_header->spi = htonl(0x12345678);
+		esp_header->sn = htonl(sn);
+	}
+	else
+	{
+		struct udphdr *const udp_header = (struct udphdr *) (ip_header + 1);
+		udp_header->source = htons(1234);
+		udp_header->dest = htons(1235);
+		udp_header->len = htons(sizeof(struct udphdr) + payload_len);
+		udp_header->check = htons(0x1234 + sn);
+	}
+	for(i = ip_len - payload_len; i < ip_len; i++)
+	{
+		rohc_buf_byte_at(ip_packet, i) = i & 0xff;
+	}
+
+	/* compress the packet */
+	status = rohc_compress4(comp, ip_packet, &rohc_packet);
+	if(status != ROHC_STATUS_OK)
+	{
+		fprintf(stderr, "failed to compress packet with SN %u\n", sn);
+		goto error;
+	}
+	info.version_major = 0;
+	info.version_minor = 1;
+	if(!rohc_comp_get_last_packet_info2(comp, &info))
+	{
+		fprintf(stderr, "failed to get compression info for packet with SN "
+		        "%u\n", sn);
+		goto error;
+	}
+	*wlsb_width = info.context_wlsb_width;
+
+	return true;
+
+error:
+	return false;
+}
+
+
+/**
+ * @brief Deliver one positive ACK for CID 0 to the compressor
+ *
+ * @param comp          The ROHC compressor
+ * @param is_feedback1  Whether to deliver a FEEDBACK-1 or a FEEDBACK-2
+ * @param msn           The MSN acknowledged by the feedback
+ * @return              true if the feedback was successfully delivered,
+ *                      false otherwise
+ */
+static bool deliver_feedback(struct rohc_comp *const comp,
+                             const bool is_feedback1,
+                             const uint16_t msn)
+{
+	const struct rohc_ts arrival_time = { .sec = 0, .nsec = 0 };
+	uint8_t feedback_data[4];
+	struct rohc_buf feedback =
+		rohc_buf_init_full(feedback_data, 4, arrival_time);
+
+	if(is_feedback1)
+	{
+		/* RFC 5225, §6.9.1: 8-bit MSN */
+		feedback_data[0] = 0xf0 | 1; /* feedback type + size */
+		feedback_data[1] = msn & 0xff;
+		feedback.len = 2;
+	}
+	else
+	{
+		/* RFC 5225, §6.9.1: Acktype, 14-bit MSN and CRC-8 */
+		feedback_data[0] = 0xf0 | 3; /* feedback type + size */
+		feedback_data[1] = (ROHC_FEEDBACK_ACK << 6) | ((msn >> 8) & 0x3f);
+		feedback_data[2] = msn & 0xff;
+		feedback_data[3] = 0x00;
+		feedback_data[3] = crc8(feedback_data + 1, 3);
+	}
+
+	if(!rohc_comp_deliver_feedback2(comp, feedback))
+	{
+		fprintf(stderr, "failed to deliver the positive feedback\n");
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Compute the 8-bit CRC of the feedback as defined by RFC 3095
+ *
+ * @param data  The data to compute the CRC for
+ * @param len   The length of the data
+ * @return      The 8-bit CRC
+ */
+static uint8_t crc8(const uint8_t *const data, const size_t len)
+{
+	uint8_t crc = 0xff;
+	size_t i;
+	size_t j;
+
+	for(i = 0; i < len; i++)
+	{
+		crc ^= data[i];
+		for(j = 0; j < 8; j++)
+		{
+			crc = (crc & 1) ? ((crc >> 1) ^ 0xe0) : (crc >> 1);
+		}
+	}
+
+	return crc;
+}
+
+
+/**
+ * @brief Callback to print traces of the ROHC library
+ *
+ * @param priv_ctxt  An optional private context, may be NULL
+ * @param level      The priority level of the trace
+ * @param entity     The entity that emitted the trace among:
+ *                    \li ROHC_TRACE_COMP
+ *                    \li ROHC_TRACE_DECOMP
+ * @param profile    The ID of the ROHC compression/decompression profile
+ *                   the trace is related to
+ * @param format     The format string of the trace
+ */
+static void print_rohc_traces(void *const priv_ctxt,
+                              const rohc_trace_level_t level,
+                              const rohc_trace_entity_t entity,
+                              const int profile,
+                              const char *const format,
+                              ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	vfprintf(stdout, format, args);
+	va_end(args);
+}
+
+
+/**
+ * @brief Generate a false random number for testing the ROHC library
+ *
+ * The ROHCv2 compression context uses it as first MSN, so that the test
+ * knows the MSN of every packet.
+ *
+ * @param comp          The ROHC compressor
+ * @param user_context  Should always be NULL
+ * @return              Always the same number
+ */
+static int gen_false_random_num(const struct rohc_comp *const comp,
+                                void *const user_context)
+{
+	return (TEST_FIRST_MSN - 1);
+}
@@ -0,0 +1 @@
+../../test_non_regression.sh
\ No newline at end of file